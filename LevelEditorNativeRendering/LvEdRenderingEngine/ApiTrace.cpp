@@ -0,0 +1,308 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    ApiTrace.cpp
+
+****************************************************************************/
+#include "ApiTrace.h"
+#include <string.h>
+#include <assert.h>
+#include "Core/Logger.h"
+#include "Core/StringUtils.h"
+#include "VectorMath/CollisionPrimitives.h"
+#include "GobSystem/Terrain/TerrainGob.h"
+
+using namespace LvEdEngine;
+
+static const uint32_t TraceMagic = 'L' | ('V' << 8) | ('T' << 16) | ('R' << 24);
+static const uint32_t TraceVersion = 1;
+static const uint32_t NullBlob = 0xFFFFFFFF;
+
+static const char* s_callNames[ApiCall::Count] =
+{
+    #define LVED_API_CALL_NAME(name) #name,
+    LVED_API_CALLS(LVED_API_CALL_NAME)
+    #undef LVED_API_CALL_NAME
+};
+
+//---------------------------------------------------------------------------
+const char* ApiCall::ToString(Enum call)
+{
+    return call < Count ? s_callNames[call] : "Unknown";
+}
+
+//---------------------------------------------------------------------------
+// size of the argument types of LVED_INVOKE_FUNCTIONS.
+template<typename T> struct InvokeArg
+{
+    static uint32_t Size(const void* /*arg*/) { return sizeof(T); }
+};
+template<> struct InvokeArg<InvokeNoArg>
+{
+    static uint32_t Size(const void* /*arg*/) { return 0; }
+};
+template<> struct InvokeArg<InvokeString>
+{
+    static uint32_t Size(const void* arg) { return (uint32_t)(wcslen((const wchar_t*)arg) + 1) * sizeof(wchar_t); }
+};
+
+#define LVED_WIDEN2(str) L ## str
+#define LVED_WIDEN(str) LVED_WIDEN2(str)
+
+//---------------------------------------------------------------------------
+uint32_t LvEdEngine::GetInvokeArgSize(const wchar_t* fn, const void* arg)
+{
+    if(fn == NULL || arg == NULL)
+        return 0;
+    #define LVED_INVOKE_ARG_SIZE(name, argType, returnsId) \
+        if(wcscmp(fn, LVED_WIDEN(#name)) == 0) return InvokeArg<argType>::Size(arg);
+    LVED_INVOKE_FUNCTIONS(LVED_INVOKE_ARG_SIZE)
+    #undef LVED_INVOKE_ARG_SIZE
+    return 0;
+}
+
+//---------------------------------------------------------------------------
+bool LvEdEngine::InvokeReturnsInstanceId(const wchar_t* fn)
+{
+    if(fn == NULL)
+        return false;
+    #define LVED_INVOKE_RETURNS_ID(name, argType, returnsId) \
+        if(wcscmp(fn, LVED_WIDEN(#name)) == 0) return returnsId;
+    LVED_INVOKE_FUNCTIONS(LVED_INVOKE_RETURNS_ID)
+    #undef LVED_INVOKE_RETURNS_ID
+    return false;
+}
+
+//===========================================================================
+// ApiTraceWriter
+//===========================================================================
+
+ApiTraceWriter::ApiTraceWriter()
+  : m_file(NULL),
+    m_callCount(0)
+{
+}
+
+//---------------------------------------------------------------------------
+ApiTraceWriter::~ApiTraceWriter()
+{
+    Close();
+}
+
+//---------------------------------------------------------------------------
+bool ApiTraceWriter::Open(const wchar_t* file)
+{
+    Close();
+    if(_wfopen_s(&m_file, file, L"wb") != 0 || m_file == NULL)
+    {
+        m_file = NULL;
+        Logger::Log(OutputMessageType::Error, L"Failed to create trace file %s\n", file);
+        return false;
+    }
+
+    TraceFileHeader header;
+    header.magic = TraceMagic;
+    header.version = TraceVersion;
+    header.pointerSize = sizeof(void*);
+    header.reserved = 0;
+    fwrite(&header, sizeof(header), 1, m_file);
+    m_callCount = 0;
+    return true;
+}
+
+//---------------------------------------------------------------------------
+void ApiTraceWriter::Close()
+{
+    if(m_file)
+    {
+        fclose(m_file);
+        m_file = NULL;
+    }
+}
+
+//---------------------------------------------------------------------------
+ApiTraceWriter& ApiTraceWriter::BeginCall(ApiCallEnum call)
+{
+    m_record.resize(sizeof(TraceRecordHeader));
+    TraceRecordHeader* header = reinterpret_cast<TraceRecordHeader*>(&m_record[0]);
+    header->call = (uint16_t)call;
+    header->reserved = 0;
+    header->size = 0;
+    return *this;
+}
+
+//---------------------------------------------------------------------------
+ApiTraceWriter& ApiTraceWriter::WriteBytes(const void* data, uint32_t size)
+{
+    if(size > 0)
+    {
+        size_t pos = m_record.size();
+        m_record.resize(pos + size);
+        memcpy(&m_record[pos], data, size);
+    }
+    return *this;
+}
+
+//---------------------------------------------------------------------------
+ApiTraceWriter& ApiTraceWriter::WriteBlob(const void* data, uint32_t size)
+{
+    Write<uint32_t>(data ? size : NullBlob);
+    Align();
+    if(data)
+        WriteBytes(data, size);
+    return *this;
+}
+
+//---------------------------------------------------------------------------
+ApiTraceWriter& ApiTraceWriter::WriteString(const char* str)
+{
+    return WriteBlob(str, str ? (uint32_t)strlen(str) + 1 : 0);
+}
+
+//---------------------------------------------------------------------------
+ApiTraceWriter& ApiTraceWriter::WriteString(const wchar_t* str)
+{
+    return WriteBlob(str, str ? (uint32_t)(wcslen(str) + 1) * sizeof(wchar_t) : 0);
+}
+
+//---------------------------------------------------------------------------
+void ApiTraceWriter::EndCall()
+{
+    Align();
+    reinterpret_cast<TraceRecordHeader*>(&m_record[0])->size = (uint32_t)m_record.size();
+    if(m_file)
+    {
+        fwrite(&m_record[0], m_record.size(), 1, m_file);
+        m_callCount++;
+    }
+}
+
+//---------------------------------------------------------------------------
+void ApiTraceWriter::Align()
+{
+    m_record.resize((m_record.size() + 7) & ~(size_t)7, 0);
+}
+
+//===========================================================================
+// ApiTraceReader
+//===========================================================================
+
+ApiTraceReader::ApiTraceReader()
+  : m_size(0),
+    m_next(0),
+    m_pos(0),
+    m_end(0),
+    m_error(false)
+{
+}
+
+//---------------------------------------------------------------------------
+bool ApiTraceReader::Open(const wchar_t* file)
+{
+    FILE* fp = NULL;
+    if(_wfopen_s(&fp, file, L"rb") != 0 || fp == NULL)
+    {
+        Logger::Log(OutputMessageType::Error, L"Failed to open trace file %s\n", file);
+        return false;
+    }
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    bool valid = size >= (long)sizeof(TraceFileHeader);
+    if(valid)
+    {
+        m_data.resize((size + 7) / 8);
+        valid = fread(&m_data[0], size, 1, fp) == 1;
+    }
+    fclose(fp);
+
+    const TraceFileHeader* header = valid ? reinterpret_cast<const TraceFileHeader*>(&m_data[0]) : NULL;
+    if(header == NULL || header->magic != TraceMagic || header->version != TraceVersion)
+    {
+        Logger::Log(OutputMessageType::Error, L"%s is not a trace file\n", file);
+        return false;
+    }
+    if(header->pointerSize != sizeof(void*))
+    {
+        Logger::Log(OutputMessageType::Error, L"%s was recorded by a %d bit engine\n", file, header->pointerSize * 8);
+        return false;
+    }
+
+    m_size = (uint32_t)size;
+    m_next = sizeof(TraceFileHeader);
+    m_pos = m_end = m_next;
+    m_error = false;
+    return true;
+}
+
+//---------------------------------------------------------------------------
+bool ApiTraceReader::NextCall(ApiCallEnum* call)
+{
+    if(m_error || m_next + sizeof(TraceRecordHeader) > m_size)
+        return false;
+    const TraceRecordHeader* header = reinterpret_cast<const TraceRecordHeader*>(
+        reinterpret_cast<const uint8_t*>(&m_data[0]) + m_next);
+    if(header->size < sizeof(TraceRecordHeader) || m_next + header->size > m_size || header->call >= ApiCall::Count)
+    {
+        m_error = true;
+        return false;
+    }
+    *call = (ApiCallEnum)header->call;
+    m_pos = m_next + sizeof(TraceRecordHeader);
+    m_end = m_next + header->size;
+    m_next = m_end;
+    return true;
+}
+
+//---------------------------------------------------------------------------
+const uint8_t* ApiTraceReader::Consume(uint32_t size)
+{
+    if(m_error || m_pos + size > m_end)
+    {
+        m_error = true;
+        return NULL;
+    }
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(&m_data[0]) + m_pos;
+    m_pos += size;
+    return data;
+}
+
+//---------------------------------------------------------------------------
+void ApiTraceReader::Align()
+{
+    m_pos = (m_pos + 7) & ~7u;
+}
+
+//---------------------------------------------------------------------------
+void ApiTraceReader::ReadBytes(void* data, uint32_t size)
+{
+    const uint8_t* src = Consume(size);
+    if(src)
+        memcpy(data, src, size);
+    else
+        memset(data, 0, size);
+}
+
+//---------------------------------------------------------------------------
+const void* ApiTraceReader::ReadBlob(uint32_t* size)
+{
+    uint32_t blobSize = Read<uint32_t>();
+    Align();
+    if(size)
+        *size = blobSize == NullBlob ? 0 : blobSize;
+    if(blobSize == NullBlob)
+        return NULL;
+    return Consume(blobSize);
+}
+
+//---------------------------------------------------------------------------
+const char* ApiTraceReader::ReadStringA()
+{
+    return (const char*)ReadBlob(NULL);
+}
+
+//---------------------------------------------------------------------------
+const wchar_t* ApiTraceReader::ReadStringW()
+{
+    return (const wchar_t*)ReadBlob(NULL);
+}
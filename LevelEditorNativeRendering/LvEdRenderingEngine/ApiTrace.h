@@ -0,0 +1,202 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    ApiTrace.h
+
+    Records the LvEd_* calls made by the editor into a binary trace file.
+    LvEdTraceReplay replays them on the engine, so editing sessions can be
+    profiled and compared from one build to the next without the editor.
+
+    A trace file starts with a TraceFileHeader, followed by one record per
+    call: a TraceRecordHeader and the arguments of the call. Records and
+    blobs are 8 byte aligned.
+****************************************************************************/
+#pragma once
+
+#include <stdio.h>
+#include <stdint.h>
+#include <vector>
+#include "Core/typedefs.h"
+#include "Core/NonCopyable.h"
+
+namespace LvEdEngine
+{
+    // The recorded calls, the enum and the names are generated from this table.
+    // Append new calls at the end so older traces still replay.
+    #define LVED_API_CALLS(X) \
+    X(Clear) \
+    X(GetObjectTypeId) \
+    X(GetObjectPropertyId) \
+    X(GetObjectChildListId) \
+    X(CreateObject) \
+    X(DestroyObject) \
+    X(InvokeMemberFn) \
+    X(SetObjectProperty) \
+    X(GetObjectProperty) \
+    X(ObjectAddChild) \
+    X(ObjectRemoveChild) \
+    X(RayPick) \
+    X(FrustumPick) \
+    X(SetSelection) \
+    X(SetRenderState) \
+    X(SetGameLevel) \
+    X(GetGameLevel) \
+    X(WaitForPendingResources) \
+    X(Update) \
+    X(Begin) \
+    X(End) \
+    X(RenderGame) \
+    X(SetRenderThreadCount) \
+    X(SetOcclusionCulling) \
+    X(BuildStaticBatches) \
+    X(ClearStaticBatches) \
+    X(SaveRenderSurfaceToFile) \
+    X(CreateVertexBuffer) \
+    X(CreateIndexBuffer) \
+    X(DeleteBuffer) \
+    X(SetRendererFlag) \
+    X(DrawPrimitive) \
+    X(DrawIndexedPrimitive) \
+    X(CreateFontInstance) /* CreateFont is a windows macro. */ \
+    X(DeleteFont) \
+    X(DrawText2D) \
+    X(SetSmallFeatureCulling) \
+    X(DrawBatch) \
+    X(SetResourceMemoryBudget) \
+    X(MountArchive) \
+    X(SetContentSharing) \
+    X(SetTextureCache) \
+    X(SetTextureStreaming) \
+    X(PackArchive) \
+    // end of LVED_API_CALLS
+
+    namespace ApiCall
+    {
+        enum Enum
+        {
+            #define LVED_API_CALL_ENUM(name) name,
+            LVED_API_CALLS(LVED_API_CALL_ENUM)
+            #undef LVED_API_CALL_ENUM
+            Count
+        };
+
+        const char* ToString(Enum call);
+    }
+    typedef ApiCall::Enum ApiCallEnum;
+
+    struct TraceFileHeader
+    {
+        uint32_t magic;     // "LVTR"
+        uint32_t version;
+        uint32_t pointerSize; // handles are pointers, traces only replay on the same architecture.
+        uint32_t reserved;
+    };
+
+    struct TraceRecordHeader
+    {
+        uint16_t call;
+        uint16_t reserved;
+        uint32_t size;      // size in bytes including the header, multiple of 8.
+    };
+
+    //-----------------------------------------------------------------------
+    //  Writes the calls to a trace file.
+    //  Usage: writer.BeginCall(ApiCall::X).Write(a).WriteBlob(p, n).EndCall();
+    //-----------------------------------------------------------------------
+    class ApiTraceWriter : public NonCopyable
+    {
+    public:
+        ApiTraceWriter();
+        ~ApiTraceWriter();
+
+        bool Open(const wchar_t* file);
+        void Close();
+        bool IsOpen() const { return m_file != NULL; }
+
+        ApiTraceWriter& BeginCall(ApiCallEnum call);
+        template<typename T> ApiTraceWriter& Write(const T& value)
+        {
+            return WriteBytes(&value, sizeof(T));
+        }
+        ApiTraceWriter& WriteBytes(const void* data, uint32_t size);
+        // writes the size followed by the data, data can be NULL.
+        ApiTraceWriter& WriteBlob(const void* data, uint32_t size);
+        // null terminated strings, str can be NULL.
+        ApiTraceWriter& WriteString(const char* str);
+        ApiTraceWriter& WriteString(const wchar_t* str);
+        void EndCall();
+
+        uint32_t GetCallCount() const { return m_callCount; }
+
+    private:
+        void Align();
+
+        FILE*                 m_file;
+        std::vector<uint8_t>  m_record;
+        uint32_t              m_callCount;
+    };
+
+    //-----------------------------------------------------------------------
+    //  Reads the calls of a trace file. The file is read into memory when
+    //  it's opened, so reading doesn't touch the disk while replaying.
+    //-----------------------------------------------------------------------
+    class ApiTraceReader : public NonCopyable
+    {
+    public:
+        ApiTraceReader();
+
+        bool Open(const wchar_t* file);
+
+        // moves to the next record, returns false at the end of the trace.
+        bool NextCall(ApiCallEnum* call);
+        template<typename T> T Read()
+        {
+            T value;
+            ReadBytes(&value, sizeof(T));
+            return value;
+        }
+        void ReadBytes(void* data, uint32_t size);
+        // returns NULL for NULL blobs, the data stays valid until the reader is destroyed.
+        const void* ReadBlob(uint32_t* size);
+        const char* ReadStringA();
+        const wchar_t* ReadStringW();
+
+        // true if a record was shorter than its arguments, or the file is corrupt.
+        bool HasError() const { return m_error; }
+
+    private:
+        const uint8_t* Consume(uint32_t size);
+        void Align();
+
+        std::vector<uint64_t> m_data;   // 8 byte aligned file data.
+        uint32_t              m_size;
+        uint32_t              m_next;   // offset of the next record.
+        uint32_t              m_pos;    // read position in the current record.
+        uint32_t              m_end;    // end of the current record.
+        bool                  m_error;
+    };
+
+    // argument types of the InvokeMemberFn functions that have no struct of their own.
+    struct InvokeNoArg {};
+    struct InvokeString {};     // null terminated wchar_t string.
+    struct CreateImageArgs { int32_t width; int32_t height; int32_t format; };
+
+    // The functions LvEd_InvokeMemberFn can call: name, argument type and
+    // whether they return an instance id. The trace records and replays the
+    // arguments from this table, keep it in sync with the Invoke() implementations.
+    #define LVED_INVOKE_FUNCTIONS(X) \
+    X(SetOccluder,            bool,            false) \
+    X(RayPick,                Ray,             false) \
+    X(DrawBrush,              DrawBrushArgs,   false) \
+    X(ApplyDirtyRegion,       Bound2di,        false) \
+    X(CreateNew,              CreateImageArgs, false) \
+    X(SaveToFile,             InvokeString,    false) \
+    X(GetHeightMapInstanceId, InvokeNoArg,     true) \
+    X(GetMaskMapInstanceId,   InvokeNoArg,     true) \
+    // end of LVED_INVOKE_FUNCTIONS
+
+    // size of the argument the InvokeMemberFn function takes, 0 for unknown functions.
+    uint32_t GetInvokeArgSize(const wchar_t* fn, const void* arg);
+    // true if the InvokeMemberFn function returns an instance id.
+    bool InvokeReturnsInstanceId(const wchar_t* fn);
+}
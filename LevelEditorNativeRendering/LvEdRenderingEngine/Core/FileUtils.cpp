@@ -83,4 +83,91 @@ namespace LvEdEngine
     return lastSlash;
 }
 
+// ----------------------------------------------------------------------------------------------
+std::wstring FileUtils::FullPath(const WCHAR* filename)
+{
+    WCHAR fullPath[MAX_PATH];
+    DWORD len = GetFullPathName(filename, MAX_PATH, fullPath, NULL);
+    return (len > 0 && len < MAX_PATH) ? fullPath : filename;
+}
+
+// ----------------------------------------------------------------------------------------------
+std::wstring FileUtils::CanonicalPath(const WCHAR* filename)
+{
+    std::wstring path = FullPath(filename);
+    for(auto it = path.begin(); it != path.end(); ++it)
+    {
+#ifdef _WIN32
+        *it = (*it == L'/') ? L'\\' : towlower(*it);
+#else
+        // case sensitive file system.
+        if(*it == L'\\') *it = L'/';
+#endif
+    }
+    return path;
+}
+
+// ----------------------------------------------------------------------------------------------
+bool FileUtils::SaveFile(const WCHAR* filename, const void* data, UINT size)
+{
+    std::wstring tmpName = filename;
+    tmpName += L".tmp";
+    HANDLE fileHandle = CreateFile(tmpName.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (fileHandle == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    DWORD dwBytesWritten = 0;
+    BOOL written = WriteFile(fileHandle, data, size, &dwBytesWritten, NULL);
+    CloseHandle(fileHandle);
+    if (!written || dwBytesWritten != size
+        || !MoveFileEx(tmpName.c_str(), filename, MOVEFILE_REPLACE_EXISTING))
+    {
+        DeleteFile(tmpName.c_str());
+        return false;
+    }
+    return true;
+}
+
+// ----------------------------------------------------------------------------------------------
+static bool MakeDir(const std::wstring& dir)
+{
+    return CreateDirectory(dir.c_str(), NULL) || GetLastError() == ERROR_ALREADY_EXISTS;
+}
+
+// ----------------------------------------------------------------------------------------------
+std::wstring FileUtils::GetCacheDir(const WCHAR* subDir)
+{
+    WCHAR root[MAX_PATH];
+    std::wstring dir;
+    DWORD len = GetEnvironmentVariable(L"LVED_CACHE_DIR", root, MAX_PATH);
+    if (len > 0 && len < MAX_PATH)
+    {
+        dir = root;
+        if (!MakeDir(dir))
+            return std::wstring();
+    }
+    else
+    {
+        len = GetEnvironmentVariable(L"LOCALAPPDATA", root, MAX_PATH);
+        if (len == 0 || len >= MAX_PATH)
+            return std::wstring();
+        dir = root;
+        dir += L"\\LvEdRenderingEngine";
+        if (!MakeDir(dir))
+            return std::wstring();
+        dir += L"\\Cache";
+        if (!MakeDir(dir))
+            return std::wstring();
+    }
+
+    dir += L"\\";
+    dir += subDir;
+    if (!MakeDir(dir))
+        return std::wstring();
+    dir += L"\\";
+    return dir;
+}
+
 }; // namespace
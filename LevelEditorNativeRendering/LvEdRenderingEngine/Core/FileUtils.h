@@ -13,5 +13,19 @@ class FileUtils
         static BYTE* LoadFile(const WCHAR* filename, UINT * sizeOut);
         static std::wstring GetExtensionLower(const WCHAR* filename);
         static const WCHAR* Name(const WCHAR* filename);
+        // the absolute path, spelled as given.
+        static std::wstring FullPath(const WCHAR* filename);
+        // the full path with the separators of the platform, lower case on
+        // Windows: the same file always gets the same name. Only a key, open
+        // files by their FullPath() since the case matters on POSIX.
+        static std::wstring CanonicalPath(const WCHAR* filename);
+
+        // writes to a temporary file first and renames it, so readers never see a partial file.
+        static bool SaveFile(const WCHAR* filename, const void* data, UINT size);
+
+        // directory for data the engine can rebuild, created if needed.
+        // %LOCALAPPDATA%\LvEdRenderingEngine\Cache\<subDir>\ unless LVED_CACHE_DIR is set.
+        // returns an empty string if the directory can't be created.
+        static std::wstring GetCacheDir(const WCHAR* subDir);
     };
 }
@@ -0,0 +1,131 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    FrameArena.cpp
+
+****************************************************************************/
+#include "FrameArena.h"
+#include <malloc.h>
+#include "Utils.h"
+#include "Logger.h"
+
+using namespace LvEdEngine;
+
+FrameArena* FrameArena::s_inst = NULL;
+
+static const uint32_t kBaseAlign = 16;
+
+//---------------------------------------------------------------------------
+void FrameArena::InitInstance(uint32_t capacity)
+{
+    if(s_inst == NULL)
+        s_inst = new FrameArena(capacity);
+}
+
+//---------------------------------------------------------------------------
+void FrameArena::DestroyInstance()
+{
+    SAFE_DELETE(s_inst);
+}
+
+//---------------------------------------------------------------------------
+FrameArena::FrameArena(uint32_t capacity)
+  : m_base(NULL),
+    m_capacity(capacity),
+    m_offset(0),
+    m_frameOverflow(0),
+    m_generation(1),
+    m_peakBytes(0),
+    m_overflowBytes(0)
+{
+    InitializeCriticalSection(&m_overflowLock);
+    m_base = (uint8_t*)_aligned_malloc(m_capacity, kBaseAlign);
+    if(m_base == NULL)
+        m_capacity = 0;
+}
+
+//---------------------------------------------------------------------------
+FrameArena::~FrameArena()
+{
+    FreeOverflow();
+    _aligned_free(m_base);
+    DeleteCriticalSection(&m_overflowLock);
+}
+
+//---------------------------------------------------------------------------
+void* FrameArena::Alloc(uint32_t size, uint32_t align)
+{
+    assert(align > 0 && (align & (align - 1)) == 0);
+    if(align > kBaseAlign)
+        return AllocOverflow(size, align);
+
+    for(;;)
+    {
+        LONG offset = m_offset;
+        uint32_t start = ((uint32_t)offset + align - 1) & ~(align - 1);
+        uint32_t end = start + size;
+        if(end > m_capacity || end < start)
+            break;
+        if(InterlockedCompareExchange(&m_offset, (LONG)end, offset) == offset)
+            return m_base + start;
+    }
+    return AllocOverflow(size, align);
+}
+
+//---------------------------------------------------------------------------
+void* FrameArena::AllocOverflow(uint32_t size, uint32_t align)
+{
+    if(align < kBaseAlign)
+        align = kBaseAlign;
+    void* ptr = _aligned_malloc(size > 0 ? size : 1, align);
+    assert(ptr);
+
+    EnterCriticalSection(&m_overflowLock);
+    m_overflow.push_back(ptr);
+    LeaveCriticalSection(&m_overflowLock);
+    InterlockedExchangeAdd(&m_frameOverflow, (LONG)size);
+    return ptr;
+}
+
+//---------------------------------------------------------------------------
+void FrameArena::FreeOverflow()
+{
+    for(auto it = m_overflow.begin(); it != m_overflow.end(); ++it)
+        _aligned_free(*it);
+    m_overflow.clear();
+}
+
+//---------------------------------------------------------------------------
+void FrameArena::Reset()
+{
+    uint32_t used = (uint32_t)m_offset;
+    m_overflowBytes = (uint32_t)m_frameOverflow;
+    m_peakBytes = used + m_overflowBytes;
+
+    FreeOverflow();
+    if(m_overflowBytes > 0)
+    {
+        // grow to the peak of this frame plus some slack, this is the only
+        // time the arena allocates from the heap.
+        uint32_t capacity = m_peakBytes + m_peakBytes / 4;
+        uint8_t* base = (uint8_t*)_aligned_malloc(capacity, kBaseAlign);
+        if(base)
+        {
+            _aligned_free(m_base);
+            m_base = base;
+            m_capacity = capacity;
+            Logger::Log(OutputMessageType::Debug, "frame arena grown to %u bytes\n", capacity);
+        }
+    }
+#ifdef _DEBUG
+    else if(used > 0)
+    {
+        // makes using freed memory fail early.
+        memset(m_base, 0xCD, used);
+    }
+#endif
+
+    m_offset = 0;
+    m_frameOverflow = 0;
+    m_generation++;
+}
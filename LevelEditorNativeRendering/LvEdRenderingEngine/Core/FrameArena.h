@@ -0,0 +1,218 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    FrameArena.h
+
+    Linear allocator for the data that only lives for one frame: render
+    lists, hit records, temporary arrays. Allocating is a pointer bump and
+    everything is released at once by Reset(), which LvEd_End calls.
+    When a frame doesn't fit, the extra allocations come from the heap and
+    the arena grows to the peak of that frame at the next Reset(), so
+    frames that stay under the peak don't touch the heap.
+****************************************************************************/
+#pragma once
+
+#include <vector>
+#include <new>
+#include <string.h>
+#include <assert.h>
+#include "WinHeaders.h"
+#include "NonCopyable.h"
+
+namespace LvEdEngine
+{
+    class FrameArena : public NonCopyable
+    {
+    public:
+        static void InitInstance(uint32_t capacity);
+        static void DestroyInstance();
+        static FrameArena* Inst() { return s_inst; }
+
+        // thread safe, never returns NULL.
+        void* Alloc(uint32_t size, uint32_t align);
+
+        // releases everything allocated since the previous Reset().
+        // nothing allocated from the arena may be used after this.
+        void Reset();
+
+        // incremented by Reset(), memory allocated in an older generation is gone.
+        uint32_t GetGeneration() const { return m_generation; }
+
+        // stats of the last frame.
+        uint32_t GetCapacity() const { return m_capacity; }
+        uint32_t GetPeakBytes() const { return m_peakBytes; }         // including the overflow.
+        uint32_t GetOverflowBytes() const { return m_overflowBytes; } // allocated from the heap.
+
+    private:
+        FrameArena(uint32_t capacity);
+        ~FrameArena();
+        static FrameArena* s_inst;
+
+        void* AllocOverflow(uint32_t size, uint32_t align);
+        void FreeOverflow();
+
+        uint8_t*            m_base;
+        uint32_t            m_capacity;
+        volatile LONG       m_offset;
+        volatile LONG       m_frameOverflow;
+        uint32_t            m_generation;
+        uint32_t            m_peakBytes;
+        uint32_t            m_overflowBytes;
+
+        CRITICAL_SECTION    m_overflowLock;
+        std::vector<void*>  m_overflow;
+    };
+
+    //-----------------------------------------------------------------------
+    //  Growable array allocated from the FrameArena, for types that can be
+    //  copied with memcpy and don't need a destructor.
+    //  It's emptied when the frame ends: after FrameArena::Reset() it acts
+    //  as if clear() was called, and the first allocation of the new frame
+    //  reserves the capacity reached before, so a member FrameVector that is
+    //  refilled every frame allocates once per frame.
+    //-----------------------------------------------------------------------
+    template<typename T>
+    class FrameVector
+    {
+    public:
+        typedef T           value_type;
+        typedef T*          iterator;
+        typedef const T*    const_iterator;
+
+        FrameVector() : m_data(NULL), m_size(0), m_capacity(0), m_hint(0), m_generation(0) {}
+        FrameVector(const FrameVector& other) : m_data(NULL), m_size(0), m_capacity(0), m_hint(0), m_generation(0)
+        {
+            insert(end(), other.begin(), other.end());
+        }
+        FrameVector& operator=(const FrameVector& other)
+        {
+            if(this != &other)
+            {
+                clear();
+                insert(end(), other.begin(), other.end());
+            }
+            return *this;
+        }
+
+        size_t size() const { return Stale() ? 0 : m_size; }
+        bool empty() const { return size() == 0; }
+
+        iterator begin() { Sync(); return m_data; }
+        iterator end() { Sync(); return m_data + m_size; }
+        const_iterator begin() const { return Stale() ? NULL : m_data; }
+        const_iterator end() const { return Stale() ? NULL : m_data + m_size; }
+
+        T& operator[](size_t i) { assert(!Stale() && i < m_size); return m_data[i]; }
+        const T& operator[](size_t i) const { assert(!Stale() && i < m_size); return m_data[i]; }
+        T& front() { return (*this)[0]; }
+        T& back() { return (*this)[m_size - 1]; }
+
+        void clear() { Sync(); m_size = 0; }
+
+        void reserve(size_t count)
+        {
+            Sync();
+            if(count > m_capacity)
+                Grow(count);
+        }
+
+        void resize(size_t count)
+        {
+            reserve(count);
+            for(size_t i = m_size; i < count; ++i)
+                new(m_data + i) T();
+            m_size = (uint32_t)count;
+        }
+
+        void push_back(const T& val)
+        {
+            Sync();
+            if(m_size == m_capacity)
+            {
+                T copy = val; // val may be in the array.
+                Grow(m_size + 1);
+                m_data[m_size++] = copy;
+                return;
+            }
+            m_data[m_size++] = val;
+        }
+
+        template<typename It>
+        void insert(iterator pos, It first, It last)
+        {
+            // the offset into the current storage, before Sync() or reserve() replace it.
+            size_t index = pos - m_data;
+            Sync();
+            if(index > m_size)
+                index = m_size; // pos is from a previous frame.
+            size_t count = 0;
+            for(It it = first; it != last; ++it)
+                count++;
+            if(count == 0)
+                return;
+            reserve(m_size + count);
+            T* dest = m_data + index;
+            memmove((void*)(dest + count), dest, (m_size - index) * sizeof(T));
+            for(It it = first; it != last; ++it)
+                *dest++ = *it;
+            m_size += (uint32_t)count;
+        }
+
+        iterator erase(iterator first, iterator last)
+        {
+            size_t from = first - m_data;
+            size_t to = last - m_data;
+            Sync();
+            if(to > m_size)
+                from = to = m_size; // the range is from a previous frame.
+            T* dest = m_data + from;
+            if(to < m_size)
+                memmove((void*)dest, m_data + to, (m_size - to) * sizeof(T));
+            m_size -= (uint32_t)(to - from);
+            return dest;
+        }
+
+    private:
+        bool Stale() const
+        {
+            return m_data != NULL && m_generation != FrameArena::Inst()->GetGeneration();
+        }
+
+        // drops the memory of a previous frame.
+        void Sync()
+        {
+            if(Stale())
+            {
+                m_hint = m_capacity;
+                m_data = NULL;
+                m_size = 0;
+                m_capacity = 0;
+            }
+        }
+
+        void Grow(size_t count)
+        {
+            size_t capacity = m_capacity * 2;
+            if(capacity < count)
+                capacity = count;
+            if(capacity < m_hint)
+                capacity = m_hint;
+            if(capacity < 16)
+                capacity = 16;
+
+            FrameArena* arena = FrameArena::Inst();
+            T* data = (T*)arena->Alloc((uint32_t)(capacity * sizeof(T)), __alignof(T));
+            if(m_size > 0)
+                memcpy((void*)data, m_data, m_size * sizeof(T));
+            m_data = data;
+            m_capacity = (uint32_t)capacity;
+            m_generation = arena->GetGeneration();
+        }
+
+        T*          m_data;
+        uint32_t    m_size;
+        uint32_t    m_capacity;
+        uint32_t    m_hint;       // capacity reached in the previous frame.
+        uint32_t    m_generation; // arena generation of m_data.
+    };
+}
@@ -4,6 +4,7 @@
 #include <string>
 #include <map>
 #include <cstdint>
+#include <cstring>
 #include "Hasher.h"
 
 // -------------------------------------------------------------------------
@@ -45,4 +46,119 @@ hash32_t HashLowercase32(const char * string)
         return hval;
     }
 
+    // -------------------------------------------------------------------------
+    // generate a hash for a wide string, hval can chain several hashes.
+    hash32_t Hash32(const wchar_t * string, hash32_t hval)
+    {
+        const wchar_t * current = string;
+        while(*current != 0 )
+        {
+            hval = hval + (hval<<1) + (hval<<4) + (hval<<7) + (hval<<8) + (hval<<24);
+            hval = hval ^ (unsigned int)(*current);
+            ++current;
+        }
+        return hval;
+    }
+
+    // -------------------------------------------------------------------------
+    static const uint64_t Prime64_1 = 0x9E3779B185EBCA87ull;
+    static const uint64_t Prime64_2 = 0xC2B2AE3D27D4EB4Full;
+    static const uint64_t Prime64_3 = 0x165667B19E3779F9ull;
+    static const uint64_t Prime64_4 = 0x85EBCA77C2B2AE63ull;
+    static const uint64_t Prime64_5 = 0x27D4EB2F165667C5ull;
+
+    static inline uint64_t Rotl64(uint64_t x, int r)
+    {
+        return (x << r) | (x >> (64 - r));
+    }
+
+    static inline uint64_t Read64(const uint8_t* p)
+    {
+        uint64_t v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    static inline uint32_t Read32(const uint8_t* p)
+    {
+        uint32_t v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    static inline uint64_t Round64(uint64_t acc, uint64_t input)
+    {
+        acc += input * Prime64_2;
+        acc = Rotl64(acc, 31);
+        return acc * Prime64_1;
+    }
+
+    static inline uint64_t Merge64(uint64_t acc, uint64_t val)
+    {
+        acc ^= Round64(0, val);
+        return acc * Prime64_1 + Prime64_4;
+    }
+
+    // -------------------------------------------------------------------------
+    hash64_t Hash64(const void * data, size_t size, hash64_t seed)
+    {
+        const uint8_t* p = (const uint8_t*)data;
+        const uint8_t* end = p + size;
+        uint64_t h;
+
+        if(size >= 32)
+        {
+            // four independent lanes of 8 bytes.
+            const uint8_t* limit = end - 32;
+            uint64_t v1 = seed + Prime64_1 + Prime64_2;
+            uint64_t v2 = seed + Prime64_2;
+            uint64_t v3 = seed;
+            uint64_t v4 = seed - Prime64_1;
+            do
+            {
+                v1 = Round64(v1, Read64(p)); p += 8;
+                v2 = Round64(v2, Read64(p)); p += 8;
+                v3 = Round64(v3, Read64(p)); p += 8;
+                v4 = Round64(v4, Read64(p)); p += 8;
+            } while(p <= limit);
+
+            h = Rotl64(v1, 1) + Rotl64(v2, 7) + Rotl64(v3, 12) + Rotl64(v4, 18);
+            h = Merge64(h, v1);
+            h = Merge64(h, v2);
+            h = Merge64(h, v3);
+            h = Merge64(h, v4);
+        }
+        else
+        {
+            h = seed + Prime64_5;
+        }
+
+        h += (uint64_t)size;
+        while(p + 8 <= end)
+        {
+            h ^= Round64(0, Read64(p));
+            h = Rotl64(h, 27) * Prime64_1 + Prime64_4;
+            p += 8;
+        }
+        if(p + 4 <= end)
+        {
+            h ^= (uint64_t)Read32(p) * Prime64_1;
+            h = Rotl64(h, 23) * Prime64_2 + Prime64_3;
+            p += 4;
+        }
+        while(p < end)
+        {
+            h ^= (*p) * Prime64_5;
+            h = Rotl64(h, 11) * Prime64_1;
+            ++p;
+        }
+
+        h ^= h >> 33;
+        h *= Prime64_2;
+        h ^= h >> 29;
+        h *= Prime64_3;
+        h ^= h >> 32;
+        return h;
+    }
+
 }; // namespace LvEdEngine
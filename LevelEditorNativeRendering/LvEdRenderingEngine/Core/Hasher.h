@@ -16,4 +16,10 @@ namespace LvEdEngine
     // generate an hash for a string
     hash32_t Hash32(const char * string);
     hash32_t HashLowercase32(const char * string);
+    hash32_t Hash32(const wchar_t * string, hash32_t hval = Hash32InitialValue);
+
+    // -------------------------------------------------------------------------
+    // fast 64 bit hash of a block of memory (xxHash64), for file contents.
+    typedef uint64_t hash64_t;
+    hash64_t Hash64(const void * data, size_t size, hash64_t seed = 0);
 };
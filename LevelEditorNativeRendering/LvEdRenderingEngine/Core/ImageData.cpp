@@ -40,7 +40,7 @@ namespace LvEdEngine
      }
 }
 
-static const uint64_t szLimit  = 16i64 * 1024i64 * 1024i64 * 1024i64; 
+static const uint64_t szLimit  = 16ULL * 1024ULL * 1024ULL * 1024ULL; 
 
 void ImageData::CreateNew(int32_t width, int32_t height, uint32_t format)
 {
@@ -4,7 +4,7 @@
 #include "Object.h"
 #include <stdint.h>
 #include <assert.h>
-#include "../VectorMath/V3dmath.h"
+#include "../VectorMath/V3dMath.h"
 #include "../VectorMath/CollisionPrimitives.h"
 
 
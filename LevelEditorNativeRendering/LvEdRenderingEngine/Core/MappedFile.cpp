@@ -0,0 +1,224 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    MappedFile.cpp
+
+    Win32 file mappings, or mmap() for the POSIX builds.
+****************************************************************************/
+#include "MappedFile.h"
+#include <string.h>
+#include "WinHeaders.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+using namespace LvEdEngine;
+
+// the view of an empty file.
+static uint8_t s_emptyView[1] = { 0 };
+
+//---------------------------------------------------------------------------
+static size_t PageSize()
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+#else
+    return (size_t)sysconf(_SC_PAGESIZE);
+#endif
+}
+
+//---------------------------------------------------------------------------
+MappedFile::MappedFile()
+  : m_data(NULL),
+    m_size(0),
+    m_view(NULL),
+    m_copy(NULL)
+#ifdef _WIN32
+    , m_mapping(NULL)
+#endif
+{
+}
+
+//---------------------------------------------------------------------------
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+//---------------------------------------------------------------------------
+bool MappedFile::Open(const wchar_t* filename, Access access, bool zeroTerminated)
+{
+    Close();
+    if(!Map(filename, access))
+    {
+        Close();
+        return false;
+    }
+
+    if(zeroTerminated && m_view && (m_size % PageSize()) == 0)
+    {
+        // no room left in the last page for the terminator.
+        m_copy = new uint8_t[m_size + 1];
+        memcpy(m_copy, m_data, m_size);
+        m_copy[m_size] = 0;
+        Unmap();
+        m_data = m_copy;
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------
+void MappedFile::Close()
+{
+    Unmap();
+    delete[] m_copy;
+    m_copy = NULL;
+    m_data = NULL;
+    m_size = 0;
+}
+
+//---------------------------------------------------------------------------
+void MappedFile::Prefetch() const
+{
+    if(!m_view)
+        return;
+    const size_t pageSize = PageSize();
+    const volatile uint8_t* data = m_data;
+    uint8_t sum = 0;
+    for(size_t i = 0; i < m_size; i += pageSize)
+        sum += data[i];
+    (void)sum;
+}
+
+#ifdef _WIN32
+//---------------------------------------------------------------------------
+// true if the file may disappear while it is mapped.
+static bool IsOnRemoteOrRemovableDrive(const wchar_t* filename)
+{
+    wchar_t root[MAX_PATH];
+    if(!GetVolumePathNameW(filename, root, MAX_PATH))
+        return false;
+    UINT type = GetDriveTypeW(root);
+    return type == DRIVE_REMOTE || type == DRIVE_REMOVABLE;
+}
+
+//---------------------------------------------------------------------------
+static bool ReadWholeFile(HANDLE file, uint8_t* dst, size_t size)
+{
+    while(size > 0)
+    {
+        DWORD chunk = size > 0x40000000 ? 0x40000000 : (DWORD)size;
+        DWORD read = 0;
+        if(!ReadFile(file, dst, chunk, &read, NULL) || read == 0)
+            return false;
+        dst += read;
+        size -= read;
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------
+bool MappedFile::Map(const wchar_t* filename, Access access)
+{
+    HANDLE file = CreateFileW(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if(file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize;
+    if(!GetFileSizeEx(file, &fileSize) || (uint64_t)fileSize.QuadPart > (size_t)-1)
+    {
+        CloseHandle(file);
+        return false;
+    }
+    m_size = (size_t)fileSize.QuadPart;
+    if(m_size == 0)
+    {
+        // empty files can't be mapped.
+        CloseHandle(file);
+        m_data = s_emptyView;
+        return true;
+    }
+
+    if(IsOnRemoteOrRemovableDrive(filename))
+    {
+        // a private copy, with room for the terminator of Open().
+        m_copy = new uint8_t[m_size + 1];
+        m_copy[m_size] = 0;
+        bool read = ReadWholeFile(file, m_copy, m_size);
+        CloseHandle(file);
+        if(!read)
+            return false;
+        m_data = m_copy;
+        return true;
+    }
+
+    // the mapping keeps the file open.
+    m_mapping = CreateFileMappingW(file, NULL, access == CopyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if(!m_mapping)
+        return false;
+    m_view = MapViewOfFile(m_mapping, access == CopyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+    if(!m_view)
+        return false;
+    m_data = (uint8_t*)m_view;
+    return true;
+}
+
+//---------------------------------------------------------------------------
+void MappedFile::Unmap()
+{
+    if(m_view)
+        UnmapViewOfFile(m_view);
+    if(m_mapping)
+        CloseHandle(m_mapping);
+    m_mapping = NULL;
+    m_view = NULL;
+}
+#else
+//---------------------------------------------------------------------------
+bool MappedFile::Map(const wchar_t* filename, Access access)
+{
+    // the engine's paths may use backslashes, like for CreateFileW().
+    int fd = open(Win32Posix::NativePath(filename).c_str(), O_RDONLY);
+    if(fd < 0)
+        return false;
+    struct stat st;
+    if(fstat(fd, &st) != 0)
+    {
+        close(fd);
+        return false;
+    }
+    m_size = (size_t)st.st_size;
+    if(m_size == 0)
+    {
+        close(fd);
+        m_data = s_emptyView;
+        return true;
+    }
+
+    // private mappings are copy on write, the mapping keeps the file open.
+    int prot = access == CopyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ;
+    void* view = mmap(NULL, m_size, prot, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(view == MAP_FAILED)
+        return false;
+    posix_madvise(view, m_size, POSIX_MADV_SEQUENTIAL);
+    m_view = view;
+    m_data = (uint8_t*)view;
+    return true;
+}
+
+//---------------------------------------------------------------------------
+void MappedFile::Unmap()
+{
+    if(m_view)
+        munmap(m_view, m_size);
+    m_view = NULL;
+}
+#endif
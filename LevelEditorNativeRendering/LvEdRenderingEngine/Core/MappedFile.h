@@ -0,0 +1,64 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    MappedFile.h
+
+    Maps a whole file into the address space so parsers read it in place
+    instead of from a copy on the heap. Pages are brought in by the OS as
+    they are touched and are shared with the file cache.
+    A ReadOnly view must not be written to. A CopyOnWrite view is private:
+    writing to it copies the touched pages and never changes the file, for
+    parsers that modify their input such as rapidxml in situ parsing.
+    On Windows, files on network shares and removable drives are read into
+    the heap instead: a view of them raises an in-page error on access once
+    the share or the drive goes away.
+****************************************************************************/
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "NonCopyable.h"
+
+namespace LvEdEngine
+{
+    class MappedFile : public NonCopyable
+    {
+    public:
+        enum Access
+        {
+            ReadOnly,
+            CopyOnWrite,
+        };
+
+        MappedFile();
+        ~MappedFile();
+
+        // Maps filename, closing what was open before. With zeroTerminated
+        // the byte after the view is 0: the OS fills the end of the last page
+        // with zeros, so a copy is only made when the file size is a multiple
+        // of the page size.
+        bool Open(const wchar_t* filename, Access access = ReadOnly, bool zeroTerminated = false);
+        void Close();
+
+        bool IsOpen() const { return m_data != NULL; }
+        // NULL when closed, an empty file has a valid empty view.
+        uint8_t* GetData() const { return m_data; }
+        size_t GetSize() const { return m_size; }
+
+        // touches every page so that the disk reads happen now rather than
+        // while the view is parsed.
+        void Prefetch() const;
+
+    private:
+        bool Map(const wchar_t* filename, Access access);
+        void Unmap();
+
+        uint8_t* m_data;
+        size_t   m_size;
+        void*    m_view;     // the mapping, NULL for empty files and copies.
+        uint8_t* m_copy;     // allocated with new[] when the view had to be copied, or the file was read.
+#ifdef _WIN32
+        void*    m_mapping;  // HANDLE of the file mapping object.
+#endif
+    };
+}
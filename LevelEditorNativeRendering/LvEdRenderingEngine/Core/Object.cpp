@@ -1,2 +1,68 @@
 //Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
 
+
+#include "Object.h"
+#include "WinHeaders.h"
+#include <vector>
+#include <algorithm>
+
+using namespace LvEdEngine;
+
+// objects are created by the loader threads too.
+static SRWLOCK s_indexLock = SRWLOCK_INIT;
+static uint32_t s_nextIndex = 0;
+// never freed, objects can outlive the static destructors.
+static std::vector<uint32_t>* s_freeIndices = NULL;
+// the live object of each index, NULL for the free indices.
+static std::vector<Object*>* s_objects = NULL;
+
+//---------------------------------------------------------------------------
+Object::Object()
+{
+    AcquireSRWLockExclusive(&s_indexLock);
+    if(s_freeIndices && !s_freeIndices->empty())
+    {
+        m_objectIndex = s_freeIndices->back();
+        s_freeIndices->pop_back();
+    }
+    else
+    {
+        m_objectIndex = s_nextIndex++;
+    }
+    if(s_objects == NULL)
+        s_objects = new std::vector<Object*>();
+    if(m_objectIndex >= s_objects->size())
+        s_objects->resize(m_objectIndex + 1, NULL);
+    (*s_objects)[m_objectIndex] = this;
+    ReleaseSRWLockExclusive(&s_indexLock);
+}
+
+//---------------------------------------------------------------------------
+Object::~Object()
+{
+    AcquireSRWLockExclusive(&s_indexLock);
+    if(s_freeIndices == NULL)
+        s_freeIndices = new std::vector<uint32_t>();
+    s_freeIndices->push_back(m_objectIndex);
+    (*s_objects)[m_objectIndex] = NULL;
+    ReleaseSRWLockExclusive(&s_indexLock);
+}
+
+//---------------------------------------------------------------------------
+void Object::FindLive(const std::vector<ObjectGUID>& sortedIds, std::vector<LiveId>* found)
+{
+    if(sortedIds.empty())
+        return;
+    AcquireSRWLockShared(&s_indexLock);
+    uint32_t count = s_objects ? (uint32_t)s_objects->size() : 0;
+    for(uint32_t index = 0; index < count; ++index)
+    {
+        Object* obj = (*s_objects)[index];
+        if(obj && std::binary_search(sortedIds.begin(), sortedIds.end(), obj->GetInstanceId()))
+        {
+            LiveId live = { obj->GetInstanceId(), index };
+            found->push_back(live);
+        }
+    }
+    ReleaseSRWLockShared(&s_indexLock);
+}
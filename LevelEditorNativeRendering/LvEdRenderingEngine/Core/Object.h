@@ -5,6 +5,7 @@
 #include "typedefs.h"
 #include "NonCopyable.h"
 #include <stdint.h>
+#include <vector>
 
 namespace LvEdEngine
 {    
@@ -12,13 +13,34 @@ namespace LvEdEngine
     class Object : public NonCopyable
     {
     public:
+        Object();
         virtual const char* ClassName()  const  = 0;
         ObjectGUID GetInstanceId() const
         {
             return (ObjectGUID)this;
         }
-        virtual ~Object(void){}
+
+        // small dense index of this object, the indices of destroyed objects
+        // are reused. Used to keep per object data in flat arrays, see Selection.
+        uint32_t GetObjectIndex() const { return m_objectIndex; }
+
+        // a live object and its index.
+        struct LiveId
+        {
+            ObjectGUID id;
+            uint32_t   index;
+        };
+
+        // adds the ids of sortedIds that are live objects to found, without
+        // dereferencing any of them. Walks every object index, it's meant for
+        // ids that come from the editor, like the selection.
+        static void FindLive(const std::vector<ObjectGUID>& sortedIds, std::vector<LiveId>* found);
+
+        virtual ~Object(void);
 
         virtual void Invoke(wchar_t* /*fn*/, const void* /*arg*/, void** /*retVal*/) {}
+
+    private:
+        uint32_t m_objectIndex;
     };
 }
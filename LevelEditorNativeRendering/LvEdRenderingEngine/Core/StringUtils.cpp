@@ -1,6 +1,7 @@
 //Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
 
 #include "StringUtils.h"
+#include <wchar.h>
 
 namespace StrUtils
 {
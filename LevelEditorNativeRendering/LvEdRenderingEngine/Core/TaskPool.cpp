@@ -0,0 +1,135 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+#include "TaskPool.h"
+#include "Logger.h"
+#include <assert.h>
+
+namespace LvEdEngine
+{
+    static const uint32_t MaxWorkers = 15;
+
+    // ----------------------------------------------------------------------------------------------
+    TaskPool::TaskPool(uint32_t numWorkers)
+        : m_exitRequested(false),
+          m_func(NULL),
+          m_userData(NULL),
+          m_count(0),
+          m_next(0),
+          m_busy(0)
+    {
+        if(numWorkers > MaxWorkers)
+            numWorkers = MaxWorkers;
+
+        m_wakeSemaphore = CreateSemaphore(NULL, 0, MaxWorkers, NULL);
+        m_doneEvent = CreateEvent(NULL, false, false, NULL);
+
+        // reserve first, workers keep a pointer to their entry.
+        m_workers.resize(numWorkers);
+        for(uint32_t i = 0; i < numWorkers; ++i)
+        {
+            m_workers[i].pool = this;
+            m_workers[i].thread = i + 1; // thread 0 is the caller of Run().
+            HANDLE handle = CreateThread(NULL, 0, &TaskPool::ThreadProc, &m_workers[i], 0, NULL);
+            if(handle == NULL)
+            {
+                Logger::Log(OutputMessageType::Warning, L"TaskPool: failed to create worker thread %d\n", i);
+                m_workers.resize(i);
+                break;
+            }
+            m_threads.push_back(handle);
+        }
+    }
+
+    // ----------------------------------------------------------------------------------------------
+    TaskPool::~TaskPool()
+    {
+        m_exitRequested = true;
+        if(!m_threads.empty())
+        {
+            ReleaseSemaphore(m_wakeSemaphore, (LONG)m_threads.size(), NULL);
+            WaitForMultipleObjects((DWORD)m_threads.size(), &m_threads[0], TRUE, INFINITE);
+        }
+        for(auto it = m_threads.begin(); it != m_threads.end(); ++it)
+        {
+            CloseHandle(*it);
+        }
+        CloseHandle(m_wakeSemaphore);
+        CloseHandle(m_doneEvent);
+    }
+
+    // ----------------------------------------------------------------------------------------------
+    //static
+    uint32_t TaskPool::DefaultWorkerCount()
+    {
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        uint32_t count = info.dwNumberOfProcessors > 1 ? info.dwNumberOfProcessors - 1 : 0;
+        return count > MaxWorkers ? MaxWorkers : count;
+    }
+
+    // ----------------------------------------------------------------------------------------------
+    DWORD WINAPI TaskPool::ThreadProc(void* arg)
+    {
+        Worker* worker = (Worker*)arg;
+        TaskPool* pool = worker->pool;
+        for(;;)
+        {
+            WaitForSingleObject(pool->m_wakeSemaphore, INFINITE);
+            if(pool->m_exitRequested)
+                break;
+
+            pool->Execute(worker->thread);
+
+            // the semaphore is released once per worker so the number of
+            // wake-ups matches m_busy even if one worker wakes up twice.
+            if(InterlockedDecrement(&pool->m_busy) == 0)
+                SetEvent(pool->m_doneEvent);
+        }
+        return 0;
+    }
+
+    // ----------------------------------------------------------------------------------------------
+    void TaskPool::Execute(uint32_t thread)
+    {
+        for(;;)
+        {
+            LONG index = InterlockedIncrement(&m_next) - 1;
+            if(index >= m_count)
+                break;
+            m_func(m_userData, (uint32_t)index, thread);
+        }
+    }
+
+    // ----------------------------------------------------------------------------------------------
+    void TaskPool::Run(uint32_t count, TaskFunc func, void* userData)
+    {
+        assert(func);
+        if(count == 0)
+            return;
+
+        if(m_threads.empty() || count == 1)
+        {
+            for(uint32_t i = 0; i < count; ++i)
+                func(userData, i, 0);
+            return;
+        }
+
+        m_func = func;
+        m_userData = userData;
+        m_count = (LONG)count;
+        m_next = 0;
+
+        // don't wake more workers than there are tasks left for them.
+        LONG numWake = (LONG)m_threads.size();
+        if(numWake > (LONG)count - 1)
+            numWake = (LONG)count - 1;
+        m_busy = numWake;
+        MemoryBarrier();
+        ReleaseSemaphore(m_wakeSemaphore, numWake, NULL);
+
+        Execute(0);
+        WaitForSingleObject(m_doneEvent, INFINITE);
+        m_func = NULL;
+        m_userData = NULL;
+    }
+}
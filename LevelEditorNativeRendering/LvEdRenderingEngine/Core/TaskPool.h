@@ -0,0 +1,59 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+#pragma once
+#include <vector>
+#include "WinHeaders.h"
+#include "NonCopyable.h"
+
+namespace LvEdEngine
+{
+    // A small pool of persistent worker threads used to split per-frame work
+    // into independent tasks.
+    // Run() hands out task indices to the workers and to the calling thread
+    // and returns once every task has finished.
+    class TaskPool : public NonCopyable
+    {
+    public:
+        // index is in [0, count); thread is in [0, GetThreadCount()) and
+        // is unique among the threads running tasks of the same Run() call.
+        typedef void (*TaskFunc)(void* userData, uint32_t index, uint32_t thread);
+
+        // numWorkers is the number of threads created in addition to
+        // the calling thread; 0 makes Run() execute every task inline.
+        explicit TaskPool(uint32_t numWorkers);
+        ~TaskPool();
+
+        // number of threads that can run tasks, including the calling thread.
+        uint32_t GetThreadCount() const { return (uint32_t)m_threads.size() + 1; }
+
+        // runs func for each index in [0, count) and waits for all of them.
+        // must only be called from one thread at a time.
+        void Run(uint32_t count, TaskFunc func, void* userData);
+
+        // number of workers worth creating on this machine.
+        static uint32_t DefaultWorkerCount();
+
+    private:
+        struct Worker
+        {
+            TaskPool* pool;
+            uint32_t  thread;
+        };
+
+        static DWORD WINAPI ThreadProc(void* arg);
+        void Execute(uint32_t thread);
+
+        std::vector<HANDLE> m_threads;
+        std::vector<Worker> m_workers;
+        HANDLE m_wakeSemaphore;  // released once per worker for each Run().
+        HANDLE m_doneEvent;      // set when the last worker is done.
+        volatile bool m_exitRequested;
+
+        // state of the current Run().
+        TaskFunc m_func;
+        void* m_userData;
+        LONG m_count;
+        volatile LONG m_next;
+        volatile LONG m_busy;
+    };
+}
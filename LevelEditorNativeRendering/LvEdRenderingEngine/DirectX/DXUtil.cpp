@@ -1,7 +1,7 @@
 //Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
 
 #include "DXUtil.h"
-#include <D3D11.h>
+#include <d3d11.h>
 #include "../Core/Utils.h"
 #include "../Core/FileUtils.h"
 #include "../Core/Logger.h"
@@ -40,6 +40,34 @@
     return hr;
 }
 
+HRESULT DXUtil::LoadTexture(const wchar_t* file, const void* data, size_t size, TexMetadata* metadata, DirectX::ScratchImage& image)
+{
+    HRESULT hr = S_OK;
+    std::wstring ext = FileUtils::GetExtensionLower(file);
+    if(!data || size == 0) return E_INVALIDARG;
+
+    if(ext == L".dds")
+    {
+        hr = LoadFromDDSMemory( data, size, DDS_FLAGS_FORCE_RGB, metadata, image );
+    }
+    else if(ext == L".tga")
+    {
+        hr = LoadFromTGAMemory(data, size, metadata, image);
+    }
+    else if(ext == L".bmp"
+         || ext == L".png"
+         || ext == L".jpg" || ext == L".jpeg"
+         || ext == L".tif" || ext == L".tiff")
+    {
+        hr = LoadFromWICMemory(data, size, WIC_FLAGS_FORCE_RGB, metadata, image);
+    }
+    else
+    {
+        hr = E_INVALIDARG;
+    }
+    return hr;
+}
+
 // Gets wic codec from file extension
 REFGUID DXUtil::GetWICCodecFromFileExtension(const wchar_t* extension)
 {
@@ -2,10 +2,10 @@
 
 #pragma once
 #include <stdint.h>
-#include <D3D11.h>
+#include <d3d11.h>
 #include "../Core/WinHeaders.h"
 #include "../Core/Utils.h"
-#include "../core/Logger.h"
+#include "../Core/Logger.h"
 #include "DirectXTex/DirectXTex.h"
 #include <assert.h>
 
@@ -15,6 +15,8 @@ class DXUtil
 
     // load texture  memory.
     static HRESULT LoadTexture(const wchar_t* file, DirectX::TexMetadata* metadata, DirectX::ScratchImage& image);
+    // same from the contents of the file, the name only gives the format.
+    static HRESULT LoadTexture(const wchar_t* file, const void* data, size_t size, DirectX::TexMetadata* metadata, DirectX::ScratchImage& image);
    
     // Gets wic codec from file extension
     // extension must be in lower case.
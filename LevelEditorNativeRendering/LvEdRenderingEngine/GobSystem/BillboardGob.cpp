@@ -17,7 +17,7 @@ namespace LvEdEngine
 //virtual 
 void BillboardGob::GetRenderables(RenderableNodeCollector* collector, RenderContext* context)
 {
-		if (!IsVisible(context->Cam().GetFrustum()))
+		if (!IsVisible(context))
 			return;
 
 		super::GetRenderables(collector, context);
@@ -65,6 +65,7 @@ namespace LvEdEngine
     m_localBounds = AABB(float3(-0.5f,-0.5f,-0.5f),float3(0.5f,0.5f,0.5f));
     m_bounds = m_localBounds;
     m_bounds.Transform(billboard);
+    m_boundsVersion++;
     r->bounds = m_bounds;    
 }
 
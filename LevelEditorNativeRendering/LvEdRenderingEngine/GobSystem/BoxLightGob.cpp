@@ -31,20 +31,24 @@ namespace LvEdEngine
 void BoxLightGob::SetAmbient(int color)
 {
     ConvertColor(color, &m_light->ambient);
+    LightingState::Inst()->LightChanged(m_light);
 }
 
 void BoxLightGob::SetDiffuse(int color)
 {
     ConvertColor(color, &m_light->diffuse);
+    LightingState::Inst()->LightChanged(m_light);
 }
 
 void BoxLightGob::SetSpecular(int color)
 {
     ConvertColor(color, &m_light->specular);
+    LightingState::Inst()->LightChanged(m_light);
 }
 void BoxLightGob::SetDirection(const float3& v)
 {
     m_light->dir = normalize(v);
+    LightingState::Inst()->LightChanged(m_light);
 }
 
 float3 BoxLightGob::GetDirection()
@@ -55,12 +59,13 @@ namespace LvEdEngine
 void BoxLightGob::SetAttenuation(const float3& atten)
 {
     m_light->attenuation = float4(atten.x,atten.y,atten.z,1);
+    LightingState::Inst()->LightChanged(m_light);
 }
 
 void BoxLightGob::GetRenderables(RenderableNodeCollector* collector, RenderContext* context)
 {     
     
-	if (!IsVisible(context->Cam().GetFrustum())) return;
+	if (!IsVisible(context)) return;
 
 	// No need to call super::GetRenderables	
 	//super::GetRenderables(collector, context);
@@ -89,6 +94,7 @@ namespace LvEdEngine
     super::Update(fr,updateType);
     m_light->min = m_bounds.Min();
     m_light->max = m_bounds.Max();
+    LightingState::Inst()->LightChanged(m_light);
 }
 
 };
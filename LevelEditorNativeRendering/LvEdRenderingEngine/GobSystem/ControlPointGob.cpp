@@ -42,6 +42,7 @@ namespace LvEdEngine
         max = maximize(max, transformed);
     }
     m_bounds = AABB(min,max);
+    m_boundsVersion++;
 
     // give it same color as curve
     int color = 0xFFFF0000;
@@ -56,6 +57,7 @@ namespace LvEdEngine
     r.mesh = mesh;
     ConvertColor(color, &r.diffuse);
     r.objectId = GetInstanceId();
+    r.objectIndex = GetObjectIndex();
     r.bounds = m_bounds;
     r.WorldXform = billboard;
     r.SetFlag(RenderableNode::kTestAgainstBBoxOnly, true);
@@ -96,7 +96,7 @@ namespace LvEdEngine
 //virtual
 void CurveGob::GetRenderables(RenderableNodeCollector* collector, RenderContext* context)
 {
-	if (!IsVisible(context->Cam().GetFrustum()) || m_points.size() < 2)
+	if (!IsVisible(context) || m_points.size() < 2)
 		return;
     
 	super::GetRenderables(collector, context);
@@ -105,6 +105,7 @@ namespace LvEdEngine
     r.mesh = &m_mesh;
     ConvertColor(m_color, &r.diffuse);
     r.objectId = GetInstanceId();
+    r.objectIndex = GetObjectIndex();
     r.SetFlag( RenderableNode::kShadowCaster, false );
     r.SetFlag( RenderableNode::kShadowReceiver, false );
     r.bounds = m_bounds;
@@ -164,6 +165,7 @@ namespace LvEdEngine
         max = maximize(max, (*it)->GetBounds().Max());
     }
     m_bounds = AABB(min,max);                    
+    m_boundsVersion++;
     m_boundsDirty = false;
     std::vector<float3> verts;
     switch(m_type)
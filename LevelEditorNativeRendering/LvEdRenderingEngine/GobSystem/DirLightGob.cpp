@@ -27,20 +27,24 @@ namespace LvEdEngine
 void DirLightGob::SetAmbient(int color)
 {
     ConvertColor(color, &m_light->ambient);
+    LightingState::Inst()->LightChanged(m_light);
 }
 
 void DirLightGob::SetDiffuse(int color)
 {
     ConvertColor(color, &m_light->diffuse);
+    LightingState::Inst()->LightChanged(m_light);
 }
 
 void DirLightGob::SetSpecular(int color)
 {
     ConvertColor(color, &m_light->specular);
+    LightingState::Inst()->LightChanged(m_light);
 }
 void DirLightGob::SetDirection(const float3& v)
 {
     m_light->dir = normalize(v);
+    LightingState::Inst()->LightChanged(m_light);
 }
 
 }
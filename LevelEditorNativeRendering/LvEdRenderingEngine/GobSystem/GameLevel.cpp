@@ -1,8 +1,75 @@
 //Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
 
 #include "GameLevel.h"
+#include "../Core/TaskPool.h"
+#include "../Core/Utils.h"
+#include "../Renderer/RenderableNodeSorter.h"
+#include "../Renderer/RenderContext.h"
 
 namespace LvEdEngine
 {
+    struct CollectData
+    {
+        GameObject* parent;
+        std::vector<GameObject*>* children;
+        std::vector<RenderableNodeSorter*>* sorters;
+        RenderContext* context;
+    };
 
+    // ----------------------------------------------------------------------------------
+    GameLevel::~GameLevel()
+    {
+        for(auto it = m_threadSorters.begin(); it != m_threadSorters.end(); ++it)
+        {
+            SAFE_DELETE(*it);
+        }
+    }
+
+    // ----------------------------------------------------------------------------------
+    //static
+    void GameLevel::CollectSubtree(void* userData, uint32_t index, uint32_t thread)
+    {
+        CollectData* data = (CollectData*)userData;
+        RenderableNodeSorter* sorter = (*data->sorters)[thread];
+        // the child index orders the nodes when the sorters are merged.
+        sorter->SetRunKey(index);
+        GameObject* child = (*data->children)[index];
+        child->InheritCullPlanes(data->parent);
+        child->GetRenderables(sorter, data->context);
+    }
+
+    // ----------------------------------------------------------------------------------
+    void GameLevel::GetRenderablesParallel(RenderableNodeSorter* sorter, RenderContext* context, TaskPool* pool)
+    {
+        if(pool == NULL || pool->GetThreadCount() < 2 || m_children.size() < 2)
+        {
+            GetRenderables(sorter, context);
+            return;
+        }
+
+        if (!IsVisible(context))
+            return;
+
+        // the level's own components come first, as in GameObjectGroup::GetRenderables()
+        GameObject::GetRenderables(sorter, context);
+
+        uint32_t threadCount = pool->GetThreadCount();
+        while(m_threadSorters.size() < threadCount)
+        {
+            m_threadSorters.push_back(new RenderableNodeSorter());
+        }
+        for(uint32_t i = 0; i < threadCount; ++i)
+        {
+            m_threadSorters[i]->SetFlags(sorter->GetFlags());
+        }
+
+        CollectData data;
+        data.parent = this;
+        data.children = &m_children;
+        data.sorters = &m_threadSorters;
+        data.context = context;
+        pool->Run((uint32_t)m_children.size(), &GameLevel::CollectSubtree, &data);
+
+        sorter->Merge(&m_threadSorters[0], threadCount, pool);
+    }
 }
\ No newline at end of file
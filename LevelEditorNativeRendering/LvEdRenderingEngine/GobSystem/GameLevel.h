@@ -8,12 +8,15 @@ namespace LvEdEngine
 {
     class SkyDome;
     class TerrainGob;
+    class TaskPool;
+    class RenderableNodeSorter;
     // this is the root top level containter for game objects.    
 	class GameLevel : public GameObjectGroup
 	{
 	public:   
 
         GameLevel(): m_activeskyeDome(NULL) {}
+        virtual ~GameLevel();
         virtual const char* ClassName() const {return StaticClassName();}
         static const char* StaticClassName(){return "GameLevel";}
                
@@ -26,8 +29,17 @@ class GameLevel : public GameObjectGroup
         void SetFogDensity(float density) { m_fog.density = density;  }       
 
         const ExpFog& GetFog() const {return m_fog;}
+
+        // Same as GetRenderables() but the top level children are collected
+        // on the pool threads, each into its own sorter, and merged into sorter.
+        // The resulting buckets are identical to the ones of the serial path.
+        void GetRenderablesParallel(RenderableNodeSorter* sorter, RenderContext* context, TaskPool* pool);
+
     private:
+        static void CollectSubtree(void* userData, uint32_t index, uint32_t thread);
+
         ExpFog m_fog;     
+        std::vector<RenderableNodeSorter*> m_threadSorters; // one per pool thread.
     private:
         typedef GameObjectGroup super;
 
@@ -1,8 +1,11 @@
 //Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
 
-#include <D3D11.h>
+#include <d3d11.h>
 #include "GameObject.h"
 #include "GameObjectComponent.h"
+#include "../Core/StringUtils.h"
+#include "../ResourceManager/ResourceManager.h"
+#include "../Renderer/Resource.h"
 #include <algorithm>
 
 namespace LvEdEngine
@@ -15,9 +18,16 @@ namespace LvEdEngine
         m_visible = true;
         m_castsShadows = true;
         m_receivesShadows = true;
+        m_occluder = false;
+        m_cullStamp = 0;
+        m_cullPlanes = Frustum::AllPlanes;
+        m_childCullStamp = 0;
+        m_childCullPlanes = Frustum::AllPlanes;
+        m_cullLastPlane = 0;
 
         m_localBounds = AABB(float3(-0.5f,-0.5f,-0.5f), float3(0.5f,0.5f,0.5f));
         m_bounds = m_localBounds;
+        m_boundsVersion = 0;
     }
 
     // ----------------------------------------------------------------------------------
@@ -98,6 +108,7 @@ namespace LvEdEngine
         {            
             m_bounds = m_localBounds;
             m_bounds.Transform(m_world);            
+            m_boundsVersion++;
             m_boundsDirty = false;
             m_worldBoundUpdated = true;
         }
@@ -152,12 +163,42 @@ namespace LvEdEngine
     // ----------------------------------------------------------------------------------
     bool GameObject::IsVisible(const Frustum& frustum) const
     {
-        bool visible = m_visible;
-        if(m_visible)
+        if(!m_visible)
+            return false;
+
+        uint32_t planes = (m_cullStamp == frustum.GetStamp()) ? m_cullPlanes : Frustum::AllPlanes;
+        uint32_t lastPlane = m_cullLastPlane;
+        bool visible = FrustumAABBIntersect(frustum, m_bounds, &planes, &lastPlane) != 0;
+        m_cullLastPlane = lastPlane;
+        m_childCullPlanes = visible ? planes : Frustum::AllPlanes;
+        m_childCullStamp = frustum.GetStamp();
+        return visible;
+    }
+
+    // ----------------------------------------------------------------------------------
+    bool GameObject::IsVisible(RenderContext* context) const
+    {
+        if(!IsVisible(context->Cam().GetFrustum()))
+            return false;
+        // keep the selection visible however small it is.
+        return !context->IsSmallFeature(m_bounds) || context->selection.IsSelected(this);
+    }
+
+    // ----------------------------------------------------------------------------------
+    void GameObject::PrioritizeResource(Resource* res, RenderContext* context) const
+    {
+        if(res && !res->IsReady())
         {
-            visible = TestFrustumAABB(frustum, m_bounds);
+            float distance = length(m_bounds.GetCenter() - context->Cam().CamPos());
+            ResourceManager::Inst()->RaisePriority(res, ResourceManager::VisiblePriority(distance));
         }
-        return visible;
+    }
+
+    // ----------------------------------------------------------------------------------
+    void GameObject::InheritCullPlanes(const GameObject* parent)
+    {
+        m_cullPlanes = parent->m_childCullPlanes;
+        m_cullStamp = parent->m_childCullStamp;
     }
 
 
@@ -169,11 +210,29 @@ namespace LvEdEngine
     }
 
    
+    // ----------------------------------------------------------------------------------
+    void GameObject::SetOccluder(bool occluder)
+    {
+        m_occluder = occluder;
+        InvalidateWorld(); // cached renderables pick up the flag when they are rebuilt.
+    }
+
+    // ----------------------------------------------------------------------------------
+    //virtual
+    void GameObject::Invoke(wchar_t* fn, const void* arg, void** /*retVal*/)
+    {
+        if(StrUtils::Equal(fn,L"SetOccluder"))
+        {
+            assert(arg);
+            if(arg) SetOccluder(*(const bool*)arg);
+        }
+    }
+
     // ----------------------------------------------------------------------------------
     //virtual
 	void GameObject::GetRenderables(RenderableNodeCollector* collector, RenderContext* context)
     {
-		if (!IsVisible(context->Cam().GetFrustum()))
+		if (!IsVisible(context))
 			return;	
 		for (auto it = m_components.begin(); it != m_components.end(); ++it)
 		{
@@ -185,11 +244,14 @@ namespace LvEdEngine
     void GameObject::SetupRenderable(RenderableNode* r, RenderContext* /*context*/)
     {
         r->objectId = GetInstanceId();
+        r->objectIndex = GetObjectIndex();
         r->bounds = m_bounds;
         r->WorldXform = m_world;
         r->SetFlag( RenderableNode::kShadowCaster, GetCastsShadows() );
         r->SetFlag( RenderableNode::kShadowReceiver, GetReceivesShadows() );
-        LightingState::Inst()->UpdateLightEnvironment( *r );
+        r->SetFlag( RenderableNode::kOccluder, GetOccluder() );
+        LightingState::Inst()->UpdateLightEnvironment( m_lighting, m_bounds, m_boundsVersion, m_lightingStamp );
+        r->lighting = m_lighting;
     }
 
 
@@ -16,6 +16,7 @@ namespace LvEdEngine
 {
     
     class GameObjectComponent;
+    class Resource;
     class QueryFunctor
     {
     public:
@@ -38,16 +39,31 @@ class GameObject : public Object
         const Matrix& GetWorldTransform() const  { return m_world; }
         const AABB& GetBounds() const;
         const AABB& GetLocalBounds() const;
+        // incremented every time the world bounds change.
+        uint32_t GetBoundsVersion() const { return m_boundsVersion; }
         bool IsVisible() const;
+        // only tests the frustum planes the parent straddles when the parent
+        // was tested against the same frustum, see InheritCullPlanes().
         bool IsVisible(const Frustum& frustum) const;
+        // frustum test with the camera of the context and small feature culling.
+        bool IsVisible(RenderContext* context) const;
+        // called by the parent on its children after its own IsVisible().
+        void InheritCullPlanes(const GameObject* parent);
         void SetVisible(bool visible);
         bool GetVisible(){return m_visible;}
         bool GetCastsShadows(){return m_castsShadows;}
         void SetCastsShadows(bool castsShadows){m_castsShadows = castsShadows;}
         bool GetReceivesShadows(){return m_receivesShadows;}
         void SetReceivesShadows(bool receivesShadows){m_receivesShadows = receivesShadows;}
+        // occluders are rasterized by the software occlusion culler,
+        // only flag objects that are large and not too detailed.
+        bool GetOccluder(){return m_occluder;}
+        void SetOccluder(bool occluder);
         GameObject* Parent(){return m_parent;}
 
+        // handles "SetOccluder" with a bool argument.
+        virtual void Invoke(wchar_t* fn, const void* arg, void** retVal);
+
         void AddComponent(GameObjectComponent* component, int index);
         void RemoveComponent(GameObjectComponent* component);
 
@@ -65,12 +81,15 @@ class GameObject : public Object
         void SetParent(GameObject* parent);
         virtual void Query(QueryFunctor& func) { func(this);}
     protected:
+        // raises the load priority of a resource this object waits for while visible.
+        void PrioritizeResource(Resource* res, RenderContext* context) const;
 
         GameObject * m_parent;
 		Matrix m_local;		
 		Matrix m_world;
         AABB m_bounds;  // AABB in world space.
         AABB m_localBounds; // AABB in local space.
+        uint32_t m_boundsVersion;
         std::wstring m_name;
         bool m_boundsDirty;
         bool m_worldDirty;
@@ -81,10 +100,23 @@ class GameObject : public Object
 
 		std::vector<GameObjectComponent*> m_components;
 
+        // light environment used by SetupRenderable(), only recomputed
+        // when the bounds or a light overlapping them change.
+        LightEnvironment m_lighting;
+        LightEnvStamp m_lightingStamp;
+
     private:
+        // hierarchical culling state, written by IsVisible(frustum).
+        mutable uint32_t m_cullStamp;       // frustum stamp of m_cullPlanes.
+        mutable uint32_t m_cullPlanes;      // planes the parent straddles.
+        mutable uint32_t m_childCullStamp;
+        mutable uint32_t m_childCullPlanes; // planes these bounds straddle.
+        mutable uint32_t m_cullLastPlane;   // plane that rejected the bounds last time.
+
         bool m_visible;
         bool m_castsShadows;
         bool m_receivesShadows;
+        bool m_occluder;
         
         typedef Object super;
     };
@@ -24,13 +24,15 @@ namespace LvEdEngine
     //virtual 
     void GameObjectGroup::GetRenderables(RenderableNodeCollector* collector, RenderContext* context)
     {
-		if (!IsVisible(context->Cam().GetFrustum()))
+		if (!IsVisible(context))
 			return;
 
 		super::GetRenderables(collector, context);
 
           for(auto it = m_children.begin(); it != m_children.end(); ++it)
           {
+              // the children skip the planes this group is inside of.
+              (*it)->InheritCullPlanes(this);
               (*it)->GetRenderables(collector,context);
           }
 
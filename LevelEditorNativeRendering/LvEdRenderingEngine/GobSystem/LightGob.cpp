@@ -1,7 +1,7 @@
 //Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
 
 #include "LightGob.h"
-#include "..\Renderer\RenderableNodeSet.h"
+#include "../Renderer/RenderableNodeSet.h"
 #include "../Renderer/TextureLib.h"
 #include "../Renderer/Model.h"
 #include "../Renderer/ShapeLib.h"
@@ -26,7 +26,7 @@ namespace LvEdEngine
 //virtual 
 void LightGob::GetRenderables(RenderableNodeCollector* collector, RenderContext* context)
 {
-	if (!IsVisible(context->Cam().GetFrustum()))
+	if (!IsVisible(context))
 		return;
     
 	super::GetRenderables(collector, context);
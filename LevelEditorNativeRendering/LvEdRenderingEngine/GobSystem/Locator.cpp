@@ -27,10 +27,13 @@ namespace LvEdEngine
     // ----------------------------------------------------------------------------------
 	void Locator::GetRenderables(RenderableNodeCollector* collector, RenderContext* context)
     {  
-		if (!IsVisible(context->Cam().GetFrustum()))
+		if (!IsVisible(context))
 			return;
 		super::GetRenderables(collector, context);
+        if(m_resource)
+            PrioritizeResource(m_resource->GetTarget(), context);
 
+        UpdateLighting();
         RenderFlagsEnum flags = (RenderFlagsEnum)(RenderFlags::Textured | RenderFlags::Lit);
         collector->Add( m_renderables.begin(), m_renderables.end(), flags, Shaders::TexturedShader );
     }
@@ -38,6 +41,7 @@ namespace LvEdEngine
     void Locator::BuildRenderables()
     {
         m_renderables.clear();
+        m_lightingStamps.clear();
         Model* model = NULL;
         assert(m_resource);
         model = (Model*)m_resource->GetTarget();
@@ -60,13 +64,13 @@ namespace LvEdEngine
                 renderNode.bounds = geo->mesh->bounds;
                 renderNode.bounds.Transform(renderNode.WorldXform);
                 renderNode.objectId = GetInstanceId();
+                renderNode.objectIndex = GetObjectIndex();
                 renderNode.diffuse =  mat->diffuse;
                 renderNode.specular = mat->specular.xyz();
                 renderNode.specPower = mat->power;
                 renderNode.SetFlag( RenderableNode::kShadowCaster, GetCastsShadows() );
                 renderNode.SetFlag( RenderableNode::kShadowReceiver, GetReceivesShadows() );
-
-                LightingState::Inst()->UpdateLightEnvironment(renderNode);
+                renderNode.SetFlag( RenderableNode::kOccluder, GetOccluder() );
 
                 for(unsigned int i = TextureType::MIN; i < TextureType::MAX; ++i)
                 {
@@ -75,6 +79,19 @@ namespace LvEdEngine
                 m_renderables.push_back(renderNode);
             }
         }
+        // light environments are computed on demand by UpdateLighting()
+        m_lightingStamps.resize(m_renderables.size());
+    }
+
+    // ----------------------------------------------------------------------------------
+    void Locator::UpdateLighting()
+    {
+        // node bounds only change in BuildRenderables() which resets the stamps.
+        for(size_t i = 0; i < m_renderables.size(); ++i)
+        {
+            RenderableNode& r = m_renderables[i];
+            LightingState::Inst()->UpdateLightEnvironment(r.lighting, r.bounds, 0, m_lightingStamps[i]);
+        }
     }
 
 
@@ -84,6 +101,7 @@ namespace LvEdEngine
         m_resource = r;
         m_modelTransforms.clear();
         m_renderables.clear();
+        m_lightingStamps.clear();
         InvalidateBounds();
         InvalidateWorld();        
     }
@@ -130,14 +148,5 @@ namespace LvEdEngine
             }      
             this->UpdateWorldAABB();            
         }
-
-        if(RenderContext::Inst()->LightEnvDirty)
-        {
-            // update light env.
-            for(auto  renderNode = m_renderables.begin(); renderNode != m_renderables.end(); renderNode++)
-            {
-                LightingState::Inst()->UpdateLightEnvironment(*renderNode);
-            }
-        }         
     }
 }
@@ -27,10 +27,12 @@ class Locator : public GameObject
         void Update(const FrameTime& fr, UpdateTypeEnum updateType);
     protected:
         void BuildRenderables();
+        void UpdateLighting();
 
         ResourceReference* m_resource;
         std::vector<Matrix> m_modelTransforms;        
         RenderNodeList m_renderables;
+        std::vector<LightEnvStamp> m_lightingStamps; // one per renderable.
     private:
         typedef GameObject super;
     };
@@ -164,11 +164,14 @@ namespace LvEdEngine
 		return;
 
 	super::GetRenderables(collector, context);
+    if(m_geometry)
+        PrioritizeResource(m_geometry->GetTarget(), context);
 
     RenderFlagsEnum flags = (RenderFlagsEnum) (RenderFlags::Textured | RenderFlags::Lit);
 
     if (!m_renderables.empty())
     {
+        UpdateLighting();
         collector->Add(m_renderables.begin(), m_renderables.end(), flags, Shaders::TexturedShader);
     }
     else
@@ -179,9 +182,11 @@ namespace LvEdEngine
         r.mesh = mesh;
         r.diffuse = float4(0.0f,0.3f,0,1);
         r.objectId = GetInstanceId();
+        r.objectIndex = GetObjectIndex();
         r.WorldXform = m_world;
         r.bounds = m_bounds;
-        LightingState::Inst()->UpdateLightEnvironment(r);
+        LightingState::Inst()->UpdateLightEnvironment(m_lighting, m_bounds, m_boundsVersion, m_lightingStamp);
+        r.lighting = m_lighting;
         collector->Add(r, flags, Shaders::TexturedShader);
     }
 }
@@ -190,6 +195,7 @@ namespace LvEdEngine
 void OrcGob::BuildRenderables()
 {
     m_renderables.clear();
+    m_lightingStamps.clear();
     Model* model = NULL;
     assert(m_geometry);
     model = (Model*)m_geometry->GetTarget();
@@ -214,13 +220,13 @@ namespace LvEdEngine
             renderNode.bounds = geo->mesh->bounds;
             renderNode.bounds.Transform(renderNode.WorldXform);
             renderNode.objectId = GetInstanceId();
+            renderNode.objectIndex = GetObjectIndex();
             renderNode.diffuse =  mat->diffuse;
             renderNode.specular = mat->specular.xyz();
             renderNode.specPower = mat->power;
             renderNode.SetFlag( RenderableNode::kShadowCaster, GetCastsShadows() );
             renderNode.SetFlag( RenderableNode::kShadowReceiver, GetReceivesShadows() );
-
-            LightingState::Inst()->UpdateLightEnvironment(renderNode);
+            renderNode.SetFlag( RenderableNode::kOccluder, GetOccluder() );
 
             for(unsigned int i = TextureType::MIN; i < TextureType::MAX; ++i)
             {
@@ -229,6 +235,19 @@ namespace LvEdEngine
             m_renderables.push_back(renderNode);
         }
     }
+    // light environments are computed on demand by UpdateLighting()
+    m_lightingStamps.resize(m_renderables.size());
+}
+
+// ----------------------------------------------------------------------------------
+void OrcGob::UpdateLighting()
+{
+    // node bounds only change in BuildRenderables() which resets the stamps.
+    for(size_t i = 0; i < m_renderables.size(); ++i)
+    {
+        RenderableNode& r = m_renderables[i];
+        LightingState::Inst()->UpdateLightEnvironment(r.lighting, r.bounds, 0, m_lightingStamps[i]);
+    }
 }
 
 
@@ -270,16 +289,6 @@ namespace LvEdEngine
         }      
         this->UpdateWorldAABB();            
     }
-
-    if(RenderContext::Inst()->LightEnvDirty)
-    {
-        // update light env.
-        for(auto  renderNode = m_renderables.begin(); renderNode != m_renderables.end(); renderNode++)
-        {
-            LightingState::Inst()->UpdateLightEnvironment(*renderNode);
-        }
-    }       
-
 }
 
 }; // namespace
@@ -43,11 +43,13 @@ class OrcGob : public GameObject
 
     protected:
         void BuildRenderables();
+        void UpdateLighting();
 
         ResourceReference* m_geometry;
         ResourceReference* m_animation;
         GameObjectReference* m_target;
         RenderNodeList m_renderables;
+        std::vector<LightEnvStamp> m_lightingStamps; // one per renderable.
 
         std::vector<GameObjectReference*> m_friends;
         std::vector<OrcGob*> m_children;
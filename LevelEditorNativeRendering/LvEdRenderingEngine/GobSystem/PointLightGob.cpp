@@ -25,26 +25,31 @@ namespace LvEdEngine
 void PointLightGob::SetAmbient(int color)
 {
     ConvertColor(color, &m_light->ambient);
+    LightingState::Inst()->LightChanged(m_light);
 }
 
 void PointLightGob::SetDiffuse(int color)
 {
     ConvertColor(color, &m_light->diffuse);
+    LightingState::Inst()->LightChanged(m_light);
 }
 
 void PointLightGob::SetSpecular(int color)
 {
     ConvertColor(color, &m_light->specular);
+    LightingState::Inst()->LightChanged(m_light);
 }
 
 void PointLightGob::SetAttenuation(const float3& atten)
 {
     m_light->attenuation = float4(atten.x,atten.y,atten.z,1);
+    LightingState::Inst()->LightChanged(m_light);
 }
 
 void PointLightGob::SetRange(float r)
 {
     m_light->position.w = r;
+    LightingState::Inst()->LightChanged(m_light);
 }
 
 
@@ -63,6 +68,7 @@ namespace LvEdEngine
     float range = m_light->position.w;
     float3 pos(&m_world.M41);
     m_light->position = float4(pos, range);  
+    LightingState::Inst()->LightChanged(m_light);
 }
 
 };
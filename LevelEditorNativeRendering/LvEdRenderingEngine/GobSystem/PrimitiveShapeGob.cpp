@@ -39,7 +39,7 @@
 //virtual 
 void PrimitiveShapeGob::GetRenderables(RenderableNodeCollector* collector, RenderContext* context)
 {
-    if ( IsVisible(context->Cam().GetFrustum()) )
+    if ( IsVisible(context) )
     {
 		super::GetRenderables(collector, context);
 
@@ -21,12 +21,10 @@ namespace LvEdEngine
     SkyDome::~SkyDome()
     {
         SAFE_RELEASE(m_texture);
-        ResourceManager::Inst()->GarbageCollect();
     }
     void SkyDome::SetCubeMap(wchar_t* filename)
     {
         SAFE_RELEASE(m_texture);
-        ResourceManager::Inst()->GarbageCollect();
         if(filename && wcslen(filename) > 0)
             m_texture = (Texture*) ResourceManager::Inst()->LoadImmediate(filename,NULL);
 
@@ -40,6 +38,7 @@ namespace LvEdEngine
         RenderableNode r;        
         r.mesh = ShapeLibGetMesh(RenderShape::Sphere);
         r.objectId = GetInstanceId();    
+        r.objectIndex = GetObjectIndex();
         r.textures[TextureType::Cubemap] = m_texture ? m_texture : TextureLib::Inst()->GetDefault(TextureType::Cubemap);       
         r.SetFlag( RenderableNode::kShadowCaster, false );
         r.SetFlag( RenderableNode::kShadowReceiver, false );
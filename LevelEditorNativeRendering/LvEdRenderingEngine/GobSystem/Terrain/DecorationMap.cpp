@@ -1,11 +1,13 @@
 //Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
 
 #include "DecorationMap.h"
+#include <algorithm>
 #include "TerrainGob.h"
 #include "../../Core/ImageData.h"
 #include "../../Core/StringUtils.h"
 #include "../../Renderer/RenderBuffer.h"
 #include "../../Renderer/GpuResourceFactory.h"
+#include "../../Renderer/TransientBuffer.h"
 
 namespace LvEdEngine
 {
@@ -15,7 +17,6 @@ namespace LvEdEngine
                                  m_vertexcount(),
                                  m_lodDistance(1200),
                                  m_genVB(true),
-                                 m_decoDynVB(NULL),
                                  m_numOfDecoratorsPerTexel(1)
 
 {
@@ -26,7 +27,6 @@ namespace LvEdEngine
 DecorationMap::~DecorationMap()
 {
     ReleaseResources();
-    SAFE_DELETE(m_decoDynVB);
 }
 
 
@@ -59,9 +59,12 @@ namespace LvEdEngine
              for(int32_t x = box.x1; x < box.x2; x++)
              {                 
                  int32_t patchIndex = (int32_t)(y / dimy) * numPatchX + (int32_t)( x / dimx);
-                 m_tmpPatchSet.insert(patchIndex);                 
+                 if(m_tmpPatchSet.empty() || m_tmpPatchSet.back() != patchIndex)
+                     m_tmpPatchSet.push_back(patchIndex);
              }
          }
+         std::sort(m_tmpPatchSet.begin(), m_tmpPatchSet.end());
+         m_tmpPatchSet.erase(std::unique(m_tmpPatchSet.begin(), m_tmpPatchSet.end()), m_tmpPatchSet.end());
 
          for(auto it = m_tmpPatchSet.begin(); it != m_tmpPatchSet.end(); it++)
          {             
@@ -90,48 +93,51 @@ namespace LvEdEngine
     m_vertexcount = 0;
 }
 
-const VertexBuffer* DecorationMap::GetVB(RenderContext* rc, uint32_t& vertCount)
+bool DecorationMap::GetVB(RenderContext* rc, TransientAlloc* alloc, uint32_t& vertCount)
 {
     vertCount = 0;
     GenVBuffers();
-    if(m_vertexcount == 0) return NULL;
+    if(m_vertexcount == 0) return false;
     
     auto d3dcontext = rc->Context();
-    vertCount = 0;
-        
-
-    if( m_decoDynVB == NULL || m_decoDynVB->GetCount() < m_vertexcount)
+    const TerrainPatchList& patchlist = this->GetParent()->GetVisiblePatches();
 
+    // count the decorators of the patches within the lod distance,
+    // only those are written to the transient buffer.
+    uint32_t count = 0;
+    for(auto it = patchlist.begin(); it != patchlist.end(); it++)
     {
-        SAFE_DELETE(m_decoDynVB);
-        m_decoDynVB = GpuResourceFactory::CreateVertexBuffer(NULL, VertexFormat::VF_T,
-            m_vertexcount,BufferUsage::DYNAMIC); 
-        assert(m_decoDynVB);        
+        const VBList* pos2d = &m_listOfVBList[it->patchId];
+        float dist = length( it->bounds.GetCenter() - rc->Cam().CamPos());            
+        if( dist > m_lodDistance || pos2d->size() == 0) continue;            
+        count += (uint32_t)pos2d->size();
     }
+    if(count == 0) return false;
 
-    if(!m_decoDynVB) return NULL;
-    D3D11_MAPPED_SUBRESOURCE mappedResource;
-    const TerrainPatchList& patchlist = this->GetParent()->GetVisiblePatches();
-    
-    HRESULT hr = d3dcontext->Map(m_decoDynVB->GetBuffer(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource);
-    if(FAILED(hr)) return NULL;
+    TransientBuffer* tb = TransientBuffer::Inst();
+    uint32_t stride = sizeof(float2);
+    if(count > tb->GetMaxCount(stride))
+        count = tb->GetMaxCount(stride);
+    if(!tb->Map(d3dcontext, stride, count, alloc)) return false;
 
     // update dynamic instance  buffer        
     // for each visible terrain patch.
     
-    for(auto it = patchlist.begin(); it != patchlist.end(); it++)
+    for(auto it = patchlist.begin(); it != patchlist.end() && vertCount < count; it++)
     {
         const VBList* pos2d = &m_listOfVBList[it->patchId];
         float dist = length( it->bounds.GetCenter() - rc->Cam().CamPos());            
             if( dist > m_lodDistance || pos2d->size() == 0) continue;            
             // update instance buffer.
             
-            uint8_t* destPtr =  ( (uint8_t*)mappedResource.pData + (vertCount * m_decoDynVB->GetStride()));
-            CopyMemory(destPtr, &pos2d->front(), m_decoDynVB->GetStride() * pos2d->size());
-            vertCount += (uint32_t)pos2d->size();
+            uint32_t n = (uint32_t)pos2d->size();
+            if(n > count - vertCount) n = count - vertCount;
+            uint8_t* destPtr =  ( (uint8_t*)alloc->data + (vertCount * stride));
+            CopyMemory(destPtr, &pos2d->front(), stride * n);
+            vertCount += n;
     }
-    d3dcontext->Unmap(m_decoDynVB->GetBuffer(), 0);       
-    return m_decoDynVB;
+    tb->Unmap(d3dcontext);
+    return true;
 }
 
 void DecorationMap::GenVBuffers(int32_t patchId)
@@ -5,14 +5,14 @@
 #include <vector>
 #include "../../VectorMath/CollisionPrimitives.h"
 #include "../../Core/Utils.h"
+#include "../../Core/FrameArena.h"
 #include <vector>
-#include <set>
 
 namespace LvEdEngine
 {
 
-class VertexBuffer;
 class RenderContext;
+struct TransientAlloc;
 typedef std::vector<float2> VBList;
 typedef std::vector<VBList> ListOfVBList;
 class DecorationMap : public TerrainMap
@@ -33,7 +33,8 @@ void SetNumOfDecorators(int numOfDecorators)
         m_genVB = true;        
     }   
 
-    const VertexBuffer* GetVB(RenderContext* rc, uint32_t& vertCount);
+    // writes the decorators of the visible patches to the transient buffer.
+    bool GetVB(RenderContext* rc, TransientAlloc* alloc, uint32_t& vertCount);
     uint32_t GetVertexcount() const {return m_vertexcount;}
     const ListOfVBList& GetListOfVBList()
     {
@@ -59,10 +60,9 @@ void SetNumOfDecorators(int numOfDecorators)
     void GenVBuffers();
     void GenVBuffers(int32_t patchId);
     uint32_t ComputeTotalVertexCount();
-    VertexBuffer*  m_decoDynVB; // dynamic vertex buffer used for rendering decoration maps.
 
     // temp to holds terrain patch ids that need to be udpated.
-    std::set<int32_t> m_tmpPatchSet;
+    FrameVector<int32_t> m_tmpPatchSet;
     
     static int32_t s_instId;
     int32_t m_instId;
@@ -2,6 +2,7 @@
 
 #include "TerrainGob.h"
 #include <algorithm>
+#include <float.h>
 #include "../../Core/Utils.h"
 #include "../../Core/FileUtils.h"
 #include "../../Core/StringUtils.h"
@@ -90,13 +91,6 @@ namespace LvEdEngine
 
 
 
-struct DrawBrushArgs
-{
-    float3 posW;    
-    float radius;
-    float falloff;   
-    float2 scale;
-};
 struct RayPickRetVal
 {
     int8_t picked;
@@ -148,6 +142,10 @@ struct RayPickRetVal
         hmInstId = m_heightMap ? m_heightMap->GetInstanceId() : 0;
         *retVal = &hmInstId;
     }
+    else
+    {
+        super::Invoke(fn,arg,retVal);
+    }
 }
 
 
@@ -164,7 +162,7 @@ struct RayPickRetVal
         int32_t patchCell = m_patchDim - 1;
         int32_t stride = (m_cols-1) / patchCell;
         
-         
+        tempBrushdata.reserve((box.x2 - box.x1) * (box.y2 - box.y1));
         for(int32_t y = box.y1; y < box.y2; y++)
         {
             for(int32_t x = box.x1; x < box.x2; x++)
@@ -173,9 +171,12 @@ struct RayPickRetVal
                 tempBrushdata.push_back(*val);                   
                 int32_t patchIndex = ((y-1)/patchCell)  * stride + (x-1)/patchCell;
                 assert(patchIndex < m_renderableNodes.size());
-                m_tmpPatchSet.insert(patchIndex);
+                if(m_tmpPatchSet.empty() || m_tmpPatchSet.back() != patchIndex)
+                    m_tmpPatchSet.push_back(patchIndex);
             }
         }
+        std::sort(m_tmpPatchSet.begin(), m_tmpPatchSet.end());
+        m_tmpPatchSet.erase(std::unique(m_tmpPatchSet.begin(), m_tmpPatchSet.end()), m_tmpPatchSet.end());
       
         auto cntx = RenderContext::Inst()->Context();
         D3D11_BOX destRegion;
@@ -207,6 +208,7 @@ struct RayPickRetVal
                 }                
             }
             patch->boundsTr = bound;
+            BuildOccluder(*patch);
         }        
         InvalidateBounds();        
     }
@@ -319,6 +321,7 @@ struct RayPickRetVal
         for(auto it = m_pickPatchlist.begin(); it != m_pickPatchlist.end(); it++)
         {
             m_pickPosT.clear();
+            m_pickPosT.reserve(m_patchDim * m_patchDim);
             TerrainPatch* patch = *it;
           
             int yEnd = patch->y + patchCell;
@@ -411,15 +414,6 @@ struct RayPickRetVal
 
         UpdateWorldAABB();
     }
-    
-    if(RenderContext::Inst()->LightEnvDirty)
-    {
-        for(auto it = m_renderableNodes.begin(); it != m_renderableNodes.end(); it++)
-        {
-            LightingState::Inst()->UpdateLightEnvironment(it->lighting,it->bounds);
-        }
-    }
-
 }
 
 const TerrainPatchList& TerrainGob::GetVisiblePatches( RenderContext* context)
@@ -433,6 +427,8 @@ struct RayPickRetVal
         {
             if (TestFrustumAABB(frustum, it->bounds))
             {
+                // patch bounds are recomputed together with the terrain bounds.
+                LightingState::Inst()->UpdateLightEnvironment(it->lighting, it->bounds, m_boundsVersion, it->lightingStamp);
                 m_visibleList.push_back(*it);                
             }
         }
@@ -617,7 +613,44 @@ struct RayPickRetVal
         }
         it->boundsTr = bound;
     }      
+
+    m_occluderHeights.resize(m_renderableNodes.size() * GetOccluderDim() * GetOccluderDim());
+    for(auto it = m_renderableNodes.begin(); it != m_renderableNodes.end(); it++)
+    {
+        BuildOccluder(*it);
+    }
     InvalidateBounds();
 }
 
+// Each occluder vertex takes the lowest height of the cells around it,
+// so the coarse surface stays under the actual terrain.
+void TerrainGob::BuildOccluder(const TerrainPatch& patch)
+{
+    int32_t patchCell = m_patchDim - 1;
+    int32_t span = patchCell / OccluderCells;
+    int32_t dim = GetOccluderDim();
+    float* heights = &m_occluderHeights[patch.patchId * dim * dim];
+    uint8_t* ptr = (uint8_t*)m_heightMap->GetBufferPointer();
+    for(int32_t j = 0; j < dim; j++)
+    {
+        int32_t yBegin = patch.y + std::max(j - 1, 0) * span;
+        int32_t yEnd = patch.y + std::min(j + 1, OccluderCells) * span;
+        for(int32_t i = 0; i < dim; i++)
+        {
+            int32_t xBegin = patch.x + std::max(i - 1, 0) * span;
+            int32_t xEnd = patch.x + std::min(i + 1, OccluderCells) * span;
+            float minHeight = FLT_MAX;
+            for(int32_t y = yBegin; y <= yEnd; y++)
+            {
+                float* scanline = (float*) (ptr + y * m_heightMap->GetRowPitch());
+                for(int32_t x = xBegin; x <= xEnd; x++)
+                {
+                    minHeight = minimize(minHeight, scanline[x]);
+                }
+            }
+            heights[j * dim + i] = minHeight;
+        }
+    }
+}
+
 }
\ No newline at end of file
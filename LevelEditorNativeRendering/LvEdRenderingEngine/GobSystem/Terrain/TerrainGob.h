@@ -6,7 +6,7 @@
 #include "LayerMap.h"
 #include "DecorationMap.h"
 #include <vector>
-#include <set>
+#include "../../Core/FrameArena.h"
 namespace LvEdEngine
 {  
 
@@ -16,6 +16,15 @@ class DecorationMap;
 class ImageData;
 class TerrainShader;
 
+// argument of the DrawBrush member function.
+struct DrawBrushArgs
+{
+    float3 posW;    
+    float radius;
+    float falloff;   
+    float2 scale;
+};
+
 class TerrainPatch
 {
 public:
@@ -25,6 +34,7 @@ class TerrainPatch
     AABB boundsTr;  // bounds in terrain space.
     AABB bounds; // bound in world space.    
     LightEnvironment lighting;
+    LightEnvStamp lightingStamp; // computed against bounds at the terrain's bounds version.
 };
 
 typedef std::vector<TerrainPatch> TerrainPatchList;
@@ -61,7 +71,7 @@ void SetCellSize(float cellSize)
          
      bool RayPick(const Ray& rayw, float3& hitpos, float3& norm, float3& nearestVertex);
      float GetHeightAt(float u, float v) const;     
-     float TerrainGob::GetHeightAt(float2 posT) const;
+     float GetHeightAt(float2 posT) const;
      int32_t GetPatchIdAt(float u, float v) const;
      int32_t GetNumOfPatches() const {return (int)m_renderableNodes.size();}
 
@@ -79,9 +89,20 @@ void SetCellSize(float cellSize)
     int32_t  GetNumCols() const {return m_cols;}
     int32_t  GetNumRows() const {return m_rows;}
     int32_t  GetPatchDim() const {return m_patchDim;}
+
+    // coarse version of each patch used as occluder by the software occlusion culler.
+    // GetOccluderDim() x GetOccluderDim() heights in terrain space, laid out like the patch
+    // vertices and never above the actual surface.
+    static int32_t GetOccluderDim() { return OccluderCells + 1; }
+    float GetOccluderStep() const { return m_cellSize * (m_patchDim - 1) / OccluderCells; }
+    const float* GetOccluderHeights(const TerrainPatch& patch) const
+    {
+        return &m_occluderHeights[patch.patchId * GetOccluderDim() * GetOccluderDim()];
+    }
     
 private:    
     typedef GameObject super;
+    static const int32_t OccluderCells = 8; // per patch side, must divide m_patchDim - 1.
 
     int32_t m_cols;
     int32_t m_rows;
@@ -103,12 +124,17 @@ void SetCellSize(float cellSize)
     TerrainPatchList m_visibleList; // visible list of renderable node.
     void BuildPatches();
 
+    // occluder heights of all the patches, see GetOccluderHeights().
+    std::vector<float> m_occluderHeights;
+    void BuildOccluder(const TerrainPatch& patch);
+
     // scratch lists used by RayPick(..) function.
-    std::vector<TerrainPatch*> m_pickPatchlist;
-    std::vector<float3> m_pickPosT;
+    FrameVector<TerrainPatch*> m_pickPatchlist;
+    FrameVector<float3> m_pickPosT;
 
-    std::vector<float> tempBrushdata;
-    std::set<int32_t> m_tmpPatchSet;
+    // scratch lists used by ApplyDirtyRegion(..) function.
+    FrameVector<float> tempBrushdata;
+    FrameVector<int32_t> m_tmpPatchSet;
     
     // Apply dirty region to heightmap texture.
     void ApplyDirtyRegion(const Bound2di& box);
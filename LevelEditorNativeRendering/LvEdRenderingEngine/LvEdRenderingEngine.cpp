@@ -7,10 +7,12 @@
 #include <stdio.h>
 #include <set>
 #include <algorithm>
-#include <D3D11.h>
+#include <d3d11.h>
 #include "Core/Logger.h"
 #include "Core/ErrorHandler.h"
 #include "Core/PerfTimer.h"
+#include "Core/TaskPool.h"
+#include "Core/FrameArena.h"
 #include "Core/Utils.h"
 #include "Core/WinHeaders.h"
 #include <mmsystem.h>
@@ -27,9 +29,17 @@
 #include "Renderer/RenderUtil.h"
 #include "Renderer/RenderableNodeSorter.h"
 #include "Renderer/ShadowMapGen.h"
+#include "Renderer/ShadowCasterCollector.h"
+#include "Renderer/OcclusionCuller.h"
+#include "Renderer/StaticBatcher.h"
+#include "Renderer/D3D11CommandBackend.h"
 #include "Renderer/LineRenderer.h"
+#include "Renderer/TransientBuffer.h"
 #include "Renderer/Shader.h"
 #include "Renderer/ShaderLib.h"
+#include "Renderer/ShaderCache.h"
+#include "Renderer/EngineShaders.h"
+#include "Renderer/D3DShaderCompiler.h"
 #include "Renderer/TextureLib.h"
 #include "Renderer/GpuResourceFactory.h"
 #include "ResourceManager/ResourceManager.h"
@@ -38,9 +48,13 @@
 #include "Model3d/ColladaModelFactory.h"
 #include "Model3d/ObjModelFactory.h"
 #include "ResourceManager/TextureFactory.h"
+#include "ResourceManager/AssetArchive.h"
+#include "ResourceManager/TextureCache.h"
+#include "ResourceManager/TextureStreamer.h"
 #include "GobSystem/GameLevel.h"
 #include "GobSystem/SkyDome.h"
 #include "LvEdUtils.h"
+#include "ApiTrace.h"
 #include "Renderer/RenderBuffer.h"
 #include "Renderer/Model.h"
 #include "Renderer/FontRenderer.h"
@@ -48,12 +62,12 @@
 #include "Model3d/rapidxmlhelpers.h"
 #include "Core/Hasher.h"
 #include "Core/FileUtils.h"
-#include "DirectX\DirectXTex\DirectXTex.h"
+#include "DirectX/DirectXTex/DirectXTex.h"
 #include "Renderer/Texture.h"
 #include "DirectX/DXUtil.h"
-#include "Core\ImageData.h"
-#include "GobSystem\Terrain\TerrainGob.h"
-#include "Renderer\TerrainShader.h"
+#include "Core/ImageData.h"
+#include "GobSystem/Terrain/TerrainGob.h"
+#include "Renderer/TerrainShader.h"
 
 // Use the following primitive types
 //int8_t;
@@ -132,7 +146,7 @@ void SetCallback(InvalidateViewsCallbackType invalidateCallback)
     {
         m_callback = invalidateCallback;
     }
-    virtual void OnResourceLoaded(Resource* r);
+    virtual void OnResourcesLoaded(Resource* const* resources, uint32_t count);
 private:
     InvalidateViewsCallbackType m_callback;
 };
@@ -156,10 +170,16 @@ class EngineData : public NonCopyable
     BasicRenderer* basicRenderer;
       
     MyResourceListener resourceListener;
-    std::vector<HitRecord> HitRecords;
+    FrameVector<HitRecord> HitRecords; // valid until the frame ends.
     ShadowMapGen*        shadowMapShader;
     RenderableNodeSorter    renderableSorter;
     RenderableNodeSet       pickCollector; 
+    ShadowCasterCollector   shadowCasters;
+    TaskPool*               taskPool;   // used for collecting renderables, NULL for serial collection.
+    OcclusionCuller         occlusionCuller;
+    StaticBatcher           staticBatcher;
+    D3D11CommandBackend*    commandBackend;
+    bool                    occlusionCulling;
     Font* AxisFont;
     
 };
@@ -169,7 +189,10 @@ class EngineData : public NonCopyable
   : pRenderSurface( NULL ),  
     GameLevel( NULL ),
     basicRenderer( NULL ),    
-    shadowMapShader( NULL)    
+    shadowMapShader( NULL),
+    taskPool( NULL ),
+    commandBackend( NULL ),
+    occlusionCulling( true )
 {
     
     // Initialize the 'code generated' bridge.
@@ -179,6 +202,10 @@ class EngineData : public NonCopyable
     basicRenderer   = new BasicRenderer(device);
     shadowMapShader = new ShadowMapGen(device);
 
+    uint32_t numWorkers = TaskPool::DefaultWorkerCount();
+    if(numWorkers > 0)
+        taskPool = new TaskPool(numWorkers);
+
     AxisFont = Font::CreateNewInstance( device,L"Arial",14,LvEdFonts::kFontStyleBOLD);
 }
 
@@ -187,17 +214,20 @@ class EngineData : public NonCopyable
 {
     SAFE_DELETE(basicRenderer);    
     SAFE_DELETE(shadowMapShader); 
+    SAFE_DELETE(taskPool);
+    SAFE_DELETE(commandBackend);
     SAFE_DELETE(AxisFont);    
 }
 
 
 static EngineData* s_engineData = NULL;
-
+static bool s_headless = false; // use the null device, see LvEd_SetHeadless.
+static ApiTraceWriter s_trace;   // records the calls, see LvEd_StartTrace.
 
 //=============================================================================================
-void MyResourceListener::OnResourceLoaded(Resource* /*r*/)
+// one invalidate for all the resources loaded since the last update.
+void MyResourceListener::OnResourcesLoaded(Resource* const* /*resources*/, uint32_t /*count*/)
 {    
-    RenderContext::Inst()->LightEnvDirty = true;
     if(m_callback) m_callback();   
 }
 
@@ -225,12 +255,19 @@ class EngineData : public NonCopyable
     // note if you using game-engine
     // you don't need to use DeviceManager class.
     // the game-engine should provide
-    gD3D11 = new DeviceManager();
+    gD3D11 = new DeviceManager(s_headless);
     GpuResourceFactory::SetDevice(gD3D11->GetDevice());
+    ShaderCache::InitInstance(new D3DShaderCompiler(), FileUtils::GetCacheDir(L"Shaders"));
+    ShaderCache::Inst()->Prefetch(EngineShader::GetDescs(), EngineShader::Count);
     RSCache::InitInstance(gD3D11->GetDevice());
     TextureLib::InitInstance(gD3D11->GetDevice());
     ShapeLibStartup(gD3D11->GetDevice());
     ResourceManager::InitInstance();
+    TextureCache::InitInstance();
+    // the null device streams in LvEd_Update, so that traces replay the same way.
+    TextureStreamer::InitInstance(gD3D11->GetDevice(), gD3D11->GetImmediateContext(), !s_headless);
+    FrameArena::InitInstance(4 * 1024 * 1024);
+    TransientBuffer::InitInstance(gD3D11->GetDevice(), 4 * 1024 * 1024);
     LineRenderer::InitInstance(gD3D11->GetDevice());
     ShadowMaps::InitInstance(gD3D11->GetDevice(),2048);
    
@@ -238,6 +275,8 @@ class EngineData : public NonCopyable
     s_engineData = new EngineData( gD3D11->GetDevice() );
     s_engineData->resourceListener.SetCallback(invalidateCallback);
     RenderContext::Inst()->SetContext(gD3D11->GetImmediateContext());
+    s_engineData->commandBackend = new D3D11CommandBackend(gD3D11->GetImmediateContext());
+    RenderContext::Inst()->SetBackend(s_engineData->commandBackend);
 
     ShaderLib::InitInstance(gD3D11->GetDevice());
     FontRenderer::InitInstance( gD3D11 );
@@ -264,6 +303,22 @@ class EngineData : public NonCopyable
     const wchar_t* info = EngineInfo::Inst()->GetInfo();
     if(outEngineInfo)
         *outEngineInfo = info;
+
+    // record the session when LVED_API_TRACE names a trace file.
+    wchar_t traceFile[MAX_PATH];
+    if(GetEnvironmentVariableW(L"LVED_API_TRACE", traceFile, MAX_PATH) > 0)
+        LvEd_StartTrace(traceFile);
+}
+
+
+LVEDRENDERINGENGINE_API void __stdcall LvEd_SetHeadless(bool headless)
+{
+    if(gD3D11)
+    {
+        Logger::Log(OutputMessageType::Warning, L"LvEd_SetHeadless must be called before LvEd_Initialize\n");
+        return;
+    }
+    s_headless = headless;
 }
 
 
@@ -271,6 +326,7 @@ class EngineData : public NonCopyable
 {
     ErrorHandler::ClearError();
     Logger::Log(OutputMessageType::Info, L"Shutdown Rendering Engine\n");
+    LvEd_StopTrace();
     if(!gD3D11) return;
 
     LvEd_Clear();
@@ -280,11 +336,17 @@ class EngineData : public NonCopyable
     LvEdFonts::FontRenderer::DestroyInstance();
     ShaderLib::DestroyInstance();    
     LineRenderer::DestroyInstance();
+    TransientBuffer::DestroyInstance();
+    FrameArena::DestroyInstance();
     RenderContext::DestroyInstance();    
+    TextureStreamer::Inst()->CancelUploads(); // they reference textures.
     ResourceManager::DestroyInstance();
+    TextureStreamer::DestroyInstance(); // after the loaders, they register textures.
+    TextureCache::DestroyInstance();
     ShadowMaps::DestroyInstance();
     RSCache::DestroyInstance();
     EngineInfo::DestroyInstance();
+    ShaderCache::DestroyInstance();
     SAFE_DELETE(s_engineData);
     SAFE_DELETE(gD3D11);
 }
@@ -294,7 +356,8 @@ class EngineData : public NonCopyable
 {
     ErrorHandler::ClearError();
     Logger::Log(OutputMessageType::Info, "SceneReset\n");    
-    RenderContext::Inst()->selection.clear();        
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::Clear).EndCall();
+    RenderContext::Inst()->selection.Clear();
     ResourceManager * rm = ResourceManager::Inst();
     rm->GarbageCollect();
 }
@@ -309,18 +372,21 @@ class EngineData : public NonCopyable
 LVEDRENDERINGENGINE_API ObjectTypeGUID __stdcall LvEd_GetObjectTypeId(char* className)
 {
     ErrorHandler::ClearError();
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::GetObjectTypeId).WriteString(className).EndCall();
     return s_engineData->Bridge.GetTypeId(className);
 }
 
 LVEDRENDERINGENGINE_API ObjectPropertyUID  _stdcall LvEd_GetObjectPropertyId(ObjectTypeGUID id, char* propertyName)
 {
     ErrorHandler::ClearError();
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::GetObjectPropertyId).Write(id).WriteString(propertyName).EndCall();
     return s_engineData->Bridge.GetPropertyId(id,propertyName);
 }
 
 LVEDRENDERINGENGINE_API ObjectPropertyUID __stdcall LvEd_GetObjectChildListId(ObjectTypeGUID id, char* listName)
 {
     ErrorHandler::ClearError();
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::GetObjectChildListId).Write(id).WriteString(listName).EndCall();
     return s_engineData->Bridge.GetChildListId(id,listName);
 }
 
@@ -328,6 +394,7 @@ class EngineData : public NonCopyable
 {
     ErrorHandler::ClearError();
     ObjectGUID instanceId = s_engineData->Bridge.CreateObject(typeId, data, size);    
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::CreateObject).Write(typeId).WriteBlob(data, (uint32_t)size).Write(instanceId).EndCall();
     return instanceId;
 }
 
@@ -335,12 +402,12 @@ class EngineData : public NonCopyable
 LVEDRENDERINGENGINE_API void __stdcall LvEd_DestroyObject(ObjectTypeGUID typeId, ObjectGUID instanceId)
 {
     ErrorHandler::ClearError();
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::DestroyObject).Write(typeId).Write(instanceId).EndCall();
     if(s_engineData->GameLevel && s_engineData->GameLevel->GetInstanceId() == instanceId)
         s_engineData->GameLevel = NULL;
 
     s_engineData->Bridge.DestroyObject(typeId, instanceId);
-
-    ResourceManager::Inst()->GarbageCollect();
+    // the resources released are evicted by LvEd_Update when over budget.
 }
 
 
@@ -350,25 +417,27 @@ class EngineData : public NonCopyable
     if(instanceId == 0) return;
     Object* obj = reinterpret_cast<Object*>(instanceId);
     obj->Invoke(fn,arg,retVal);
+
+    if(s_trace.IsOpen())
+    {
+        // instance ids are returned through retVal, they are recorded for the replay.
+        ObjectGUID retId = (InvokeReturnsInstanceId(fn) && retVal && *retVal) ? *(ObjectGUID*)*retVal : 0;
+        s_trace.BeginCall(ApiCall::InvokeMemberFn).Write(instanceId).WriteString(fn)
+            .WriteBlob(arg, GetInvokeArgSize(fn, arg)).Write(retId).EndCall();
+    }
 }
 
-static hash32_t swapchainTypeId = Hash32("SwapChain");
-static hash32_t renderStateTypeId = Hash32("RenderState");
 LVEDRENDERINGENGINE_API void __stdcall LvEd_SetObjectProperty(ObjectTypeGUID typeId, ObjectPropertyUID propId, ObjectGUID instanceId, void* data, int size)
 {
     ErrorHandler::ClearError();
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::SetObjectProperty).Write(typeId).Write(propId).Write(instanceId).WriteBlob(data, (uint32_t)size).EndCall();
     s_engineData->Bridge.SetProperty(typeId,propId,instanceId,data,size);
-    
-    // for certain objects, we don't want to update lighting.    
-    if(typeId == renderStateTypeId || typeId == swapchainTypeId)
-        return;
-
-    RenderContext::Inst()->LightEnvDirty = true;   
 }
 
 LVEDRENDERINGENGINE_API void __stdcall LvEd_GetObjectProperty(ObjectTypeGUID typeId, ObjectPropertyUID propId, ObjectGUID instanceId, void** data, int* size)
 {
     ErrorHandler::ClearError();
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::GetObjectProperty).Write(typeId).Write(propId).Write(instanceId).EndCall();
     s_engineData->Bridge.GetProperty(typeId,propId,instanceId,data,size);
 }
 
@@ -376,6 +445,7 @@ class EngineData : public NonCopyable
 LVEDRENDERINGENGINE_API void __stdcall LvEd_ObjectAddChild(ObjectTypeGUID typeId, ObjectPropertyUID listId, ObjectGUID parentId, ObjectGUID  childId, int index)
 {
     ErrorHandler::ClearError();
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::ObjectAddChild).Write(typeId).Write(listId).Write(parentId).Write(childId).Write<int32_t>(index).EndCall();
     assert(listId != 0);
     assert(parentId != 0);
     
@@ -403,13 +473,12 @@ class EngineData : public NonCopyable
      {
          s_engineData->GameLevel->Terrains.push_back((TerrainGob*)obj);         
      }
-         
-    RenderContext::Inst()->LightEnvDirty = true;
 }
 
 LVEDRENDERINGENGINE_API void __stdcall LvEd_ObjectRemoveChild(ObjectTypeGUID typeId, ObjectListUID listId, ObjectGUID parentId, ObjectGUID childId)
 {
     ErrorHandler::ClearError();
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::ObjectRemoveChild).Write(typeId).Write(listId).Write(parentId).Write(childId).EndCall();
     assert(listId != 0);
     assert(parentId != 0);
     
@@ -445,8 +514,6 @@ class EngineData : public NonCopyable
             s_engineData->GameLevel->Terrains.erase(it);
         }                   
     }
-
-    RenderContext::Inst()->LightEnvDirty = true;
 }
 
 
@@ -464,6 +531,8 @@ bool HitRecordSorting(const HitRecord& n1, const HitRecord& n2)
 LVEDRENDERINGENGINE_API bool __stdcall LvEd_RayPick(float viewxform[], float projxform[],Ray* rayW, bool skipSelected, HitRecord** hits, int* count)
 {
     ErrorHandler::ClearError();
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::RayPick).WriteBytes(viewxform, 16 * sizeof(float)).WriteBytes(projxform, 16 * sizeof(float))
+        .Write(*rayW).Write(skipSelected).EndCall();
     if(s_engineData->GameLevel == NULL)
     {
         ErrorHandler::SetError(ErrorType::UnknownError, L"%s: no GameLevel set", __WFUNCTION__);
@@ -642,6 +711,8 @@ bool HitRecordSorting(const HitRecord& n1, const HitRecord& n2)
 LVEDRENDERINGENGINE_API bool __stdcall LvEd_FrustumPick(ObjectGUID renderSurface, float viewxform[], float projxform[],float* rect, HitRecord** hits, int* count)
 {
     ErrorHandler::ClearError();
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::FrustumPick).Write(renderSurface).WriteBytes(viewxform, 16 * sizeof(float))
+        .WriteBytes(projxform, 16 * sizeof(float)).WriteBytes(rect, 4 * sizeof(float)).EndCall();
     *hits = 0;
     *count = 0;
     float w = rect[2];
@@ -743,12 +814,8 @@ bool HitRecordSorting(const HitRecord& n1, const HitRecord& n2)
 LVEDRENDERINGENGINE_API void __stdcall LvEd_SetSelection(ObjectGUID*  instanceIds, int count)
 {
     ErrorHandler::ClearError();
-    RenderContext::Inst()->selection.clear();
-
-    for(int i = 0; i < count; i++)
-    {
-        RenderContext::Inst()->selection.insert(instanceIds[i]);
-    }
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::SetSelection).WriteBlob(instanceIds, (uint32_t)count * sizeof(ObjectGUID)).EndCall();
+    RenderContext::Inst()->selection.Set(instanceIds, count);
 }
 
 //===============================================================================
@@ -758,6 +825,7 @@ bool HitRecordSorting(const HitRecord& n1, const HitRecord& n2)
 LVEDRENDERINGENGINE_API void __stdcall LvEd_SetRenderState(ObjectGUID instId)
 {
     ErrorHandler::ClearError();
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::SetRenderState).Write(instId).EndCall();
     RenderState* renderState = reinterpret_cast<RenderState*>(instId);    
     RenderContext::Inst()->SetState(renderState);
 }
@@ -765,6 +833,9 @@ bool HitRecordSorting(const HitRecord& n1, const HitRecord& n2)
 LVEDRENDERINGENGINE_API void __stdcall LvEd_SetGameLevel(ObjectGUID instId)
 {
     ErrorHandler::ClearError();
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::SetGameLevel).Write(instId).EndCall();
+    // the batches reference the objects of the previous level.
+    s_engineData->staticBatcher.Clear();
     if(instId != 0)
     {
         GameLevel* gameLevel = reinterpret_cast<GameLevel*>(instId);
@@ -779,17 +850,26 @@ bool HitRecordSorting(const HitRecord& n1, const HitRecord& n2)
 LVEDRENDERINGENGINE_API ObjectGUID __stdcall LvEd_GetGameLevel()
 {
     ErrorHandler::ClearError();
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::GetGameLevel).EndCall();
     return s_engineData->GameLevel ? s_engineData->GameLevel->GetInstanceId() : 0;
 }
 
 LVEDRENDERINGENGINE_API void __stdcall LvEd_WaitForPendingResources()
 {
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::WaitForPendingResources).EndCall();
 	ResourceManager::Inst()->WaitOnPending();
 }
 
+// time LvEd_Update spends evicting resources when over the memory budget.
+static const float ResourceCollectSliceMs = 0.5f;
+
 LVEDRENDERINGENGINE_API void __stdcall LvEd_Update(FrameTime* ft, UpdateTypeEnum updateType)
 {    
     ErrorHandler::ClearError();    
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::Update).Write(*ft).Write<int32_t>(updateType).EndCall();
+    ResourceManager::Inst()->DispatchLoaded();
+    ResourceManager::Inst()->CollectIncremental(ResourceCollectSliceMs);
+    TextureStreamer::Inst()->Update();
     s_engineData->GameLevel->Update(*ft, updateType);  
 	ShaderLib::Inst()->Update(*ft, updateType);
 }
@@ -797,6 +877,8 @@ bool HitRecordSorting(const HitRecord& n1, const HitRecord& n2)
 LVEDRENDERINGENGINE_API void __stdcall LvEd_Begin(ObjectGUID renderSurface, float viewxform[], float projxform[])
 {
     ErrorHandler::ClearError();
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::Begin).Write(renderSurface).WriteBytes(viewxform, 16 * sizeof(float))
+        .WriteBytes(projxform, 16 * sizeof(float)).EndCall();
     
     s_engineData->pRenderSurface = reinterpret_cast<RenderSurface*>(renderSurface);
 
@@ -838,6 +920,7 @@ bool HitRecordSorting(const HitRecord& n1, const HitRecord& n2)
     light.diffuse = float3(250.0f/255.0f, 245.0f/255.0f, 240.0f/255.0f);       
     light.specular = light.diffuse; // float3(0.4f,0.4f,0.4f);
     light.dir = float3(0.258819073f, -0.965925932f, 0.0f);
+    LightingState::Inst()->LightChanged(&light); // no-op unless the values differ.
     
     d3dcontext->ClearDepthStencilView( s_engineData->pRenderSurface->GetDepthStencilView(), D3D11_CLEAR_DEPTH, 1.0f, 0 );
     if(s_engineData->GameLevel->m_activeskyeDome && s_engineData->GameLevel->m_activeskyeDome->GetVisible())
@@ -863,9 +946,279 @@ bool NodeSortGreater(const RenderableNode& n1, const RenderableNode& n2)
 }
 
 
+// ---------------------------------------------------------------------------------------------------------
+// renders the shadow map of each cascade.
+static void RenderShadowMaps(GlobalRenderFlagsEnum flags)
+{
+    RenderContext* rc = RenderContext::Inst();
+    ShadowMaps* shadowMaps = ShadowMaps::Inst();
+    shadowMaps->UpdateCascades(rc->Context(), LightingState::Inst()->ProminentDirLight(), rc->Cam(), s_engineData->GameLevel->GetBounds());
+    const ShadowCascades& cascades = shadowMaps->GetCascades();
+    if(cascades.GetCount() == 0)
+        return;
+
+    // gather the casters from the volume covered by all the cascades,
+    // casters outside of the view frustum can still shadow visible objects.
+    ShadowCasterCollector& casters = s_engineData->shadowCasters;
+    casters.SetFlags(flags);
+    Matrix view = rc->Cam().View();
+    Matrix proj = rc->Cam().Proj();
+    rc->Cam().SetViewProj(cascades.GetLightView(), cascades.GetCasterProj());
+    // small feature culling is relative to the camera, not to the light.
+    float smallFeatureSize = rc->GetSmallFeatureSize();
+    rc->SetSmallFeatureSize(0);
+    s_engineData->GameLevel->GetRenderables(&casters, rc);
+    rc->SetSmallFeatureSize(smallFeatureSize);
+    rc->Cam().SetViewProj(view, proj);
+    casters.CullCasters(cascades);
+
+    s_engineData->shadowMapShader->Begin( rc, s_engineData->pRenderSurface );
+    for(uint32_t i = 0; i < cascades.GetCount(); ++i)
+    {
+        s_engineData->shadowMapShader->DrawCascade(i, casters);
+    }
+    s_engineData->shadowMapShader->End();
+    casters.ClearLists();
+}
+
+// ---------------------------------------------------------------------------------------------------------
+// rasterizes the terrain and the occluder nodes, then removes the nodes
+// hidden behind them from the sorter.
+static void CullOccludedRenderables()
+{
+    RenderContext* rc = RenderContext::Inst();
+    OcclusionCuller& culler = s_engineData->occlusionCuller;
+    culler.Begin(rc->Cam().View(), rc->Cam().Proj());
+
+    const Frustum& frustum = rc->Cam().GetFrustum();
+    auto terrainlist = &(s_engineData->GameLevel->Terrains);
+    for(auto it = terrainlist->begin(); it != terrainlist->end(); it++)
+    {
+        TerrainGob* terrain = (*it);
+        if(!terrain->IsVisible(frustum))
+            continue;
+        const TerrainPatchList& patches = terrain->Patches();
+        for(auto patch = patches.begin(); patch != patches.end(); patch++)
+        {
+            if(TestFrustumAABB(frustum, patch->bounds))
+            {
+                culler.RasterizeHeightGrid(terrain->GetOccluderHeights(*patch), TerrainGob::GetOccluderDim(),
+                    patch->x * terrain->GetCellSize(), patch->y * terrain->GetCellSize(),
+                    terrain->GetOccluderStep(), terrain->GetWorldTransform());
+            }
+        }
+    }
+
+    RenderableNodeSorter& sorter = s_engineData->renderableSorter;
+    for(unsigned int i = 0; i < sorter.GetBucketCount(); ++i)
+    {
+        RenderableNodeSorter::Bucket& bucket = *sorter.GetBucket(i);
+        for(auto it = bucket.renderables.begin(); it != bucket.renderables.end(); it++)
+        {
+            Mesh* mesh = it->mesh;
+            if(it->GetFlag(RenderableNode::kOccluder) && mesh && mesh->primitiveType == PrimitiveType::TriangleList
+                && !mesh->pos.empty() && !mesh->indices.empty())
+            {
+                culler.RasterizeMesh(&mesh->pos[0], (uint32_t)mesh->pos.size(), &mesh->indices[0],
+                    (uint32_t)mesh->indices.size(), it->WorldXform, false);
+            }
+        }
+    }
+    culler.End();
+    if(!culler.HasOccluders())
+        return;
+
+    for(unsigned int i = 0; i < sorter.GetBucketCount(); ++i)
+    {
+        FrameNodeList& renderables = sorter.GetBucket(i)->renderables;
+        size_t count = 0;
+        for(size_t k = 0; k < renderables.size(); ++k)
+        {
+            if(culler.IsVisible(renderables[k].bounds))
+            {
+                if(count != k)
+                    renderables[count] = renderables[k];
+                count++;
+            }
+        }
+        renderables.resize(count);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------
+LVEDRENDERINGENGINE_API void __stdcall LvEd_SetOcclusionCulling(bool enable)
+{
+    ErrorHandler::ClearError();
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::SetOcclusionCulling).Write(enable).EndCall();
+    s_engineData->occlusionCulling = enable;
+}
+
+// ---------------------------------------------------------------------------------------------------------
+LVEDRENDERINGENGINE_API void __stdcall LvEd_SetSmallFeatureCulling(float pixels)
+{
+    ErrorHandler::ClearError();
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::SetSmallFeatureCulling).Write(pixels).EndCall();
+    RenderContext::Inst()->SetSmallFeatureSize(pixels);
+}
+
+// ---------------------------------------------------------------------------------------------------------
+LVEDRENDERINGENGINE_API void __stdcall LvEd_GetOcclusionStats(uint32_t* occluderTriangles, uint32_t* tested, uint32_t* culled)
+{
+    ErrorHandler::ClearError();
+    const OcclusionStats& stats = s_engineData->occlusionCuller.GetStats();
+    if(occluderTriangles) *occluderTriangles = stats.occluderTriangles;
+    if(tested) *tested = stats.tested;
+    if(culled) *culled = stats.culled;
+}
+
+// ---------------------------------------------------------------------------------------------------------
+LVEDRENDERINGENGINE_API void __stdcall LvEd_GetFrameMemoryStats(uint32_t* peakBytes, uint32_t* overflowBytes, uint32_t* capacityBytes)
+{
+    ErrorHandler::ClearError();
+    FrameArena* arena = FrameArena::Inst();
+    if(peakBytes) *peakBytes = arena->GetPeakBytes();
+    if(overflowBytes) *overflowBytes = arena->GetOverflowBytes();
+    if(capacityBytes) *capacityBytes = arena->GetCapacity();
+}
+
+// ---------------------------------------------------------------------------------------------------------
+LVEDRENDERINGENGINE_API void __stdcall LvEd_SetResourceMemoryBudget(uint32_t megabytes)
+{
+    ErrorHandler::ClearError();
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::SetResourceMemoryBudget).Write(megabytes).EndCall();
+    ResourceManager::Inst()->SetMemoryBudget((uint64_t)megabytes * 1024 * 1024);
+}
+
+// ---------------------------------------------------------------------------------------------------------
+LVEDRENDERINGENGINE_API void __stdcall LvEd_GetResourceMemoryStats(uint64_t* loadedBytes, uint64_t* budgetBytes)
+{
+    ErrorHandler::ClearError();
+    ResourceManager* rm = ResourceManager::Inst();
+    if(loadedBytes) *loadedBytes = rm->GetLoadedBytes();
+    if(budgetBytes) *budgetBytes = rm->GetMemoryBudget();
+}
+
+// ---------------------------------------------------------------------------------------------------------
+LVEDRENDERINGENGINE_API void __stdcall LvEd_SetContentSharing(bool enable)
+{
+    ErrorHandler::ClearError();
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::SetContentSharing).Write(enable).EndCall();
+    ResourceManager::Inst()->SetContentSharing(enable);
+}
+
+// ---------------------------------------------------------------------------------------------------------
+LVEDRENDERINGENGINE_API void __stdcall LvEd_GetContentSharingStats(uint32_t* sharedCount, uint64_t* savedBytes)
+{
+    ErrorHandler::ClearError();
+    ResourceManager::Inst()->GetSharingStats(sharedCount, savedBytes);
+}
+
+// ---------------------------------------------------------------------------------------------------------
+LVEDRENDERINGENGINE_API void __stdcall LvEd_SetTextureCache(bool enable, bool compress)
+{
+    ErrorHandler::ClearError();
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::SetTextureCache).Write(enable).Write(compress).EndCall();
+    TextureCache::Inst()->SetOptions(enable, compress);
+}
+
+// ---------------------------------------------------------------------------------------------------------
+LVEDRENDERINGENGINE_API void __stdcall LvEd_SetTextureStreaming(bool enable, uint32_t budgetMegabytes)
+{
+    ErrorHandler::ClearError();
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::SetTextureStreaming).Write(enable).Write(budgetMegabytes).EndCall();
+    TextureStreamer* streamer = TextureStreamer::Inst();
+    streamer->SetEnabled(enable);
+    streamer->SetBudget((uint64_t)budgetMegabytes * 1024 * 1024);
+}
+
+// ---------------------------------------------------------------------------------------------------------
+LVEDRENDERINGENGINE_API void __stdcall LvEd_GetTextureStreamingStats(uint64_t* residentBytes, uint32_t* textureCount, uint32_t* pendingCount)
+{
+    ErrorHandler::ClearError();
+    TextureStreamer::Inst()->GetStats(residentBytes, textureCount, pendingCount);
+}
+
+// ---------------------------------------------------------------------------------------------------------
+LVEDRENDERINGENGINE_API bool __stdcall LvEd_MountArchive(wchar_t* archiveFile, wchar_t* mountDir)
+{
+    ErrorHandler::ClearError();
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::MountArchive).WriteString(archiveFile).WriteString(mountDir).EndCall();
+    return ResourceManager::Inst()->MountArchive(archiveFile, mountDir);
+}
+
+// ---------------------------------------------------------------------------------------------------------
+LVEDRENDERINGENGINE_API int __stdcall LvEd_PackArchive(wchar_t* rootDir, wchar_t* archiveFile, bool compress)
+{
+    ErrorHandler::ClearError();
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::PackArchive).WriteString(rootDir).WriteString(archiveFile).Write(compress).EndCall();
+    return AssetArchive::Pack(rootDir, archiveFile, compress);
+}
+
+// ---------------------------------------------------------------------------------------------------------
+LVEDRENDERINGENGINE_API int __stdcall LvEd_BuildStaticBatches(float cellSize)
+{
+    ErrorHandler::ClearError();
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::BuildStaticBatches).Write(cellSize).EndCall();
+    StaticBatcher& batcher = s_engineData->staticBatcher;
+    batcher.Clear();
+    if(s_engineData->GameLevel == NULL)
+    {
+        ErrorHandler::SetError(ErrorType::UnknownError, L"%s: no GameLevel set", __WFUNCTION__);
+        return 0;
+    }
+
+    // collect from a camera looking down at the whole level,
+    // so the candidates don't depend on the current view.
+    RenderContext* rc = RenderContext::Inst();
+    const AABB& bounds = s_engineData->GameLevel->GetBounds();
+    if(bounds.Min().x > bounds.Max().x)
+        return 0; // empty level.
+    float3 center = bounds.GetCenter();
+    float3 extents = (bounds.Max() - bounds.Min()) * 0.5f;
+    float radius = maximize(extents.x, extents.z) + 1.0f;
+    float3 eye(center.x, bounds.Max().y + 1.0f, center.z);
+    Matrix view = rc->Cam().View();
+    Matrix proj = rc->Cam().Proj();
+    rc->Cam().SetViewProj(Matrix::CreateLookAtRH(eye, center, float3(0,0,-1)),
+        Matrix::CreateOrthographicOffCenter(-radius, radius, -radius, radius, 0.0f, 2.0f * extents.y + 2.0f));
+    float smallFeatureSize = rc->GetSmallFeatureSize();
+    rc->SetSmallFeatureSize(0);
+    batcher.ClearLists();
+    s_engineData->GameLevel->GetRenderables(&batcher, rc);
+    rc->SetSmallFeatureSize(smallFeatureSize);
+    rc->Cam().SetViewProj(view, proj);
+
+    uint32_t count = batcher.Build(rc->Device(), cellSize);
+    batcher.ClearLists();
+    return (int)count;
+}
+
+// ---------------------------------------------------------------------------------------------------------
+LVEDRENDERINGENGINE_API void __stdcall LvEd_ClearStaticBatches()
+{
+    ErrorHandler::ClearError();
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::ClearStaticBatches).EndCall();
+    s_engineData->staticBatcher.Clear();
+}
+
+// ---------------------------------------------------------------------------------------------------------
+LVEDRENDERINGENGINE_API void __stdcall LvEd_SetRenderThreadCount(int count)
+{
+    ErrorHandler::ClearError();
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::SetRenderThreadCount).Write<int32_t>(count).EndCall();
+    uint32_t numWorkers = count > 0 ? (uint32_t)(count - 1) : TaskPool::DefaultWorkerCount();
+    if(s_engineData->taskPool && s_engineData->taskPool->GetThreadCount() == numWorkers + 1)
+        return;
+
+    SAFE_DELETE(s_engineData->taskPool);
+    if(numWorkers > 0)
+        s_engineData->taskPool = new TaskPool(numWorkers);
+}
+
 // ---------------------------------------------------------------------------------------------------------
 LVEDRENDERINGENGINE_API void __stdcall LvEd_RenderGame()
 {
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::RenderGame).EndCall();
    
     s_engineData->basicRenderer->End(); 
 
@@ -883,7 +1236,12 @@ bool NodeSortGreater(const RenderableNode& n1, const RenderableNode& n2)
     GlobalRenderFlagsEnum flags = renderState->GetGlobalRenderFlags();
 
     s_engineData->renderableSorter.SetFlags( flags );
-    s_engineData->GameLevel->GetRenderables(&s_engineData->renderableSorter, RenderContext::Inst());
+    s_engineData->GameLevel->GetRenderablesParallel(&s_engineData->renderableSorter, RenderContext::Inst(), s_engineData->taskPool);
+    if(s_engineData->occlusionCulling)
+    {
+        CullOccludedRenderables();
+    }
+    s_engineData->staticBatcher.Apply(&s_engineData->renderableSorter);
    
     // sort semi-transparent objects back to front
      for(unsigned int i = 0; i < s_engineData->renderableSorter.GetBucketCount(); ++i)
@@ -908,17 +1266,7 @@ bool NodeSortGreater(const RenderableNode& n1, const RenderableNode& n2)
     //  Pre-Pass For Shadow Maps    
     if (renderShadows)
     {           
-        s_engineData->shadowMapShader->Begin( RenderContext::Inst(), s_engineData->pRenderSurface, s_engineData->GameLevel->GetBounds() );        
-        for(unsigned int i = 0; i < s_engineData->renderableSorter.GetBucketCount(); ++i)
-        {
-            RenderableNodeSorter::Bucket& bucket = *s_engineData->renderableSorter.GetBucket(i);
-            if (( bucket.shaderId == Shaders::TexturedShader ) &&
-                ( bucket.renderables.size() > 0 ))
-            {                     
-                s_engineData->shadowMapShader->DrawNodes( bucket.renderables);
-            }
-        }            
-        s_engineData->shadowMapShader->End();
+        RenderShadowMaps(flags);
     }
    
     // render  opaque objects
@@ -935,6 +1283,25 @@ bool NodeSortGreater(const RenderableNode& n1, const RenderableNode& n2)
         }
     }     
 
+    // wire-frame of the selected objects, or of everything in wire-frame mode,
+    // drawn from the nodes of the solid pass.
+    bool allWire = (flags & GlobalRenderFlags::WireFrame) != 0;
+    if((flags & GlobalRenderFlags::Solid) && (allWire || RenderContext::Inst()->selection.Count() > 0))
+    {
+        WireFrameShader* wshader = (WireFrameShader*)ShaderLib::Inst()->GetShader(Shaders::WireFrameShader);
+        wshader->Begin(RenderContext::Inst());
+        for(unsigned int i = 0; i < s_engineData->renderableSorter.GetBucketCount(); ++i)
+        {
+            RenderableNodeSorter::Bucket& bucket = *s_engineData->renderableSorter.GetBucket(i);
+            if ( bucket.renderables.size() > 0 && bucket.shaderId != Shaders::WireFrameShader)
+            {
+                wshader->SetRenderFlag( bucket.renderFlags );
+                wshader->DrawHighlights( bucket.renderables, allWire );
+            }
+        }
+        wshader->End();
+    }
+
     auto terrainlist = &(s_engineData->GameLevel->Terrains);
     if(terrainlist->size() > 0)
     {
@@ -1058,6 +1425,7 @@ static void RenderWorldAxis()
 // ---------------------------------------------------------------------------------------------------------
 LVEDRENDERINGENGINE_API void __stdcall LvEd_End()
 {
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::End).EndCall();
     RenderContext* rc = RenderContext::Inst();
     RenderSurface* surface = s_engineData->pRenderSurface;
 
@@ -1070,18 +1438,26 @@ static void RenderWorldAxis()
     {        
         RenderWorldAxis();
         SwapChain* swapchain = static_cast<SwapChain*>(surface);
-        HRESULT hr = swapchain->GetDXGISwapChain()->Present(0,0);
-        Logger::IsFailureLog(hr, L"presenting swapchain");
+        if(swapchain->GetDXGISwapChain())
+        {
+            HRESULT hr = swapchain->GetDXGISwapChain()->Present(0,0);
+            Logger::IsFailureLog(hr, L"presenting swapchain");
+        }
     }
+    TransientBuffer::Inst()->EndFrame(gD3D11->GetImmediateContext());
+    // headless frames aren't presented, the null device finishes them at a flush.
+    if(s_headless)
+        gD3D11->GetImmediateContext()->Flush();
 
     s_engineData->renderableSorter.ClearLists();    
     s_engineData->pRenderSurface = NULL;    
-    RenderContext::Inst()->LightEnvDirty = false; 
+    FrameArena::Inst()->Reset();
 }
 
 LVEDRENDERINGENGINE_API bool __stdcall LvEd_SaveRenderSurfaceToFile(ObjectGUID renderSurfaceId, wchar_t *fileName)
 {
     ErrorHandler::ClearError();
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::SaveRenderSurfaceToFile).Write(renderSurfaceId).WriteString(fileName).EndCall();
        
     if(fileName == NULL || wcslen(fileName) == 0 )
     {
@@ -1108,7 +1484,10 @@ static void RenderWorldAxis()
 LVEDRENDERINGENGINE_API ObjectGUID __stdcall LvEd_CreateVertexBuffer(VertexFormatEnum vf, void* buffer, uint32_t vertexCount)
 {
     ErrorHandler::ClearError();
-    return s_engineData->basicRenderer->CreateVertexBuffer(vf,buffer,vertexCount);
+    ObjectGUID vb = s_engineData->basicRenderer->CreateVertexBuffer(vf,buffer,vertexCount);
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::CreateVertexBuffer).Write<int32_t>(vf).Write(vertexCount)
+        .WriteBlob(buffer, GpuResourceFactory::GetVertexSize(vf) * vertexCount).Write(vb).EndCall();
+    return vb;
 }
 
 // ---------------------------------------------------------------------------------------------------------
@@ -1116,7 +1495,9 @@ static void RenderWorldAxis()
 LVEDRENDERINGENGINE_API ObjectGUID __stdcall LvEd_CreateIndexBuffer(uint32_t* buffer, uint32_t indexCount)
 {
     ErrorHandler::ClearError();
-    return s_engineData->basicRenderer->CreateIndexBuffer(buffer,indexCount);
+    ObjectGUID ib = s_engineData->basicRenderer->CreateIndexBuffer(buffer,indexCount);
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::CreateIndexBuffer).Write(indexCount).WriteBlob(buffer, indexCount * sizeof(uint32_t)).Write(ib).EndCall();
+    return ib;
 }
 
 
@@ -1124,12 +1505,14 @@ static void RenderWorldAxis()
 LVEDRENDERINGENGINE_API void __stdcall LvEd_DeleteBuffer(ObjectGUID buffer)
 {
     ErrorHandler::ClearError();
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::DeleteBuffer).Write(buffer).EndCall();
     s_engineData->basicRenderer->DeleteBuffer(buffer);
 }
 
 
 LVEDRENDERINGENGINE_API void __stdcall LvEd_SetRendererFlag(BasicRendererFlagsEnum renderFlags)
 {
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::SetRendererFlag).Write<int32_t>(renderFlags).EndCall();
     s_engineData->basicRenderer->SetRendererFlag(renderFlags);
 }
 
@@ -1143,6 +1526,8 @@ static void RenderWorldAxis()
                                                     float* xform)                                                    
 {
     ErrorHandler::ClearError();
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::DrawPrimitive).Write<int32_t>(pt).Write(vb).Write(StartVertex).Write(vertexCount)
+        .WriteBlob(color, 4 * sizeof(float)).WriteBlob(xform, 16 * sizeof(float)).EndCall();
     s_engineData->basicRenderer->DrawPrimitive(pt,vb,StartVertex, vertexCount,color,xform);
 }
 
@@ -1157,19 +1542,33 @@ static void RenderWorldAxis()
                                                                 float* xform)
 {
     ErrorHandler::ClearError();
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::DrawIndexedPrimitive).Write<int32_t>(pt).Write(vb).Write(ib).Write(startIndex).Write(indexCount)
+        .Write(startVertex).WriteBlob(color, 4 * sizeof(float)).WriteBlob(xform, 16 * sizeof(float)).EndCall();
     s_engineData->basicRenderer->DrawIndexedPrimitive(pt,vb,ib,startIndex,indexCount,startVertex,color,xform);
 }
 
+// ---------------------------------------------------------------------------------------------------------
+LVEDRENDERINGENGINE_API void __stdcall LvEd_DrawBatch(BasicDrawItem* items, int count)
+{
+    ErrorHandler::ClearError();
+    if(count <= 0 || items == NULL) return;
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::DrawBatch).WriteBlob(items, count * sizeof(BasicDrawItem)).EndCall();
+    s_engineData->basicRenderer->DrawBatch(items,(uint32_t)count);
+}
+
 // ---------------------------------------------------------------------------------------------------------
 LVEDRENDERINGENGINE_API ObjectGUID LvEd_CreateFont(WCHAR* fontName, float pixelHeight, LvEdFonts::FontStyleFlags fontStyles )
 {
     ErrorHandler::ClearError();
-    return (ObjectGUID)LvEdFonts::Font::CreateNewInstance( gD3D11->GetDevice(), fontName, pixelHeight, fontStyles );
+    ObjectGUID font = (ObjectGUID)LvEdFonts::Font::CreateNewInstance( gD3D11->GetDevice(), fontName, pixelHeight, fontStyles );
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::CreateFontInstance).WriteString(fontName).Write(pixelHeight).Write<int32_t>(fontStyles).Write(font).EndCall();
+    return font;
 }
 
 LVEDRENDERINGENGINE_API void __stdcall LvEd_DeleteFont(ObjectGUID font)
 {
     ErrorHandler::ClearError();
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::DeleteFont).Write(font).EndCall();
     using namespace LvEdFonts;
     Font* pFont = reinterpret_cast<Font*>(font);
     delete pFont;
@@ -1179,6 +1578,7 @@ static void RenderWorldAxis()
 LVEDRENDERINGENGINE_API void LvEd_DrawText2D(ObjectGUID font, WCHAR* text, int x, int y, int color)
 {
     ErrorHandler::ClearError();
+    if(s_trace.IsOpen()) s_trace.BeginCall(ApiCall::DrawText2D).Write(font).WriteString(text).Write<int32_t>(x).Write<int32_t>(y).Write<int32_t>(color).EndCall();
     using namespace LvEdFonts;    
     Font* pFont = reinterpret_cast<Font*>(font);
 
@@ -1187,6 +1587,30 @@ static void RenderWorldAxis()
     FontRenderer::Inst()->DrawText( pFont, text, x, y, colorRGBA );
 }
 
+//===============================================================================
+// Trace
+//===============================================================================
+
+LVEDRENDERINGENGINE_API bool __stdcall LvEd_StartTrace(wchar_t* traceFile)
+{
+    ErrorHandler::ClearError();
+    LvEd_StopTrace();
+    if(!s_trace.Open(traceFile))
+    {
+        ErrorHandler::SetError(ErrorType::UnknownError, L"%s: can't create %s", __WFUNCTION__, traceFile);
+        return false;
+    }
+    Logger::Log(OutputMessageType::Info, L"Recording API trace to %s\n", traceFile);
+    return true;
+}
+
+LVEDRENDERINGENGINE_API void __stdcall LvEd_StopTrace()
+{
+    if(!s_trace.IsOpen()) return;
+    Logger::Log(OutputMessageType::Info, L"API trace stopped, %d calls recorded\n", s_trace.GetCallCount());
+    s_trace.Close();
+}
+
 //===============================================================================
 // Error Handling
 //===============================================================================
@@ -1207,8 +1631,8 @@ static void RenderWorldAxis()
 //=========================================
 
 
-#include "rapidxml-1.13\rapidxml.hpp"
-#include "rapidxml-1.13\rapidxml_print.hpp"
+#include "rapidxml-1.13/rapidxml.hpp"
+#include "rapidxml-1.13/rapidxml_print.hpp"
 typedef rapidxml::xml_document<wchar_t> XmlDocument;
 typedef rapidxml::xml_node<wchar_t> XmlNode;
 typedef rapidxml::xml_attribute<wchar_t> XmlAttribute;
@@ -37,6 +37,7 @@ namespace LvEdEngine
 {
     class RenderSurface;
     class Ray;
+    struct BasicDrawItem;
 }
 
 using namespace LvEdEngine;
@@ -64,6 +65,18 @@ class Ray;
     InvalidateViewsCallbackType invalidateCallback, 
     const wchar_t** outEngineInfo);
 
+/**
+ * Runs the engine on a null device that needs no GPU.
+ *
+ * Resources are kept in CPU memory and nothing is drawn, but updating,
+ * picking and building the frames work as usual, for benchmarks and tests.
+ * Swap chains render to offscreen textures.
+ * Must be called before LvEd_Initialize.
+ *
+ * @param headless true to use the null device.
+ */
+extern "C" LVEDRENDERINGENGINE_API void __stdcall LvEd_SetHeadless(bool headless);
+
 
 /**
  * Shuts down the game-rendering engine.
@@ -249,6 +262,7 @@ class Ray;
  * @param count Number of picked objects
  *
  * @remark The HitRecords are sorted along the ray.
+ *         The array is valid until the next pick or LvEd_End call.
  *
  * @return TRUE if one or more objects picked, FALSE otherwise
  *
@@ -266,6 +280,8 @@ class Ray;
  * @param hits An array of HitRecord 
  * @param count Number of picked objects
  *
+ * @remark The array is valid until the next pick or LvEd_End call.
+ *
  * @return TRUE if one or more objects picked, FALSE otherwise
  *
  */
@@ -364,6 +380,176 @@ class Ray;
  */
 extern "C" LVEDRENDERINGENGINE_API void __stdcall LvEd_RenderGame();
 
+/**
+ * Sets the number of threads LvEd_RenderGame uses to collect renderables.
+ *
+ * The top level objects of the game level are distributed among the threads
+ * and the results are merged in the same order as the serial path, so the
+ * rendered output doesn't depend on the thread count.
+ *
+ * @param count number of threads including the calling thread.
+ *        1 collects on the calling thread only, 0 picks a count suited
+ *        to this machine (the default).
+ */
+extern "C" LVEDRENDERINGENGINE_API void __stdcall LvEd_SetRenderThreadCount(int count);
+
+/**
+ * Enables software occlusion culling in LvEd_RenderGame (enabled by default).
+ *
+ * Terrain and objects flagged as occluders (see GameObject "SetOccluder")
+ * are rasterized into a small CPU depth buffer and renderables hidden
+ * behind them are not drawn.
+ */
+extern "C" LVEDRENDERINGENGINE_API void __stdcall LvEd_SetOcclusionCulling(bool enable);
+
+/**
+ * Sets the small feature culling threshold of LvEd_RenderGame.
+ *
+ * Game objects whose bounds are smaller than the given size on screen are
+ * not drawn, selected objects are always drawn.
+ *
+ * @param pixels size in pixels, 0 disables small feature culling (the default).
+ */
+extern "C" LVEDRENDERINGENGINE_API void __stdcall LvEd_SetSmallFeatureCulling(float pixels);
+
+/**
+ * Gets the occlusion culling statistics of the last LvEd_RenderGame call.
+ *
+ * @param occluderTriangles triangles rasterized into the depth buffer.
+ * @param tested number of renderables tested.
+ * @param culled number of renderables that were not drawn.
+ */
+extern "C" LVEDRENDERINGENGINE_API void __stdcall LvEd_GetOcclusionStats(uint32_t* occluderTriangles, uint32_t* tested, uint32_t* culled);
+
+/**
+ * Gets the per-frame memory statistics of the last LvEd_End call.
+ * Render lists, hit records and other data that only lives for one frame
+ * are allocated from a linear arena that is reset by LvEd_End.
+ *
+ * @param peakBytes bytes allocated during the frame.
+ * @param overflowBytes bytes that didn't fit in the arena and came from the heap,
+ *        the arena grows so the next frame fits.
+ * @param capacityBytes size of the arena.
+ */
+extern "C" LVEDRENDERINGENGINE_API void __stdcall LvEd_GetFrameMemoryStats(uint32_t* peakBytes, uint32_t* overflowBytes, uint32_t* capacityBytes);
+
+/**
+ * Sets the memory budget of the loaded resources.
+ *
+ * Resources stay cached after the objects using them are destroyed.
+ * While the textures and models loaded take more memory than the budget,
+ * LvEd_Update evicts the unreferenced ones, least recently used first,
+ * spending at most a fraction of a millisecond per call.
+ *
+ * @param megabytes CPU and GPU memory of the loaded resources, 1024 by default.
+ */
+extern "C" LVEDRENDERINGENGINE_API void __stdcall LvEd_SetResourceMemoryBudget(uint32_t megabytes);
+
+/**
+ * Gets the memory taken by the loaded resources and the budget, in bytes.
+ */
+extern "C" LVEDRENDERINGENGINE_API void __stdcall LvEd_GetResourceMemoryStats(uint64_t* loadedBytes, uint64_t* budgetBytes);
+
+/**
+ * Enables sharing resources between files with identical contents.
+ *
+ * Paths are always compared as full lower case paths. With content sharing
+ * the files loaded asynchronously are also hashed, and a texture whose bytes
+ * match one already loaded or loading uses the same GPU texture.
+ *
+ * @param enable TRUE by default.
+ */
+extern "C" LVEDRENDERINGENGINE_API void __stdcall LvEd_SetContentSharing(bool enable);
+
+/**
+ * Gets the content sharing statistics since LvEd_Initialize.
+ *
+ * @param sharedCount resources that shared the contents of another one.
+ * @param savedBytes memory those resources would have taken.
+ */
+extern "C" LVEDRENDERINGENGINE_API void __stdcall LvEd_GetContentSharingStats(uint32_t* sharedCount, uint64_t* savedBytes);
+
+/**
+ * Sets the options of the processed texture cache.
+ *
+ * Textures that aren't dds files are decoded and get a full mip chain when
+ * they are loaded. The result is saved in the local cache directory, named
+ * after the hash of the file and the options, and later loads of the same
+ * contents read it instead. Changing the options only affects new loads.
+ *
+ * @param enable TRUE by default.
+ * @param compress block compress the cached textures to BC1, or BC3 when
+ *                 they have alpha. Slow the first time. FALSE by default.
+ */
+extern "C" LVEDRENDERINGENGINE_API void __stdcall LvEd_SetTextureCache(bool enable, bool compress);
+
+/**
+ * Sets the mip streaming of the large textures.
+ *
+ * Textures larger than 512 pixels that can be read again from a dds file,
+ * their own or their texture cache entry, are loaded with their small mips
+ * only. The mips needed for the size of the objects on screen are streamed
+ * in by LvEd_Update, within the budget: when the textures don't fit, the
+ * ones drawn least recently lose their most detailed mips first.
+ *
+ * @param enable TRUE by default. Only affects the textures loaded afterwards,
+ *               except that disabling brings the streamed textures to full resolution.
+ * @param budgetMegabytes memory for the mips of the streamed textures, 512 by default.
+ */
+extern "C" LVEDRENDERINGENGINE_API void __stdcall LvEd_SetTextureStreaming(bool enable, uint32_t budgetMegabytes);
+
+/**
+ * Gets the state of the texture streaming.
+ *
+ * @param residentBytes memory of the streamed textures at their current mips.
+ * @param textureCount number of streamed textures.
+ * @param pendingCount uploads in progress.
+ */
+extern "C" LVEDRENDERINGENGINE_API void __stdcall LvEd_GetTextureStreamingStats(uint64_t* residentBytes, uint32_t* textureCount, uint32_t* pendingCount);
+
+/**
+ * Mounts an asset archive created by LvEd_PackArchive.
+ *
+ * Resources under mountDir are loaded from the archive when it contains
+ * them, and from the disk otherwise. Archives mounted last are searched
+ * first, they stay mounted until LvEd_Shutdown.
+ *
+ * @param archiveFile the archive.
+ * @param mountDir directory the archive was packed from, or where it replaces it.
+ * @return TRUE if the archive was mounted.
+ */
+extern "C" LVEDRENDERINGENGINE_API bool __stdcall LvEd_MountArchive(wchar_t* archiveFile, wchar_t* mountDir);
+
+/**
+ * Packs every file under a directory into an asset archive.
+ *
+ * @param rootDir directory to pack, for example the AssetRoot.
+ * @param archiveFile archive to create, it is overwritten.
+ * @param compress compress the files that get noticeably smaller.
+ * @return the number of files packed, -1 on failure.
+ */
+extern "C" LVEDRENDERINGENGINE_API int __stdcall LvEd_PackArchive(wchar_t* rootDir, wchar_t* archiveFile, bool compress);
+
+/**
+ * Merges the small static meshes of the current game level into batches.
+ *
+ * Meshes that share a material and a vertex format within a cell are
+ * pre-transformed into a combined mesh. LvEd_RenderGame draws the batched
+ * objects with one draw per batch as long as they don't move, selection
+ * and picking still work on the individual objects.
+ * Call it once the level and its models are loaded, the batches are
+ * released by LvEd_ClearStaticBatches or when the game level changes.
+ *
+ * @param cellSize size of the grid cells used to group the meshes.
+ * @return number of batches.
+ */
+extern "C" LVEDRENDERINGENGINE_API int __stdcall LvEd_BuildStaticBatches(float cellSize);
+
+/**
+ * Releases the batches built by LvEd_BuildStaticBatches.
+ */
+extern "C" LVEDRENDERINGENGINE_API void __stdcall LvEd_ClearStaticBatches();
+
 /**
  * Saves render surface to the given file path.
  * if the file exit it will be overwritten.
@@ -463,6 +649,18 @@ class Ray;
                                                                     float* xform);
                                                                     
 
+/**
+ * Draws many primitives in one call, with the flags of LvEd_SetRendererFlag.
+ * The draws are sorted to reduce state changes, unless depth test is disabled,
+ * and their transforms and colors are uploaded at once.
+ *
+ * @param items Array of draw descriptors, see BasicDrawItem in BasicRenderer.h.
+ *              An item with a zero ib is a non indexed draw.
+ * @param count Number of items
+ *
+ */
+extern "C" LVEDRENDERINGENGINE_API void __stdcall LvEd_DrawBatch(LvEdEngine::BasicDrawItem* items, int count);
+
 
 //=============================================================================
 // LevelEditor Font Support Functions
@@ -504,6 +702,32 @@ class Ray;
 extern "C" LVEDRENDERINGENGINE_API void LvEd_DrawText2D(ObjectGUID font, WCHAR* text, int x, int y, int color);
 
 
+//==============================================================================
+// Trace Functions
+//==============================================================================
+
+/**
+ * Starts recording the API calls and their arguments to a trace file.
+ *
+ * Recording also starts from LvEd_Initialize when the LVED_API_TRACE
+ * environment variable names a trace file, and stops at LvEd_Shutdown.
+ * Data the editor writes directly into engine memory, such as the pixels
+ * of terrain maps, is not recorded, nor are the Get*Stats queries and
+ * LvEd_GetLastError, which only read engine state.
+ * LvEdTraceReplay replays the traces.
+ *
+ * @param traceFile file to record to, it is overwritten.
+ * @return TRUE if the file was created.
+ */
+extern "C" LVEDRENDERINGENGINE_API bool __stdcall LvEd_StartTrace(wchar_t* traceFile);
+
+/**
+ * Stops recording and closes the trace file.
+ */
+extern "C" LVEDRENDERINGENGINE_API void __stdcall LvEd_StopTrace();
+
+
+
 /**
  * Gets the last error type.  Error results on each API call, but is thread specific
  *
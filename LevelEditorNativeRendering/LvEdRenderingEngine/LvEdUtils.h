@@ -2,7 +2,7 @@
 
 #pragma once
 
-#include "Renderer\RenderableNodeSet.h"
+#include "Renderer/RenderableNodeSet.h"
 #include <set>
 #include "Core/Object.h"
 
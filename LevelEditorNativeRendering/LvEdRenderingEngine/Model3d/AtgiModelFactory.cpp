@@ -173,6 +173,9 @@ namespace LvEdEngine
             material->texNames[i] = texFilename;
         }
     }
+
+    // the textures load while the rest of the file is parsed.
+    builder->m_model->RequestTextures(material, ResourceManager::Inst());
 }
 
 // ------------------------------------------------------------------------------------------------
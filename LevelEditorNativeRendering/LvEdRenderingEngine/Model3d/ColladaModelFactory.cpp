@@ -420,6 +420,9 @@ namespace LvEdEngine
         }
     }
 
+    // the textures load while the rest of the file is parsed.
+    builder->m_model->RequestTextures(mat, ResourceManager::Inst());
+
 
         
 }
@@ -708,7 +711,7 @@ namespace LvEdEngine
         xml_node* asset = rootXml->first_node("asset");
         xml_node* upaxisNode =  asset->first_node("up_axis");        
         
-        if(upaxisNode && strcmpi(upaxisNode->value(),"Z_UP") == 0)
+        if(upaxisNode && _stricmp(upaxisNode->value(),"Z_UP") == 0)
         {
             rootNode->transform = Matrix::CreateRotationX(-PiOver2);
         }
@@ -56,13 +56,23 @@ namespace LvEdEngine
     
     bool ObjModelFactory::LoadResource(Resource* resource, const WCHAR * filename)
     {
-        UINT dataSize;
-        BYTE* data = FileUtils::LoadFile(filename, &dataSize);
-        if (!data)
+        ResourceData data;
+        if (!ReadResource(filename, &data))
         {
             return false;
         }
+        bool succeeded = ProcessResource(resource, filename, data);
+        return succeeded;
+    }
+
+    bool ObjModelFactory::ReadResource(const WCHAR* filename, ResourceData* data)
+    {
+        return data->Map(filename);
+    }
 
+    // the material library is small and read here.
+    bool ObjModelFactory::ProcessResource(Resource* resource, const WCHAR* filename, const ResourceData& data)
+    {
         Model * model = (Model*)resource;
         model->SetSourceFileName(filename);
 
@@ -72,30 +82,23 @@ namespace LvEdEngine
         bool succeeded = true;
         builder.Begin();
         {
-            std::vector<byte> vData; vData.resize(dataSize);
-            memcpy(&vData[0], data, dataSize);
-            SAFE_DELETE_ARRAY(data);
-
-            // let's parse OBJ
-            champ::ObjParser parser(vData);
+            // let's parse OBJ, straight from the mapped file
+            champ::ObjParser parser(data.bytes, data.size);
             champ::MtlParser mtlParser;
             if (!parser.m_materialLib.empty())
             {
                 // let's parse Mtl
                 std::wstring matFname = ToWstring(parser.m_materialLib);
-                BYTE* matData = FileUtils::LoadFile(matFname.c_str(), &dataSize);
-                if (!matData)
+                ResourceData matData;
+                if (!matData.Map(matFname.c_str()))
                 {
                     matFname = StrExtractPath(filename) + L"\\" + StrExtractFilename(matFname);
-                    matData = FileUtils::LoadFile(matFname.c_str(), &dataSize);
+                    matData.Map(matFname.c_str());
                 }
 
-                if (matData && dataSize>0)
+                if (matData.size > 0)
                 {
-                    std::vector<byte> matVData; matVData.resize(dataSize);
-                    memcpy(&matVData[0], matData, dataSize);
-                    SAFE_DELETE_ARRAY(matData);
-                    mtlParser.Parse(matVData);
+                    mtlParser.Parse(matData.bytes, matData.size);
                 }
             }
 
@@ -111,6 +114,7 @@ namespace LvEdEngine
                 material->power = mat->ns;
                 material->texNames[TextureType::DIFFUSE] = StrExtractFilename(mat->map_kd);
                 material->texNames[TextureType::SPEC] = StrExtractFilename(mat->map_ks);
+                builder.m_model->RequestTextures(material, ResourceManager::Inst());
             }
 
             // scene
@@ -177,6 +181,7 @@ namespace LvEdEngine
             model->Construct(m_device, ResourceManager::Inst());
         else
             model->Destroy();
+        return succeeded;
     }
     
     Resource* ObjModelFactory::CreateResource(Resource* )
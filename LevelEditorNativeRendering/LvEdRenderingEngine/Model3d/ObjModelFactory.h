@@ -11,6 +11,8 @@ class ObjModelFactory : public ResourceFactory
     public:
         ObjModelFactory(ID3D11Device* device);
         virtual bool LoadResource(Resource* resource, const WCHAR * filename);
+        virtual bool ReadResource(const WCHAR* filename, ResourceData* data);
+        virtual bool ProcessResource(Resource* resource, const WCHAR* filename, const ResourceData& data);
         virtual Resource* CreateResource(Resource* def);
 
     protected:
@@ -5,6 +5,7 @@
 #include <vector>
 #include <map>
 #include <cctype>
+#include <cstring>
 #include <functional>
 #include "../Core/Logger.h"
 #include "../Core/FileUtils.h"
@@ -156,27 +157,22 @@ struct Group
     return StrLtrim(StrRtrim(s));
 }
 
-inline bool GetLine(const std::vector<byte>& data, size_t& cur, std::string& outLine)
+inline bool GetLine(const byte* data, size_t size, size_t& cur, std::string& outLine)
 {
-    if (cur >= data.size()) return false;
-    outLine.clear();
-    char c;
-    while (cur < data.size() && (c = data[cur]) != '\n')
-    {
-        outLine += c;
-        ++cur;
-    }
-
-    if (c == '\n')
-        ++cur;
+    if (cur >= size) return false;
+    const byte* start = data + cur;
+    const byte* end = (const byte*)memchr(start, '\n', size - cur);
+    if (!end) end = data + size;
+    outLine.assign((const char*)start, (const char*)end);
+    cur = (end - data) + 1; // past the '\n'
 
     StrTrim(outLine);
-    return cur <= data.size();
+    return true;
 }
 
-ObjParser::ObjParser(const std::vector<byte>& data)
+ObjParser::ObjParser(const byte* data, size_t size)
 {
-    if (data.empty()) return;
+    if (!data || size == 0) return;
     std::vector<Group> groups;
     std::vector<v3> positions;
     std::vector<v3> normals;
@@ -189,7 +185,7 @@ struct Group
     v3 _v3;
     v2 _v2;
     bool doneRecenter = false;
-    while ( GetLine(data, cur, line) )
+    while ( GetLine(data, size, cur, line) )
     {
         if (line.empty()) continue;
         switch (*line.begin())
@@ -380,12 +376,12 @@ mttoken mtl_tokenize(const std::string& w, int* m)
 #define TOKEN_1IN(n) case MT_##n: parseint  (v, 1, &curMat->n); break
 
 
-void MtlParser::Parse(const std::vector<byte>& data)
+void MtlParser::Parse(const byte* data, size_t size)
 {
     size_t cur = 0;
     std::string line, w, v;
     Material* curMat = nullptr;
-    while (GetLine(data, cur, line))
+    while (GetLine(data, size, cur, line))
     {
         if (line.empty()) continue;
         if (*line.begin() == '#') continue;
@@ -31,7 +31,8 @@ struct SubObj
         };
 
     public:
-        ObjParser(const std::vector<byte>& data);
+        // data is only read, it doesn't need to be zero terminated.
+        ObjParser(const byte* data, size_t size);
 
         std::vector<SubObj> m_objects;        
         std::string m_materialLib;
@@ -65,7 +66,7 @@ struct Material
         };
 
     public:
-        void Parse(const std::vector<byte>& data);
+        void Parse(const byte* data, size_t size);
 
         std::map<std::string, Material*> m_materials;
     };
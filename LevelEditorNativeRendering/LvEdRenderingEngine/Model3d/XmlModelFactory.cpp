@@ -20,13 +20,25 @@ namespace LvEdEngine
 // ----------------------------------------------------------------------------------------------
 bool XmlModelFactory::LoadResource(Resource* resource, const WCHAR * filename)
 {
-    UINT dataSize;
-    BYTE* data = FileUtils::LoadFile(filename, &dataSize);
-    if (!data)
+    ResourceData data;
+    if (!ReadResource(filename, &data))
     {
         return false;
     }
+    bool succeeded = ProcessResource(resource, filename, data);
+    return succeeded;
+}
 
+// ----------------------------------------------------------------------------------------------
+bool XmlModelFactory::ReadResource(const WCHAR* filename, ResourceData* data)
+{
+    return data->Map(filename, MappedFile::CopyOnWrite, true);
+}
+
+// ----------------------------------------------------------------------------------------------
+// the xml is parsed in place, in the copy-on-write view of the file.
+bool XmlModelFactory::ProcessResource(Resource* resource, const WCHAR* filename, const ResourceData& data)
+{
     Model * model = (Model*)resource;
     model->SetSourceFileName(filename);
 
@@ -43,7 +55,7 @@ namespace LvEdEngine
 
     try
     {
-        doc.parse<0>((char*)data);
+        doc.parse<0>((char*)data.bytes);
 
         m_parseErrors = 0;
 
@@ -87,8 +99,6 @@ namespace LvEdEngine
         model->Destroy();
     }
 
-    SAFE_DELETE_ARRAY(data);
-
     return succeeded;
 }
 
@@ -16,6 +16,8 @@ class XmlModelFactory : public ResourceFactory
     public:
         XmlModelFactory(ID3D11Device* device);
         virtual bool LoadResource(Resource* resource, const WCHAR * filename);
+        virtual bool ReadResource(const WCHAR* filename, ResourceData* data);
+        virtual bool ProcessResource(Resource* resource, const WCHAR* filename, const ResourceData& data);
         virtual void ProcessXml(xml_node * root, Model3dBuilder * builder) = 0;
     protected:
         ID3D11Device* m_device;
@@ -0,0 +1,19 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    Compiler.h
+
+    The MSVC keywords the engine uses, for GCC and Clang. The CMake build
+    includes it in every file since headers like Core/typedefs.h use the
+    keywords without including anything.
+****************************************************************************/
+#pragma once
+
+#define __stdcall
+#define __cdecl
+#define __declspec(x)
+#define __forceinline inline __attribute__((always_inline))
+#define __int8  char
+#define __int16 short
+#define __int32 int
+#define __int64 long long
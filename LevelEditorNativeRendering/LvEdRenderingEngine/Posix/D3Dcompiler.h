@@ -0,0 +1,17 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    D3Dcompiler.h
+
+    The POSIX build has no HLSL compiler. Shaders come from the ShaderCache,
+    with whatever ShaderCompiler the host installs; D3DCreateBlob is all the
+    engine needs from here.
+****************************************************************************/
+#pragma once
+
+#include <windows.h>
+#include "d3dcommon.h"
+
+#define D3D_COMPILER_VERSION 0
+
+HRESULT D3DCreateBlob(SIZE_T size, ID3DBlob** ppBlob);
@@ -0,0 +1,16 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    ResUtilPosix.cpp
+
+    The POSIX build has no Win32 resources, so nothing loads from them.
+****************************************************************************/
+#include "../Core/ResUtil.h"
+
+using namespace LvEdEngine;
+
+void* ResUtil::LoadResource(const wchar_t* /*type*/, const wchar_t* /*name*/, uint32_t* size)
+{
+    if(size) *size = 0;
+    return NULL;
+}
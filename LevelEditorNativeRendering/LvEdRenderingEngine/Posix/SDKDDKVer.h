@@ -0,0 +1,4 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+// no Windows platform to select.
+#pragma once
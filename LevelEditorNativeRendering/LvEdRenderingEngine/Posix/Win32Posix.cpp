@@ -0,0 +1,1316 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+#include <windows.h>
+#include <D3Dcompiler.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <fnmatch.h>
+#include <sys/stat.h>
+#include <wctype.h>
+#include <string>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// errors. errno is mapped to the Win32 codes the engine checks for.
+static __thread DWORD s_lastError = ERROR_SUCCESS;
+
+DWORD GetLastError()
+{
+    return s_lastError;
+}
+
+void SetLastError(DWORD error)
+{
+    s_lastError = error;
+}
+
+static void SetLastErrorFromErrno()
+{
+    switch(errno)
+    {
+    case ENOENT:  s_lastError = ERROR_FILE_NOT_FOUND; break;
+    case ENOTDIR: s_lastError = ERROR_PATH_NOT_FOUND; break;
+    case EACCES:
+    case EPERM:   s_lastError = ERROR_ACCESS_DENIED; break;
+    case EEXIST:  s_lastError = ERROR_ALREADY_EXISTS; break;
+    default:      s_lastError = 0x20000000 | (DWORD)errno; break;
+    }
+}
+
+// ---------------------------------------------------------------------------
+uint32_t Win32Posix::NextUuid()
+{
+    static volatile LONG s_next = 0;
+    return (uint32_t)InterlockedIncrement(&s_next);
+}
+
+// ---------------------------------------------------------------------------
+// critical sections and condition variables
+void InitializeCriticalSection(CRITICAL_SECTION* cs)
+{
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&cs->mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
+
+BOOL InitializeCriticalSectionAndSpinCount(CRITICAL_SECTION* cs, DWORD)
+{
+    InitializeCriticalSection(cs);
+    return TRUE;
+}
+
+void DeleteCriticalSection(CRITICAL_SECTION* cs)
+{
+    pthread_mutex_destroy(&cs->mutex);
+}
+
+static void AbsTimeout(DWORD milliseconds, timespec* ts)
+{
+    clock_gettime(CLOCK_REALTIME, ts);
+    ts->tv_sec += milliseconds / 1000;
+    ts->tv_nsec += (long)(milliseconds % 1000) * 1000000L;
+    if(ts->tv_nsec >= 1000000000L)
+    {
+        ts->tv_sec += 1;
+        ts->tv_nsec -= 1000000000L;
+    }
+}
+
+BOOL SleepConditionVariableCS(CONDITION_VARIABLE* cv, CRITICAL_SECTION* cs, DWORD milliseconds)
+{
+    if(milliseconds == INFINITE)
+        return pthread_cond_wait(&cv->cond, &cs->mutex) == 0;
+    timespec ts;
+    AbsTimeout(milliseconds, &ts);
+    if(pthread_cond_timedwait(&cv->cond, &cs->mutex, &ts) != 0)
+    {
+        s_lastError = ERROR_TIMEOUT;
+        return FALSE;
+    }
+    return TRUE;
+}
+
+// ---------------------------------------------------------------------------
+// handles. Waitable objects share one lock and one condition variable;
+// every state change wakes all the waiters, who recheck their objects.
+struct PosixHandle
+{
+    virtual ~PosixHandle() {}
+    // called with s_waitLock held. Returns true and consumes the signal
+    // if the object is signaled.
+    virtual bool TryAcquire() { return false; }
+};
+
+static pthread_mutex_t s_waitLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t s_waitCond = PTHREAD_COND_INITIALIZER;
+
+struct PosixEvent : public PosixHandle
+{
+    bool manualReset;
+    bool signaled;
+    virtual bool TryAcquire()
+    {
+        if(!signaled)
+            return false;
+        if(!manualReset)
+            signaled = false;
+        return true;
+    }
+};
+
+struct PosixSemaphore : public PosixHandle
+{
+    LONG count;
+    LONG maximum;
+    virtual bool TryAcquire()
+    {
+        if(count == 0)
+            return false;
+        --count;
+        return true;
+    }
+};
+
+// shared by the thread and its handle, freed by the last of the two.
+struct PosixThread : public PosixHandle
+{
+    LPTHREAD_START_ROUTINE start;
+    LPVOID param;
+    bool done;
+    LONG refs;
+    virtual bool TryAcquire() { return done; }
+};
+
+struct PosixFile : public PosixHandle
+{
+    int fd;
+    virtual ~PosixFile() { close(fd); }
+};
+
+struct PosixFind : public PosixHandle
+{
+    DIR* dir;
+    std::string dirName;
+    std::string pattern;
+    virtual ~PosixFind() { if(dir) closedir(dir); }
+};
+
+static void ReleaseThread(PosixThread* thread)
+{
+    if(InterlockedDecrement(&thread->refs) == 0)
+        delete thread;
+}
+
+BOOL CloseHandle(HANDLE handle)
+{
+    if(handle == NULL || handle == INVALID_HANDLE_VALUE)
+    {
+        s_lastError = ERROR_INVALID_HANDLE;
+        return FALSE;
+    }
+    PosixHandle* h = (PosixHandle*)handle;
+    PosixThread* thread = dynamic_cast<PosixThread*>(h);
+    if(thread)
+        ReleaseThread(thread);
+    else
+        delete h;
+    return TRUE;
+}
+
+static void* ThreadMain(void* arg)
+{
+    PosixThread* thread = (PosixThread*)arg;
+    thread->start(thread->param);
+    pthread_mutex_lock(&s_waitLock);
+    thread->done = true;
+    pthread_cond_broadcast(&s_waitCond);
+    pthread_mutex_unlock(&s_waitLock);
+    ReleaseThread(thread);
+    return NULL;
+}
+
+HANDLE CreateThread(LPSECURITY_ATTRIBUTES, SIZE_T stackSize, LPTHREAD_START_ROUTINE start,
+    LPVOID param, DWORD flags, LPDWORD threadId)
+{
+    if(flags & CREATE_SUSPENDED)
+    {
+        s_lastError = ERROR_NOT_SUPPORTED;
+        return NULL;
+    }
+    PosixThread* thread = new PosixThread();
+    thread->start = start;
+    thread->param = param;
+    thread->done = false;
+    thread->refs = 2;
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    if(stackSize)
+        pthread_attr_setstacksize(&attr, stackSize < (SIZE_T)PTHREAD_STACK_MIN ? (SIZE_T)PTHREAD_STACK_MIN : stackSize);
+    pthread_t id;
+    int result = pthread_create(&id, &attr, ThreadMain, thread);
+    pthread_attr_destroy(&attr);
+    if(result != 0)
+    {
+        delete thread;
+        s_lastError = ERROR_NOT_ENOUGH_MEMORY;
+        return NULL;
+    }
+    if(threadId)
+        *threadId = (DWORD)(uintptr_t)id;
+    return thread;
+}
+
+// thread priorities need privileges on most systems; the hint is dropped.
+BOOL SetThreadPriority(HANDLE, int)
+{
+    return TRUE;
+}
+
+DWORD GetCurrentThreadId()
+{
+    return (DWORD)(uintptr_t)pthread_self();
+}
+
+HANDLE CreateEventW(LPSECURITY_ATTRIBUTES, BOOL manualReset, BOOL initialState, LPCWSTR)
+{
+    PosixEvent* event = new PosixEvent();
+    event->manualReset = manualReset != FALSE;
+    event->signaled = initialState != FALSE;
+    return event;
+}
+
+BOOL SetEvent(HANDLE event)
+{
+    pthread_mutex_lock(&s_waitLock);
+    ((PosixEvent*)event)->signaled = true;
+    pthread_cond_broadcast(&s_waitCond);
+    pthread_mutex_unlock(&s_waitLock);
+    return TRUE;
+}
+
+BOOL ResetEvent(HANDLE event)
+{
+    pthread_mutex_lock(&s_waitLock);
+    ((PosixEvent*)event)->signaled = false;
+    pthread_mutex_unlock(&s_waitLock);
+    return TRUE;
+}
+
+HANDLE CreateSemaphoreW(LPSECURITY_ATTRIBUTES, LONG initialCount, LONG maximumCount, LPCWSTR)
+{
+    PosixSemaphore* semaphore = new PosixSemaphore();
+    semaphore->count = initialCount;
+    semaphore->maximum = maximumCount;
+    return semaphore;
+}
+
+BOOL ReleaseSemaphore(HANDLE handle, LONG releaseCount, LONG* previousCount)
+{
+    PosixSemaphore* semaphore = (PosixSemaphore*)handle;
+    pthread_mutex_lock(&s_waitLock);
+    BOOL result = FALSE;
+    if(releaseCount > 0 && semaphore->count + releaseCount <= semaphore->maximum)
+    {
+        if(previousCount)
+            *previousCount = semaphore->count;
+        semaphore->count += releaseCount;
+        pthread_cond_broadcast(&s_waitCond);
+        result = TRUE;
+    }
+    pthread_mutex_unlock(&s_waitLock);
+    if(!result)
+        s_lastError = ERROR_TOO_MANY_POSTS;
+    return result;
+}
+
+DWORD WaitForMultipleObjects(DWORD count, const HANDLE* handles, BOOL waitAll, DWORD milliseconds)
+{
+    timespec ts;
+    if(milliseconds != INFINITE)
+        AbsTimeout(milliseconds, &ts);
+
+    pthread_mutex_lock(&s_waitLock);
+    DWORD result = WAIT_TIMEOUT;
+    for(;;)
+    {
+        if(waitAll)
+        {
+            // nothing is consumed until all of them are signaled.
+            DWORD i = 0;
+            for(; i < count; ++i)
+            {
+                PosixHandle* h = (PosixHandle*)handles[i];
+                PosixEvent* event = dynamic_cast<PosixEvent*>(h);
+                PosixSemaphore* semaphore = dynamic_cast<PosixSemaphore*>(h);
+                PosixThread* thread = dynamic_cast<PosixThread*>(h);
+                if((event && !event->signaled) || (semaphore && semaphore->count == 0) || (thread && !thread->done))
+                    break;
+            }
+            if(i == count)
+            {
+                for(i = 0; i < count; ++i)
+                    ((PosixHandle*)handles[i])->TryAcquire();
+                result = WAIT_OBJECT_0;
+                break;
+            }
+        }
+        else
+        {
+            DWORD i = 0;
+            for(; i < count; ++i)
+            {
+                if(((PosixHandle*)handles[i])->TryAcquire())
+                    break;
+            }
+            if(i < count)
+            {
+                result = WAIT_OBJECT_0 + i;
+                break;
+            }
+        }
+
+        if(milliseconds == 0)
+            break;
+        if(milliseconds == INFINITE)
+            pthread_cond_wait(&s_waitCond, &s_waitLock);
+        else if(pthread_cond_timedwait(&s_waitCond, &s_waitLock, &ts) == ETIMEDOUT)
+            milliseconds = 0; // one last check.
+    }
+    pthread_mutex_unlock(&s_waitLock);
+    return result;
+}
+
+DWORD WaitForSingleObject(HANDLE handle, DWORD milliseconds)
+{
+    return WaitForMultipleObjects(1, &handle, FALSE, milliseconds);
+}
+
+void Sleep(DWORD milliseconds)
+{
+    timespec ts;
+    ts.tv_sec = milliseconds / 1000;
+    ts.tv_nsec = (long)(milliseconds % 1000) * 1000000L;
+    while(nanosleep(&ts, &ts) != 0 && errno == EINTR)
+    {
+    }
+}
+
+BOOL SwitchToThread()
+{
+    sched_yield();
+    return TRUE;
+}
+
+// ---------------------------------------------------------------------------
+// time and system
+static uint64_t MonotonicNs()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+DWORD GetTickCount()
+{
+    return (DWORD)(MonotonicNs() / 1000000ULL);
+}
+
+ULONGLONG GetTickCount64()
+{
+    return MonotonicNs() / 1000000ULL;
+}
+
+BOOL QueryPerformanceCounter(LARGE_INTEGER* count)
+{
+    count->QuadPart = (LONGLONG)MonotonicNs();
+    return TRUE;
+}
+
+BOOL QueryPerformanceFrequency(LARGE_INTEGER* frequency)
+{
+    frequency->QuadPart = 1000000000LL;
+    return TRUE;
+}
+
+void GetSystemInfo(SYSTEM_INFO* info)
+{
+    long pageSize = sysconf(_SC_PAGESIZE);
+    long processors = sysconf(_SC_NPROCESSORS_ONLN);
+    info->dwPageSize = pageSize > 0 ? (DWORD)pageSize : 4096;
+    info->dwNumberOfProcessors = processors > 0 ? (DWORD)processors : 1;
+    info->dwAllocationGranularity = info->dwPageSize < 65536 ? 65536 : info->dwPageSize;
+}
+
+// there is no debugger channel; the Logger prints to the console as well.
+void OutputDebugStringA(LPCSTR)
+{
+}
+
+void OutputDebugStringW(LPCWSTR)
+{
+}
+
+// ---------------------------------------------------------------------------
+// strings
+static bool DecodeUtf8(const char* str, size_t size, std::wstring* out)
+{
+    out->clear();
+    for(size_t i = 0; i < size;)
+    {
+        unsigned char c = (unsigned char)str[i];
+        uint32_t code;
+        int extra;
+        if(c < 0x80)                { code = c; extra = 0; }
+        else if((c & 0xE0) == 0xC0) { code = c & 0x1F; extra = 1; }
+        else if((c & 0xF0) == 0xE0) { code = c & 0x0F; extra = 2; }
+        else if((c & 0xF8) == 0xF0) { code = c & 0x07; extra = 3; }
+        else                        { code = 0xFFFD; extra = 0; }
+        ++i;
+        for(int k = 0; k < extra; ++k, ++i)
+        {
+            if(i >= size || ((unsigned char)str[i] & 0xC0) != 0x80)
+            {
+                code = 0xFFFD;
+                break;
+            }
+            code = (code << 6) | ((unsigned char)str[i] & 0x3F);
+        }
+        out->push_back((wchar_t)code);
+    }
+    return true;
+}
+
+static void EncodeUtf8(const wchar_t* wstr, size_t size, std::string* out)
+{
+    out->clear();
+    for(size_t i = 0; i < size; ++i)
+    {
+        uint32_t code = (uint32_t)wstr[i];
+        if(code < 0x80)
+        {
+            out->push_back((char)code);
+        }
+        else if(code < 0x800)
+        {
+            out->push_back((char)(0xC0 | (code >> 6)));
+            out->push_back((char)(0x80 | (code & 0x3F)));
+        }
+        else if(code < 0x10000)
+        {
+            out->push_back((char)(0xE0 | (code >> 12)));
+            out->push_back((char)(0x80 | ((code >> 6) & 0x3F)));
+            out->push_back((char)(0x80 | (code & 0x3F)));
+        }
+        else
+        {
+            out->push_back((char)(0xF0 | (code >> 18)));
+            out->push_back((char)(0x80 | ((code >> 12) & 0x3F)));
+            out->push_back((char)(0x80 | ((code >> 6) & 0x3F)));
+            out->push_back((char)(0x80 | (code & 0x3F)));
+        }
+    }
+}
+
+static void DecodeLocale(const char* str, size_t size, std::wstring* out)
+{
+    out->clear();
+    mbstate_t state;
+    memset(&state, 0, sizeof(state));
+    for(size_t i = 0; i < size;)
+    {
+        wchar_t wc;
+        size_t n = mbrtowc(&wc, str + i, size - i, &state);
+        if(n == (size_t)-1 || n == (size_t)-2)
+        {
+            // not valid in the locale, taken as Latin-1 like the C locale would.
+            wc = (unsigned char)str[i];
+            n = 1;
+            memset(&state, 0, sizeof(state));
+        }
+        else if(n == 0)
+        {
+            n = 1;
+        }
+        out->push_back(wc);
+        i += n;
+    }
+}
+
+static void EncodeLocale(const wchar_t* wstr, size_t size, std::string* out)
+{
+    out->clear();
+    mbstate_t state;
+    memset(&state, 0, sizeof(state));
+    char buffer[16];
+    for(size_t i = 0; i < size; ++i)
+    {
+        size_t n = wcrtomb(buffer, wstr[i], &state);
+        if(n == (size_t)-1)
+        {
+            buffer[0] = '?';
+            n = 1;
+            memset(&state, 0, sizeof(state));
+        }
+        out->append(buffer, n);
+    }
+}
+
+int MultiByteToWideChar(UINT codePage, DWORD, LPCSTR str, int size, LPWSTR wstr, int wsize)
+{
+    size_t length = size < 0 ? strlen(str) + 1 : (size_t)size;
+    std::wstring result;
+    if(codePage == CP_UTF8)
+        DecodeUtf8(str, length, &result);
+    else
+        DecodeLocale(str, length, &result);
+    if(wsize == 0)
+        return (int)result.size();
+    if(result.size() > (size_t)wsize)
+    {
+        s_lastError = ERROR_INSUFFICIENT_BUFFER;
+        return 0;
+    }
+    memcpy(wstr, result.data(), result.size() * sizeof(wchar_t));
+    return (int)result.size();
+}
+
+int WideCharToMultiByte(UINT codePage, DWORD, LPCWSTR wstr, int wsize, LPSTR str, int size,
+    LPCSTR, LPBOOL usedDefaultChar)
+{
+    size_t length = wsize < 0 ? wcslen(wstr) + 1 : (size_t)wsize;
+    std::string result;
+    if(codePage == CP_UTF8)
+        EncodeUtf8(wstr, length, &result);
+    else
+        EncodeLocale(wstr, length, &result);
+    if(usedDefaultChar)
+        *usedDefaultChar = FALSE;
+    if(size == 0)
+        return (int)result.size();
+    if(result.size() > (size_t)size)
+    {
+        s_lastError = ERROR_INSUFFICIENT_BUFFER;
+        return 0;
+    }
+    memcpy(str, result.data(), result.size());
+    return (int)result.size();
+}
+
+int _wcsicmp(const wchar_t* a, const wchar_t* b)
+{
+    return wcscasecmp(a, b);
+}
+
+int _wcsnicmp(const wchar_t* a, const wchar_t* b, size_t n)
+{
+    return wcsncasecmp(a, b, n);
+}
+
+wchar_t* _wcslwr_s(wchar_t* str, size_t size)
+{
+    for(size_t i = 0; i < size && str[i]; ++i)
+        str[i] = towlower(str[i]);
+    return str;
+}
+
+int _wtoi(const wchar_t* str)
+{
+    return (int)wcstol(str, NULL, 10);
+}
+
+double _wtof(const wchar_t* str)
+{
+    return wcstod(str, NULL);
+}
+
+// the *_s copies: on overflow the destination is emptied and ERANGE
+// returned, unless the count is _TRUNCATE.
+template<typename CharT>
+static int CopyString(CharT* dst, size_t size, const CharT* src, size_t count)
+{
+    if(!dst || size == 0)
+        return EINVAL;
+    if(!src)
+    {
+        dst[0] = 0;
+        return EINVAL;
+    }
+    size_t length = 0;
+    while(length < count && src[length])
+        ++length;
+    if(length >= size)
+    {
+        if(count == _TRUNCATE)
+        {
+            memcpy(dst, src, (size - 1) * sizeof(CharT));
+            dst[size - 1] = 0;
+            return STRUNCATE;
+        }
+        dst[0] = 0;
+        return ERANGE;
+    }
+    memcpy(dst, src, length * sizeof(CharT));
+    dst[length] = 0;
+    return 0;
+}
+
+template<typename CharT>
+static size_t Length(const CharT* str, size_t size)
+{
+    size_t length = 0;
+    while(length < size && str[length])
+        ++length;
+    return length;
+}
+
+int strcpy_s(char* dst, size_t size, const char* src)
+{
+    return CopyString(dst, size, src, (size_t)-2);
+}
+
+int strncpy_s(char* dst, size_t size, const char* src, size_t count)
+{
+    return CopyString(dst, size, src, count);
+}
+
+int strcat_s(char* dst, size_t size, const char* src)
+{
+    size_t length = Length(dst, size);
+    if(length == size)
+        return EINVAL;
+    return CopyString(dst + length, size - length, src, (size_t)-2);
+}
+
+int wcscpy_s(wchar_t* dst, size_t size, const wchar_t* src)
+{
+    return CopyString(dst, size, src, (size_t)-2);
+}
+
+int wcsncpy_s(wchar_t* dst, size_t size, const wchar_t* src, size_t count)
+{
+    return CopyString(dst, size, src, count);
+}
+
+int wcscat_s(wchar_t* dst, size_t size, const wchar_t* src)
+{
+    size_t length = Length(dst, size);
+    if(length == size)
+        return EINVAL;
+    return CopyString(dst + length, size - length, src, (size_t)-2);
+}
+
+// ---------------------------------------------------------------------------
+// printf. The formats are MSVC's: in the wide functions %s and %c take wide
+// arguments and %S, %hs narrow ones; I64 is a 64 bit length.
+static std::wstring TranslateFormat(const wchar_t* format)
+{
+    std::wstring out;
+    while(*format)
+    {
+        if(*format != L'%')
+        {
+            out.push_back(*format++);
+            continue;
+        }
+        out.push_back(*format++);
+        if(*format == L'%')
+        {
+            out.push_back(*format++);
+            continue;
+        }
+        while(*format && wcschr(L"-+ #0", *format))
+            out.push_back(*format++);
+        while(*format && (iswdigit(*format) || *format == L'*' || *format == L'.'))
+            out.push_back(*format++);
+
+        bool narrow = false, wide = false;
+        if(format[0] == L'I' && format[1] == L'6' && format[2] == L'4')
+        {
+            out += L"ll";
+            format += 3;
+        }
+        else if(format[0] == L'I' && format[1] == L'3' && format[2] == L'2')
+        {
+            format += 3;
+        }
+        else if(format[0] == L'I')
+        {
+            out += L"z";
+            format += 1;
+        }
+        else if(format[0] == L'h' && (format[1] == L's' || format[1] == L'c' || format[1] == L'S' || format[1] == L'C'))
+        {
+            narrow = true;
+            format += 1;
+        }
+        else if(format[0] == L'l' && (format[1] == L's' || format[1] == L'c'))
+        {
+            wide = true;
+            format += 1;
+        }
+        else if(format[0] == L'w' && (format[1] == L's' || format[1] == L'c'))
+        {
+            wide = true;
+            format += 1;
+        }
+        else
+        {
+            while(*format && wcschr(L"hlLqjzt", *format))
+                out.push_back(*format++);
+        }
+
+        wchar_t conversion = *format;
+        if(!conversion)
+            break;
+        ++format;
+        if(conversion == L'S' || conversion == L'C')
+        {
+            if(!wide)
+                narrow = true;
+            conversion = conversion == L'S' ? L's' : L'c';
+        }
+        if(conversion == L's' || conversion == L'c')
+        {
+            if(!narrow)
+                out.push_back(L'l');
+        }
+        out.push_back(conversion);
+    }
+    return out;
+}
+
+static std::string TranslateFormat(const char* format)
+{
+    std::string out;
+    while(*format)
+    {
+        if(format[0] == '%' && format[1] == '%')
+        {
+            out += "%%";
+            format += 2;
+            continue;
+        }
+        if(*format != '%')
+        {
+            out.push_back(*format++);
+            continue;
+        }
+        out.push_back(*format++);
+        while(*format && strchr("-+ #0123456789*.", *format))
+            out.push_back(*format++);
+        if(format[0] == 'I' && format[1] == '6' && format[2] == '4')
+        {
+            out += "ll";
+            format += 3;
+        }
+        else if(format[0] == 'I' && format[1] == '3' && format[2] == '2')
+        {
+            format += 3;
+        }
+        else if(format[0] == 'I')
+        {
+            out += "z";
+            format += 1;
+        }
+    }
+    return out;
+}
+
+static int FormatNarrow(std::string* out, const char* format, va_list args)
+{
+    std::string fmt = TranslateFormat(format);
+    va_list copy;
+    va_copy(copy, args);
+    int length = vsnprintf(NULL, 0, fmt.c_str(), copy);
+    va_end(copy);
+    if(length < 0)
+        return length;
+    out->resize((size_t)length + 1);
+    vsnprintf(&(*out)[0], out->size(), fmt.c_str(), args);
+    out->resize((size_t)length);
+    return length;
+}
+
+static int FormatWide(std::wstring* out, const wchar_t* format, va_list args)
+{
+    // vswprintf doesn't report the needed size, the buffer grows until it fits.
+    std::wstring fmt = TranslateFormat(format);
+    size_t size = 256;
+    for(;;)
+    {
+        out->resize(size);
+        va_list copy;
+        va_copy(copy, args);
+        int length = vswprintf(&(*out)[0], size, fmt.c_str(), copy);
+        va_end(copy);
+        if(length >= 0 && (size_t)length < size)
+        {
+            out->resize((size_t)length);
+            return length;
+        }
+        if(size >= (1u << 24))
+            return -1;
+        size *= 2;
+    }
+}
+
+template<typename CharT, typename StringT>
+static int Output(CharT* buffer, size_t size, size_t count, const StringT& text, int length)
+{
+    if(!buffer || size == 0)
+        return -1;
+    if(length < 0)
+    {
+        buffer[0] = 0;
+        return -1;
+    }
+    size_t limit = count == _TRUNCATE ? size - 1 : (count < size - 1 ? count : size - 1);
+    if((size_t)length <= limit)
+    {
+        memcpy(buffer, text.data(), length * sizeof(CharT));
+        buffer[length] = 0;
+        return length;
+    }
+    if(count == _TRUNCATE || count < size)
+    {
+        memcpy(buffer, text.data(), limit * sizeof(CharT));
+        buffer[limit] = 0;
+        return -1;
+    }
+    buffer[0] = 0;
+    return -1;
+}
+
+int _vsnprintf_s(char* buffer, size_t size, size_t count, const char* format, va_list args)
+{
+    std::string text;
+    int length = FormatNarrow(&text, format, args);
+    return Output(buffer, size, count, text, length);
+}
+
+int vsprintf_s(char* buffer, size_t size, const char* format, va_list args)
+{
+    return _vsnprintf_s(buffer, size, _TRUNCATE, format, args);
+}
+
+int sprintf_s(char* buffer, size_t size, const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int result = vsprintf_s(buffer, size, format, args);
+    va_end(args);
+    return result;
+}
+
+int _snprintf_s(char* buffer, size_t size, size_t count, const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int result = _vsnprintf_s(buffer, size, count, format, args);
+    va_end(args);
+    return result;
+}
+
+int _vscprintf(const char* format, va_list args)
+{
+    std::string text;
+    return FormatNarrow(&text, format, args);
+}
+
+int _vsnwprintf_s(wchar_t* buffer, size_t size, size_t count, const wchar_t* format, va_list args)
+{
+    std::wstring text;
+    int length = FormatWide(&text, format, args);
+    return Output(buffer, size, count, text, length);
+}
+
+int vswprintf_s(wchar_t* buffer, size_t size, const wchar_t* format, va_list args)
+{
+    return _vsnwprintf_s(buffer, size, _TRUNCATE, format, args);
+}
+
+int swprintf_s(wchar_t* buffer, size_t size, const wchar_t* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int result = vswprintf_s(buffer, size, format, args);
+    va_end(args);
+    return result;
+}
+
+int _snwprintf_s(wchar_t* buffer, size_t size, size_t count, const wchar_t* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int result = _vsnwprintf_s(buffer, size, count, format, args);
+    va_end(args);
+    return result;
+}
+
+int _vscwprintf(const wchar_t* format, va_list args)
+{
+    std::wstring text;
+    return FormatWide(&text, format, args);
+}
+
+// printed narrow so stdout keeps its byte orientation for printf.
+int Win32Posix_wprintf(const wchar_t* format, ...)
+{
+    std::wstring text;
+    va_list args;
+    va_start(args, format);
+    int length = FormatWide(&text, format, args);
+    va_end(args);
+    if(length < 0)
+        return length;
+    std::string out;
+    EncodeLocale(text.data(), text.size(), &out);
+    fputs(out.c_str(), stdout);
+    return length;
+}
+
+// ---------------------------------------------------------------------------
+DWORD GetEnvironmentVariableW(LPCWSTR name, LPWSTR buffer, DWORD size)
+{
+    std::string narrowName;
+    EncodeLocale(name, wcslen(name), &narrowName);
+    const char* value = getenv(narrowName.c_str());
+    if(!value)
+    {
+        s_lastError = ERROR_ENVVAR_NOT_FOUND;
+        return 0;
+    }
+    std::wstring wide;
+    DecodeLocale(value, strlen(value), &wide);
+    if(wide.size() + 1 > size)
+        return (DWORD)wide.size() + 1;
+    wcscpy(buffer, wide.c_str());
+    return (DWORD)wide.size();
+}
+
+DWORD FormatMessageW(DWORD flags, LPCVOID, DWORD messageId, DWORD, LPWSTR buffer, DWORD, va_list*)
+{
+    if(!(flags & FORMAT_MESSAGE_ALLOCATE_BUFFER))
+        return 0;
+    wchar_t text[128];
+    if(messageId & 0x20000000)
+        swprintf(text, 128, L"%s\r\n", strerror((int)(messageId & ~0x20000000)));
+    else
+        swprintf(text, 128, L"error %u\r\n", (unsigned)messageId);
+    size_t length = wcslen(text);
+    wchar_t* result = (wchar_t*)malloc((length + 1) * sizeof(wchar_t));
+    wcscpy(result, text);
+    *(wchar_t**)buffer = result;
+    return (DWORD)length;
+}
+
+HANDLE LocalFree(HANDLE mem)
+{
+    free(mem);
+    return NULL;
+}
+
+// ---------------------------------------------------------------------------
+// files
+std::string Win32Posix::NativePath(const wchar_t* name)
+{
+    std::wstring path = name;
+    for(auto it = path.begin(); it != path.end(); ++it)
+    {
+        if(*it == L'\\')
+            *it = L'/';
+    }
+    std::string result;
+    EncodeLocale(path.data(), path.size(), &result);
+    return result;
+}
+
+HANDLE CreateFileW(LPCWSTR name, DWORD access, DWORD, LPSECURITY_ATTRIBUTES, DWORD creation, DWORD, HANDLE)
+{
+    int flags = 0;
+    if((access & GENERIC_READ) && (access & GENERIC_WRITE))
+        flags = O_RDWR;
+    else if(access & GENERIC_WRITE)
+        flags = O_WRONLY;
+    else
+        flags = O_RDONLY;
+    switch(creation)
+    {
+    case CREATE_NEW:        flags |= O_CREAT | O_EXCL; break;
+    case CREATE_ALWAYS:     flags |= O_CREAT | O_TRUNC; break;
+    case OPEN_ALWAYS:       flags |= O_CREAT; break;
+    case TRUNCATE_EXISTING: flags |= O_TRUNC; break;
+    default: break;
+    }
+    int fd = open(Win32Posix::NativePath(name).c_str(), flags | O_CLOEXEC, 0666);
+    if(fd < 0)
+    {
+        SetLastErrorFromErrno();
+        return INVALID_HANDLE_VALUE;
+    }
+    PosixFile* file = new PosixFile();
+    file->fd = fd;
+    return file;
+}
+
+BOOL ReadFile(HANDLE handle, LPVOID buffer, DWORD size, LPDWORD read, void*)
+{
+    int fd = ((PosixFile*)handle)->fd;
+    DWORD total = 0;
+    while(total < size)
+    {
+        ssize_t n = ::read(fd, (char*)buffer + total, size - total);
+        if(n < 0)
+        {
+            if(errno == EINTR)
+                continue;
+            SetLastErrorFromErrno();
+            if(read)
+                *read = total;
+            return FALSE;
+        }
+        if(n == 0)
+            break;
+        total += (DWORD)n;
+    }
+    if(read)
+        *read = total;
+    return TRUE;
+}
+
+BOOL WriteFile(HANDLE handle, LPCVOID buffer, DWORD size, LPDWORD written, void*)
+{
+    int fd = ((PosixFile*)handle)->fd;
+    DWORD total = 0;
+    while(total < size)
+    {
+        ssize_t n = ::write(fd, (const char*)buffer + total, size - total);
+        if(n < 0)
+        {
+            if(errno == EINTR)
+                continue;
+            SetLastErrorFromErrno();
+            if(written)
+                *written = total;
+            return FALSE;
+        }
+        total += (DWORD)n;
+    }
+    if(written)
+        *written = total;
+    return TRUE;
+}
+
+BOOL GetFileSizeEx(HANDLE handle, LARGE_INTEGER* size)
+{
+    struct stat st;
+    if(fstat(((PosixFile*)handle)->fd, &st) != 0)
+    {
+        SetLastErrorFromErrno();
+        return FALSE;
+    }
+    size->QuadPart = (LONGLONG)st.st_size;
+    return TRUE;
+}
+
+BOOL SetFilePointerEx(HANDLE handle, LARGE_INTEGER distance, LARGE_INTEGER* newPosition, DWORD method)
+{
+    int whence = method == FILE_END ? SEEK_END : (method == FILE_CURRENT ? SEEK_CUR : SEEK_SET);
+    off_t pos = lseek(((PosixFile*)handle)->fd, (off_t)distance.QuadPart, whence);
+    if(pos < 0)
+    {
+        SetLastErrorFromErrno();
+        return FALSE;
+    }
+    if(newPosition)
+        newPosition->QuadPart = (LONGLONG)pos;
+    return TRUE;
+}
+
+BOOL FlushFileBuffers(HANDLE handle)
+{
+    return fsync(((PosixFile*)handle)->fd) == 0;
+}
+
+BOOL DeleteFileW(LPCWSTR name)
+{
+    if(unlink(Win32Posix::NativePath(name).c_str()) != 0)
+    {
+        SetLastErrorFromErrno();
+        return FALSE;
+    }
+    return TRUE;
+}
+
+BOOL MoveFileExW(LPCWSTR existing, LPCWSTR newName, DWORD flags)
+{
+    std::string to = Win32Posix::NativePath(newName);
+    struct stat st;
+    if(!(flags & MOVEFILE_REPLACE_EXISTING) && stat(to.c_str(), &st) == 0)
+    {
+        s_lastError = ERROR_ALREADY_EXISTS;
+        return FALSE;
+    }
+    if(rename(Win32Posix::NativePath(existing).c_str(), to.c_str()) != 0)
+    {
+        SetLastErrorFromErrno();
+        return FALSE;
+    }
+    return TRUE;
+}
+
+BOOL CreateDirectoryW(LPCWSTR name, LPSECURITY_ATTRIBUTES)
+{
+    if(mkdir(Win32Posix::NativePath(name).c_str(), 0777) != 0)
+    {
+        SetLastErrorFromErrno();
+        return FALSE;
+    }
+    return TRUE;
+}
+
+DWORD GetFileAttributesW(LPCWSTR name)
+{
+    struct stat st;
+    if(stat(Win32Posix::NativePath(name).c_str(), &st) != 0)
+    {
+        SetLastErrorFromErrno();
+        return INVALID_FILE_ATTRIBUTES;
+    }
+    return S_ISDIR(st.st_mode) ? FILE_ATTRIBUTE_DIRECTORY : FILE_ATTRIBUTE_NORMAL;
+}
+
+DWORD GetFullPathNameW(LPCWSTR name, DWORD size, LPWSTR buffer, LPWSTR* filePart)
+{
+    std::wstring path = name;
+    for(auto it = path.begin(); it != path.end(); ++it)
+    {
+        if(*it == L'\\')
+            *it = L'/';
+    }
+    if(path.empty() || path[0] != L'/')
+    {
+        char cwd[4096];
+        if(!getcwd(cwd, sizeof(cwd)))
+        {
+            SetLastErrorFromErrno();
+            return 0;
+        }
+        std::wstring wideCwd;
+        DecodeLocale(cwd, strlen(cwd), &wideCwd);
+        path = wideCwd + L"/" + path;
+    }
+
+    // removes ".", ".." and repeated separators; a trailing separator stays.
+    std::vector<std::wstring> parts;
+    size_t start = 1;
+    bool trailing = path.size() > 1 && path[path.size() - 1] == L'/';
+    while(start <= path.size())
+    {
+        size_t end = path.find(L'/', start);
+        if(end == std::wstring::npos)
+            end = path.size();
+        std::wstring part = path.substr(start, end - start);
+        if(part == L"..")
+        {
+            if(!parts.empty())
+                parts.pop_back();
+        }
+        else if(!part.empty() && part != L".")
+        {
+            parts.push_back(part);
+        }
+        start = end + 1;
+    }
+    std::wstring result;
+    for(auto it = parts.begin(); it != parts.end(); ++it)
+        result += L"/" + *it;
+    if(result.empty() || trailing)
+        result += L"/";
+
+    if(result.size() + 1 > size)
+        return (DWORD)result.size() + 1;
+    wcscpy(buffer, result.c_str());
+    if(filePart)
+    {
+        wchar_t* slash = wcsrchr(buffer, L'/');
+        *filePart = (slash && slash[1]) ? slash + 1 : NULL;
+    }
+    return (DWORD)result.size();
+}
+
+static bool NextMatch(PosixFind* find, WIN32_FIND_DATAW* data)
+{
+    while(dirent* entry = readdir(find->dir))
+    {
+        if(fnmatch(find->pattern.c_str(), entry->d_name, FNM_CASEFOLD) != 0)
+            continue;
+        std::string path = find->dirName + entry->d_name;
+        struct stat st;
+        if(stat(path.c_str(), &st) != 0)
+            continue;
+        memset(data, 0, sizeof(*data));
+        data->dwFileAttributes = S_ISDIR(st.st_mode) ? FILE_ATTRIBUTE_DIRECTORY : FILE_ATTRIBUTE_NORMAL;
+        uint64_t size = (uint64_t)st.st_size;
+        data->nFileSizeHigh = (DWORD)(size >> 32);
+        data->nFileSizeLow = (DWORD)size;
+        // 100ns intervals since 1601.
+        uint64_t time = ((uint64_t)st.st_mtime + 11644473600ULL) * 10000000ULL;
+        data->ftLastWriteTime.dwLowDateTime = (DWORD)time;
+        data->ftLastWriteTime.dwHighDateTime = (DWORD)(time >> 32);
+        std::wstring wide;
+        DecodeLocale(entry->d_name, strlen(entry->d_name), &wide);
+        wcsncpy(data->cFileName, wide.c_str(), MAX_PATH - 1);
+        return true;
+    }
+    return false;
+}
+
+HANDLE FindFirstFileW(LPCWSTR pattern, WIN32_FIND_DATAW* data)
+{
+    std::string path = Win32Posix::NativePath(pattern);
+    size_t slash = path.rfind('/');
+    PosixFind* find = new PosixFind();
+    find->dirName = slash == std::string::npos ? std::string("./") : path.substr(0, slash + 1);
+    find->pattern = slash == std::string::npos ? path : path.substr(slash + 1);
+    find->dir = opendir(find->dirName.c_str());
+    if(!find->dir)
+    {
+        SetLastErrorFromErrno();
+        delete find;
+        return INVALID_HANDLE_VALUE;
+    }
+    if(!NextMatch(find, data))
+    {
+        delete find;
+        s_lastError = ERROR_FILE_NOT_FOUND;
+        return INVALID_HANDLE_VALUE;
+    }
+    return find;
+}
+
+BOOL FindNextFileW(HANDLE handle, WIN32_FIND_DATAW* data)
+{
+    if(!NextMatch((PosixFind*)handle, data))
+    {
+        s_lastError = ERROR_NO_MORE_FILES;
+        return FALSE;
+    }
+    return TRUE;
+}
+
+BOOL FindClose(HANDLE handle)
+{
+    delete (PosixFind*)handle;
+    return TRUE;
+}
+
+// ---------------------------------------------------------------------------
+// a heap blob for the shader cache.
+namespace
+{
+    class Blob : public ID3DBlob
+    {
+    public:
+        explicit Blob(SIZE_T size) : m_refs(1), m_data(size) {}
+        HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppvObject)
+        {
+            if(riid == __uuidof(ID3DBlob) || riid == __uuidof(IUnknown))
+            {
+                AddRef();
+                *ppvObject = this;
+                return S_OK;
+            }
+            *ppvObject = NULL;
+            return E_NOINTERFACE;
+        }
+        ULONG STDMETHODCALLTYPE AddRef() { return (ULONG)InterlockedIncrement(&m_refs); }
+        ULONG STDMETHODCALLTYPE Release()
+        {
+            LONG refs = InterlockedDecrement(&m_refs);
+            if(refs == 0)
+                delete this;
+            return (ULONG)refs;
+        }
+        LPVOID STDMETHODCALLTYPE GetBufferPointer() { return m_data.empty() ? NULL : &m_data[0]; }
+        SIZE_T STDMETHODCALLTYPE GetBufferSize() { return m_data.size(); }
+    private:
+        volatile LONG m_refs;
+        std::vector<BYTE> m_data;
+    };
+}
+
+HRESULT D3DCreateBlob(SIZE_T size, ID3DBlob** ppBlob)
+{
+    if(!ppBlob)
+        return E_INVALIDARG;
+    *ppBlob = new Blob(size);
+    return S_OK;
+}
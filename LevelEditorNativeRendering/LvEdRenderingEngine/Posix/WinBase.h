@@ -0,0 +1,5 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+// everything is in windows.h.
+#pragma once
+#include <windows.h>
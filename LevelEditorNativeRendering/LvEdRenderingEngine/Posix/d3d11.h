@@ -0,0 +1,941 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    d3d11.h
+
+    The D3D11 types and interfaces for the POSIX build, where the only
+    device is the null device (Renderer/NullDevice.h). Same names, values
+    and methods as the Windows SDK, without the features the engine
+    doesn't use: no D3D11CreateDevice, no swap chains.
+****************************************************************************/
+#pragma once
+
+#include <windows.h>
+#include "d3dcommon.h"
+#include "dxgi.h"
+
+#define D3D11_SDK_VERSION 7
+
+#define D3D11_FLOAT32_MAX 3.402823466e+38f
+#define D3D11_APPEND_ALIGNED_ELEMENT 0xffffffff
+#define D3D11_DEFAULT_STENCIL_READ_MASK 0xff
+#define D3D11_DEFAULT_STENCIL_WRITE_MASK 0xff
+#define D3D11_REQ_MIP_LEVELS 15
+#define D3D11_REQ_TEXTURE1D_U_DIMENSION 16384
+#define D3D11_REQ_TEXTURE1D_ARRAY_AXIS_DIMENSION 2048
+#define D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION 16384
+#define D3D11_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION 2048
+#define D3D11_REQ_TEXTURE3D_U_V_OR_W_DIMENSION 2048
+#define D3D11_REQ_TEXTURECUBE_DIMENSION 16384
+#define D3D10_REQ_TEXTURE1D_U_DIMENSION 8192
+#define D3D10_REQ_TEXTURE1D_ARRAY_AXIS_DIMENSION 512
+#define D3D10_REQ_TEXTURE2D_U_OR_V_DIMENSION 8192
+#define D3D10_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION 512
+#define D3D10_REQ_TEXTURE3D_U_V_OR_W_DIMENSION 2048
+#define D3D10_REQ_TEXTURECUBE_DIMENSION 8192
+#define D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT 14
+#define D3D11_COMMONSHADER_INPUT_RESOURCE_SLOT_COUNT 128
+#define D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT 16
+#define D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT 32
+#define D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT 8
+
+typedef D3D_PRIMITIVE_TOPOLOGY D3D11_PRIMITIVE_TOPOLOGY;
+typedef D3D_SRV_DIMENSION D3D11_SRV_DIMENSION;
+typedef RECT D3D11_RECT;
+
+// ---------------------------------------------------------------------------
+// enums
+typedef enum D3D11_USAGE
+{
+    D3D11_USAGE_DEFAULT     = 0,
+    D3D11_USAGE_IMMUTABLE   = 1,
+    D3D11_USAGE_DYNAMIC     = 2,
+    D3D11_USAGE_STAGING     = 3,
+} D3D11_USAGE;
+
+typedef enum D3D11_BIND_FLAG
+{
+    D3D11_BIND_VERTEX_BUFFER    = 0x1,
+    D3D11_BIND_INDEX_BUFFER     = 0x2,
+    D3D11_BIND_CONSTANT_BUFFER  = 0x4,
+    D3D11_BIND_SHADER_RESOURCE  = 0x8,
+    D3D11_BIND_STREAM_OUTPUT    = 0x10,
+    D3D11_BIND_RENDER_TARGET    = 0x20,
+    D3D11_BIND_DEPTH_STENCIL    = 0x40,
+    D3D11_BIND_UNORDERED_ACCESS = 0x80,
+} D3D11_BIND_FLAG;
+
+typedef enum D3D11_CPU_ACCESS_FLAG
+{
+    D3D11_CPU_ACCESS_WRITE  = 0x10000,
+    D3D11_CPU_ACCESS_READ   = 0x20000,
+} D3D11_CPU_ACCESS_FLAG;
+
+typedef enum D3D11_RESOURCE_MISC_FLAG
+{
+    D3D11_RESOURCE_MISC_GENERATE_MIPS           = 0x1,
+    D3D11_RESOURCE_MISC_SHARED                  = 0x2,
+    D3D11_RESOURCE_MISC_TEXTURECUBE             = 0x4,
+    D3D11_RESOURCE_MISC_DRAWINDIRECT_ARGS       = 0x10,
+    D3D11_RESOURCE_MISC_BUFFER_ALLOW_RAW_VIEWS  = 0x20,
+    D3D11_RESOURCE_MISC_BUFFER_STRUCTURED       = 0x40,
+    D3D11_RESOURCE_MISC_RESOURCE_CLAMP          = 0x80,
+    D3D11_RESOURCE_MISC_SHARED_KEYEDMUTEX       = 0x100,
+    D3D11_RESOURCE_MISC_GDI_COMPATIBLE          = 0x200,
+} D3D11_RESOURCE_MISC_FLAG;
+
+typedef enum D3D11_MAP
+{
+    D3D11_MAP_READ                  = 1,
+    D3D11_MAP_WRITE                 = 2,
+    D3D11_MAP_READ_WRITE            = 3,
+    D3D11_MAP_WRITE_DISCARD         = 4,
+    D3D11_MAP_WRITE_NO_OVERWRITE    = 5,
+} D3D11_MAP;
+
+typedef enum D3D11_MAP_FLAG
+{
+    D3D11_MAP_FLAG_DO_NOT_WAIT = 0x100000,
+} D3D11_MAP_FLAG;
+
+typedef enum D3D11_RESOURCE_DIMENSION
+{
+    D3D11_RESOURCE_DIMENSION_UNKNOWN    = 0,
+    D3D11_RESOURCE_DIMENSION_BUFFER     = 1,
+    D3D11_RESOURCE_DIMENSION_TEXTURE1D  = 2,
+    D3D11_RESOURCE_DIMENSION_TEXTURE2D  = 3,
+    D3D11_RESOURCE_DIMENSION_TEXTURE3D  = 4,
+} D3D11_RESOURCE_DIMENSION;
+
+typedef enum D3D11_RTV_DIMENSION
+{
+    D3D11_RTV_DIMENSION_UNKNOWN             = 0,
+    D3D11_RTV_DIMENSION_BUFFER              = 1,
+    D3D11_RTV_DIMENSION_TEXTURE1D           = 2,
+    D3D11_RTV_DIMENSION_TEXTURE1DARRAY      = 3,
+    D3D11_RTV_DIMENSION_TEXTURE2D           = 4,
+    D3D11_RTV_DIMENSION_TEXTURE2DARRAY      = 5,
+    D3D11_RTV_DIMENSION_TEXTURE2DMS         = 6,
+    D3D11_RTV_DIMENSION_TEXTURE2DMSARRAY    = 7,
+    D3D11_RTV_DIMENSION_TEXTURE3D           = 8,
+} D3D11_RTV_DIMENSION;
+
+typedef enum D3D11_DSV_DIMENSION
+{
+    D3D11_DSV_DIMENSION_UNKNOWN             = 0,
+    D3D11_DSV_DIMENSION_TEXTURE1D           = 1,
+    D3D11_DSV_DIMENSION_TEXTURE1DARRAY      = 2,
+    D3D11_DSV_DIMENSION_TEXTURE2D           = 3,
+    D3D11_DSV_DIMENSION_TEXTURE2DARRAY      = 4,
+    D3D11_DSV_DIMENSION_TEXTURE2DMS         = 5,
+    D3D11_DSV_DIMENSION_TEXTURE2DMSARRAY    = 6,
+} D3D11_DSV_DIMENSION;
+
+typedef enum D3D11_UAV_DIMENSION
+{
+    D3D11_UAV_DIMENSION_UNKNOWN         = 0,
+    D3D11_UAV_DIMENSION_BUFFER          = 1,
+    D3D11_UAV_DIMENSION_TEXTURE1D       = 2,
+    D3D11_UAV_DIMENSION_TEXTURE1DARRAY  = 3,
+    D3D11_UAV_DIMENSION_TEXTURE2D       = 4,
+    D3D11_UAV_DIMENSION_TEXTURE2DARRAY  = 5,
+    D3D11_UAV_DIMENSION_TEXTURE3D       = 8,
+} D3D11_UAV_DIMENSION;
+
+typedef enum D3D11_FILL_MODE
+{
+    D3D11_FILL_WIREFRAME    = 2,
+    D3D11_FILL_SOLID        = 3,
+} D3D11_FILL_MODE;
+
+typedef enum D3D11_CULL_MODE
+{
+    D3D11_CULL_NONE     = 1,
+    D3D11_CULL_FRONT    = 2,
+    D3D11_CULL_BACK     = 3,
+} D3D11_CULL_MODE;
+
+typedef enum D3D11_BLEND
+{
+    D3D11_BLEND_ZERO            = 1,
+    D3D11_BLEND_ONE             = 2,
+    D3D11_BLEND_SRC_COLOR       = 3,
+    D3D11_BLEND_INV_SRC_COLOR   = 4,
+    D3D11_BLEND_SRC_ALPHA       = 5,
+    D3D11_BLEND_INV_SRC_ALPHA   = 6,
+    D3D11_BLEND_DEST_ALPHA      = 7,
+    D3D11_BLEND_INV_DEST_ALPHA  = 8,
+    D3D11_BLEND_DEST_COLOR      = 9,
+    D3D11_BLEND_INV_DEST_COLOR  = 10,
+    D3D11_BLEND_SRC_ALPHA_SAT   = 11,
+    D3D11_BLEND_BLEND_FACTOR    = 14,
+    D3D11_BLEND_INV_BLEND_FACTOR = 15,
+    D3D11_BLEND_SRC1_COLOR      = 16,
+    D3D11_BLEND_INV_SRC1_COLOR  = 17,
+    D3D11_BLEND_SRC1_ALPHA      = 18,
+    D3D11_BLEND_INV_SRC1_ALPHA  = 19,
+} D3D11_BLEND;
+
+typedef enum D3D11_BLEND_OP
+{
+    D3D11_BLEND_OP_ADD          = 1,
+    D3D11_BLEND_OP_SUBTRACT     = 2,
+    D3D11_BLEND_OP_REV_SUBTRACT = 3,
+    D3D11_BLEND_OP_MIN          = 4,
+    D3D11_BLEND_OP_MAX          = 5,
+} D3D11_BLEND_OP;
+
+typedef enum D3D11_COLOR_WRITE_ENABLE
+{
+    D3D11_COLOR_WRITE_ENABLE_RED    = 1,
+    D3D11_COLOR_WRITE_ENABLE_GREEN  = 2,
+    D3D11_COLOR_WRITE_ENABLE_BLUE   = 4,
+    D3D11_COLOR_WRITE_ENABLE_ALPHA  = 8,
+    D3D11_COLOR_WRITE_ENABLE_ALL    = 15,
+} D3D11_COLOR_WRITE_ENABLE;
+
+typedef enum D3D11_COMPARISON_FUNC
+{
+    D3D11_COMPARISON_NEVER          = 1,
+    D3D11_COMPARISON_LESS           = 2,
+    D3D11_COMPARISON_EQUAL          = 3,
+    D3D11_COMPARISON_LESS_EQUAL     = 4,
+    D3D11_COMPARISON_GREATER        = 5,
+    D3D11_COMPARISON_NOT_EQUAL      = 6,
+    D3D11_COMPARISON_GREATER_EQUAL  = 7,
+    D3D11_COMPARISON_ALWAYS         = 8,
+} D3D11_COMPARISON_FUNC;
+
+typedef enum D3D11_DEPTH_WRITE_MASK
+{
+    D3D11_DEPTH_WRITE_MASK_ZERO = 0,
+    D3D11_DEPTH_WRITE_MASK_ALL  = 1,
+} D3D11_DEPTH_WRITE_MASK;
+
+typedef enum D3D11_STENCIL_OP
+{
+    D3D11_STENCIL_OP_KEEP       = 1,
+    D3D11_STENCIL_OP_ZERO       = 2,
+    D3D11_STENCIL_OP_REPLACE    = 3,
+    D3D11_STENCIL_OP_INCR_SAT   = 4,
+    D3D11_STENCIL_OP_DECR_SAT   = 5,
+    D3D11_STENCIL_OP_INVERT     = 6,
+    D3D11_STENCIL_OP_INCR       = 7,
+    D3D11_STENCIL_OP_DECR       = 8,
+} D3D11_STENCIL_OP;
+
+typedef enum D3D11_FILTER
+{
+    D3D11_FILTER_MIN_MAG_MIP_POINT                          = 0,
+    D3D11_FILTER_MIN_MAG_POINT_MIP_LINEAR                   = 0x1,
+    D3D11_FILTER_MIN_POINT_MAG_LINEAR_MIP_POINT             = 0x4,
+    D3D11_FILTER_MIN_POINT_MAG_MIP_LINEAR                   = 0x5,
+    D3D11_FILTER_MIN_LINEAR_MAG_MIP_POINT                   = 0x10,
+    D3D11_FILTER_MIN_LINEAR_MAG_POINT_MIP_LINEAR            = 0x11,
+    D3D11_FILTER_MIN_MAG_LINEAR_MIP_POINT                   = 0x14,
+    D3D11_FILTER_MIN_MAG_MIP_LINEAR                         = 0x15,
+    D3D11_FILTER_ANISOTROPIC                                = 0x55,
+    D3D11_FILTER_COMPARISON_MIN_MAG_MIP_POINT               = 0x80,
+    D3D11_FILTER_COMPARISON_MIN_MAG_POINT_MIP_LINEAR        = 0x81,
+    D3D11_FILTER_COMPARISON_MIN_POINT_MAG_LINEAR_MIP_POINT  = 0x84,
+    D3D11_FILTER_COMPARISON_MIN_POINT_MAG_MIP_LINEAR        = 0x85,
+    D3D11_FILTER_COMPARISON_MIN_LINEAR_MAG_MIP_POINT        = 0x90,
+    D3D11_FILTER_COMPARISON_MIN_LINEAR_MAG_POINT_MIP_LINEAR = 0x91,
+    D3D11_FILTER_COMPARISON_MIN_MAG_LINEAR_MIP_POINT        = 0x94,
+    D3D11_FILTER_COMPARISON_MIN_MAG_MIP_LINEAR              = 0x95,
+    D3D11_FILTER_COMPARISON_ANISOTROPIC                     = 0xd5,
+} D3D11_FILTER;
+
+typedef enum D3D11_TEXTURE_ADDRESS_MODE
+{
+    D3D11_TEXTURE_ADDRESS_WRAP          = 1,
+    D3D11_TEXTURE_ADDRESS_MIRROR        = 2,
+    D3D11_TEXTURE_ADDRESS_CLAMP         = 3,
+    D3D11_TEXTURE_ADDRESS_BORDER        = 4,
+    D3D11_TEXTURE_ADDRESS_MIRROR_ONCE   = 5,
+} D3D11_TEXTURE_ADDRESS_MODE;
+
+typedef enum D3D11_INPUT_CLASSIFICATION
+{
+    D3D11_INPUT_PER_VERTEX_DATA     = 0,
+    D3D11_INPUT_PER_INSTANCE_DATA   = 1,
+} D3D11_INPUT_CLASSIFICATION;
+
+typedef enum D3D11_QUERY
+{
+    D3D11_QUERY_EVENT                   = 0,
+    D3D11_QUERY_OCCLUSION               = 1,
+    D3D11_QUERY_TIMESTAMP               = 2,
+    D3D11_QUERY_TIMESTAMP_DISJOINT      = 3,
+    D3D11_QUERY_PIPELINE_STATISTICS     = 4,
+    D3D11_QUERY_OCCLUSION_PREDICATE     = 5,
+} D3D11_QUERY;
+
+typedef enum D3D11_ASYNC_GETDATA_FLAG
+{
+    D3D11_ASYNC_GETDATA_DONOTFLUSH = 0x1,
+} D3D11_ASYNC_GETDATA_FLAG;
+
+typedef enum D3D11_CLEAR_FLAG
+{
+    D3D11_CLEAR_DEPTH   = 0x1,
+    D3D11_CLEAR_STENCIL = 0x2,
+} D3D11_CLEAR_FLAG;
+
+typedef enum D3D11_DEVICE_CONTEXT_TYPE
+{
+    D3D11_DEVICE_CONTEXT_IMMEDIATE  = 0,
+    D3D11_DEVICE_CONTEXT_DEFERRED   = 1,
+} D3D11_DEVICE_CONTEXT_TYPE;
+
+typedef enum D3D11_CREATE_DEVICE_FLAG
+{
+    D3D11_CREATE_DEVICE_SINGLETHREADED  = 0x1,
+    D3D11_CREATE_DEVICE_DEBUG           = 0x2,
+    D3D11_CREATE_DEVICE_SWITCH_TO_REF   = 0x4,
+    D3D11_CREATE_DEVICE_PREVENT_INTERNAL_THREADING_OPTIMIZATIONS = 0x8,
+    D3D11_CREATE_DEVICE_BGRA_SUPPORT    = 0x20,
+} D3D11_CREATE_DEVICE_FLAG;
+
+typedef enum D3D11_FEATURE
+{
+    D3D11_FEATURE_THREADING                 = 0,
+    D3D11_FEATURE_DOUBLES                   = 1,
+    D3D11_FEATURE_FORMAT_SUPPORT            = 2,
+    D3D11_FEATURE_FORMAT_SUPPORT2           = 3,
+    D3D11_FEATURE_D3D10_X_HARDWARE_OPTIONS  = 4,
+} D3D11_FEATURE;
+
+typedef struct D3D11_FEATURE_DATA_D3D10_X_HARDWARE_OPTIONS
+{
+    BOOL ComputeShaders_Plus_RawAndStructuredBuffers_Via_Shader_4_x;
+} D3D11_FEATURE_DATA_D3D10_X_HARDWARE_OPTIONS;
+
+typedef enum D3D11_FORMAT_SUPPORT
+{
+    D3D11_FORMAT_SUPPORT_BUFFER                 = 0x1,
+    D3D11_FORMAT_SUPPORT_IA_VERTEX_BUFFER       = 0x2,
+    D3D11_FORMAT_SUPPORT_IA_INDEX_BUFFER        = 0x4,
+    D3D11_FORMAT_SUPPORT_SO_BUFFER              = 0x8,
+    D3D11_FORMAT_SUPPORT_TEXTURE1D              = 0x10,
+    D3D11_FORMAT_SUPPORT_TEXTURE2D              = 0x20,
+    D3D11_FORMAT_SUPPORT_TEXTURE3D              = 0x40,
+    D3D11_FORMAT_SUPPORT_TEXTURECUBE            = 0x80,
+    D3D11_FORMAT_SUPPORT_SHADER_LOAD            = 0x100,
+    D3D11_FORMAT_SUPPORT_SHADER_SAMPLE          = 0x200,
+    D3D11_FORMAT_SUPPORT_MIP                    = 0x8000,
+    D3D11_FORMAT_SUPPORT_MIP_AUTOGEN            = 0x10000,
+    D3D11_FORMAT_SUPPORT_RENDER_TARGET          = 0x20000,
+    D3D11_FORMAT_SUPPORT_BLENDABLE              = 0x40000,
+    D3D11_FORMAT_SUPPORT_DEPTH_STENCIL          = 0x80000,
+    D3D11_FORMAT_SUPPORT_MULTISAMPLE_RESOLVE    = 0x200000,
+} D3D11_FORMAT_SUPPORT;
+
+typedef enum D3D11_COUNTER
+{
+    D3D11_COUNTER_DEVICE_DEPENDENT_0 = 0x40000000,
+} D3D11_COUNTER;
+
+typedef enum D3D11_COUNTER_TYPE
+{
+    D3D11_COUNTER_TYPE_FLOAT32  = 0,
+    D3D11_COUNTER_TYPE_UINT16   = 1,
+    D3D11_COUNTER_TYPE_UINT32   = 2,
+    D3D11_COUNTER_TYPE_UINT64   = 3,
+} D3D11_COUNTER_TYPE;
+
+// ---------------------------------------------------------------------------
+// descriptions
+typedef struct D3D11_BUFFER_DESC
+{
+    UINT        ByteWidth;
+    D3D11_USAGE Usage;
+    UINT        BindFlags;
+    UINT        CPUAccessFlags;
+    UINT        MiscFlags;
+    UINT        StructureByteStride;
+} D3D11_BUFFER_DESC;
+
+typedef struct D3D11_TEXTURE1D_DESC
+{
+    UINT        Width;
+    UINT        MipLevels;
+    UINT        ArraySize;
+    DXGI_FORMAT Format;
+    D3D11_USAGE Usage;
+    UINT        BindFlags;
+    UINT        CPUAccessFlags;
+    UINT        MiscFlags;
+} D3D11_TEXTURE1D_DESC;
+
+typedef struct D3D11_TEXTURE2D_DESC
+{
+    UINT                Width;
+    UINT                Height;
+    UINT                MipLevels;
+    UINT                ArraySize;
+    DXGI_FORMAT         Format;
+    DXGI_SAMPLE_DESC    SampleDesc;
+    D3D11_USAGE         Usage;
+    UINT                BindFlags;
+    UINT                CPUAccessFlags;
+    UINT                MiscFlags;
+} D3D11_TEXTURE2D_DESC;
+
+typedef struct D3D11_TEXTURE3D_DESC
+{
+    UINT        Width;
+    UINT        Height;
+    UINT        Depth;
+    UINT        MipLevels;
+    DXGI_FORMAT Format;
+    D3D11_USAGE Usage;
+    UINT        BindFlags;
+    UINT        CPUAccessFlags;
+    UINT        MiscFlags;
+} D3D11_TEXTURE3D_DESC;
+
+typedef struct D3D11_SUBRESOURCE_DATA
+{
+    const void* pSysMem;
+    UINT        SysMemPitch;
+    UINT        SysMemSlicePitch;
+} D3D11_SUBRESOURCE_DATA;
+
+typedef struct D3D11_MAPPED_SUBRESOURCE
+{
+    void*   pData;
+    UINT    RowPitch;
+    UINT    DepthPitch;
+} D3D11_MAPPED_SUBRESOURCE;
+
+typedef struct D3D11_BOX
+{
+    UINT left;
+    UINT top;
+    UINT front;
+    UINT right;
+    UINT bottom;
+    UINT back;
+} D3D11_BOX;
+
+typedef struct D3D11_VIEWPORT
+{
+    FLOAT TopLeftX;
+    FLOAT TopLeftY;
+    FLOAT Width;
+    FLOAT Height;
+    FLOAT MinDepth;
+    FLOAT MaxDepth;
+} D3D11_VIEWPORT;
+
+typedef struct D3D11_BUFFER_SRV
+{
+    union { UINT FirstElement; UINT ElementOffset; };
+    union { UINT NumElements; UINT ElementWidth; };
+} D3D11_BUFFER_SRV;
+
+typedef struct D3D11_BUFFEREX_SRV
+{
+    UINT FirstElement;
+    UINT NumElements;
+    UINT Flags;
+} D3D11_BUFFEREX_SRV;
+
+typedef struct D3D11_TEX1D_SRV { UINT MostDetailedMip; UINT MipLevels; } D3D11_TEX1D_SRV;
+typedef struct D3D11_TEX1D_ARRAY_SRV { UINT MostDetailedMip; UINT MipLevels; UINT FirstArraySlice; UINT ArraySize; } D3D11_TEX1D_ARRAY_SRV;
+typedef struct D3D11_TEX2D_SRV { UINT MostDetailedMip; UINT MipLevels; } D3D11_TEX2D_SRV;
+typedef struct D3D11_TEX2D_ARRAY_SRV { UINT MostDetailedMip; UINT MipLevels; UINT FirstArraySlice; UINT ArraySize; } D3D11_TEX2D_ARRAY_SRV;
+typedef struct D3D11_TEX2DMS_SRV { UINT UnusedField_NothingToDefine; } D3D11_TEX2DMS_SRV;
+typedef struct D3D11_TEX2DMS_ARRAY_SRV { UINT FirstArraySlice; UINT ArraySize; } D3D11_TEX2DMS_ARRAY_SRV;
+typedef struct D3D11_TEX3D_SRV { UINT MostDetailedMip; UINT MipLevels; } D3D11_TEX3D_SRV;
+typedef struct D3D11_TEXCUBE_SRV { UINT MostDetailedMip; UINT MipLevels; } D3D11_TEXCUBE_SRV;
+typedef struct D3D11_TEXCUBE_ARRAY_SRV { UINT MostDetailedMip; UINT MipLevels; UINT First2DArrayFace; UINT NumCubes; } D3D11_TEXCUBE_ARRAY_SRV;
+
+typedef struct D3D11_SHADER_RESOURCE_VIEW_DESC
+{
+    DXGI_FORMAT         Format;
+    D3D11_SRV_DIMENSION ViewDimension;
+    union
+    {
+        D3D11_BUFFER_SRV        Buffer;
+        D3D11_TEX1D_SRV         Texture1D;
+        D3D11_TEX1D_ARRAY_SRV   Texture1DArray;
+        D3D11_TEX2D_SRV         Texture2D;
+        D3D11_TEX2D_ARRAY_SRV   Texture2DArray;
+        D3D11_TEX2DMS_SRV       Texture2DMS;
+        D3D11_TEX2DMS_ARRAY_SRV Texture2DMSArray;
+        D3D11_TEX3D_SRV         Texture3D;
+        D3D11_TEXCUBE_SRV       TextureCube;
+        D3D11_TEXCUBE_ARRAY_SRV TextureCubeArray;
+        D3D11_BUFFEREX_SRV      BufferEx;
+    };
+} D3D11_SHADER_RESOURCE_VIEW_DESC;
+
+typedef struct D3D11_BUFFER_RTV
+{
+    union { UINT FirstElement; UINT ElementOffset; };
+    union { UINT NumElements; UINT ElementWidth; };
+} D3D11_BUFFER_RTV;
+
+typedef struct D3D11_TEX1D_RTV { UINT MipSlice; } D3D11_TEX1D_RTV;
+typedef struct D3D11_TEX1D_ARRAY_RTV { UINT MipSlice; UINT FirstArraySlice; UINT ArraySize; } D3D11_TEX1D_ARRAY_RTV;
+typedef struct D3D11_TEX2D_RTV { UINT MipSlice; } D3D11_TEX2D_RTV;
+typedef struct D3D11_TEX2DMS_RTV { UINT UnusedField_NothingToDefine; } D3D11_TEX2DMS_RTV;
+typedef struct D3D11_TEX2D_ARRAY_RTV { UINT MipSlice; UINT FirstArraySlice; UINT ArraySize; } D3D11_TEX2D_ARRAY_RTV;
+typedef struct D3D11_TEX2DMS_ARRAY_RTV { UINT FirstArraySlice; UINT ArraySize; } D3D11_TEX2DMS_ARRAY_RTV;
+typedef struct D3D11_TEX3D_RTV { UINT MipSlice; UINT FirstWSlice; UINT WSize; } D3D11_TEX3D_RTV;
+
+typedef struct D3D11_RENDER_TARGET_VIEW_DESC
+{
+    DXGI_FORMAT         Format;
+    D3D11_RTV_DIMENSION ViewDimension;
+    union
+    {
+        D3D11_BUFFER_RTV        Buffer;
+        D3D11_TEX1D_RTV         Texture1D;
+        D3D11_TEX1D_ARRAY_RTV   Texture1DArray;
+        D3D11_TEX2D_RTV         Texture2D;
+        D3D11_TEX2D_ARRAY_RTV   Texture2DArray;
+        D3D11_TEX2DMS_RTV       Texture2DMS;
+        D3D11_TEX2DMS_ARRAY_RTV Texture2DMSArray;
+        D3D11_TEX3D_RTV         Texture3D;
+    };
+} D3D11_RENDER_TARGET_VIEW_DESC;
+
+typedef struct D3D11_TEX1D_DSV { UINT MipSlice; } D3D11_TEX1D_DSV;
+typedef struct D3D11_TEX1D_ARRAY_DSV { UINT MipSlice; UINT FirstArraySlice; UINT ArraySize; } D3D11_TEX1D_ARRAY_DSV;
+typedef struct D3D11_TEX2D_DSV { UINT MipSlice; } D3D11_TEX2D_DSV;
+typedef struct D3D11_TEX2D_ARRAY_DSV { UINT MipSlice; UINT FirstArraySlice; UINT ArraySize; } D3D11_TEX2D_ARRAY_DSV;
+typedef struct D3D11_TEX2DMS_DSV { UINT UnusedField_NothingToDefine; } D3D11_TEX2DMS_DSV;
+typedef struct D3D11_TEX2DMS_ARRAY_DSV { UINT FirstArraySlice; UINT ArraySize; } D3D11_TEX2DMS_ARRAY_DSV;
+
+typedef struct D3D11_DEPTH_STENCIL_VIEW_DESC
+{
+    DXGI_FORMAT         Format;
+    D3D11_DSV_DIMENSION ViewDimension;
+    UINT                Flags;
+    union
+    {
+        D3D11_TEX1D_DSV         Texture1D;
+        D3D11_TEX1D_ARRAY_DSV   Texture1DArray;
+        D3D11_TEX2D_DSV         Texture2D;
+        D3D11_TEX2D_ARRAY_DSV   Texture2DArray;
+        D3D11_TEX2DMS_DSV       Texture2DMS;
+        D3D11_TEX2DMS_ARRAY_DSV Texture2DMSArray;
+    };
+} D3D11_DEPTH_STENCIL_VIEW_DESC;
+
+typedef struct D3D11_BUFFER_UAV { UINT FirstElement; UINT NumElements; UINT Flags; } D3D11_BUFFER_UAV;
+typedef struct D3D11_TEX1D_UAV { UINT MipSlice; } D3D11_TEX1D_UAV;
+typedef struct D3D11_TEX1D_ARRAY_UAV { UINT MipSlice; UINT FirstArraySlice; UINT ArraySize; } D3D11_TEX1D_ARRAY_UAV;
+typedef struct D3D11_TEX2D_UAV { UINT MipSlice; } D3D11_TEX2D_UAV;
+typedef struct D3D11_TEX2D_ARRAY_UAV { UINT MipSlice; UINT FirstArraySlice; UINT ArraySize; } D3D11_TEX2D_ARRAY_UAV;
+typedef struct D3D11_TEX3D_UAV { UINT MipSlice; UINT FirstWSlice; UINT WSize; } D3D11_TEX3D_UAV;
+
+typedef struct D3D11_UNORDERED_ACCESS_VIEW_DESC
+{
+    DXGI_FORMAT         Format;
+    D3D11_UAV_DIMENSION ViewDimension;
+    union
+    {
+        D3D11_BUFFER_UAV        Buffer;
+        D3D11_TEX1D_UAV         Texture1D;
+        D3D11_TEX1D_ARRAY_UAV   Texture1DArray;
+        D3D11_TEX2D_UAV         Texture2D;
+        D3D11_TEX2D_ARRAY_UAV   Texture2DArray;
+        D3D11_TEX3D_UAV         Texture3D;
+    };
+} D3D11_UNORDERED_ACCESS_VIEW_DESC;
+
+typedef struct D3D11_RASTERIZER_DESC
+{
+    D3D11_FILL_MODE FillMode;
+    D3D11_CULL_MODE CullMode;
+    BOOL            FrontCounterClockwise;
+    INT             DepthBias;
+    FLOAT           DepthBiasClamp;
+    FLOAT           SlopeScaledDepthBias;
+    BOOL            DepthClipEnable;
+    BOOL            ScissorEnable;
+    BOOL            MultisampleEnable;
+    BOOL            AntialiasedLineEnable;
+} D3D11_RASTERIZER_DESC;
+
+typedef struct D3D11_RENDER_TARGET_BLEND_DESC
+{
+    BOOL            BlendEnable;
+    D3D11_BLEND     SrcBlend;
+    D3D11_BLEND     DestBlend;
+    D3D11_BLEND_OP  BlendOp;
+    D3D11_BLEND     SrcBlendAlpha;
+    D3D11_BLEND     DestBlendAlpha;
+    D3D11_BLEND_OP  BlendOpAlpha;
+    UINT8           RenderTargetWriteMask;
+} D3D11_RENDER_TARGET_BLEND_DESC;
+
+typedef struct D3D11_BLEND_DESC
+{
+    BOOL                            AlphaToCoverageEnable;
+    BOOL                            IndependentBlendEnable;
+    D3D11_RENDER_TARGET_BLEND_DESC  RenderTarget[8];
+} D3D11_BLEND_DESC;
+
+typedef struct D3D11_DEPTH_STENCILOP_DESC
+{
+    D3D11_STENCIL_OP        StencilFailOp;
+    D3D11_STENCIL_OP        StencilDepthFailOp;
+    D3D11_STENCIL_OP        StencilPassOp;
+    D3D11_COMPARISON_FUNC   StencilFunc;
+} D3D11_DEPTH_STENCILOP_DESC;
+
+typedef struct D3D11_DEPTH_STENCIL_DESC
+{
+    BOOL                        DepthEnable;
+    D3D11_DEPTH_WRITE_MASK      DepthWriteMask;
+    D3D11_COMPARISON_FUNC       DepthFunc;
+    BOOL                        StencilEnable;
+    UINT8                       StencilReadMask;
+    UINT8                       StencilWriteMask;
+    D3D11_DEPTH_STENCILOP_DESC  FrontFace;
+    D3D11_DEPTH_STENCILOP_DESC  BackFace;
+} D3D11_DEPTH_STENCIL_DESC;
+
+typedef struct D3D11_SAMPLER_DESC
+{
+    D3D11_FILTER                Filter;
+    D3D11_TEXTURE_ADDRESS_MODE  AddressU;
+    D3D11_TEXTURE_ADDRESS_MODE  AddressV;
+    D3D11_TEXTURE_ADDRESS_MODE  AddressW;
+    FLOAT                       MipLODBias;
+    UINT                        MaxAnisotropy;
+    D3D11_COMPARISON_FUNC       ComparisonFunc;
+    FLOAT                       BorderColor[4];
+    FLOAT                       MinLOD;
+    FLOAT                       MaxLOD;
+} D3D11_SAMPLER_DESC;
+
+typedef struct D3D11_INPUT_ELEMENT_DESC
+{
+    LPCSTR                      SemanticName;
+    UINT                        SemanticIndex;
+    DXGI_FORMAT                 Format;
+    UINT                        InputSlot;
+    UINT                        AlignedByteOffset;
+    D3D11_INPUT_CLASSIFICATION  InputSlotClass;
+    UINT                        InstanceDataStepRate;
+} D3D11_INPUT_ELEMENT_DESC;
+
+typedef struct D3D11_SO_DECLARATION_ENTRY
+{
+    UINT    Stream;
+    LPCSTR  SemanticName;
+    UINT    SemanticIndex;
+    BYTE    StartComponent;
+    BYTE    ComponentCount;
+    BYTE    OutputSlot;
+} D3D11_SO_DECLARATION_ENTRY;
+
+typedef struct D3D11_QUERY_DESC
+{
+    D3D11_QUERY Query;
+    UINT        MiscFlags;
+} D3D11_QUERY_DESC;
+
+typedef struct D3D11_COUNTER_DESC
+{
+    D3D11_COUNTER   Counter;
+    UINT            MiscFlags;
+} D3D11_COUNTER_DESC;
+
+typedef struct D3D11_COUNTER_INFO
+{
+    D3D11_COUNTER   LastDeviceDependentCounter;
+    UINT            NumSimultaneousCounters;
+    UINT8           NumDetectableParallelUnits;
+} D3D11_COUNTER_INFO;
+
+inline UINT D3D11CalcSubresource(UINT MipSlice, UINT ArraySlice, UINT MipLevels)
+{
+    return MipSlice + ArraySlice * MipLevels;
+}
+
+// ---------------------------------------------------------------------------
+// interfaces
+struct ID3D11Device;
+struct ID3D11ClassLinkage;
+
+struct ID3D11DeviceChild : public IUnknown
+{
+    virtual void STDMETHODCALLTYPE GetDevice(ID3D11Device** ppDevice) = 0;
+    virtual HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID guid, UINT* pDataSize, void* pData) = 0;
+    virtual HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID guid, UINT DataSize, const void* pData) = 0;
+    virtual HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID guid, const IUnknown* pData) = 0;
+};
+
+struct ID3D11Resource : public ID3D11DeviceChild
+{
+    virtual void STDMETHODCALLTYPE GetType(D3D11_RESOURCE_DIMENSION* pResourceDimension) = 0;
+    virtual void STDMETHODCALLTYPE SetEvictionPriority(UINT EvictionPriority) = 0;
+    virtual UINT STDMETHODCALLTYPE GetEvictionPriority() = 0;
+};
+
+struct ID3D11Buffer : public ID3D11Resource
+{
+    virtual void STDMETHODCALLTYPE GetDesc(D3D11_BUFFER_DESC* pDesc) = 0;
+};
+
+struct ID3D11Texture1D : public ID3D11Resource
+{
+    virtual void STDMETHODCALLTYPE GetDesc(D3D11_TEXTURE1D_DESC* pDesc) = 0;
+};
+
+struct ID3D11Texture2D : public ID3D11Resource
+{
+    virtual void STDMETHODCALLTYPE GetDesc(D3D11_TEXTURE2D_DESC* pDesc) = 0;
+};
+
+struct ID3D11Texture3D : public ID3D11Resource
+{
+    virtual void STDMETHODCALLTYPE GetDesc(D3D11_TEXTURE3D_DESC* pDesc) = 0;
+};
+
+struct ID3D11View : public ID3D11DeviceChild
+{
+    virtual void STDMETHODCALLTYPE GetResource(ID3D11Resource** ppResource) = 0;
+};
+
+struct ID3D11ShaderResourceView : public ID3D11View
+{
+    virtual void STDMETHODCALLTYPE GetDesc(D3D11_SHADER_RESOURCE_VIEW_DESC* pDesc) = 0;
+};
+
+struct ID3D11RenderTargetView : public ID3D11View
+{
+    virtual void STDMETHODCALLTYPE GetDesc(D3D11_RENDER_TARGET_VIEW_DESC* pDesc) = 0;
+};
+
+struct ID3D11DepthStencilView : public ID3D11View
+{
+    virtual void STDMETHODCALLTYPE GetDesc(D3D11_DEPTH_STENCIL_VIEW_DESC* pDesc) = 0;
+};
+
+struct ID3D11UnorderedAccessView : public ID3D11View
+{
+    virtual void STDMETHODCALLTYPE GetDesc(D3D11_UNORDERED_ACCESS_VIEW_DESC* pDesc) = 0;
+};
+
+struct ID3D11BlendState : public ID3D11DeviceChild
+{
+    virtual void STDMETHODCALLTYPE GetDesc(D3D11_BLEND_DESC* pDesc) = 0;
+};
+
+struct ID3D11DepthStencilState : public ID3D11DeviceChild
+{
+    virtual void STDMETHODCALLTYPE GetDesc(D3D11_DEPTH_STENCIL_DESC* pDesc) = 0;
+};
+
+struct ID3D11RasterizerState : public ID3D11DeviceChild
+{
+    virtual void STDMETHODCALLTYPE GetDesc(D3D11_RASTERIZER_DESC* pDesc) = 0;
+};
+
+struct ID3D11SamplerState : public ID3D11DeviceChild
+{
+    virtual void STDMETHODCALLTYPE GetDesc(D3D11_SAMPLER_DESC* pDesc) = 0;
+};
+
+struct ID3D11InputLayout : public ID3D11DeviceChild {};
+struct ID3D11VertexShader : public ID3D11DeviceChild {};
+struct ID3D11HullShader : public ID3D11DeviceChild {};
+struct ID3D11DomainShader : public ID3D11DeviceChild {};
+struct ID3D11GeometryShader : public ID3D11DeviceChild {};
+struct ID3D11PixelShader : public ID3D11DeviceChild {};
+struct ID3D11ComputeShader : public ID3D11DeviceChild {};
+struct ID3D11ClassInstance : public ID3D11DeviceChild {};
+struct ID3D11ClassLinkage : public ID3D11DeviceChild {};
+struct ID3D11CommandList : public ID3D11DeviceChild {};
+
+struct ID3D11Asynchronous : public ID3D11DeviceChild
+{
+    virtual UINT STDMETHODCALLTYPE GetDataSize() = 0;
+};
+
+struct ID3D11Query : public ID3D11Asynchronous
+{
+    virtual void STDMETHODCALLTYPE GetDesc(D3D11_QUERY_DESC* pDesc) = 0;
+};
+
+struct ID3D11Predicate : public ID3D11Query {};
+
+struct ID3D11Counter : public ID3D11Asynchronous
+{
+    virtual void STDMETHODCALLTYPE GetDesc(D3D11_COUNTER_DESC* pDesc) = 0;
+};
+
+struct ID3D11DeviceContext : public ID3D11DeviceChild
+{
+    virtual void STDMETHODCALLTYPE VSSetConstantBuffers(UINT StartSlot, UINT NumBuffers, ID3D11Buffer* const* ppConstantBuffers) = 0;
+    virtual void STDMETHODCALLTYPE PSSetShaderResources(UINT StartSlot, UINT NumViews, ID3D11ShaderResourceView* const* ppShaderResourceViews) = 0;
+    virtual void STDMETHODCALLTYPE PSSetShader(ID3D11PixelShader* pPixelShader, ID3D11ClassInstance* const* ppClassInstances, UINT NumClassInstances) = 0;
+    virtual void STDMETHODCALLTYPE PSSetSamplers(UINT StartSlot, UINT NumSamplers, ID3D11SamplerState* const* ppSamplers) = 0;
+    virtual void STDMETHODCALLTYPE VSSetShader(ID3D11VertexShader* pVertexShader, ID3D11ClassInstance* const* ppClassInstances, UINT NumClassInstances) = 0;
+    virtual void STDMETHODCALLTYPE DrawIndexed(UINT IndexCount, UINT StartIndexLocation, INT BaseVertexLocation) = 0;
+    virtual void STDMETHODCALLTYPE Draw(UINT VertexCount, UINT StartVertexLocation) = 0;
+    virtual HRESULT STDMETHODCALLTYPE Map(ID3D11Resource* pResource, UINT Subresource, D3D11_MAP MapType, UINT MapFlags, D3D11_MAPPED_SUBRESOURCE* pMappedResource) = 0;
+    virtual void STDMETHODCALLTYPE Unmap(ID3D11Resource* pResource, UINT Subresource) = 0;
+    virtual void STDMETHODCALLTYPE PSSetConstantBuffers(UINT StartSlot, UINT NumBuffers, ID3D11Buffer* const* ppConstantBuffers) = 0;
+    virtual void STDMETHODCALLTYPE IASetInputLayout(ID3D11InputLayout* pInputLayout) = 0;
+    virtual void STDMETHODCALLTYPE IASetVertexBuffers(UINT StartSlot, UINT NumBuffers, ID3D11Buffer* const* ppVertexBuffers, const UINT* pStrides, const UINT* pOffsets) = 0;
+    virtual void STDMETHODCALLTYPE IASetIndexBuffer(ID3D11Buffer* pIndexBuffer, DXGI_FORMAT Format, UINT Offset) = 0;
+    virtual void STDMETHODCALLTYPE DrawIndexedInstanced(UINT IndexCountPerInstance, UINT InstanceCount, UINT StartIndexLocation, INT BaseVertexLocation, UINT StartInstanceLocation) = 0;
+    virtual void STDMETHODCALLTYPE DrawInstanced(UINT VertexCountPerInstance, UINT InstanceCount, UINT StartVertexLocation, UINT StartInstanceLocation) = 0;
+    virtual void STDMETHODCALLTYPE GSSetConstantBuffers(UINT StartSlot, UINT NumBuffers, ID3D11Buffer* const* ppConstantBuffers) = 0;
+    virtual void STDMETHODCALLTYPE GSSetShader(ID3D11GeometryShader* pShader, ID3D11ClassInstance* const* ppClassInstances, UINT NumClassInstances) = 0;
+    virtual void STDMETHODCALLTYPE IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY Topology) = 0;
+    virtual void STDMETHODCALLTYPE VSSetShaderResources(UINT StartSlot, UINT NumViews, ID3D11ShaderResourceView* const* ppShaderResourceViews) = 0;
+    virtual void STDMETHODCALLTYPE VSSetSamplers(UINT StartSlot, UINT NumSamplers, ID3D11SamplerState* const* ppSamplers) = 0;
+    virtual void STDMETHODCALLTYPE Begin(ID3D11Asynchronous* pAsync) = 0;
+    virtual void STDMETHODCALLTYPE End(ID3D11Asynchronous* pAsync) = 0;
+    virtual HRESULT STDMETHODCALLTYPE GetData(ID3D11Asynchronous* pAsync, void* pData, UINT DataSize, UINT GetDataFlags) = 0;
+    virtual void STDMETHODCALLTYPE SetPredication(ID3D11Predicate* pPredicate, BOOL PredicateValue) = 0;
+    virtual void STDMETHODCALLTYPE GSSetShaderResources(UINT StartSlot, UINT NumViews, ID3D11ShaderResourceView* const* ppShaderResourceViews) = 0;
+    virtual void STDMETHODCALLTYPE GSSetSamplers(UINT StartSlot, UINT NumSamplers, ID3D11SamplerState* const* ppSamplers) = 0;
+    virtual void STDMETHODCALLTYPE OMSetRenderTargets(UINT NumViews, ID3D11RenderTargetView* const* ppRenderTargetViews, ID3D11DepthStencilView* pDepthStencilView) = 0;
+    virtual void STDMETHODCALLTYPE OMSetRenderTargetsAndUnorderedAccessViews(UINT NumRTVs, ID3D11RenderTargetView* const* ppRenderTargetViews,
+        ID3D11DepthStencilView* pDepthStencilView, UINT UAVStartSlot, UINT NumUAVs, ID3D11UnorderedAccessView* const* ppUnorderedAccessViews,
+        const UINT* pUAVInitialCounts) = 0;
+    virtual void STDMETHODCALLTYPE OMSetBlendState(ID3D11BlendState* pBlendState, const FLOAT BlendFactor[4], UINT SampleMask) = 0;
+    virtual void STDMETHODCALLTYPE OMSetDepthStencilState(ID3D11DepthStencilState* pDepthStencilState, UINT StencilRef) = 0;
+    virtual void STDMETHODCALLTYPE SOSetTargets(UINT NumBuffers, ID3D11Buffer* const* ppSOTargets, const UINT* pOffsets) = 0;
+    virtual void STDMETHODCALLTYPE DrawAuto() = 0;
+    virtual void STDMETHODCALLTYPE DrawIndexedInstancedIndirect(ID3D11Buffer* pBufferForArgs, UINT AlignedByteOffsetForArgs) = 0;
+    virtual void STDMETHODCALLTYPE DrawInstancedIndirect(ID3D11Buffer* pBufferForArgs, UINT AlignedByteOffsetForArgs) = 0;
+    virtual void STDMETHODCALLTYPE Dispatch(UINT ThreadGroupCountX, UINT ThreadGroupCountY, UINT ThreadGroupCountZ) = 0;
+    virtual void STDMETHODCALLTYPE DispatchIndirect(ID3D11Buffer* pBufferForArgs, UINT AlignedByteOffsetForArgs) = 0;
+    virtual void STDMETHODCALLTYPE RSSetState(ID3D11RasterizerState* pRasterizerState) = 0;
+    virtual void STDMETHODCALLTYPE RSSetViewports(UINT NumViewports, const D3D11_VIEWPORT* pViewports) = 0;
+    virtual void STDMETHODCALLTYPE RSSetScissorRects(UINT NumRects, const D3D11_RECT* pRects) = 0;
+    virtual void STDMETHODCALLTYPE CopySubresourceRegion(ID3D11Resource* pDstResource, UINT DstSubresource, UINT DstX, UINT DstY, UINT DstZ,
+        ID3D11Resource* pSrcResource, UINT SrcSubresource, const D3D11_BOX* pSrcBox) = 0;
+    virtual void STDMETHODCALLTYPE CopyResource(ID3D11Resource* pDstResource, ID3D11Resource* pSrcResource) = 0;
+    virtual void STDMETHODCALLTYPE UpdateSubresource(ID3D11Resource* pDstResource, UINT DstSubresource, const D3D11_BOX* pDstBox,
+        const void* pSrcData, UINT SrcRowPitch, UINT SrcDepthPitch) = 0;
+    virtual void STDMETHODCALLTYPE CopyStructureCount(ID3D11Buffer* pDstBuffer, UINT DstAlignedByteOffset, ID3D11UnorderedAccessView* pSrcView) = 0;
+    virtual void STDMETHODCALLTYPE ClearRenderTargetView(ID3D11RenderTargetView* pRenderTargetView, const FLOAT ColorRGBA[4]) = 0;
+    virtual void STDMETHODCALLTYPE ClearUnorderedAccessViewUint(ID3D11UnorderedAccessView* pUnorderedAccessView, const UINT Values[4]) = 0;
+    virtual void STDMETHODCALLTYPE ClearUnorderedAccessViewFloat(ID3D11UnorderedAccessView* pUnorderedAccessView, const FLOAT Values[4]) = 0;
+    virtual void STDMETHODCALLTYPE ClearDepthStencilView(ID3D11DepthStencilView* pDepthStencilView, UINT ClearFlags, FLOAT Depth, UINT8 Stencil) = 0;
+    virtual void STDMETHODCALLTYPE GenerateMips(ID3D11ShaderResourceView* pShaderResourceView) = 0;
+    virtual void STDMETHODCALLTYPE SetResourceMinLOD(ID3D11Resource* pResource, FLOAT MinLOD) = 0;
+    virtual FLOAT STDMETHODCALLTYPE GetResourceMinLOD(ID3D11Resource* pResource) = 0;
+    virtual void STDMETHODCALLTYPE ResolveSubresource(ID3D11Resource* pDstResource, UINT DstSubresource,
+        ID3D11Resource* pSrcResource, UINT SrcSubresource, DXGI_FORMAT Format) = 0;
+    virtual void STDMETHODCALLTYPE ExecuteCommandList(ID3D11CommandList* pCommandList, BOOL RestoreContextState) = 0;
+    virtual void STDMETHODCALLTYPE HSSetShaderResources(UINT StartSlot, UINT NumViews, ID3D11ShaderResourceView* const* ppShaderResourceViews) = 0;
+    virtual void STDMETHODCALLTYPE HSSetShader(ID3D11HullShader* pHullShader, ID3D11ClassInstance* const* ppClassInstances, UINT NumClassInstances) = 0;
+    virtual void STDMETHODCALLTYPE HSSetSamplers(UINT StartSlot, UINT NumSamplers, ID3D11SamplerState* const* ppSamplers) = 0;
+    virtual void STDMETHODCALLTYPE HSSetConstantBuffers(UINT StartSlot, UINT NumBuffers, ID3D11Buffer* const* ppConstantBuffers) = 0;
+    virtual void STDMETHODCALLTYPE DSSetShaderResources(UINT StartSlot, UINT NumViews, ID3D11ShaderResourceView* const* ppShaderResourceViews) = 0;
+    virtual void STDMETHODCALLTYPE DSSetShader(ID3D11DomainShader* pDomainShader, ID3D11ClassInstance* const* ppClassInstances, UINT NumClassInstances) = 0;
+    virtual void STDMETHODCALLTYPE DSSetSamplers(UINT StartSlot, UINT NumSamplers, ID3D11SamplerState* const* ppSamplers) = 0;
+    virtual void STDMETHODCALLTYPE DSSetConstantBuffers(UINT StartSlot, UINT NumBuffers, ID3D11Buffer* const* ppConstantBuffers) = 0;
+    virtual void STDMETHODCALLTYPE CSSetShaderResources(UINT StartSlot, UINT NumViews, ID3D11ShaderResourceView* const* ppShaderResourceViews) = 0;
+    virtual void STDMETHODCALLTYPE CSSetUnorderedAccessViews(UINT StartSlot, UINT NumUAVs, ID3D11UnorderedAccessView* const* ppUnorderedAccessViews,
+        const UINT* pUAVInitialCounts) = 0;
+    virtual void STDMETHODCALLTYPE CSSetShader(ID3D11ComputeShader* pComputeShader, ID3D11ClassInstance* const* ppClassInstances, UINT NumClassInstances) = 0;
+    virtual void STDMETHODCALLTYPE CSSetSamplers(UINT StartSlot, UINT NumSamplers, ID3D11SamplerState* const* ppSamplers) = 0;
+    virtual void STDMETHODCALLTYPE CSSetConstantBuffers(UINT StartSlot, UINT NumBuffers, ID3D11Buffer* const* ppConstantBuffers) = 0;
+    virtual void STDMETHODCALLTYPE VSGetConstantBuffers(UINT StartSlot, UINT NumBuffers, ID3D11Buffer** ppConstantBuffers) = 0;
+    virtual void STDMETHODCALLTYPE PSGetShaderResources(UINT StartSlot, UINT NumViews, ID3D11ShaderResourceView** ppShaderResourceViews) = 0;
+    virtual void STDMETHODCALLTYPE PSGetShader(ID3D11PixelShader** ppPixelShader, ID3D11ClassInstance** ppClassInstances, UINT* pNumClassInstances) = 0;
+    virtual void STDMETHODCALLTYPE PSGetSamplers(UINT StartSlot, UINT NumSamplers, ID3D11SamplerState** ppSamplers) = 0;
+    virtual void STDMETHODCALLTYPE VSGetShader(ID3D11VertexShader** ppVertexShader, ID3D11ClassInstance** ppClassInstances, UINT* pNumClassInstances) = 0;
+    virtual void STDMETHODCALLTYPE PSGetConstantBuffers(UINT StartSlot, UINT NumBuffers, ID3D11Buffer** ppConstantBuffers) = 0;
+    virtual void STDMETHODCALLTYPE IAGetInputLayout(ID3D11InputLayout** ppInputLayout) = 0;
+    virtual void STDMETHODCALLTYPE IAGetVertexBuffers(UINT StartSlot, UINT NumBuffers, ID3D11Buffer** ppVertexBuffers, UINT* pStrides, UINT* pOffsets) = 0;
+    virtual void STDMETHODCALLTYPE IAGetIndexBuffer(ID3D11Buffer** pIndexBuffer, DXGI_FORMAT* Format, UINT* Offset) = 0;
+    virtual void STDMETHODCALLTYPE GSGetConstantBuffers(UINT StartSlot, UINT NumBuffers, ID3D11Buffer** ppConstantBuffers) = 0;
+    virtual void STDMETHODCALLTYPE GSGetShader(ID3D11GeometryShader** ppGeometryShader, ID3D11ClassInstance** ppClassInstances, UINT* pNumClassInstances) = 0;
+    virtual void STDMETHODCALLTYPE IAGetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY* pTopology) = 0;
+    virtual void STDMETHODCALLTYPE VSGetShaderResources(UINT StartSlot, UINT NumViews, ID3D11ShaderResourceView** ppShaderResourceViews) = 0;
+    virtual void STDMETHODCALLTYPE VSGetSamplers(UINT StartSlot, UINT NumSamplers, ID3D11SamplerState** ppSamplers) = 0;
+    virtual void STDMETHODCALLTYPE GetPredication(ID3D11Predicate** ppPredicate, BOOL* pPredicateValue) = 0;
+    virtual void STDMETHODCALLTYPE GSGetShaderResources(UINT StartSlot, UINT NumViews, ID3D11ShaderResourceView** ppShaderResourceViews) = 0;
+    virtual void STDMETHODCALLTYPE GSGetSamplers(UINT StartSlot, UINT NumSamplers, ID3D11SamplerState** ppSamplers) = 0;
+    virtual void STDMETHODCALLTYPE OMGetRenderTargets(UINT NumViews, ID3D11RenderTargetView** ppRenderTargetViews, ID3D11DepthStencilView** ppDepthStencilView) = 0;
+    virtual void STDMETHODCALLTYPE OMGetRenderTargetsAndUnorderedAccessViews(UINT NumRTVs, ID3D11RenderTargetView** ppRenderTargetViews,
+        ID3D11DepthStencilView** ppDepthStencilView, UINT UAVStartSlot, UINT NumUAVs, ID3D11UnorderedAccessView** ppUnorderedAccessViews) = 0;
+    virtual void STDMETHODCALLTYPE OMGetBlendState(ID3D11BlendState** ppBlendState, FLOAT BlendFactor[4], UINT* pSampleMask) = 0;
+    virtual void STDMETHODCALLTYPE OMGetDepthStencilState(ID3D11DepthStencilState** ppDepthStencilState, UINT* pStencilRef) = 0;
+    virtual void STDMETHODCALLTYPE SOGetTargets(UINT NumBuffers, ID3D11Buffer** ppSOTargets) = 0;
+    virtual void STDMETHODCALLTYPE RSGetState(ID3D11RasterizerState** ppRasterizerState) = 0;
+    virtual void STDMETHODCALLTYPE RSGetViewports(UINT* pNumViewports, D3D11_VIEWPORT* pViewports) = 0;
+    virtual void STDMETHODCALLTYPE RSGetScissorRects(UINT* pNumRects, D3D11_RECT* pRects) = 0;
+    virtual void STDMETHODCALLTYPE HSGetShaderResources(UINT StartSlot, UINT NumViews, ID3D11ShaderResourceView** ppShaderResourceViews) = 0;
+    virtual void STDMETHODCALLTYPE HSGetShader(ID3D11HullShader** ppHullShader, ID3D11ClassInstance** ppClassInstances, UINT* pNumClassInstances) = 0;
+    virtual void STDMETHODCALLTYPE HSGetSamplers(UINT StartSlot, UINT NumSamplers, ID3D11SamplerState** ppSamplers) = 0;
+    virtual void STDMETHODCALLTYPE HSGetConstantBuffers(UINT StartSlot, UINT NumBuffers, ID3D11Buffer** ppConstantBuffers) = 0;
+    virtual void STDMETHODCALLTYPE DSGetShaderResources(UINT StartSlot, UINT NumViews, ID3D11ShaderResourceView** ppShaderResourceViews) = 0;
+    virtual void STDMETHODCALLTYPE DSGetShader(ID3D11DomainShader** ppDomainShader, ID3D11ClassInstance** ppClassInstances, UINT* pNumClassInstances) = 0;
+    virtual void STDMETHODCALLTYPE DSGetSamplers(UINT StartSlot, UINT NumSamplers, ID3D11SamplerState** ppSamplers) = 0;
+    virtual void STDMETHODCALLTYPE DSGetConstantBuffers(UINT StartSlot, UINT NumBuffers, ID3D11Buffer** ppConstantBuffers) = 0;
+    virtual void STDMETHODCALLTYPE CSGetShaderResources(UINT StartSlot, UINT NumViews, ID3D11ShaderResourceView** ppShaderResourceViews) = 0;
+    virtual void STDMETHODCALLTYPE CSGetUnorderedAccessViews(UINT StartSlot, UINT NumUAVs, ID3D11UnorderedAccessView** ppUnorderedAccessViews) = 0;
+    virtual void STDMETHODCALLTYPE CSGetShader(ID3D11ComputeShader** ppComputeShader, ID3D11ClassInstance** ppClassInstances, UINT* pNumClassInstances) = 0;
+    virtual void STDMETHODCALLTYPE CSGetSamplers(UINT StartSlot, UINT NumSamplers, ID3D11SamplerState** ppSamplers) = 0;
+    virtual void STDMETHODCALLTYPE CSGetConstantBuffers(UINT StartSlot, UINT NumBuffers, ID3D11Buffer** ppConstantBuffers) = 0;
+    virtual void STDMETHODCALLTYPE ClearState() = 0;
+    virtual void STDMETHODCALLTYPE Flush() = 0;
+    virtual D3D11_DEVICE_CONTEXT_TYPE STDMETHODCALLTYPE GetType() = 0;
+    virtual UINT STDMETHODCALLTYPE GetContextFlags() = 0;
+    virtual HRESULT STDMETHODCALLTYPE FinishCommandList(BOOL RestoreDeferredContextState, ID3D11CommandList** ppCommandList) = 0;
+};
+
+struct ID3D11Device : public IUnknown
+{
+    virtual HRESULT STDMETHODCALLTYPE CreateBuffer(const D3D11_BUFFER_DESC* pDesc, const D3D11_SUBRESOURCE_DATA* pInitialData, ID3D11Buffer** ppBuffer) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateTexture1D(const D3D11_TEXTURE1D_DESC* pDesc, const D3D11_SUBRESOURCE_DATA* pInitialData, ID3D11Texture1D** ppTexture1D) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateTexture2D(const D3D11_TEXTURE2D_DESC* pDesc, const D3D11_SUBRESOURCE_DATA* pInitialData, ID3D11Texture2D** ppTexture2D) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateTexture3D(const D3D11_TEXTURE3D_DESC* pDesc, const D3D11_SUBRESOURCE_DATA* pInitialData, ID3D11Texture3D** ppTexture3D) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateShaderResourceView(ID3D11Resource* pResource, const D3D11_SHADER_RESOURCE_VIEW_DESC* pDesc, ID3D11ShaderResourceView** ppSRView) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateUnorderedAccessView(ID3D11Resource* pResource, const D3D11_UNORDERED_ACCESS_VIEW_DESC* pDesc, ID3D11UnorderedAccessView** ppUAView) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateRenderTargetView(ID3D11Resource* pResource, const D3D11_RENDER_TARGET_VIEW_DESC* pDesc, ID3D11RenderTargetView** ppRTView) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateDepthStencilView(ID3D11Resource* pResource, const D3D11_DEPTH_STENCIL_VIEW_DESC* pDesc, ID3D11DepthStencilView** ppDepthStencilView) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateInputLayout(const D3D11_INPUT_ELEMENT_DESC* pInputElementDescs, UINT NumElements,
+        const void* pShaderBytecodeWithInputSignature, SIZE_T BytecodeLength, ID3D11InputLayout** ppInputLayout) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateVertexShader(const void* pShaderBytecode, SIZE_T BytecodeLength, ID3D11ClassLinkage* pClassLinkage, ID3D11VertexShader** ppVertexShader) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateGeometryShader(const void* pShaderBytecode, SIZE_T BytecodeLength, ID3D11ClassLinkage* pClassLinkage, ID3D11GeometryShader** ppGeometryShader) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateGeometryShaderWithStreamOutput(const void* pShaderBytecode, SIZE_T BytecodeLength,
+        const D3D11_SO_DECLARATION_ENTRY* pSODeclaration, UINT NumEntries, const UINT* pBufferStrides, UINT NumStrides,
+        UINT RasterizedStream, ID3D11ClassLinkage* pClassLinkage, ID3D11GeometryShader** ppGeometryShader) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreatePixelShader(const void* pShaderBytecode, SIZE_T BytecodeLength, ID3D11ClassLinkage* pClassLinkage, ID3D11PixelShader** ppPixelShader) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateHullShader(const void* pShaderBytecode, SIZE_T BytecodeLength, ID3D11ClassLinkage* pClassLinkage, ID3D11HullShader** ppHullShader) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateDomainShader(const void* pShaderBytecode, SIZE_T BytecodeLength, ID3D11ClassLinkage* pClassLinkage, ID3D11DomainShader** ppDomainShader) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateComputeShader(const void* pShaderBytecode, SIZE_T BytecodeLength, ID3D11ClassLinkage* pClassLinkage, ID3D11ComputeShader** ppComputeShader) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateClassLinkage(ID3D11ClassLinkage** ppLinkage) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateBlendState(const D3D11_BLEND_DESC* pBlendStateDesc, ID3D11BlendState** ppBlendState) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateDepthStencilState(const D3D11_DEPTH_STENCIL_DESC* pDepthStencilDesc, ID3D11DepthStencilState** ppDepthStencilState) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateRasterizerState(const D3D11_RASTERIZER_DESC* pRasterizerDesc, ID3D11RasterizerState** ppRasterizerState) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateSamplerState(const D3D11_SAMPLER_DESC* pSamplerDesc, ID3D11SamplerState** ppSamplerState) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateQuery(const D3D11_QUERY_DESC* pQueryDesc, ID3D11Query** ppQuery) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreatePredicate(const D3D11_QUERY_DESC* pPredicateDesc, ID3D11Predicate** ppPredicate) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateCounter(const D3D11_COUNTER_DESC* pCounterDesc, ID3D11Counter** ppCounter) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CreateDeferredContext(UINT ContextFlags, ID3D11DeviceContext** ppDeferredContext) = 0;
+    virtual HRESULT STDMETHODCALLTYPE OpenSharedResource(HANDLE hResource, REFIID ReturnedInterface, void** ppResource) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CheckFormatSupport(DXGI_FORMAT Format, UINT* pFormatSupport) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CheckMultisampleQualityLevels(DXGI_FORMAT Format, UINT SampleCount, UINT* pNumQualityLevels) = 0;
+    virtual void STDMETHODCALLTYPE CheckCounterInfo(D3D11_COUNTER_INFO* pCounterInfo) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CheckCounter(const D3D11_COUNTER_DESC* pDesc, D3D11_COUNTER_TYPE* pType, UINT* pActiveCounters,
+        LPSTR szName, UINT* pNameLength, LPSTR szUnits, UINT* pUnitsLength, LPSTR szDescription, UINT* pDescriptionLength) = 0;
+    virtual HRESULT STDMETHODCALLTYPE CheckFeatureSupport(D3D11_FEATURE Feature, void* pFeatureSupportData, UINT FeatureSupportDataSize) = 0;
+    virtual HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID guid, UINT* pDataSize, void* pData) = 0;
+    virtual HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID guid, UINT DataSize, const void* pData) = 0;
+    virtual HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID guid, const IUnknown* pData) = 0;
+    virtual D3D_FEATURE_LEVEL STDMETHODCALLTYPE GetFeatureLevel() = 0;
+    virtual UINT STDMETHODCALLTYPE GetCreationFlags() = 0;
+    virtual HRESULT STDMETHODCALLTYPE GetDeviceRemovedReason() = 0;
+    virtual void STDMETHODCALLTYPE GetImmediateContext(ID3D11DeviceContext** ppImmediateContext) = 0;
+    virtual HRESULT STDMETHODCALLTYPE SetExceptionMode(UINT RaiseFlags) = 0;
+    virtual UINT STDMETHODCALLTYPE GetExceptionMode() = 0;
+};
@@ -0,0 +1,5 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+// DirectXTex.h includes this one; the D3D 11.1 additions aren't used.
+#pragma once
+#include "d3d11.h"
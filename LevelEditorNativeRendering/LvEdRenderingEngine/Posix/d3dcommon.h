@@ -0,0 +1,121 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    d3dcommon.h
+
+    The Direct3D types shared by D3D11 and the shader compiler, for the
+    POSIX build.
+****************************************************************************/
+#pragma once
+
+#include <windows.h>
+
+typedef enum D3D_DRIVER_TYPE
+{
+    D3D_DRIVER_TYPE_UNKNOWN     = 0,
+    D3D_DRIVER_TYPE_HARDWARE    = 1,
+    D3D_DRIVER_TYPE_REFERENCE   = 2,
+    D3D_DRIVER_TYPE_NULL        = 3,
+    D3D_DRIVER_TYPE_SOFTWARE    = 4,
+    D3D_DRIVER_TYPE_WARP        = 5,
+} D3D_DRIVER_TYPE;
+
+typedef enum D3D_FEATURE_LEVEL
+{
+    D3D_FEATURE_LEVEL_9_1   = 0x9100,
+    D3D_FEATURE_LEVEL_9_2   = 0x9200,
+    D3D_FEATURE_LEVEL_9_3   = 0x9300,
+    D3D_FEATURE_LEVEL_10_0  = 0xa000,
+    D3D_FEATURE_LEVEL_10_1  = 0xa100,
+    D3D_FEATURE_LEVEL_11_0  = 0xb000,
+} D3D_FEATURE_LEVEL;
+
+#define D3D_FL9_1_REQ_TEXTURE1D_U_DIMENSION     2048
+#define D3D_FL9_3_REQ_TEXTURE1D_U_DIMENSION     4096
+#define D3D_FL9_1_REQ_TEXTURE2D_U_OR_V_DIMENSION 2048
+#define D3D_FL9_3_REQ_TEXTURE2D_U_OR_V_DIMENSION 4096
+#define D3D_FL9_1_REQ_TEXTURECUBE_DIMENSION     512
+#define D3D_FL9_3_REQ_TEXTURECUBE_DIMENSION     4096
+#define D3D_FL9_1_REQ_TEXTURE3D_U_V_OR_W_DIMENSION 256
+
+typedef enum D3D_PRIMITIVE_TOPOLOGY
+{
+    D3D_PRIMITIVE_TOPOLOGY_UNDEFINED        = 0,
+    D3D_PRIMITIVE_TOPOLOGY_POINTLIST        = 1,
+    D3D_PRIMITIVE_TOPOLOGY_LINELIST         = 2,
+    D3D_PRIMITIVE_TOPOLOGY_LINESTRIP        = 3,
+    D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST     = 4,
+    D3D_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP    = 5,
+    D3D_PRIMITIVE_TOPOLOGY_LINELIST_ADJ     = 10,
+    D3D_PRIMITIVE_TOPOLOGY_LINESTRIP_ADJ    = 11,
+    D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST_ADJ = 12,
+    D3D_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP_ADJ = 13,
+    D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED      = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED,
+    D3D11_PRIMITIVE_TOPOLOGY_POINTLIST      = D3D_PRIMITIVE_TOPOLOGY_POINTLIST,
+    D3D11_PRIMITIVE_TOPOLOGY_LINELIST       = D3D_PRIMITIVE_TOPOLOGY_LINELIST,
+    D3D11_PRIMITIVE_TOPOLOGY_LINESTRIP      = D3D_PRIMITIVE_TOPOLOGY_LINESTRIP,
+    D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST   = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST,
+    D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP  = D3D_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP,
+    D3D11_PRIMITIVE_TOPOLOGY_LINELIST_ADJ   = D3D_PRIMITIVE_TOPOLOGY_LINELIST_ADJ,
+    D3D11_PRIMITIVE_TOPOLOGY_LINESTRIP_ADJ  = D3D_PRIMITIVE_TOPOLOGY_LINESTRIP_ADJ,
+    D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST_ADJ = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST_ADJ,
+    D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP_ADJ = D3D_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP_ADJ,
+} D3D_PRIMITIVE_TOPOLOGY;
+
+typedef enum D3D_SRV_DIMENSION
+{
+    D3D_SRV_DIMENSION_UNKNOWN           = 0,
+    D3D_SRV_DIMENSION_BUFFER            = 1,
+    D3D_SRV_DIMENSION_TEXTURE1D         = 2,
+    D3D_SRV_DIMENSION_TEXTURE1DARRAY    = 3,
+    D3D_SRV_DIMENSION_TEXTURE2D         = 4,
+    D3D_SRV_DIMENSION_TEXTURE2DARRAY    = 5,
+    D3D_SRV_DIMENSION_TEXTURE2DMS       = 6,
+    D3D_SRV_DIMENSION_TEXTURE2DMSARRAY  = 7,
+    D3D_SRV_DIMENSION_TEXTURE3D         = 8,
+    D3D_SRV_DIMENSION_TEXTURECUBE       = 9,
+    D3D_SRV_DIMENSION_TEXTURECUBEARRAY  = 10,
+    D3D_SRV_DIMENSION_BUFFEREX          = 11,
+    D3D11_SRV_DIMENSION_UNKNOWN         = D3D_SRV_DIMENSION_UNKNOWN,
+    D3D11_SRV_DIMENSION_BUFFER          = D3D_SRV_DIMENSION_BUFFER,
+    D3D11_SRV_DIMENSION_TEXTURE1D       = D3D_SRV_DIMENSION_TEXTURE1D,
+    D3D11_SRV_DIMENSION_TEXTURE1DARRAY  = D3D_SRV_DIMENSION_TEXTURE1DARRAY,
+    D3D11_SRV_DIMENSION_TEXTURE2D       = D3D_SRV_DIMENSION_TEXTURE2D,
+    D3D11_SRV_DIMENSION_TEXTURE2DARRAY  = D3D_SRV_DIMENSION_TEXTURE2DARRAY,
+    D3D11_SRV_DIMENSION_TEXTURE2DMS     = D3D_SRV_DIMENSION_TEXTURE2DMS,
+    D3D11_SRV_DIMENSION_TEXTURE2DMSARRAY = D3D_SRV_DIMENSION_TEXTURE2DMSARRAY,
+    D3D11_SRV_DIMENSION_TEXTURE3D       = D3D_SRV_DIMENSION_TEXTURE3D,
+    D3D11_SRV_DIMENSION_TEXTURECUBE     = D3D_SRV_DIMENSION_TEXTURECUBE,
+    D3D11_SRV_DIMENSION_TEXTURECUBEARRAY = D3D_SRV_DIMENSION_TEXTURECUBEARRAY,
+    D3D11_SRV_DIMENSION_BUFFEREX        = D3D_SRV_DIMENSION_BUFFEREX,
+} D3D_SRV_DIMENSION;
+
+// private data name for debug names, see ID3D11DeviceChild::SetPrivateData().
+static const GUID WKPDID_D3DDebugObjectName = { 0x429b8c22, 0x9188, 0x4b0c, { 0x87, 0x42, 0xac, 0xb0, 0xbf, 0x85, 0xc2, 0x00 } };
+
+typedef struct _D3D_SHADER_MACRO
+{
+    LPCSTR Name;
+    LPCSTR Definition;
+} D3D_SHADER_MACRO;
+
+struct ID3D10Blob : public IUnknown
+{
+    virtual LPVOID STDMETHODCALLTYPE GetBufferPointer() = 0;
+    virtual SIZE_T STDMETHODCALLTYPE GetBufferSize() = 0;
+};
+typedef ID3D10Blob ID3DBlob;
+
+typedef enum _D3D_INCLUDE_TYPE
+{
+    D3D_INCLUDE_LOCAL   = 0,
+    D3D_INCLUDE_SYSTEM  = 1,
+} D3D_INCLUDE_TYPE;
+
+struct ID3DInclude
+{
+    virtual HRESULT STDMETHODCALLTYPE Open(D3D_INCLUDE_TYPE IncludeType, LPCSTR pFileName, LPCVOID pParentData,
+        LPCVOID* ppData, UINT* pBytes) = 0;
+    virtual HRESULT STDMETHODCALLTYPE Close(LPCVOID pData) = 0;
+    virtual ~ID3DInclude() {}
+};
@@ -0,0 +1,34 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    dxgi.h
+
+    The DXGI types the engine's headers refer to, for the POSIX build.
+    There are no DXGI factories or swap chains there.
+****************************************************************************/
+#pragma once
+
+#include <windows.h>
+#include "dxgiformat.h"
+
+#define DXGI_ERROR_INVALID_CALL     ((HRESULT)0x887A0001)
+#define DXGI_ERROR_NOT_FOUND        ((HRESULT)0x887A0002)
+#define DXGI_ERROR_MORE_DATA        ((HRESULT)0x887A0003)
+#define DXGI_ERROR_UNSUPPORTED      ((HRESULT)0x887A0004)
+#define DXGI_ERROR_DEVICE_REMOVED   ((HRESULT)0x887A0005)
+
+#define DXGI_USAGE_SHADER_INPUT         0x00000010UL
+#define DXGI_USAGE_RENDER_TARGET_OUTPUT 0x00000020UL
+typedef UINT DXGI_USAGE;
+
+typedef struct DXGI_SAMPLE_DESC
+{
+    UINT Count;
+    UINT Quality;
+} DXGI_SAMPLE_DESC;
+
+// never created, only released.
+struct IDXGIFactory1 : public IUnknown {};
+struct IDXGIAdapter1 : public IUnknown {};
+struct IDXGIOutput : public IUnknown {};
+struct IDXGISwapChain : public IUnknown {};
@@ -0,0 +1,7 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+// the COM interfaces DirectXTex.h refers to, without the WIC codecs.
+#pragma once
+#include <windows.h>
+
+struct IPropertyBag2;
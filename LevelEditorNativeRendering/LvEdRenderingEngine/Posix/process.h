@@ -0,0 +1,5 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+// threads are created with CreateThread, see windows.h.
+#pragma once
+#include <windows.h>
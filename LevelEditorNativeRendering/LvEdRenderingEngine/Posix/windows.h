@@ -0,0 +1,531 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    windows.h
+
+    The part of the Win32 API used by the portable libraries of the engine,
+    for the CMake build on POSIX systems. This directory is only in the
+    include path of that build; the functions are in Win32Posix.cpp.
+    Wide strings are wchar_t, 32 bits here, and the wide printf functions
+    take %s for wide strings as they do on Windows.
+****************************************************************************/
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#include <wctype.h>
+#include <limits.h>
+#include <errno.h>
+#include <float.h>
+#include <pthread.h>
+#include <string>
+
+#include "Compiler.h"
+
+// ---------------------------------------------------------------------------
+// calling conventions and COM declarations.
+#define WINAPI
+#define APIENTRY
+#define CALLBACK
+#define STDMETHODCALLTYPE
+#define STDMETHOD(method)        virtual HRESULT STDMETHODCALLTYPE method
+#define STDMETHOD_(type, method) virtual type STDMETHODCALLTYPE method
+#define PURE = 0
+#define THIS_
+#define THIS void
+#define DECLSPEC_NOVTABLE
+// annotations
+#define _In_
+#define _In_opt_
+#define _In_z_
+#define _In_reads_(n)
+#define _In_reads_opt_(n)
+#define _In_reads_bytes_(n)
+#define _In_count_(n)
+#define _Out_
+#define _Out_opt_
+#define _Out_writes_(n)
+#define _Out_writes_opt_(n)
+#define _Out_writes_bytes_(n)
+#define _Outptr_
+#define _Outptr_opt_
+#define _Inout_
+#define _Inout_opt_
+#define _Use_decl_annotations_
+#define _Analysis_assume_(e)
+#define _TRUNCATE ((size_t)-1)
+#define _countof(a) (sizeof(a) / sizeof((a)[0]))
+#define ARRAYSIZE(a) _countof(a)
+#define UNREFERENCED_PARAMETER(p) (void)(p)
+
+// ---------------------------------------------------------------------------
+// types, with the Windows sizes: LONG and DWORD are 32 bits.
+typedef uint8_t         BYTE;
+typedef int             BOOL;
+typedef uint8_t         BOOLEAN;
+typedef char            CHAR;
+typedef wchar_t         WCHAR;
+typedef WCHAR           TCHAR;
+typedef int16_t         SHORT;
+typedef uint16_t        USHORT;
+typedef uint16_t        WORD;
+typedef int             INT;
+typedef unsigned int    UINT;
+typedef int32_t         LONG;
+typedef uint32_t        ULONG;
+typedef uint32_t        DWORD;
+typedef uint32_t        DWORD32;
+typedef uint64_t        DWORD64;
+typedef int8_t          INT8;
+typedef int16_t         INT16;
+typedef int32_t         INT32;
+typedef int64_t         INT64;
+typedef uint8_t         UINT8;
+typedef uint16_t        UINT16;
+typedef uint32_t        UINT32;
+typedef uint64_t        UINT64;
+typedef int64_t         LONGLONG;
+typedef uint64_t        ULONGLONG;
+typedef intptr_t        INT_PTR;
+typedef uintptr_t       UINT_PTR;
+typedef intptr_t        LONG_PTR;
+typedef uintptr_t       ULONG_PTR;
+typedef size_t          SIZE_T;
+typedef float           FLOAT;
+typedef int32_t         HRESULT;
+typedef void            VOID;
+typedef void*           PVOID;
+typedef void*           LPVOID;
+typedef const void*     LPCVOID;
+typedef char*           LPSTR;
+typedef const char*     LPCSTR;
+typedef WCHAR*          LPWSTR;
+typedef const WCHAR*    LPCWSTR;
+typedef WCHAR*          LPTSTR;
+typedef const WCHAR*    LPCTSTR;
+typedef BOOL*           LPBOOL;
+typedef DWORD*          LPDWORD;
+typedef unsigned char*  PUCHAR;
+typedef ULONG*          PULONG;
+typedef void*           HANDLE;
+typedef HANDLE          HMODULE;
+typedef HANDLE          HINSTANCE;
+typedef HANDLE          HWND;
+typedef HANDLE          HDC;
+typedef HANDLE          HMONITOR;
+typedef INT_PTR (WINAPI *FARPROC)();
+
+#ifndef TRUE
+#define TRUE  1
+#define FALSE 0
+#endif
+#define MAX_PATH 260
+#define MAXLONG  0x7fffffff
+#define INFINITE 0xFFFFFFFF
+#define INVALID_HANDLE_VALUE ((HANDLE)(intptr_t)-1)
+#define WAIT_OBJECT_0  0
+#define WAIT_TIMEOUT   258
+#define WAIT_FAILED    0xFFFFFFFF
+
+typedef union _LARGE_INTEGER
+{
+    struct
+    {
+        DWORD LowPart;
+        LONG  HighPart;
+    };
+    LONGLONG QuadPart;
+} LARGE_INTEGER;
+
+typedef struct tagRECT
+{
+    LONG left;
+    LONG top;
+    LONG right;
+    LONG bottom;
+} RECT;
+
+typedef struct tagPOINT
+{
+    LONG x;
+    LONG y;
+} POINT;
+
+typedef struct _SECURITY_ATTRIBUTES SECURITY_ATTRIBUTES, *LPSECURITY_ATTRIBUTES;
+
+// ---------------------------------------------------------------------------
+// HRESULT
+#define SUCCEEDED(hr) (((HRESULT)(hr)) >= 0)
+#define FAILED(hr)    (((HRESULT)(hr)) < 0)
+#define MAKE_HRESULT(sev, fac, code) ((HRESULT)(((uint32_t)(sev) << 31) | ((uint32_t)(fac) << 16) | ((uint32_t)(code))))
+#define HRESULT_FROM_WIN32(x) ((HRESULT)(x) <= 0 ? (HRESULT)(x) : (HRESULT)(((x) & 0x0000FFFF) | 0x80070000))
+#define S_OK            ((HRESULT)0)
+#define S_FALSE         ((HRESULT)1)
+#define E_NOTIMPL       ((HRESULT)0x80004001)
+#define E_NOINTERFACE   ((HRESULT)0x80004002)
+#define E_POINTER       ((HRESULT)0x80004003)
+#define E_ABORT         ((HRESULT)0x80004004)
+#define E_FAIL          ((HRESULT)0x80004005)
+#define E_UNEXPECTED    ((HRESULT)0x8000FFFF)
+#define E_ACCESSDENIED  ((HRESULT)0x80070005)
+#define E_HANDLE        ((HRESULT)0x80070006)
+#define E_OUTOFMEMORY   ((HRESULT)0x8007000E)
+#define E_INVALIDARG    ((HRESULT)0x80070057)
+
+#define ERROR_SUCCESS           0
+#define ERROR_FILE_NOT_FOUND    2
+#define ERROR_PATH_NOT_FOUND    3
+#define ERROR_ACCESS_DENIED     5
+#define ERROR_INVALID_HANDLE    6
+#define ERROR_NOT_ENOUGH_MEMORY 8
+#define ERROR_NO_MORE_FILES     18
+#define ERROR_HANDLE_EOF        38
+#define ERROR_NOT_SUPPORTED     50
+#define ERROR_INSUFFICIENT_BUFFER 122
+#define ERROR_ALREADY_EXISTS    183
+#define ERROR_ENVVAR_NOT_FOUND  203
+#define ERROR_TOO_MANY_POSTS    298
+#define ERROR_TIMEOUT           1460
+#ifndef STRUNCATE
+#define STRUNCATE               80
+#endif
+
+// ---------------------------------------------------------------------------
+// COM: GUIDs and IUnknown. __uuidof gives every interface its own GUID,
+// unique within the process.
+typedef struct _GUID
+{
+    uint32_t Data1;
+    uint16_t Data2;
+    uint16_t Data3;
+    uint8_t  Data4[8];
+} GUID;
+typedef GUID IID;
+typedef const GUID& REFGUID;
+typedef const IID&  REFIID;
+
+inline bool operator==(const GUID& a, const GUID& b) { return memcmp(&a, &b, sizeof(GUID)) == 0; }
+inline bool operator!=(const GUID& a, const GUID& b) { return !(a == b); }
+inline bool IsEqualGUID(REFGUID a, REFGUID b) { return a == b; }
+
+namespace Win32Posix
+{
+    uint32_t NextUuid();
+
+    // the POSIX path of a Win32 file name: backslashes become slashes,
+    // in the encoding of the locale. The file functions of the shim open this.
+    std::string NativePath(const wchar_t* name);
+
+    template<class T> inline const GUID& UuidOf()
+    {
+        static const GUID uuid = { NextUuid(), 0, 0, { 0 } };
+        return uuid;
+    }
+}
+#define __uuidof(T) Win32Posix::UuidOf<T>()
+
+struct IUnknown
+{
+    virtual HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppvObject) = 0;
+    virtual ULONG STDMETHODCALLTYPE AddRef() = 0;
+    virtual ULONG STDMETHODCALLTYPE Release() = 0;
+    virtual ~IUnknown() {}
+};
+
+// ---------------------------------------------------------------------------
+// memory
+#define CopyMemory(dst, src, size)  memcpy((dst), (src), (size))
+#define MoveMemory(dst, src, size)  memmove((dst), (src), (size))
+#define FillMemory(dst, size, fill) memset((dst), (fill), (size))
+#define ZeroMemory(dst, size)       memset((dst), 0, (size))
+inline void* SecureZeroMemory(void* dst, size_t size)
+{
+    volatile char* p = (volatile char*)dst;
+    while(size--)
+        *p++ = 0;
+    return dst;
+}
+inline void* _aligned_malloc(size_t size, size_t alignment)
+{
+    void* p = NULL;
+    if(alignment < sizeof(void*))
+        alignment = sizeof(void*);
+    return posix_memalign(&p, alignment, size) == 0 ? p : NULL;
+}
+inline void _aligned_free(void* p) { free(p); }
+inline int memcpy_s(void* dst, size_t dstSize, const void* src, size_t count)
+{
+    if(count > dstSize)
+        return ERANGE;
+    memcpy(dst, src, count);
+    return 0;
+}
+#define _alloca(size) __builtin_alloca(size)
+
+// ---------------------------------------------------------------------------
+// interlocked operations, all full barriers as on Windows.
+inline LONG InterlockedIncrement(volatile LONG* p) { return __sync_add_and_fetch(p, 1); }
+inline LONG InterlockedDecrement(volatile LONG* p) { return __sync_sub_and_fetch(p, 1); }
+inline LONG InterlockedExchange(volatile LONG* p, LONG v) { __sync_synchronize(); return __sync_lock_test_and_set(p, v); }
+inline LONG InterlockedExchangeAdd(volatile LONG* p, LONG v) { return __sync_fetch_and_add(p, v); }
+inline LONG InterlockedCompareExchange(volatile LONG* p, LONG exchange, LONG comparand) { return __sync_val_compare_and_swap(p, comparand, exchange); }
+inline LONGLONG InterlockedIncrement64(volatile LONGLONG* p) { return __sync_add_and_fetch(p, 1); }
+inline LONGLONG InterlockedDecrement64(volatile LONGLONG* p) { return __sync_sub_and_fetch(p, 1); }
+inline LONGLONG InterlockedExchange64(volatile LONGLONG* p, LONGLONG v) { __sync_synchronize(); return __sync_lock_test_and_set(p, v); }
+inline LONGLONG InterlockedExchangeAdd64(volatile LONGLONG* p, LONGLONG v) { return __sync_fetch_and_add(p, v); }
+inline LONGLONG InterlockedCompareExchange64(volatile LONGLONG* p, LONGLONG exchange, LONGLONG comparand) { return __sync_val_compare_and_swap(p, comparand, exchange); }
+inline void* InterlockedCompareExchangePointer(void* volatile* p, void* exchange, void* comparand) { return __sync_val_compare_and_swap(p, comparand, exchange); }
+inline void* InterlockedExchangePointer(void* volatile* p, void* v) { __sync_synchronize(); return __sync_lock_test_and_set(p, v); }
+inline void MemoryBarrier() { __sync_synchronize(); }
+#define _ReadWriteBarrier() __asm__ __volatile__("" ::: "memory")
+#define YieldProcessor() __builtin_ia32_pause()
+
+// ---------------------------------------------------------------------------
+// synchronization. Critical sections are recursive, like on Windows.
+typedef struct _CRITICAL_SECTION
+{
+    pthread_mutex_t mutex;
+} CRITICAL_SECTION, *LPCRITICAL_SECTION, RTL_CRITICAL_SECTION, *PRTL_CRITICAL_SECTION;
+
+void InitializeCriticalSection(CRITICAL_SECTION* cs);
+BOOL InitializeCriticalSectionAndSpinCount(CRITICAL_SECTION* cs, DWORD spinCount);
+void DeleteCriticalSection(CRITICAL_SECTION* cs);
+inline void EnterCriticalSection(CRITICAL_SECTION* cs) { pthread_mutex_lock(&cs->mutex); }
+inline void LeaveCriticalSection(CRITICAL_SECTION* cs) { pthread_mutex_unlock(&cs->mutex); }
+inline BOOL TryEnterCriticalSection(CRITICAL_SECTION* cs) { return pthread_mutex_trylock(&cs->mutex) == 0; }
+
+typedef struct _SRWLOCK
+{
+    pthread_rwlock_t lock;
+} SRWLOCK, *PSRWLOCK;
+#define SRWLOCK_INIT { PTHREAD_RWLOCK_INITIALIZER }
+inline void InitializeSRWLock(SRWLOCK* lock) { pthread_rwlock_init(&lock->lock, NULL); }
+inline void AcquireSRWLockExclusive(SRWLOCK* lock) { pthread_rwlock_wrlock(&lock->lock); }
+inline void ReleaseSRWLockExclusive(SRWLOCK* lock) { pthread_rwlock_unlock(&lock->lock); }
+inline void AcquireSRWLockShared(SRWLOCK* lock) { pthread_rwlock_rdlock(&lock->lock); }
+inline void ReleaseSRWLockShared(SRWLOCK* lock) { pthread_rwlock_unlock(&lock->lock); }
+
+typedef struct _CONDITION_VARIABLE
+{
+    pthread_cond_t cond;
+} CONDITION_VARIABLE, *PCONDITION_VARIABLE;
+#define CONDITION_VARIABLE_INIT { PTHREAD_COND_INITIALIZER }
+inline void InitializeConditionVariable(CONDITION_VARIABLE* cv) { pthread_cond_init(&cv->cond, NULL); }
+inline void WakeConditionVariable(CONDITION_VARIABLE* cv) { pthread_cond_signal(&cv->cond); }
+inline void WakeAllConditionVariable(CONDITION_VARIABLE* cv) { pthread_cond_broadcast(&cv->cond); }
+// the critical section must be entered once by the calling thread.
+BOOL SleepConditionVariableCS(CONDITION_VARIABLE* cv, CRITICAL_SECTION* cs, DWORD milliseconds);
+
+// threads, events and semaphores are HANDLEs closed with CloseHandle.
+typedef DWORD (WINAPI *LPTHREAD_START_ROUTINE)(LPVOID param);
+#define CREATE_SUSPENDED 0x00000004
+#define THREAD_PRIORITY_LOWEST          -2
+#define THREAD_PRIORITY_BELOW_NORMAL    -1
+#define THREAD_PRIORITY_NORMAL          0
+#define THREAD_PRIORITY_ABOVE_NORMAL    1
+#define THREAD_PRIORITY_HIGHEST         2
+
+HANDLE CreateThread(LPSECURITY_ATTRIBUTES attributes, SIZE_T stackSize, LPTHREAD_START_ROUTINE start,
+    LPVOID param, DWORD flags, LPDWORD threadId);
+BOOL SetThreadPriority(HANDLE thread, int priority);
+DWORD GetCurrentThreadId();
+HANDLE CreateEventW(LPSECURITY_ATTRIBUTES attributes, BOOL manualReset, BOOL initialState, LPCWSTR name);
+#define CreateEvent CreateEventW
+BOOL SetEvent(HANDLE event);
+BOOL ResetEvent(HANDLE event);
+HANDLE CreateSemaphoreW(LPSECURITY_ATTRIBUTES attributes, LONG initialCount, LONG maximumCount, LPCWSTR name);
+#define CreateSemaphore CreateSemaphoreW
+BOOL ReleaseSemaphore(HANDLE semaphore, LONG releaseCount, LONG* previousCount);
+DWORD WaitForSingleObject(HANDLE handle, DWORD milliseconds);
+DWORD WaitForMultipleObjects(DWORD count, const HANDLE* handles, BOOL waitAll, DWORD milliseconds);
+BOOL CloseHandle(HANDLE handle);
+void Sleep(DWORD milliseconds);
+BOOL SwitchToThread();
+
+// ---------------------------------------------------------------------------
+// time and system
+DWORD GetTickCount();
+ULONGLONG GetTickCount64();
+BOOL QueryPerformanceCounter(LARGE_INTEGER* count);
+BOOL QueryPerformanceFrequency(LARGE_INTEGER* frequency);
+
+typedef struct _SYSTEM_INFO
+{
+    DWORD dwPageSize;
+    DWORD dwNumberOfProcessors;
+    DWORD dwAllocationGranularity;
+} SYSTEM_INFO, *LPSYSTEM_INFO;
+void GetSystemInfo(SYSTEM_INFO* info);
+
+// there are no Windows modules, lookups always fail.
+inline HMODULE GetModuleHandleW(LPCWSTR name) { (void)name; return NULL; }
+inline FARPROC GetProcAddress(HMODULE module, LPCSTR name) { (void)module; (void)name; return NULL; }
+
+DWORD GetLastError();
+void SetLastError(DWORD error);
+void OutputDebugStringA(LPCSTR text);
+void OutputDebugStringW(LPCWSTR text);
+#define OutputDebugString OutputDebugStringW
+DWORD GetEnvironmentVariableW(LPCWSTR name, LPWSTR buffer, DWORD size);
+#define GetEnvironmentVariable GetEnvironmentVariableW
+
+#define FORMAT_MESSAGE_ALLOCATE_BUFFER  0x00000100
+#define FORMAT_MESSAGE_IGNORE_INSERTS   0x00000200
+#define FORMAT_MESSAGE_FROM_SYSTEM      0x00001000
+#define LANG_NEUTRAL    0x00
+#define SUBLANG_DEFAULT 0x01
+#define MAKELANGID(p, s) ((((WORD)(s)) << 10) | (WORD)(p))
+// FORMAT_MESSAGE_ALLOCATE_BUFFER only; the buffer is freed with LocalFree.
+DWORD FormatMessageW(DWORD flags, LPCVOID source, DWORD messageId, DWORD languageId, LPWSTR buffer, DWORD size, va_list* args);
+#define FormatMessage FormatMessageW
+HANDLE LocalFree(HANDLE mem);
+
+// there is no COM runtime; per-thread initialization always succeeds.
+#define COINIT_MULTITHREADED        0x0
+#define COINIT_APARTMENTTHREADED    0x2
+inline HRESULT CoInitializeEx(LPVOID reserved, DWORD coInit) { (void)reserved; (void)coInit; return S_OK; }
+inline void CoUninitialize() {}
+
+// ---------------------------------------------------------------------------
+// files. Paths are converted to the multibyte encoding, '\' and '/' both
+// separate directories.
+#define GENERIC_READ    0x80000000
+#define GENERIC_WRITE   0x40000000
+#define FILE_READ_DATA  0x00000001
+#define FILE_SHARE_READ     0x00000001
+#define FILE_SHARE_WRITE    0x00000002
+#define FILE_SHARE_DELETE   0x00000004
+#define CREATE_NEW          1
+#define CREATE_ALWAYS       2
+#define OPEN_EXISTING       3
+#define OPEN_ALWAYS         4
+#define TRUNCATE_EXISTING   5
+#define FILE_ATTRIBUTE_READONLY     0x00000001
+#define FILE_ATTRIBUTE_HIDDEN       0x00000002
+#define FILE_ATTRIBUTE_DIRECTORY    0x00000010
+#define FILE_ATTRIBUTE_NORMAL       0x00000080
+#define FILE_ATTRIBUTE_TEMPORARY    0x00000100
+#define FILE_FLAG_SEQUENTIAL_SCAN   0x08000000
+#define INVALID_FILE_ATTRIBUTES     ((DWORD)-1)
+#define FILE_BEGIN      0
+#define FILE_CURRENT    1
+#define FILE_END        2
+#define MOVEFILE_REPLACE_EXISTING   0x00000001
+#define MOVEFILE_COPY_ALLOWED       0x00000002
+#define MOVEFILE_WRITE_THROUGH      0x00000008
+
+typedef struct _FILETIME
+{
+    DWORD dwLowDateTime;
+    DWORD dwHighDateTime;
+} FILETIME;
+
+typedef struct _WIN32_FIND_DATAW
+{
+    DWORD    dwFileAttributes;
+    FILETIME ftCreationTime;
+    FILETIME ftLastAccessTime;
+    FILETIME ftLastWriteTime;
+    DWORD    nFileSizeHigh;
+    DWORD    nFileSizeLow;
+    WCHAR    cFileName[MAX_PATH];
+} WIN32_FIND_DATAW;
+
+HANDLE CreateFileW(LPCWSTR name, DWORD access, DWORD shareMode, LPSECURITY_ATTRIBUTES attributes,
+    DWORD creation, DWORD flags, HANDLE templateFile);
+#define CreateFile CreateFileW
+BOOL ReadFile(HANDLE file, LPVOID buffer, DWORD size, LPDWORD read, void* overlapped);
+BOOL WriteFile(HANDLE file, LPCVOID buffer, DWORD size, LPDWORD written, void* overlapped);
+BOOL GetFileSizeEx(HANDLE file, LARGE_INTEGER* size);
+BOOL SetFilePointerEx(HANDLE file, LARGE_INTEGER distance, LARGE_INTEGER* newPosition, DWORD method);
+BOOL FlushFileBuffers(HANDLE file);
+BOOL DeleteFileW(LPCWSTR name);
+#define DeleteFile DeleteFileW
+BOOL MoveFileExW(LPCWSTR existing, LPCWSTR newName, DWORD flags);
+#define MoveFileEx MoveFileExW
+BOOL CreateDirectoryW(LPCWSTR name, LPSECURITY_ATTRIBUTES attributes);
+#define CreateDirectory CreateDirectoryW
+DWORD GetFileAttributesW(LPCWSTR name);
+#define GetFileAttributes GetFileAttributesW
+// the directory part is resolved, the file doesn't have to exist.
+DWORD GetFullPathNameW(LPCWSTR name, DWORD size, LPWSTR buffer, LPWSTR* filePart);
+#define GetFullPathName GetFullPathNameW
+// only "dir\*" patterns.
+HANDLE FindFirstFileW(LPCWSTR pattern, WIN32_FIND_DATAW* data);
+BOOL FindNextFileW(HANDLE find, WIN32_FIND_DATAW* data);
+BOOL FindClose(HANDLE find);
+
+// ---------------------------------------------------------------------------
+// strings. The multibyte code page is the C locale's, CP_UTF8 is UTF-8.
+#define CP_ACP  0
+#define CP_UTF8 65001
+int MultiByteToWideChar(UINT codePage, DWORD flags, LPCSTR str, int size, LPWSTR wstr, int wsize);
+int WideCharToMultiByte(UINT codePage, DWORD flags, LPCWSTR wstr, int wsize, LPSTR str, int size,
+    LPCSTR defaultChar, LPBOOL usedDefaultChar);
+
+inline int lstrlenA(LPCSTR str) { return str ? (int)strlen(str) : 0; }
+inline int lstrlenW(LPCWSTR str) { return str ? (int)wcslen(str) : 0; }
+inline int _stricmp(const char* a, const char* b) { return strcasecmp(a, b); }
+inline int _strnicmp(const char* a, const char* b, size_t n) { return strncasecmp(a, b, n); }
+int _wcsicmp(const wchar_t* a, const wchar_t* b);
+int _wcsnicmp(const wchar_t* a, const wchar_t* b, size_t n);
+wchar_t* _wcslwr_s(wchar_t* str, size_t size);
+int _wtoi(const wchar_t* str);
+double _wtof(const wchar_t* str);
+
+int strcpy_s(char* dst, size_t size, const char* src);
+int strncpy_s(char* dst, size_t size, const char* src, size_t count);
+int strcat_s(char* dst, size_t size, const char* src);
+int wcscpy_s(wchar_t* dst, size_t size, const wchar_t* src);
+int wcsncpy_s(wchar_t* dst, size_t size, const wchar_t* src, size_t count);
+int wcscat_s(wchar_t* dst, size_t size, const wchar_t* src);
+template<size_t N> inline int strcpy_s(char (&dst)[N], const char* src) { return strcpy_s(dst, N, src); }
+template<size_t N> inline int strcat_s(char (&dst)[N], const char* src) { return strcat_s(dst, N, src); }
+template<size_t N> inline int wcscpy_s(wchar_t (&dst)[N], const wchar_t* src) { return wcscpy_s(dst, N, src); }
+template<size_t N> inline int wcscat_s(wchar_t (&dst)[N], const wchar_t* src) { return wcscat_s(dst, N, src); }
+template<size_t N> inline int strncpy_s(char (&dst)[N], const char* src, size_t count) { return strncpy_s(dst, N, src, count); }
+template<size_t N> inline int wcsncpy_s(wchar_t (&dst)[N], const wchar_t* src, size_t count) { return wcsncpy_s(dst, N, src, count); }
+
+// printf family. count _TRUNCATE truncates instead of failing.
+int _vsnprintf_s(char* buffer, size_t size, size_t count, const char* format, va_list args);
+int vsprintf_s(char* buffer, size_t size, const char* format, va_list args);
+int sprintf_s(char* buffer, size_t size, const char* format, ...);
+int _snprintf_s(char* buffer, size_t size, size_t count, const char* format, ...);
+int _vscprintf(const char* format, va_list args);
+int _vsnwprintf_s(wchar_t* buffer, size_t size, size_t count, const wchar_t* format, va_list args);
+int vswprintf_s(wchar_t* buffer, size_t size, const wchar_t* format, va_list args);
+int swprintf_s(wchar_t* buffer, size_t size, const wchar_t* format, ...);
+int _snwprintf_s(wchar_t* buffer, size_t size, size_t count, const wchar_t* format, ...);
+int _vscwprintf(const wchar_t* format, va_list args);
+int Win32Posix_wprintf(const wchar_t* format, ...);
+#define wprintf Win32Posix_wprintf
+
+template<size_t N> inline int sprintf_s(char (&buffer)[N], const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int result = vsprintf_s(buffer, N, format, args);
+    va_end(args);
+    return result;
+}
+template<size_t N> inline int swprintf_s(wchar_t (&buffer)[N], const wchar_t* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int result = vswprintf_s(buffer, N, format, args);
+    va_end(args);
+    return result;
+}
+template<size_t N> inline int vsprintf_s(char (&buffer)[N], const char* format, va_list args)
+{
+    return vsprintf_s(buffer, N, format, args);
+}
+template<size_t N> inline int vswprintf_s(wchar_t (&buffer)[N], const wchar_t* format, va_list args)
+{
+    return vswprintf_s(buffer, N, format, args);
+}
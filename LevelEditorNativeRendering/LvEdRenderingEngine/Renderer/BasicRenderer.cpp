@@ -3,14 +3,18 @@
 
 //#include <D3Dcompiler.h>
 #include <d3d11.h>
+#include <algorithm>
 #include "BasicRenderer.h"
 #include "RenderBuffer.h"
 #include "GpuResourceFactory.h"
 #include "RenderState.h"
 #include "Texture.h"
 #include "RenderUtil.h"
+#include "EngineShaders.h"
 #include "../Core/Logger.h"
 #include "RenderSurface.h"
+#include "GizmoBatch.h"
+#include "TransientBuffer.h"
 
 using namespace LvEdEngine;
 
@@ -207,6 +211,131 @@
    
  }
 
+bool BasicRenderer::DrawItemSorting(const BasicDrawItem* a, const BasicDrawItem* b)
+{
+    if(a->primitiveType != b->primitiveType)
+        return a->primitiveType < b->primitiveType;
+    if(a->vb != b->vb)
+        return a->vb < b->vb;
+    if(a->ib != b->ib)
+        return a->ib < b->ib;
+    if(a->start != b->start)
+        return a->start < b->start;
+    if(a->count != b->count)
+        return a->count < b->count;
+    if(a->startVertex != b->startVertex)
+        return a->startVertex < b->startVertex;
+    return a < b;
+}
+
+void BasicRenderer::DrawBatch(const BasicDrawItem* items, uint32_t count)
+{
+    if(!m_context || !items || count == 0) return;
+
+    m_batchItems.resize(count);
+    for(uint32_t i = 0; i < count; ++i)
+        m_batchItems[i] = items + i;
+
+    // without depth test the order of the draws is visible.
+    if(!(m_renderFlags & BasicRendererFlags::DisableDepthTest))
+        std::sort(m_batchItems.begin(), m_batchItems.end(), DrawItemSorting);
+
+    // lit and specular are the same for the whole batch.
+    m_cbPerDraw.Data.lit = (m_renderFlags & BasicRendererFlags::Lit) != 0;
+    m_cbPerDraw.Data.specular = float4(0.0f,0.0f,0.0f,1.0f);
+    m_cbPerDraw.Update(m_context);
+
+    m_context->VSSetShader(m_pVertexShaderBatch,NULL,0);
+    m_context->PSSetShader(m_pPixelShaderBatch,NULL,0);
+    m_context->IASetInputLayout(m_pVertexLayoutBatch);
+
+    TransientBuffer* transient = TransientBuffer::Inst();
+    uint32_t maxCount = transient->GetMaxCount(sizeof(GizmoInstance));
+    const BasicDrawItem* prev = NULL;
+    uint32_t next = 0;
+    while(next < count)
+    {
+        uint32_t chunk = count - next;
+        if(chunk > maxCount)
+            chunk = maxCount;
+
+        TransientAlloc alloc;
+        if(chunk == 0 || !transient->Map(m_context, sizeof(GizmoInstance), chunk, &alloc))
+            break;
+
+        // world matrix as columns and the color, see GizmoInstance.
+        GizmoInstance* instances = (GizmoInstance*)alloc.data;
+        for(uint32_t i = 0; i < chunk; ++i)
+        {
+            const BasicDrawItem* item = m_batchItems[next + i];
+            const float* m = item->xform;
+            GizmoInstance& inst = instances[i];
+            inst.world[0] = float4(m[0], m[4], m[8],  m[12]);
+            inst.world[1] = float4(m[1], m[5], m[9],  m[13]);
+            inst.world[2] = float4(m[2], m[6], m[10], m[14]);
+            inst.uvXform[0] = float4(0,0,0,0);
+            inst.uvXform[1] = float4(0,0,0,0);
+            inst.color = float4(item->color[0], item->color[1], item->color[2], item->color[3]);
+        }
+        transient->Unmap(m_context);
+
+        UINT instanceStride = sizeof(GizmoInstance);
+        UINT instanceOffset = 0;
+        m_context->IASetVertexBuffers(1, 1, &alloc.buffer, &instanceStride, &instanceOffset);
+
+        uint32_t i = 0;
+        while(i < chunk)
+        {
+            const BasicDrawItem* item = m_batchItems[next + i];
+
+            // neighbouring draws of the same range are instances of one draw.
+            uint32_t instanceCount = 1;
+            while(i + instanceCount < chunk)
+            {
+                const BasicDrawItem* other = m_batchItems[next + i + instanceCount];
+                if(other->primitiveType != item->primitiveType || other->vb != item->vb || other->ib != item->ib
+                    || other->start != item->start || other->count != item->count || other->startVertex != item->startVertex)
+                    break;
+                instanceCount++;
+            }
+
+            if(!prev || prev->primitiveType != item->primitiveType)
+                m_context->IASetPrimitiveTopology( (D3D11_PRIMITIVE_TOPOLOGY)item->primitiveType );
+            if(!prev || prev->vb != item->vb)
+            {
+                VertexBuffer* vb = reinterpret_cast<VertexBuffer*>(item->vb);
+                UINT stride = vb->GetStride();
+                UINT offset = 0;
+                ID3D11Buffer* buffer = vb->GetBuffer();
+                m_context->IASetVertexBuffers( 0, 1, &buffer, &stride, &offset );
+            }
+            if(item->ib && (!prev || prev->ib != item->ib))
+            {
+                IndexBuffer* ib = reinterpret_cast<IndexBuffer*>(item->ib);
+                m_context->IASetIndexBuffer(ib->GetBuffer(),(DXGI_FORMAT)ib->GetFormat(),0);
+            }
+
+            uint32_t startInstance = alloc.firstVertex + i;
+            if(item->ib)
+                m_context->DrawIndexedInstanced(item->count, instanceCount, item->start, item->startVertex, startInstance);
+            else
+                m_context->DrawInstanced(item->count, instanceCount, item->start, startInstance);
+
+            prev = item;
+            i += instanceCount;
+        }
+        next += chunk;
+    }
+
+    // the instance stream is only valid for this batch.
+    ID3D11Buffer* nullBuffer = NULL;
+    UINT zero = 0;
+    m_context->IASetVertexBuffers(1, 1, &nullBuffer, &zero, &zero);
+
+    m_context->VSSetShader(m_pVertexShaderP,NULL,0);
+    m_context->PSSetShader(m_pPixelShaderP,NULL,0);
+    m_context->IASetInputLayout( m_pVertexLayout );
+}
 
 ObjectGUID BasicRenderer::CreateVertexBuffer(VertexFormatEnum vf, void* buffer, uint32_t vertexCount)
 {    
@@ -241,7 +370,7 @@
     m_cbPerDraw.Construct(device);
 
 	// Compile the vertex shader
-    ID3DBlob* pVSBlob = CompileShaderFromResource(L"BasicRenderer.hlsl", "VS", "vs_4_0", NULL);
+    ID3DBlob* pVSBlob = EngineShader::Compile(EngineShader::BasicRendererVS);
     
     // Create the vertex shader
     m_pVertexShaderP = GpuResourceFactory::CreateVertexShader(pVSBlob);
@@ -254,11 +383,22 @@
     
     
     // Compile the pixel shader
-    ID3DBlob* pPSBlob = CompileShaderFromResource(L"BasicRenderer.hlsl", "PS", "ps_4_0", NULL);
+    ID3DBlob* pPSBlob = EngineShader::Compile(EngineShader::BasicRendererPS);
     // Create the pixel shader
     m_pPixelShaderP = GpuResourceFactory::CreatePixelShader(pPSBlob);    
     pPSBlob->Release();      
 
+    // instanced shaders of DrawBatch().
+    pVSBlob = EngineShader::Compile(EngineShader::BasicRendererBatchVS);
+    m_pVertexShaderBatch = GpuResourceFactory::CreateVertexShader(pVSBlob);
+    m_pVertexLayoutBatch = GpuResourceFactory::CreateInputLayout(pVSBlob,VertexFormat::VF_PN,true);
+    assert(m_pVertexShaderBatch && m_pVertexLayoutBatch);
+    pVSBlob->Release();
+
+    pPSBlob = EngineShader::Compile(EngineShader::BasicRendererBatchPS);
+    m_pPixelShaderBatch = GpuResourceFactory::CreatePixelShader(pPSBlob);
+    pPSBlob->Release();
+
 }
 
 BasicRenderer::~BasicRenderer()
@@ -266,4 +406,7 @@
     SAFE_RELEASE(m_pVertexShaderP);
     SAFE_RELEASE(m_pPixelShaderP);
     SAFE_RELEASE(m_pVertexLayout);    
+    SAFE_RELEASE(m_pVertexShaderBatch);
+    SAFE_RELEASE(m_pPixelShaderBatch);
+    SAFE_RELEASE(m_pVertexLayoutBatch);
 }
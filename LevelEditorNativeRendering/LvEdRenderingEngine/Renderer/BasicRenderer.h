@@ -4,6 +4,7 @@
 #include "../Core/WinHeaders.h"
 #include "../Core/typedefs.h"
 #include "../Core/NonCopyable.h"
+#include "../Core/FrameArena.h"
 #include "../VectorMath/V3dMath.h"
 #include "RenderEnums.h"
 #include "Lights.h"
@@ -13,6 +14,20 @@ namespace LvEdEngine
 {
     class RenderSurface;
 
+// one draw of BasicRenderer::DrawBatch(),
+// the layout is shared with the DrawBatchItem struct of GameEngine.cs.
+struct BasicDrawItem
+{
+    ObjectGUID vb;
+    ObjectGUID ib;              // 0 for a non indexed draw.
+    int32_t    primitiveType;   // PrimitiveTypeEnum
+    uint32_t   start;           // first index, or first vertex when ib is 0.
+    uint32_t   count;           // number of indices or vertices.
+    uint32_t   startVertex;     // base vertex of an indexed draw.
+    float      color[4];
+    float      xform[16];
+};
+
 // Basic renderer,
 // used for simple rendering.
 // this class is internal to this DLL.
@@ -50,6 +65,12 @@ class BasicRenderer : public NonCopyable
                                 uint32_t startVertex,                        
                                 float* color,
                                 float* xform);
+
+    // Draws many primitives with the current renderer flags.
+    // The draws are sorted by topology and buffers, unless depth test is
+    // disabled, and the transforms and colors go to one instance stream,
+    // so a run of draws of the same range is a single instanced draw.
+    void DrawBatch(const BasicDrawItem* items, uint32_t count);
                                 
    
     // delete vertex or index buffer.
@@ -57,6 +78,7 @@ class BasicRenderer : public NonCopyable
 private:	    
     
     void UpdateCbPerDraw(const Matrix& xform, const float4& color); // update constant buffer per draw
+    static bool DrawItemSorting(const BasicDrawItem* a, const BasicDrawItem* b);
     bool m_clearForegroundDepthBuffer;
     bool m_primaryDepthBufferActive;
     void SetDepthBuffer(ID3D11DepthStencilView* dv);
@@ -66,6 +88,9 @@ class BasicRenderer : public NonCopyable
 	ID3D11VertexShader*     m_pVertexShaderP;
 	ID3D11PixelShader*      m_pPixelShaderP;
 	ID3D11InputLayout*      m_pVertexLayout;
+	ID3D11VertexShader*     m_pVertexShaderBatch;
+	ID3D11PixelShader*      m_pPixelShaderBatch;
+	ID3D11InputLayout*      m_pVertexLayoutBatch;
     
 	ID3D11DeviceContext* m_context;
     RenderSurface* m_surface;
@@ -90,6 +115,8 @@ struct ConstantBufferPerDraw
 
     TConstantBuffer<ConstantBufferPerFrame>  m_cbPerFrame;
 	TConstantBuffer<ConstantBufferPerDraw>   m_cbPerDraw;
+
+    FrameVector<const BasicDrawItem*> m_batchItems; // DrawBatch() order.
  };
 
 }
@@ -1,15 +1,17 @@
 //Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
 
 #include "BasicShader.h"
-#include <D3D11.h>
+#include <d3d11.h>
 #include "Renderable.h"
 #include "RenderBuffer.h"
 #include "RenderUtil.h"
+#include "EngineShaders.h"
 #include "../Core/Utils.h"
 #include "RenderContext.h"
 #include "RenderState.h"
 #include "Model.h"
 #include "GpuResourceFactory.h"
+#include "TransientBuffer.h"
 
 using namespace LvEdEngine;
 
@@ -26,11 +28,8 @@
     
     // set cbuffers
     ID3D11Buffer* nativePerFrameBuffer[] = {m_cbPerFrame.GetBuffer()};
-    ID3D11Buffer* nativePerObjectBuffer[] = {m_cbPerObject.GetBuffer()};
     d3dcontext->VSSetConstantBuffers(0,1,nativePerFrameBuffer);
     d3dcontext->PSSetConstantBuffers(0,1,nativePerFrameBuffer);	    
-    d3dcontext->VSSetConstantBuffers(1,1,nativePerObjectBuffer);
-	d3dcontext->PSSetConstantBuffers(1,1,nativePerObjectBuffer);	
     
 	// set vs, ps and layout.
 	d3dcontext->VSSetShader(m_vsShader,NULL,0);
@@ -55,59 +54,71 @@
 }
 
 // ------------------------------------------------------------------------------------------------
-void BasicShader::DrawNodes(const RenderNodeList& renderNodes)
+void BasicShader::DrawNodes(const FrameNodeList& renderNodes)
 {
     ID3D11DeviceContext* d3dContext = m_rc->Context();
-    
-    for ( auto it = renderNodes.begin(); it != renderNodes.end(); ++it )
+
+    // one instanced draw per mesh, control points share theirs.
+    bool keepOrder = (m_renderFlags & RenderFlags::AlphaBlend) != 0; // sorted back to front.
+    m_batch.Begin(renderNodes, false, NULL, keepOrder);
+    while(m_batch.Next(d3dContext))
     {
-        const RenderableNode& r = (*it);
-        
-        Matrix::Transpose(r.WorldXform,m_cbPerObject.Data.worldXform);
-        m_cbPerObject.Data.color = r.diffuse;        
-        m_cbPerObject.Update(d3dContext);
-        
-        uint32_t stride = r.mesh->vertexBuffer->GetStride();
-        uint32_t offset = 0;    
-        uint32_t startVertex = 0;
-        ID3D11Buffer* d3dvb  = r.mesh->vertexBuffer->GetBuffer();
-        d3dContext->IASetPrimitiveTopology( (D3D11_PRIMITIVE_TOPOLOGY)r.mesh->primitiveType );
-        
-        d3dContext->IASetVertexBuffers( 0, 1, &d3dvb, &stride, &offset );
-
-        if(r.mesh->indexBuffer)
+        ID3D11Buffer* instanceBuffer = m_batch.GetInstanceBuffer();
+        uint32_t instanceStride = sizeof(GizmoInstance);
+        uint32_t instanceOffset = 0;
+        d3dContext->IASetVertexBuffers( 1, 1, &instanceBuffer, &instanceStride, &instanceOffset );
+
+        for(uint32_t i = 0; i < m_batch.GetRunCount(); ++i)
         {
-            uint32_t startIndex  = 0;
-            uint32_t indexCount  = r.mesh->indexBuffer->GetCount();
-            IndexBuffer* d3dib  = r.mesh->indexBuffer;
-            d3dContext->IASetIndexBuffer(d3dib->GetBuffer(),(DXGI_FORMAT)d3dib->GetFormat(),0);    
-            d3dContext->DrawIndexed(indexCount,startIndex,startVertex);
+            const GizmoBatch::Run& run = m_batch.GetRun(i);
+            const Mesh* mesh = run.node->mesh;
+
+            uint32_t stride = mesh->vertexBuffer->GetStride();
+            uint32_t offset = 0;    
+            uint32_t startVertex = 0;
+            ID3D11Buffer* d3dvb  = mesh->vertexBuffer->GetBuffer();
+            d3dContext->IASetPrimitiveTopology( (D3D11_PRIMITIVE_TOPOLOGY)mesh->primitiveType );
+            
+            d3dContext->IASetVertexBuffers( 0, 1, &d3dvb, &stride, &offset );
+
+            if(mesh->indexBuffer)
+            {
+                uint32_t startIndex  = 0;
+                uint32_t indexCount  = mesh->indexBuffer->GetCount();
+                IndexBuffer* d3dib  = mesh->indexBuffer;
+                d3dContext->IASetIndexBuffer(d3dib->GetBuffer(),(DXGI_FORMAT)d3dib->GetFormat(),0);    
+                d3dContext->DrawIndexedInstanced(indexCount,run.instanceCount,startIndex,startVertex,run.startInstance);
+            }
+            else
+            {
+                d3dContext->DrawInstanced(mesh->vertexBuffer->GetCount(),run.instanceCount,startVertex,run.startInstance);
+            }        
         }
-        else
-        {
-            d3dContext->Draw(r.mesh->vertexBuffer->GetCount(),startVertex);
-        }        
     }
+
+    // the instance stream is only valid for this draw.
+    ID3D11Buffer* nullBuffer = NULL;
+    uint32_t zero = 0;
+    d3dContext->IASetVertexBuffers( 1, 1, &nullBuffer, &zero, &zero );
 }
 
 // ------------------------------------------------------------------------------------------------
 BasicShader::BasicShader(ID3D11Device* device)
-    : Shader( Shaders::BasicShader )
+    : Shader( Shaders::BasicShader ), m_renderFlags(RenderFlags::None)
 {
     // create cbuffers.
     m_cbPerFrame.Construct(device);
-    m_cbPerObject.Construct(device);
 
     // compile shaders
-    ID3DBlob* vsBlob = CompileShaderFromResource(L"BasicShader.hlsl", "VS","vs_4_0", NULL);    
-    ID3DBlob* psBlob = CompileShaderFromResource(L"BasicShader.hlsl", "PS","ps_4_0", NULL);
+    ID3DBlob* vsBlob = EngineShader::Compile(EngineShader::BasicShaderVS);    
+    ID3DBlob* psBlob = EngineShader::Compile(EngineShader::BasicShaderPS);
     assert(vsBlob && psBlob);
     m_vsShader = GpuResourceFactory::CreateVertexShader(vsBlob);     
     m_psShader = GpuResourceFactory::CreatePixelShader(psBlob);
     assert(m_vsShader && m_psShader);
     
     // create input layout
-    m_vertexLayout = GpuResourceFactory::CreateInputLayout(vsBlob, VertexFormat::VF_P);
+    m_vertexLayout = GpuResourceFactory::CreateInputLayout(vsBlob, VertexFormat::VF_P, true);
     assert(m_vertexLayout);
 
     // release the blobs
@@ -127,6 +138,7 @@
 void BasicShader::SetRenderFlag(RenderFlagsEnum rf)
 {
     ID3D11DeviceContext*  d3dcontext = m_rc->Context();
+    m_renderFlags = rf;
 
     // set blend state 
     auto blendState = RSCache::Inst()->GetBlendState(rf);
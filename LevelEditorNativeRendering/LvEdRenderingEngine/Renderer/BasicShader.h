@@ -8,6 +8,7 @@
 #include "RenderEnums.h"
 #include "Renderable.h"
 #include "RenderBuffer.h"
+#include "GizmoBatch.h"
 
 
 
@@ -22,7 +23,7 @@ class BasicShader : public Shader
         virtual void Begin(RenderContext* rc);
         virtual void End();
         virtual void SetRenderFlag(RenderFlagsEnum rf);
-        virtual void DrawNodes(const RenderNodeList& renderNodes);
+        virtual void DrawNodes(const FrameNodeList& renderNodes);
 
 
     private:
@@ -32,13 +33,9 @@ struct BasicCbPerFrame
             Matrix projXform;   
         };
 
-        struct BasicCbPerObject
-        {
-            Matrix worldXform; 
-            float4 color;
-        };
         TConstantBuffer<BasicCbPerFrame> m_cbPerFrame;
-        TConstantBuffer<BasicCbPerObject> m_cbPerObject;        
+        GizmoBatch             m_batch;
+        RenderFlagsEnum        m_renderFlags;
         ID3D11VertexShader*    m_vsShader;
         ID3D11PixelShader*     m_psShader;
         ID3D11InputLayout*     m_vertexLayout;
@@ -7,6 +7,7 @@
 #include "RenderContext.h"
 #include "RenderState.h"
 #include "RenderUtil.h"
+#include "EngineShaders.h"
 #include "Lights.h"
 #include "Model.h"
 #include "TextureLib.h"
@@ -29,18 +30,17 @@ namespace LvEdEngine
 {
     assert(device);
     m_cbPerFrame.Construct(device);
-    m_cbPerDraw.Construct(device);
     
     // create shaders
-    ID3DBlob* pVSBlob = CompileShaderFromResource(L"Billboard.hlsl", "VSMain","vs_4_0", NULL);
-    ID3DBlob* pPSBlob = CompileShaderFromResource(L"Billboard.hlsl", "PSMain","ps_4_0", NULL);
+    ID3DBlob* pVSBlob = EngineShader::Compile(EngineShader::BillboardVS);
+    ID3DBlob* pPSBlob = EngineShader::Compile(EngineShader::BillboardPS);
     assert(pVSBlob && pPSBlob);
         
     m_vertexShader = GpuResourceFactory::CreateVertexShader(pVSBlob);
     m_pixelShader  =  GpuResourceFactory::CreatePixelShader(pPSBlob);
     assert(m_vertexShader && m_pixelShader);
     
-    m_vertexLayout = GpuResourceFactory::CreateInputLayout(pVSBlob, VertexFormat::VF_PNTT);
+    m_vertexLayout = GpuResourceFactory::CreateInputLayout(pVSBlob, VertexFormat::VF_PNTT, true);
     assert(m_vertexLayout);
 
     // release blob memory
@@ -93,11 +93,8 @@ namespace LvEdEngine
 
     // set per call buffer.
     auto perframeCb = m_cbPerFrame.GetBuffer();
-    auto perDrawCb = m_cbPerDraw.GetBuffer();
     dc->VSSetConstantBuffers(0,1,&perframeCb);
     dc->PSSetConstantBuffers(0,1,&perframeCb);
-    dc->VSSetConstantBuffers(1,1,&perDrawCb);
-    dc->PSSetConstantBuffers(1,1,&perDrawCb);
 
 
     // set vs, ps and layout.
@@ -117,52 +114,46 @@ namespace LvEdEngine
 }
 
 // --------------------------------------------------------------------------------------------------
-void BillboardShader::DrawNodes(const RenderNodeList& renderNodes)
-{
-    for(auto it = renderNodes.begin(); it != renderNodes.end(); it++)
-    {
-        const RenderableNode& renderable = (*it);
-        Draw( renderable );
-    }
-}
-
-// --------------------------------------------------------------------------------------------------
-void BillboardShader::Draw(const RenderableNode& r)
+void BillboardShader::DrawNodes(const FrameNodeList& renderNodes)
 {
     ID3D11DeviceContext* dc = m_rc->Context();
 
-    // verify lighting
-    assert(r.lighting.numDirLights <= MAX_DIR_LIGHTS);
-    assert(r.lighting.numBoxLights <= MAX_BOX_LIGHTS);
-    assert(r.lighting.numPointLights <= MAX_POINT_LIGHTS);
-
-    Matrix::Transpose(r.WorldXform,m_cbPerDraw.Data.worldXform);
-    Matrix::Transpose(r.TextureXForm, m_cbPerDraw.Data.textureXForm);
-    m_cbPerDraw.Data.color = r.diffuse;
-    m_cbPerDraw.Update(dc);
-    
-    ID3D11ShaderResourceView* diffuseMap[1] = {NULL};    
-    if( (m_renderFlags & RenderFlags::Textured) && r.textures[TextureType::DIFFUSE])
+    bool textured = (m_renderFlags & RenderFlags::Textured) != 0;
+    bool keepOrder = (m_renderFlags & RenderFlags::AlphaBlend) != 0; // sorted back to front.
+    m_batch.Begin(renderNodes, textured, TextureLib::Inst()->GetWhite(), keepOrder);
+    while(m_batch.Next(dc))
     {
-        diffuseMap[0] = r.textures[TextureType::DIFFUSE]->GetView();
+        ID3D11Buffer* instanceBuffer = m_batch.GetInstanceBuffer();
+        uint32_t instanceStride = sizeof(GizmoInstance);
+        uint32_t instanceOffset = 0;
+        dc->IASetVertexBuffers( 1, 1, &instanceBuffer, &instanceStride, &instanceOffset );
+
+        for(uint32_t i = 0; i < m_batch.GetRunCount(); ++i)
+        {
+            const GizmoBatch::Run& run = m_batch.GetRun(i);
+            const Mesh* mesh = run.node->mesh;
+
+            run.texture->RequestMip(0);
+            ID3D11ShaderResourceView* diffuseMap[1] = { run.texture->GetView() };
+            dc->PSSetShaderResources( 0, 1, diffuseMap );
+
+            uint32_t stride = mesh->vertexBuffer->GetStride();
+            uint32_t offset = 0;    
+            uint32_t indexCount = mesh->indexBuffer->GetCount();
+            ID3D11Buffer* d3dvb = mesh->vertexBuffer->GetBuffer();
+            ID3D11Buffer* d3dib = mesh->indexBuffer->GetBuffer();
+
+            dc->IASetPrimitiveTopology( (D3D11_PRIMITIVE_TOPOLOGY)mesh->primitiveType );    
+            dc->IASetVertexBuffers( 0, 1, &d3dvb, &stride, &offset );
+            dc->IASetIndexBuffer(d3dib, (DXGI_FORMAT) mesh->indexBuffer->GetFormat(), 0);
+            dc->DrawIndexedInstanced(indexCount, run.instanceCount, 0, 0, run.startInstance);
+        }
     }
-    else
-    {
-        diffuseMap[0] = TextureLib::Inst()->GetWhite()->GetView();
-    }
-   
-    dc->PSSetShaderResources( 0, 1, diffuseMap );
-
-    uint32_t stride = r.mesh->vertexBuffer->GetStride();
-    uint32_t offset = 0;    
-    uint32_t indexCount = r.mesh->indexBuffer->GetCount();
-    ID3D11Buffer* d3dvb = r.mesh->vertexBuffer->GetBuffer();
-    ID3D11Buffer* d3dib = r.mesh->indexBuffer->GetBuffer();
-
-    dc->IASetPrimitiveTopology( (D3D11_PRIMITIVE_TOPOLOGY)r.mesh->primitiveType );    
-    dc->IASetVertexBuffers( 0, 1, &d3dvb, &stride, &offset );
-    dc->IASetIndexBuffer(d3dib, (DXGI_FORMAT) r.mesh->indexBuffer->GetFormat(), 0);
-    dc->DrawIndexed(indexCount,0,0 );
+
+    // the instance stream is only valid for this draw.
+    ID3D11Buffer* nullBuffer = NULL;
+    uint32_t zero = 0;
+    dc->IASetVertexBuffers( 1, 1, &nullBuffer, &zero, &zero );
 }
 
 
@@ -6,6 +6,7 @@
 #include "Renderable.h"
 #include "Shader.h"
 #include "RenderBuffer.h"
+#include "GizmoBatch.h"
 
 namespace LvEdEngine
 {
@@ -30,10 +31,10 @@ class BillboardShader : public Shader
     // set fill mode
     virtual void SetRenderFlag(RenderFlagsEnum rf);    
 
-    virtual void DrawNodes(const RenderNodeList& renderNodes);
+    // draws the nodes with one instanced draw per mesh and texture.
+    virtual void DrawNodes(const FrameNodeList& renderNodes);
     
 private:    
-    void Draw(const RenderableNode& r);  
 
     // -------------------------------------------------------------------
     struct ConstantBufferPerFrame
@@ -42,20 +43,12 @@ struct ConstantBufferPerFrame
          Matrix projXform;
     };
 
-    // -------------------------------------------------------------------
-    struct ConstantBufferPerDraw
-    {
-        Matrix worldXform;
-        Matrix textureXForm;
-        float4 color;  // alpha is not used.
-    };
-
     ID3D11VertexShader*     m_vertexShader;
     ID3D11PixelShader*      m_pixelShader;
     ID3D11InputLayout*      m_vertexLayout;
 
     TConstantBuffer<ConstantBufferPerFrame> m_cbPerFrame;
-    TConstantBuffer<ConstantBufferPerDraw> m_cbPerDraw;    
+    GizmoBatch              m_batch;
     
     RenderFlagsEnum         m_renderFlags;
     RenderContext*          m_rc;
@@ -0,0 +1,235 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    CommandBuffer.cpp
+
+****************************************************************************/
+#include "CommandBuffer.h"
+#include <string.h>
+#include <assert.h>
+
+using namespace LvEdEngine;
+
+static const uint32_t InvalidState = 0xFFFFFFFF;
+
+//---------------------------------------------------------------------------
+CommandBuffer::CommandBuffer()
+  : m_size(0),
+    m_commandCount(0),
+    m_drawCount(0)
+{
+    Reset();
+}
+
+//---------------------------------------------------------------------------
+void CommandBuffer::Reset()
+{
+    m_size = 0;
+    m_commandCount = 0;
+    m_drawCount = 0;
+    m_vertexBuffer = NULL;
+    m_vertexStride = InvalidState;
+    m_indexBuffer = NULL;
+    m_topology = InvalidState;
+    m_layout = NULL;
+    m_vs = NULL;
+    m_ps = NULL;
+    m_gs = NULL;
+}
+
+//---------------------------------------------------------------------------
+void* CommandBuffer::Alloc(CommandTypeEnum type, uint32_t payloadSize)
+{
+    uint32_t size = (sizeof(CommandHeader) + payloadSize + 7) & ~7u;
+    assert(size <= 0xFFFF);
+    uint32_t required = (m_size + size) / sizeof(uint64_t);
+    if(required > m_data.size())
+        m_data.resize(required < 2 * m_data.size() ? 2 * m_data.size() : required);
+
+    CommandHeader* header = reinterpret_cast<CommandHeader*>(reinterpret_cast<uint8_t*>(&m_data[0]) + m_size);
+    header->type = (uint16_t)type;
+    header->size = (uint16_t)size;
+    m_size += size;
+    m_commandCount++;
+    return header + 1;
+}
+
+//---------------------------------------------------------------------------
+void CommandBuffer::SetVertexBuffer(ID3D11Buffer* buffer, uint32_t stride, uint32_t offset)
+{
+    if(buffer == m_vertexBuffer && stride == m_vertexStride && offset == 0)
+        return;
+    CmdSetVertexBuffer* cmd = (CmdSetVertexBuffer*)Alloc(CommandType::SetVertexBuffer, sizeof(CmdSetVertexBuffer));
+    cmd->buffer = buffer;
+    cmd->stride = stride;
+    cmd->offset = offset;
+    m_vertexBuffer = offset == 0 ? buffer : NULL;
+    m_vertexStride = stride;
+}
+
+//---------------------------------------------------------------------------
+void CommandBuffer::SetIndexBuffer(ID3D11Buffer* buffer, uint32_t format)
+{
+    // a buffer always has the same format.
+    if(buffer == m_indexBuffer && buffer != NULL)
+        return;
+    CmdSetIndexBuffer* cmd = (CmdSetIndexBuffer*)Alloc(CommandType::SetIndexBuffer, sizeof(CmdSetIndexBuffer));
+    cmd->buffer = buffer;
+    cmd->format = format;
+    m_indexBuffer = buffer;
+}
+
+//---------------------------------------------------------------------------
+void CommandBuffer::SetTopology(uint32_t topology)
+{
+    if(topology == m_topology)
+        return;
+    CmdSetTopology* cmd = (CmdSetTopology*)Alloc(CommandType::SetTopology, sizeof(CmdSetTopology));
+    cmd->topology = topology;
+    m_topology = topology;
+}
+
+//---------------------------------------------------------------------------
+void CommandBuffer::SetInputLayout(ID3D11InputLayout* layout)
+{
+    if(layout == m_layout && layout != NULL)
+        return;
+    CmdSetInputLayout* cmd = (CmdSetInputLayout*)Alloc(CommandType::SetInputLayout, sizeof(CmdSetInputLayout));
+    cmd->layout = layout;
+    m_layout = layout;
+}
+
+//---------------------------------------------------------------------------
+void CommandBuffer::SetShaders(ID3D11VertexShader* vs, ID3D11PixelShader* ps, ID3D11GeometryShader* gs)
+{
+    if(vs == m_vs && ps == m_ps && gs == m_gs && vs != NULL)
+        return;
+    CmdSetShaders* cmd = (CmdSetShaders*)Alloc(CommandType::SetShaders, sizeof(CmdSetShaders));
+    cmd->vs = vs;
+    cmd->ps = ps;
+    cmd->gs = gs;
+    m_vs = vs;
+    m_ps = ps;
+    m_gs = gs;
+}
+
+//---------------------------------------------------------------------------
+void CommandBuffer::SetRasterState(ID3D11RasterizerState* state)
+{
+    CmdSetRasterState* cmd = (CmdSetRasterState*)Alloc(CommandType::SetRasterState, sizeof(CmdSetRasterState));
+    cmd->state = state;
+}
+
+//---------------------------------------------------------------------------
+void CommandBuffer::SetBlendState(ID3D11BlendState* state, const float blendFactor[4], uint32_t sampleMask)
+{
+    CmdSetBlendState* cmd = (CmdSetBlendState*)Alloc(CommandType::SetBlendState, sizeof(CmdSetBlendState));
+    cmd->state = state;
+    for(int i = 0; i < 4; ++i)
+        cmd->blendFactor[i] = blendFactor[i];
+    cmd->sampleMask = sampleMask;
+}
+
+//---------------------------------------------------------------------------
+void CommandBuffer::SetDepthState(ID3D11DepthStencilState* state, uint32_t stencilRef)
+{
+    CmdSetDepthState* cmd = (CmdSetDepthState*)Alloc(CommandType::SetDepthState, sizeof(CmdSetDepthState));
+    cmd->state = state;
+    cmd->stencilRef = stencilRef;
+}
+
+//---------------------------------------------------------------------------
+void CommandBuffer::SetPSResources(uint32_t slot, uint32_t count, ID3D11ShaderResourceView* const* views)
+{
+    assert(count <= MaxCommandSlots);
+    CmdSetPSResources* cmd = (CmdSetPSResources*)Alloc(CommandType::SetPSResources, sizeof(CmdSetPSResources));
+    cmd->slot = slot;
+    cmd->count = count;
+    memcpy(cmd->views, views, count * sizeof(ID3D11ShaderResourceView*));
+}
+
+//---------------------------------------------------------------------------
+void CommandBuffer::SetPSSamplers(uint32_t slot, uint32_t count, ID3D11SamplerState* const* samplers)
+{
+    assert(count <= MaxCommandSlots);
+    CmdSetPSSamplers* cmd = (CmdSetPSSamplers*)Alloc(CommandType::SetPSSamplers, sizeof(CmdSetPSSamplers));
+    cmd->slot = slot;
+    cmd->count = count;
+    memcpy(cmd->samplers, samplers, count * sizeof(ID3D11SamplerState*));
+}
+
+//---------------------------------------------------------------------------
+void CommandBuffer::SetConstantBuffers(uint32_t slot, uint32_t count, ID3D11Buffer* const* buffers)
+{
+    assert(count <= MaxCommandSlots);
+    CmdSetConstantBuffers* cmd = (CmdSetConstantBuffers*)Alloc(CommandType::SetConstantBuffers, sizeof(CmdSetConstantBuffers));
+    cmd->slot = slot;
+    cmd->count = count;
+    memcpy(cmd->buffers, buffers, count * sizeof(ID3D11Buffer*));
+}
+
+//---------------------------------------------------------------------------
+void CommandBuffer::UpdateConstants(ID3D11Buffer* buffer, const void* data, uint32_t size)
+{
+    CmdUpdateConstants* cmd = (CmdUpdateConstants*)Alloc(CommandType::UpdateConstants, sizeof(CmdUpdateConstants) + size);
+    cmd->buffer = buffer;
+    cmd->size = size;
+    memcpy(cmd + 1, data, size);
+}
+
+//---------------------------------------------------------------------------
+void CommandBuffer::Draw(uint32_t vertexCount, uint32_t startVertex)
+{
+    CmdDraw* cmd = (CmdDraw*)Alloc(CommandType::Draw, sizeof(CmdDraw));
+    cmd->vertexCount = vertexCount;
+    cmd->startVertex = startVertex;
+    m_drawCount++;
+}
+
+//---------------------------------------------------------------------------
+void CommandBuffer::DrawIndexed(uint32_t indexCount, uint32_t startIndex, int32_t baseVertex)
+{
+    CmdDrawIndexed* cmd = (CmdDrawIndexed*)Alloc(CommandType::DrawIndexed, sizeof(CmdDrawIndexed));
+    cmd->indexCount = indexCount;
+    cmd->startIndex = startIndex;
+    cmd->baseVertex = baseVertex;
+    m_drawCount++;
+}
+
+//---------------------------------------------------------------------------
+void CommandBuffer::Append(const CommandBuffer& other)
+{
+    if(other.m_size == 0)
+        return;
+    uint32_t required = (m_size + other.m_size) / sizeof(uint64_t);
+    if(required > m_data.size())
+        m_data.resize(required);
+    memcpy(reinterpret_cast<uint8_t*>(&m_data[0]) + m_size, &other.m_data[0], other.m_size);
+    m_size += other.m_size;
+    m_commandCount += other.m_commandCount;
+    m_drawCount += other.m_drawCount;
+
+    // the bindings are the ones left by the other buffer.
+    m_vertexBuffer = other.m_vertexBuffer;
+    m_vertexStride = other.m_vertexStride;
+    m_indexBuffer = other.m_indexBuffer;
+    m_topology = other.m_topology;
+    m_layout = other.m_layout;
+    m_vs = other.m_vs;
+    m_ps = other.m_ps;
+    m_gs = other.m_gs;
+}
+
+//---------------------------------------------------------------------------
+const CommandHeader* CommandBuffer::First() const
+{
+    return m_size > 0 ? reinterpret_cast<const CommandHeader*>(&m_data[0]) : NULL;
+}
+
+//---------------------------------------------------------------------------
+const CommandHeader* CommandBuffer::Next(const CommandHeader* cmd) const
+{
+    const uint8_t* next = reinterpret_cast<const uint8_t*>(cmd) + cmd->size;
+    const uint8_t* end = reinterpret_cast<const uint8_t*>(&m_data[0]) + m_size;
+    return next < end ? reinterpret_cast<const CommandHeader*>(next) : NULL;
+}
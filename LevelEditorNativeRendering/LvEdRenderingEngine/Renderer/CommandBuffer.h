@@ -0,0 +1,145 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    CommandBuffer.h
+
+    Render commands recorded into a linear buffer and executed later by a
+    CommandBackend. Recording doesn't touch the device, so frame building
+    can be profiled and tested without D3D11, and command buffers can be
+    recorded on worker threads.
+****************************************************************************/
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "../Core/NonCopyable.h"
+
+// the resources are only used as handles while recording.
+struct ID3D11Buffer;
+struct ID3D11InputLayout;
+struct ID3D11VertexShader;
+struct ID3D11PixelShader;
+struct ID3D11GeometryShader;
+struct ID3D11ShaderResourceView;
+struct ID3D11SamplerState;
+struct ID3D11RasterizerState;
+struct ID3D11BlendState;
+struct ID3D11DepthStencilState;
+
+namespace LvEdEngine
+{
+    namespace CommandType
+    {
+        enum Enum
+        {
+            SetVertexBuffer,
+            SetIndexBuffer,
+            SetTopology,
+            SetInputLayout,
+            SetShaders,
+            SetRasterState,
+            SetBlendState,
+            SetDepthState,
+            SetPSResources,
+            SetPSSamplers,
+            SetConstantBuffers,   // bound to both the vertex and the pixel stage.
+            UpdateConstants,
+            Draw,
+            DrawIndexed,
+        };
+    }
+    typedef CommandType::Enum CommandTypeEnum;
+
+    static const uint32_t MaxCommandSlots = 8;
+
+    // every command starts with this header, followed by its payload.
+    struct CommandHeader
+    {
+        uint16_t type;
+        uint16_t size;  // size in bytes including the header, multiple of 8.
+    };
+
+    struct CmdSetVertexBuffer  { ID3D11Buffer* buffer; uint32_t stride; uint32_t offset; };
+    struct CmdSetIndexBuffer   { ID3D11Buffer* buffer; uint32_t format; };
+    struct CmdSetTopology      { uint32_t topology; };
+    struct CmdSetInputLayout   { ID3D11InputLayout* layout; };
+    struct CmdSetShaders       { ID3D11VertexShader* vs; ID3D11PixelShader* ps; ID3D11GeometryShader* gs; };
+    struct CmdSetRasterState   { ID3D11RasterizerState* state; };
+    struct CmdSetBlendState    { ID3D11BlendState* state; float blendFactor[4]; uint32_t sampleMask; };
+    struct CmdSetDepthState    { ID3D11DepthStencilState* state; uint32_t stencilRef; };
+    struct CmdSetPSResources   { uint32_t slot; uint32_t count; ID3D11ShaderResourceView* views[MaxCommandSlots]; };
+    struct CmdSetPSSamplers    { uint32_t slot; uint32_t count; ID3D11SamplerState* samplers[MaxCommandSlots]; };
+    struct CmdSetConstantBuffers { uint32_t slot; uint32_t count; ID3D11Buffer* buffers[MaxCommandSlots]; };
+    struct CmdUpdateConstants  { ID3D11Buffer* buffer; uint32_t size; /* followed by size bytes of data */ };
+    struct CmdDraw             { uint32_t vertexCount; uint32_t startVertex; };
+    struct CmdDrawIndexed      { uint32_t indexCount; uint32_t startIndex; int32_t baseVertex; };
+
+    class CommandBuffer : public NonCopyable
+    {
+    public:
+        CommandBuffer();
+
+        // clears the commands, keeps the memory.
+        void Reset();
+
+        // Recording. The input assembler and shader bindings are skipped
+        // when they match what was last recorded since Reset().
+        void SetVertexBuffer(ID3D11Buffer* buffer, uint32_t stride, uint32_t offset = 0);
+        void SetIndexBuffer(ID3D11Buffer* buffer, uint32_t format);
+        void SetTopology(uint32_t topology);
+        void SetInputLayout(ID3D11InputLayout* layout);
+        void SetShaders(ID3D11VertexShader* vs, ID3D11PixelShader* ps, ID3D11GeometryShader* gs = NULL);
+        void SetRasterState(ID3D11RasterizerState* state);
+        void SetBlendState(ID3D11BlendState* state, const float blendFactor[4], uint32_t sampleMask);
+        void SetDepthState(ID3D11DepthStencilState* state, uint32_t stencilRef);
+        void SetPSResources(uint32_t slot, uint32_t count, ID3D11ShaderResourceView* const* views);
+        void SetPSSamplers(uint32_t slot, uint32_t count, ID3D11SamplerState* const* samplers);
+        void SetConstantBuffers(uint32_t slot, uint32_t count, ID3D11Buffer* const* buffers);
+        // the data is copied into the command buffer.
+        void UpdateConstants(ID3D11Buffer* buffer, const void* data, uint32_t size);
+        void Draw(uint32_t vertexCount, uint32_t startVertex);
+        void DrawIndexed(uint32_t indexCount, uint32_t startIndex, int32_t baseVertex);
+
+        // Appends the commands of another buffer, for buffers recorded in parallel.
+        void Append(const CommandBuffer& other);
+
+        // Iteration: for(const CommandHeader* cmd = First(); cmd; cmd = Next(cmd))
+        const CommandHeader* First() const;
+        const CommandHeader* Next(const CommandHeader* cmd) const;
+        template<typename T> static const T* Payload(const CommandHeader* cmd)
+        {
+            return reinterpret_cast<const T*>(cmd + 1);
+        }
+
+        uint32_t GetCommandCount() const { return m_commandCount; }
+        uint32_t GetDrawCount() const { return m_drawCount; }
+        uint32_t GetSizeInBytes() const { return m_size; }
+
+    private:
+        void* Alloc(CommandTypeEnum type, uint32_t payloadSize);
+
+        std::vector<uint64_t> m_data;   // 8 byte aligned storage.
+        uint32_t m_size;                // used bytes.
+        uint32_t m_commandCount;
+        uint32_t m_drawCount;
+
+        // last recorded bindings, for redundant command elimination.
+        ID3D11Buffer*       m_vertexBuffer;
+        uint32_t            m_vertexStride;
+        ID3D11Buffer*       m_indexBuffer;
+        uint32_t            m_topology;
+        ID3D11InputLayout*  m_layout;
+        ID3D11VertexShader* m_vs;
+        ID3D11PixelShader*  m_ps;
+        ID3D11GeometryShader* m_gs;
+    };
+
+    // executes command buffers on a device.
+    class CommandBackend : public NonCopyable
+    {
+    public:
+        virtual ~CommandBackend() {}
+        virtual void Execute(const CommandBuffer& commands) = 0;
+    };
+}
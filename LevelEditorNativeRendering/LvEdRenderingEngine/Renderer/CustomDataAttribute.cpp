@@ -3,6 +3,8 @@
 #include "CustomDataAttribute.h"
 #include "../Core/Utils.h"
 #include "../Core/Logger.h"
+#include <limits.h>
+#include <float.h>
 
 // REMOVE
 #include "../Model3d/rapidxmlhelpers.h"
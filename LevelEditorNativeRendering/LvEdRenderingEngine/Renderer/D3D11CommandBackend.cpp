@@ -0,0 +1,111 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    D3D11CommandBackend.cpp
+
+****************************************************************************/
+#include "D3D11CommandBackend.h"
+#include "../Core/Logger.h"
+#include <assert.h>
+
+using namespace LvEdEngine;
+
+//---------------------------------------------------------------------------
+void D3D11CommandBackend::Execute(const CommandBuffer& commands)
+{
+    ID3D11DeviceContext* dc = m_context;
+    for(const CommandHeader* cmd = commands.First(); cmd; cmd = commands.Next(cmd))
+    {
+        switch(cmd->type)
+        {
+        case CommandType::SetVertexBuffer:
+            {
+                const CmdSetVertexBuffer* c = CommandBuffer::Payload<CmdSetVertexBuffer>(cmd);
+                ID3D11Buffer* buffer = c->buffer;
+                UINT stride = c->stride;
+                UINT offset = c->offset;
+                dc->IASetVertexBuffers(0, 1, &buffer, &stride, &offset);
+            }
+            break;
+        case CommandType::SetIndexBuffer:
+            {
+                const CmdSetIndexBuffer* c = CommandBuffer::Payload<CmdSetIndexBuffer>(cmd);
+                dc->IASetIndexBuffer(c->buffer, (DXGI_FORMAT)c->format, 0);
+            }
+            break;
+        case CommandType::SetTopology:
+            dc->IASetPrimitiveTopology((D3D11_PRIMITIVE_TOPOLOGY)CommandBuffer::Payload<CmdSetTopology>(cmd)->topology);
+            break;
+        case CommandType::SetInputLayout:
+            dc->IASetInputLayout(CommandBuffer::Payload<CmdSetInputLayout>(cmd)->layout);
+            break;
+        case CommandType::SetShaders:
+            {
+                const CmdSetShaders* c = CommandBuffer::Payload<CmdSetShaders>(cmd);
+                dc->VSSetShader(c->vs, NULL, 0);
+                dc->PSSetShader(c->ps, NULL, 0);
+                dc->GSSetShader(c->gs, NULL, 0);
+            }
+            break;
+        case CommandType::SetRasterState:
+            dc->RSSetState(CommandBuffer::Payload<CmdSetRasterState>(cmd)->state);
+            break;
+        case CommandType::SetBlendState:
+            {
+                const CmdSetBlendState* c = CommandBuffer::Payload<CmdSetBlendState>(cmd);
+                dc->OMSetBlendState(c->state, c->blendFactor, c->sampleMask);
+            }
+            break;
+        case CommandType::SetDepthState:
+            {
+                const CmdSetDepthState* c = CommandBuffer::Payload<CmdSetDepthState>(cmd);
+                dc->OMSetDepthStencilState(c->state, c->stencilRef);
+            }
+            break;
+        case CommandType::SetPSResources:
+            {
+                const CmdSetPSResources* c = CommandBuffer::Payload<CmdSetPSResources>(cmd);
+                dc->PSSetShaderResources(c->slot, c->count, c->views);
+            }
+            break;
+        case CommandType::SetPSSamplers:
+            {
+                const CmdSetPSSamplers* c = CommandBuffer::Payload<CmdSetPSSamplers>(cmd);
+                dc->PSSetSamplers(c->slot, c->count, c->samplers);
+            }
+            break;
+        case CommandType::SetConstantBuffers:
+            {
+                const CmdSetConstantBuffers* c = CommandBuffer::Payload<CmdSetConstantBuffers>(cmd);
+                dc->VSSetConstantBuffers(c->slot, c->count, c->buffers);
+                dc->PSSetConstantBuffers(c->slot, c->count, c->buffers);
+            }
+            break;
+        case CommandType::UpdateConstants:
+            {
+                const CmdUpdateConstants* c = CommandBuffer::Payload<CmdUpdateConstants>(cmd);
+                D3D11_MAPPED_SUBRESOURCE mappedResource;
+                HRESULT hr = dc->Map(c->buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource);
+                if(Logger::IsFailureLog(hr, L"failed map cb")) break;
+                CopyMemory(mappedResource.pData, c + 1, c->size);
+                dc->Unmap(c->buffer, 0);
+            }
+            break;
+        case CommandType::Draw:
+            {
+                const CmdDraw* c = CommandBuffer::Payload<CmdDraw>(cmd);
+                dc->Draw(c->vertexCount, c->startVertex);
+            }
+            break;
+        case CommandType::DrawIndexed:
+            {
+                const CmdDrawIndexed* c = CommandBuffer::Payload<CmdDrawIndexed>(cmd);
+                dc->DrawIndexed(c->indexCount, c->startIndex, c->baseVertex);
+            }
+            break;
+        default:
+            assert(0); // unknown command.
+            break;
+        }
+    }
+}
@@ -0,0 +1,24 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    D3D11CommandBackend.h
+
+    Executes command buffers on a D3D11 device context.
+****************************************************************************/
+#pragma once
+
+#include <d3d11.h>
+#include "CommandBuffer.h"
+
+namespace LvEdEngine
+{
+    class D3D11CommandBackend : public CommandBackend
+    {
+    public:
+        D3D11CommandBackend(ID3D11DeviceContext* context) : m_context(context) {}
+        virtual void Execute(const CommandBuffer& commands);
+
+    private:
+        ID3D11DeviceContext* m_context;
+    };
+}
@@ -0,0 +1,111 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+#include "D3DShaderCompiler.h"
+#include <D3Dcompiler.h>
+#include "../Core/ResUtil.h"
+#include "../Core/Logger.h"
+
+namespace LvEdEngine
+{
+
+    // custom include handler 
+    // helps shader compiler to resolve #include as embedded resources 
+    // and remembers the files it opened.
+    class IncludeHandler : public ID3DInclude, public NonCopyable
+    {
+        public:
+        IncludeHandler(std::vector<std::string>* includes) : m_includes(includes) {}
+
+        STDMETHOD(Open)(
+            D3D_INCLUDE_TYPE /*IncludeType*/,
+            LPCSTR pFileName,
+            LPCVOID /*pParentData*/,
+            LPCVOID *ppData,
+            UINT *pBytes)
+        {                       
+            WCHAR wfile[MAX_PATH];
+            if(MultiByteToWideChar(CP_ACP, 0, pFileName, -1, wfile, MAX_PATH) == 0)
+                return E_INVALIDARG;
+            *ppData = ResUtil::LoadResource(L"SHADER",wfile,pBytes);            
+            if(*pBytes == 0)
+                return E_INVALIDARG;
+            m_includes->push_back(pFileName);
+            return S_OK;
+        }
+        STDMETHOD(Close)( LPCVOID pData)
+        {
+            if(pData)
+            {                
+                free((void*)pData);
+            }          
+            return S_OK;
+        }
+
+        private:
+        std::vector<std::string>* m_includes;
+    };
+
+// -------------------------------------------------------------------------------------------------
+D3DShaderCompiler::D3DShaderCompiler()
+{
+    m_flags = D3DCOMPILE_ENABLE_STRICTNESS;
+#if defined( DEBUG ) || defined( _DEBUG )  
+    m_flags |= D3DCOMPILE_DEBUG;
+#else
+    m_flags |= D3DCOMPILE_OPTIMIZATION_LEVEL3;     
+#endif
+}
+
+// -------------------------------------------------------------------------------------------------
+bool D3DShaderCompiler::ReadSource(const char* name, std::string* source)
+{
+    WCHAR wname[MAX_PATH];
+    if(MultiByteToWideChar(CP_ACP, 0, name, -1, wname, MAX_PATH) == 0)
+        return false;
+    uint32_t size = 0;
+    void* data = ResUtil::LoadResource(L"SHADER", wname, &size);
+    if(data == NULL)
+        return false;
+    source->assign((const char*)data, size);
+    free(data);
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+bool D3DShaderCompiler::Compile(const char* name, const std::string& source, const D3D_SHADER_MACRO* macros,
+    const char* entryPoint, const char* target, std::vector<uint8_t>* code, std::vector<std::string>* includes)
+{
+    ID3DBlob* pErrorBlob = NULL;
+    ID3DBlob* pCompiledCode = NULL;
+    IncludeHandler incHandler(includes);
+    HRESULT hr = D3DCompile(source.data(), source.size(), name, macros, &incHandler,
+        entryPoint, target, m_flags, 0, &pCompiledCode, &pErrorBlob);
+
+    if( FAILED(hr) )
+    {
+        if( pErrorBlob != NULL )
+            Logger::Log(OutputMessageType::Error, "Shader Error: %s\n",(char*)pErrorBlob->GetBufferPointer());
+    }
+    else
+    {
+        if( pErrorBlob != NULL )
+            Logger::Log(OutputMessageType::Warning, "Shader Warning: %s\n",(char*)pErrorBlob->GetBufferPointer());
+    }
+    if( pErrorBlob ) pErrorBlob->Release();
+    if( pCompiledCode == NULL )
+        return false;
+
+    const uint8_t* bytes = (const uint8_t*)pCompiledCode->GetBufferPointer();
+    code->assign(bytes, bytes + pCompiledCode->GetBufferSize());
+    pCompiledCode->Release();
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+hash64_t D3DShaderCompiler::GetVersion()
+{
+    UINT version[2] = { D3D_COMPILER_VERSION, m_flags };
+    return Hash64(version, sizeof(version));
+}
+
+}; // namespace
@@ -0,0 +1,28 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    D3DShaderCompiler.h
+
+    ShaderCompiler of the engine: the shaders and the files they include
+    are SHADER resources of the dll, compiled with D3DCompile.
+****************************************************************************/
+#pragma once
+
+#include "ShaderCache.h"
+
+namespace LvEdEngine
+{
+    class D3DShaderCompiler : public ShaderCompiler
+    {
+    public:
+        D3DShaderCompiler();
+
+        virtual bool ReadSource(const char* name, std::string* source);
+        virtual bool Compile(const char* name, const std::string& source, const D3D_SHADER_MACRO* macros,
+            const char* entryPoint, const char* target, std::vector<uint8_t>* code, std::vector<std::string>* includes);
+        virtual hash64_t GetVersion();
+
+    private:
+        UINT m_flags;
+    };
+}
@@ -4,6 +4,7 @@
 #include "../Core/Logger.h"
 #include "../Core/Utils.h"
 #include "DeviceManager.h"
+#include "NullDevice.h"
 
 namespace LvEdEngine
 {
@@ -11,16 +12,33 @@ namespace LvEdEngine
 DeviceManager* gD3D11;
 
 
-DeviceManager::DeviceManager(void)
+DeviceManager::DeviceManager(bool headless)
 	: m_pd3dDevice(NULL), 
 	m_pImmediateContext(NULL),    
-	m_pDXGIFactory1(NULL)
+	m_pDXGIFactory1(NULL),
+	m_headless(headless)
 {	
     
-	// create DXGIFactory, d3d device
-
 	HRESULT hr = S_OK;
 
+#ifndef _WIN32
+	// no DXGI outside Windows, only the null device.
+	m_headless = true;
+#endif
+	if(m_headless)
+	{
+		hr = CreateNullDevice(&m_pd3dDevice, &m_pImmediateContext);
+		if(Logger::IsFailureLog(hr, L"CreateNullDevice"))
+		{
+			return;
+		}
+		Logger::Log(OutputMessageType::Info, L"Null device, nothing is drawn\n");
+		return;
+	}
+
+#ifdef _WIN32
+	// create DXGIFactory, d3d device
+
 	// create dxgi factory and keep it for future use.	
 	hr = CreateDXGIFactory1(__uuidof(IDXGIFactory1), (void**)(&m_pDXGIFactory1) );
 	if (Logger::IsFailureLog(hr))
@@ -160,7 +178,7 @@ namespace LvEdEngine
         strFeatureLevel = L"Newer than D3D_FEATURE_LEVEL_11_0";                        
     }        
     Logger::Log(OutputMessageType::Info,L"Feature Level: %s\n", strFeatureLevel);
-
+#endif
 }
 
 DeviceManager::~DeviceManager(void)
@@ -1,7 +1,7 @@
 //Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
 
 #pragma once
-#include "../Core/winheaders.h"
+#include "../Core/WinHeaders.h"
 #include "../Core/NonCopyable.h"
 #include <d3d11.h>
 
@@ -13,7 +13,9 @@ class DeviceManager : public NonCopyable
 {
 
 public:
-	DeviceManager(void);
+	// a headless device manager creates a null device, see NullDevice.h,
+	// and has no DXGI factory, swap chains render offscreen.
+	DeviceManager(bool headless = false);
 	~DeviceManager(void);
 
 		
@@ -32,11 +34,17 @@ class DeviceManager : public NonCopyable
 		return m_pImmediateContext;
 	}
 
+	bool IsHeadless() const
+	{
+		return m_headless;
+	}
+
 
 private:	
 	ID3D11Device*           m_pd3dDevice;
 	ID3D11DeviceContext*    m_pImmediateContext;		
 	IDXGIFactory1*          m_pDXGIFactory1;
+	bool                    m_headless;
     
 
 };
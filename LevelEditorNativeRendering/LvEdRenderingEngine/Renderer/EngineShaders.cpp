@@ -0,0 +1,32 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    EngineShaders.cpp
+
+****************************************************************************/
+#include "EngineShaders.h"
+#include "RenderUtil.h"
+
+namespace LvEdEngine
+{
+
+#define LVED_ENGINE_SHADER_DESC(id, file, entryPoint, target) { file, entryPoint, target, NULL },
+static const ShaderCache::ShaderDesc s_descs[EngineShader::Count] =
+{
+    LVED_ENGINE_SHADERS(LVED_ENGINE_SHADER_DESC)
+};
+#undef LVED_ENGINE_SHADER_DESC
+
+// -------------------------------------------------------------------------------------------------
+const ShaderCache::ShaderDesc* EngineShader::GetDescs()
+{
+    return s_descs;
+}
+
+// -------------------------------------------------------------------------------------------------
+ID3DBlob* EngineShader::Compile(Enum shader)
+{
+    return CompileShader(s_descs[shader]);
+}
+
+}; // namespace
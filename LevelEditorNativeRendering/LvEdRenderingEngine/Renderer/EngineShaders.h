@@ -0,0 +1,71 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    EngineShaders.h
+
+    The shaders the engine creates while initializing, one at a time in the
+    constructors of the renderers. LvEd_Initialize() prefetches the same
+    list, so that the ones missing from the ShaderCache compile in parallel.
+****************************************************************************/
+#pragma once
+
+#include <d3d11.h>
+#include "ShaderCache.h"
+
+// X(id, file, entry point, target)
+#define LVED_ENGINE_SHADERS(X) \
+    X(BasicRendererVS,      "BasicRenderer.hlsl",   "VS",          "vs_4_0") \
+    X(BasicRendererPS,      "BasicRenderer.hlsl",   "PS",          "ps_4_0") \
+    X(BasicRendererBatchVS, "BasicRenderer.hlsl",   "VS_Batch",    "vs_4_0") \
+    X(BasicRendererBatchPS, "BasicRenderer.hlsl",   "PS_Batch",    "ps_4_0") \
+    X(BasicShaderVS,        "BasicShader.hlsl",     "VS",          "vs_4_0") \
+    X(BasicShaderPS,        "BasicShader.hlsl",     "PS",          "ps_4_0") \
+    X(BillboardVS,          "Billboard.hlsl",       "VSMain",      "vs_4_0") \
+    X(BillboardPS,          "Billboard.hlsl",       "PSMain",      "ps_4_0") \
+    X(FontVS,               "FontShader.hlsl",      "VS",          "vs_4_0") \
+    X(FontPS,               "FontShader.hlsl",      "PS",          "ps_4_0") \
+    X(LineVS,               "LineShader.hlsl",      "VS",          "vs_4_0") \
+    X(LinePS,               "LineShader.hlsl",      "PS",          "ps_4_0") \
+    X(NormalsVS,            "NormalsShader.hlsl",   "VS",          "vs_4_0") \
+    X(NormalsGS,            "NormalsShader.hlsl",   "GS",          "gs_4_0") \
+    X(NormalsPS,            "NormalsShader.hlsl",   "PS",          "ps_4_0") \
+    X(ShadowMapGenVS,       "ShadowMapGen.hlsl",    "VSMain",      "vs_4_0") \
+    X(SkyDomeVS,            "SkySphere.hlsl",       "VS_Render",   "vs_4_0") \
+    X(SkyDomePS,            "SkySphere.hlsl",       "PS_Render",   "ps_4_0") \
+    X(TerrainVS,            "TerrainShader.hlsl",   "VSMain",      "vs_4_0") \
+    X(TerrainPS,            "TerrainShader.hlsl",   "PSMain",      "ps_4_0") \
+    X(TerrainSolidWireVS,   "TerrainShader.hlsl",   "VSSolidWire", "vs_4_0") \
+    X(TerrainSolidWireGS,   "TerrainShader.hlsl",   "GSSolidWire", "gs_4_0") \
+    X(TerrainSolidWirePS,   "TerrainShader.hlsl",   "PSSolidWire", "ps_4_0") \
+    X(TerrainNormalsVS,     "TerrainShader.hlsl",   "VSNormals",   "vs_4_0") \
+    X(TerrainNormalsGS,     "TerrainShader.hlsl",   "GSNormals",   "gs_4_0") \
+    X(TerrainNormalsPS,     "TerrainShader.hlsl",   "PSNormals",   "ps_4_0") \
+    X(TerrainDecoVS,        "TerrainShader.hlsl",   "VSDeco",      "vs_4_0") \
+    X(TerrainDecoPS,        "TerrainShader.hlsl",   "PSDeco",      "ps_4_0") \
+    X(TerrainDecoBBVS,      "TerrainShader.hlsl",   "VSDecoBB",    "vs_4_0") \
+    X(TerrainDecoBBGS,      "TerrainShader.hlsl",   "GSDecoBB",    "gs_4_0") \
+    X(TexturedVS,           "TexturedShader.hlsl",  "VSMain",      "vs_4_0") \
+    X(TexturedPS,           "TexturedShader.hlsl",  "PSMain",      "ps_4_0") \
+    X(WireframeVS,          "WireFrameShader.hlsl", "VSSolidWire", "vs_4_0") \
+    X(WireframeGS,          "WireFrameShader.hlsl", "GSSolidWire", "gs_4_0") \
+    X(WireframePS,          "WireFrameShader.hlsl", "PSSolidWire", "ps_4_0")
+
+namespace LvEdEngine
+{
+    namespace EngineShader
+    {
+#define LVED_ENGINE_SHADER_ENUM(id, file, entryPoint, target) id,
+        enum Enum
+        {
+            LVED_ENGINE_SHADERS(LVED_ENGINE_SHADER_ENUM)
+            Count
+        };
+#undef LVED_ENGINE_SHADER_ENUM
+
+        // the whole table, Count descs.
+        const ShaderCache::ShaderDesc* GetDescs();
+
+        // the code of the shader from the ShaderCache, NULL on failure.
+        ID3DBlob* Compile(Enum shader);
+    }
+}
@@ -6,9 +6,14 @@
 ****************************************************************************/
 #include "d3d11.h"
 #include <assert.h>
+#include <wchar.h>
+#ifdef _WIN32
 #include <Gdiplus.h>
+#endif
 #include "DeviceManager.h"
-#include "../Core\Utils.h"
+#include "../Core/Utils.h"
+#include "../Core/FileUtils.h"
+#include "../Core/Logger.h"
 #include "Font.h"
 
 using namespace LvEdEngine;
@@ -18,21 +23,49 @@
 static const WCHAR s_EndChar        = 127;
 static const WCHAR s_NumChars       = ( s_EndChar - s_StartChar ); // doesn't include s_EndChar
 
+#ifdef _WIN32
 static Gdiplus::FontStyle 
                 FlagsToGdiStyleEnum( FontStyleFlags fontStyles );
 static void     GetCharacterSizes(Gdiplus::Font& font, Gdiplus::Graphics& charGraphics, FontAtlasSizeInfo* info /*OUT*/);
 static void     CreateAndIndexAtlasBitmap(Gdiplus::Font& font, Gdiplus::Graphics& charGraphics, Gdiplus::Bitmap& charBitmap, 
                     Gdiplus::Graphics& fontSheetGraphics, FontAtlasSizeInfo* pSizeInfo,
                     ScreenRect* pCharacterMap );
-static HRESULT  CreateAtlasTexture(ID3D11Device* device, Gdiplus::Bitmap& fontSheetBitmap, const FontAtlasSizeInfo* info,
-                    ID3D11Texture2D** ppD3dTexture, ID3D11ShaderResourceView** ppD3dShaderResourceView);
 static int      GetCharMinX(Gdiplus::Bitmap& charBitmap);
 static int      GetCharMaxX(Gdiplus::Bitmap& charBitmap);
+#endif
+static HRESULT  CreateAtlasTexture(ID3D11Device* device, const void* pixels, const FontAtlasSizeInfo* info,
+                    ID3D11Texture2D** ppD3dTexture, ID3D11ShaderResourceView** ppD3dShaderResourceView);
 
 
+//---------------------------------------------------------------------------
+//  Atlas cache file: the header, s_NumChars ScreenRects, then the
+//  atlas pixels (B8G8R8A8, atlasTextureWidth * atlasTextureHeight).
+//---------------------------------------------------------------------------
+static const size_t s_maxFontName = 64;
+struct FontAtlasFileHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    WCHAR    fontName[s_maxFontName];
+    float    pixelFontSize;
+    uint32_t fontStyles;
+    uint32_t antiAliased;
+    uint32_t numChars;
+    uint32_t atlasTextureWidth;
+    uint32_t atlasTextureHeight;
+    int32_t  characterRowHeight;
+    int32_t  spaceCharacterWidth;
+    int32_t  gapBetweenChars;
+};
+static const uint32_t s_atlasFileMagic   = 'L' | ('V' << 8) | ('F' << 16) | ('A' << 24);
+static const uint32_t s_atlasFileVersion = 1;   // bump when the atlas layout changes.
+
+static volatile LONG s_nextSerial = 0;
+
 //---------------------------------------------------------------------------
 Font::Font()
-  : m_pixelFontSize( 0.0f ),
+  : m_serial( (uint32_t)InterlockedIncrement( &s_nextSerial ) ),
+    m_pixelFontSize( 0.0f ),
     m_fontStyles( 0 ),
     m_antiAliased( false ),
     m_monoSpace( false ),
@@ -66,8 +99,6 @@
                             FontStyleFlags fontStyles, 
                             bool antiAliased)
 {
-    using namespace Gdiplus;
-
     LvEdFonts::Font* pFont = new Font;
 
     pFont->m_fontName          = fontName;
@@ -77,14 +108,29 @@
 
 	HRESULT hr = S_OK;
 
-	ULONG_PTR token = NULL;
-	GdiplusStartupInput startupInput(NULL, TRUE, TRUE);
-	GdiplusStartupOutput startupOutput;
-	GdiplusStartup(&token, &startupInput, &startupOutput);
-
-    hr = pFont->InitTextureAndShaderObjects(device, fontName, pixelFontSize, fontStyles, antiAliased );
-
-	GdiplusShutdown(token);
+    std::wstring cacheFile = pFont->GetAtlasCacheFile();
+    std::vector<uint8_t> pixels;
+    if ( !cacheFile.empty() && pFont->LoadAtlasCache( cacheFile.c_str(), &pixels ) )
+    {
+        hr = CreateAtlasTexture( device, &pixels[0], &pFont->m_sizeInfo, &pFont->m_d3dTexture, &pFont->m_d3dShaderResourceView );
+    }
+    else
+    {
+#ifdef _WIN32
+        using namespace Gdiplus;
+	    ULONG_PTR token = NULL;
+	    GdiplusStartupInput startupInput(NULL, TRUE, TRUE);
+	    GdiplusStartupOutput startupOutput;
+	    GdiplusStartup(&token, &startupInput, &startupOutput);
+
+        hr = pFont->InitTextureAndShaderObjects(device, fontName, pixelFontSize, fontStyles, antiAliased, cacheFile.c_str() );
+
+	    GdiplusShutdown(token);
+#else
+        // atlases are rasterized with GDI+, elsewhere only cached ones load.
+        hr = E_NOTIMPL;
+#endif
+    }
     if ( FAILED( hr ) )
     {
         SAFE_DELETE( pFont );
@@ -92,13 +138,15 @@
     return pFont;
 }
 
+#ifdef _WIN32
 //---------------------------------------------------------------------------
 HRESULT Font::InitTextureAndShaderObjects(
                             ID3D11Device* device, 
                             const WCHAR* fontName, 
                             float pixelFontSize, 
                             FontStyleFlags fontStyles, 
-                            bool antiAliased )
+                            bool antiAliased,
+                            const WCHAR* cacheFile )
 {
     using namespace Gdiplus;
 
@@ -133,9 +181,127 @@
 	CreateAndIndexAtlasBitmap(font, charGraphics, charBitmap, fontSheetGraphics,
             &m_sizeInfo, m_characterLookup );
 
-	CreateAtlasTexture(device, fontSheetBitmap, &m_sizeInfo, &m_d3dTexture, &m_d3dShaderResourceView );
+	// Lock the bitmap for direct memory access
+	BitmapData bmData;
+    Rect rect(0, 0, m_sizeInfo.atlasTextureWidth, m_sizeInfo.atlasTextureHeight );
+	if ( fontSheetBitmap.LockBits(&rect, ImageLockModeRead, PixelFormat32bppARGB, &bmData) != Ok )
+    {
+        return E_FAIL;
+    }
+    assert( bmData.Stride == (INT)( m_sizeInfo.atlasTextureWidth * 4 ) );
+
+    if ( cacheFile != NULL && cacheFile[0] != 0 )
+    {
+        SaveAtlasCache( cacheFile, bmData.Scan0 );
+    }
+	hr = CreateAtlasTexture(device, bmData.Scan0, &m_sizeInfo, &m_d3dTexture, &m_d3dShaderResourceView );
+
+	fontSheetBitmap.UnlockBits(&bmData);
     return hr;
 }
+#endif
+
+//---------------------------------------------------------------------------
+std::wstring Font::GetAtlasCacheFile()
+{
+    std::wstring dir = FileUtils::GetCacheDir( L"Fonts" );
+    if ( dir.empty() || m_fontName.size() >= s_maxFontName )
+    {
+        return std::wstring();
+    }
+
+    // e.g. "Courier_New_12.00_2_1.lvfont"
+    std::wstring name = m_fontName;
+    for ( auto it = name.begin(); it != name.end(); ++it )
+    {
+        if ( !iswalnum( *it ) )
+        {
+            *it = L'_';
+        }
+    }
+    WCHAR suffix[64];
+    swprintf_s( suffix, L"_%.2f_%u_%d.lvfont", m_pixelFontSize, m_fontStyles, m_antiAliased ? 1 : 0 );
+    return dir + name + suffix;
+}
+
+//---------------------------------------------------------------------------
+bool Font::LoadAtlasCache( const WCHAR* cacheFile, std::vector<uint8_t>* pixels )
+{
+    UINT size = 0;
+    BYTE* data = FileUtils::LoadFile( cacheFile, &size );
+    if ( data == NULL )
+    {
+        return false;
+    }
+
+    bool valid = false;
+    const FontAtlasFileHeader* header = (const FontAtlasFileHeader*)data;
+    if ( size >= sizeof(FontAtlasFileHeader)
+        && header->magic == s_atlasFileMagic
+        && header->version == s_atlasFileVersion
+        && header->numChars == s_NumChars
+        && header->pixelFontSize == m_pixelFontSize
+        && header->fontStyles == m_fontStyles
+        && header->antiAliased == (uint32_t)( m_antiAliased ? 1 : 0 )
+        && header->atlasTextureWidth == FontAtlasSizeInfo::kTextureWidth
+        && header->atlasTextureHeight > 0
+        && wcsncmp( header->fontName, m_fontName.c_str(), s_maxFontName ) == 0 )
+    {
+        UINT rectsSize  = s_NumChars * sizeof(ScreenRect);
+        UINT pixelsSize = header->atlasTextureWidth * header->atlasTextureHeight * 4;
+        valid = ( size == sizeof(FontAtlasFileHeader) + rectsSize + pixelsSize );
+        if ( valid )
+        {
+            m_sizeInfo.atlasTextureWidth    = header->atlasTextureWidth;
+            m_sizeInfo.atlasTextureHeight   = header->atlasTextureHeight;
+            m_sizeInfo.characterRowHeight   = header->characterRowHeight;
+            m_sizeInfo.spaceCharacterWidth  = header->spaceCharacterWidth;
+            m_sizeInfo.gapBetweenChars      = header->gapBetweenChars;
+
+            const BYTE* rects = data + sizeof(FontAtlasFileHeader);
+            memcpy( m_characterLookup, rects, rectsSize );
+            pixels->assign( rects + rectsSize, rects + rectsSize + pixelsSize );
+        }
+    }
+
+    if ( !valid )
+    {
+        Logger::Log( OutputMessageType::Warning, L"Ignoring invalid font atlas cache file %s\n", cacheFile );
+    }
+    delete[] data;
+    return valid;
+}
+
+//---------------------------------------------------------------------------
+void Font::SaveAtlasCache( const WCHAR* cacheFile, const void* pixels )
+{
+    FontAtlasFileHeader header;
+    SecureZeroMemory( &header, sizeof(header) );
+    header.magic                = s_atlasFileMagic;
+    header.version              = s_atlasFileVersion;
+    wcsncpy_s( header.fontName, m_fontName.c_str(), _TRUNCATE );
+    header.pixelFontSize        = m_pixelFontSize;
+    header.fontStyles           = m_fontStyles;
+    header.antiAliased          = m_antiAliased ? 1 : 0;
+    header.numChars             = s_NumChars;
+    header.atlasTextureWidth    = m_sizeInfo.atlasTextureWidth;
+    header.atlasTextureHeight   = m_sizeInfo.atlasTextureHeight;
+    header.characterRowHeight   = m_sizeInfo.characterRowHeight;
+    header.spaceCharacterWidth  = m_sizeInfo.spaceCharacterWidth;
+    header.gapBetweenChars      = m_sizeInfo.gapBetweenChars;
+
+    UINT rectsSize  = s_NumChars * sizeof(ScreenRect);
+    UINT pixelsSize = m_sizeInfo.atlasTextureWidth * m_sizeInfo.atlasTextureHeight * 4;
+    std::vector<uint8_t> data( sizeof(header) + rectsSize + pixelsSize );
+    memcpy( &data[0], &header, sizeof(header) );
+    memcpy( &data[sizeof(header)], m_characterLookup, rectsSize );
+    memcpy( &data[sizeof(header) + rectsSize], pixels, pixelsSize );
+
+    if ( !FileUtils::SaveFile( cacheFile, &data[0], (UINT)data.size() ) )
+    {
+        Logger::Log( OutputMessageType::Warning, L"Failed to write font atlas cache file %s\n", cacheFile );
+    }
+}
 
 void Font::SetMonospace( bool bSet )
 {
@@ -152,6 +318,7 @@
     }
 }
 
+#ifdef _WIN32
 //---------------------------------------------------------------------------
 void GetCharacterSizes(Gdiplus::Font& font, Gdiplus::Graphics& charGraphics, FontAtlasSizeInfo* info /*OUT*/)
 {
@@ -245,19 +412,14 @@ void GetCharacterSizes(Gdiplus::Font& font, Gdiplus::Graphics& charGraphics, Fon
 	}
 }
 
+#endif
+
 //---------------------------------------------------------------------------
-HRESULT CreateAtlasTexture(ID3D11Device* device, Gdiplus::Bitmap& fontSheetBitmap, const FontAtlasSizeInfo* pSizeInfo,
+HRESULT CreateAtlasTexture(ID3D11Device* device, const void* pixels, const FontAtlasSizeInfo* pSizeInfo,
     ID3D11Texture2D** ppD3dTexture, ID3D11ShaderResourceView** ppD3dShaderResourceView )
 {
-    using namespace Gdiplus;
-
 	HRESULT hr = S_OK;
 
-	// Lock the bitmap for direct memory access
-	BitmapData bmData;
-    Rect rect(0, 0, pSizeInfo->atlasTextureWidth, pSizeInfo->atlasTextureHeight );
-	fontSheetBitmap.LockBits(&rect,ImageLockModeRead, PixelFormat32bppARGB, &bmData);  
-
 	// Copy into a texture.
 	D3D11_TEXTURE2D_DESC texDesc;
 	texDesc.Width  = pSizeInfo->atlasTextureWidth;
@@ -273,7 +435,7 @@ void GetCharacterSizes(Gdiplus::Font& font, Gdiplus::Graphics& charGraphics, Fon
 	texDesc.MiscFlags = 0;
 
 	D3D11_SUBRESOURCE_DATA data;        
-	data.pSysMem = bmData.Scan0;
+	data.pSysMem = pixels;
 	data.SysMemPitch = pSizeInfo->atlasTextureWidth * 4;
 	data.SysMemSlicePitch = 0;
 
@@ -288,14 +450,10 @@ void GetCharacterSizes(Gdiplus::Font& font, Gdiplus::Graphics& charGraphics, Fon
 	srvDesc.Texture2D.MostDetailedMip = 0;
 
 	hr = device->CreateShaderResourceView(*ppD3dTexture, &srvDesc, ppD3dShaderResourceView );
-	if(FAILED(hr))
-		return hr;
-
-	fontSheetBitmap.UnlockBits(&bmData);  
-
 	return hr;
 }
 
+#ifdef _WIN32
 //---------------------------------------------------------------------------
 int GetCharMinX(Gdiplus::Bitmap& charBitmap)
 {
@@ -372,3 +530,4 @@ int GetCharMaxX(Gdiplus::Bitmap& charBitmap)
     assert( false );
     return Gdiplus::FontStyleRegular;
 }
+#endif
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include "../Core/Object.h"
 
 #include "../Renderer/Resource.h"
@@ -50,6 +51,8 @@ class Font : public Object
                                                 bool antiAliased=true);
             virtual ~Font();
 
+            // unique for the life of the process, unlike the address of the font.
+            uint32_t                    GetSerial()                 { return m_serial; }
             const WCHAR*                GetFontName()               { return m_fontName.c_str(); }
             float                       GetFontSize()               { return m_pixelFontSize; }
             FontStyleFlags              GetFontStyleFlags()         { return m_fontStyles; }
@@ -72,8 +75,16 @@ class Font : public Object
                                                 const WCHAR* fontName, 
                                                 float pixelFontSize, 
                                                 FontStyleFlags fontStyles, 
-                                                bool antiAliased );
+                                                bool antiAliased,
+                                                const WCHAR* cacheFile );
 
+                                            // The atlas of a font, size and style is built once with GDI+
+                                            // and stored in the font cache directory.
+            std::wstring                GetAtlasCacheFile();
+            bool                        LoadAtlasCache( const WCHAR* cacheFile, std::vector<uint8_t>* pixels );
+            void                        SaveAtlasCache( const WCHAR* cacheFile, const void* pixels );
+
+            uint32_t                    m_serial;
             std::wstring                m_fontName;
             float                       m_pixelFontSize;
             FontStyleFlags              m_fontStyles;
@@ -14,9 +14,13 @@
 #include "DeviceManager.h"
 #include "RenderState.h"
 #include "RenderUtil.h"
+#include "EngineShaders.h"
 #include "../VectorMath/V3dMath.h"
 #include "RenderContext.h"
 #include "GpuResourceFactory.h"
+#include "TransientBuffer.h"
+#include "../Core/Hasher.h"
+#include <algorithm>
 
 using namespace LvEdEngine;
 using namespace LvEdEngine::LvEdFonts;
@@ -27,7 +31,6 @@
 
 static ID3D11RasterizerState*   CreateFontRasterState(ID3D11Device* device);
 static ID3D11BlendState*        CreateTransparentBlendState(ID3D11Device* device);
-static ID3D11Buffer*            CreateFontVertexBuffer(ID3D11Device* device, UINT maxBatches, UINT stride);
 static ID3D11Buffer*            CreateFontIndexBuffer(ID3D11Device* device, UINT maxBatches );
 
 //---------------------------------------------------------------------------
@@ -72,7 +75,6 @@ static float3 ScrnPtToNDC( RenderContext* rc, int x, int y, int z )
 //---------------------------------------------------------------------------
 FontRenderer::FontRenderer()
   : m_deviceManager(NULL),
-    m_vertexBuffer(NULL),
     m_indexBuffer(NULL),
     m_vertexShader(NULL),
     m_pixelShader(NULL),
@@ -87,14 +89,14 @@ static float3 ScrnPtToNDC( RenderContext* rc, int x, int y, int z )
     m_targetY(0),
     m_currX(0),
     m_currY(0),
-    m_scale(1.0f)
+    m_scale(1.0f),
+    m_frame(0)
 {
 }
 
 //---------------------------------------------------------------------------
 FontRenderer::~FontRenderer()
 {
-    SAFE_RELEASE( m_vertexBuffer );
     SAFE_RELEASE( m_indexBuffer );
     SAFE_RELEASE( m_vertexShader );
     SAFE_RELEASE( m_pixelShader );
@@ -125,10 +127,10 @@ static float3 ScrnPtToNDC( RenderContext* rc, int x, int y, int z )
     m_deviceManager = pDeviceManager;
     m_fontDrawOps.reserve( GetMaxBatch() );
 
-    ID3DBlob* pVSBlob = CompileShaderFromResource(L"FontShader.hlsl", "VS","vs_4_0", NULL);
+    ID3DBlob* pVSBlob = EngineShader::Compile(EngineShader::FontVS);
     assert(pVSBlob);
 
-    ID3DBlob* pPSBlob = CompileShaderFromResource(L"FontShader.hlsl", "PS","ps_4_0", NULL);
+    ID3DBlob* pPSBlob = EngineShader::Compile(EngineShader::FontPS);
     assert(pPSBlob);
 
     m_vertexShader = GpuResourceFactory::CreateVertexShader(pVSBlob);
@@ -140,9 +142,6 @@ static float3 ScrnPtToNDC( RenderContext* rc, int x, int y, int z )
     m_vertexLayout = GpuResourceFactory::CreateInputLayout(pVSBlob, VertexFormat::VF_PTC);
     assert(m_vertexLayout);
 
-    m_vertexBuffer = CreateFontVertexBuffer( m_deviceManager->GetDevice(), (UINT)GetMaxBatch(), sizeof(FontTextVertex) );
-    assert(m_vertexBuffer);
-
     m_indexBuffer = CreateFontIndexBuffer( m_deviceManager->GetDevice(), (UINT)GetMaxBatch() );
     assert(m_indexBuffer);
 
@@ -155,29 +154,6 @@ static float3 ScrnPtToNDC( RenderContext* rc, int x, int y, int z )
     assert(m_blendState);
 }
 
-//-------------------------------------------------------------------------------------------------
-ID3D11Buffer* CreateFontVertexBuffer(ID3D11Device* device, UINT maxBatches, UINT stride )
-{
-    HRESULT hr = S_OK;
-
-    D3D11_BUFFER_DESC vbd;
-    vbd.ByteWidth = ( maxBatches * kVerticesPerQuad * stride );
-    vbd.Usage = D3D11_USAGE_DYNAMIC;
-    vbd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-    vbd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-    vbd.MiscFlags = 0;
-    vbd.StructureByteStride = 0;
-
-    ID3D11Buffer* buff = NULL;
-    hr = device->CreateBuffer(&vbd, 0, &buff);
-    if (Logger::IsFailureLog(hr))
-    {
-        return NULL;
-    }
-
-    return buff;
-}
-
 //-------------------------------------------------------------------------------------------------
 ID3D11Buffer* CreateFontIndexBuffer(ID3D11Device* device, UINT maxBatches )
 {
@@ -309,7 +285,7 @@ static float3 ScrnPtToNDC( RenderContext* rc, int x, int y, int z )
 //---------------------------------------------------------------------------
 void FontRenderer::FontDrawingBegin(  RenderContext* rc )
 {
-    assert( m_vertexBuffer != NULL );
+    assert( TransientBuffer::Inst()->GetBuffer() != NULL );
     assert( m_indexBuffer != NULL );
 
     m_currentRC = rc;
@@ -324,9 +300,10 @@ static float3 ScrnPtToNDC( RenderContext* rc, int x, int y, int z )
 
     UINT stride = sizeof(FontTextVertex);
     UINT offset = 0;
+    ID3D11Buffer* vertexBuffer = TransientBuffer::Inst()->GetBuffer();
     dc->IASetInputLayout(m_vertexLayout);
     dc->IASetIndexBuffer(m_indexBuffer, DXGI_FORMAT_R32_UINT, 0);
-    dc->IASetVertexBuffers(0, 1, &m_vertexBuffer, &stride, &offset);
+    dc->IASetVertexBuffers(0, 1, &vertexBuffer, &stride, &offset);
     dc->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
     dc->VSSetShader( m_vertexShader, 0, 0 );
@@ -366,7 +343,7 @@ static float3 ScrnPtToNDC( RenderContext* rc, int x, int y, int z )
     size_t numRemaining = m_fontDrawOps.size();
     while ( numRemaining > 0 )
     {
-        size_t numToBatch = min( numRemaining, GetMaxBatch() );
+        size_t numToBatch = std::min( numRemaining, GetMaxBatch() );
         ProcessOneBatch( batchStart, numToBatch );
         batchStart += numToBatch;
         numRemaining -= numToBatch;
@@ -441,10 +418,18 @@ static float3 ScrnPtToNDC( RenderContext* rc, int x, int y, int z )
     // pointer here. The caller may have the text as a WCHAR* and we don't want to force a copy
     // into the FontPrintRequest's vector in that case.
     //
-    for ( const WCHAR* p = msgText; *p != 0; p++ )
+    const TextLayout& layout = GetTextLayout( msgText );
+    for ( auto it = layout.ops.begin(); it != layout.ops.end(); ++it )
     {
-        ProcessChar( *p );
+        FontDrawOp op = *it;
+        op.m_scrnDestRect.topX  += m_currX;
+        op.m_scrnDestRect.bottX += m_currX;
+        op.m_scrnDestRect.topY  += m_currY;
+        op.m_scrnDestRect.bottY += m_currY;
+        m_fontDrawOps.push_back( op );
     }
+    m_currX += layout.endX;
+    m_currY += layout.endY;
 
     FontDrawOpsExecute();
 
@@ -452,6 +437,74 @@ static float3 ScrnPtToNDC( RenderContext* rc, int x, int y, int z )
     SetY( m_currY );
 }
 
+//---------------------------------------------------------------------------
+// Returns the cached layout of msgText in the active font, laying it out on a miss.
+const FontRenderer::TextLayout& FontRenderer::GetTextLayout( const WCHAR* msgText )
+{
+    uint32_t fontSerial = m_activeFont->GetSerial();
+    bool monoSpace = m_activeFont->GetMonospace();
+    uint32_t key = Hash32( msgText, Hash32InitialValue ^ ( fontSerial * 2 + ( monoSpace ? 1 : 0 ) ) );
+
+    std::pair<TextLayoutMap::iterator, TextLayoutMap::iterator> range = m_layoutCache.equal_range( key );
+    for ( auto it = range.first; it != range.second; ++it )
+    {
+        TextLayout& layout = it->second;
+        if ( layout.fontSerial == fontSerial && layout.monoSpace == monoSpace && layout.text == msgText )
+        {
+            layout.lastUsedFrame = m_frame;
+            return layout;
+        }
+    }
+
+    TextLayoutMap::iterator it = m_layoutCache.insert( std::make_pair( key, TextLayout() ) );
+    TextLayout& layout = it->second;
+    layout.text = msgText;
+    layout.fontSerial = fontSerial;
+    layout.monoSpace = monoSpace;
+    layout.lastUsedFrame = m_frame;
+
+    // lay the string out at (0,0); ProcessChar() appends to m_fontDrawOps
+    // and returns to m_targetX on '\n'.
+    int currX = m_currX;
+    int currY = m_currY;
+    int targetX = m_targetX;
+    m_currX = m_currY = m_targetX = 0;
+    m_fontDrawOps.swap( layout.ops );
+    for ( const WCHAR* p = msgText; *p != 0; p++ )
+    {
+        ProcessChar( *p );
+    }
+    m_fontDrawOps.swap( layout.ops );
+    layout.endX = m_currX;
+    layout.endY = m_currY;
+    m_currX = currX;
+    m_currY = currY;
+    m_targetX = targetX;
+    return layout;
+}
+
+//---------------------------------------------------------------------------
+// Drops the layouts that weren't used in the last kLayoutCacheFrames frames.
+void FontRenderer::TrimLayoutCache()
+{
+    m_frame++;
+    if ( ( m_frame % kLayoutCacheFrames ) != 0 )
+    {
+        return;
+    }
+    for ( auto it = m_layoutCache.begin(); it != m_layoutCache.end(); )
+    {
+        if ( m_frame - it->second.lastUsedFrame > kLayoutCacheFrames )
+        {
+            it = m_layoutCache.erase( it );
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
 //---------------------------------------------------------------------------
 void FontRenderer::ProcessChar( WCHAR aChar )
 {
@@ -486,8 +539,14 @@ static float3 ScrnPtToNDC( RenderContext* rc, int x, int y, int z )
 //---------------------------------------------------------------------------
 void FontRenderer::ProcessOneBatch( size_t startIndex, size_t numToProcess )
 {
+    INT baseVertex = 0;
     { // We want buffAccess to go out of scope before we call DrawIndexed().
-        VertexBufferAccessor buffAccess( m_currentRC->Context(), m_vertexBuffer );
+        VertexBufferAccessor buffAccess( m_currentRC->Context(), (UINT)( numToProcess * kVerticesPerQuad ) );
+        if ( buffAccess.VertexData() == NULL )
+        {
+            return;
+        }
+        baseVertex = (INT)buffAccess.FirstVertex();
 
         size_t destOfs = 0;
         for( unsigned int i = 0; i < numToProcess; ++i)
@@ -498,7 +557,7 @@ static float3 ScrnPtToNDC( RenderContext* rc, int x, int y, int z )
         }
     }
 
-    m_currentRC->Context()->DrawIndexed(((UINT)numToProcess * kIndexElementsPerQuad ), 0, 0);
+    m_currentRC->Context()->DrawIndexed(((UINT)numToProcess * kIndexElementsPerQuad ), 0, baseVertex);
 }
 
 //---------------------------------------------------------------------------
@@ -519,6 +578,7 @@ static float3 ScrnPtToNDC( RenderContext* rc, int x, int y, int z )
 
     m_printRequests.clear();
     m_stringBlob.clear();
+    TrimLayoutCache();
 
     FontDrawingEnd();
 }
@@ -533,20 +593,24 @@ static float3 ScrnPtToNDC( RenderContext* rc, int x, int y, int z )
 //===========================================================================
 
 //---------------------------------------------------------------------------
-// Constructor makes buffer data available in VertexData()
-FontRenderer::VertexBufferAccessor::VertexBufferAccessor( ID3D11DeviceContext* context, ID3D11Buffer* vertexBuffer )
-    : m_context( context ), m_vertexBuffer( vertexBuffer )
+// Constructor maps vertexCount vertices of the transient buffer, VertexData() is NULL if that fails.
+FontRenderer::VertexBufferAccessor::VertexBufferAccessor( ID3D11DeviceContext* context, UINT vertexCount )
+    : m_context( context ), m_buffer( NULL )
 {
-    D3D11_MAPPED_SUBRESOURCE subResource;
-    m_context->Map(m_vertexBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &subResource);
-    m_buffer = reinterpret_cast<FontTextVertex*>(subResource.pData);
+    if ( TransientBuffer::Inst()->Map( m_context, sizeof(FontTextVertex), vertexCount, &m_alloc ) )
+    {
+        m_buffer = reinterpret_cast<FontTextVertex*>( m_alloc.data );
+    }
 }
 
 //---------------------------------------------------------------------------
 // Destructor does the necessary cleanup.
 FontRenderer::VertexBufferAccessor::~VertexBufferAccessor()
 {
-    m_context->Unmap(m_vertexBuffer, 0);
+    if ( m_buffer )
+    {
+        TransientBuffer::Inst()->Unmap( m_context );
+    }
 }
 
 
@@ -10,9 +10,12 @@
 
 #include <d3d11.h>
 #include <vector>
+#include <map>
+#include <string>
 #include "FontTypes.h"
 #include "../Core/StringBlob.h"
 #include "../Core/NonCopyable.h"
+#include "TransientBuffer.h"
 
 namespace LvEdEngine
 {
@@ -155,12 +158,13 @@ class FontDrawOp
             class VertexBufferAccessor : public NonCopyable
             {
             public:
-                VertexBufferAccessor( ID3D11DeviceContext* context, ID3D11Buffer* vertexBuffer );
+                VertexBufferAccessor( ID3D11DeviceContext* context, UINT vertexCount );
                 ~VertexBufferAccessor();
                 FontRenderer::FontTextVertex* VertexData()  { return m_buffer; }
+                UINT FirstVertex() const { return m_alloc.firstVertex; }
             private:
                 ID3D11DeviceContext*    m_context;
-                ID3D11Buffer*           m_vertexBuffer;
+                TransientAlloc          m_alloc;
                 FontTextVertex*         m_buffer;
             };
 
@@ -177,8 +181,7 @@ class VertexBufferAccessor : public NonCopyable
             DeviceManager*          m_deviceManager;
             RenderContext*          m_currentRC;   // transient
 
-            ID3D11Buffer*           m_vertexBuffer;
-            ID3D11Buffer*           m_indexBuffer;
+            ID3D11Buffer*           m_indexBuffer;     // quads, the vertices are in the TransientBuffer.
             ID3D11VertexShader*     m_vertexShader;
             ID3D11PixelShader*      m_pixelShader;
             ID3D11InputLayout*      m_vertexLayout;
@@ -215,13 +218,40 @@ class FontPrintRequest
                 float4 colorRGBA;
                 size_t m_msgIndex;       // To obtain the string from m_stringBlob.
             };
-            typedef StringBlob<WCHAR,8192> StringBlob;
+            typedef LvEdEngine::StringBlob<WCHAR,8192> StringBlob;
             typedef std::vector<FontPrintRequest> FontPrintRequestList;
             StringBlob m_stringBlob;
             FontPrintRequestList  m_printRequests;
 
             void    SendTextToScreen( const FontPrintRequest& printReq, const WCHAR* msgText );
 
+            //
+            //  Text Layout Cache
+            //
+            //  The draw ops of a string, relative to where the string starts,
+            //  are kept for the strings drawn in the last kLayoutCacheFrames
+            //  frames, so overlays and labels that don't change aren't laid
+            //  out again every frame.
+            //
+            class TextLayout
+            {
+            public:
+                std::wstring    text;
+                uint32_t        fontSerial;
+                bool            monoSpace;
+                int             endX;           // cursor after the string, relative to the start.
+                int             endY;
+                uint32_t        lastUsedFrame;
+                FontDrawOpArray ops;
+            };
+            typedef std::multimap<uint32_t, TextLayout> TextLayoutMap;  // keyed by hash.
+            static const uint32_t kLayoutCacheFrames = 64;
+            TextLayoutMap   m_layoutCache;
+            uint32_t        m_frame;
+
+            const TextLayout&   GetTextLayout( const WCHAR* msgText );
+            void                TrimLayoutCache();
+
             static FontRenderer*  s_Inst;
 
         };
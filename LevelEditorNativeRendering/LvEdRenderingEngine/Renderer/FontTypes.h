@@ -3,7 +3,7 @@
 #pragma once
 
 #include <stdint.h>
-#include "..\VectorMath\V3dMath.h"
+#include "../VectorMath/V3dMath.h"
 
 namespace LvEdEngine
 {
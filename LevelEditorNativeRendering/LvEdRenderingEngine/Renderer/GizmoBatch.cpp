@@ -0,0 +1,115 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    GizmoBatch.cpp
+
+****************************************************************************/
+#include "GizmoBatch.h"
+#include <algorithm>
+#include <xmmintrin.h>
+#include "Model.h"
+#include "TransientBuffer.h"
+
+using namespace LvEdEngine;
+
+//---------------------------------------------------------------------------
+GizmoBatch::GizmoBatch()
+  : m_nodes(NULL),
+    m_next(0),
+    m_buffer(NULL)
+{
+}
+
+//---------------------------------------------------------------------------
+bool GizmoBatch::ItemSorting(const Item& a, const Item& b)
+{
+    if(a.mesh != b.mesh)
+        return a.mesh < b.mesh;
+    if(a.texture != b.texture)
+        return a.texture < b.texture;
+    return a.index < b.index;
+}
+
+//---------------------------------------------------------------------------
+void GizmoBatch::Begin(const FrameNodeList& nodes, bool useTextures, Texture* defaultTexture, bool keepOrder)
+{
+    m_nodes = &nodes;
+    m_next = 0;
+    m_buffer = NULL;
+    m_runs.clear();
+    m_items.resize(nodes.size());
+    for(uint32_t i = 0; i < (uint32_t)nodes.size(); ++i)
+    {
+        const RenderableNode& r = nodes[i];
+        Item& item = m_items[i];
+        item.mesh = r.mesh;
+        item.texture = (useTextures && r.textures[TextureType::DIFFUSE]) ? r.textures[TextureType::DIFFUSE] : defaultTexture;
+        item.index = i;
+    }
+    if(!keepOrder)
+        std::sort(m_items.begin(), m_items.end(), ItemSorting);
+}
+
+//---------------------------------------------------------------------------
+// writes the world matrix as columns, the shader takes a dot product per
+// row, the texture transform and the color. Sequential 16 byte stores suit
+// the write-combined memory of the mapped buffer.
+static void WriteInstance(const RenderableNode& r, GizmoInstance* inst)
+{
+    const float* m = &r.WorldXform.M11;
+    __m128 row0 = _mm_loadu_ps(m);
+    __m128 row1 = _mm_loadu_ps(m + 4);
+    __m128 row2 = _mm_loadu_ps(m + 8);
+    __m128 row3 = _mm_loadu_ps(m + 12);
+    _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+    const Matrix& t = r.TextureXForm;
+    float* dest = &inst->world[0].x;
+    _mm_storeu_ps(dest,      row0);
+    _mm_storeu_ps(dest + 4,  row1);
+    _mm_storeu_ps(dest + 8,  row2);
+    _mm_storeu_ps(dest + 12, _mm_setr_ps(t.M11, t.M21, t.M41, 0));
+    _mm_storeu_ps(dest + 16, _mm_setr_ps(t.M12, t.M22, t.M42, 0));
+    _mm_storeu_ps(dest + 20, _mm_loadu_ps(&r.diffuse.x));
+}
+
+//---------------------------------------------------------------------------
+bool GizmoBatch::Next(ID3D11DeviceContext* dc)
+{
+    m_runs.clear();
+    uint32_t total = (uint32_t)m_items.size();
+    if(m_next >= total)
+        return false;
+
+    TransientBuffer* transient = TransientBuffer::Inst();
+    uint32_t count = transient->GetMaxCount(sizeof(GizmoInstance));
+    if(count > total - m_next)
+        count = total - m_next;
+
+    TransientAlloc alloc;
+    if(count == 0 || !transient->Map(dc, sizeof(GizmoInstance), count, &alloc))
+    {
+        m_next = total;
+        return false;
+    }
+
+    GizmoInstance* instances = (GizmoInstance*)alloc.data;
+    for(uint32_t i = 0; i < count; ++i)
+    {
+        const Item& item = m_items[m_next + i];
+        const RenderableNode& r = (*m_nodes)[item.index];
+        WriteInstance(r, instances + i);
+
+        if(m_runs.empty() || m_runs.back().node->mesh != item.mesh || m_runs.back().texture != item.texture)
+        {
+            Run run = { &r, item.texture, alloc.firstVertex + i, 0 };
+            m_runs.push_back(run);
+        }
+        m_runs.back().instanceCount++;
+    }
+    transient->Unmap(dc);
+
+    m_buffer = alloc.buffer;
+    m_next += count;
+    return true;
+}
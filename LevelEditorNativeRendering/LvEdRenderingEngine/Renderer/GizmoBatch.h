@@ -0,0 +1,77 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    GizmoBatch.h
+
+    Instanced drawing of the small nodes the editor has many of: billboards,
+    light icons, curve control points. The nodes of a bucket are grouped by
+    mesh and texture and the per node data goes to one instance stream in
+    the TransientBuffer, so every group is a single draw.
+****************************************************************************/
+#pragma once
+
+#include "Renderable.h"
+#include "../Core/NonCopyable.h"
+
+struct ID3D11DeviceContext;
+struct ID3D11Buffer;
+
+namespace LvEdEngine
+{
+    class Mesh;
+    class Texture;
+
+    // per instance data, matches the INSTWORLD, INSTUV and INSTCOLOR
+    // elements added by GpuResourceFactory::CreateInputLayout().
+    struct GizmoInstance
+    {
+        float4 world[3];    // the first three columns of the world matrix.
+        float4 uvXform[2];  // the texture transform applied to (u, v, 1).
+        float4 color;
+    };
+
+    class GizmoBatch : public NonCopyable
+    {
+    public:
+        // nodes with the same mesh and texture, drawn with one instanced draw.
+        struct Run
+        {
+            const RenderableNode* node;     // the first node of the run.
+            Texture*              texture;
+            uint32_t              startInstance;
+            uint32_t              instanceCount;
+        };
+
+        GizmoBatch();
+
+        // Groups the nodes by mesh and by diffuse texture, if useTextures is
+        // set, nodes without a texture use defaultTexture. With keepOrder only
+        // neighbouring nodes are grouped, for back to front sorted buckets.
+        // The nodes must stay unchanged until Next() returns false.
+        void Begin(const FrameNodeList& nodes, bool useTextures, Texture* defaultTexture, bool keepOrder);
+
+        // Writes the instances of the next runs to the transient buffer,
+        // as many as fit in one map. Returns false when all nodes are done.
+        bool Next(ID3D11DeviceContext* dc);
+
+        // the instance buffer and the runs of the last Next().
+        ID3D11Buffer* GetInstanceBuffer() const { return m_buffer; }
+        uint32_t GetRunCount() const { return (uint32_t)m_runs.size(); }
+        const Run& GetRun(uint32_t index) const { return m_runs[index]; }
+
+    private:
+        struct Item
+        {
+            const Mesh* mesh;
+            Texture*    texture;
+            uint32_t    index;  // in the nodes.
+        };
+        static bool ItemSorting(const Item& a, const Item& b);
+
+        const FrameNodeList*  m_nodes;
+        FrameVector<Item>     m_items;
+        FrameVector<Run>      m_runs;
+        uint32_t              m_next;
+        ID3D11Buffer*         m_buffer;
+    };
+}
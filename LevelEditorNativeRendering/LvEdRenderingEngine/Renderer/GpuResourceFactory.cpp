@@ -4,11 +4,10 @@
 
 static ID3D11Device* s_device = NULL;
 void GpuResourceFactory::SetDevice(ID3D11Device* device) { s_device = device; }
-static uint32_t GetSizeInBytes(VertexFormatEnum vf);
 
 VertexBuffer* GpuResourceFactory::CreateVertexBuffer(void* data, VertexFormatEnum vf, uint32_t count, uint32_t bufferUsage)
 {    
-    uint32_t vertexSize = GetSizeInBytes(vf);
+    uint32_t vertexSize = GetVertexSize(vf);
 
     HRESULT hr = S_OK;
     UINT cpuAccess = 0;
@@ -103,9 +102,9 @@ static void SetLayout(D3D11_INPUT_ELEMENT_DESC * desc, LPCSTR name, UINT index,
     desc->InstanceDataStepRate = rate;
 }
 
-ID3D11InputLayout* GpuResourceFactory::CreateInputLayout(void* code, uint32_t codeSize, VertexFormatEnum vf)
+ID3D11InputLayout* GpuResourceFactory::CreateInputLayout(void* code, uint32_t codeSize, VertexFormatEnum vf, bool gizmoInstances)
 {
-    D3D11_INPUT_ELEMENT_DESC elements[10];
+    D3D11_INPUT_ELEMENT_DESC elements[16];
     uint32_t numelements = 0;
     switch(vf)
     {    
@@ -157,6 +156,19 @@ static void SetLayout(D3D11_INPUT_ELEMENT_DESC * desc, LPCSTR name, UINT index,
         break;
     }
 
+    if(gizmoInstances && numelements > 0)
+    {
+        // GizmoInstance, one per instance.
+        D3D11_INPUT_ELEMENT_DESC* inst = &elements[numelements];
+        SetLayout(&inst[0], "INSTWORLD", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 0, D3D11_INPUT_PER_INSTANCE_DATA, 1);
+        SetLayout(&inst[1], "INSTWORLD", 1, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, 1);
+        SetLayout(&inst[2], "INSTWORLD", 2, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, 1);
+        SetLayout(&inst[3], "INSTUV",    0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, 1);
+        SetLayout(&inst[4], "INSTUV",    1, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, 1);
+        SetLayout(&inst[5], "INSTCOLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, 1);
+        numelements += 6;
+    }
+
     ID3D11InputLayout* layout = NULL;
     HRESULT hr = S_OK;
     if(numelements > 0)
@@ -346,7 +358,7 @@ static void SetLayout(D3D11_INPUT_ELEMENT_DESC * desc, LPCSTR name, UINT index,
 
 
 //-------------------------------------------------------------------------------------------------
-static uint32_t GetSizeInBytes(VertexFormatEnum vf)
+uint32_t GpuResourceFactory::GetVertexSize(VertexFormatEnum vf)
 {   
     uint32_t size = 0;
     switch(vf)
@@ -42,6 +42,9 @@ class GpuResourceFactory
     // set the device used for creating resources.
     static void SetDevice(ID3D11Device* device);
 
+    // size in bytes of one vertex of the given format.
+    static uint32_t GetVertexSize(VertexFormatEnum vf);
+
     // Create vertex buffer
     // data:  source data it can be null if the buffer usage is dynamic.
     // vf  : see VertexFormatEnum
@@ -64,10 +67,11 @@ class GpuResourceFactory
     // code : compiled shader code with With input signature
     // codeSize: code size in bytes
     // vf: vertex format
-    static ID3D11InputLayout* CreateInputLayout(void* code, uint32_t codeSize, VertexFormatEnum vf);
-    static ID3D11InputLayout* CreateInputLayout(ID3DBlob* blob, VertexFormatEnum vf)
+    // gizmoInstances adds the GizmoInstance elements in slot 1, see GizmoBatch.
+    static ID3D11InputLayout* CreateInputLayout(void* code, uint32_t codeSize, VertexFormatEnum vf, bool gizmoInstances = false);
+    static ID3D11InputLayout* CreateInputLayout(ID3DBlob* blob, VertexFormatEnum vf, bool gizmoInstances = false)
     {
-        if(blob) return CreateInputLayout(blob->GetBufferPointer(), (uint32_t)blob->GetBufferSize(),vf);
+        if(blob) return CreateInputLayout(blob->GetBufferPointer(), (uint32_t)blob->GetBufferSize(),vf,gizmoInstances);
         return NULL;
     }
 
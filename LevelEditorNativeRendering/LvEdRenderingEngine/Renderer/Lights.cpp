@@ -1,7 +1,7 @@
 //Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
 
 #include "Lights.h"
-#include <set>
+#include <map>
 #include "../VectorMath/V3dMath.h"
 #include "../VectorMath/CollisionPrimitives.h"
 #include "Renderable.h"
@@ -9,6 +9,26 @@
 namespace LvEdEngine
 {
 
+// max number of light changes kept for IsStale() queries.
+// cached environments older than the oldest logged change are always recomputed.
+static const size_t MaxLightChanges = 256;
+
+// region affected by a directional light, it is unbounded.
+static AABB UnboundedRegion()
+{
+    return AABB(float3(-FLT_MAX, -FLT_MAX, -FLT_MAX), float3(FLT_MAX, FLT_MAX, FLT_MAX));
+}
+
+//-------------------------------------------------------------------------------------------------
+static AABB PointLightRegion(const PointLight& light)
+{
+    float3 pos = float3(light.position.x, light.position.y, light.position.z);
+    float radius = light.position.w;
+    float3 ll(pos.x - radius, pos.y - radius, pos.z - radius);
+    float3 ur(pos.x + radius, pos.y + radius, pos.z + radius);
+    return AABB(ll, ur);
+}
+
 //-------------------------------------------------------------------------------------------------
 LightingState::LightingState()
 {
@@ -26,6 +46,12 @@ namespace LvEdEngine
 
     m_noPointLight.ambient = m_noPointLight.diffuse = m_noPointLight.specular = float3(0,0,0);
     m_noPointLight.position = float4(0,0,0,0);
+
+    m_defaultDirLight = DirLight();
+    m_defaultDirLightLast = m_defaultDirLight;
+
+    // zero is reserved for stamps that were never computed.
+    m_version = 1;
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -41,7 +67,7 @@ namespace LvEdEngine
     DirLight* light = DefaultDirLight();
     if(m_dirLights.size())
     {
-        light = *(m_dirLights.begin());
+        light = m_dirLights.begin()->first;
     }
     return light;
 }
@@ -50,7 +76,8 @@ namespace LvEdEngine
 DirLight* LightingState::CreateDirLight()
 {
     DirLight * light = new DirLight();
-    m_dirLights.insert(light);
+    m_dirLights[light] = *light;
+    LogChange(UnboundedRegion());
     return light;
 }
 
@@ -58,7 +85,8 @@ namespace LvEdEngine
 BoxLight* LightingState::CreateBoxLight()
 {
     BoxLight * light = new BoxLight();
-    m_boxLights.insert(light);
+    m_boxLights[light] = *light;
+    LogChange(AABB(light->min, light->max));
     return light;
 }
 
@@ -66,7 +94,8 @@ namespace LvEdEngine
 PointLight* LightingState::CreatePointLight()
 {
     PointLight * light = new PointLight();
-    m_pointLights.insert(light);
+    m_pointLights[light] = *light;
+    LogChange(PointLightRegion(*light));
     return light;
 }
 
@@ -74,23 +103,140 @@ namespace LvEdEngine
 void LightingState::DestroyDirLight(DirLight* light)
 {
     m_dirLights.erase(light);
+    LogChange(UnboundedRegion());
     delete light;
 }
 
 //-------------------------------------------------------------------------------------------------
 void LightingState::DestroyBoxLight(BoxLight* light)
 {
-    m_boxLights.erase(light);
+    auto it = m_boxLights.find(light);
+    if(it != m_boxLights.end())
+    {
+        LogChange(AABB(it->second.min, it->second.max));
+        m_boxLights.erase(it);
+    }
+    LogChange(AABB(light->min, light->max));
     delete light;
 }
 
 //-------------------------------------------------------------------------------------------------
 void LightingState::DestroyPointLight(PointLight* light)
 {
-    m_pointLights.erase(light);
+    auto it = m_pointLights.find(light);
+    if(it != m_pointLights.end())
+    {
+        LogChange(PointLightRegion(it->second));
+        m_pointLights.erase(it);
+    }
+    LogChange(PointLightRegion(*light));
     delete light;
 }
 
+//-------------------------------------------------------------------------------------------------
+void LightingState::LightChanged(DirLight* light)
+{
+    DirLight* last = NULL;
+    if(light == &m_defaultDirLight)
+    {
+        last = &m_defaultDirLightLast;
+    }
+    else
+    {
+        auto it = m_dirLights.find(light);
+        if(it == m_dirLights.end()) return;
+        last = &it->second;
+    }
+
+    if(memcmp(last, light, sizeof(DirLight)) != 0)
+    {
+        *last = *light;
+        LogChange(UnboundedRegion());
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+void LightingState::LightChanged(BoxLight* light)
+{
+    auto it = m_boxLights.find(light);
+    if(it == m_boxLights.end()) return;
+
+    BoxLight& last = it->second;
+    if(memcmp(&last, light, sizeof(BoxLight)) != 0)
+    {
+        // objects that were inside the old box or are inside the new one are affected.
+        LogChange(AABB(last.min, last.max));
+        LogChange(AABB(light->min, light->max));
+        last = *light;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+void LightingState::LightChanged(PointLight* light)
+{
+    auto it = m_pointLights.find(light);
+    if(it == m_pointLights.end()) return;
+
+    PointLight& last = it->second;
+    if(memcmp(&last, light, sizeof(PointLight)) != 0)
+    {
+        LogChange(PointLightRegion(last));
+        LogChange(PointLightRegion(*light));
+        last = *light;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+void LightingState::LogChange(const AABB& region)
+{
+    if(m_changes.size() >= MaxLightChanges)
+    {
+        m_changes.erase(m_changes.begin(), m_changes.begin() + MaxLightChanges / 2);
+    }
+
+    ++m_version;
+    LightChange change;
+    change.version = m_version;
+    change.region = region;
+    m_changes.push_back(change);
+}
+
+//-------------------------------------------------------------------------------------------------
+bool LightingState::IsStale(const LightEnvStamp& stamp, const AABB& bounds, uint32_t boundsVersion) const
+{
+    if(stamp.lightVersion == 0 || stamp.boundsVersion != boundsVersion)
+        return true;
+
+    if(stamp.lightVersion == m_version)
+        return false;
+
+    // the changes made after the stamp are no longer logged.
+    if(m_changes.empty() || stamp.lightVersion + 1 < m_changes.front().version)
+        return true;
+
+    for(auto it = m_changes.rbegin(); it != m_changes.rend() && it->version > stamp.lightVersion; ++it)
+    {
+        if(TestAABBAABB(bounds, it->region))
+            return true;
+    }
+    return false;
+}
+
+//-------------------------------------------------------------------------------------------------
+bool LightingState::UpdateLightEnvironment(LightEnvironment& env, const AABB& bounds,
+                                           uint32_t boundsVersion, LightEnvStamp& stamp)
+{
+    bool stale = IsStale(stamp, bounds, boundsVersion);
+    if(stale)
+    {
+        UpdateLightEnvironment(env, bounds);
+    }
+    stamp.lightVersion = m_version;
+    stamp.boundsVersion = boundsVersion;
+    return stale;
+}
+
+//-------------------------------------------------------------------------------------------------
 void LightingState::UpdateLightEnvironment( RenderableNode& r )
 {    
     UpdateLightEnvironment(r.lighting,r.bounds);
@@ -109,7 +255,7 @@ namespace LvEdEngine
     {
         for(auto it = m_dirLights.begin(); it != m_dirLights.end(); ++it)
         {                        
-            env.dir[env.numDirLights++] = *(*it);
+            env.dir[env.numDirLights++] = *(it->first);
             if(env.numDirLights >= MAX_DIR_LIGHTS)
             {
                 break;
@@ -124,7 +270,7 @@ namespace LvEdEngine
     // gather box lights
     for(auto it = m_boxLights.begin(); it != m_boxLights.end(); ++it)
     {
-        BoxLight  light = *(*it);
+        BoxLight  light = *(it->first);
         AABB lightBounds(light.min, light.max);
 
         if(TestAABBAABB(bounds, lightBounds))
@@ -140,14 +286,10 @@ namespace LvEdEngine
     // gather point lights
     for(auto it = m_pointLights.begin(); it != m_pointLights.end(); ++it)
     {
-        PointLight  light = *(*it);
+        PointLight  light = *(it->first);
 
         // build an AABB for the sphere and test.
-        float3 pos = float3(light.position.x, light.position.y, light.position.z);
-        float radius = light.position.w;
-        float3 ll(pos.x - radius, pos.y - radius, pos.z - radius);
-        float3 ur(pos.x + radius, pos.y + radius, pos.z + radius);
-        AABB sphereBounds(ll, ur);
+        AABB sphereBounds = PointLightRegion(light);
         if(TestAABBAABB(bounds, sphereBounds))
         {
             env.point[env.numPointLights++] = light;
@@ -4,7 +4,8 @@
 #include "../VectorMath/V3dMath.h"
 #include "../VectorMath/CollisionPrimitives.h"
 #include "../Core/NonCopyable.h"
-#include <set>
+#include <map>
+#include <vector>
 
 namespace LvEdEngine
 {
@@ -75,6 +76,15 @@ struct LightEnvironment
         uint32_t pad1;
     };
 
+    // Identifies the state a cached LightEnvironment was computed from.
+    // A zero lightVersion means the environment was never computed.
+    struct LightEnvStamp
+    {
+        LightEnvStamp() : lightVersion(0), boundsVersion(0) {}
+        uint32_t lightVersion;  // LightingState::Version() at compute time.
+        uint32_t boundsVersion; // version of the bounds used at compute time.
+    };
+
     class LightingState : public NonCopyable
     {
     public:
@@ -91,16 +101,49 @@ class LightingState : public NonCopyable
         PointLight* CreatePointLight();
         void        DestroyPointLight(PointLight* light);
 
+        // Must be called after a light is modified.
+        // Bumps the version if the light differs from its last known state.
+        void        LightChanged(DirLight* light);
+        void        LightChanged(BoxLight* light);
+        void        LightChanged(PointLight* light);
+
+        // Incremented each time a light is created, destroyed or changed.
+        uint32_t    Version() const { return m_version; }
+
         void        UpdateLightEnvironment( RenderableNode& r );
         void        UpdateLightEnvironment(LightEnvironment& env, const AABB& bounds);
 
+        // Recomputes env only if the bounds version differs from the stamp or
+        // a light overlapping bounds changed since the stamp was taken.
+        // returns true if env was recomputed.
+        bool        UpdateLightEnvironment(LightEnvironment& env, const AABB& bounds,
+                                           uint32_t boundsVersion, LightEnvStamp& stamp);
+        bool        IsStale(const LightEnvStamp& stamp, const AABB& bounds, uint32_t boundsVersion) const;
+
     private:
         LightingState();
 
+        // region of the world affected by a light change.
+        struct LightChange
+        {
+            uint32_t version;
+            AABB region;
+        };
+        void        LogChange(const AABB& region);
+
+        // each light is mapped to a copy of its last known state.
+        typedef std::map<DirLight*, DirLight>       DirLightMap;
+        typedef std::map<BoxLight*, BoxLight>       BoxLightMap;
+        typedef std::map<PointLight*, PointLight>   PointLightMap;
+
         DirLight                m_defaultDirLight;
-        std::set<DirLight*>     m_dirLights;
-        std::set<BoxLight*>     m_boxLights;
-        std::set<PointLight*>   m_pointLights;
+        DirLight                m_defaultDirLightLast;
+        DirLightMap             m_dirLights;
+        BoxLightMap             m_boxLights;
+        PointLightMap           m_pointLights;
+
+        uint32_t                m_version;
+        std::vector<LightChange> m_changes;
 
         DirLight                m_noDirLight;
         BoxLight                m_noBoxLight;
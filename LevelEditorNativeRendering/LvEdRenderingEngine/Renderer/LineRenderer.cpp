@@ -2,9 +2,11 @@
 
 #include "LineRenderer.h"
 #include "RenderUtil.h"
+#include "EngineShaders.h"
 #include "RenderContext.h"
 #include "RenderState.h"
 #include "GpuResourceFactory.h"
+#include "TransientBuffer.h"
 
 namespace LvEdEngine
 {
@@ -132,21 +134,26 @@ namespace LvEdEngine
     d3dContext->OMSetDepthStencilState(NULL,0);    
     d3dContext->OMSetBlendState( NULL, NULL, 0xFFFFFFFF );
     
-    ID3D11Buffer* vbuffers[1] = {m_vbPC->GetBuffer()};
-    uint32_t strides[1] = {m_vbPC->GetStride()};
+    TransientBuffer* tb = TransientBuffer::Inst();
+    ID3D11Buffer* vbuffers[1] = {tb->GetBuffer()};
+    uint32_t strides[1] = {sizeof(VertexPC)};
     uint32_t offsets[1] = {0};
     d3dContext->IASetVertexBuffers( 0, 1, vbuffers, strides, offsets );
     
-
-    uint32_t bufSize = m_vbPC->GetCount();
+    // keep the count even, so a line is never split between two draws.
+    uint32_t bufSize = tb->GetMaxCount(sizeof(VertexPC)) & ~1u;
     uint32_t totalVertexCount = (uint32_t) m_vertsPC.size();
     uint32_t start = 0;
     uint32_t count =  (totalVertexCount < bufSize) ? totalVertexCount : bufSize;
     
     while(start < totalVertexCount)
     {        
-        m_vbPC->Update(d3dContext,&m_vertsPC[start],count);        
-        d3dContext->Draw(count,0);
+        TransientAlloc alloc;
+        if(!tb->Map(d3dContext, sizeof(VertexPC), count, &alloc))
+            break;
+        CopyMemory(alloc.data, &m_vertsPC[start], count * sizeof(VertexPC));
+        tb->Unmap(d3dContext);
+        d3dContext->Draw(count,alloc.firstVertex);
         start += count;
         if( (start + count) > totalVertexCount)
             count = totalVertexCount - start;
@@ -167,16 +174,9 @@ namespace LvEdEngine
 
 LineRenderer::LineRenderer(ID3D11Device* device)
 {
-    // create vertex buffer.
-    uint32_t vertCount = 1000;
-
-  
-    m_vbPC = GpuResourceFactory::CreateVertexBuffer(NULL,VertexFormat::VF_PC,vertCount,BufferUsage::DYNAMIC);    
-    assert(m_vbPC);
-
     // compile shaders
-    ID3DBlob* vsBlob = CompileShaderFromResource(L"LineShader.hlsl", "VS","vs_4_0", NULL);    
-    ID3DBlob* psBlob = CompileShaderFromResource(L"LineShader.hlsl", "PS","ps_4_0", NULL);
+    ID3DBlob* vsBlob = EngineShader::Compile(EngineShader::LineVS);    
+    ID3DBlob* psBlob = EngineShader::Compile(EngineShader::LinePS);
     assert(vsBlob);
     assert(psBlob);
 
@@ -197,7 +197,6 @@ namespace LvEdEngine
 
 LineRenderer::~LineRenderer()
 {
-    SAFE_DELETE(m_vbPC);
     SAFE_RELEASE(m_vsShader);
     SAFE_RELEASE(m_psShader);
     SAFE_RELEASE(m_vertexLayoutPC);    
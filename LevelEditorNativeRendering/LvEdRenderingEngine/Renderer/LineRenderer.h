@@ -4,10 +4,10 @@
 #include "../Core/WinHeaders.h"
 #include "../Core/typedefs.h"
 #include "../Core/NonCopyable.h"
+#include "../Core/FrameArena.h"
 #include "../VectorMath/V3dMath.h"
 #include "../VectorMath/CollisionPrimitives.h"
 #include "RenderBuffer.h"
-#include <vector>
 
 namespace LvEdEngine
 {
@@ -54,8 +54,7 @@ void DrawLine(const float3& v1, const float3& v2, const float4& color1, const fl
     static LineRenderer*   s_inst;
 
     float4 m_color;
-    std::vector<VertexPC> m_vertsPC;
-    VertexBuffer* m_vbPC; // vertex buffer.
+    FrameVector<VertexPC> m_vertsPC; // uploaded to the TransientBuffer.
     
     ID3D11InputLayout*     m_vertexLayoutPC;
     ID3D11VertexShader*    m_vsShader;
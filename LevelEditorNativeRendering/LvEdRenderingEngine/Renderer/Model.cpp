@@ -406,18 +406,7 @@ namespace LvEdEngine
     {
         Material * mat = it->second;
         assert(mat);
-        for(unsigned int i = TextureType::MIN; i < TextureType::MAX; ++i)
-        {
-            if(mat->texNames[i].length())
-            {
-                WCHAR strPath[MAX_PATH];
-                // initialize wTexName to wchar_t version of texNames[i]
-                std::wstring wTexName(mat->texNames[i].begin(), mat->texNames[i].end());
-                swprintf_s(strPath, MAX_PATH, L"%ls%ls", m_path.c_str(), wTexName.c_str());
-                mat->textures[i] = (Texture*)manager->LoadAsync(strPath, TextureLib::Inst()->GetDefault((TextureTypeEnum)i) );                
-                //mat->textures[i] = (Texture*)manager->LoadImmediate(m_strPathW, TextureLibGetDefault((TextureTypeEnum)i) );
-            }
-        }
+        RequestTextures(mat, manager);
     }
 
 
@@ -426,6 +415,52 @@ namespace LvEdEngine
     return S_OK;
 }
 
+// ------------------------------------------------------------------------------------------------
+void Model::RequestTextures(Material* mat, ResourceManager* manager)
+{
+    for(unsigned int i = TextureType::MIN; i < TextureType::MAX; ++i)
+    {
+        if(mat->texNames[i].length() && !mat->textures[i])
+        {
+            WCHAR strPath[MAX_PATH];
+            // initialize wTexName to wchar_t version of texNames[i]
+            std::wstring wTexName(mat->texNames[i].begin(), mat->texNames[i].end());
+            swprintf_s(strPath, MAX_PATH, L"%ls%ls", m_path.c_str(), wTexName.c_str());
+            mat->textures[i] = (Texture*)manager->LoadAsync(strPath, TextureLib::Inst()->GetDefault((TextureTypeEnum)i) );                
+            manager->AddDependency(this, mat->textures[i]);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+uint64_t Model::GetCpuBytes()
+{
+    uint64_t bytes = 0;
+    for(MeshDict::iterator it = m_meshes.begin(); it != m_meshes.end(); ++it)
+    {
+        Mesh * m = it->second;
+        bytes += m->pos.capacity() * sizeof(float3);
+        bytes += m->nor.capacity() * sizeof(float3);
+        bytes += m->tan.capacity() * sizeof(float3);
+        bytes += m->tex.capacity() * sizeof(float2);
+        bytes += m->indices.capacity() * sizeof(unsigned int);
+    }
+    return bytes;
+}
+
+// ------------------------------------------------------------------------------------------------
+uint64_t Model::GetGpuBytes()
+{
+    uint64_t bytes = 0;
+    for(MeshDict::iterator it = m_meshes.begin(); it != m_meshes.end(); ++it)
+    {
+        Mesh * m = it->second;
+        if(m->vertexBuffer) bytes += m->vertexBuffer->GetSize();
+        if(m->indexBuffer) bytes += m->indexBuffer->GetSize();
+    }
+    return bytes;
+}
+
 // ------------------------------------------------------------------------------------------------
 void Model::Destroy()
 {
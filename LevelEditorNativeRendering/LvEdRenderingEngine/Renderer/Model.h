@@ -4,7 +4,7 @@
 #include <string>
 #include <vector>
 #include <map>
-#include <D3D11.h>
+#include <d3d11.h>
 
 #include "../Core/WinHeaders.h"
 #include "../Core/NonCopyable.h"
@@ -147,6 +147,9 @@ class Model : public Resource
 
     //IResource methods
     virtual ResourceTypeEnum GetType(){return ResourceType::Model;}
+    // the meshes, the textures are resources of their own.
+    virtual uint64_t GetCpuBytes();
+    virtual uint64_t GetGpuBytes();
 
     Node * CreateNode(const std::string& name);
     Geometry * CreateGeometry(const std::string& name);
@@ -175,6 +178,11 @@ class Model : public Resource
     HRESULT Construct(ID3D11Device* d3dDevice, ResourceManager* manager);
     void Destroy();
 
+    // starts loading the textures named by the material that aren't loading yet
+    // and makes them dependencies of the model. Factories call it as soon as
+    // a material is parsed, Construct() calls it for the remaining ones.
+    void RequestTextures(Material* mat, ResourceManager* manager);
+
     
     const AABB& GetBounds(){return m_bounds;}
 
@@ -2,10 +2,11 @@
 
 #include "../Core/NonCopyable.h"
 #include "NormalsShader.h"
-#include <D3D11.h>
+#include <d3d11.h>
 #include "Renderable.h"
 #include "RenderBuffer.h"
 #include "RenderUtil.h"
+#include "EngineShaders.h"
 #include "../Core/Utils.h"
 #include "RenderContext.h"
 #include "RenderState.h"
@@ -55,7 +56,7 @@
 }
 
 
-void NormalsShader::DrawNodes(const RenderNodeList& renderNodes)
+void NormalsShader::DrawNodes(const FrameNodeList& renderNodes)
 {    
     ID3D11DeviceContext* d3dContext = m_rcntx->Context();
     for ( auto it = renderNodes.begin(); it != renderNodes.end(); ++it )
@@ -90,9 +91,9 @@
     m_cbPerFrame.Construct(device);
     m_cbPerObject.Construct(device);
         
-    ID3DBlob* vsBlob = CompileShaderFromResource(L"NormalsShader.hlsl", "VS","vs_4_0", NULL);    
-    ID3DBlob* gsBlob = CompileShaderFromResource(L"NormalsShader.hlsl", "GS","gs_4_0", NULL);    
-    ID3DBlob* psBlob = CompileShaderFromResource(L"NormalsShader.hlsl", "PS","ps_4_0", NULL);
+    ID3DBlob* vsBlob = EngineShader::Compile(EngineShader::NormalsVS);    
+    ID3DBlob* gsBlob = EngineShader::Compile(EngineShader::NormalsGS);    
+    ID3DBlob* psBlob = EngineShader::Compile(EngineShader::NormalsPS);
 
     assert(vsBlob);
     assert(gsBlob);
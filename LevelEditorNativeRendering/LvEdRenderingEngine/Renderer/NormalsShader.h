@@ -30,7 +30,7 @@ class NormalsShader : public Shader
         virtual void Begin(RenderContext* rc);
         virtual void End();
         virtual void SetRenderFlag(RenderFlagsEnum rf);
-        virtual void DrawNodes(const RenderNodeList& renderNodes);
+        virtual void DrawNodes(const FrameNodeList& renderNodes);
 
         void SetColor(float4 wireColor);
         
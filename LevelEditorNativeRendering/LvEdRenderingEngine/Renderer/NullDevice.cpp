@@ -0,0 +1,876 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    NullDevice.cpp
+
+****************************************************************************/
+#include "../Core/WinHeaders.h"
+#include "NullDevice.h"
+#include <vector>
+#include <string.h>
+#include <stdint.h>
+#include "../DirectX/DirectXTex/DirectXTex.h"
+
+namespace LvEdEngine
+{
+
+//---------------------------------------------------------------------------
+// Base of all the device children, implements IUnknown and ID3D11DeviceChild.
+// The children don't keep the device alive.
+template<class Interface, class Parent = ID3D11DeviceChild>
+class NullChild : public Interface
+{
+public:
+    NullChild(ID3D11Device* device) : m_refCount(1), m_device(device) {}
+    virtual ~NullChild() {}
+
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppvObject)
+    {
+        if(ppvObject == NULL)
+            return E_POINTER;
+        if(riid == __uuidof(IUnknown) || riid == __uuidof(ID3D11DeviceChild)
+            || riid == __uuidof(Parent) || riid == __uuidof(Interface))
+        {
+            *ppvObject = static_cast<Interface*>(this);
+            AddRef();
+            return S_OK;
+        }
+        *ppvObject = NULL;
+        return E_NOINTERFACE;
+    }
+
+    ULONG STDMETHODCALLTYPE AddRef()
+    {
+        return (ULONG)InterlockedIncrement(&m_refCount);
+    }
+
+    ULONG STDMETHODCALLTYPE Release()
+    {
+        ULONG refCount = (ULONG)InterlockedDecrement(&m_refCount);
+        if(refCount == 0)
+            delete this;
+        return refCount;
+    }
+
+    void STDMETHODCALLTYPE GetDevice(ID3D11Device** ppDevice)
+    {
+        *ppDevice = m_device;
+        m_device->AddRef();
+    }
+
+    HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID /*guid*/, UINT* pDataSize, void* /*pData*/)
+    {
+        if(pDataSize) *pDataSize = 0;
+        return DXGI_ERROR_NOT_FOUND;
+    }
+
+    HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID /*guid*/, UINT /*DataSize*/, const void* /*pData*/)
+    {
+        return S_OK;
+    }
+
+    HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID /*guid*/, const IUnknown* /*pData*/)
+    {
+        return S_OK;
+    }
+
+protected:
+    volatile LONG m_refCount;
+    ID3D11Device* m_device;
+};
+
+//---------------------------------------------------------------------------
+// state objects only keep their description.
+template<class Interface, class Desc>
+class NullState : public NullChild<Interface>
+{
+public:
+    NullState(ID3D11Device* device, const Desc* desc) : NullChild<Interface>(device)
+    {
+        m_desc = *desc;
+    }
+
+    void STDMETHODCALLTYPE GetDesc(Desc* pDesc) { *pDesc = m_desc; }
+
+private:
+    Desc m_desc;
+};
+
+typedef NullState<ID3D11BlendState, D3D11_BLEND_DESC>               NullBlendState;
+typedef NullState<ID3D11DepthStencilState, D3D11_DEPTH_STENCIL_DESC> NullDepthStencilState;
+typedef NullState<ID3D11RasterizerState, D3D11_RASTERIZER_DESC>     NullRasterizerState;
+typedef NullState<ID3D11SamplerState, D3D11_SAMPLER_DESC>           NullSamplerState;
+
+//---------------------------------------------------------------------------
+// event query, the null GPU is done with the commands issued before
+// End() at the next flush of the context.
+class NullQuery : public NullChild<ID3D11Query, ID3D11Asynchronous>
+{
+public:
+    NullQuery(ID3D11Device* device, const D3D11_QUERY_DESC& desc)
+        : NullChild<ID3D11Query, ID3D11Asynchronous>(device), m_desc(desc), m_issued(false), m_flush(0) {}
+
+    UINT STDMETHODCALLTYPE GetDataSize() { return sizeof(BOOL); }
+    void STDMETHODCALLTYPE GetDesc(D3D11_QUERY_DESC* pDesc) { *pDesc = m_desc; }
+
+    D3D11_QUERY_DESC m_desc;
+    bool     m_issued; // End() was called.
+    uint32_t m_flush;  // flush count of the context at End().
+};
+
+//---------------------------------------------------------------------------
+// contents of a mip level of an array slice, or of a buffer.
+struct NullSubresource
+{
+    std::vector<uint8_t> data;
+    UINT width;      // in pixels, bytes for buffers.
+    UINT height;     // in pixels.
+    UINT rowPitch;   // bytes per row of pixels or blocks.
+    UINT rows;       // rows of pixels or blocks.
+    UINT blockSize;  // bytes per pixel or per block.
+    UINT blockDim;   // 4 for block compressed formats, 1 otherwise.
+};
+
+//---------------------------------------------------------------------------
+template<class Interface, class Desc, D3D11_RESOURCE_DIMENSION Dimension>
+class NullResource : public NullChild<Interface, ID3D11Resource>
+{
+public:
+    NullResource(ID3D11Device* device, const Desc& desc)
+        : NullChild<Interface, ID3D11Resource>(device),
+        m_desc(desc),
+        m_evictionPriority(0)
+    {
+    }
+
+    void STDMETHODCALLTYPE GetType(D3D11_RESOURCE_DIMENSION* pResourceDimension) { *pResourceDimension = Dimension; }
+    void STDMETHODCALLTYPE SetEvictionPriority(UINT EvictionPriority) { m_evictionPriority = EvictionPriority; }
+    UINT STDMETHODCALLTYPE GetEvictionPriority() { return m_evictionPriority; }
+    void STDMETHODCALLTYPE GetDesc(Desc* pDesc) { *pDesc = m_desc; }
+
+    Desc m_desc;
+    std::vector<NullSubresource> m_subresources;
+
+private:
+    UINT m_evictionPriority;
+};
+
+typedef NullResource<ID3D11Buffer, D3D11_BUFFER_DESC, D3D11_RESOURCE_DIMENSION_BUFFER>          NullBuffer;
+typedef NullResource<ID3D11Texture2D, D3D11_TEXTURE2D_DESC, D3D11_RESOURCE_DIMENSION_TEXTURE2D> NullTexture2D;
+
+//---------------------------------------------------------------------------
+// returns the subresources of a resource created by the null device.
+static std::vector<NullSubresource>* GetSubresources(ID3D11Resource* resource)
+{
+    if(resource == NULL)
+        return NULL;
+    D3D11_RESOURCE_DIMENSION dim;
+    resource->GetType(&dim);
+    if(dim == D3D11_RESOURCE_DIMENSION_BUFFER)
+        return &static_cast<NullBuffer*>(static_cast<ID3D11Buffer*>(resource))->m_subresources;
+    if(dim == D3D11_RESOURCE_DIMENSION_TEXTURE2D)
+        return &static_cast<NullTexture2D*>(static_cast<ID3D11Texture2D*>(resource))->m_subresources;
+    return NULL;
+}
+
+//---------------------------------------------------------------------------
+static NullSubresource* GetSubresource(ID3D11Resource* resource, UINT index)
+{
+    std::vector<NullSubresource>* subresources = GetSubresources(resource);
+    if(subresources == NULL || index >= subresources->size())
+        return NULL;
+    return &(*subresources)[index];
+}
+
+//---------------------------------------------------------------------------
+// computes the bytes covered by a box, the whole subresource if the box is NULL.
+// returns false if the box is outside the subresource.
+static bool GetRegion(const NullSubresource& sub, const D3D11_BOX* box, size_t* offset, size_t* rowBytes, UINT* rows)
+{
+    if(box == NULL)
+    {
+        *offset = 0;
+        *rowBytes = sub.rowPitch;
+        *rows = sub.rows;
+        return true;
+    }
+
+    // the small mips of block compressed formats are still made of whole blocks.
+    UINT width  = (sub.width + sub.blockDim - 1) / sub.blockDim * sub.blockDim;
+    UINT height = (sub.height + sub.blockDim - 1) / sub.blockDim * sub.blockDim;
+    if(box->left >= box->right || box->top >= box->bottom
+        || box->right > width || box->bottom > height)
+        return false;
+
+    UINT left   = box->left / sub.blockDim;
+    UINT right  = (box->right + sub.blockDim - 1) / sub.blockDim;
+    UINT top    = box->top / sub.blockDim;
+    UINT bottom = (box->bottom + sub.blockDim - 1) / sub.blockDim;
+    *offset = top * sub.rowPitch + left * sub.blockSize;
+    *rowBytes = (right - left) * sub.blockSize;
+    *rows = bottom - top;
+    return true;
+}
+
+//---------------------------------------------------------------------------
+template<class Interface, class Desc>
+class NullView : public NullChild<Interface, ID3D11View>
+{
+public:
+    NullView(ID3D11Device* device, ID3D11Resource* resource, const Desc* desc)
+        : NullChild<Interface, ID3D11View>(device),
+        m_resource(resource)
+    {
+        m_resource->AddRef();
+        if(desc)
+            m_desc = *desc;
+        else
+            memset(&m_desc, 0, sizeof(m_desc));
+    }
+
+    ~NullView()
+    {
+        m_resource->Release();
+    }
+
+    void STDMETHODCALLTYPE GetResource(ID3D11Resource** ppResource)
+    {
+        *ppResource = m_resource;
+        m_resource->AddRef();
+    }
+
+    void STDMETHODCALLTYPE GetDesc(Desc* pDesc) { *pDesc = m_desc; }
+
+private:
+    ID3D11Resource* m_resource;
+    Desc m_desc;
+};
+
+typedef NullView<ID3D11ShaderResourceView, D3D11_SHADER_RESOURCE_VIEW_DESC> NullShaderResourceView;
+typedef NullView<ID3D11RenderTargetView, D3D11_RENDER_TARGET_VIEW_DESC>     NullRenderTargetView;
+typedef NullView<ID3D11DepthStencilView, D3D11_DEPTH_STENCIL_VIEW_DESC>     NullDepthStencilView;
+
+//---------------------------------------------------------------------------
+// All the state setters and draws are ignored, the getters return NULL states.
+class NullDeviceContext : public NullChild<ID3D11DeviceContext>
+{
+public:
+    NullDeviceContext(ID3D11Device* device) : NullChild<ID3D11DeviceContext>(device), m_flushCount(0) {}
+
+    // pipeline state.
+    void STDMETHODCALLTYPE VSSetConstantBuffers(UINT, UINT, ID3D11Buffer* const*) {}
+    void STDMETHODCALLTYPE PSSetShaderResources(UINT, UINT, ID3D11ShaderResourceView* const*) {}
+    void STDMETHODCALLTYPE PSSetShader(ID3D11PixelShader*, ID3D11ClassInstance* const*, UINT) {}
+    void STDMETHODCALLTYPE PSSetSamplers(UINT, UINT, ID3D11SamplerState* const*) {}
+    void STDMETHODCALLTYPE VSSetShader(ID3D11VertexShader*, ID3D11ClassInstance* const*, UINT) {}
+    void STDMETHODCALLTYPE PSSetConstantBuffers(UINT, UINT, ID3D11Buffer* const*) {}
+    void STDMETHODCALLTYPE IASetInputLayout(ID3D11InputLayout*) {}
+    void STDMETHODCALLTYPE IASetVertexBuffers(UINT, UINT, ID3D11Buffer* const*, const UINT*, const UINT*) {}
+    void STDMETHODCALLTYPE IASetIndexBuffer(ID3D11Buffer*, DXGI_FORMAT, UINT) {}
+    void STDMETHODCALLTYPE GSSetConstantBuffers(UINT, UINT, ID3D11Buffer* const*) {}
+    void STDMETHODCALLTYPE GSSetShader(ID3D11GeometryShader*, ID3D11ClassInstance* const*, UINT) {}
+    void STDMETHODCALLTYPE IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY) {}
+    void STDMETHODCALLTYPE VSSetShaderResources(UINT, UINT, ID3D11ShaderResourceView* const*) {}
+    void STDMETHODCALLTYPE VSSetSamplers(UINT, UINT, ID3D11SamplerState* const*) {}
+    void STDMETHODCALLTYPE SetPredication(ID3D11Predicate*, BOOL) {}
+    void STDMETHODCALLTYPE GSSetShaderResources(UINT, UINT, ID3D11ShaderResourceView* const*) {}
+    void STDMETHODCALLTYPE GSSetSamplers(UINT, UINT, ID3D11SamplerState* const*) {}
+    void STDMETHODCALLTYPE OMSetRenderTargets(UINT, ID3D11RenderTargetView* const*, ID3D11DepthStencilView*) {}
+    void STDMETHODCALLTYPE OMSetRenderTargetsAndUnorderedAccessViews(UINT, ID3D11RenderTargetView* const*, ID3D11DepthStencilView*,
+        UINT, UINT, ID3D11UnorderedAccessView* const*, const UINT*) {}
+    void STDMETHODCALLTYPE OMSetBlendState(ID3D11BlendState*, const FLOAT[4], UINT) {}
+    void STDMETHODCALLTYPE OMSetDepthStencilState(ID3D11DepthStencilState*, UINT) {}
+    void STDMETHODCALLTYPE SOSetTargets(UINT, ID3D11Buffer* const*, const UINT*) {}
+    void STDMETHODCALLTYPE RSSetState(ID3D11RasterizerState*) {}
+    void STDMETHODCALLTYPE RSSetViewports(UINT, const D3D11_VIEWPORT*) {}
+    void STDMETHODCALLTYPE RSSetScissorRects(UINT, const D3D11_RECT*) {}
+    void STDMETHODCALLTYPE HSSetShaderResources(UINT, UINT, ID3D11ShaderResourceView* const*) {}
+    void STDMETHODCALLTYPE HSSetShader(ID3D11HullShader*, ID3D11ClassInstance* const*, UINT) {}
+    void STDMETHODCALLTYPE HSSetSamplers(UINT, UINT, ID3D11SamplerState* const*) {}
+    void STDMETHODCALLTYPE HSSetConstantBuffers(UINT, UINT, ID3D11Buffer* const*) {}
+    void STDMETHODCALLTYPE DSSetShaderResources(UINT, UINT, ID3D11ShaderResourceView* const*) {}
+    void STDMETHODCALLTYPE DSSetShader(ID3D11DomainShader*, ID3D11ClassInstance* const*, UINT) {}
+    void STDMETHODCALLTYPE DSSetSamplers(UINT, UINT, ID3D11SamplerState* const*) {}
+    void STDMETHODCALLTYPE DSSetConstantBuffers(UINT, UINT, ID3D11Buffer* const*) {}
+    void STDMETHODCALLTYPE CSSetShaderResources(UINT, UINT, ID3D11ShaderResourceView* const*) {}
+    void STDMETHODCALLTYPE CSSetUnorderedAccessViews(UINT, UINT, ID3D11UnorderedAccessView* const*, const UINT*) {}
+    void STDMETHODCALLTYPE CSSetShader(ID3D11ComputeShader*, ID3D11ClassInstance* const*, UINT) {}
+    void STDMETHODCALLTYPE CSSetSamplers(UINT, UINT, ID3D11SamplerState* const*) {}
+    void STDMETHODCALLTYPE CSSetConstantBuffers(UINT, UINT, ID3D11Buffer* const*) {}
+
+    // draws, clears and queries.
+    void STDMETHODCALLTYPE DrawIndexed(UINT, UINT, INT) {}
+    void STDMETHODCALLTYPE Draw(UINT, UINT) {}
+    void STDMETHODCALLTYPE DrawIndexedInstanced(UINT, UINT, UINT, INT, UINT) {}
+    void STDMETHODCALLTYPE DrawInstanced(UINT, UINT, UINT, UINT) {}
+    void STDMETHODCALLTYPE DrawAuto() {}
+    void STDMETHODCALLTYPE DrawIndexedInstancedIndirect(ID3D11Buffer*, UINT) {}
+    void STDMETHODCALLTYPE DrawInstancedIndirect(ID3D11Buffer*, UINT) {}
+    void STDMETHODCALLTYPE Dispatch(UINT, UINT, UINT) {}
+    void STDMETHODCALLTYPE DispatchIndirect(ID3D11Buffer*, UINT) {}
+    void STDMETHODCALLTYPE ClearRenderTargetView(ID3D11RenderTargetView*, const FLOAT[4]) {}
+    void STDMETHODCALLTYPE ClearUnorderedAccessViewUint(ID3D11UnorderedAccessView*, const UINT[4]) {}
+    void STDMETHODCALLTYPE ClearUnorderedAccessViewFloat(ID3D11UnorderedAccessView*, const FLOAT[4]) {}
+    void STDMETHODCALLTYPE ClearDepthStencilView(ID3D11DepthStencilView*, UINT, FLOAT, UINT8) {}
+    void STDMETHODCALLTYPE GenerateMips(ID3D11ShaderResourceView*) {}
+    void STDMETHODCALLTYPE SetResourceMinLOD(ID3D11Resource*, FLOAT) {}
+    FLOAT STDMETHODCALLTYPE GetResourceMinLOD(ID3D11Resource*) { return 0.0f; }
+    void STDMETHODCALLTYPE CopyStructureCount(ID3D11Buffer*, UINT, ID3D11UnorderedAccessView*) {}
+    void STDMETHODCALLTYPE Begin(ID3D11Asynchronous*) {}
+    void STDMETHODCALLTYPE End(ID3D11Asynchronous* pAsync);
+    HRESULT STDMETHODCALLTYPE GetData(ID3D11Asynchronous* pAsync, void* pData, UINT DataSize, UINT GetDataFlags);
+    void STDMETHODCALLTYPE ExecuteCommandList(ID3D11CommandList*, BOOL) {}
+    HRESULT STDMETHODCALLTYPE FinishCommandList(BOOL, ID3D11CommandList**) { return DXGI_ERROR_INVALID_CALL; }
+    void STDMETHODCALLTYPE ClearState() {}
+    void STDMETHODCALLTYPE Flush() { m_flushCount++; }
+    D3D11_DEVICE_CONTEXT_TYPE STDMETHODCALLTYPE GetType() { return D3D11_DEVICE_CONTEXT_IMMEDIATE; }
+    UINT STDMETHODCALLTYPE GetContextFlags() { return 0; }
+
+    // resource access, on the CPU copies.
+    HRESULT STDMETHODCALLTYPE Map(ID3D11Resource* pResource, UINT Subresource, D3D11_MAP MapType, UINT MapFlags,
+        D3D11_MAPPED_SUBRESOURCE* pMappedResource);
+    void STDMETHODCALLTYPE Unmap(ID3D11Resource*, UINT) {}
+    void STDMETHODCALLTYPE CopySubresourceRegion(ID3D11Resource* pDstResource, UINT DstSubresource, UINT DstX, UINT DstY, UINT DstZ,
+        ID3D11Resource* pSrcResource, UINT SrcSubresource, const D3D11_BOX* pSrcBox);
+    void STDMETHODCALLTYPE CopyResource(ID3D11Resource* pDstResource, ID3D11Resource* pSrcResource);
+    void STDMETHODCALLTYPE UpdateSubresource(ID3D11Resource* pDstResource, UINT DstSubresource, const D3D11_BOX* pDstBox,
+        const void* pSrcData, UINT SrcRowPitch, UINT SrcDepthPitch);
+    void STDMETHODCALLTYPE ResolveSubresource(ID3D11Resource* pDstResource, UINT DstSubresource,
+        ID3D11Resource* pSrcResource, UINT SrcSubresource, DXGI_FORMAT Format);
+
+    // getters.
+    void STDMETHODCALLTYPE VSGetConstantBuffers(UINT, UINT NumBuffers, ID3D11Buffer** pp) { ClearArray(pp, NumBuffers); }
+    void STDMETHODCALLTYPE PSGetShaderResources(UINT, UINT NumViews, ID3D11ShaderResourceView** pp) { ClearArray(pp, NumViews); }
+    void STDMETHODCALLTYPE PSGetShader(ID3D11PixelShader** pp, ID3D11ClassInstance**, UINT* pNum) { GetShader(pp, pNum); }
+    void STDMETHODCALLTYPE PSGetSamplers(UINT, UINT NumSamplers, ID3D11SamplerState** pp) { ClearArray(pp, NumSamplers); }
+    void STDMETHODCALLTYPE VSGetShader(ID3D11VertexShader** pp, ID3D11ClassInstance**, UINT* pNum) { GetShader(pp, pNum); }
+    void STDMETHODCALLTYPE PSGetConstantBuffers(UINT, UINT NumBuffers, ID3D11Buffer** pp) { ClearArray(pp, NumBuffers); }
+    void STDMETHODCALLTYPE IAGetInputLayout(ID3D11InputLayout** pp) { ClearArray(pp, 1); }
+    void STDMETHODCALLTYPE IAGetVertexBuffers(UINT, UINT NumBuffers, ID3D11Buffer** pp, UINT* pStrides, UINT* pOffsets)
+    {
+        ClearArray(pp, NumBuffers);
+        ClearArray(pStrides, NumBuffers);
+        ClearArray(pOffsets, NumBuffers);
+    }
+    void STDMETHODCALLTYPE IAGetIndexBuffer(ID3D11Buffer** pp, DXGI_FORMAT* pFormat, UINT* pOffset)
+    {
+        ClearArray(pp, 1);
+        if(pFormat) *pFormat = DXGI_FORMAT_UNKNOWN;
+        ClearArray(pOffset, 1);
+    }
+    void STDMETHODCALLTYPE GSGetConstantBuffers(UINT, UINT NumBuffers, ID3D11Buffer** pp) { ClearArray(pp, NumBuffers); }
+    void STDMETHODCALLTYPE GSGetShader(ID3D11GeometryShader** pp, ID3D11ClassInstance**, UINT* pNum) { GetShader(pp, pNum); }
+    void STDMETHODCALLTYPE IAGetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY* pTopology)
+    {
+        if(pTopology) *pTopology = D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED;
+    }
+    void STDMETHODCALLTYPE VSGetShaderResources(UINT, UINT NumViews, ID3D11ShaderResourceView** pp) { ClearArray(pp, NumViews); }
+    void STDMETHODCALLTYPE VSGetSamplers(UINT, UINT NumSamplers, ID3D11SamplerState** pp) { ClearArray(pp, NumSamplers); }
+    void STDMETHODCALLTYPE GetPredication(ID3D11Predicate** pp, BOOL* pValue)
+    {
+        ClearArray(pp, 1);
+        if(pValue) *pValue = FALSE;
+    }
+    void STDMETHODCALLTYPE GSGetShaderResources(UINT, UINT NumViews, ID3D11ShaderResourceView** pp) { ClearArray(pp, NumViews); }
+    void STDMETHODCALLTYPE GSGetSamplers(UINT, UINT NumSamplers, ID3D11SamplerState** pp) { ClearArray(pp, NumSamplers); }
+    void STDMETHODCALLTYPE OMGetRenderTargets(UINT NumViews, ID3D11RenderTargetView** ppRTV, ID3D11DepthStencilView** ppDSV)
+    {
+        ClearArray(ppRTV, NumViews);
+        ClearArray(ppDSV, 1);
+    }
+    void STDMETHODCALLTYPE OMGetRenderTargetsAndUnorderedAccessViews(UINT NumRTVs, ID3D11RenderTargetView** ppRTV,
+        ID3D11DepthStencilView** ppDSV, UINT, UINT NumUAVs, ID3D11UnorderedAccessView** ppUAV)
+    {
+        ClearArray(ppRTV, NumRTVs);
+        ClearArray(ppDSV, 1);
+        ClearArray(ppUAV, NumUAVs);
+    }
+    void STDMETHODCALLTYPE OMGetBlendState(ID3D11BlendState** pp, FLOAT BlendFactor[4], UINT* pSampleMask)
+    {
+        ClearArray(pp, 1);
+        if(BlendFactor)
+        {
+            for(int i = 0; i < 4; ++i)
+                BlendFactor[i] = 1.0f;
+        }
+        if(pSampleMask) *pSampleMask = 0xffffffff;
+    }
+    void STDMETHODCALLTYPE OMGetDepthStencilState(ID3D11DepthStencilState** pp, UINT* pStencilRef)
+    {
+        ClearArray(pp, 1);
+        ClearArray(pStencilRef, 1);
+    }
+    void STDMETHODCALLTYPE SOGetTargets(UINT NumBuffers, ID3D11Buffer** pp) { ClearArray(pp, NumBuffers); }
+    void STDMETHODCALLTYPE RSGetState(ID3D11RasterizerState** pp) { ClearArray(pp, 1); }
+    void STDMETHODCALLTYPE RSGetViewports(UINT* pNumViewports, D3D11_VIEWPORT*) { ClearArray(pNumViewports, 1); }
+    void STDMETHODCALLTYPE RSGetScissorRects(UINT* pNumRects, D3D11_RECT*) { ClearArray(pNumRects, 1); }
+    void STDMETHODCALLTYPE HSGetShaderResources(UINT, UINT NumViews, ID3D11ShaderResourceView** pp) { ClearArray(pp, NumViews); }
+    void STDMETHODCALLTYPE HSGetShader(ID3D11HullShader** pp, ID3D11ClassInstance**, UINT* pNum) { GetShader(pp, pNum); }
+    void STDMETHODCALLTYPE HSGetSamplers(UINT, UINT NumSamplers, ID3D11SamplerState** pp) { ClearArray(pp, NumSamplers); }
+    void STDMETHODCALLTYPE HSGetConstantBuffers(UINT, UINT NumBuffers, ID3D11Buffer** pp) { ClearArray(pp, NumBuffers); }
+    void STDMETHODCALLTYPE DSGetShaderResources(UINT, UINT NumViews, ID3D11ShaderResourceView** pp) { ClearArray(pp, NumViews); }
+    void STDMETHODCALLTYPE DSGetShader(ID3D11DomainShader** pp, ID3D11ClassInstance**, UINT* pNum) { GetShader(pp, pNum); }
+    void STDMETHODCALLTYPE DSGetSamplers(UINT, UINT NumSamplers, ID3D11SamplerState** pp) { ClearArray(pp, NumSamplers); }
+    void STDMETHODCALLTYPE DSGetConstantBuffers(UINT, UINT NumBuffers, ID3D11Buffer** pp) { ClearArray(pp, NumBuffers); }
+    void STDMETHODCALLTYPE CSGetShaderResources(UINT, UINT NumViews, ID3D11ShaderResourceView** pp) { ClearArray(pp, NumViews); }
+    void STDMETHODCALLTYPE CSGetUnorderedAccessViews(UINT, UINT NumUAVs, ID3D11UnorderedAccessView** pp) { ClearArray(pp, NumUAVs); }
+    void STDMETHODCALLTYPE CSGetShader(ID3D11ComputeShader** pp, ID3D11ClassInstance**, UINT* pNum) { GetShader(pp, pNum); }
+    void STDMETHODCALLTYPE CSGetSamplers(UINT, UINT NumSamplers, ID3D11SamplerState** pp) { ClearArray(pp, NumSamplers); }
+    void STDMETHODCALLTYPE CSGetConstantBuffers(UINT, UINT NumBuffers, ID3D11Buffer** pp) { ClearArray(pp, NumBuffers); }
+
+private:
+    template<class T> static void ClearArray(T* p, UINT count)
+    {
+        if(p) memset(p, 0, count * sizeof(T));
+    }
+
+    template<class T> static void GetShader(T** ppShader, UINT* pNumClassInstances)
+    {
+        ClearArray(ppShader, 1);
+        ClearArray(pNumClassInstances, 1);
+    }
+
+    uint32_t m_flushCount;
+};
+
+//---------------------------------------------------------------------------
+void NullDeviceContext::End(ID3D11Asynchronous* pAsync)
+{
+    if(pAsync == NULL)
+        return;
+    NullQuery* query = static_cast<NullQuery*>(static_cast<ID3D11Query*>(pAsync));
+    query->m_issued = true;
+    query->m_flush = m_flushCount;
+}
+
+//---------------------------------------------------------------------------
+HRESULT NullDeviceContext::GetData(ID3D11Asynchronous* pAsync, void* pData, UINT DataSize, UINT GetDataFlags)
+{
+    if(pAsync == NULL)
+        return E_INVALIDARG;
+    NullQuery* query = static_cast<NullQuery*>(static_cast<ID3D11Query*>(pAsync));
+    if(!query->m_issued)
+        return DXGI_ERROR_INVALID_CALL;
+    if((GetDataFlags & D3D11_ASYNC_GETDATA_DONOTFLUSH) == 0)
+        Flush();
+    if(query->m_flush == m_flushCount)
+        return S_FALSE;
+    if(pData)
+    {
+        if(DataSize < sizeof(BOOL))
+            return E_INVALIDARG;
+        *static_cast<BOOL*>(pData) = TRUE;
+    }
+    return S_OK;
+}
+
+//---------------------------------------------------------------------------
+HRESULT NullDeviceContext::Map(ID3D11Resource* pResource, UINT Subresource, D3D11_MAP /*MapType*/, UINT /*MapFlags*/,
+    D3D11_MAPPED_SUBRESOURCE* pMappedResource)
+{
+    NullSubresource* sub = GetSubresource(pResource, Subresource);
+    if(sub == NULL || pMappedResource == NULL)
+        return E_INVALIDARG;
+    pMappedResource->pData = &sub->data[0];
+    pMappedResource->RowPitch = sub->rowPitch;
+    pMappedResource->DepthPitch = (UINT)sub->data.size();
+    return S_OK;
+}
+
+//---------------------------------------------------------------------------
+void NullDeviceContext::CopySubresourceRegion(ID3D11Resource* pDstResource, UINT DstSubresource, UINT DstX, UINT DstY, UINT /*DstZ*/,
+    ID3D11Resource* pSrcResource, UINT SrcSubresource, const D3D11_BOX* pSrcBox)
+{
+    NullSubresource* dst = GetSubresource(pDstResource, DstSubresource);
+    NullSubresource* src = GetSubresource(pSrcResource, SrcSubresource);
+    if(dst == NULL || src == NULL || dst->blockSize != src->blockSize || dst->blockDim != src->blockDim)
+        return;
+
+    D3D11_BOX srcBox = {0, 0, 0, src->width, src->height, 1};
+    if(pSrcBox)
+        srcBox = *pSrcBox;
+    D3D11_BOX dstBox = {DstX, DstY, 0, DstX + srcBox.right - srcBox.left, DstY + srcBox.bottom - srcBox.top, 1};
+
+    size_t srcOffset, dstOffset, srcRowBytes, dstRowBytes;
+    UINT srcRows, dstRows;
+    if(!GetRegion(*src, &srcBox, &srcOffset, &srcRowBytes, &srcRows)
+        || !GetRegion(*dst, &dstBox, &dstOffset, &dstRowBytes, &dstRows))
+        return;
+
+    size_t rowBytes = srcRowBytes < dstRowBytes ? srcRowBytes : dstRowBytes;
+    UINT rows = srcRows < dstRows ? srcRows : dstRows;
+    for(UINT r = 0; r < rows; ++r)
+        memcpy(&dst->data[dstOffset + r * dst->rowPitch], &src->data[srcOffset + r * src->rowPitch], rowBytes);
+}
+
+//---------------------------------------------------------------------------
+void NullDeviceContext::CopyResource(ID3D11Resource* pDstResource, ID3D11Resource* pSrcResource)
+{
+    std::vector<NullSubresource>* dst = GetSubresources(pDstResource);
+    std::vector<NullSubresource>* src = GetSubresources(pSrcResource);
+    if(dst == NULL || src == NULL || dst->size() != src->size())
+        return;
+    for(size_t i = 0; i < dst->size(); ++i)
+    {
+        if((*dst)[i].data.size() == (*src)[i].data.size())
+            (*dst)[i].data = (*src)[i].data;
+    }
+}
+
+//---------------------------------------------------------------------------
+void NullDeviceContext::UpdateSubresource(ID3D11Resource* pDstResource, UINT DstSubresource, const D3D11_BOX* pDstBox,
+    const void* pSrcData, UINT SrcRowPitch, UINT /*SrcDepthPitch*/)
+{
+    NullSubresource* dst = GetSubresource(pDstResource, DstSubresource);
+    if(dst == NULL || pSrcData == NULL)
+        return;
+
+    size_t offset, rowBytes;
+    UINT rows;
+    if(!GetRegion(*dst, pDstBox, &offset, &rowBytes, &rows))
+        return;
+
+    const uint8_t* src = static_cast<const uint8_t*>(pSrcData);
+    for(UINT r = 0; r < rows; ++r)
+        memcpy(&dst->data[offset + r * dst->rowPitch], src + r * SrcRowPitch, rowBytes);
+}
+
+//---------------------------------------------------------------------------
+void NullDeviceContext::ResolveSubresource(ID3D11Resource* pDstResource, UINT DstSubresource,
+    ID3D11Resource* pSrcResource, UINT SrcSubresource, DXGI_FORMAT /*Format*/)
+{
+    NullSubresource* dst = GetSubresource(pDstResource, DstSubresource);
+    NullSubresource* src = GetSubresource(pSrcResource, SrcSubresource);
+    if(dst && src && dst->data.size() == src->data.size())
+        dst->data = src->data;
+}
+
+//---------------------------------------------------------------------------
+class NullDevice : public ID3D11Device
+{
+public:
+    NullDevice() : m_refCount(1)
+    {
+        m_context = new NullDeviceContext(this);
+    }
+
+    virtual ~NullDevice()
+    {
+        m_context->Release();
+    }
+
+    // IUnknown
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppvObject)
+    {
+        if(ppvObject == NULL)
+            return E_POINTER;
+        if(riid == __uuidof(IUnknown) || riid == __uuidof(ID3D11Device))
+        {
+            *ppvObject = static_cast<ID3D11Device*>(this);
+            AddRef();
+            return S_OK;
+        }
+        *ppvObject = NULL;
+        return E_NOINTERFACE;
+    }
+
+    ULONG STDMETHODCALLTYPE AddRef()
+    {
+        return (ULONG)InterlockedIncrement(&m_refCount);
+    }
+
+    ULONG STDMETHODCALLTYPE Release()
+    {
+        ULONG refCount = (ULONG)InterlockedDecrement(&m_refCount);
+        if(refCount == 0)
+            delete this;
+        return refCount;
+    }
+
+    // resources and views.
+    HRESULT STDMETHODCALLTYPE CreateBuffer(const D3D11_BUFFER_DESC* pDesc, const D3D11_SUBRESOURCE_DATA* pInitialData, ID3D11Buffer** ppBuffer);
+    HRESULT STDMETHODCALLTYPE CreateTexture2D(const D3D11_TEXTURE2D_DESC* pDesc, const D3D11_SUBRESOURCE_DATA* pInitialData, ID3D11Texture2D** ppTexture2D);
+    HRESULT STDMETHODCALLTYPE CreateTexture1D(const D3D11_TEXTURE1D_DESC*, const D3D11_SUBRESOURCE_DATA*, ID3D11Texture1D**) { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE CreateTexture3D(const D3D11_TEXTURE3D_DESC*, const D3D11_SUBRESOURCE_DATA*, ID3D11Texture3D**) { return E_NOTIMPL; }
+
+    HRESULT STDMETHODCALLTYPE CreateShaderResourceView(ID3D11Resource* pResource, const D3D11_SHADER_RESOURCE_VIEW_DESC* pDesc,
+        ID3D11ShaderResourceView** ppSRView)
+    {
+        return CreateView<NullShaderResourceView>(pResource, pDesc, ppSRView);
+    }
+
+    HRESULT STDMETHODCALLTYPE CreateRenderTargetView(ID3D11Resource* pResource, const D3D11_RENDER_TARGET_VIEW_DESC* pDesc,
+        ID3D11RenderTargetView** ppRTView)
+    {
+        return CreateView<NullRenderTargetView>(pResource, pDesc, ppRTView);
+    }
+
+    HRESULT STDMETHODCALLTYPE CreateDepthStencilView(ID3D11Resource* pResource, const D3D11_DEPTH_STENCIL_VIEW_DESC* pDesc,
+        ID3D11DepthStencilView** ppDepthStencilView)
+    {
+        return CreateView<NullDepthStencilView>(pResource, pDesc, ppDepthStencilView);
+    }
+
+    HRESULT STDMETHODCALLTYPE CreateUnorderedAccessView(ID3D11Resource*, const D3D11_UNORDERED_ACCESS_VIEW_DESC*, ID3D11UnorderedAccessView**)
+    {
+        return E_NOTIMPL;
+    }
+
+    // shaders and input layouts, the byte code is not looked at.
+    HRESULT STDMETHODCALLTYPE CreateInputLayout(const D3D11_INPUT_ELEMENT_DESC*, UINT, const void*, SIZE_T, ID3D11InputLayout** ppInputLayout)
+    {
+        return CreateChild(ppInputLayout);
+    }
+
+    HRESULT STDMETHODCALLTYPE CreateVertexShader(const void*, SIZE_T, ID3D11ClassLinkage*, ID3D11VertexShader** ppVertexShader)
+    {
+        return CreateChild(ppVertexShader);
+    }
+
+    HRESULT STDMETHODCALLTYPE CreateGeometryShader(const void*, SIZE_T, ID3D11ClassLinkage*, ID3D11GeometryShader** ppGeometryShader)
+    {
+        return CreateChild(ppGeometryShader);
+    }
+
+    HRESULT STDMETHODCALLTYPE CreateGeometryShaderWithStreamOutput(const void*, SIZE_T, const D3D11_SO_DECLARATION_ENTRY*, UINT,
+        const UINT*, UINT, UINT, ID3D11ClassLinkage*, ID3D11GeometryShader** ppGeometryShader)
+    {
+        return CreateChild(ppGeometryShader);
+    }
+
+    HRESULT STDMETHODCALLTYPE CreatePixelShader(const void*, SIZE_T, ID3D11ClassLinkage*, ID3D11PixelShader** ppPixelShader)
+    {
+        return CreateChild(ppPixelShader);
+    }
+
+    HRESULT STDMETHODCALLTYPE CreateHullShader(const void*, SIZE_T, ID3D11ClassLinkage*, ID3D11HullShader**) { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE CreateDomainShader(const void*, SIZE_T, ID3D11ClassLinkage*, ID3D11DomainShader**) { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE CreateComputeShader(const void*, SIZE_T, ID3D11ClassLinkage*, ID3D11ComputeShader**) { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE CreateClassLinkage(ID3D11ClassLinkage**) { return E_NOTIMPL; }
+
+    // states.
+    HRESULT STDMETHODCALLTYPE CreateBlendState(const D3D11_BLEND_DESC* pBlendStateDesc, ID3D11BlendState** ppBlendState)
+    {
+        return CreateState<NullBlendState>(pBlendStateDesc, ppBlendState);
+    }
+
+    HRESULT STDMETHODCALLTYPE CreateDepthStencilState(const D3D11_DEPTH_STENCIL_DESC* pDepthStencilDesc, ID3D11DepthStencilState** ppDepthStencilState)
+    {
+        return CreateState<NullDepthStencilState>(pDepthStencilDesc, ppDepthStencilState);
+    }
+
+    HRESULT STDMETHODCALLTYPE CreateRasterizerState(const D3D11_RASTERIZER_DESC* pRasterizerDesc, ID3D11RasterizerState** ppRasterizerState)
+    {
+        return CreateState<NullRasterizerState>(pRasterizerDesc, ppRasterizerState);
+    }
+
+    HRESULT STDMETHODCALLTYPE CreateSamplerState(const D3D11_SAMPLER_DESC* pSamplerDesc, ID3D11SamplerState** ppSamplerState)
+    {
+        return CreateState<NullSamplerState>(pSamplerDesc, ppSamplerState);
+    }
+
+    // queries and deferred contexts.
+    HRESULT STDMETHODCALLTYPE CreateQuery(const D3D11_QUERY_DESC* pQueryDesc, ID3D11Query** ppQuery)
+    {
+        if(pQueryDesc == NULL)
+            return E_INVALIDARG;
+        if(pQueryDesc->Query != D3D11_QUERY_EVENT)
+            return E_NOTIMPL;
+        if(ppQuery == NULL)
+            return S_FALSE;
+        *ppQuery = new NullQuery(this, *pQueryDesc);
+        return S_OK;
+    }
+    HRESULT STDMETHODCALLTYPE CreatePredicate(const D3D11_QUERY_DESC*, ID3D11Predicate**) { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE CreateCounter(const D3D11_COUNTER_DESC*, ID3D11Counter**) { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE CreateDeferredContext(UINT, ID3D11DeviceContext**) { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE OpenSharedResource(HANDLE, REFIID, void**) { return E_NOTIMPL; }
+
+    // capabilities, everything is supported.
+    HRESULT STDMETHODCALLTYPE CheckFormatSupport(DXGI_FORMAT, UINT* pFormatSupport)
+    {
+        if(pFormatSupport == NULL)
+            return E_INVALIDARG;
+        *pFormatSupport = 0xffffffff;
+        return S_OK;
+    }
+
+    // one quality level, so multisampling ends up disabled.
+    HRESULT STDMETHODCALLTYPE CheckMultisampleQualityLevels(DXGI_FORMAT, UINT, UINT* pNumQualityLevels)
+    {
+        if(pNumQualityLevels == NULL)
+            return E_INVALIDARG;
+        *pNumQualityLevels = 1;
+        return S_OK;
+    }
+
+    void STDMETHODCALLTYPE CheckCounterInfo(D3D11_COUNTER_INFO* pCounterInfo)
+    {
+        if(pCounterInfo) memset(pCounterInfo, 0, sizeof(D3D11_COUNTER_INFO));
+    }
+
+    HRESULT STDMETHODCALLTYPE CheckCounter(const D3D11_COUNTER_DESC*, D3D11_COUNTER_TYPE*, UINT*, LPSTR, UINT*, LPSTR, UINT*, LPSTR, UINT*)
+    {
+        return E_NOTIMPL;
+    }
+
+    HRESULT STDMETHODCALLTYPE CheckFeatureSupport(D3D11_FEATURE, void* pFeatureSupportData, UINT FeatureSupportDataSize)
+    {
+        if(pFeatureSupportData == NULL)
+            return E_INVALIDARG;
+        memset(pFeatureSupportData, 0, FeatureSupportDataSize);
+        return S_OK;
+    }
+
+    HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID, UINT* pDataSize, void*)
+    {
+        if(pDataSize) *pDataSize = 0;
+        return DXGI_ERROR_NOT_FOUND;
+    }
+
+    HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID, UINT, const void*) { return S_OK; }
+    HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID, const IUnknown*) { return S_OK; }
+    D3D_FEATURE_LEVEL STDMETHODCALLTYPE GetFeatureLevel() { return D3D_FEATURE_LEVEL_11_0; }
+    UINT STDMETHODCALLTYPE GetCreationFlags() { return 0; }
+    HRESULT STDMETHODCALLTYPE GetDeviceRemovedReason() { return S_OK; }
+    HRESULT STDMETHODCALLTYPE SetExceptionMode(UINT) { return S_OK; }
+    UINT STDMETHODCALLTYPE GetExceptionMode() { return 0; }
+
+    void STDMETHODCALLTYPE GetImmediateContext(ID3D11DeviceContext** ppImmediateContext)
+    {
+        *ppImmediateContext = m_context;
+        m_context->AddRef();
+    }
+
+private:
+    // a NULL output pointer only validates the arguments.
+    template<class T> HRESULT CreateChild(T** ppChild)
+    {
+        if(ppChild == NULL)
+            return S_FALSE;
+        *ppChild = new NullChild<T>(this);
+        return S_OK;
+    }
+
+    template<class State, class Desc, class Interface> HRESULT CreateState(const Desc* pDesc, Interface** ppState)
+    {
+        if(pDesc == NULL)
+            return E_INVALIDARG;
+        if(ppState == NULL)
+            return S_FALSE;
+        *ppState = new State(this, pDesc);
+        return S_OK;
+    }
+
+    template<class View, class Desc, class Interface> HRESULT CreateView(ID3D11Resource* pResource, const Desc* pDesc, Interface** ppView)
+    {
+        if(GetSubresources(pResource) == NULL)
+            return E_INVALIDARG;
+        if(ppView == NULL)
+            return S_FALSE;
+        *ppView = new View(this, pResource, pDesc);
+        return S_OK;
+    }
+
+    volatile LONG m_refCount;
+    NullDeviceContext* m_context;
+};
+
+//---------------------------------------------------------------------------
+HRESULT NullDevice::CreateBuffer(const D3D11_BUFFER_DESC* pDesc, const D3D11_SUBRESOURCE_DATA* pInitialData, ID3D11Buffer** ppBuffer)
+{
+    if(pDesc == NULL || pDesc->ByteWidth == 0)
+        return E_INVALIDARG;
+    if(ppBuffer == NULL)
+        return S_FALSE;
+
+    NullBuffer* buffer = new NullBuffer(this, *pDesc);
+    buffer->m_subresources.resize(1);
+    NullSubresource& sub = buffer->m_subresources[0];
+    sub.data.resize(pDesc->ByteWidth);
+    sub.width = pDesc->ByteWidth;
+    sub.height = 1;
+    sub.rowPitch = pDesc->ByteWidth;
+    sub.rows = 1;
+    sub.blockSize = 1;
+    sub.blockDim = 1;
+    if(pInitialData && pInitialData->pSysMem)
+        memcpy(&sub.data[0], pInitialData->pSysMem, pDesc->ByteWidth);
+
+    *ppBuffer = buffer;
+    return S_OK;
+}
+
+//---------------------------------------------------------------------------
+HRESULT NullDevice::CreateTexture2D(const D3D11_TEXTURE2D_DESC* pDesc, const D3D11_SUBRESOURCE_DATA* pInitialData, ID3D11Texture2D** ppTexture2D)
+{
+    if(pDesc == NULL || pDesc->Width == 0 || pDesc->Height == 0 || pDesc->ArraySize == 0
+        || DirectX::BitsPerPixel(pDesc->Format) == 0)
+        return E_INVALIDARG;
+    if(ppTexture2D == NULL)
+        return S_FALSE;
+
+    // zero mip levels means the full chain.
+    D3D11_TEXTURE2D_DESC desc = *pDesc;
+    if(desc.MipLevels == 0)
+    {
+        UINT size = desc.Width > desc.Height ? desc.Width : desc.Height;
+        desc.MipLevels = 1;
+        while(size > 1)
+        {
+            size >>= 1;
+            desc.MipLevels++;
+        }
+    }
+
+    bool compressed = DirectX::IsCompressed(desc.Format);
+    NullTexture2D* texture = new NullTexture2D(this, desc);
+    texture->m_subresources.resize(desc.MipLevels * desc.ArraySize);
+    for(UINT slice = 0; slice < desc.ArraySize; ++slice)
+    {
+        UINT width = desc.Width;
+        UINT height = desc.Height;
+        for(UINT mip = 0; mip < desc.MipLevels; ++mip)
+        {
+            UINT index = D3D11CalcSubresource(mip, slice, desc.MipLevels);
+            NullSubresource& sub = texture->m_subresources[index];
+            size_t rowPitch, slicePitch;
+            DirectX::ComputePitch(desc.Format, width, height, rowPitch, slicePitch);
+            sub.width = width;
+            sub.height = height;
+            sub.rowPitch = (UINT)rowPitch;
+            sub.rows = (UINT)DirectX::ComputeScanlines(desc.Format, height);
+            sub.blockDim = compressed ? 4 : 1;
+            sub.blockSize = compressed ? sub.rowPitch / ((width + 3) / 4) : sub.rowPitch / width;
+            if(sub.blockSize == 0) sub.blockSize = 1;
+            sub.data.resize(slicePitch);
+
+            if(pInitialData && pInitialData[index].pSysMem)
+            {
+                const uint8_t* src = static_cast<const uint8_t*>(pInitialData[index].pSysMem);
+                for(UINT r = 0; r < sub.rows; ++r)
+                    memcpy(&sub.data[r * sub.rowPitch], src + r * pInitialData[index].SysMemPitch, sub.rowPitch);
+            }
+
+            if(width > 1) width >>= 1;
+            if(height > 1) height >>= 1;
+        }
+    }
+
+    *ppTexture2D = texture;
+    return S_OK;
+}
+
+//---------------------------------------------------------------------------
+HRESULT CreateNullDevice(ID3D11Device** ppDevice, ID3D11DeviceContext** ppImmediateContext)
+{
+    if(ppDevice == NULL)
+        return E_INVALIDARG;
+    NullDevice* device = new NullDevice();
+    if(ppImmediateContext)
+        device->GetImmediateContext(ppImmediateContext);
+    *ppDevice = device;
+    return S_OK;
+}
+
+}
@@ -0,0 +1,24 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    NullDevice.h
+
+    A D3D11 device and immediate context that don't need a GPU.
+    Buffers and textures keep their size and contents in CPU memory, so
+    creating, updating, mapping and copying resources work as usual, while
+    state changes, clears and draws do nothing. Used to run the engine
+    headless, for benchmarks and automated tests.
+****************************************************************************/
+#pragma once
+
+#include <d3d11.h>
+
+namespace LvEdEngine
+{
+    // creates a null device and its immediate context.
+    // Event queries are done once the context is flushed, GetData() without
+    // D3D11_ASYNC_GETDATA_DONOTFLUSH flushes it.
+    // Texture1D, Texture3D, unordered access views, the other queries, and
+    // the hull, domain and compute shaders are not supported.
+    HRESULT CreateNullDevice(ID3D11Device** ppDevice, ID3D11DeviceContext** ppImmediateContext);
+}
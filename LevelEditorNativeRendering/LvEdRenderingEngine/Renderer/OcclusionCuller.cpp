@@ -0,0 +1,307 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    OcclusionCuller.cpp
+
+****************************************************************************/
+#include "OcclusionCuller.h"
+#include <math.h>
+#include <float.h>
+#include <emmintrin.h>
+
+using namespace LvEdEngine;
+
+static inline int32_t MinInt(int32_t a, int32_t b) { return a < b ? a : b; }
+static inline int32_t MaxInt(int32_t a, int32_t b) { return a > b ? a : b; }
+
+//---------------------------------------------------------------------------
+OcclusionCuller::OcclusionCuller(uint32_t width)
+  : m_width(0),
+    m_height(0),
+    m_tilesX(0),
+    m_tilesY(0)
+{
+    // whole tiles only, so the rasterizer never has to mask the end of a row.
+    m_tilesX = width >= TileSize ? width / TileSize : 1;
+    m_width = m_tilesX * TileSize;
+    m_stats.occluderTriangles = 0;
+    m_stats.tested = 0;
+    m_stats.culled = 0;
+}
+
+//---------------------------------------------------------------------------
+void OcclusionCuller::Begin(const Matrix& view, const Matrix& proj)
+{
+    // M22/M11 is the aspect ratio for both perspective and orthographic projections.
+    float aspect = (proj.M11 != 0.0f) ? fabsf(proj.M22 / proj.M11) : 1.0f;
+    aspect = maximize(aspect, 0.25f);
+    aspect = minimize(aspect, 4.0f);
+    uint32_t height = (uint32_t)((float)m_width / aspect + 0.5f);
+    m_tilesY = height >= TileSize ? (height + TileSize - 1) / TileSize : 1;
+    m_height = m_tilesY * TileSize;
+
+    m_viewProj = view * proj;
+    m_depth.assign(m_width * m_height, 1.0f);
+    m_tileDepth.assign(m_tilesX * m_tilesY, 1.0f);
+    m_stats.occluderTriangles = 0;
+    m_stats.tested = 0;
+    m_stats.culled = 0;
+}
+
+//---------------------------------------------------------------------------
+void OcclusionCuller::TransformVertices(const float3* pos, uint32_t count, const Matrix& world)
+{
+    Matrix xform = world * m_viewProj;
+    m_clipVerts.resize(count);
+    for(uint32_t i = 0; i < count; ++i)
+    {
+        m_clipVerts[i] = float4::Transform(float4(pos[i].x, pos[i].y, pos[i].z, 1.0f), xform);
+    }
+}
+
+//---------------------------------------------------------------------------
+void OcclusionCuller::RasterizeMesh(const float3* pos, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount,
+                                    const Matrix& world, bool cullBackFaces)
+{
+    if(vertexCount == 0 || indexCount < 3)
+        return;
+
+    TransformVertices(pos, vertexCount, world);
+    for(uint32_t i = 0; i + 2 < indexCount; i += 3)
+    {
+        uint32_t i0 = indices[i], i1 = indices[i + 1], i2 = indices[i + 2];
+        if(i0 >= vertexCount || i1 >= vertexCount || i2 >= vertexCount)
+            continue;
+        RasterizeClipTriangle(m_clipVerts[i0], m_clipVerts[i1], m_clipVerts[i2], cullBackFaces);
+    }
+}
+
+//---------------------------------------------------------------------------
+void OcclusionCuller::RasterizeHeightGrid(const float* heights, uint32_t dim, float x0, float z0, float step,
+                                          const Matrix& world)
+{
+    if(dim < 2)
+        return;
+
+    Matrix xform = world * m_viewProj;
+    m_clipVerts.resize(dim * dim);
+    for(uint32_t z = 0; z < dim; ++z)
+    {
+        for(uint32_t x = 0; x < dim; ++x)
+        {
+            uint32_t i = z * dim + x;
+            float4 p(x0 + x * step, heights[i], z0 + z * step, 1.0f);
+            m_clipVerts[i] = float4::Transform(p, xform);
+        }
+    }
+
+    // same triangulation as the terrain patches, ACD and ADB.
+    for(uint32_t z = 0; z < dim - 1; ++z)
+    {
+        for(uint32_t x = 0; x < dim - 1; ++x)
+        {
+            const float4& a = m_clipVerts[z * dim + x];
+            const float4& b = m_clipVerts[z * dim + x + 1];
+            const float4& c = m_clipVerts[(z + 1) * dim + x];
+            const float4& d = m_clipVerts[(z + 1) * dim + x + 1];
+            RasterizeClipTriangle(a, c, d, true);
+            RasterizeClipTriangle(a, d, b, true);
+        }
+    }
+}
+
+//---------------------------------------------------------------------------
+// clips the triangle against the near plane (z = 0) and rasterizes the rest.
+// The other planes are handled by clamping to the screen.
+void OcclusionCuller::RasterizeClipTriangle(const float4& a, const float4& b, const float4& c, bool cullBackFaces)
+{
+    const float4* in[3] = { &a, &b, &c };
+    float4 poly[4];
+    uint32_t count = 0;
+    for(uint32_t i = 0; i < 3; ++i)
+    {
+        const float4& p = *in[i];
+        const float4& q = *in[(i + 1) % 3];
+        bool pIn = p.z >= 0.0f;
+        bool qIn = q.z >= 0.0f;
+        if(pIn)
+            poly[count++] = p;
+        if(pIn != qIn)
+        {
+            float t = p.z / (p.z - q.z);
+            poly[count++] = p + (q - p) * t;
+        }
+    }
+    if(count < 3)
+        return;
+
+    float3 screen[4];
+    for(uint32_t i = 0; i < count; ++i)
+    {
+        // in front of the near plane w is positive for both perspective and orthographic projections.
+        float invW = 1.0f / maximize(poly[i].w, 1e-6f);
+        screen[i].x = (poly[i].x * invW * 0.5f + 0.5f) * (float)m_width;
+        screen[i].y = (0.5f - poly[i].y * invW * 0.5f) * (float)m_height;
+        screen[i].z = poly[i].z * invW;
+    }
+    RasterizeTriangle(screen[0], screen[1], screen[2], cullBackFaces);
+    if(count == 4)
+        RasterizeTriangle(screen[0], screen[2], screen[3], cullBackFaces);
+}
+
+//---------------------------------------------------------------------------
+void OcclusionCuller::RasterizeTriangle(const float3& v0, const float3& v1In, const float3& v2In, bool cullBackFaces)
+{
+    // CCW front faces are CW once y points down.
+    float area = (v1In.x - v0.x) * (v2In.y - v0.y) - (v1In.y - v0.y) * (v2In.x - v0.x);
+    if(cullBackFaces && area >= 0.0f)
+        return;
+    if(fabsf(area) < 1e-8f)
+        return;
+
+    // reorder so the edge functions are positive inside.
+    const float3& v1 = area > 0.0f ? v1In : v2In;
+    const float3& v2 = area > 0.0f ? v2In : v1In;
+    area = fabsf(area);
+
+    float minX = minimize(v0.x, minimize(v1.x, v2.x));
+    float maxX = maximize(v0.x, maximize(v1.x, v2.x));
+    float minY = minimize(v0.y, minimize(v1.y, v2.y));
+    float maxY = maximize(v0.y, maximize(v1.y, v2.y));
+    if(maxX < 0.0f || maxY < 0.0f || minX >= (float)m_width || minY >= (float)m_height)
+        return;
+
+    int32_t x0 = MaxInt((int32_t)floorf(minX), 0) & ~3;
+    int32_t x1 = MinInt((int32_t)ceilf(maxX), (int32_t)m_width - 1);
+    int32_t y0 = MaxInt((int32_t)floorf(minY), 0);
+    int32_t y1 = MinInt((int32_t)ceilf(maxY), (int32_t)m_height - 1);
+
+    // edge ij: E(p) = A * p.x + B * p.y + C, positive on the inner side.
+    float a12 = v1.y - v2.y, b12 = v2.x - v1.x, c12 = -(a12 * v1.x + b12 * v1.y);
+    float a20 = v2.y - v0.y, b20 = v0.x - v2.x, c20 = -(a20 * v2.x + b20 * v2.y);
+    float a01 = v0.y - v1.y, b01 = v1.x - v0.x, c01 = -(a01 * v0.x + b01 * v0.y);
+
+    // depth plane from the barycentric weights E12/area, E20/area and E01/area.
+    float invArea = 1.0f / area;
+    float za = (v0.z * a12 + v1.z * a20 + v2.z * a01) * invArea;
+    float zb = (v0.z * b12 + v1.z * b20 + v2.z * b01) * invArea;
+    float zc = (v0.z * c12 + v1.z * c20 + v2.z * c01) * invArea;
+
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 pixelOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+    const __m128 step4e0 = _mm_set1_ps(4.0f * a12);
+    const __m128 step4e1 = _mm_set1_ps(4.0f * a20);
+    const __m128 step4e2 = _mm_set1_ps(4.0f * a01);
+    const __m128 step4z  = _mm_set1_ps(4.0f * za);
+
+    for(int32_t y = y0; y <= y1; ++y)
+    {
+        float py = (float)y + 0.5f;
+        __m128 px = _mm_add_ps(_mm_set1_ps((float)x0), pixelOffsets);
+        __m128 e0 = _mm_add_ps(_mm_mul_ps(px, _mm_set1_ps(a12)), _mm_set1_ps(b12 * py + c12));
+        __m128 e1 = _mm_add_ps(_mm_mul_ps(px, _mm_set1_ps(a20)), _mm_set1_ps(b20 * py + c20));
+        __m128 e2 = _mm_add_ps(_mm_mul_ps(px, _mm_set1_ps(a01)), _mm_set1_ps(b01 * py + c01));
+        __m128 z  = _mm_add_ps(_mm_mul_ps(px, _mm_set1_ps(za)),  _mm_set1_ps(zb * py + zc));
+
+        float* row = &m_depth[y * m_width];
+        for(int32_t x = x0; x <= x1; x += 4)
+        {
+            // strictly inside only, pixels touched by an edge aren't considered covered.
+            __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpgt_ps(e0, zero), _mm_cmpgt_ps(e1, zero)),
+                                       _mm_cmpgt_ps(e2, zero));
+            if(_mm_movemask_ps(inside))
+            {
+                __m128 depth = _mm_loadu_ps(row + x);
+                __m128 nearer = _mm_min_ps(depth, z);
+                _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearer), _mm_andnot_ps(inside, depth)));
+            }
+            e0 = _mm_add_ps(e0, step4e0);
+            e1 = _mm_add_ps(e1, step4e1);
+            e2 = _mm_add_ps(e2, step4e2);
+            z  = _mm_add_ps(z, step4z);
+        }
+    }
+    m_stats.occluderTriangles++;
+}
+
+//---------------------------------------------------------------------------
+void OcclusionCuller::End()
+{
+    for(uint32_t ty = 0; ty < m_tilesY; ++ty)
+    {
+        for(uint32_t tx = 0; tx < m_tilesX; ++tx)
+        {
+            __m128 tileMax = _mm_setzero_ps();
+            for(uint32_t y = 0; y < TileSize; ++y)
+            {
+                const float* row = &m_depth[(ty * TileSize + y) * m_width + tx * TileSize];
+                tileMax = _mm_max_ps(tileMax, _mm_max_ps(_mm_loadu_ps(row), _mm_loadu_ps(row + 4)));
+            }
+            float lanes[4];
+            _mm_storeu_ps(lanes, tileMax);
+            m_tileDepth[ty * m_tilesX + tx] = maximize(maximize(lanes[0], lanes[1]), maximize(lanes[2], lanes[3]));
+        }
+    }
+}
+
+//---------------------------------------------------------------------------
+bool OcclusionCuller::IsVisible(const AABB& bounds)
+{
+    m_stats.tested++;
+    if(!HasOccluders())
+        return true;
+
+    float minX = FLT_MAX, minY = FLT_MAX, minZ = FLT_MAX;
+    float maxX = -FLT_MAX, maxY = -FLT_MAX;
+    for(uint32_t i = 0; i < 8; ++i)
+    {
+        float4 corner((i & 1) ? bounds.Max().x : bounds.Min().x,
+                      (i & 2) ? bounds.Max().y : bounds.Min().y,
+                      (i & 4) ? bounds.Max().z : bounds.Min().z, 1.0f);
+        float4 clip = float4::Transform(corner, m_viewProj);
+        if(clip.z < 0.0f || clip.w <= 1e-6f)
+            return true;
+        float invW = 1.0f / clip.w;
+        float sx = (clip.x * invW * 0.5f + 0.5f) * (float)m_width;
+        float sy = (0.5f - clip.y * invW * 0.5f) * (float)m_height;
+        minX = minimize(minX, sx); maxX = maximize(maxX, sx);
+        minY = minimize(minY, sy); maxY = maximize(maxY, sy);
+        minZ = minimize(minZ, clip.z * invW);
+    }
+
+    // off screen parts aren't visible, frustum culling deals with the rest.
+    if(maxX < 0.0f || maxY < 0.0f || minX >= (float)m_width || minY >= (float)m_height)
+        return true;
+
+    // every pixel the rectangle touches.
+    int32_t x0 = MaxInt((int32_t)floorf(minX), 0);
+    int32_t x1 = MinInt((int32_t)floorf(maxX), (int32_t)m_width - 1);
+    int32_t y0 = MaxInt((int32_t)floorf(minY), 0);
+    int32_t y1 = MinInt((int32_t)floorf(maxY), (int32_t)m_height - 1);
+
+    for(int32_t ty = y0 / (int32_t)TileSize; ty <= y1 / (int32_t)TileSize; ++ty)
+    {
+        for(int32_t tx = x0 / (int32_t)TileSize; tx <= x1 / (int32_t)TileSize; ++tx)
+        {
+            if(m_tileDepth[ty * m_tilesX + tx] < minZ)
+                continue;
+
+            // the tile isn't fully covered in front of the bounds, check its pixels.
+            int32_t px0 = MaxInt(x0, tx * (int32_t)TileSize);
+            int32_t px1 = MinInt(x1, (tx + 1) * (int32_t)TileSize - 1);
+            int32_t py0 = MaxInt(y0, ty * (int32_t)TileSize);
+            int32_t py1 = MinInt(y1, (ty + 1) * (int32_t)TileSize - 1);
+            for(int32_t y = py0; y <= py1; ++y)
+            {
+                const float* row = &m_depth[y * m_width];
+                for(int32_t x = px0; x <= px1; ++x)
+                {
+                    if(row[x] >= minZ)
+                        return true;
+                }
+            }
+        }
+    }
+    m_stats.culled++;
+    return false;
+}
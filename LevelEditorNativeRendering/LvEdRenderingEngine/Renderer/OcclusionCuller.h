@@ -0,0 +1,77 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    OcclusionCuller.h
+
+    Software occlusion culling. Occluders are rasterized into a small CPU
+    depth buffer, four pixels at a time with SSE2, and bounds are tested
+    against the per tile max depth before falling back to the pixels.
+    Only depends on VectorMath, no GPU involved.
+****************************************************************************/
+#pragma once
+#include <vector>
+#include "../Core/NonCopyable.h"
+#include "../VectorMath/V3dMath.h"
+#include "../VectorMath/CollisionPrimitives.h"
+
+namespace LvEdEngine
+{
+    struct OcclusionStats
+    {
+        uint32_t occluderTriangles; // triangles rasterized into the depth buffer.
+        uint32_t tested;            // bounds tested since Begin().
+        uint32_t culled;            // bounds found to be fully occluded.
+    };
+
+    class OcclusionCuller : public NonCopyable
+    {
+    public:
+        static const uint32_t TileSize = 8;
+
+        // width of the depth buffer in pixels, the height follows the aspect ratio of the projection.
+        OcclusionCuller(uint32_t width = 256);
+
+        // clears the depth buffer and the stats.
+        void Begin(const Matrix& view, const Matrix& proj);
+
+        // rasterizes an indexed triangle list.
+        // both faces are rasterized unless cullBackFaces is set, front faces are CCW.
+        void RasterizeMesh(const float3* pos, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount,
+                           const Matrix& world, bool cullBackFaces);
+
+        // rasterizes a dim x dim grid of heights laid out on the xz plane, row by row along +z,
+        // starting at (x0, z0) with the given spacing. Triangles face +y.
+        void RasterizeHeightGrid(const float* heights, uint32_t dim, float x0, float z0, float step,
+                                 const Matrix& world);
+
+        // builds the tile depths, call after rasterizing all the occluders.
+        void End();
+
+        // true if anything was rasterized since Begin().
+        bool HasOccluders() const { return m_stats.occluderTriangles > 0; }
+
+        // returns false if the world space bounds are hidden behind the occluders.
+        // Bounds crossing the near plane are always visible. Updates the stats,
+        // so only call it from one thread at a time.
+        bool IsVisible(const AABB& bounds);
+
+        const OcclusionStats& GetStats() const { return m_stats; }
+        uint32_t GetWidth() const { return m_width; }
+        uint32_t GetHeight() const { return m_height; }
+
+    private:
+        void TransformVertices(const float3* pos, uint32_t count, const Matrix& world);
+        void RasterizeClipTriangle(const float4& a, const float4& b, const float4& c, bool cullBackFaces);
+        void RasterizeTriangle(const float3& v0, const float3& v1, const float3& v2, bool cullBackFaces);
+
+        uint32_t m_width;
+        uint32_t m_height;
+        uint32_t m_tilesX;
+        uint32_t m_tilesY;
+        Matrix m_viewProj;
+        std::vector<float> m_depth;     // z/w per pixel, 1 is the far plane.
+        std::vector<float> m_tileDepth; // max depth of each tile.
+        std::vector<float4> m_clipVerts; // scratch, vertices in clip space.
+        OcclusionStats m_stats;
+    };
+}
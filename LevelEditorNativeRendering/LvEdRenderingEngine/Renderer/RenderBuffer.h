@@ -1,7 +1,7 @@
 //Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
 
 #pragma once
-#include <D3D11.h>
+#include <d3d11.h>
 #include "../Core/Utils.h"
 #include "../Core/WinHeaders.h"
 #include "../Core/NonCopyable.h"
@@ -2,7 +2,8 @@
 
 #include "RenderContext.h"
 #include "RenderState.h"
-#include "..\Core\Utils.h"
+#include "../Core/Utils.h"
+#include <float.h>
 
 namespace LvEdEngine
 {
@@ -16,7 +17,6 @@ namespace LvEdEngine
         s_inst = new RenderContext();
 
     s_inst->m_device = device;    
-    s_inst->LightEnvDirty = true;
 }
 
 RenderContext::~RenderContext()
@@ -29,4 +29,24 @@ namespace LvEdEngine
    
 }
 
+//---------------------------------------------------------------------------
+bool RenderContext::IsSmallFeature(const AABB& bounds) const
+{
+    if(m_smallFeatureSize <= 0)
+        return false;
+    return ComputeScreenSize(bounds) < m_smallFeatureSize;
+}
+
+//---------------------------------------------------------------------------
+float RenderContext::ComputeScreenSize(const AABB& bounds) const
+{
+    // at the distance of the center of the bounding sphere.
+    float3 center = bounds.GetCenter();
+    float diameter = length(bounds.Max() - bounds.Min());
+    if(!m_cam.IsOrtho() && length(center - m_cam.CamPos()) <= diameter * 0.5f)
+        return FLT_MAX;
+    float unitPerPixel = m_cam.ComputeUnitPerPixel(center, m_viewPort.y);
+    return diameter / unitPerPixel;
+}
+
 }
@@ -1,7 +1,7 @@
 //Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
 
 #pragma once
-#include <D3D11.h>
+#include <d3d11.h>
 #include "../VectorMath/V3dMath.h"
 #include "../VectorMath/CollisionPrimitives.h"
 #include "../Core/Object.h"
@@ -10,13 +10,12 @@
 #include <map>
 #include "Lights.h"
 #include "../VectorMath/Camera.h"
-#include <set>
-
-typedef std::set<ObjectGUID> Selection;
+#include "Selection.h"
 
 namespace LvEdEngine
 {
     class RenderState;
+    class CommandBackend;
     
      class RenderContext : public NonCopyable
      {
@@ -31,6 +30,8 @@ class RenderContext : public NonCopyable
         ID3D11DeviceContext* Context() const {return m_context;}        
         RenderState* State() const {return m_currentState; }
         Camera& Cam()  {return m_cam;}
+        // executes the command buffers recorded by the shaders.
+        CommandBackend* Backend() const {return m_backend;}
         
         const ExpFog& GlobalFog() const {return m_fog;}
         const float4& ViewPort(){return m_viewPort;}
@@ -39,19 +40,30 @@ class RenderContext : public NonCopyable
         void  SetFog(ExpFog fog) { m_fog = fog;}
         // Setting Context State        
         void SetContext(ID3D11DeviceContext* context){m_context = context;}
+        // the backend is not owned by the render context.
+        void SetBackend(CommandBackend* backend){m_backend = backend;}
         // Object Ids of any items currently selected.
         Selection selection;
-        bool LightEnvDirty;
+
+        // objects whose bounds cover less than this many pixels on screen are
+        // not drawn, 0 disables small feature culling.
+        void SetSmallFeatureSize(float pixels) { m_smallFeatureSize = pixels; }
+        float GetSmallFeatureSize() const { return m_smallFeatureSize; }
+        bool IsSmallFeature(const AABB& bounds) const;
+        // diameter of the bounding sphere in pixels, FLT_MAX if the camera is inside.
+        float ComputeScreenSize(const AABB& bounds) const;
 
     private:
-        RenderContext() {}
+        RenderContext() : m_backend(NULL), m_smallFeatureSize(0) {}
         ~RenderContext();
         Camera m_cam;
         ID3D11Device* m_device;
         ID3D11DeviceContext* m_context;        
+        CommandBackend* m_backend;
         float4 m_viewPort;
         ExpFog  m_fog;
         RenderState* m_currentState;
+        float m_smallFeatureSize;
         static RenderContext*   s_inst;
     };
 }
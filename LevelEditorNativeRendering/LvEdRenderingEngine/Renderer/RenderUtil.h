@@ -7,10 +7,13 @@
 #include "../VectorMath/V3dMath.h"
 #include "../VectorMath/CollisionPrimitives.h"
 #include "RenderEnums.h"
+#include "ShaderCache.h"
 #include <d3d11.h>
 
 namespace LvEdEngine
 {    
     // SHADERS
     ID3DBlob* CompileShaderFromResource(LPCWSTR resourceName, LPCSTR szEntryPoint, LPCSTR szShaderModel, const D3D_SHADER_MACRO *shaderMacros);   
+    // the code of the shader from the ShaderCache, see EngineShaders.h for the engine's own.
+    ID3DBlob* CompileShader(const ShaderCache::ShaderDesc& desc);
 };
@@ -8,9 +8,10 @@
 #include "../VectorMath/V3dMath.h"
 #include "../VectorMath/CollisionPrimitives.h"
 #include "../Core/StringBlob.h"
+#include "../Core/FrameArena.h"
 #include "RenderEnums.h"
 #include "Lights.h"
-#include "D3DCommon.h"
+#include <d3dcommon.h>
 
 namespace LvEdEngine
 {    
@@ -28,7 +29,9 @@ enum Flags
             kShadowCaster           = 1 << 0,
             kShadowReceiver         = 1 << 1,
             kTestAgainstBBoxOnly    = 1 << 2,   // hit test: should the hit test against the mesh?
-            kNotPickable            = 1 << 3  // this node is not pickable
+            kNotPickable            = 1 << 3, // this node is not pickable
+            kOccluder               = 1 << 4, // the mesh hides whatever is behind it, see OcclusionCuller.
+            kSelected               = 1 << 5  // set by RenderableNodeSorter, the wire-frame pass highlights the node.
         };
 
         RenderableNode()
@@ -38,6 +41,7 @@ enum Flags
             SetFlag( kShadowReceiver, true );            
             
             objectId = 0;
+            objectIndex = 0;
             diffuse.x = diffuse.y = diffuse.z = diffuse.w = 1.0f;
             specular.x = specular.y = specular.z = 0.0f;
             emissive = float4(0,0,0,0);
@@ -46,6 +50,8 @@ enum Flags
                 textures[t] = NULL;
             
             mesh = NULL;
+            indexStart = 0;
+            indexCount = 0;
             lighting.numDirLights = 0;
             lighting.numBoxLights = 0;
             lighting.numPointLights = 0;
@@ -53,6 +59,10 @@ enum Flags
 
         // The mesh to draw.
         Mesh* mesh;
+
+        // range of the mesh indices to draw, indexCount 0 draws all of them.
+        uint32_t indexStart;
+        uint32_t indexCount;
         
         // world transform matrix
         Matrix WorldXform;
@@ -65,8 +75,10 @@ enum Flags
         uint32_t flags;
         LightEnvironment lighting;
 
-        // the handle of the game object that created this node.
+        // the handle of the game object that created this node,
+        // and its object index, see Selection::IsSelected().
         ObjectGUID objectId;
+        uint32_t objectIndex;
 
         float Distance;
 
@@ -76,5 +88,7 @@ enum Flags
         bool    GetFlag( Flags flagBit ) const          { return (( flags & flagBit ) != 0 ); }
     };
     typedef std::vector<RenderableNode> RenderNodeList;
+    // the nodes collected for the current frame, see RenderableNodeSorter.
+    typedef FrameVector<RenderableNode> FrameNodeList;
 }
 
@@ -27,7 +27,7 @@
     if(m_skipSelected)
     {
         RenderContext* context = RenderContext::Inst();
-        if( context->selection.find( r.objectId ) != context->selection.end() )
+        if( context->selection.IsSelected( r.objectId, r.objectIndex ) )
             return;        
     }
 
@@ -39,9 +39,8 @@
 {
     if(m_skipSelected && listBegin != listEnd)
     {
-        ObjectGUID gobId = listBegin->objectId;
         RenderContext* context = RenderContext::Inst();
-        if( context->selection.find( gobId ) != context->selection.end() )
+        if( context->selection.IsSelected( listBegin->objectId, listBegin->objectIndex ) )
             return;
 
     }
@@ -10,6 +10,7 @@
 #include <algorithm>
 #include "Model.h"
 #include "RenderContext.h"
+#include "../Core/TaskPool.h"
 
 
 using namespace LvEdEngine;
@@ -19,6 +20,7 @@
 
 //---------------------------------------------------------------------------
 RenderableNodeSorter::RenderableNodeSorter()
+  : m_runKey(NoRunKey)
 {
 }
 
@@ -33,6 +35,7 @@
     for ( auto it=m_buckets.begin(); it != m_buckets.end(); ++it )
     {
         it->second.renderables.clear();
+        it->second.runs.clear();
     }
     ClearBounds();
 }
@@ -75,7 +78,15 @@ static bool BucketKeySorting(const uint32_t n1, const uint32_t n2)
         m_bucketKeys.push_back(bucketKey);
         std::sort(m_bucketKeys.begin(), m_bucketKeys.end(), BucketKeySorting);
     }
-    return it->second;
+
+    Bucket& bucket = it->second;
+    if(m_runKey != NoRunKey && (bucket.runs.empty() || bucket.runs.back().key != m_runKey))
+    {
+        // every caller appends to the bucket right away.
+        Bucket::Run run = { m_runKey, (uint32_t)bucket.renderables.size() };
+        bucket.runs.push_back(run);
+    }
+    return bucket;
 }
 
 //---------------------------------------------------------------------------
@@ -84,7 +95,7 @@ static bool BucketKeySorting(const uint32_t n1, const uint32_t n2)
     
     assert(shaderId != Shaders::NONE);
     RenderContext* context = RenderContext::Inst();
-    bool selected = ( context->selection.find( r.objectId ) != context->selection.end() );    
+    bool selected = context->selection.IsSelected( r.objectId, r.objectIndex );
          
     PrimitiveTypeEnum primtype = r.mesh->primitiveType;
     GlobalRenderFlagsEnum gflags = this->GetFlags();
@@ -97,21 +108,22 @@ static bool BucketKeySorting(const uint32_t n1, const uint32_t n2)
     bool wireflagset = (gflags & GlobalRenderFlags::WireFrame) != 0;    
     if(triPrim)
     {
+         // the node is added once, the wire-frame of the solid nodes is
+         // drawn from the solid buckets, see WireFrameShader::DrawHighlights().
          if(gflags & GlobalRenderFlags::Solid) 
          {
              Bucket& bucket = GetOrMakeBucket(flags, shaderId);
              bucket.renderables.push_back( r );
+             bucket.renderables.back().SetFlag(RenderableNode::kSelected, selected);
              if(r.GetFlag(RenderableNode::kShadowCaster))
                  m_bounds.Extend(r.bounds);    
          }
-
-         if(selected || wireflagset)
+         else if(selected || wireflagset)
          {
-             RenderableNode node = r;
-             node.diffuse = selected ? context->State()->GetSelectionColor() : context->State()->GetWireframeColor();
              flags &= ~RenderFlags::AlphaBlend;             
              Bucket& bucket = GetOrMakeBucket(flags, Shaders::WireFrameShader );
-             bucket.renderables.push_back( node );
+             bucket.renderables.push_back( r );
+             bucket.renderables.back().SetFlag(RenderableNode::kSelected, selected);
          }         
     }
     else
@@ -140,9 +152,8 @@ static bool BucketKeySorting(const uint32_t n1, const uint32_t n2)
     // use the first renderable to detect if parent gob is selected
     // and also if the gob is shadow caster.
     assert(shaderId != Shaders::NONE);
-    ObjectGUID gobId = listBegin->objectId;
     RenderContext* context = RenderContext::Inst();
-    bool selected = ( context->selection.find( gobId ) != context->selection.end() );
+    bool selected = context->selection.IsSelected( listBegin->objectId, listBegin->objectIndex );
     //bool isShadowCaster = listBegin->GetFlag( RenderableNode::kShadowCaster );
     GlobalRenderFlagsEnum gflags = this->GetFlags();
 
@@ -156,29 +167,28 @@ static bool BucketKeySorting(const uint32_t n1, const uint32_t n2)
     bool wireflagset = (gflags & GlobalRenderFlags::WireFrame) != 0;
     if(triPrim)
     {
+         Bucket* bucket = NULL;
          if(gflags & GlobalRenderFlags::Solid)
          {
-             Bucket& bucket = GetOrMakeBucket(flags, shaderId);
-             bucket.renderables.insert( bucket.renderables.end(), listBegin, listEnd );
+             bucket = &GetOrMakeBucket(flags, shaderId);
              for ( auto it = listBegin; it != listEnd; ++it )      
              {
                  if(it->GetFlag(RenderableNode::kShadowCaster))
                      m_bounds.Extend(it->bounds);  
              }
          }
-
-         if(selected || wireflagset)
+         else if(selected || wireflagset)
          {
-             float4 color = selected ? context->State()->GetSelectionColor() : context->State()->GetWireframeColor();
              flags &= ~RenderFlags::AlphaBlend;             
-             Bucket& bucket = GetOrMakeBucket(flags, Shaders::WireFrameShader );
+             bucket = &GetOrMakeBucket(flags, Shaders::WireFrameShader );
+         }
 
-             for ( auto it = listBegin; it != listEnd; ++it )      
-             {
-                 RenderableNode node = (*it);
-                 node.diffuse = color;
-                 bucket.renderables.push_back(node);
-             }
+         if(bucket)
+         {
+             size_t first = bucket->renderables.size();
+             bucket->renderables.insert( bucket->renderables.end(), listBegin, listEnd );
+             for ( size_t k = first; k < bucket->renderables.size(); ++k )
+                 bucket->renderables[k].SetFlag(RenderableNode::kSelected, selected);
          }
     }
     else
@@ -203,6 +213,117 @@ static bool BucketKeySorting(const uint32_t n1, const uint32_t n2)
     }
 }
 
+//---------------------------------------------------------------------------
+struct RenderableNodeSorter::MergeData
+{
+    RenderableNodeSorter*  dest;
+    RenderableNodeSorter** sources;
+    uint32_t               sourceCount;
+    FrameVector<uint32_t>  bucketKeys;
+};
+
+// a run of nodes in one of the source buckets.
+struct MergeSegment
+{
+    uint32_t key;
+    uint32_t source;
+    uint32_t begin;
+    uint32_t end;
+};
+
+//---------------------------------------------------------------------------
+static bool MergeSegmentSorting(const MergeSegment& s1, const MergeSegment& s2)
+{
+    if(s1.key != s2.key)
+        return s1.key < s2.key;
+    return s1.source < s2.source;
+}
+
+//---------------------------------------------------------------------------
+// merges one bucket, called for different buckets at the same time.
+void RenderableNodeSorter::MergeBucket(void* userData, uint32_t index, uint32_t /*thread*/)
+{
+    MergeData* data = (MergeData*)userData;
+    uint32_t bucketKey = data->bucketKeys[index];
+
+    FrameVector<MergeSegment> segments;
+    size_t total = 0;
+    for(uint32_t s = 0; s < data->sourceCount; ++s)
+    {
+        BucketMap& srcBuckets = data->sources[s]->m_buckets;
+        BucketMap::iterator it = srcBuckets.find(bucketKey);
+        if(it == srcBuckets.end())
+            continue;
+        Bucket& src = it->second;
+        assert(src.renderables.empty() || !src.runs.empty());
+        for(size_t r = 0; r < src.runs.size(); ++r)
+        {
+            MergeSegment seg;
+            seg.key = src.runs[r].key;
+            seg.source = s;
+            seg.begin = src.runs[r].begin;
+            seg.end = (r + 1 < src.runs.size()) ? src.runs[r + 1].begin : (uint32_t)src.renderables.size();
+            if(seg.end > seg.begin)
+            {
+                segments.push_back(seg);
+                total += seg.end - seg.begin;
+            }
+        }
+    }
+    std::sort(segments.begin(), segments.end(), MergeSegmentSorting);
+
+    // the bucket already exists, so find() doesn't modify the map.
+    Bucket& dest = data->dest->m_buckets.find(bucketKey)->second;
+    dest.renderables.reserve(dest.renderables.size() + total);
+    for(auto it = segments.begin(); it != segments.end(); ++it)
+    {
+        FrameNodeList& src = data->sources[it->source]->m_buckets.find(bucketKey)->second.renderables;
+        dest.renderables.insert(dest.renderables.end(), src.begin() + it->begin, src.begin() + it->end);
+    }
+}
+
+//---------------------------------------------------------------------------
+void RenderableNodeSorter::Merge(RenderableNodeSorter** sources, uint32_t count, TaskPool* pool)
+{
+    MergeData data;
+    data.dest = this;
+    data.sources = sources;
+    data.sourceCount = count;
+
+    // create the destination buckets up front, the bucket map must not
+    // change while buckets are merged in parallel.
+    for(uint32_t s = 0; s < count; ++s)
+    {
+        RenderableNodeSorter* src = sources[s];
+        for(auto it = src->m_buckets.begin(); it != src->m_buckets.end(); ++it)
+        {
+            if(it->second.renderables.empty())
+                continue;
+            GetOrMakeBucket(it->second.renderFlags, it->second.shaderId);
+            data.bucketKeys.push_back(it->first);
+        }
+        m_bounds.Extend(src->m_bounds);
+    }
+    std::sort(data.bucketKeys.begin(), data.bucketKeys.end(), BucketKeySorting);
+    data.bucketKeys.erase(std::unique(data.bucketKeys.begin(), data.bucketKeys.end()), data.bucketKeys.end());
+
+    uint32_t numBuckets = (uint32_t)data.bucketKeys.size();
+    if(pool)
+    {
+        pool->Run(numBuckets, &RenderableNodeSorter::MergeBucket, &data);
+    }
+    else
+    {
+        for(uint32_t i = 0; i < numBuckets; ++i)
+            MergeBucket(&data, i, 0);
+    }
+
+    for(uint32_t s = 0; s < count; ++s)
+    {
+        sources[s]->ClearLists();
+    }
+}
+
 //---------------------------------------------------------------------------
 void RenderableNodeSorter::Debug_GetStats( uint32_t& numBuckets, uint32_t& numItems )
 {
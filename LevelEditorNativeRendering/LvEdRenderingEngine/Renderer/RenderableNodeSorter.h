@@ -9,6 +9,8 @@
 
 namespace LvEdEngine
 {
+    class TaskPool;
+
     class RenderableNodeSorter : public RenderableNodeCollector
     {
     public:
@@ -26,12 +28,31 @@ class RenderableNodeSorter : public RenderableNodeCollector
 
         virtual void Debug_GetStats( uint32_t& numBuckets, uint32_t& numItems );
 
+        // Tags the nodes added from now on with the given key.
+        // Merge() orders the nodes of several sorters by these keys, so
+        // collecting with one sorter per thread and merging gives the
+        // same buckets as collecting everything with a single sorter.
+        static const uint32_t NoRunKey = 0xFFFFFFFF;
+        void SetRunKey(uint32_t key) { m_runKey = key; }
+
+        // Appends the nodes of the given sorters to this one ordered by run key,
+        // then clears the sources. Buckets are merged on the pool if one is given.
+        void Merge(RenderableNodeSorter** sources, uint32_t count, TaskPool* pool);
+
         class Bucket
         {
         public:
+            // a sequence of nodes added under the same run key.
+            struct Run
+            {
+                uint32_t key;
+                uint32_t begin; // index of the first node of the run.
+            };
+
             ShadersEnum     shaderId;
             RenderFlagsEnum renderFlags;
-            RenderNodeList  renderables;
+            FrameNodeList   renderables;
+            FrameVector<Run> runs;  // only recorded while a run key is set.
 
             Bucket() : renderFlags((RenderFlagsEnum)0) {}
         };
@@ -44,7 +65,11 @@ class Bucket
         typedef std::vector<uint32_t> BucketKeys;
         BucketMap       m_buckets;
         BucketKeys      m_bucketKeys;
+        uint32_t        m_runKey;
         Bucket&         GetOrMakeBucket( uint32_t rf, ShadersEnum shaderId);
+
+        struct MergeData;
+        static void     MergeBucket(void* userData, uint32_t index, uint32_t thread);
     };
 
 }
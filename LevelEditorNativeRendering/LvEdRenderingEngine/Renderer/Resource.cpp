@@ -11,6 +11,7 @@ namespace LvEdEngine
 {
     m_refCount = 0;
     m_ready = false;
+    m_lastUsed = GetTickCount();
 }
 
 // -----------------------------------------------------------------------------------------------
@@ -22,19 +23,21 @@ namespace LvEdEngine
 // -----------------------------------------------------------------------------------------------
 void Resource::AddRef()
 {
-    ++m_refCount;
+    InterlockedIncrement(&m_refCount);
+    m_lastUsed = GetTickCount();
 }
 
 // -----------------------------------------------------------------------------------------------
 void Resource::Release()
 {
-    --m_refCount;
+    m_lastUsed = GetTickCount();
+    InterlockedDecrement(&m_refCount);
 }
 
 // -----------------------------------------------------------------------------------------------
 int Resource::GetRef()
 {
-    return m_refCount;
+    return (int)m_refCount;
 }
 
 // -----------------------------------------------------------------------------------------------
@@ -46,6 +49,8 @@ namespace LvEdEngine
 // -----------------------------------------------------------------------------------------------
 void Resource::SetReady()
 {
+    // everything written while loading is visible before the flag.
+    MemoryBarrier();
     m_ready = true;
 }
 
@@ -24,9 +24,19 @@ class Resource : public Object
         int GetRef();
         bool IsReady();
         void SetReady();
+
+        // memory owned by the resource, counted against the memory budget
+        // of the ResourceManager once the resource finished loading.
+        virtual uint64_t GetCpuBytes() { return 0; }
+        virtual uint64_t GetGpuBytes() { return 0; }
+        // GetTickCount() of the last AddRef() or Release(), unreferenced
+        // resources are evicted least recently used first.
+        DWORD GetLastUsed() { return m_lastUsed; }
     protected:
-        int m_refCount;
-        bool m_ready;
+        // resources are referenced and finished by the loader threads too.
+        volatile LONG m_refCount;
+        volatile bool m_ready;
+        volatile DWORD m_lastUsed;
     };
 
     //--------------------------------------------------
@@ -7,7 +7,7 @@
 #include <stdarg.h>
 #include <d3d11.h>
 #include "FontRenderer.h"
-#include "..\Core\Utils.h"
+#include "../Core/Utils.h"
 #include "ScreenMsgPrinter.h"
 
 using namespace LvEdEngine;
@@ -41,20 +41,20 @@
 //---------------------------------------------------------------------------
 void ScreenMsgPrinter::AddMsg( const WCHAR* fmt, va_list args )
 {
-    va_list argStart = args;
-
     int buffSz = 0;
     {
-        va_list args = argStart;
-        buffSz = _vscwprintf( fmt, args ) + 1;
-        va_end(args);
+        va_list argCopy;
+        va_copy(argCopy, args);
+        buffSz = _vscwprintf( fmt, argCopy ) + 1;
+        va_end(argCopy);
     }
 
     WCHAR* buffer = (WCHAR*)_alloca( sizeof(WCHAR) * buffSz );
     {
-        va_list args = argStart;
-        vswprintf_s( buffer, (size_t)buffSz, fmt, args );
-        va_end(args);
+        va_list argCopy;
+        va_copy(argCopy, args);
+        vswprintf_s( buffer, (size_t)buffSz, fmt, argCopy );
+        va_end(argCopy);
     }
 
     int newLineCount = 0;
@@ -2,7 +2,7 @@
 
 #pragma once
 
-#include <D3D11.h>
+#include <d3d11.h>
 #include "Font.h"
 #include "FontRenderer.h"
 #include "../Core/NonCopyable.h"
@@ -0,0 +1,46 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    Selection.cpp
+
+****************************************************************************/
+#include "Selection.h"
+#include <algorithm>
+
+using namespace LvEdEngine;
+
+//---------------------------------------------------------------------------
+void Selection::Set(const ObjectGUID* ids, int count)
+{
+    Clear();
+    m_sorted.assign(ids, ids + (count > 0 ? count : 0));
+    std::sort(m_sorted.begin(), m_sorted.end());
+    m_live.clear();
+    Object::FindLive(m_sorted, &m_live);
+    for(auto it = m_live.begin(); it != m_live.end(); ++it)
+    {
+        uint32_t index = it->index;
+        if(index >= m_owners.size())
+        {
+            m_owners.resize(index + 1, 0);
+            m_bits.resize((m_owners.size() + 31) / 32, 0);
+        }
+        m_bits[index >> 5] |= 1u << (index & 31);
+        m_owners[index] = it->id;
+        m_indices.push_back(index);
+    }
+    m_count = (uint32_t)m_indices.size();
+}
+
+//---------------------------------------------------------------------------
+void Selection::Clear()
+{
+    // only touch the words of the selected objects.
+    for(auto it = m_indices.begin(); it != m_indices.end(); ++it)
+    {
+        m_bits[*it >> 5] = 0;
+        m_owners[*it] = 0;
+    }
+    m_indices.clear();
+    m_count = 0;
+}
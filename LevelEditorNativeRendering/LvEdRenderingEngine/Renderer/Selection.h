@@ -0,0 +1,53 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    Selection.h
+
+    The set of selected objects as one bit per object index, so testing a
+    node while collecting the render lists is a bit test and a compare.
+    The ids come from the editor, Set() matches them against the live
+    objects with Object::FindLive() and never dereferences them.
+****************************************************************************/
+#pragma once
+
+#include <stddef.h>
+#include <vector>
+#include "../Core/Object.h"
+
+namespace LvEdEngine
+{
+    class Selection
+    {
+    public:
+        Selection() : m_count(0) {}
+
+        // replaces the selection, ids that aren't live objects are ignored.
+        void Set(const ObjectGUID* ids, int count);
+        void Clear();
+
+        uint32_t Count() const { return m_count; }
+
+        // id and index of the object that created a RenderableNode.
+        bool IsSelected(ObjectGUID id, uint32_t index) const
+        {
+            if(index >= m_owners.size() || (m_bits[index >> 5] & (1u << (index & 31))) == 0)
+                return false;
+            // the index may have been reused by another object.
+            return m_owners[index] == id;
+        }
+
+        // obj is a live object.
+        bool IsSelected(const Object* obj) const
+        {
+            return obj != NULL && IsSelected(obj->GetInstanceId(), obj->GetObjectIndex());
+        }
+
+    private:
+        std::vector<uint32_t>   m_bits;     // one bit per object index.
+        std::vector<ObjectGUID> m_owners;   // the selected object of each set bit.
+        std::vector<uint32_t>   m_indices;  // the set bits, for Clear().
+        std::vector<ObjectGUID> m_sorted;   // scratch for Set().
+        std::vector<Object::LiveId> m_live; // scratch for Set().
+        uint32_t                m_count;
+    };
+}
@@ -64,7 +64,7 @@ class Shader : public NonCopyable
 
         //  Do the drawing.
         //  Connect resources, vertex and index buffers, and draw the world.
-        virtual void DrawNodes(const RenderNodeList& renderNodes) = 0;
+        virtual void DrawNodes(const FrameNodeList& renderNodes) = 0;
 
         //  Called after drawing.
         //  Perform any needed post-drawing cleanup.
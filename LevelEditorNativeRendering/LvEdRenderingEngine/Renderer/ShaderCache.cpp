@@ -0,0 +1,308 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+#include "ShaderCache.h"
+#include <string.h>
+#include "../Core/Utils.h"
+#include "../Core/Logger.h"
+#include "../Core/FileUtils.h"
+#include "../Core/MappedFile.h"
+#include "../Core/TaskPool.h"
+
+namespace LvEdEngine
+{
+
+// the cache files: the header, the includes, then the code.
+struct ShaderFileHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    hash64_t key;
+    uint32_t includeCount;  // each one: hash64_t hash, uint32_t name size, the name.
+    uint32_t codeSize;
+};
+static const uint32_t ShaderFileMagic = 'L' | ('V' << 8) | ('S' << 16) | ('C' << 24);
+static const uint32_t ShaderFileVersion = 1;
+
+ShaderCache* ShaderCache::s_inst = NULL;
+
+// -------------------------------------------------------------------------------------------------
+void ShaderCache::InitInstance(ShaderCompiler* compiler, const std::wstring& dir)
+{
+    if(s_inst == NULL)
+        s_inst = new ShaderCache(compiler, dir);
+}
+
+// -------------------------------------------------------------------------------------------------
+void ShaderCache::DestroyInstance()
+{
+    SAFE_DELETE(s_inst);
+}
+
+// -------------------------------------------------------------------------------------------------
+ShaderCache::ShaderCache(ShaderCompiler* compiler, const std::wstring& dir)
+    : m_compiler(compiler),
+      m_dir(dir),
+      m_memoryHits(0),
+      m_diskHits(0),
+      m_compiled(0)
+{
+    m_version = m_compiler->GetVersion();
+    InitializeCriticalSection(&m_lock);
+}
+
+// -------------------------------------------------------------------------------------------------
+ShaderCache::~ShaderCache()
+{
+    for(auto it = m_entries.begin(); it != m_entries.end(); ++it)
+        delete it->second;
+    DeleteCriticalSection(&m_lock);
+    delete m_compiler;
+}
+
+// -------------------------------------------------------------------------------------------------
+// hashes the terminator too, so that consecutive strings can't be confused.
+static hash64_t HashString(const char* str, hash64_t seed)
+{
+    if(str == NULL)
+        str = "";
+    return Hash64(str, strlen(str) + 1, seed);
+}
+
+// -------------------------------------------------------------------------------------------------
+hash64_t ShaderCache::ComputeKey(const ShaderDesc& desc, const std::string& source) const
+{
+    hash64_t key = Hash64(source.data(), source.size(), m_version);
+    key = HashString(desc.name, key);
+    key = HashString(desc.entryPoint, key);
+    key = HashString(desc.target, key);
+    for(const D3D_SHADER_MACRO* macro = desc.macros; macro && macro->Name; ++macro)
+    {
+        key = HashString(macro->Name, key);
+        key = HashString(macro->Definition, key);
+    }
+    return key;
+}
+
+// -------------------------------------------------------------------------------------------------
+bool ShaderCache::Get(const ShaderDesc& desc, std::vector<uint8_t>* code)
+{
+    std::string source;
+    if(!m_compiler->ReadSource(desc.name, &source))
+    {
+        Logger::Log(OutputMessageType::Error, "Shader source not found: %s\n", desc.name);
+        return false;
+    }
+    hash64_t key = ComputeKey(desc, source);
+
+    EnterCriticalSection(&m_lock);
+    auto it = m_entries.find(key);
+    Entry* found = it != m_entries.end() ? it->second : NULL;
+    if(found)
+        code->assign(found->code.begin(), found->code.end());
+    LeaveCriticalSection(&m_lock);
+    if(found)
+    {
+        InterlockedIncrement(&m_memoryHits);
+        return found->compiled;
+    }
+
+    Entry* entry = new Entry();
+    std::wstring file = GetFile(key);
+    if(!file.empty() && LoadEntry(file, key, entry) && IncludesMatch(entry->includes))
+    {
+        entry->compiled = true;
+        InterlockedIncrement(&m_diskHits);
+    }
+    else
+    {
+        entry->code.clear();
+        entry->includes.clear();
+        std::vector<std::string> includes;
+        entry->compiled = m_compiler->Compile(desc.name, source, desc.macros, desc.entryPoint, desc.target,
+            &entry->code, &includes);
+        if(entry->compiled)
+        {
+            for(auto name = includes.begin(); name != includes.end(); ++name)
+            {
+                Include include;
+                include.name = *name;
+                if(!HashInclude(include.name, &include.hash))
+                    break;
+                entry->includes.push_back(include);
+            }
+            InterlockedIncrement(&m_compiled);
+            if(!file.empty() && entry->includes.size() == includes.size())
+                SaveEntry(file, key, *entry);
+        }
+    }
+    code->assign(entry->code.begin(), entry->code.end());
+    bool compiled = entry->compiled;
+
+    // failures are kept too, so that they are only reported once.
+    EnterCriticalSection(&m_lock);
+    Entry*& slot = m_entries[key];
+    if(slot == NULL)
+        slot = entry;
+    else
+        delete entry;   // another thread got it first.
+    LeaveCriticalSection(&m_lock);
+    return compiled;
+}
+
+// -------------------------------------------------------------------------------------------------
+struct PrefetchData
+{
+    ShaderCache* cache;
+    const ShaderCache::ShaderDesc* descs;
+};
+
+// -------------------------------------------------------------------------------------------------
+//static
+void ShaderCache::PrefetchTask(void* userData, uint32_t index, uint32_t /*thread*/)
+{
+    PrefetchData* data = (PrefetchData*)userData;
+    std::vector<uint8_t> code;
+    data->cache->Get(data->descs[index], &code);
+}
+
+// -------------------------------------------------------------------------------------------------
+void ShaderCache::Prefetch(const ShaderDesc* descs, uint32_t count)
+{
+    // the compiler is mostly busy on the shaders that missed, one per core.
+    TaskPool pool(TaskPool::DefaultWorkerCount());
+    PrefetchData data = { this, descs };
+    pool.Run(count, &ShaderCache::PrefetchTask, &data);
+
+    uint32_t memoryHits, diskHits, compiled;
+    GetStats(&memoryHits, &diskHits, &compiled);
+    Logger::Log(OutputMessageType::Debug, L"ShaderCache: %u shaders from the disk, %u compiled on %u threads\n",
+        diskHits, compiled, pool.GetThreadCount());
+}
+
+// -------------------------------------------------------------------------------------------------
+// the hash of an include, read once.
+bool ShaderCache::HashInclude(const std::string& name, hash64_t* hash)
+{
+    EnterCriticalSection(&m_lock);
+    auto it = m_includeHashes.find(name);
+    bool found = it != m_includeHashes.end();
+    if(found)
+        *hash = it->second;
+    LeaveCriticalSection(&m_lock);
+    if(found)
+        return true;
+
+    std::string source;
+    if(!m_compiler->ReadSource(name.c_str(), &source))
+        return false;
+    *hash = Hash64(source.data(), source.size());
+
+    EnterCriticalSection(&m_lock);
+    m_includeHashes[name] = *hash;
+    LeaveCriticalSection(&m_lock);
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+bool ShaderCache::IncludesMatch(const std::vector<Include>& includes)
+{
+    for(auto it = includes.begin(); it != includes.end(); ++it)
+    {
+        hash64_t hash;
+        if(!HashInclude(it->name, &hash) || hash != it->hash)
+            return false;
+    }
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+std::wstring ShaderCache::GetFile(hash64_t key) const
+{
+    if(m_dir.empty())
+        return std::wstring();
+    WCHAR name[32];
+    swprintf_s(name, L"%016llx.lvshader", (unsigned long long)key);
+    return m_dir + name;
+}
+
+// -------------------------------------------------------------------------------------------------
+bool ShaderCache::LoadEntry(const std::wstring& file, hash64_t key, Entry* entry)
+{
+    MappedFile mapped;
+    if(!mapped.Open(file.c_str()))
+        return false;
+
+    const uint8_t* data = mapped.GetData();
+    size_t size = mapped.GetSize();
+    ShaderFileHeader header;
+    if(size < sizeof(header))
+        return false;
+    memcpy(&header, data, sizeof(header));
+    if(header.magic != ShaderFileMagic || header.version != ShaderFileVersion || header.key != key)
+        return false;
+
+    size_t offset = sizeof(header);
+    for(uint32_t i = 0; i < header.includeCount; ++i)
+    {
+        Include include;
+        uint32_t nameSize;
+        if(size - offset < sizeof(include.hash) + sizeof(nameSize))
+            return false;
+        memcpy(&include.hash, data + offset, sizeof(include.hash));
+        memcpy(&nameSize, data + offset + sizeof(include.hash), sizeof(nameSize));
+        offset += sizeof(include.hash) + sizeof(nameSize);
+        if(size - offset < nameSize)
+            return false;
+        include.name.assign((const char*)data + offset, nameSize);
+        offset += nameSize;
+        entry->includes.push_back(include);
+    }
+    if(size - offset != header.codeSize || header.codeSize == 0)
+        return false;
+    entry->code.assign(data + offset, data + size);
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+static void Append(std::vector<uint8_t>& data, const void* bytes, size_t size)
+{
+    data.insert(data.end(), (const uint8_t*)bytes, (const uint8_t*)bytes + size);
+}
+
+// -------------------------------------------------------------------------------------------------
+void ShaderCache::SaveEntry(const std::wstring& file, hash64_t key, const Entry& entry)
+{
+    ShaderFileHeader header;
+    header.magic = ShaderFileMagic;
+    header.version = ShaderFileVersion;
+    header.key = key;
+    header.includeCount = (uint32_t)entry.includes.size();
+    header.codeSize = (uint32_t)entry.code.size();
+
+    std::vector<uint8_t> data;
+    Append(data, &header, sizeof(header));
+    for(auto it = entry.includes.begin(); it != entry.includes.end(); ++it)
+    {
+        uint32_t nameSize = (uint32_t)it->name.size();
+        Append(data, &it->hash, sizeof(it->hash));
+        Append(data, &nameSize, sizeof(nameSize));
+        Append(data, it->name.data(), nameSize);
+    }
+    Append(data, &entry.code[0], entry.code.size());
+
+    // another thread or process may be writing the same file, either one is good.
+    if(!FileUtils::SaveFile(file.c_str(), &data[0], (UINT)data.size()))
+    {
+        Logger::Log(OutputMessageType::Debug, L"Can't write shader cache file %s\n", file.c_str());
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+void ShaderCache::GetStats(uint32_t* memoryHits, uint32_t* diskHits, uint32_t* compiled)
+{
+    if(memoryHits) *memoryHits = (uint32_t)m_memoryHits;
+    if(diskHits) *diskHits = (uint32_t)m_diskHits;
+    if(compiled) *compiled = (uint32_t)m_compiled;
+}
+
+}; // namespace
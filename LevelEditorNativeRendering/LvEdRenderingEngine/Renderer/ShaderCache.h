@@ -0,0 +1,110 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    ShaderCache.h
+
+    Keeps the compiled code of the shaders, in memory and in the local
+    cache directory, so they are only compiled again when they change.
+    A shader is identified by a hash of its source, name, entry point,
+    target, macros and compiler version. The files it includes are saved
+    with their hashes and checked before the code saved on the disk is used.
+    The cache only reads sources and compiles through a ShaderCompiler.
+    Prefetch() gets many shaders at once on all the cores, the engine uses
+    it for the shaders it creates while initializing.
+****************************************************************************/
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <d3d11.h>
+#include "../Core/WinHeaders.h"
+#include "../Core/NonCopyable.h"
+#include "../Core/Hasher.h"
+
+namespace LvEdEngine
+{
+    // reads and compiles shaders for the ShaderCache.
+    class ShaderCompiler : public NonCopyable
+    {
+    public:
+        virtual ~ShaderCompiler() {}
+
+        // contents of a shader or of a file it includes, false if there is none.
+        virtual bool ReadSource(const char* name, std::string* source) = 0;
+
+        // compiles the source of the shader named name, and adds the names of
+        // the files it included to includes. Logs the errors. Thread safe.
+        virtual bool Compile(const char* name, const std::string& source, const D3D_SHADER_MACRO* macros,
+            const char* entryPoint, const char* target, std::vector<uint8_t>* code, std::vector<std::string>* includes) = 0;
+
+        // changes with the compiler and the options that change its output.
+        virtual hash64_t GetVersion() = 0;
+    };
+
+    class ShaderCache : public NonCopyable
+    {
+    public:
+        // takes ownership of compiler. With an empty dir the shaders are only kept in memory.
+        static void InitInstance(ShaderCompiler* compiler, const std::wstring& dir);
+        static void DestroyInstance();
+        static ShaderCache* Inst() { return s_inst; }
+
+        struct ShaderDesc
+        {
+            const char*             name;
+            const char*             entryPoint;
+            const char*             target;
+            const D3D_SHADER_MACRO* macros;     // terminated by a NULL name, or NULL.
+        };
+
+        // the code of the shader: from memory, from the disk, or compiled
+        // and saved. false if it doesn't compile. Thread safe.
+        bool Get(const ShaderDesc& desc, std::vector<uint8_t>* code);
+
+        // gets the shaders in parallel, so that Get() finds them in memory.
+        void Prefetch(const ShaderDesc* descs, uint32_t count);
+
+        // identifies the shader without its includes.
+        hash64_t ComputeKey(const ShaderDesc& desc, const std::string& source) const;
+
+        // how the shaders were found since the cache was created.
+        void GetStats(uint32_t* memoryHits, uint32_t* diskHits, uint32_t* compiled);
+
+    private:
+        ShaderCache(ShaderCompiler* compiler, const std::wstring& dir);
+        ~ShaderCache();
+        static ShaderCache* s_inst;
+
+        struct Include
+        {
+            std::string name;
+            hash64_t    hash;
+        };
+        struct Entry
+        {
+            bool                    compiled;   // false if it failed to compile.
+            std::vector<uint8_t>    code;
+            std::vector<Include>    includes;
+        };
+
+        bool HashInclude(const std::string& name, hash64_t* hash);
+        bool IncludesMatch(const std::vector<Include>& includes);
+        std::wstring GetFile(hash64_t key) const;
+        bool LoadEntry(const std::wstring& file, hash64_t key, Entry* entry);
+        void SaveEntry(const std::wstring& file, hash64_t key, const Entry& entry);
+        static void PrefetchTask(void* userData, uint32_t index, uint32_t thread);
+
+        ShaderCompiler*     m_compiler;
+        std::wstring        m_dir;
+        hash64_t            m_version;
+
+        CRITICAL_SECTION    m_lock;     // guards the maps.
+        std::map<hash64_t, Entry*> m_entries;           // by key.
+        std::map<std::string, hash64_t> m_includeHashes;
+
+        volatile LONG       m_memoryHits;
+        volatile LONG       m_diskHits;
+        volatile LONG       m_compiled;
+    };
+}
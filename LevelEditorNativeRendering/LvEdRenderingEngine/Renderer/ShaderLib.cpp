@@ -12,7 +12,7 @@
 #include "SkyDomeShader.h"
 #include "TexturedShader.h"
 #include "TerrainShader.h"
-#include "WireFrameShader.h"
+#include "WireframeShader.h"
 #include "NormalsShader.h"
 
 using namespace LvEdEngine;
@@ -0,0 +1,167 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    ShadowCascades.cpp
+
+****************************************************************************/
+#include "ShadowCascades.h"
+#include <math.h>
+
+using namespace LvEdEngine;
+
+//---------------------------------------------------------------------------
+ShadowCascades::ShadowCascades()
+  : m_count(0),
+    m_lambda(0.75f)
+{
+}
+
+//---------------------------------------------------------------------------
+void ShadowCascades::ComputeSplits(float nearZ, float farZ, uint32_t count, float lambda, float* splits)
+{
+    // the logarithmic split is undefined for a zero near plane.
+    nearZ = maximize(nearZ, 0.001f);
+    farZ = maximize(farZ, nearZ);
+    splits[0] = nearZ;
+    for(uint32_t i = 1; i < count; ++i)
+    {
+        float f = (float)i / (float)count;
+        float logSplit = nearZ * powf(farZ / nearZ, f);
+        float uniSplit = nearZ + (farZ - nearZ) * f;
+        splits[i] = lambda * logSplit + (1.0f - lambda) * uniSplit;
+    }
+    splits[count] = farZ;
+}
+
+//---------------------------------------------------------------------------
+// returns the NDC depth of the given view space distance.
+static float ViewDepthToNdc(const Matrix& proj, float depth)
+{
+    float3 p(0, 0, -depth);
+    p.Transform(proj);
+    return p.z;
+}
+
+//---------------------------------------------------------------------------
+void ShadowCascades::Update(const Matrix& camView, const Matrix& camProj, const float3& lightDir,
+                            const AABB& sceneBounds, uint32_t count, uint32_t mapSize)
+{
+    m_count = 0;
+    if(count > MaxShadowCascades) count = MaxShadowCascades;
+    if(count == 0 || mapSize == 0) return;
+
+    const float3& smin = sceneBounds.Min();
+    const float3& smax = sceneBounds.Max();
+    if(smin.x > smax.x || smin.y > smax.y || smin.z > smax.z)
+        return; // empty scene.
+
+    // depth range of the camera, same as Camera::SetViewProj()
+    Matrix invProj;
+    Matrix::Invert(camProj, invProj);
+    float3 p0(0,0,0);
+    float3 p1(0,0,1);
+    p0.Transform(invProj);
+    p1.Transform(invProj);
+    float nearZ = fabsf(p0.z);
+    float farZ  = fabsf(p1.z);
+
+    // only split the part of the frustum that overlaps the scene.
+    AABB sceneV = sceneBounds;
+    sceneV.Transform(camView);
+    nearZ = maximize(nearZ, -sceneV.Max().z);
+    farZ  = minimize(farZ, -sceneV.Min().z);
+    if(farZ <= nearZ)
+        return;
+
+    // light view, looking down the light direction.
+    float3 worldUp(0,1,0);
+    float3 dir = normalize(lightDir);
+    float3 right, up;
+    if(fabsf(dot(dir, worldUp)) + Epsilon >= 1.0f)
+    {
+        right = float3(1, 0, 0);
+        up = normalize(cross(right, dir));
+    }
+    else
+    {
+        right = normalize(cross(dir, worldUp));
+        up = normalize(cross(right, dir));
+    }
+    m_lightView = Matrix(right.x, up.x, -dir.x, 0.0f,
+                         right.y, up.y, -dir.y, 0.0f,
+                         right.z, up.z, -dir.z, 0.0f,
+                         0.0f,    0.0f, 0.0f,   1.0f);
+
+    // everything between the light and a cascade can cast shadows into it.
+    AABB sceneL = sceneBounds;
+    sceneL.Transform(m_lightView);
+    float towardLightZ = sceneL.Max().z;
+
+    float splits[MaxShadowCascades + 1];
+    ComputeSplits(nearZ, farZ, count, m_lambda, splits);
+
+    Matrix invViewProj;
+    Matrix::Invert(camView * camProj, invViewProj);
+
+    AABB casterVolume;
+    for(uint32_t c = 0; c < count; ++c)
+    {
+        ShadowCascade& cascade = m_cascades[c];
+        cascade.splitNear = splits[c];
+        cascade.splitFar  = splits[c + 1];
+
+        // world space corners of the frustum slice.
+        float zn = ViewDepthToNdc(camProj, cascade.splitNear);
+        float zf = ViewDepthToNdc(camProj, cascade.splitFar);
+        float3 corners[8] = {
+            float3(-1,-1,zn), float3(1,-1,zn), float3(1,1,zn), float3(-1,1,zn),
+            float3(-1,-1,zf), float3(1,-1,zf), float3(1,1,zf), float3(-1,1,zf) };
+        float3 center(0,0,0);
+        for(int i = 0; i < 8; ++i)
+        {
+            corners[i].Transform(invViewProj);
+            center = center + corners[i];
+        }
+        center = center / 8.0f;
+
+        // the bounding sphere doesn't change size as the camera rotates.
+        float radius = 0;
+        for(int i = 0; i < 8; ++i)
+            radius = maximize(radius, length(corners[i] - center));
+        radius = ceilf(radius * 16.0f) / 16.0f;
+
+        // snap the center to whole texels so moving the camera
+        // doesn't move the shadow map relative to the world.
+        float3 centerL = float3::Transform(center, m_lightView);
+        float texel = (2.0f * radius) / (float)mapSize;
+        centerL.x = floorf(centerL.x / texel) * texel;
+        centerL.y = floorf(centerL.y / texel) * texel;
+
+        float3 bmin(centerL.x - radius, centerL.y - radius, centerL.z - radius);
+        float3 bmax(centerL.x + radius, centerL.y + radius, maximize(centerL.z + radius, towardLightZ));
+        cascade.casterBounds = AABB(bmin, bmax);
+        cascade.proj = Matrix::CreateOrthographicOffCenter(bmin.x, bmax.x, bmin.y, bmax.y, -bmax.z, -bmin.z);
+        casterVolume.Extend(cascade.casterBounds);
+    }
+
+    const float3& cmin = casterVolume.Min();
+    const float3& cmax = casterVolume.Max();
+    m_casterProj = Matrix::CreateOrthographicOffCenter(cmin.x, cmax.x, cmin.y, cmax.y, -cmax.z, -cmin.z);
+    m_count = count;
+}
+
+//---------------------------------------------------------------------------
+uint32_t ShadowCascades::GetCasterMask(const AABB& bounds) const
+{
+    uint32_t mask = 0;
+    if(m_count == 0) return mask;
+
+    AABB boundsL = bounds;
+    boundsL.Transform(m_lightView);
+    for(uint32_t c = 0; c < m_count; ++c)
+    {
+        if(TestAABBAABB(boundsL, m_cascades[c].casterBounds))
+            mask |= (1 << c);
+    }
+    return mask;
+}
@@ -0,0 +1,65 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    ShadowCascades.h
+
+    CPU side of cascaded shadow maps: split distances, per-cascade light
+    projections and shadow caster tests. Only depends on VectorMath.
+****************************************************************************/
+#pragma once
+#include "../VectorMath/V3dMath.h"
+#include "../VectorMath/CollisionPrimitives.h"
+
+namespace LvEdEngine
+{
+    static const uint32_t MaxShadowCascades = 4;
+
+    struct ShadowCascade
+    {
+        float  splitNear;    // view depth range covered by this cascade.
+        float  splitFar;
+        Matrix proj;         // light space orthographic projection.
+        AABB   casterBounds; // light space volume, extruded toward the light,
+                             // that a shadow caster must intersect.
+    };
+
+    class ShadowCascades
+    {
+    public:
+        ShadowCascades();
+
+        // Practical split scheme: blends logarithmic (lambda=1) and uniform (lambda=0)
+        // splits of [nearZ, farZ]. splits must hold count+1 entries.
+        static void ComputeSplits(float nearZ, float farZ, uint32_t count, float lambda, float* splits);
+
+        // Fits count cascades to the part of the camera frustum that overlaps sceneBounds.
+        // Each cascade is fitted to the bounding sphere of its frustum slice and snapped
+        // to whole shadow map texels, so the shadows don't shimmer when the camera moves.
+        void Update(const Matrix& camView, const Matrix& camProj, const float3& lightDir,
+                    const AABB& sceneBounds, uint32_t count, uint32_t mapSize);
+
+        // number of cascades, 0 if the camera doesn't see anything to shadow.
+        uint32_t GetCount() const { return m_count; }
+        const ShadowCascade& GetCascade(uint32_t index) const { return m_cascades[index]; }
+
+        // light view matrix shared by all the cascades.
+        const Matrix& GetLightView() const { return m_lightView; }
+
+        // light space projection covering the caster volumes of all the cascades.
+        const Matrix& GetCasterProj() const { return m_casterProj; }
+
+        // returns a bit per cascade the world space bounds can cast shadows into.
+        uint32_t GetCasterMask(const AABB& bounds) const;
+
+        // blend factor used by Update() for the practical split scheme.
+        void SetSplitLambda(float lambda) { m_lambda = lambda; }
+        float GetSplitLambda() const { return m_lambda; }
+
+    private:
+        uint32_t m_count;
+        float m_lambda;
+        Matrix m_lightView;
+        Matrix m_casterProj;
+        ShadowCascade m_cascades[MaxShadowCascades];
+    };
+}
@@ -0,0 +1,69 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    ShadowCasterCollector.cpp
+
+****************************************************************************/
+#include "ShadowCasterCollector.h"
+#include "Model.h"
+
+using namespace LvEdEngine;
+
+//---------------------------------------------------------------------------
+bool ShadowCasterCollector::IsCaster(const RenderableNode& r, ShadersEnum shaderId)
+{
+    // same nodes the shadow pass used to draw from the sorted buckets:
+    // solid, textured triangles that cast shadows.
+    if(shaderId != Shaders::TexturedShader || !r.GetFlag(RenderableNode::kShadowCaster))
+        return false;
+    if((GetFlags() & GlobalRenderFlags::Solid) == 0)
+        return false;
+    PrimitiveTypeEnum primtype = r.mesh->primitiveType;
+    return primtype == PrimitiveType::TriangleList || primtype == PrimitiveType::TriangleStrip;
+}
+
+//---------------------------------------------------------------------------
+void ShadowCasterCollector::Add(RenderableNode& r, RenderFlagsEnum /*rf*/, ShadersEnum shaderId)
+{
+    if(IsCaster(r, shaderId))
+    {
+        m_candidates.push_back(r);
+        m_bounds.Extend(r.bounds);
+    }
+}
+
+//---------------------------------------------------------------------------
+void ShadowCasterCollector::Add( const RenderNodeList::iterator& listBegin, const RenderNodeList::iterator& listEnd,
+                                 RenderFlagsEnum rf, ShadersEnum shaderId )
+{
+    for(auto it = listBegin; it != listEnd; ++it)
+    {
+        Add(*it, rf, shaderId);
+    }
+}
+
+//---------------------------------------------------------------------------
+void ShadowCasterCollector::ClearLists()
+{
+    m_candidates.clear();
+    for(uint32_t i = 0; i < MaxShadowCascades; ++i)
+        m_casters[i].clear();
+    ClearBounds();
+}
+
+//---------------------------------------------------------------------------
+void ShadowCasterCollector::CullCasters(const ShadowCascades& cascades)
+{
+    for(uint32_t i = 0; i < MaxShadowCascades; ++i)
+        m_casters[i].clear();
+
+    for(uint32_t n = 0; n < (uint32_t)m_candidates.size(); ++n)
+    {
+        uint32_t mask = cascades.GetCasterMask(m_candidates[n].bounds);
+        for(uint32_t c = 0; mask != 0; ++c, mask >>= 1)
+        {
+            if(mask & 1)
+                m_casters[c].push_back(n);
+        }
+    }
+}
@@ -0,0 +1,39 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    ShadowCasterCollector.h
+
+****************************************************************************/
+#pragma once
+
+#include <vector>
+#include "RenderableNodeCollector.h"
+#include "ShadowCascades.h"
+
+namespace LvEdEngine
+{
+    //-----------------------------------------------------------------------
+    //  Collects the shadow casters of the level, independently of the
+    //  view frustum, and sorts them into per-cascade caster lists.
+    //-----------------------------------------------------------------------
+    class ShadowCasterCollector : public RenderableNodeCollector
+    {
+    public:
+        virtual void Add( RenderableNode& r, RenderFlagsEnum rf, ShadersEnum shaderIdPref);
+        virtual void Add( const RenderNodeList::iterator& listBegin, const RenderNodeList::iterator& listEnd, RenderFlagsEnum rf, ShadersEnum shaderIdPref);
+        virtual void ClearLists();
+
+        // culls the collected casters against each cascade's caster volume.
+        void CullCasters(const ShadowCascades& cascades);
+
+        const RenderNodeList& GetCandidates() const { return m_candidates; }
+        // indices into GetCandidates() of the casters of the given cascade.
+        const std::vector<uint32_t>& GetCasters(uint32_t cascade) const { return m_casters[cascade]; }
+
+    private:
+        bool IsCaster(const RenderableNode& r, ShadersEnum shaderId);
+
+        RenderNodeList        m_candidates;
+        std::vector<uint32_t> m_casters[MaxShadowCascades];
+    };
+}
@@ -7,6 +7,7 @@
 ****************************************************************************/
 #include "ShadowMapGen.h"
 #include "RenderUtil.h"
+#include "EngineShaders.h"
 #include "RenderEnums.h"
 #include "RenderState.h"
 #include "Texture.h"
@@ -14,9 +15,9 @@
 #include "RenderBuffer.h"
 #include "ScreenMsgPrinter.h"
 #include "Lights.h"
-#include "..\GobSystem\GameLevel.h"
+#include "../GobSystem/GameLevel.h"
 #include "FontRenderer.h"
-#include "..\LvEdUtils.h"
+#include "../LvEdUtils.h"
 #include "../Core/Logger.h"
 #include "GpuResourceFactory.h"
 
@@ -43,7 +44,7 @@
 
     //GpuResourceFactory
     // compile and create vertex shader.
-    ID3DBlob* vsBlob =  CompileShaderFromResource(L"ShadowMapGen.hlsl","VSMain","vs_4_0", NULL);
+    ID3DBlob* vsBlob =  EngineShader::Compile(EngineShader::ShadowMapGenVS);
     assert(vsBlob);
     m_vertexShader = GpuResourceFactory::CreateVertexShader(vsBlob);
     assert(m_vertexShader);
@@ -71,7 +72,7 @@
 }
 
 //---------------------------------------------------------------------------
-void ShadowMapGen::Begin(RenderContext* rc, RenderSurface* pSurface, const AABB& bounds )
+void ShadowMapGen::Begin(RenderContext* rc, RenderSurface* pSurface)
 {
     m_rc = rc;
     m_pSurface = pSurface;
@@ -79,19 +80,9 @@
 
     // set depth-stencil state to default.
     dc->OMSetDepthStencilState(NULL,0);
-    
-    ShadowMaps::Inst()->UpdateLightCamera(dc, LightingState::Inst()->ProminentDirLight(), bounds);
-    ShadowMaps::Inst()->SetAndClear(dc);
         
     dc->RSSetState( m_rasterState );
     
-    const Camera& lightCam = ShadowMaps::Inst()->GetCamera();    
-
-    // update per frame cb         
-    Matrix::Transpose(lightCam.View() ,m_cbPerFrame.Data.view);
-    Matrix::Transpose(lightCam.Proj(),m_cbPerFrame.Data.proj);
-    m_cbPerFrame.Update(dc);
-    
     // set imput layout.
     dc->IASetInputLayout( m_layoutP );
 
@@ -110,14 +101,28 @@
 }
 
 //---------------------------------------------------------------------------
-void ShadowMapGen::DrawNodes(const RenderNodeList& renderNodes)
+void ShadowMapGen::DrawCascade(uint32_t cascade, const ShadowCasterCollector& casters)
 {  
-    // Render the scene into the shadow map
-    for(auto it = renderNodes.begin(); it != renderNodes.end(); it++)
+    ID3D11DeviceContext*  dc = m_rc->Context();
+    const ShadowCascades& cascades = ShadowMaps::Inst()->GetCascades();
+    assert(cascade < cascades.GetCount());
+
+    ShadowMaps::Inst()->SetAndClear(dc, cascade);
+
+    // update per frame cb         
+    Matrix::Transpose(cascades.GetLightView(), m_cbPerFrame.Data.view);
+    Matrix::Transpose(cascades.GetCascade(cascade).proj, m_cbPerFrame.Data.proj);
+    m_cbPerFrame.Update(dc);
+
+    // Render the casters into the shadow map
+    const RenderNodeList& nodes = casters.GetCandidates();
+    const std::vector<uint32_t>& indices = casters.GetCasters(cascade);
+    m_commands.Reset();
+    for(auto it = indices.begin(); it != indices.end(); it++)
     {        
-        const RenderableNode& renderable = (*it);
-        DrawRenderable(renderable);        
+        DrawRenderable(nodes[*it]);        
     }        
+    m_rc->Backend()->Execute(m_commands);
 }
 
 //---------------------------------------------------------------------------
@@ -141,22 +146,17 @@
     if (!r.GetFlag( RenderableNode::kShadowCaster ) )
         return;
 
-    ID3D11DeviceContext* dc = m_rc->Context();
-        
     Matrix::Transpose(r.WorldXform, m_cbPerDraw.Data);    
-    m_cbPerDraw.Update(dc);
+    m_commands.UpdateConstants(m_cbPerDraw.GetBuffer(), &m_cbPerDraw.Data, sizeof(m_cbPerDraw.Data));
         
     uint32_t stride = r.mesh->vertexBuffer->GetStride();
-    uint32_t offset = 0;
     uint32_t startIndex = 0;
     uint32_t startVertex = 0;
     uint32_t indexCount = r.mesh->indexBuffer->GetCount();
-    ID3D11Buffer* d3dvb = r.mesh->vertexBuffer->GetBuffer();
-    ID3D11Buffer* d3dib = r.mesh->indexBuffer->GetBuffer();
 
-    dc->IASetPrimitiveTopology( (D3D11_PRIMITIVE_TOPOLOGY)r.mesh->primitiveType );
-    dc->IASetVertexBuffers( 0, 1, &d3dvb, &stride, &offset );
-    dc->IASetIndexBuffer(d3dib, (DXGI_FORMAT) r.mesh->indexBuffer->GetFormat(), 0);
+    m_commands.SetTopology( r.mesh->primitiveType );
+    m_commands.SetVertexBuffer( r.mesh->vertexBuffer->GetBuffer(), stride );
+    m_commands.SetIndexBuffer( r.mesh->indexBuffer->GetBuffer(), r.mesh->indexBuffer->GetFormat() );
 
-    dc->DrawIndexed(indexCount, startIndex, startVertex);
+    m_commands.DrawIndexed(indexCount, startIndex, startVertex);
 }
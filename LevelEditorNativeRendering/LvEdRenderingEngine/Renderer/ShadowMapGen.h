@@ -10,6 +10,8 @@
 #include "ShadowMaps.h"
 #include "RenderSurface.h"
 #include "RenderBuffer.h"
+#include "ShadowCasterCollector.h"
+#include "CommandBuffer.h"
 
 namespace LvEdEngine
 {
@@ -21,11 +23,12 @@ class ShadowMapGen : public NonCopyable
 
         //  Called begin before drawing.
         //  Set up sampler states, shaders, connect constant buffers, etc.
-        void Begin(RenderContext* rc, RenderSurface* pSurface, const AABB& bounds );
+        //  ShadowMaps::UpdateCascades() must have been called for this frame.
+        void Begin(RenderContext* rc, RenderSurface* pSurface);
 
         //  Do the drawing.
-        //  Connect resources, vertex and index buffers, and draw the world.
-        void DrawNodes(const RenderNodeList& renderNodes);
+        //  Clears the shadow map of the given cascade and draws its casters.
+        void DrawCascade(uint32_t cascade, const ShadowCasterCollector& casters);
 
         //  Called after drawing.
         //  Perform any needed post-drawing cleanup.
@@ -49,6 +52,9 @@ struct CbPerFrame
         ID3D11InputLayout*          m_layoutP;
         ID3D11RasterizerState*      m_rasterState;
 
+        // caster draws of the current cascade.
+        CommandBuffer               m_commands;
+
         void DrawRenderable(const RenderableNode& r);
 
     };
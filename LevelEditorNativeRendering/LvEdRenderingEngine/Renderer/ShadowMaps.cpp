@@ -33,17 +33,20 @@
 ShadowMaps::ShadowMaps(ID3D11Device* device, uint32_t dim) 
 {
     HRESULT hr;
-    m_depthStencilView = NULL;
+    for(uint32_t i = 0; i < MaxShadowCascades; ++i)
+        m_depthStencilViews[i] = NULL;
     m_samplerState     = NULL;
     m_resourceView     = NULL;
+    m_enabled          = false;
+    m_cascadeCount     = MaxShadowCascades;
 
-    // create depth buffer.
+    // create depth buffer, one slice per cascade.
     D3D11_TEXTURE2D_DESC tex2dDesc;
     SecureZeroMemory( &tex2dDesc, sizeof(tex2dDesc) );
     tex2dDesc.Width                 = dim;
     tex2dDesc.Height                = dim;
     tex2dDesc.MipLevels             = 1;
-    tex2dDesc.ArraySize             = 1;
+    tex2dDesc.ArraySize             = MaxShadowCascades;
     tex2dDesc.Format                = DXGI_FORMAT_R32_TYPELESS;
     tex2dDesc.SampleDesc.Count      = 1;
     tex2dDesc.SampleDesc.Quality    = 0;
@@ -56,19 +59,25 @@
     Logger::IsFailureLog(hr, L"Create depth buffer");
     assert(depthbuffer);
   
-    D3D11_DEPTH_STENCIL_VIEW_DESC  depthStencilViewDsc;
-    SecureZeroMemory( &depthStencilViewDsc, sizeof(depthStencilViewDsc) );
-    depthStencilViewDsc.Format = DXGI_FORMAT_D32_FLOAT;    
-    depthStencilViewDsc.ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2D;    
-    hr = device->CreateDepthStencilView( depthbuffer, &depthStencilViewDsc, &m_depthStencilView );
-    Logger::IsFailureLog(hr, L"CreateDepthStencilView");
-    assert(m_depthStencilView);
+    for(uint32_t i = 0; i < MaxShadowCascades; ++i)
+    {
+        D3D11_DEPTH_STENCIL_VIEW_DESC  depthStencilViewDsc;
+        SecureZeroMemory( &depthStencilViewDsc, sizeof(depthStencilViewDsc) );
+        depthStencilViewDsc.Format = DXGI_FORMAT_D32_FLOAT;    
+        depthStencilViewDsc.ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2DARRAY;
+        depthStencilViewDsc.Texture2DArray.FirstArraySlice = i;
+        depthStencilViewDsc.Texture2DArray.ArraySize = 1;
+        hr = device->CreateDepthStencilView( depthbuffer, &depthStencilViewDsc, &m_depthStencilViews[i] );
+        Logger::IsFailureLog(hr, L"CreateDepthStencilView");
+        assert(m_depthStencilViews[i]);
+    }
     
     D3D11_SHADER_RESOURCE_VIEW_DESC shaderResourceViewDsc;
     SecureZeroMemory( &shaderResourceViewDsc, sizeof(shaderResourceViewDsc) );
     shaderResourceViewDsc.Format = DXGI_FORMAT_R32_FLOAT;
-    shaderResourceViewDsc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-    shaderResourceViewDsc.Texture2D.MipLevels = 1;
+    shaderResourceViewDsc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2DARRAY;
+    shaderResourceViewDsc.Texture2DArray.MipLevels = 1;
+    shaderResourceViewDsc.Texture2DArray.ArraySize = MaxShadowCascades;
     
     hr = device->CreateShaderResourceView( depthbuffer, &shaderResourceViewDsc, &m_resourceView  );
     Logger::IsFailureLog(hr, L"CreateShaderResourceView");
@@ -109,82 +118,46 @@
 {
     SAFE_RELEASE(m_samplerState);
     SAFE_RELEASE(m_resourceView);
-    SAFE_RELEASE(m_depthStencilView);    
+    for(uint32_t i = 0; i < MaxShadowCascades; ++i)
+        SAFE_RELEASE(m_depthStencilViews[i]);
 }
 
 //---------------------------------------------------------------------------
-void ShadowMaps::UpdateLightCamera( ID3D11DeviceContext* dc, const DirLight* light, const AABB& renderedArea )
+void ShadowMaps::SetCascadeCount(uint32_t count)
 {
-    float3 worldUp(0,1,0);
-    float3 lightDir = normalize(light->dir);
-
-    // compute ligtcam params.
-    float dt = dot(-lightDir, worldUp);
-    float3 center = renderedArea.GetCenter();
-    float dim = length(renderedArea.Max() - renderedArea.Min());
-    float radi = dim * 0.5f;
-
-    float3 camPos = center - (radi * lightDir);
-    float3 up;
-    float3 right;
-
-    if ((dt + Epsilon) >= 1)
-    {
-        up = float3(0, 0, -1);
-        right = float3(1, 0, 0);
-
-    }
-    else
-    {
-        right = normalize(cross(lightDir, worldUp));
-        up = normalize(cross(right, lightDir));
-        right = cross(lightDir, worldUp);
-        up = cross(right, lightDir);
-    }
-
+    if(count < 1) count = 1;
+    if(count > MaxShadowCascades) count = MaxShadowCascades;
+    m_cascadeCount = count;
+}
 
-    // create view matrix from right, up and look, and position.
-     float rp = -dot(right, camPos);
-     float upp = -dot(up, camPos);
-     float zp = dot(lightDir, camPos);
-     Matrix view(
-                right.x, up.x, -lightDir.x, 0.0f,
-                right.y, up.y, -lightDir.y, 0.0f,
-                right.z, up.z, -lightDir.z, 0.0f,
-                rp, upp, zp, 1.0f);
-
-    // compute the width, height, near, far by transforming the AABB into view space.
-    AABB lbounds = renderedArea;
-    lbounds.Transform(view);
-    float3 vmin = lbounds.Min();
-    float3 vmax = lbounds.Max();
-    float width = vmax.x - vmin.x;
-    float height = vmax.y - vmin.y;
-    float nearz = 0.0f;
-    float farz = dim;
-
-    Matrix proj = Matrix::CreateOrthographic(width,height, nearz, farz);
-    //Matrix proj = Matrix::CreateOrthographicOffCenter(vmin.x, vmax.x, vmin.y, vmax.y, nearz, farz);
-    m_lightCamera.SetViewProj(view, proj);
+//---------------------------------------------------------------------------
+void ShadowMaps::UpdateCascades( ID3D11DeviceContext* dc, const DirLight* light, const Camera& cam, const AABB& sceneBounds )
+{
+    m_cascades.Update(cam.View(), cam.Proj(), light->dir, sceneBounds, m_cascadeCount, (uint32_t)MapSize());
 
     // update cb        
     m_cbShadow.Data.texelSize  = ( 1.0f / MapSize() );        
+    m_cbShadow.Data.cascadeCount = m_cascades.GetCount();
 
-    // udpate constant buffer using lightcamera.
     // transform coords from NDC space to texture space.
     float4x4 ndcToTexSpace(  0.5f,  0.0f, 0.0f, 0.0f,
                              0.0f, -0.5f, 0.0f, 0.0f,
                              0.0f,  0.0f, 1.0f, 0.0f,
                              0.5f,  0.5f, 0.0f, 1.0f);
-                                 
-    float4x4 shadowViewProjection = (m_lightCamera.View() * m_lightCamera.Proj()) * ndcToTexSpace;
-    Matrix::Transpose(shadowViewProjection, m_cbShadow.Data.xform);    
+
+    for(uint32_t i = 0; i < m_cascades.GetCount(); ++i)
+    {
+        float4x4 shadowViewProjection = (m_cascades.GetLightView() * m_cascades.GetCascade(i).proj) * ndcToTexSpace;
+        Matrix::Transpose(shadowViewProjection, m_cbShadow.Data.xform[i]);
+    }
     m_cbShadow.Update(dc);
 }
 
-void ShadowMaps::SetAndClear(ID3D11DeviceContext* dc)
+void ShadowMaps::SetAndClear(ID3D11DeviceContext* dc, uint32_t cascade)
 {
+    assert(cascade < MaxShadowCascades);
+    ID3D11DepthStencilView* dsv = m_depthStencilViews[cascade];
     dc->RSSetViewports(1,&m_viewport);    
-    dc->OMSetRenderTargets(0, NULL, m_depthStencilView);
-    dc->ClearDepthStencilView(m_depthStencilView, D3D11_CLEAR_DEPTH, 1.0f, 0);
+    dc->OMSetRenderTargets(0, NULL, dsv);
+    dc->ClearDepthStencilView(dsv, D3D11_CLEAR_DEPTH, 1.0f, 0);
 }
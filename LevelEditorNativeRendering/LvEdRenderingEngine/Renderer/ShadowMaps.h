@@ -9,6 +9,7 @@
 #include "Lights.h"
 #include "Shader.h"
 #include "RenderBuffer.h"
+#include "ShadowCascades.h"
 
 namespace LvEdEngine
 {
@@ -18,6 +19,7 @@ class DirLight;
     //  ShadowMaps
     //
     //  Global singleton for sharing shadow map data.
+    //  Holds one shadow map slice per cascade.
     //-----------------------------------------------------------------------
     class ShadowMaps : public NonCopyable
     {
@@ -30,37 +32,42 @@ class ShadowMaps : public NonCopyable
         
         ID3D11SamplerState*  GetSamplerState(){ return m_samplerState; }        
         ID3D11ShaderResourceView*   GetShaderResourceView() { return m_resourceView; }
-        const Camera& GetCamera() {return m_lightCamera;}
+        const ShadowCascades& GetCascades() {return m_cascades;}
         const D3D11_VIEWPORT& GetViewPort() {return m_viewport;}
         float MapSize() {return m_viewport.Width;}
-        // sets and clears depth stencil buffer and set render target to null.
-        void SetAndClear(ID3D11DeviceContext* dc);
-        void UpdateLightCamera(ID3D11DeviceContext* dc, const DirLight* light, const AABB& renderedArea );
+        // sets and clears the depth stencil buffer of the given cascade and set render target to null.
+        void SetAndClear(ID3D11DeviceContext* dc, uint32_t cascade);
+        // fits the cascades to the camera and updates the shadow constant buffer.
+        void UpdateCascades(ID3D11DeviceContext* dc, const DirLight* light, const Camera& cam, const AABB& sceneBounds );
         ID3D11Buffer* GetShadowConstantBuffer() { return m_cbShadow.GetBuffer(); }        
         bool IsEnabled() {return m_enabled;}
         void SetEnabled(bool enabled) { m_enabled = enabled;}
+        uint32_t GetCascadeCount() { return m_cascadeCount; }
+        void SetCascadeCount(uint32_t count);
         
     private:
 
         __declspec(align(16))
         struct CbShadow
         {
-            Matrix xform;    
-            float  texelSize; // Shadow map texel size.
-            float pad[3];
+            Matrix   xform[MaxShadowCascades]; // world to shadow map space, per cascade.
+            float    texelSize; // Shadow map texel size.
+            uint32_t cascadeCount;
+            float pad[2];
         };
 
         static ShadowMaps*   s_inst;
         ShadowMaps(ID3D11Device* device, uint32_t dim);
         ~ShadowMaps();
 
-        ID3D11DepthStencilView*     m_depthStencilView;        
+        ID3D11DepthStencilView*     m_depthStencilViews[MaxShadowCascades];
         ID3D11SamplerState*         m_samplerState;
         ID3D11ShaderResourceView*   m_resourceView;
         TConstantBuffer<CbShadow>   m_cbShadow;
         D3D11_VIEWPORT m_viewport;
         bool m_enabled;
-        Camera                      m_lightCamera;        
+        uint32_t                    m_cascadeCount;
+        ShadowCascades              m_cascades;
     };
 
 }   // namespace LvEdEngine
@@ -11,6 +11,7 @@
 #include "RenderContext.h"
 #include "RenderState.h"
 #include "RenderUtil.h"
+#include "EngineShaders.h"
 #include "Lights.h"
 #include "Model.h"
 #include "GpuResourceFactory.h"
@@ -28,8 +29,8 @@
     m_cbPerFrame.Construct(device);
 
     // create shaders        
-    ID3DBlob* pVSBlob = CompileShaderFromResource(L"SkySphere.hlsl", "VS_Render","vs_4_0", NULL);    
-    ID3DBlob* pPSBlob = CompileShaderFromResource(L"SkySphere.hlsl", "PS_Render","ps_4_0", NULL);
+    ID3DBlob* pVSBlob = EngineShader::Compile(EngineShader::SkyDomeVS);    
+    ID3DBlob* pPSBlob = EngineShader::Compile(EngineShader::SkyDomePS);
     assert(pVSBlob);
     assert(pPSBlob);
 
@@ -110,7 +111,7 @@
 }
 
 //---------------------------------------------------------------------------
-void SkyDomeShader::DrawNodes(const RenderNodeList& nodes)
+void SkyDomeShader::DrawNodes(const FrameNodeList& nodes)
 {
     for(auto it = nodes.begin(); it != nodes.end(); it++)
     {
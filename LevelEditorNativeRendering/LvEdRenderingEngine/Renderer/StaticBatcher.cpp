@@ -0,0 +1,371 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    StaticBatcher.cpp
+
+****************************************************************************/
+#include "StaticBatcher.h"
+#include <algorithm>
+#include <math.h>
+#include "Model.h"
+#include "RenderableNodeSorter.h"
+#include "../Core/Utils.h"
+#include "../Core/Logger.h"
+
+using namespace LvEdEngine;
+
+// only small meshes are worth batching, large ones are already efficient to draw.
+static const uint32_t MaxMemberVertices = 8192;
+static const uint32_t MaxBatchVertices  = 1 << 20;
+
+//---------------------------------------------------------------------------
+// determinant of the upper 3x3 part.
+static float Determinant3x3(const Matrix& m)
+{
+    return m.M11 * (m.M22 * m.M33 - m.M23 * m.M32)
+         - m.M12 * (m.M21 * m.M33 - m.M23 * m.M31)
+         + m.M13 * (m.M21 * m.M32 - m.M22 * m.M31);
+}
+
+//---------------------------------------------------------------------------
+// compares the lights in use, the rest of the arrays is left over.
+static bool SameLights(const LightEnvironment& a, const LightEnvironment& b)
+{
+    return a.numDirLights == b.numDirLights && a.numBoxLights == b.numBoxLights && a.numPointLights == b.numPointLights
+        && memcmp(a.dir, b.dir, a.numDirLights * sizeof(DirLight)) == 0
+        && memcmp(a.box, b.box, a.numBoxLights * sizeof(BoxLight)) == 0
+        && memcmp(a.point, b.point, a.numPointLights * sizeof(PointLight)) == 0;
+}
+
+//---------------------------------------------------------------------------
+StaticBatcher::BatchKey::BatchKey()
+{
+    // compared with memcmp, padding included.
+    memset(this, 0, sizeof(BatchKey));
+}
+
+//---------------------------------------------------------------------------
+bool StaticBatcher::BatchKey::operator<(const BatchKey& other) const
+{
+    return memcmp(this, &other, sizeof(BatchKey)) < 0;
+}
+
+//---------------------------------------------------------------------------
+StaticBatcher::StaticBatcher()
+  : m_frame(0)
+{
+}
+
+//---------------------------------------------------------------------------
+StaticBatcher::~StaticBatcher()
+{
+    Clear();
+}
+
+//---------------------------------------------------------------------------
+bool StaticBatcher::IsCandidate(const RenderableNode& r, ShadersEnum shaderId) const
+{
+    if(shaderId != Shaders::TexturedShader || r.mesh == NULL || r.mesh->vertexBuffer == NULL)
+        return false;
+    const Mesh* mesh = r.mesh;
+    if(mesh->primitiveType != PrimitiveType::TriangleList || mesh->indices.empty())
+        return false;
+    if(mesh->pos.size() > MaxMemberVertices || mesh->nor.size() != mesh->pos.size())
+        return false;
+    // the batch draws use an identity texture transform.
+    Matrix identity;
+    return memcmp(&r.TextureXForm, &identity, sizeof(Matrix)) == 0 && r.indexCount == 0;
+}
+
+//---------------------------------------------------------------------------
+void StaticBatcher::Add(RenderableNode& r, RenderFlagsEnum rf, ShadersEnum shaderId)
+{
+    if(IsCandidate(r, shaderId) && (rf & RenderFlags::AlphaBlend) == 0)
+    {
+        Candidate candidate;
+        candidate.node = r;
+        candidate.renderFlags = rf;
+        m_candidates.push_back(candidate);
+        m_bounds.Extend(r.bounds);
+    }
+}
+
+//---------------------------------------------------------------------------
+void StaticBatcher::Add( const RenderNodeList::iterator& listBegin, const RenderNodeList::iterator& listEnd,
+                         RenderFlagsEnum rf, ShadersEnum shaderId )
+{
+    for(auto it = listBegin; it != listEnd; ++it)
+    {
+        Add(*it, rf, shaderId);
+    }
+}
+
+//---------------------------------------------------------------------------
+void StaticBatcher::ClearLists()
+{
+    m_candidates.clear();
+    ClearBounds();
+}
+
+//---------------------------------------------------------------------------
+void StaticBatcher::Clear()
+{
+    for(auto it = m_batches.begin(); it != m_batches.end(); ++it)
+    {
+        SAFE_DELETE(it->mesh);
+    }
+    m_batches.clear();
+    m_members.clear();
+    m_memberMap.clear();
+    m_touched.clear();
+}
+
+//---------------------------------------------------------------------------
+StaticBatcher::BatchKey StaticBatcher::MakeKey(const RenderableNode& r, RenderFlagsEnum rf, float cellSize) const
+{
+    BatchKey key;
+    float3 center = r.bounds.GetCenter();
+    key.cell[0] = (int32_t)floorf(center.x / cellSize);
+    key.cell[1] = (int32_t)floorf(center.y / cellSize);
+    key.cell[2] = (int32_t)floorf(center.z / cellSize);
+    key.vertexFormat = r.mesh->tan.empty() ? (r.mesh->tex.empty() ? VertexFormat::VF_PN : VertexFormat::VF_PNT) : VertexFormat::VF_PNTT;
+    key.renderFlags = rf;
+    key.nodeFlags = r.flags;
+    key.diffuse[0] = r.diffuse.x;   key.diffuse[1] = r.diffuse.y;   key.diffuse[2] = r.diffuse.z;   key.diffuse[3] = r.diffuse.w;
+    key.emissive[0] = r.emissive.x; key.emissive[1] = r.emissive.y; key.emissive[2] = r.emissive.z; key.emissive[3] = r.emissive.w;
+    key.specular[0] = r.specular.x; key.specular[1] = r.specular.y; key.specular[2] = r.specular.z; key.specular[3] = r.specPower;
+    for(int t = TextureType::MIN; t < TextureType::MAX; t++)
+        key.textures[t] = r.textures[t];
+    return key;
+}
+
+//---------------------------------------------------------------------------
+uint32_t StaticBatcher::Build(ID3D11Device* device, float cellSize)
+{
+    Clear();
+    cellSize = maximize(cellSize, 1e-3f);
+
+    typedef std::map<BatchKey, std::vector<uint32_t> > GroupMap;
+    GroupMap groups;
+    for(uint32_t i = 0; i < (uint32_t)m_candidates.size(); ++i)
+    {
+        const Candidate& c = m_candidates[i];
+        groups[MakeKey(c.node, c.renderFlags, cellSize)].push_back(i);
+    }
+
+    for(auto it = groups.begin(); it != groups.end(); ++it)
+    {
+        // a single node gains nothing from batching.
+        const std::vector<uint32_t>& group = it->second;
+        if(group.size() < 2)
+            continue;
+
+        uint32_t begin = 0;
+        uint32_t vertexCount = 0;
+        for(uint32_t i = 0; i < (uint32_t)group.size(); ++i)
+        {
+            uint32_t count = (uint32_t)m_candidates[group[i]].node.mesh->pos.size();
+            if(vertexCount + count > MaxBatchVertices)
+            {
+                MakeBatch(device, group, begin, i);
+                begin = i;
+                vertexCount = 0;
+            }
+            vertexCount += count;
+        }
+        MakeBatch(device, group, begin, (uint32_t)group.size());
+    }
+
+    Logger::Log(OutputMessageType::Info, L"Static batching merged %d nodes into %d batches\n",
+        (int)m_members.size(), (int)m_batches.size());
+    return (uint32_t)m_batches.size();
+}
+
+//---------------------------------------------------------------------------
+void StaticBatcher::MakeBatch(ID3D11Device* device, const std::vector<uint32_t>& candidates, uint32_t begin, uint32_t end)
+{
+    if(end - begin < 2)
+        return;
+
+    Batch batch;
+    batch.mesh = new Mesh();
+    batch.mesh->name = "static batch";
+    batch.firstMember = (uint32_t)m_members.size();
+    batch.memberCount = end - begin;
+    batch.bucket = 0;
+    batch.node = m_candidates[candidates[begin]].node;
+    batch.node.mesh = batch.mesh;
+    batch.node.WorldXform.MakeIdentity();
+    batch.node.bounds = AABB();
+
+    Mesh* dest = batch.mesh;
+    for(uint32_t i = begin; i < end; ++i)
+    {
+        const RenderableNode& r = m_candidates[candidates[i]].node;
+        const Mesh* src = r.mesh;
+
+        // normals go through the inverse transpose of the world transform.
+        Matrix w = r.WorldXform;
+        w.M41 = w.M42 = w.M43 = 0; w.M44 = 1;
+        Matrix invWorld, normalXform;
+        Matrix::Invert(w, invWorld);
+        Matrix::Transpose(invWorld, normalXform);
+        // mirroring transforms flip the winding.
+        bool flip = Determinant3x3(r.WorldXform) < 0.0f;
+
+        uint32_t baseVertex = (uint32_t)dest->pos.size();
+        for(size_t v = 0; v < src->pos.size(); ++v)
+        {
+            dest->pos.push_back(float3::Transform(src->pos[v], r.WorldXform));
+            dest->nor.push_back(normalize(float3::TransformNormal(src->nor[v], normalXform)));
+        }
+        if(!src->tex.empty())
+            dest->tex.insert(dest->tex.end(), src->tex.begin(), src->tex.end());
+        for(size_t v = 0; v < src->tan.size(); ++v)
+        {
+            dest->tan.push_back(normalize(float3::TransformNormal(src->tan[v], r.WorldXform)));
+        }
+
+        Member member;
+        member.objectId = r.objectId;
+        member.objectIndex = r.objectIndex;
+        member.mesh = src;
+        member.world = r.WorldXform;
+        member.bounds = r.bounds;
+        member.indexStart = (uint32_t)dest->indices.size();
+        member.indexCount = (uint32_t)src->indices.size();
+        member.batch = (uint32_t)m_batches.size();
+        member.frame = m_frame;
+        member.light = 0;
+        for(size_t n = 0; n + 2 < src->indices.size(); n += 3)
+        {
+            dest->indices.push_back(baseVertex + src->indices[n]);
+            dest->indices.push_back(baseVertex + src->indices[flip ? n + 2 : n + 1]);
+            dest->indices.push_back(baseVertex + src->indices[flip ? n + 1 : n + 2]);
+        }
+        batch.node.bounds.Extend(r.bounds);
+
+        m_memberMap.insert(std::make_pair(std::make_pair(member.objectId, member.mesh), (uint32_t)m_members.size()));
+        m_members.push_back(member);
+    }
+
+    dest->ComputeBound();
+    dest->Construct(device);
+    m_batches.push_back(batch);
+}
+
+//---------------------------------------------------------------------------
+bool StaticBatcher::Matches(const RenderableNode& r, const Member& member, const Batch& batch) const
+{
+    // the node must be unchanged since the batch was built. The mesh, the
+    // material and the textures are compared too, in case the object has been
+    // edited or the model reloaded.
+    if(member.frame == m_frame || memcmp(&r.WorldXform, &member.world, sizeof(Matrix)) != 0)
+        return false;
+    if(r.indexCount != 0 || r.mesh->indices.size() != member.indexCount)
+        return false;
+    const RenderableNode& b = batch.node;
+    if(memcmp(&r.diffuse, &b.diffuse, sizeof(float4)) != 0 || memcmp(&r.emissive, &b.emissive, sizeof(float4)) != 0
+        || memcmp(&r.specular, &b.specular, sizeof(float3)) != 0 || r.specPower != b.specPower)
+        return false;
+    for(int t = TextureType::MIN; t < TextureType::MAX; t++)
+    {
+        if(r.textures[t] != batch.node.textures[t])
+            return false;
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------
+void StaticBatcher::Apply(RenderableNodeSorter* sorter)
+{
+    if(m_batches.empty())
+        return;
+
+    m_frame++;
+    m_touched.clear();
+    m_lighting.clear();
+    for(uint32_t b = 0; b < sorter->GetBucketCount(); ++b)
+    {
+        RenderableNodeSorter::Bucket& bucket = *sorter->GetBucket(b);
+        if(bucket.shaderId != Shaders::TexturedShader || (bucket.renderFlags & RenderFlags::AlphaBlend))
+            continue;
+
+        FrameNodeList& renderables = bucket.renderables;
+        size_t count = 0;
+        for(size_t k = 0; k < renderables.size(); ++k)
+        {
+            const RenderableNode& r = renderables[k];
+            bool batched = false;
+            // the selected objects are drawn on their own to highlight them.
+            if(r.GetFlag(RenderableNode::kSelected))
+            {
+                renderables[count++] = renderables[k];
+                continue;
+            }
+            auto range = m_memberMap.equal_range(std::make_pair(r.objectId, (const Mesh*)r.mesh));
+            for(auto it = range.first; it != range.second && !batched; ++it)
+            {
+                Member& member = m_members[it->second];
+                uint32_t batchIndex = member.batch;
+                Batch& batch = m_batches[batchIndex];
+                if(Matches(r, member, batch))
+                {
+                    member.frame = m_frame;
+                    member.light = (uint32_t)m_lighting.size();
+                    m_lighting.push_back(r.lighting);
+                    if(m_touched.empty() || m_touched.back() != batchIndex)
+                        m_touched.push_back(batchIndex);
+                    batch.bucket = b;
+                    batched = true;
+                }
+            }
+
+            if(!batched)
+            {
+                if(count != k)
+                    renderables[count] = renderables[k];
+                count++;
+            }
+        }
+        renderables.resize(count);
+    }
+
+    std::sort(m_touched.begin(), m_touched.end());
+    m_touched.erase(std::unique(m_touched.begin(), m_touched.end()), m_touched.end());
+    for(auto it = m_touched.begin(); it != m_touched.end(); ++it)
+    {
+        Batch& batch = m_batches[*it];
+
+        // one draw per run of members collected this frame with the same lights.
+        // The members were lit on their own, the union of their bounds could
+        // pick up lights that don't reach any of them.
+        FrameNodeList& renderables = sorter->GetBucket(batch.bucket)->renderables;
+        uint32_t end = batch.firstMember + batch.memberCount;
+        for(uint32_t m = batch.firstMember; m < end; )
+        {
+            if(m_members[m].frame != m_frame)
+            {
+                ++m;
+                continue;
+            }
+            const LightEnvironment& lighting = m_lighting[m_members[m].light];
+            RenderableNode node = batch.node;
+            node.objectId = m_members[m].objectId;
+            node.objectIndex = m_members[m].objectIndex;
+            node.indexStart = m_members[m].indexStart;
+            node.indexCount = 0;
+            node.bounds = AABB();
+            node.lighting = lighting;
+            for(; m < end && m_members[m].frame == m_frame; ++m)
+            {
+                const LightEnvironment& memberLighting = m_lighting[m_members[m].light];
+                if(&memberLighting != &lighting && !SameLights(memberLighting, lighting))
+                    break;
+                node.indexCount += m_members[m].indexCount;
+                node.bounds.Extend(m_members[m].bounds);
+            }
+            renderables.push_back(node);
+        }
+    }
+}
@@ -0,0 +1,116 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    StaticBatcher.h
+
+    Merges the small meshes of the level that share a material and a vertex
+    format within a spatial cell into combined, pre-transformed meshes.
+****************************************************************************/
+#pragma once
+
+#include <vector>
+#include <map>
+#include "RenderableNodeCollector.h"
+
+struct ID3D11Device;
+
+namespace LvEdEngine
+{
+    class RenderableNodeSorter;
+
+    //-----------------------------------------------------------------------
+    //  Collects the batch candidates of the level, builds the batches and
+    //  swaps the nodes of the batched objects for batch draws each frame.
+    //  Every batch keeps the index range of each of its source nodes, so
+    //  only the objects that were collected in a frame are drawn and the
+    //  sorter keeps the source nodes for selection and picking.
+    //-----------------------------------------------------------------------
+    class StaticBatcher : public RenderableNodeCollector
+    {
+    public:
+        StaticBatcher();
+        virtual ~StaticBatcher();
+
+        // collects the nodes that can be batched, see Build().
+        virtual void Add( RenderableNode& r, RenderFlagsEnum rf, ShadersEnum shaderIdPref);
+        virtual void Add( const RenderNodeList::iterator& listBegin, const RenderNodeList::iterator& listEnd, RenderFlagsEnum rf, ShadersEnum shaderIdPref);
+        // clears the collected nodes, the batches are kept.
+        virtual void ClearLists();
+
+        // replaces the batches with the collected nodes merged per cell of the given size.
+        // returns the number of batches.
+        uint32_t Build(ID3D11Device* device, float cellSize);
+
+        // destroys the batches.
+        void Clear();
+
+        // Removes the nodes of the sorter that belong to a batch, and are still
+        // where they were when the batch was built, and adds one node per run
+        // of consecutive batch members instead. A run only spans members that
+        // were collected with the same lights, and is drawn with them.
+        void Apply(RenderableNodeSorter* sorter);
+
+        uint32_t GetBatchCount() const { return (uint32_t)m_batches.size(); }
+
+    private:
+        // nodes can only be merged if all the fields of their key match.
+        struct BatchKey
+        {
+            BatchKey();
+            bool operator<(const BatchKey& other) const;
+
+            int32_t  cell[3];
+            uint32_t vertexFormat;
+            uint32_t renderFlags;
+            uint32_t nodeFlags;
+            float    diffuse[4];
+            float    emissive[4];
+            float    specular[4];
+            Texture* textures[TextureType::MAX];
+        };
+
+        // a source node and its range in the batch indices.
+        struct Member
+        {
+            ObjectGUID  objectId;
+            uint32_t    objectIndex;
+            const Mesh* mesh;
+            Matrix      world;
+            AABB        bounds;
+            uint32_t    indexStart;
+            uint32_t    indexCount;
+            uint32_t    batch;  // index into m_batches.
+            uint32_t    frame;  // last frame the node was collected.
+            uint32_t    light;  // index into m_lighting of the node's lights that frame.
+        };
+
+        struct Batch
+        {
+            Mesh*          mesh;
+            RenderableNode node;  // material of the batch draws.
+            uint32_t       firstMember;
+            uint32_t       memberCount;
+            uint32_t       bucket; // sorter bucket of the members this frame.
+        };
+
+        struct Candidate
+        {
+            RenderableNode  node;
+            RenderFlagsEnum renderFlags;
+        };
+
+        BatchKey MakeKey(const RenderableNode& r, RenderFlagsEnum rf, float cellSize) const;
+        bool IsCandidate(const RenderableNode& r, ShadersEnum shaderId) const;
+        bool Matches(const RenderableNode& r, const Member& member, const Batch& batch) const;
+        void MakeBatch(ID3D11Device* device, const std::vector<uint32_t>& candidates, uint32_t begin, uint32_t end);
+
+        typedef std::multimap<std::pair<ObjectGUID, const Mesh*>, uint32_t> MemberMap;
+        std::vector<Candidate> m_candidates;
+        std::vector<Batch>     m_batches;
+        std::vector<Member>    m_members;
+        MemberMap              m_memberMap;     // source node to index into m_members.
+        std::vector<uint32_t>  m_touched;       // batches with members collected this frame.
+        std::vector<LightEnvironment> m_lighting; // lights of the members collected this frame.
+        uint32_t               m_frame;
+    };
+}
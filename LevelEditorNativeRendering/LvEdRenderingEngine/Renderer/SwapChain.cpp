@@ -33,7 +33,8 @@ namespace LvEdEngine
     }
 	// create swap chain, render target view, depth buffer.
 	RECT rc;
-    GetClientRect( hwnd, &rc );
+    if(!GetClientRect( hwnd, &rc ))
+        SecureZeroMemory( &rc, sizeof( rc ) ); // e.g. a window handle from a replayed trace.
     UINT width = rc.right - rc.left;
     UINT height = rc.bottom - rc.top;
 	if(width == 0) width = 16;
@@ -55,16 +56,20 @@ namespace LvEdEngine
     sd.Windowed = TRUE;
 
 	// create swap chain.
+	// there is no dxgi factory on a headless device, render offscreen.
 	HRESULT hr = S_OK;		
-	hr = m_pDXGIFactory1->CreateSwapChain(m_pd3dDevice,&sd,&m_pSwapChain);
-	if (Logger::IsFailureLog(hr, L"CreateSwapChain"))
+	if(m_pDXGIFactory1)
 	{
-		return;
+		hr = m_pDXGIFactory1->CreateSwapChain(m_pd3dDevice,&sd,&m_pSwapChain);
+		if (Logger::IsFailureLog(hr, L"CreateSwapChain"))
+		{
+			return;
+		}
 	}
 
 	// Create a render target view
     ID3D11Texture2D* pBackBuffer = NULL;
-    hr = m_pSwapChain->GetBuffer( 0, __uuidof( ID3D11Texture2D ), ( LPVOID* )&pBackBuffer );
+    hr = GetBackBuffer(width, height, &pBackBuffer);
     if (Logger::IsFailureLog(hr, L"GetBuffer"))
 	{
 		return;
@@ -177,16 +182,19 @@ namespace LvEdEngine
 	m_pDepthStencilView = NULL;
     SAFE_DELETE(m_pColorBuffer);
     
-	hr = m_pSwapChain->ResizeBuffers(0, w, h, DXGI_FORMAT_UNKNOWN, 0);
-	if (Logger::IsFailureLog(hr, L"ResizeBuffers"))
+	if(m_pSwapChain)
 	{
-		return;
+		hr = m_pSwapChain->ResizeBuffers(0, w, h, DXGI_FORMAT_UNKNOWN, 0);
+		if (Logger::IsFailureLog(hr, L"ResizeBuffers"))
+		{
+			return;
+		}
 	}
     
 
 	// Get buffer and create a render-target-view.
 	ID3D11Texture2D* pBuffer;
-	hr = m_pSwapChain->GetBuffer(0, __uuidof( ID3D11Texture2D), (void**) &pBuffer );
+	hr = GetBackBuffer(w, h, &pBuffer);
 	if (Logger::IsFailureLog(hr, L"GetBuffer"))
 	{
 		return;
@@ -259,4 +267,23 @@ namespace LvEdEngine
 	return m_pSwapChain;
 }
 
+HRESULT SwapChain::GetBackBuffer(UINT width, UINT height, ID3D11Texture2D** ppBuffer)
+{
+	if(m_pSwapChain)
+		return m_pSwapChain->GetBuffer(0, __uuidof( ID3D11Texture2D), (void**) ppBuffer );
+
+	D3D11_TEXTURE2D_DESC desc;
+	SecureZeroMemory( &desc, sizeof(desc) );
+	desc.Width = width;
+	desc.Height = height;
+	desc.MipLevels = 1;
+	desc.ArraySize = 1;
+	desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+	desc.SampleDesc.Count = GetMultiSampleCount();
+	desc.SampleDesc.Quality = GetMultiSampleQuality();
+	desc.Usage = D3D11_USAGE_DEFAULT;
+	desc.BindFlags = D3D11_BIND_RENDER_TARGET;
+	return m_pd3dDevice->CreateTexture2D( &desc, NULL, ppBuffer );
+}
+
 }// namespace LvEdEngine
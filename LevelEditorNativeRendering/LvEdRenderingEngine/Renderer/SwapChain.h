@@ -19,6 +19,7 @@ class SwapChain : public RenderSurface
     static const char* StaticClassName(){return "SwapChain";}
     
 	
+	// NULL on a headless device.
 	IDXGISwapChain* GetDXGISwapChain();
 	void Resize(int w, int h);
 	
@@ -27,6 +28,9 @@ class SwapChain : public RenderSurface
 	SurfaceType GetType();
 	    
 private:	
+	// the dxgi back buffer, or an offscreen texture without a dxgi factory.
+	HRESULT GetBackBuffer(UINT width, UINT height, ID3D11Texture2D** ppBuffer);
+
 	IDXGIFactory1*          m_pDXGIFactory1;
 	ID3D11Device*           m_pd3dDevice;
 		
@@ -12,10 +12,13 @@
 #include "RenderBuffer.h"
 #include "RenderContext.h"
 #include "RenderUtil.h"
+#include "EngineShaders.h"
 #include "Texture.h"
 #include "TextureLib.h"
 #include "ShapeLib.h"
 #include "GpuResourceFactory.h"
+#include "TransientBuffer.h"
+#include <algorithm>
 
 
 using namespace LvEdEngine;
@@ -78,8 +81,8 @@
 {
     // load and compile shaders
     ID3DBlob* pGSBlob = NULL;
-    ID3DBlob* pVSBlob = CompileShaderFromResource(L"TerrainShader.hlsl", "VSMain","vs_4_0", NULL);
-    ID3DBlob* pPSBlob = CompileShaderFromResource(L"TerrainShader.hlsl", "PSMain","ps_4_0", NULL);
+    ID3DBlob* pVSBlob = EngineShader::Compile(EngineShader::TerrainVS);
+    ID3DBlob* pPSBlob = EngineShader::Compile(EngineShader::TerrainPS);
     assert(pVSBlob);
     assert(pPSBlob);
 
@@ -94,9 +97,9 @@
     assert(m_vertexLayout);
 
     // create shaders for rendering solid wireframe.
-    pVSBlob = CompileShaderFromResource(L"TerrainShader.hlsl", "VSSolidWire","vs_4_0", NULL);
-    pGSBlob = CompileShaderFromResource(L"TerrainShader.hlsl", "GSSolidWire","gs_4_0", NULL);
-    pPSBlob = CompileShaderFromResource(L"TerrainShader.hlsl", "PSSolidWire","ps_4_0", NULL);
+    pVSBlob = EngineShader::Compile(EngineShader::TerrainSolidWireVS);
+    pGSBlob = EngineShader::Compile(EngineShader::TerrainSolidWireGS);
+    pPSBlob = EngineShader::Compile(EngineShader::TerrainSolidWirePS);
     assert(pVSBlob && pGSBlob && pPSBlob);
     
     m_VSSolidWire     = GpuResourceFactory::CreateVertexShader(pVSBlob);
@@ -108,9 +111,9 @@
     SAFE_RELEASE(pPSBlob);
 
     // create shaders for normals rendering.
-    pVSBlob = CompileShaderFromResource(L"TerrainShader.hlsl", "VSNormals","vs_4_0", NULL);
-    pGSBlob = CompileShaderFromResource(L"TerrainShader.hlsl", "GSNormals","gs_4_0", NULL);
-    pPSBlob = CompileShaderFromResource(L"TerrainShader.hlsl", "PSNormals","ps_4_0", NULL);
+    pVSBlob = EngineShader::Compile(EngineShader::TerrainNormalsVS);
+    pGSBlob = EngineShader::Compile(EngineShader::TerrainNormalsGS);
+    pPSBlob = EngineShader::Compile(EngineShader::TerrainNormalsPS);
     assert(pVSBlob && pGSBlob && pPSBlob);
     
     m_VSNormals = GpuResourceFactory::CreateVertexShader(pVSBlob);
@@ -123,8 +126,8 @@
     
 
     // create shaders for rendering decoration maps
-    pVSBlob = CompileShaderFromResource(L"TerrainShader.hlsl", "VSDeco","vs_4_0", NULL);    
-    pPSBlob = CompileShaderFromResource(L"TerrainShader.hlsl", "PSDeco","ps_4_0", NULL);
+    pVSBlob = EngineShader::Compile(EngineShader::TerrainDecoVS);    
+    pPSBlob = EngineShader::Compile(EngineShader::TerrainDecoPS);
     assert(pVSBlob && pPSBlob);
     
     // Define the input layout
@@ -149,8 +152,8 @@
     SAFE_RELEASE(pPSBlob);
 
     // decoratin rendering using billboards    
-    pVSBlob = CompileShaderFromResource(L"TerrainShader.hlsl", "VSDecoBB","vs_4_0", NULL);
-    pGSBlob = CompileShaderFromResource(L"TerrainShader.hlsl", "GSDecoBB","gs_4_0", NULL);    
+    pVSBlob = EngineShader::Compile(EngineShader::TerrainDecoBBVS);
+    pGSBlob = EngineShader::Compile(EngineShader::TerrainDecoBBGS);    
     assert(pVSBlob && pGSBlob);
 
     m_VSDecoBB = GpuResourceFactory::CreateVertexShader(pVSBlob);
@@ -287,7 +290,7 @@
     flags |= (gflags & GlobalRenderFlags::Lit) ? RenderFlags::Lit : 0;
     flags |= (gflags & GlobalRenderFlags::RenderBackFace) ? RenderFlags::RenderBackFace : 0;
     
-    bool selected = ( m_rc->selection.find( terrain->GetInstanceId() ) != m_rc->selection.end() );    
+    bool selected = m_rc->selection.IsSelected( terrain );
     bool wireframe = selected || (gflags & GlobalRenderFlags::WireFrame);
               
     Matrix world = terrain->GetWorldTransform();
@@ -318,13 +321,16 @@
         if(!layermap->IsVisible()) continue;
 
         m_perTerrainCb.Data.layerTexScale[k] = float4(layermap->GetTextureScale(),0,0,0);
+        // the layers tile close to the camera.
+        layermap->GetDiffuse()->RequestMip(0);
+        layermap->GetNormal()->RequestMip(0);
         layervews[k] = layermap->GetDiffuse()->GetView();
         maskvews[k] = layermap->GetMask()->GetView();
         bumpmapviews[k] = layermap->GetNormal()->GetView();
         k++;
     }
     int32_t numlayers = k;
-    m_perTerrainCb.Data.numLayers = (float) min(MaxNumLayers, numlayers);
+    m_perTerrainCb.Data.numLayers = (float) std::min(MaxNumLayers, numlayers);
     m_perTerrainCb.Update(d3dcontext);
     
     // replace mask of the first layer to full-mask.
@@ -421,10 +427,12 @@
         if(!map->IsVisible()) continue;
 
         uint32_t vertCount = 0;
-        const VertexBuffer* dynvb = map->GetVB(m_rc,vertCount);
-        if( vertCount == 0)  continue;
+        TransientAlloc dynvb;
+        if(!map->GetVB(m_rc,&dynvb,vertCount))  continue;
                         
         const Texture* diffuse = map->GetDiffuse();
+        diffuse->RequestMip(0);
+        map->GetNormal()->RequestMip(0);
         D3D11_TEXTURE2D_DESC desc;
         diffuse->GetTex()->GetDesc(&desc);
         
@@ -445,10 +453,10 @@
             d3dcontext->IASetInputLayout(m_vertLayoutDecoBB);
             d3dcontext->VSSetShader(m_VSDecoBB, NULL, 0);
             d3dcontext->GSSetShader(m_GSDecoBB, NULL, 0);
-            vbs[0] = dynvb->GetBuffer();
-            strides[0] = dynvb->GetStride();
+            vbs[0] = dynvb.buffer;
+            strides[0] = sizeof(float2);
             d3dcontext->IASetVertexBuffers(0, 1, vbs, strides, offsets);
-            d3dcontext->Draw(vertCount,0);
+            d3dcontext->Draw(vertCount,dynvb.firstVertex);
         }
         else
         {
@@ -456,9 +464,9 @@
             d3dcontext->IASetInputLayout(m_vertLayoutDeco);
             d3dcontext->VSSetShader(m_VSDeco, NULL, 0);
             d3dcontext->GSSetShader(NULL, NULL, 0);
-            vbs[1] = dynvb->GetBuffer();
+            vbs[1] = dynvb.buffer;
             d3dcontext->IASetVertexBuffers(0, 2, vbs, strides, offsets);
-            d3dcontext->DrawIndexedInstanced(decomesh->indexBuffer->GetCount(), vertCount, 0, 0, 0);		
+            d3dcontext->DrawIndexedInstanced(decomesh->indexBuffer->GetCount(), vertCount, 0, 0, dynvb.firstVertex);		
         }
     }
 }
@@ -478,7 +486,7 @@
 }
 
 //---------------------------------------------------------------------------
-void TerrainShader::DrawNodes(const RenderNodeList& /*renderNodes*/)
+void TerrainShader::DrawNodes(const FrameNodeList& /*renderNodes*/)
 {
     // use RenderTerrain() instead of this function.
     assert(0);   
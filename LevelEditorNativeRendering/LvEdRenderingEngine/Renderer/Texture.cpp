@@ -3,15 +3,30 @@
 #include "Texture.h"
 #include "RenderUtil.h"
 #include "../Core/Utils.h"
+#include "../DirectX/DirectXTex/DirectXTex.h"
+#include "../ResourceManager/TextureStreamer.h"
+#include <algorithm>
 
 namespace LvEdEngine
 {
 
-Texture::Texture(ID3D11Texture2D* tex, bool createView)
-{    
+void Texture::Init()
+{
     m_tex = NULL;
     m_view = NULL;
     m_texType = TextureType::Unknown;
+    m_gpuBytes = 0;
+    m_source = NULL;
+    m_streamed = false;
+    m_residentMip = 0;
+    m_fullSize = 0;
+    m_requestedMip = (LONG)NoMipRequest;
+}
+
+// ----------------------------------------------------------------------------------------------
+Texture::Texture(ID3D11Texture2D* tex, bool createView)
+{    
+    Init();
 
     ID3D11ShaderResourceView* texView = NULL;
     if(tex && createView)
@@ -27,9 +42,7 @@ namespace LvEdEngine
 // ----------------------------------------------------------------------------------------------
 Texture::Texture(ID3D11Texture2D* tex, ID3D11ShaderResourceView* view)
 {    
-    m_tex = NULL;
-    m_view = NULL;
-    m_texType = TextureType::Unknown;
+    Init();
     Set(tex,view);
 }
 
@@ -38,14 +51,13 @@ namespace LvEdEngine
 // ----------------------------------------------------------------------------------------------
 Texture::Texture()
 {
-    m_tex = NULL;
-    m_view = NULL;
-    m_texType = TextureType::Unknown;
+    Init();
 }
 
 // ----------------------------------------------------------------------------------------------
 Texture::Texture(Texture* tex)
 {           
+    Init(); // the default texture owns the memory.
     if(tex)
     {
         m_tex = tex->m_tex;
@@ -54,12 +66,6 @@ namespace LvEdEngine
         SAFE_ADDREF(m_tex);
         SAFE_ADDREF(m_view);
     }
-    else
-    {
-        m_tex = NULL;
-        m_view = NULL;
-        m_texType = TextureType::Unknown;
-    }
 }
 
 // ----------------------------------------------------------------------------------------------
@@ -67,6 +73,8 @@ namespace LvEdEngine
 // this should only get called by the resource manager when items are being released.
 Texture::~Texture()
 {
+    if(m_streamed && TextureStreamer::Inst())
+        TextureStreamer::Inst()->Unregister(this);
     SAFE_RELEASE(m_tex);
     SAFE_RELEASE(m_view);
 }
@@ -78,10 +86,109 @@ namespace LvEdEngine
     SAFE_RELEASE(m_view);
     m_tex = tex;
     m_view = view;
+    m_source = NULL;
+    m_gpuBytes = ComputeBytes(m_tex);
+    m_streamed = false;
+    m_residentMip = 0;
     if((NULL != m_tex) && (NULL != m_view))
     {
         SetReady();
     }
 }
 
+// ----------------------------------------------------------------------------------------------
+void Texture::SetMips(ID3D11Texture2D* tex, ID3D11ShaderResourceView* view, uint32_t residentMip)
+{
+    Set(tex, view);
+    m_streamed = true;
+    m_residentMip = residentMip;
+    if(m_tex)
+    {
+        D3D11_TEXTURE2D_DESC desc;
+        m_tex->GetDesc(&desc);
+        m_fullSize = std::max(desc.Width, desc.Height) << residentMip;
+    }
+}
+
+// ----------------------------------------------------------------------------------------------
+void Texture::RequestMip(uint32_t mip) const
+{
+    if(m_source)
+    {
+        m_source->RequestMip(mip);
+        return;
+    }
+    if(!m_streamed)
+        return;
+
+    // keep the smallest mip requested.
+    LONG current = m_requestedMip;
+    while((uint32_t)current > mip)
+    {
+        LONG prev = InterlockedCompareExchange(&m_requestedMip, (LONG)mip, current);
+        if(prev == current)
+            break;
+        current = prev;
+    }
+}
+
+// ----------------------------------------------------------------------------------------------
+void Texture::RequestScreenSize(float screenPixels, float tiling) const
+{
+    const Texture* tex = m_source ? m_source : this;
+    if(!tex->m_streamed)
+        return;
+
+    // each mip halves the texels across the surface.
+    float texels = (float)tex->m_fullSize * tiling;
+    uint32_t mip = 0;
+    while(texels > screenPixels * 2.0f && mip < 31)
+    {
+        texels *= 0.5f;
+        ++mip;
+    }
+    tex->RequestMip(mip);
+}
+
+// ----------------------------------------------------------------------------------------------
+uint32_t Texture::TakeMipRequest()
+{
+    return (uint32_t)InterlockedExchange(&m_requestedMip, (LONG)NoMipRequest);
+}
+
+// ----------------------------------------------------------------------------------------------
+void Texture::Share(Texture* source)
+{
+    SAFE_RELEASE(m_tex);
+    SAFE_RELEASE(m_view);
+    m_source = source;
+    m_gpuBytes = 0;
+    if((NULL != GetTex()) && (NULL != GetView()))
+    {
+        SetReady();
+    }
+}
+
+// ----------------------------------------------------------------------------------------------
+//static
+uint64_t Texture::ComputeBytes(ID3D11Texture2D* tex)
+{
+    if(!tex)
+        return 0;
+    D3D11_TEXTURE2D_DESC desc;
+    tex->GetDesc(&desc);
+    uint64_t bytes = 0;
+    size_t width = desc.Width;
+    size_t height = desc.Height;
+    for(UINT mip = 0; mip < desc.MipLevels; ++mip)
+    {
+        size_t rowPitch, slicePitch;
+        DirectX::ComputePitch(desc.Format, width, height, rowPitch, slicePitch);
+        bytes += slicePitch;
+        if(width > 1) width >>= 1;
+        if(height > 1) height >>= 1;
+    }
+    return bytes * desc.ArraySize;
+}
+
 };
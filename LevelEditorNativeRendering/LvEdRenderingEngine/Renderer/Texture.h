@@ -1,7 +1,7 @@
 //Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
 
 #pragma once
-#include <D3D11.h>
+#include <d3d11.h>
 #include "Resource.h"
 #include <stdint.h>
 #include "RenderEnums.h"
@@ -29,14 +29,47 @@ class Texture : public Resource
         void SetTextureType(TextureTypeEnum texType) { m_texType = texType; }
         TextureTypeEnum GetTextureType() { return m_texType;}
 
-        ID3D11Texture2D* GetTex() const {return m_tex;}
-        ID3D11ShaderResourceView* GetView()const {return m_view;}
+        // the texture of the source while sharing, it changes when the source streams.
+        ID3D11Texture2D* GetTex() const {return m_source ? m_source->m_tex : m_tex;}
+        ID3D11ShaderResourceView* GetView()const {return m_source ? m_source->m_view : m_view;}
 
         void Set(ID3D11Texture2D* tex, ID3D11ShaderResourceView* view);
+        // uses the texture of source, which keeps counting its memory.
+        // source must outlive this texture.
+        void Share(Texture* source);
+
+        // size of all the mips of m_tex, 0 while it shares the default texture.
+        virtual uint64_t GetGpuBytes() { return m_gpuBytes; }
+
+        // mip streaming, see TextureStreamer.
+        // like Set(), for a texture that starts at mip residentMip of the complete texture.
+        void SetMips(ID3D11Texture2D* tex, ID3D11ShaderResourceView* view, uint32_t residentMip);
+        bool IsStreamed() const { return m_source ? m_source->m_streamed : m_streamed; }
+        uint32_t GetResidentMip() const { return m_residentMip; }
+
+        // Records the most detailed mip the frame being drawn needs, thread safe.
+        // Ignored unless the texture is streamed.
+        void RequestMip(uint32_t mip) const;
+        // requests the mip that gives about one texel per pixel when the
+        // texture repeats tiling times across screenPixels.
+        void RequestScreenSize(float screenPixels, float tiling) const;
+        // returns and clears the request, NoMipRequest if there was none.
+        static const uint32_t NoMipRequest = 0xFFFFFFFF;
+        uint32_t TakeMipRequest();
                       
     private:
+        void Init();
+        static uint64_t ComputeBytes(ID3D11Texture2D* tex);
+
         ID3D11Texture2D* m_tex;
         ID3D11ShaderResourceView* m_view;
         TextureTypeEnum m_texType;
+        uint64_t m_gpuBytes;
+        Texture* m_source;              // shared, see Share().
+
+        bool m_streamed;
+        uint32_t m_residentMip;
+        uint32_t m_fullSize;            // largest dimension of mip 0.
+        mutable volatile LONG m_requestedMip;
     };
 };
@@ -2,7 +2,7 @@
 
 #pragma once
 #include "RenderEnums.h"
-#include <D3D11.h>
+#include <d3d11.h>
 #include "../Core/NonCopyable.h"
 #include <stdint.h>
 
@@ -4,6 +4,7 @@
 #include "Texture.h"
 #include "../DirectX/DXUtil.h"
 #include "../Core/Logger.h"
+#include <algorithm>
 
 
 
@@ -47,8 +48,8 @@ namespace LvEdEngine
     
     DXGI_FORMAT depthBufferFormat = DXGI_FORMAT_D24_UNORM_S8_UINT;
 
-    m_width  = max(1,width);
-    m_height = max(1,height);
+    m_width  = std::max(1,width);
+    m_height = std::max(1,height);
 
     
     m_viewport.TopLeftX = 0.0f;
@@ -65,7 +66,7 @@ namespace LvEdEngine
     UINT colorBufferQuality;
     pd3dDevice->CheckMultisampleQualityLevels(colorBufferFormat,sampleCount,&colorBufferQuality);
 
-    sampleQuality = min(sampleQuality,(min(colorBufferQuality,depthQuality)-1)); 
+    sampleQuality = std::min(sampleQuality,(std::min(colorBufferQuality,depthQuality)-1)); 
     
     D3D11_TEXTURE2D_DESC texDescr;
     SecureZeroMemory( &texDescr, sizeof(texDescr) );
@@ -3,11 +3,14 @@
 
 #include "TexturedShader.h"
 #include "RenderUtil.h"
+#include "EngineShaders.h"
 #include "RenderState.h"
 #include "RenderContext.h"
 #include "Texture.h"
 #include "Model.h"
 #include "GpuResourceFactory.h"
+#include "CommandBuffer.h"
+#include <algorithm>
 
 using namespace LvEdEngine;
 
@@ -21,12 +24,12 @@
 {
     
     //  compile and create Vertex shader
-    ID3DBlob* m_shaderSceneRenderVSBlob =  CompileShaderFromResource(L"TexturedShader.hlsl","VSMain","vs_4_0", NULL);
+    ID3DBlob* m_shaderSceneRenderVSBlob =  EngineShader::Compile(EngineShader::TexturedVS);
     assert(m_shaderSceneRenderVSBlob);
     m_shaderSceneRenderVS = GpuResourceFactory::CreateVertexShader(m_shaderSceneRenderVSBlob);
     assert(m_shaderSceneRenderVS);
     
-    ID3DBlob* m_shaderSceneRenderPSBlob =  CompileShaderFromResource(L"TexturedShader.hlsl","PSMain","ps_4_0", NULL);
+    ID3DBlob* m_shaderSceneRenderPSBlob =  EngineShader::Compile(EngineShader::TexturedPS);
     assert(m_shaderSceneRenderPSBlob);
     m_shaderSceneRenderPS = GpuResourceFactory::CreatePixelShader(m_shaderSceneRenderPSBlob);
     assert(m_shaderSceneRenderPS);
@@ -55,27 +58,25 @@
 //---------------------------------------------------------------------------
 void TexturedShader::SetRenderFlag(RenderFlagsEnum rf)
 {
-   
-    ID3D11DeviceContext*  d3dcontext = m_rc->Context();
-        
+    // recorded, so the states are applied in order with the draws.
     m_renderStateCb.Data.cb_textured   = (rf & RenderFlags::Textured) != 0;
     m_renderStateCb.Data.cb_lit        = (rf & RenderFlags::Lit) != 0;
     m_renderStateCb.Data.cb_shadowed   = ShadowMaps::Inst()->IsEnabled();
-    m_renderStateCb.Update(d3dcontext);
+    m_commands.UpdateConstants(m_renderStateCb.GetBuffer(), &m_renderStateCb.Data, sizeof(m_renderStateCb.Data));
         
     // if solid and wireframe bit are set then choose solid.
     CullModeEnum cullmode = (rf & RenderFlags::RenderBackFace) ? CullMode::NONE : CullMode::BACK;
     auto rasterState = RSCache::Inst()->GetRasterState( FillMode::Solid, cullmode );
-    d3dcontext->RSSetState(rasterState);
+    m_commands.SetRasterState(rasterState);
 
     // set blend state 
     auto blendState = RSCache::Inst()->GetBlendState(rf);
     float blendFactor[4] = {1.0f};
-    d3dcontext->OMSetBlendState(blendState, blendFactor, 0xffffffff);        
+    m_commands.SetBlendState(blendState, blendFactor, 0xffffffff);        
 
     // set depth stencil state
     auto depthState  = RSCache::Inst()->GetDepthStencilState(rf);
-    d3dcontext->OMSetDepthStencilState(depthState,0);
+    m_commands.SetDepthState(depthState,0);
    
 }
 
@@ -83,22 +84,24 @@
 void TexturedShader::Begin(RenderContext* rc)
 {
     m_rc = rc;    
-    
-    ID3D11DeviceContext*  d3dcontext = m_rc->Context();
+    m_commands.Reset();
+
+    // the pipeline setup is recorded ahead of the draws, nothing
+    // reaches the device before End().
 
     // depth stencil state
     ID3D11DepthStencilState* depth = RSCache::Inst()->GetDepthStencilState(RenderFlags::None);
-    d3dcontext->OMSetDepthStencilState(depth, 0);
+    m_commands.SetDepthState(depth, 0);
 
     // update per frame cb    
     Matrix::Transpose(m_rc->Cam().View(),m_perFrameCb.Data.cb_view);
     Matrix::Transpose(m_rc->Cam().Proj(),m_perFrameCb.Data.cb_proj);         
     m_perFrameCb.Data.cb_camPosW = m_rc->Cam().CamPos(); 
     m_perFrameCb.Data.cb_fog = m_rc->GlobalFog();    
-    m_perFrameCb.Update(d3dcontext);
+    m_commands.UpdateConstants(m_perFrameCb.GetBuffer(), &m_perFrameCb.Data, sizeof(m_perFrameCb.Data));
 
     // set input layout.
-    d3dcontext->IASetInputLayout( m_pVertexLayoutMesh );
+    m_commands.SetInputLayout( m_pVertexLayoutMesh );
 
     // set texture samplers
     ID3D11SamplerState* samplers[] = 
@@ -107,14 +110,12 @@
         ShadowMaps::Inst()->GetSamplerState()
     };
 
-    d3dcontext->PSSetSamplers( 0, ARRAY_SIZE(samplers), samplers);
+    m_commands.SetPSSamplers( 0, ARRAY_SIZE(samplers), samplers);
     
-    d3dcontext->GSSetShader( NULL, NULL, 0 );
-    d3dcontext->VSSetShader( m_shaderSceneRenderVS, NULL, 0 );
-    d3dcontext->PSSetShader( m_shaderSceneRenderPS, NULL, 0 );
+    m_commands.SetShaders( m_shaderSceneRenderVS, m_shaderSceneRenderPS, NULL );
 
     ID3D11ShaderResourceView* srv = ShadowMaps::Inst()->GetShaderResourceView();
-    d3dcontext->PSSetShaderResources( 3,1, &srv );
+    m_commands.SetPSResources( 3,1, &srv );
 
     ID3D11Buffer* constantBuffers[] = {
         m_perFrameCb.GetBuffer(),
@@ -123,21 +124,22 @@
         ShadowMaps::Inst()->GetShadowConstantBuffer()
     };
     
-    d3dcontext->VSSetConstantBuffers( 0, ARRAY_SIZE(constantBuffers), constantBuffers);
-    d3dcontext->PSSetConstantBuffers( 0, ARRAY_SIZE(constantBuffers), constantBuffers);    
+    m_commands.SetConstantBuffers( 0, ARRAY_SIZE(constantBuffers), constantBuffers);
 }
 
 // --------------------------------------------------------------------------------------------------
 void TexturedShader::End()
 {    
-    ID3D11DeviceContext*  d3dcontext = m_rc->Context();
     ID3D11ShaderResourceView* texviews[] = {NULL, NULL, NULL, NULL };
-    d3dcontext->PSSetShaderResources(0, ARRAY_SIZE(texviews) , texviews);
+    m_commands.SetPSResources(0, ARRAY_SIZE(texviews) , texviews);
+
+    m_rc->Backend()->Execute(m_commands);
+    m_commands.Reset();
     m_rc = NULL;
 }
 
 //---------------------------------------------------------------------------
-void TexturedShader::DrawNodes(const RenderNodeList& renderNodes)
+void TexturedShader::DrawNodes(const FrameNodeList& renderNodes)
 {               
     for(auto it = renderNodes.begin(); it != renderNodes.end(); it++)
     {        
@@ -151,7 +153,6 @@
 {
 
     // update per draw cb.
-    ID3D11DeviceContext*  dc = m_rc->Context();
     ID3D11ShaderResourceView* textures[] = {NULL, NULL, NULL};
     
     Matrix::Transpose(r.WorldXform, m_perDrawCb.Data.cb_world );
@@ -168,6 +169,17 @@
     m_perDrawCb.Data.cb_matEmissive    = r.emissive;
     m_perDrawCb.Data.cb_matSpecular    = float4(r.specular.x,r.specular.y, r.specular.z, r.specPower);
 
+    // the mips the textures need, see TextureStreamer.
+    Texture* diffuse = r.textures[TextureType::DIFFUSE];
+    Texture* normal = r.textures[TextureType::NORMAL];
+    if((diffuse && diffuse->IsStreamed()) || (normal && normal->IsStreamed()))
+    {
+        float pixels = m_rc->ComputeScreenSize(r.bounds);
+        float tiling = std::max(fabs(r.TextureXForm.M11), fabs(r.TextureXForm.M22));
+        if(diffuse) diffuse->RequestScreenSize(pixels, tiling);
+        if(normal) normal->RequestScreenSize(pixels, tiling);
+    }
+
     if(r.textures[TextureType::DIFFUSE])
     {
         m_perDrawCb.Data.cb_hasDiffuseMap = 1;
@@ -180,21 +192,18 @@
         textures[1] = r.textures[TextureType::NORMAL]->GetView();
     }
         
-    m_perDrawCb.Update(dc);
+    m_commands.UpdateConstants(m_perDrawCb.GetBuffer(), &m_perDrawCb.Data, sizeof(m_perDrawCb.Data));
     
-    dc->PSSetShaderResources( 0, ARRAY_SIZE(textures), textures );
+    m_commands.SetPSResources( 0, ARRAY_SIZE(textures), textures );
             
     uint32_t stride = r.mesh->vertexBuffer->GetStride();
-    uint32_t offset = 0;
-    uint32_t startIndex  = 0;
+    uint32_t startIndex  = r.indexStart;
     uint32_t startVertex = 0;    
-    uint32_t indexCount = r.mesh->indexBuffer->GetCount();        
-    ID3D11Buffer* d3dvb = r.mesh->vertexBuffer->GetBuffer();
-    ID3D11Buffer* d3dib = r.mesh->indexBuffer->GetBuffer();
-    dc->IASetPrimitiveTopology( (D3D11_PRIMITIVE_TOPOLOGY)r.mesh->primitiveType );    
-    dc->IASetVertexBuffers( 0, 1, &d3dvb, &stride, &offset );
-    dc->IASetIndexBuffer(d3dib, (DXGI_FORMAT)r.mesh->indexBuffer->GetFormat(), 0);
-    dc->DrawIndexed(indexCount, startIndex, startVertex);
+    uint32_t indexCount = r.indexCount ? r.indexCount : r.mesh->indexBuffer->GetCount();        
+    m_commands.SetTopology( r.mesh->primitiveType );    
+    m_commands.SetVertexBuffer( r.mesh->vertexBuffer->GetBuffer(), stride );
+    m_commands.SetIndexBuffer( r.mesh->indexBuffer->GetBuffer(), r.mesh->indexBuffer->GetFormat() );
+    m_commands.DrawIndexed(indexCount, startIndex, startVertex);
 }
 
 
@@ -11,6 +11,7 @@
 #include "RenderSurface.h"
 #include "Lights.h"
 #include "RenderBuffer.h"
+#include "CommandBuffer.h"
 
 namespace LvEdEngine 
 {
@@ -39,7 +40,7 @@ class TexturedShader : public Shader
 
     //  Do the drawing.
     //  Connect resources, vertex and index buffers, and draw the world.
-    virtual void DrawNodes(const RenderNodeList& renderNodes);
+    virtual void DrawNodes(const FrameNodeList& renderNodes);
 
     //  Called after drawing.
     //  Perform any needed post-drawing cleanup.
@@ -86,6 +87,9 @@ struct RenderStateCb
     TConstantBuffer<PerFrameCb>    m_perFrameCb;
     TConstantBuffer<PerDrawCb>     m_perDrawCb;
     TConstantBuffer<RenderStateCb> m_renderStateCb;
+
+    // draws recorded between Begin() and End().
+    CommandBuffer                  m_commands;
 };
 
 }; // namespace LvEdEngine
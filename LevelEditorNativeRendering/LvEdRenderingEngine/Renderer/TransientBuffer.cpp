@@ -0,0 +1,206 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    TransientBuffer.cpp
+
+****************************************************************************/
+#include "TransientBuffer.h"
+#include <assert.h>
+#include <d3d11.h>
+#include "../Core/Utils.h"
+#include "../Core/Logger.h"
+
+using namespace LvEdEngine;
+
+TransientBuffer* TransientBuffer::s_inst = NULL;
+
+//---------------------------------------------------------------------------
+void TransientBuffer::InitInstance(ID3D11Device* device, uint32_t sizeInBytes)
+{
+    if(s_inst == NULL)
+        s_inst = new TransientBuffer(device, sizeInBytes);
+}
+
+//---------------------------------------------------------------------------
+void TransientBuffer::DestroyInstance()
+{
+    SAFE_DELETE(s_inst);
+}
+
+//---------------------------------------------------------------------------
+TransientBuffer::TransientBuffer(ID3D11Device* device, uint32_t sizeInBytes)
+  : m_device(device),
+    m_buffer(NULL),
+    m_capacity(sizeInBytes),
+    m_head(0),
+    m_tail(0),
+    m_mapped(false),
+    m_discard(true),
+    m_queries(true),
+    m_frameBytes(0),
+    m_lastFrameBytes(0),
+    m_discardCount(0)
+{
+    D3D11_BUFFER_DESC desc;
+    SecureZeroMemory(&desc, sizeof(desc));
+    desc.ByteWidth = sizeInBytes;
+    desc.Usage = D3D11_USAGE_DYNAMIC;
+    desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+    desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+    HRESULT hr = device->CreateBuffer(&desc, NULL, &m_buffer);
+    if(Logger::IsFailureLog(hr, L"CreateBuffer for the transient buffer"))
+    {
+        m_buffer = NULL;
+        m_capacity = 0;
+    }
+}
+
+//---------------------------------------------------------------------------
+TransientBuffer::~TransientBuffer()
+{
+    for(auto it = m_fences.begin(); it != m_fences.end(); ++it)
+        SAFE_RELEASE(it->query);
+    for(auto it = m_freeQueries.begin(); it != m_freeQueries.end(); ++it)
+        SAFE_RELEASE(*it);
+    SAFE_RELEASE(m_buffer);
+}
+
+//---------------------------------------------------------------------------
+bool TransientBuffer::Reserve(uint32_t size, uint32_t stride, uint32_t* offset) const
+{
+    uint32_t aligned = ((m_head + stride - 1) / stride) * stride;
+    if(m_head >= m_tail)
+    {
+        // free space is [head, capacity) and [0, tail).
+        if(aligned + size <= m_capacity)
+        {
+            *offset = aligned;
+            return true;
+        }
+        // wrap, the head must stay behind the tail so a full ring isn't mistaken for an empty one.
+        if(size < m_tail)
+        {
+            *offset = 0;
+            return true;
+        }
+        return false;
+    }
+
+    // free space is [head, tail).
+    if(aligned + size < m_tail)
+    {
+        *offset = aligned;
+        return true;
+    }
+    return false;
+}
+
+//---------------------------------------------------------------------------
+void TransientBuffer::RetireFrames(ID3D11DeviceContext* dc)
+{
+    while(!m_fences.empty())
+    {
+        Fence& fence = m_fences.front();
+        if(fence.query && dc->GetData(fence.query, NULL, 0, D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK)
+            break;
+        m_tail = fence.end;
+        if(fence.query)
+            m_freeQueries.push_back(fence.query);
+        m_fences.pop_front();
+    }
+
+    // nothing in flight, start over at the beginning of the ring.
+    if(m_fences.empty() && m_head == m_tail)
+        m_head = m_tail = 0;
+}
+
+//---------------------------------------------------------------------------
+bool TransientBuffer::Map(ID3D11DeviceContext* dc, uint32_t stride, uint32_t count, TransientAlloc* alloc)
+{
+    assert(!m_mapped);
+    if(m_buffer == NULL || stride == 0 || count == 0 || count > GetMaxCount(stride))
+        return false;
+
+    uint32_t size = stride * count;
+    uint32_t offset = 0;
+    bool discard = m_discard;
+    if(!discard && !Reserve(size, stride, &offset))
+    {
+        RetireFrames(dc);
+        if(!Reserve(size, stride, &offset))
+        {
+            // the GPU still uses the whole ring, the driver renames the buffer.
+            discard = true;
+            m_discardCount++;
+        }
+    }
+    if(discard)
+    {
+        for(auto it = m_fences.begin(); it != m_fences.end(); ++it)
+        {
+            if(it->query)
+                m_freeQueries.push_back(it->query);
+        }
+        m_fences.clear();
+        m_head = m_tail = 0;
+        offset = 0;
+    }
+
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    HRESULT hr = dc->Map(m_buffer, 0, discard ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE, 0, &mapped);
+    if(Logger::IsFailureLog(hr, L"mapping the transient buffer"))
+        return false;
+
+    m_discard = false;
+    m_mapped = true;
+    m_head = offset + size;
+    m_frameBytes += size;
+
+    alloc->buffer = m_buffer;
+    alloc->data = (uint8_t*)mapped.pData + offset;
+    alloc->offset = offset;
+    alloc->firstVertex = offset / stride;
+    return true;
+}
+
+//---------------------------------------------------------------------------
+void TransientBuffer::Unmap(ID3D11DeviceContext* dc)
+{
+    assert(m_mapped);
+    dc->Unmap(m_buffer, 0);
+    m_mapped = false;
+}
+
+//---------------------------------------------------------------------------
+void TransientBuffer::EndFrame(ID3D11DeviceContext* dc)
+{
+    m_lastFrameBytes = m_frameBytes;
+    if(m_frameBytes > 0)
+    {
+        m_frameBytes = 0;
+        Fence fence;
+        fence.query = NULL;
+        fence.end = m_head;
+        if(!m_freeQueries.empty())
+        {
+            fence.query = m_freeQueries.back();
+            m_freeQueries.pop_back();
+        }
+        else if(m_queries)
+        {
+            D3D11_QUERY_DESC desc;
+            desc.Query = D3D11_QUERY_EVENT;
+            desc.MiscFlags = 0;
+            if(FAILED(m_device->CreateQuery(&desc, &fence.query)))
+            {
+                // frames are done as soon as they are submitted.
+                fence.query = NULL;
+                m_queries = false;
+            }
+        }
+        if(fence.query)
+            dc->End(fence.query);
+        m_fences.push_back(fence);
+    }
+    RetireFrames(dc);
+}
@@ -0,0 +1,91 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    TransientBuffer.h
+
+    One engine-wide dynamic vertex buffer used as a ring for the vertex data
+    that is rebuilt every frame: lines, text, decorations.
+    Allocations are written with D3D11_MAP_WRITE_NO_OVERWRITE, and the end
+    of every frame is fenced with an event query, so the space the GPU is
+    done with is reused without stalling. The buffer is only discarded when
+    the GPU still uses all of it.
+****************************************************************************/
+#pragma once
+
+#include <deque>
+#include <vector>
+#include <stdint.h>
+#include "../Core/NonCopyable.h"
+
+struct ID3D11Device;
+struct ID3D11DeviceContext;
+struct ID3D11Buffer;
+struct ID3D11Query;
+
+namespace LvEdEngine
+{
+    // vertices mapped from the ring, valid until TransientBuffer::Unmap().
+    struct TransientAlloc
+    {
+        ID3D11Buffer* buffer;
+        void*         data;
+        uint32_t      offset;       // in bytes, a multiple of the stride.
+        uint32_t      firstVertex;  // offset / stride, for the start or base vertex of the draw.
+    };
+
+    class TransientBuffer : public NonCopyable
+    {
+    public:
+        static void InitInstance(ID3D11Device* device, uint32_t sizeInBytes);
+        static void DestroyInstance();
+        static TransientBuffer* Inst() { return s_inst; }
+
+        // Maps space for count vertices of the given stride.
+        // Returns false if the count is larger than GetMaxCount(stride).
+        bool Map(ID3D11DeviceContext* dc, uint32_t stride, uint32_t count, TransientAlloc* alloc);
+        void Unmap(ID3D11DeviceContext* dc);
+
+        // Fences the allocations made since the previous call,
+        // call once per frame after the draws that use them.
+        void EndFrame(ID3D11DeviceContext* dc);
+
+        ID3D11Buffer* GetBuffer() const { return m_buffer; }
+        uint32_t GetCapacity() const { return m_capacity; }
+        // largest number of vertices a single Map() can return.
+        uint32_t GetMaxCount(uint32_t stride) const { return (m_capacity - stride) / stride; }
+
+        // bytes allocated in the last frame, and number of discards so far.
+        uint32_t GetFrameBytes() const { return m_lastFrameBytes; }
+        uint32_t GetDiscardCount() const { return m_discardCount; }
+
+    private:
+        TransientBuffer(ID3D11Device* device, uint32_t sizeInBytes);
+        ~TransientBuffer();
+        static TransientBuffer* s_inst;
+
+        // returns the offset for size bytes, or false if the range is in use.
+        bool Reserve(uint32_t size, uint32_t stride, uint32_t* offset) const;
+        // frees the space of the frames the GPU has finished.
+        void RetireFrames(ID3D11DeviceContext* dc);
+
+        struct Fence
+        {
+            ID3D11Query* query;   // NULL if queries aren't supported, the frame is done right away.
+            uint32_t     end;     // ring position at the end of the frame.
+        };
+
+        ID3D11Device*  m_device;
+        ID3D11Buffer*  m_buffer;
+        uint32_t       m_capacity;
+        uint32_t       m_head;    // next free byte.
+        uint32_t       m_tail;    // first byte that may still be used by the GPU.
+        bool           m_mapped;
+        bool           m_discard; // the next map discards the buffer.
+        bool           m_queries; // false if the device can't create event queries.
+        std::deque<Fence>          m_fences;
+        std::vector<ID3D11Query*>  m_freeQueries;
+        uint32_t       m_frameBytes;
+        uint32_t       m_lastFrameBytes;
+        uint32_t       m_discardCount;
+    };
+}
@@ -1,11 +1,12 @@
 //Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
 
-#include "WireFrameShader.h"
+#include "WireframeShader.h"
 #include "../Core/NonCopyable.h"
-#include <D3D11.h>
+#include <d3d11.h>
 #include "Renderable.h"
 #include "RenderBuffer.h"
 #include "RenderUtil.h"
+#include "EngineShaders.h"
 #include "../Core/Utils.h"
 #include "RenderContext.h"
 #include "RenderState.h"
@@ -73,44 +74,60 @@
 }
 
 
-void WireFrameShader::DrawNodes(const RenderNodeList& renderNodes)
+void WireFrameShader::DrawNodes(const FrameNodeList& renderNodes)
 {        
-    ID3D11DeviceContext* d3dContext = m_rcntx->Context();
     for ( auto it = renderNodes.begin(); it != renderNodes.end(); ++it )
     {
-        
+        DrawNode(*it);
+    }
+}
+
+void WireFrameShader::DrawHighlights(const FrameNodeList& renderNodes, bool allNodes)
+{
+    for ( auto it = renderNodes.begin(); it != renderNodes.end(); ++it )
+    {
         const RenderableNode& r = (*it);
-		bool selected = (m_rcntx->selection.find(r.objectId) != m_rcntx->selection.end());
-		
-        Matrix::Transpose(r.WorldXform,m_cbPerObject.Data.worldXform);   
-		m_cbPerObject.Data.color = r.diffuse;
-
-		if (selected)
-		{
-			//float f = Lerp(0.5f, 1.2f, m_diffuseModulator);
-			//float4 di = m_rcntx->State()->GetSelectionColor() * f;
-			float4 di = r.diffuse * m_diffuseModulator;
-			di.w = 1;			
-			m_cbPerObject.Data.color = di;
-		}
-
-
-        m_cbPerObject.Update(d3dContext);        
-        uint32_t stride = r.mesh->vertexBuffer->GetStride();
-        uint32_t offset = 0;
-        uint32_t startIndex  = 0;
-        uint32_t indexCount  = r.mesh->indexBuffer->GetCount();;
-        uint32_t startVertex = 0;
-        ID3D11Buffer* d3dvb  = r.mesh->vertexBuffer->GetBuffer();
-        ID3D11Buffer* d3dib  = r.mesh->indexBuffer->GetBuffer();
-
-        d3dContext->IASetPrimitiveTopology( (D3D11_PRIMITIVE_TOPOLOGY)r.mesh->primitiveType );                       
-        d3dContext->IASetVertexBuffers( 0, 1, &d3dvb, &stride, &offset );
-        d3dContext->IASetIndexBuffer(d3dib,(DXGI_FORMAT) r.mesh->indexBuffer->GetFormat(),0);    
-        d3dContext->DrawIndexed(indexCount,startIndex,startVertex);
+        PrimitiveTypeEnum primtype = r.mesh->primitiveType;
+        bool triPrim = primtype == PrimitiveType::TriangleList || primtype == PrimitiveType::TriangleStrip;
+        if(triPrim && (allNodes || r.GetFlag(RenderableNode::kSelected)))
+        {
+            DrawNode(r);
+        }
     }
 }
 
+void WireFrameShader::DrawNode(const RenderableNode& r)
+{
+    ID3D11DeviceContext* d3dContext = m_rcntx->Context();
+    Matrix::Transpose(r.WorldXform,m_cbPerObject.Data.worldXform);   
+
+	if (r.GetFlag(RenderableNode::kSelected))
+	{
+		// pulsate the selection color.
+		float4 di = m_rcntx->State()->GetSelectionColor() * m_diffuseModulator;
+		di.w = 1;			
+		m_cbPerObject.Data.color = di;
+	}
+	else
+	{
+		m_cbPerObject.Data.color = m_rcntx->State()->GetWireframeColor();
+	}
+
+    m_cbPerObject.Update(d3dContext);        
+    uint32_t stride = r.mesh->vertexBuffer->GetStride();
+    uint32_t offset = 0;
+    uint32_t startIndex  = r.indexStart;
+    uint32_t indexCount  = r.indexCount ? r.indexCount : r.mesh->indexBuffer->GetCount();
+    uint32_t startVertex = 0;
+    ID3D11Buffer* d3dvb  = r.mesh->vertexBuffer->GetBuffer();
+    ID3D11Buffer* d3dib  = r.mesh->indexBuffer->GetBuffer();
+
+    d3dContext->IASetPrimitiveTopology( (D3D11_PRIMITIVE_TOPOLOGY)r.mesh->primitiveType );                       
+    d3dContext->IASetVertexBuffers( 0, 1, &d3dvb, &stride, &offset );
+    d3dContext->IASetIndexBuffer(d3dib,(DXGI_FORMAT) r.mesh->indexBuffer->GetFormat(),0);    
+    d3dContext->DrawIndexed(indexCount,startIndex,startVertex);
+}
+
 WireFrameShader::WireFrameShader(ID3D11Device* device)
   : Shader( Shaders::WireFrameShader)
 {    
@@ -123,9 +140,9 @@
     m_cbPerFrame.Construct(device);
     m_cbPerObject.Construct(device);
         
-    ID3DBlob* vsBlob = CompileShaderFromResource(L"WireFrameShader.hlsl", "VSSolidWire","vs_4_0", NULL);    
-    ID3DBlob* gsBlob = CompileShaderFromResource(L"WireFrameShader.hlsl", "GSSolidWire","gs_4_0", NULL);    
-    ID3DBlob* psBlob = CompileShaderFromResource(L"WireFrameShader.hlsl", "PSSolidWire","ps_4_0", NULL);
+    ID3DBlob* vsBlob = EngineShader::Compile(EngineShader::WireframeVS);    
+    ID3DBlob* gsBlob = EngineShader::Compile(EngineShader::WireframeGS);    
+    ID3DBlob* psBlob = EngineShader::Compile(EngineShader::WireframePS);
 
     assert(vsBlob);
     assert(gsBlob);
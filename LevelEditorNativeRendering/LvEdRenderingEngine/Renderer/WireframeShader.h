@@ -33,7 +33,12 @@ class WireFrameShader : public Shader
         virtual void Begin(RenderContext* rc);
         virtual void End();
         virtual void SetRenderFlag(RenderFlagsEnum rf);
-        virtual void DrawNodes(const RenderNodeList& renderNodes);
+        virtual void DrawNodes(const FrameNodeList& renderNodes);
+
+        // draws the wire-frame of the triangle nodes of a bucket of another
+        // shader, the selected nodes or all of them when allNodes is set,
+        // with the selection or wire-frame color instead of their own.
+        void DrawHighlights(const FrameNodeList& renderNodes, bool allNodes);
     private:
 		typedef Shader super;
         struct CbPerFrame
@@ -50,6 +55,7 @@ struct CbPerObject
         };
 
         void SetCullMode(CullModeEnum cullMode);
+        void DrawNode(const RenderableNode& r);
         TConstantBuffer<CbPerFrame>  m_cbPerFrame;
         TConstantBuffer<CbPerObject> m_cbPerObject;
                 
@@ -0,0 +1,303 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+#include "AssetArchive.h"
+#include <vector>
+#include <limits.h>
+#include <algorithm>
+#include "../Core/Utils.h"
+#include "../Core/Logger.h"
+#include "../Core/FileUtils.h"
+
+namespace LvEdEngine
+{
+
+// ----------------------------------------------------------------------------------------------
+// LZNT1 from ntdll, available on every version of Windows.
+static const USHORT CompressionFormatLZNT1 = 0x0002;
+static const USHORT CompressionEngineMaximum = 0x0100;
+typedef LONG (WINAPI *RtlGetCompressionWorkSpaceSizeFn)(USHORT format, PULONG bufferWorkSpaceSize, PULONG fragmentWorkSpaceSize);
+typedef LONG (WINAPI *RtlCompressBufferFn)(USHORT format, PUCHAR src, ULONG srcSize, PUCHAR dest, ULONG destSize, ULONG chunkSize, PULONG finalSize, PVOID workSpace);
+typedef LONG (WINAPI *RtlDecompressBufferFn)(USHORT format, PUCHAR dest, ULONG destSize, PUCHAR src, ULONG srcSize, PULONG finalSize);
+
+static void* GetNtProc(const char* name)
+{
+    HMODULE ntdll = GetModuleHandleW(L"ntdll.dll");
+    return ntdll ? (void*)GetProcAddress(ntdll, name) : NULL;
+}
+
+// ----------------------------------------------------------------------------------------------
+static bool EntryLess(const ArchiveEntry& a, const ArchiveEntry& b, const char* names)
+{
+    if(a.hash != b.hash)
+        return a.hash < b.hash;
+    return strcmp(names + a.nameOffset, names + b.nameOffset) < 0;
+}
+
+// ----------------------------------------------------------------------------------------------
+AssetArchive::AssetArchive()
+  : m_header(NULL),
+    m_entries(NULL),
+    m_names(NULL)
+{
+}
+
+// ----------------------------------------------------------------------------------------------
+AssetArchive::~AssetArchive()
+{
+}
+
+// ----------------------------------------------------------------------------------------------
+bool AssetArchive::Open(const WCHAR* filename)
+{
+    m_header = NULL;
+    m_entries = NULL;
+    m_names = NULL;
+    if(!m_file.Open(filename))
+    {
+        Logger::Log(OutputMessageType::Error, L"failed to open archive %ls\n", filename);
+        return false;
+    }
+
+    const uint64_t fileSize = m_file.GetSize();
+    const ArchiveHeader* header = (const ArchiveHeader*)m_file.GetData();
+    if(fileSize < sizeof(ArchiveHeader) || header->magic != Magic || header->version != Version
+        || header->indexOffset > fileSize
+        || (fileSize - header->indexOffset) / sizeof(ArchiveEntry) < header->entryCount
+        || header->namesOffset > fileSize)
+    {
+        Logger::Log(OutputMessageType::Error, L"invalid archive %ls\n", filename);
+        m_file.Close();
+        return false;
+    }
+
+    const ArchiveEntry* entries = (const ArchiveEntry*)(m_file.GetData() + header->indexOffset);
+    const uint64_t namesSize = fileSize - header->namesOffset;
+    for(uint32_t i = 0; i < header->entryCount; ++i)
+    {
+        const ArchiveEntry& e = entries[i];
+        if(e.offset > fileSize || fileSize - e.offset < e.storedSize || e.nameOffset >= namesSize)
+        {
+            Logger::Log(OutputMessageType::Error, L"invalid archive %ls\n", filename);
+            m_file.Close();
+            return false;
+        }
+    }
+    if(namesSize > 0 && m_file.GetData()[fileSize - 1] != 0)
+    {
+        Logger::Log(OutputMessageType::Error, L"invalid archive %ls\n", filename);
+        m_file.Close();
+        return false;
+    }
+
+    m_header = header;
+    m_entries = entries;
+    m_names = (const char*)(m_file.GetData() + header->namesOffset);
+    return true;
+}
+
+// ----------------------------------------------------------------------------------------------
+const ArchiveEntry* AssetArchive::Find(const char* name) const
+{
+    if(!m_header)
+        return NULL;
+    const hash32_t hash = Hash32(name);
+    const ArchiveEntry* first = m_entries;
+    const ArchiveEntry* last = m_entries + m_header->entryCount;
+    first = std::lower_bound(first, last, hash,
+        [](const ArchiveEntry& e, hash32_t h) { return e.hash < h; });
+    for(; first != last && first->hash == hash; ++first)
+    {
+        if(strcmp(GetName(*first), name) == 0)
+            return first;
+    }
+    return NULL;
+}
+
+// ----------------------------------------------------------------------------------------------
+bool AssetArchive::Extract(const ArchiveEntry& entry, BYTE* dest) const
+{
+    if((entry.flags & ArchiveEntryFlags::Compressed) == 0)
+    {
+        memcpy(dest, GetStored(entry), entry.size);
+        return true;
+    }
+
+    static RtlDecompressBufferFn decompress = (RtlDecompressBufferFn)GetNtProc("RtlDecompressBuffer");
+    ULONG finalSize = 0;
+    LONG status = decompress ? decompress(CompressionFormatLZNT1, dest, entry.size,
+        (PUCHAR)GetStored(entry), entry.storedSize, &finalSize) : -1;
+    if(status < 0 || finalSize != entry.size)
+    {
+        Logger::Log(OutputMessageType::Error, "failed to decompress %s\n", GetName(entry));
+        return false;
+    }
+    return true;
+}
+
+// ----------------------------------------------------------------------------------------------
+//static
+std::string AssetArchive::NormalizePath(const WCHAR* path)
+{
+    WCHAR fullPath[MAX_PATH];
+    DWORD len = GetFullPathNameW(path, MAX_PATH, fullPath, NULL);
+    std::wstring wide = (len > 0 && len < MAX_PATH) ? fullPath : path;
+    for(auto it = wide.begin(); it != wide.end(); ++it)
+    {
+        *it = (*it == L'\\') ? L'/' : towlower(*it);
+    }
+
+    int size = WideCharToMultiByte(CP_UTF8, 0, wide.c_str(), (int)wide.size(), NULL, 0, NULL, NULL);
+    std::string utf8(size, '\0');
+    if(size > 0)
+        WideCharToMultiByte(CP_UTF8, 0, wide.c_str(), (int)wide.size(), &utf8[0], size, NULL, NULL);
+    return utf8;
+}
+
+// ----------------------------------------------------------------------------------------------
+// skip is a NormalizePath() path, the files are compared to it the same way.
+static void FindFiles(const std::wstring& dir, const std::string& skip, std::vector<std::wstring>* files)
+{
+    WIN32_FIND_DATAW data;
+    HANDLE find = FindFirstFileW((dir + L"*").c_str(), &data);
+    if(find == INVALID_HANDLE_VALUE)
+        return;
+    do
+    {
+        if(wcscmp(data.cFileName, L".") == 0 || wcscmp(data.cFileName, L"..") == 0)
+            continue;
+        std::wstring path = dir + data.cFileName;
+        if(data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+            FindFiles(path + L"\\", skip, files);
+        else if(AssetArchive::NormalizePath(path.c_str()) != skip)
+            files->push_back(path);
+    } while(FindNextFileW(find, &data));
+    FindClose(find);
+}
+
+// ----------------------------------------------------------------------------------------------
+static bool WriteAt(HANDLE file, uint64_t offset, const void* data, uint32_t size)
+{
+    LARGE_INTEGER pos;
+    pos.QuadPart = (LONGLONG)offset;
+    DWORD written = 0;
+    return SetFilePointerEx(file, pos, NULL, FILE_BEGIN)
+        && (size == 0 || (WriteFile(file, data, size, &written, NULL) && written == size));
+}
+
+// ----------------------------------------------------------------------------------------------
+//static
+int AssetArchive::Pack(const WCHAR* rootDir, const WCHAR* archiveFile, bool compress, uint32_t alignment)
+{
+    if(alignment == 0 || (alignment & (alignment - 1)) != 0)
+        return -1;
+
+    std::wstring root = rootDir;
+    if(!root.empty() && root[root.size() - 1] != L'\\' && root[root.size() - 1] != L'/')
+        root += L"\\";
+    // the archive may be inside rootDir, it isn't packed into itself.
+    std::vector<std::wstring> files;
+    FindFiles(root, NormalizePath(archiveFile), &files);
+    const size_t rootLen = NormalizePath(root.c_str()).size();
+
+    RtlGetCompressionWorkSpaceSizeFn workSpaceSize = (RtlGetCompressionWorkSpaceSizeFn)GetNtProc("RtlGetCompressionWorkSpaceSize");
+    RtlCompressBufferFn compressBuffer = (RtlCompressBufferFn)GetNtProc("RtlCompressBuffer");
+    std::vector<BYTE> workSpace;
+    if(compress)
+    {
+        ULONG bufferWorkSpace = 0, fragmentWorkSpace = 0;
+        if(!workSpaceSize || !compressBuffer
+            || workSpaceSize(CompressionFormatLZNT1 | CompressionEngineMaximum, &bufferWorkSpace, &fragmentWorkSpace) < 0)
+        {
+            Logger::Log(OutputMessageType::Warning, L"LZNT1 not available, packing %ls uncompressed\n", archiveFile);
+            compress = false;
+        }
+        else
+        {
+            workSpace.resize(bufferWorkSpace);
+        }
+    }
+
+    // written to a temporary file that replaces the archive at the end, like FileUtils::SaveFile().
+    std::wstring tmpName = archiveFile;
+    tmpName += L".tmp";
+    HANDLE out = CreateFileW(tmpName.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if(out == INVALID_HANDLE_VALUE)
+    {
+        Logger::Log(OutputMessageType::Error, L"failed to create %ls\n", tmpName.c_str());
+        return -1;
+    }
+
+    std::vector<ArchiveEntry> entries;
+    std::string names;
+    std::vector<BYTE> packed;
+    uint64_t offset = (sizeof(ArchiveHeader) + alignment - 1) & ~(uint64_t)(alignment - 1);
+    bool ok = true;
+    for(auto it = files.begin(); it != files.end() && ok; ++it)
+    {
+        MappedFile file;
+        if(!file.Open(it->c_str()) || file.GetSize() > UINT_MAX)
+        {
+            Logger::Log(OutputMessageType::Warning, L"skipping %ls\n", it->c_str());
+            continue;
+        }
+
+        ArchiveEntry entry;
+        memset(&entry, 0, sizeof(entry));
+        std::string name = NormalizePath(it->c_str()).substr(rootLen);
+        entry.hash = Hash32(name.c_str());
+        entry.nameOffset = (uint32_t)names.size();
+        entry.offset = offset;
+        entry.size = (uint32_t)file.GetSize();
+        entry.storedSize = entry.size;
+        names += name;
+        names += '\0';
+
+        const BYTE* stored = file.GetData();
+        if(compress && entry.size > 0)
+        {
+            // only kept when it saves at least an eighth.
+            packed.resize(entry.size);
+            ULONG finalSize = 0;
+            LONG status = compressBuffer(CompressionFormatLZNT1 | CompressionEngineMaximum, (PUCHAR)file.GetData(), entry.size,
+                &packed[0], (ULONG)packed.size(), 4096, &finalSize, &workSpace[0]);
+            if(status >= 0 && finalSize > 0 && finalSize < entry.size - entry.size / 8)
+            {
+                entry.flags |= ArchiveEntryFlags::Compressed;
+                entry.storedSize = finalSize;
+                stored = &packed[0];
+            }
+        }
+
+        ok = WriteAt(out, entry.offset, stored, entry.storedSize);
+        offset = (entry.offset + entry.storedSize + alignment - 1) & ~(uint64_t)(alignment - 1);
+        entries.push_back(entry);
+    }
+
+    const char* namesData = names.c_str();
+    std::sort(entries.begin(), entries.end(),
+        [namesData](const ArchiveEntry& a, const ArchiveEntry& b) { return EntryLess(a, b, namesData); });
+
+    ArchiveHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = Magic;
+    header.version = Version;
+    header.entryCount = (uint32_t)entries.size();
+    header.alignment = alignment;
+    header.indexOffset = (offset + 7) & ~(uint64_t)7;
+    header.namesOffset = header.indexOffset + entries.size() * sizeof(ArchiveEntry);
+    ok = ok && WriteAt(out, header.indexOffset, entries.empty() ? NULL : &entries[0], (uint32_t)(entries.size() * sizeof(ArchiveEntry)))
+        && WriteAt(out, header.namesOffset, names.c_str(), (uint32_t)names.size())
+        && WriteAt(out, 0, &header, sizeof(header));
+    CloseHandle(out);
+
+    if(!ok || !MoveFileExW(tmpName.c_str(), archiveFile, MOVEFILE_REPLACE_EXISTING))
+    {
+        Logger::Log(OutputMessageType::Error, L"failed to write %ls\n", archiveFile);
+        DeleteFileW(tmpName.c_str());
+        return -1;
+    }
+    Logger::Log(OutputMessageType::Info, L"packed %u files into %ls\n", header.entryCount, archiveFile);
+    return (int)header.entryCount;
+}
+
+}; // namespace LvEdEngine
@@ -0,0 +1,93 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    AssetArchive.h
+
+    A packed archive of asset files, read through one mapped view.
+
+    Layout:
+        ArchiveHeader
+        entry data, each entry aligned to ArchiveHeader::alignment
+        ArchiveEntry[entryCount], sorted by hash then name
+        names, zero terminated UTF-8
+
+    Names are relative to the directory that was packed, lower case with
+    '/' separators, see NormalizePath(). Entries are stored as is, or
+    compressed with LZNT1 when that makes them noticeably smaller.
+****************************************************************************/
+#pragma once
+
+#include <string>
+#include "../Core/WinHeaders.h"
+#include "../Core/NonCopyable.h"
+#include "../Core/MappedFile.h"
+#include "../Core/Hasher.h"
+
+namespace LvEdEngine
+{
+    struct ArchiveHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t entryCount;
+        uint32_t alignment;
+        uint64_t indexOffset;
+        uint64_t namesOffset;
+    };
+
+    struct ArchiveEntry
+    {
+        hash32_t hash;          // Hash32() of the name.
+        uint32_t nameOffset;    // from ArchiveHeader::namesOffset.
+        uint64_t offset;        // of the stored data, from the start of the archive.
+        uint32_t size;          // of the file.
+        uint32_t storedSize;    // equal to size unless compressed.
+        uint32_t flags;
+        uint32_t reserved;
+    };
+
+    namespace ArchiveEntryFlags
+    {
+        enum Enum
+        {
+            Compressed = 1 << 0,    // LZNT1
+        };
+    }
+
+    // ----------------------------------------------------------------------------
+    class AssetArchive : public NonCopyable
+    {
+    public:
+        static const uint32_t Magic = 0x4b50564c; // 'LVPK'
+        static const uint32_t Version = 1;
+        static const uint32_t DefaultAlignment = 16;
+
+        AssetArchive();
+        ~AssetArchive();
+
+        bool Open(const WCHAR* filename);
+        uint32_t GetEntryCount() const { return m_header ? m_header->entryCount : 0; }
+
+        // name is normalized, NULL if the archive doesn't contain it.
+        const ArchiveEntry* Find(const char* name) const;
+        const char* GetName(const ArchiveEntry& entry) const { return m_names + entry.nameOffset; }
+
+        // the stored bytes, in the mapped view.
+        const BYTE* GetStored(const ArchiveEntry& entry) const { return m_file.GetData() + entry.offset; }
+        // writes the entry.size bytes of the file to dest, decompressing them if needed.
+        bool Extract(const ArchiveEntry& entry, BYTE* dest) const;
+
+        // packs every file under rootDir into archiveFile, returns the number
+        // of files packed or -1 on failure.
+        static int Pack(const WCHAR* rootDir, const WCHAR* archiveFile, bool compress, uint32_t alignment = DefaultAlignment);
+
+        // full path, lower case, '/' separators, in UTF-8.
+        static std::string NormalizePath(const WCHAR* path);
+
+    private:
+        MappedFile m_file;
+        const ArchiveHeader* m_header;
+        const ArchiveEntry* m_entries;
+        const char* m_names;
+    };
+}
@@ -4,6 +4,7 @@
 #include <string>
 #include <algorithm>
 #include <cassert>
+#include <float.h>
 #include <functional>
 #include <process.h>
 #include <d3d11.h>
@@ -16,9 +17,11 @@
 #include "../Core/Utils.h"
 #include "../Core/FileUtils.h"
 #include "../Core/Logger.h"
+#include "../Core/TaskPool.h"
 #include "../Renderer/RenderEnums.h"
 #include "../Renderer/RenderUtil.h"
 #include "../Renderer/Resource.h"
+#include "AssetArchive.h"
 
 
 namespace LvEdEngine
@@ -47,65 +50,363 @@ class AutoSync : public NonCopyable
 };
 
 // ----------------------------------------------------------------------------------------------
-// This is the async thread. It will continue to check for pending resources to load until s_exitRequested
-// is set to true, at which point it will exit.
-DWORD WINAPI ResourceManager::ThreadProc (void* arg)
+static const uint32_t NumReadThreads = 2;   // a second read keeps the disk busy while the first one is in flight.
+const float ResourceManager::DefaultPriority = 0.0f;
+const float ResourceManager::WaitPriority = FLT_MAX;
+const uint64_t ResourceManager::DefaultMemoryBudget = 1024ull * 1024 * 1024;
+static const uint32_t GcSweepStep = 64;        // entries of m_loaded swept between time checks.
+static const DWORD GcIdleMs = 1000;            // wait after a sweep found nothing to evict.
+
+// priority inherited by the LoadAsync() calls made while a worker processes a request.
+static __declspec(thread) float s_workerPriority = 0.0f; // DefaultPriority
+
+// ----------------------------------------------------------------------------------------------
+//static
+float ResourceManager::VisiblePriority(float distance)
 {
-    ResourceManager* mgr = (ResourceManager*)arg;
+    // above DefaultPriority, closer is higher.
+    return 1.0f + 1.0f / (1.0f + (distance > 0 ? distance : 0));
+}
+
+// ----------------------------------------------------------------------------------------------
+bool ResourceData::Map(const WCHAR* filename, MappedFile::Access access, bool zeroTerminated)
+{
+    Free();
+    ResourceManager* manager = ResourceManager::Inst();
+    if(manager && manager->ReadArchived(filename, this, access == MappedFile::CopyOnWrite, zeroTerminated))
+        return true;
+
+    if(!file.Open(filename, access, zeroTerminated) || file.GetSize() > UINT_MAX)
+    {
+        file.Close();
+        return false;
+    }
+    // called on the I/O threads, the workers parse from memory.
+    file.Prefetch();
+    bytes = file.GetData();
+    size = (UINT)file.GetSize();
+    return true;
+}
+
+// ----------------------------------------------------------------------------------------------
+void ResourceData::Free()
+{
+    file.Close();
+    SAFE_DELETE_ARRAY(buffer);
+    bytes = NULL;
+    size = 0;
+}
+
+// ----------------------------------------------------------------------------------------------
+bool ResourceFactory::ReadResource(const WCHAR* /*name*/, ResourceData* /*data*/)
+{
+    return true;
+}
+
+// ----------------------------------------------------------------------------------------------
+bool ResourceFactory::ProcessResource(Resource* resource, const WCHAR* name, const ResourceData& /*data*/)
+{
+    return LoadResource(resource, name);
+}
+
+// ----------------------------------------------------------------------------------------------
+bool ResourceFactory::GetShareVariant(Resource* /*resource*/, uint32_t* /*variant*/)
+{
+    return false;
+}
+
+// ----------------------------------------------------------------------------------------------
+bool ResourceFactory::ShareResource(Resource* /*resource*/, Resource* /*source*/)
+{
+    return false;
+}
+
+// ----------------------------------------------------------------------------------------------
+// removes the request with the highest priority, the oldest one among equals.
+// the queues are short, a scan lets RaisePriority() change queued requests in place.
+//static
+ResourceManager::LoadRequest* ResourceManager::PopHighest(RequestQueue& queue)
+{
+    if(queue.empty())
+        return NULL;
+    size_t best = 0;
+    for(size_t i = 1; i < queue.size(); ++i)
+    {
+        const LoadRequest* req = queue[i];
+        const LoadRequest* cur = queue[best];
+        if(req->priority > cur->priority || (req->priority == cur->priority && req->sequence < cur->sequence))
+            best = i;
+    }
+    LoadRequest* req = queue[best];
+    queue[best] = queue.back();
+    queue.pop_back();
+    return req;
+}
 
-    while(!mgr->m_exitRequested)
+// ----------------------------------------------------------------------------------------------
+// I/O stage: reads the files of the pending requests and hands them to the workers.
+DWORD WINAPI ResourceManager::ReadThreadProc(void* arg)
+{
+    ResourceManager* mgr = (ResourceManager*)arg;
+    for(;;)
     {
-        WaitForSingleObject(mgr->m_EventHandle, INFINITE);
+        WaitForSingleObject(mgr->m_readSemaphore, INFINITE);
         if(mgr->m_exitRequested)
-        {
             break;
+
+        LoadRequest* req = NULL;
+        { // CRITICAL SECTION - BEGIN
+            AutoSync sync(&mgr->m_criticalSection);
+            req = PopHighest(mgr->m_readQueue);
+        } // CRITICAL SECTION - END
+        if(!req)
+            continue;
+
+        if(!mgr->Exists(req->filename.c_str()))
+        {
+            Logger::Log(OutputMessageType::Error, L"Failed to load file, '%ls' -- does not exist\n", req->filename.c_str());
+            mgr->FinishRequest(req);
         }
-        std::wstring filename;
-        Resource * res = NULL;
-        bool pending = true;
-        while(pending)
+        else if(!req->factory->ReadResource(req->filename.c_str(), &req->data))
         {
+            Logger::Log(OutputMessageType::Error, L"failed to read %ls\n", req->filename.c_str());
+            mgr->FinishRequest(req);
+        }
+        else if(!mgr->ShareContent(req))
+        {
+            mgr->PushWork(req);
+        }
+    }
+    return 0;
+}
 
-            { // CRITICAL SECTION - BEGIN
-                AutoSync sync(&mgr->m_criticalSection);
-                // just grab the 1st one from the map, not worrying about queue order or anything like that.
-                ResourceInfoMap::iterator it = mgr->m_pending.begin();
-                if(it == mgr->m_pending.end() )
+// ----------------------------------------------------------------------------------------------
+// processing stage: parses, builds and uploads resources, see TakeWork().
+DWORD WINAPI ResourceManager::WorkerThreadProc(void* arg)
+{
+    LoaderWorker* worker = (LoaderWorker*)arg;
+    ResourceManager* mgr = worker->manager;
+
+    // WIC decoders are COM objects.
+    HRESULT hr = CoInitializeEx(NULL, COINIT_MULTITHREADED);
+    for(;;)
+    {
+        WaitForSingleObject(mgr->m_workSemaphore, INFINITE);
+        if(mgr->m_exitRequested)
+            break;
+
+        LoadRequest* req = mgr->TakeWork(worker);
+        if(!req)
+            continue;
+
+        s_workerPriority = req->priority;
+        bool ok = mgr->ProcessRequest(req);
+        s_workerPriority = DefaultPriority;
+        mgr->ProcessedRequest(req, ok);
+    }
+    if(SUCCEEDED(hr))
+        CoUninitialize();
+    return 0;
+}
+
+// ----------------------------------------------------------------------------------------------
+void ResourceManager::PushWork(LoadRequest* req)
+{
+    LoaderWorker* worker = m_workers[(uint32_t)InterlockedIncrement(&m_nextWorker) % m_workers.size()];
+    EnterCriticalSection(&worker->lock);
+    worker->queue.push_back(req);
+    LeaveCriticalSection(&worker->lock);
+    ReleaseSemaphore(m_workSemaphore, 1, NULL);
+}
+
+// ----------------------------------------------------------------------------------------------
+// called after taking a count of m_workSemaphore, so a request is queued
+// somewhere; it may only be missed while another worker takes its own.
+ResourceManager::LoadRequest* ResourceManager::TakeWork(LoaderWorker* worker)
+{
+    while(!m_exitRequested)
+    {
+        EnterCriticalSection(&worker->lock);
+        LoadRequest* req = PopHighest(worker->queue);
+        LeaveCriticalSection(&worker->lock);
+        if(req)
+            return req;
+
+        // steal the highest priority request of the other workers.
+        LoaderWorker* victim = NULL;
+        float victimPriority = 0;
+        for(auto it = m_workers.begin(); it != m_workers.end(); ++it)
+        {
+            LoaderWorker* other = *it;
+            if(other == worker)
+                continue;
+            EnterCriticalSection(&other->lock);
+            for(auto q = other->queue.begin(); q != other->queue.end(); ++q)
+            {
+                if(!victim || (*q)->priority > victimPriority)
                 {
-                    pending = false;
-                    continue;                    
+                    victim = other;
+                    victimPriority = (*q)->priority;
                 }
+            }
+            LeaveCriticalSection(&other->lock);
+        }
 
-                assert(it != mgr->m_pending.end() );
+        if(victim)
+        {
+            EnterCriticalSection(&victim->lock);
+            req = PopHighest(victim->queue);
+            LeaveCriticalSection(&victim->lock);
+            if(req)
+                return req;
+        }
+        SwitchToThread();
+    }
+    return NULL;
+}
 
-                // make a copy on purpose since we are going to leave the critical section very soon.
-                filename = it->first;
+// ----------------------------------------------------------------------------------------------
+bool ResourceManager::ProcessRequest(LoadRequest* req)
+{
+    PerfTimer timer;
+    timer.Start();
+    bool ok = req->factory->ProcessResource(req->resource, req->filename.c_str(), req->data);
+    timer.Stop();
+    req->data.Free();
 
-                // we can use the info pointer here because the info must not be deleted
-                // clients have access to the pointer. So, all we are going to do is move the
-                // pointer from the pending map to the loaded map once we load the underlying resource.
-                res = it->second;
-            } // CRITICAL SECTION - END
+    if (ok)
+    {
+        Logger::Log(OutputMessageType::Debug, L"%d ms Loaded %ls\n", timer.ElapsedMilliseconds(), FileUtils::Name(req->filename.c_str()));
+    }
+    else
+    {
+        Logger::Log(OutputMessageType::Error, L"%d ms failed to load %ls\n", timer.ElapsedMilliseconds(), req->filename.c_str());
+    }
+    return ok;
+}
 
-            // do the actual 'load' here.....this could take some time....better not be in a critical section
-            mgr->LoadResource(res, filename.c_str());
+// ----------------------------------------------------------------------------------------------
+// finishes a processed request, unless it still waits on dependencies.
+void ResourceManager::ProcessedRequest(LoadRequest* req, bool ok)
+{
+    { // CRITICAL SECTION - BEGIN
+        AutoSync sync(&m_criticalSection);
+        req->processed = true;
+        req->succeeded = ok;
+        if(req->waitingOn > 0)
+            return; // finished with its last dependency.
+    } // CRITICAL SECTION - END
+    FinishRequest(req);
+}
 
+// ----------------------------------------------------------------------------------------------
+// moves a request to the loaded resources, loaded or not, wakes up the
+// waiting threads, queues the resource for DispatchLoaded() and finishes
+// the dependents that only waited for this one.
+void ResourceManager::FinishRequest(LoadRequest* req)
+{
+    Resource* res = req->resource;
+    if(req->sharedWith)
+        req->succeeded = req->sharedWith->IsReady() && req->factory->ShareResource(res, req->sharedWith);
 
-            { // CRITICAL SECTION - BEGIN
-                AutoSync sync(&mgr->m_criticalSection);
-                mgr->m_loaded[filename] = res;
-                mgr->m_pending.erase(filename);   //imporntant to clear pending only after added to loading.
-            } // CRITICAL SECTION - END
+    std::vector<LoadRequest*> done;
+    { // CRITICAL SECTION - BEGIN
+        AutoSync sync(&m_criticalSection);
+        if(req->succeeded)
+            res->SetReady();
+        LoadedResource& entry = AddLoaded(req->key, res);
+        entry.hasContentKey = req->hasContentKey;
+        entry.contentKey = req->contentKey;
+        entry.sharedWith = req->sharedWith;
+        if(req->sharedWith && req->succeeded)
+        {
+            m_sharedCount++;
+            m_sharedBytes += req->sharedWith->GetCpuBytes() + req->sharedWith->GetGpuBytes();
+            Logger::Log(OutputMessageType::Debug, L"%ls shares the contents of another file\n", FileUtils::Name(req->filename.c_str()));
+        }
+        m_pending.erase(req->key);   //imporntant to clear pending only after added to loading.
+        m_requests.erase(res);
+        m_finished.push_back(res);
+        for(auto it = req->dependents.begin(); it != req->dependents.end(); ++it)
+        {
+            LoadRequest* dependent = *it;
+            if(--dependent->waitingOn == 0 && dependent->processed)
+                done.push_back(dependent);
+        }
+    } // CRITICAL SECTION - END
+    WakeAllConditionVariable(&m_finishedCond);
+    delete req;
 
-            for(auto it = mgr->m_listeners.begin(); it != mgr->m_listeners.end(); ++it)
-            {
-                ResourceListener * listener = (*it);
-                listener->OnResourceLoaded(res);
-            }
+    for(auto it = done.begin(); it != done.end(); ++it)
+        FinishRequest(*it);
+}
 
+// ----------------------------------------------------------------------------------------------
+// Called after a request was read: when a resource with the same contents
+// is loaded or pending, the request finishes by sharing it instead of
+// being processed. Returns false if the request must be processed.
+bool ResourceManager::ShareContent(LoadRequest* req)
+{
+    uint32_t variant = 0;
+    if(!m_contentSharing || !req->factory->GetShareVariant(req->resource, &variant))
+        return false;
+
+    ContentKey key;
+    key.hash = Hash64(req->data.bytes, req->data.size);
+    key.size = req->data.size;
+    key.factory = req->factory;
+    key.variant = variant;
+
+    bool sourcePending = false;
+    { // CRITICAL SECTION - BEGIN
+        AutoSync sync(&m_criticalSection);
+        auto it = m_contents.find(key);
+        if(it == m_contents.end())
+        {
+            // the first one with these contents.
+            m_contents[key] = req->resource;
+            req->hasContentKey = true;
+            req->contentKey = key;
+            return false;
         }
+
+        Resource* source = it->second;
+        source->AddRef();
+        req->sharedWith = source;
+        req->processed = true;
+        auto dep = m_requests.find(source);
+        if(dep != m_requests.end())
+        {
+            // finished by FinishRequest() of the source.
+            sourcePending = true;
+            LoadRequest* sourceReq = dep->second;
+            sourceReq->dependents.push_back(req);
+            req->waitingOn++;
+            req->dependencies.push_back(source);
+            RaiseRequest(sourceReq, req->priority);
+        }
+    } // CRITICAL SECTION - END
+
+    req->data.Free();
+    if(!sourcePending)
+        FinishRequest(req);
+    return true;
+}
+
+// ----------------------------------------------------------------------------------------------
+// m_criticalSection must be held.
+void ResourceManager::RaiseRequest(LoadRequest* req, float priority)
+{
+    if(req->priority >= priority)
+        return;
+    // read without the lock by the loader threads, a stale value only changes the order.
+    req->priority = priority;
+    for(auto it = req->dependencies.begin(); it != req->dependencies.end(); ++it)
+    {
+        auto dep = m_requests.find(*it);
+        if(dep != m_requests.end())
+            RaiseRequest(dep->second, priority);
     }
-    return 0;
 }
 
 
@@ -132,27 +433,96 @@ class AutoSync : public NonCopyable
 {
     
     m_exitRequested = false;
+    m_sequence = 0;
+    m_nextWorker = 0;
+    m_contentSharing = true;
+    m_sharedCount = 0;
+    m_sharedBytes = 0;
+    m_memoryBudget = DefaultMemoryBudget;
+    m_loadedBytes = 0;
+    m_gcSwept = false;
+    m_gcNext = 0;
+    m_gcIdleUntil = 0;
 
     InitializeCriticalSection(&m_criticalSection);
-    m_EventHandle = CreateEvent(NULL, false, false, NULL);
-    m_ThreadHandle = CreateThread(NULL, 0, &ResourceManager::ThreadProc, this, 0, NULL);
-    SetThreadPriority(m_ThreadHandle, THREAD_PRIORITY_NORMAL);   
+    InitializeConditionVariable(&m_finishedCond);
+    InitializeSRWLock(&m_archiveLock);
+    m_readSemaphore = CreateSemaphore(NULL, 0, MAXLONG, NULL);
+    m_workSemaphore = CreateSemaphore(NULL, 0, MAXLONG, NULL);
+
+    for(uint32_t i = 0; i < NumReadThreads; ++i)
+    {
+        HANDLE handle = CreateThread(NULL, 0, &ResourceManager::ReadThreadProc, this, 0, NULL);
+        if(handle) m_readThreads.push_back(handle);
+    }
+
+    // the workers share the machine with the render thread and its TaskPool,
+    // so they run below normal priority.
+    uint32_t numWorkers = TaskPool::DefaultWorkerCount();
+    if(numWorkers == 0) numWorkers = 1;
+    for(uint32_t i = 0; i < numWorkers; ++i)
+    {
+        LoaderWorker* worker = new LoaderWorker();
+        worker->manager = this;
+        InitializeCriticalSection(&worker->lock);
+        m_workers.push_back(worker);
+    }
+    for(auto it = m_workers.begin(); it != m_workers.end(); ++it)
+    {
+        LoaderWorker* worker = *it;
+        worker->thread = CreateThread(NULL, 0, &ResourceManager::WorkerThreadProc, worker, 0, NULL);
+        if(worker->thread)
+            SetThreadPriority(worker->thread, THREAD_PRIORITY_BELOW_NORMAL);
+    }
+    assert(!m_readThreads.empty() && m_workers[0]->thread);
+    Logger::Log(OutputMessageType::Debug, L"ResourceManager: %u read threads, %u loader workers\n", (uint32_t)m_readThreads.size(), numWorkers);
 }
 
 // ----------------------------------------------------------------------------------------------
 ResourceManager::~ResourceManager()
 {
-    AutoSync sync(&m_criticalSection);
+    // not in the critical section, the threads may need it to finish what they are doing.
     m_exitRequested = true;
-    SetEvent(m_EventHandle);
-    WaitForSingleObject(m_ThreadHandle, INFINITE);
+    ReleaseSemaphore(m_readSemaphore, (LONG)m_readThreads.size(), NULL);
+    ReleaseSemaphore(m_workSemaphore, (LONG)m_workers.size(), NULL);
+    for(auto it = m_readThreads.begin(); it != m_readThreads.end(); ++it)
+    {
+        WaitForSingleObject(*it, INFINITE);
+        CloseHandle(*it);
+    }
+    for(auto it = m_workers.begin(); it != m_workers.end(); ++it)
+    {
+        LoaderWorker* worker = *it;
+        if(worker->thread)
+        {
+            WaitForSingleObject(worker->thread, INFINITE);
+            CloseHandle(worker->thread);
+        }
+        DeleteCriticalSection(&worker->lock);
+        delete worker;
+    }
     DeleteCriticalSection(&m_criticalSection);
-    CloseHandle(m_EventHandle);
+    CloseHandle(m_readSemaphore);
+    CloseHandle(m_workSemaphore);
+
+    // nothing reads from the archives anymore.
+    for(auto it = m_archives.begin(); it != m_archives.end(); ++it)
+    {
+        delete it->archive;
+    }
+
+    // requests that never finished.
+    for(auto it = m_pending.begin(); it != m_pending.end(); ++it)
+    {
+        LoadRequest* req = it->second;
+        delete req->resource;
+        delete req;
+    }
 
     // delete loaded resources.
     for(auto it = m_loaded.begin(); it != m_loaded.end(); ++it)
     {
-        delete it->second;
+        delete it->second.resource;
     }
 
     
@@ -183,6 +553,91 @@ class AutoSync : public NonCopyable
     m_listeners.push_back(listener);
 }
 
+// ----------------------------------------------------------------------------------------------
+bool ResourceManager::MountArchive(const WCHAR* archiveFile, const WCHAR* mountDir)
+{
+    AssetArchive* archive = new AssetArchive();
+    if(!archive->Open(archiveFile))
+    {
+        delete archive;
+        return false;
+    }
+
+    MountedArchive mounted;
+    mounted.archive = archive;
+    mounted.mountDir = AssetArchive::NormalizePath(mountDir);
+    if(mounted.mountDir.empty() || mounted.mountDir[mounted.mountDir.size() - 1] != '/')
+        mounted.mountDir += '/';
+
+    AcquireSRWLockExclusive(&m_archiveLock);
+    m_archives.push_back(mounted);
+    ReleaseSRWLockExclusive(&m_archiveLock);
+    Logger::Log(OutputMessageType::Info, L"mounted %ls, %u files\n", archiveFile, archive->GetEntryCount());
+    return true;
+}
+
+// ----------------------------------------------------------------------------------------------
+// the archives are never unmounted while the manager lives, the result stays valid.
+const ArchiveEntry* ResourceManager::FindArchived(const WCHAR* filename, AssetArchive** archive)
+{
+    const ArchiveEntry* entry = NULL;
+    AcquireSRWLockShared(&m_archiveLock);
+    if(!m_archives.empty())
+    {
+        std::string path = AssetArchive::NormalizePath(filename);
+        for(auto it = m_archives.rbegin(); it != m_archives.rend() && !entry; ++it)
+        {
+            if(path.compare(0, it->mountDir.size(), it->mountDir) == 0)
+            {
+                entry = it->archive->Find(path.c_str() + it->mountDir.size());
+                *archive = it->archive;
+            }
+        }
+    }
+    ReleaseSRWLockShared(&m_archiveLock);
+    return entry;
+}
+
+// ----------------------------------------------------------------------------------------------
+bool ResourceManager::Exists(const WCHAR* filename)
+{
+    AssetArchive* archive = NULL;
+    return FindArchived(filename, &archive) != NULL || FileUtils::Exists(filename);
+}
+
+// ----------------------------------------------------------------------------------------------
+bool ResourceManager::ReadArchived(const WCHAR* filename, ResourceData* data, bool writable, bool zeroTerminated)
+{
+    AssetArchive* archive = NULL;
+    const ArchiveEntry* entry = FindArchived(filename, &archive);
+    if(!entry)
+        return false;
+
+    if((entry->flags & ArchiveEntryFlags::Compressed) == 0 && !writable && !zeroTerminated)
+    {
+        // straight from the view, brought in like MappedFile::Prefetch().
+        data->bytes = (BYTE*)archive->GetStored(*entry);
+        data->size = entry->size;
+        const volatile BYTE* bytes = data->bytes;
+        BYTE sum = 0;
+        for(UINT i = 0; i < data->size; i += 4096)
+            sum += bytes[i];
+        (void)sum;
+        return true;
+    }
+
+    data->buffer = new BYTE[entry->size + 1];
+    data->buffer[entry->size] = 0;
+    if(!archive->Extract(*entry, data->buffer))
+    {
+        data->Free();
+        return false;
+    }
+    data->bytes = data->buffer;
+    data->size = entry->size;
+    return true;
+}
+
 // ----------------------------------------------------------------------------------------------
 ResourceFactory * ResourceManager::GetFactory(const WCHAR* filename)
 {
@@ -208,7 +663,7 @@ class AutoSync : public NonCopyable
 {
     bool ok = false;
     // try to create resource
-    if (!FileUtils::Exists(filename))
+    if (!Exists(filename))
     {
         Logger::Log(OutputMessageType::Error, L"Failed to load file, '%ls' -- does not exist\n", filename);
         return false;
@@ -243,25 +698,37 @@ class AutoSync : public NonCopyable
 
 // ----------------------------------------------------------------------------------------------
 // this function must *always* return a valid Resource, even for 'missing' resources.
-Resource* ResourceManager::LoadAsync(const WCHAR* filename, Resource* def)
+Resource* ResourceManager::LoadAsync(const WCHAR* filename, Resource* def, float priority)
 {
+    if(priority < s_workerPriority)
+        priority = s_workerPriority;
+    // different spellings of a path share one resource, the file is read
+    // from the full path as spelled.
+    std::wstring path = FileUtils::FullPath(filename);
+    std::wstring key = FileUtils::CanonicalPath(path.c_str());
+    filename = path.c_str();
+
     AutoSync sync(&m_criticalSection); // CRITICAL SECTION  - ENTIRE FUNCTION
     Resource * res = NULL;
     // check cache, use if already there.
     if(NULL == res)
     {
-        auto it = m_loaded.find(filename);
-        if(it != m_loaded.end() ) res = it->second;
+        auto it = m_loaded.find(key);
+        if(it != m_loaded.end() ) res = it->second.resource;
     }
 
     // check pending, use if already there.
     if(NULL == res)
     {
-        auto it = m_pending.find(filename);
-        if(it != m_pending.end() ) res = it->second;
+        auto it = m_pending.find(key);
+        if(it != m_pending.end() )
+        {
+            res = it->second->resource;
+            RaiseRequest(it->second, priority);
+        }
     }
 
-    // create new info and add it to pending list to be loaded.
+    // create new info and add it to the read queue.
     if(NULL == res)
     {
         ResourceFactory * factory = GetFactory(filename);
@@ -271,8 +738,22 @@ class AutoSync : public NonCopyable
         }
 
         res = factory->CreateResource(def);
-        m_pending[filename] = res;
-        BOOL success = SetEvent(m_EventHandle);
+        LoadRequest* req = new LoadRequest();
+        req->filename = filename;
+        req->key = key;
+        req->resource = res;
+        req->factory = factory;
+        req->priority = priority;
+        req->sequence = m_sequence++;
+        req->processed = false;
+        req->succeeded = false;
+        req->waitingOn = 0;
+        req->hasContentKey = false;
+        req->sharedWith = NULL;
+        m_pending[key] = req;
+        m_requests[res] = req;
+        m_readQueue.push_back(req);
+        BOOL success = ReleaseSemaphore(m_readSemaphore, 1, NULL);
         #ifdef  NDEBUG
         UNREFERENCED_VARIABLE(success);
         #endif
@@ -286,20 +767,24 @@ class AutoSync : public NonCopyable
 // ----------------------------------------------------------------------------------------------
 Resource* ResourceManager::LoadImmediate(const WCHAR* filename, Resource* def)
 {
+    std::wstring path = FileUtils::FullPath(filename);
+    std::wstring key = FileUtils::CanonicalPath(path.c_str());
+    filename = path.c_str();
+
     AutoSync sync(&m_criticalSection); // CRITICAL SECTION - ENTIRE FUNCTION
     Resource * res = NULL;
     // check cache, use if already there.
     if(NULL == res)
     {
-        auto it = m_loaded.find(filename);
-        if(it != m_loaded.end() ) res = it->second;
+        auto it = m_loaded.find(key);
+        if(it != m_loaded.end() ) res = it->second.resource;
     }
 
     // check pending, use if already there.
     if(NULL == res)
     {
-        auto it = m_pending.find(filename);
-        if(it != m_pending.end() ) res = it->second;
+        auto it = m_pending.find(key);
+        if(it != m_pending.end() ) res = it->second->resource;
     }
 
     // create new info and add load it immediatelly.
@@ -316,41 +801,173 @@ class AutoSync : public NonCopyable
         }
         else
         {
-            m_loaded[filename] = res;
+            AddLoaded(key, res);
         }
     }
     res->AddRef();
     return res;
 }
 
+// ----------------------------------------------------------------------------------------------
+void ResourceManager::RaisePriority(Resource* res, float priority)
+{
+    AutoSync sync(&m_criticalSection);
+    auto it = m_requests.find(res);
+    if(it != m_requests.end())
+        RaiseRequest(it->second, priority);
+}
+
+// ----------------------------------------------------------------------------------------------
+void ResourceManager::AddDependency(Resource* owner, Resource* dependency)
+{
+    if(!owner || !dependency || owner == dependency)
+        return;
+    AutoSync sync(&m_criticalSection);
+    auto ownerIt = m_requests.find(owner);
+    auto depIt = m_requests.find(dependency);
+    if(ownerIt == m_requests.end() || depIt == m_requests.end())
+        return;
+
+    LoadRequest* ownerReq = ownerIt->second;
+    LoadRequest* depReq = depIt->second;
+    assert(!ownerReq->processed);
+    if(ownerReq->processed)
+        return;
+    depReq->dependents.push_back(ownerReq);
+    ownerReq->waitingOn++;
+    ownerReq->dependencies.push_back(dependency);
+    RaiseRequest(depReq, ownerReq->priority);
+}
+
+// ----------------------------------------------------------------------------------------------
 void ResourceManager::WaitOnPending()
 {
-    
-    int numPending = 0;
-    do
+    AutoSync sync(&m_criticalSection);
+    while(!m_pending.empty())
     {
-        {
-            AutoSync sync(&m_criticalSection);
-            numPending = (int)m_pending.size();           
-        } 
+        SleepConditionVariableCS(&m_finishedCond, &m_criticalSection, INFINITE);
+    }
+}
+
+// ----------------------------------------------------------------------------------------------
+bool ResourceManager::Wait(Resource* res, DWORD timeoutMs)
+{
+    return WaitAll(&res, 1, timeoutMs);
+}
+
+// ----------------------------------------------------------------------------------------------
+bool ResourceManager::WaitAll(Resource* const* resources, uint32_t count, DWORD timeoutMs)
+{
+    DWORD start = GetTickCount();
+    AutoSync sync(&m_criticalSection);
+    for(uint32_t i = 0; i < count; ++i)
+    {
+        // nothing else should load before what the caller is blocked on.
+        auto it = m_requests.find(resources[i]);
+        if(it != m_requests.end())
+            RaiseRequest(it->second, WaitPriority);
+    }
 
-        //if there are pending assets, sleep for a little while, then check again.
-        if(numPending)
+    uint32_t next = 0;
+    for(;;)
+    {
+        while(next < count && m_requests.find(resources[next]) == m_requests.end())
+            next++;
+        if(next == count)
+            return true;
+
+        DWORD wait = INFINITE;
+        if(timeoutMs != INFINITE)
         {
-            Sleep(16);
-        }        
-    } while(numPending);
+            DWORD elapsed = GetTickCount() - start;
+            if(elapsed >= timeoutMs)
+                return false;
+            wait = timeoutMs - elapsed;
+        }
+        SleepConditionVariableCS(&m_finishedCond, &m_criticalSection, wait);
+    }
+}
+
+// ----------------------------------------------------------------------------------------------
+bool ResourceManager::IsPending(Resource* res)
+{
+    AutoSync sync(&m_criticalSection);
+    return m_requests.find(res) != m_requests.end();
+}
+
+// ----------------------------------------------------------------------------------------------
+void ResourceManager::DispatchLoaded()
+{
+    { // CRITICAL SECTION - BEGIN
+        AutoSync sync(&m_criticalSection);
+        m_dispatching.swap(m_finished);
+    } // CRITICAL SECTION - END
+    if(m_dispatching.empty())
+        return;
+
+    for(auto it = m_listeners.begin(); it != m_listeners.end(); ++it)
+    {
+        ResourceListener * listener = (*it);
+        listener->OnResourcesLoaded(&m_dispatching[0], (uint32_t)m_dispatching.size());
+    }
+    m_dispatching.clear();
+}
+// ----------------------------------------------------------------------------------------------
+// m_criticalSection must be held.
+ResourceManager::LoadedResource& ResourceManager::AddLoaded(const std::wstring& filename, Resource* res)
+{
+    LoadedResource& entry = m_loaded[filename];
+    if(entry.resource)
+        m_loadedEntries.erase(entry.resource);
+    m_loadedEntries[res] = &entry;
+    entry.resource = res;
+    entry.bytes = res->GetCpuBytes() + res->GetGpuBytes();
+    entry.hasContentKey = false;
+    entry.sharedWith = NULL;
+    m_loadedBytes += entry.bytes;
+    return entry;
 }
+
+// ----------------------------------------------------------------------------------------------
+// unreferenced and already seen by the listeners, m_criticalSection must be held.
+bool ResourceManager::Collectable(Resource* res)
+{
+    return res->GetRef() == 0
+        && std::find(m_finished.begin(), m_finished.end(), res) == m_finished.end();
+}
+
+// ----------------------------------------------------------------------------------------------
+// m_criticalSection must be held.
+void ResourceManager::Unload(ResourceInfoMap::iterator it)
+{
+    Logger::Log(OutputMessageType::Debug, L"Unloading %ls\n", FileUtils::Name(it->first.c_str()));
+    LoadedResource& entry = it->second;
+    if(entry.hasContentKey)
+    {
+        auto content = m_contents.find(entry.contentKey);
+        if(content != m_contents.end() && content->second == entry.resource)
+            m_contents.erase(content);
+    }
+    // the source becomes collectable once nothing shares it.
+    Resource* sharedWith = entry.sharedWith;
+    m_loadedBytes -= entry.bytes;
+    m_loadedEntries.erase(entry.resource);
+    delete entry.resource;
+    m_loaded.erase(it);
+    if(sharedWith)
+        sharedWith->Release();
+}
+
 // ----------------------------------------------------------------------------------------------
 int ResourceManager::GarbageCollect()
 {
-    int numCollected = 0;   
-    WaitOnPending();
-    assert(m_pending.size() == 0);
+    // the listeners must not see resources deleted below, resources that
+    // finish from now on are skipped by Collectable().
+    DispatchLoaded();
 
-    // CRITICAL SECTION for the remainder of the function (deadlock could occur if this is done before WaitOnPending)
     AutoSync sync(&m_criticalSection);
-
+    int numCollected = 0;
+    // deleting a model releases its textures, so repeat until a pass finds nothing.
     bool foundOne = true;
     while(foundOne)
     {
@@ -358,33 +975,144 @@ class AutoSync : public NonCopyable
         auto it = m_loaded.begin();
         while(it != m_loaded.end())
         {
-            Resource * r = it->second;
-            assert(r);
-            if(r->GetRef()==0 )
+            auto cur = it++;
+            assert(cur->second.resource);
+            if(Collectable(cur->second.resource))
             {
                 foundOne = true;
-                Logger::Log(OutputMessageType::Debug, L"Unloading %ls\n", FileUtils::Name(it->first.c_str()));
-                SAFE_DELETE(r);
+                Unload(cur);
                 ++numCollected;
-                auto temp = it;
-                ++it;
-                m_loaded.erase(temp);
+            }
+        }
+    }
+
+    // the incremental collection starts over.
+    m_gcCursor.clear();
+    m_gcCandidates.clear();
+    m_gcSwept = false;
+    m_gcNext = 0;
+    Logger::Log(OutputMessageType::Debug, L"GarbageCollect completed\n");
+    Logger::Log(OutputMessageType::Debug, L"Active Resources# %u, %llu KB\n", m_loaded.size(), m_loadedBytes / 1024);
+    return numCollected;
+}
+
+// ----------------------------------------------------------------------------------------------
+void ResourceManager::GetSharingStats(uint32_t* sharedCount, uint64_t* savedBytes)
+{
+    AutoSync sync(&m_criticalSection);
+    if(sharedCount) *sharedCount = m_sharedCount;
+    if(savedBytes) *savedBytes = m_sharedBytes;
+}
+
+// ----------------------------------------------------------------------------------------------
+void ResourceManager::UpdateBytes(Resource* res)
+{
+    AutoSync sync(&m_criticalSection);
+    auto it = m_loadedEntries.find(res);
+    if(it == m_loadedEntries.end())
+        return; // still loading, counted once it finishes.
+    LoadedResource& entry = *it->second;
+    uint64_t bytes = res->GetCpuBytes() + res->GetGpuBytes();
+    m_loadedBytes = m_loadedBytes - entry.bytes + bytes;
+    entry.bytes = bytes;
+}
+
+// ----------------------------------------------------------------------------------------------
+void ResourceManager::SetMemoryBudget(uint64_t bytes)
+{
+    AutoSync sync(&m_criticalSection);
+    m_memoryBudget = bytes;
+    m_gcIdleUntil = 0;
+}
+
+// ----------------------------------------------------------------------------------------------
+// Sweeps m_loaded a few entries at a time for unreferenced resources, then
+// evicts them oldest first until the loaded resources fit in the budget.
+// Candidates are looked up by name again before they are deleted, they may
+// have been referenced or collected in the meantime.
+void ResourceManager::CollectIncremental(float timeSliceMs)
+{
+    PerfTimer timer;
+    timer.Start();
+
+    AutoSync sync(&m_criticalSection);
+    if(m_loadedBytes <= m_memoryBudget)
+    {
+        m_gcCursor.clear();
+        m_gcCandidates.clear();
+        m_gcSwept = false;
+        m_gcNext = 0;
+        return;
+    }
+    if(m_gcIdleUntil != 0)
+    {
+        if((LONG)(GetTickCount() - m_gcIdleUntil) < 0)
+            return;
+        m_gcIdleUntil = 0;
+    }
+
+    uint32_t numCollected = 0;
+    for(;;)
+    {
+        if(!m_gcSwept)
+        {
+            auto it = m_loaded.lower_bound(m_gcCursor);
+            for(uint32_t i = 0; i < GcSweepStep && it != m_loaded.end(); ++i, ++it)
+            {
+                Resource* res = it->second.resource;
+                if(Collectable(res))
+                    m_gcCandidates.push_back(std::make_pair(res->GetLastUsed(), it->first));
+            }
+            if(it != m_loaded.end())
+            {
+                m_gcCursor = it->first;
             }
             else
             {
-                ++it;
+                // the sweep is complete.
+                m_gcCursor.clear();
+                if(m_gcCandidates.empty())
+                {
+                    // everything is referenced, look again later.
+                    m_gcIdleUntil = GetTickCount() + GcIdleMs;
+                    if(m_gcIdleUntil == 0) m_gcIdleUntil = 1;
+                    break;
+                }
+                // oldest first, GetTickCount() wraps so compare the differences.
+                DWORD now = GetTickCount();
+                std::sort(m_gcCandidates.begin(), m_gcCandidates.end(),
+                    [now](const std::pair<DWORD, std::wstring>& a, const std::pair<DWORD, std::wstring>& b)
+                    { return (now - a.first) > (now - b.first); });
+                m_gcSwept = true;
+                m_gcNext = 0;
             }
         }
+        else if(m_gcNext < m_gcCandidates.size())
+        {
+            auto it = m_loaded.find(m_gcCandidates[m_gcNext++].second);
+            if(it != m_loaded.end() && Collectable(it->second.resource))
+            {
+                Unload(it);
+                numCollected++;
+                if(m_loadedBytes <= m_memoryBudget)
+                    break;
+            }
+        }
+        else
+        {
+            // still over budget, the resources freed may have released others.
+            m_gcCandidates.clear();
+            m_gcSwept = false;
+            m_gcNext = 0;
+        }
+
+        timer.Stop();
+        if(timer.ElapsedTimeMS() >= timeSliceMs)
+            break;
     }
-    Logger::Log(OutputMessageType::Debug, L"GarbageCollect completed\n");
-    Logger::Log(OutputMessageType::Debug, L"Active Resources# %u\n", m_loaded.size());
-    // complain about any leaked resources.
-    //for(auto it = m_loaded.begin(); it != m_loaded.end(); ++it)
-    //{        
-    //    Logger::Log(OutputMessageType::Debug, L"Active Resource %ls\n", FileUtils::Name(it->first.c_str()));
-   // }
-    
-    return numCollected;
+
+    if(numCollected > 0)
+        Logger::Log(OutputMessageType::Debug, L"Evicted %u resources, %llu KB loaded\n", numCollected, m_loadedBytes / 1024);
 }
 
 }; // namespace
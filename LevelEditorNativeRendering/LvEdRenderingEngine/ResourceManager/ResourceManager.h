@@ -6,6 +6,8 @@
 #include <vector>
 #include "../Core/WinHeaders.h"
 #include "../Core/NonCopyable.h"
+#include "../Core/MappedFile.h"
+#include "../Core/Hasher.h"
 
 
 namespace LvEdEngine
@@ -13,21 +15,59 @@ namespace LvEdEngine
     class Resource;
     class ResourceManager;
     class ResourceFactory;
+    class AssetArchive;
+    struct ArchiveEntry;
 
+    // file contents read ahead by ResourceFactory::ReadResource(): a view
+    // of a mounted archive or of the mapped file, or a copy when the
+    // archive entry is compressed or has to be writable or zero terminated.
+    struct ResourceData : public NonCopyable
+    {
+        ResourceData() : bytes(NULL), size(0), buffer(NULL) {}
+        ~ResourceData() { Free(); }
+
+        // maps filename and brings its pages in, see MappedFile and
+        // ResourceManager::MountArchive().
+        bool Map(const WCHAR* filename, MappedFile::Access access = MappedFile::ReadOnly, bool zeroTerminated = false);
+        void Free();
+
+        BYTE* bytes;    // only writable when mapped CopyOnWrite.
+        UINT  size;
+        MappedFile file;
+        BYTE* buffer;   // the copy, allocated with new[].
+    };
 
     //--------------------------------------------------
     class ResourceFactory : public NonCopyable
     {
     public:
+        virtual ~ResourceFactory() {}
         virtual Resource* CreateResource(Resource* def)=0;
         virtual bool LoadResource(Resource* resource, const WCHAR* name)=0;
+
+        // Asynchronous loads are done in two stages so that reading files
+        // overlaps with parsing others: ReadResource() runs on an I/O thread
+        // and should only read from the disk, ProcessResource() runs on a
+        // loader worker with what was read.
+        // By default nothing is read ahead and ProcessResource() calls LoadResource().
+        virtual bool ReadResource(const WCHAR* name, ResourceData* data);
+        virtual bool ProcessResource(Resource* resource, const WCHAR* name, const ResourceData& data);
+
+        // Resources read from identical bytes can share their contents.
+        // GetShareVariant() returns false if the factory can't share, or
+        // sets what else makes the result differ, e.g. the texture type.
+        // ShareResource() makes resource use what source holds.
+        virtual bool GetShareVariant(Resource* resource, uint32_t* variant);
+        virtual bool ShareResource(Resource* resource, Resource* source);
     };
 
     // ----------------------------------------------------------------------------
     class ResourceListener : public NonCopyable
     {
     public:
-        virtual void OnResourceLoaded(Resource* r)=0;
+        // called on the main thread by ResourceManager::DispatchLoaded() with the
+        // resources that finished loading since the previous call, failed ones too.
+        virtual void OnResourcesLoaded(Resource* const* resources, uint32_t count)=0;
     };
 
 
@@ -43,37 +83,206 @@ class ResourceManager : public NonCopyable
         void RegisterFactory(const WCHAR* ext, ResourceFactory* factory);
         void RegisterListener(ResourceListener* listener);
 
+        // Files under mountDir are read from the archive when it contains
+        // them, archives mounted last are searched first. Archives stay
+        // mounted until the ResourceManager is destroyed.
+        bool MountArchive(const WCHAR* archiveFile, const WCHAR* mountDir);
+        // true if the file is in a mounted archive or on the disk.
+        bool Exists(const WCHAR* filename);
+        // fills data from a mounted archive, false if none contains filename.
+        bool ReadArchived(const WCHAR* filename, ResourceData* data, bool writable, bool zeroTerminated);
+
         // loading : Resource* will never be null.
         // Note: dont ever delete resources, only release them.
-        Resource* LoadAsync(const WCHAR* filename, Resource* def);
+        // Pending requests with a higher priority are loaded first, loads
+        // started by a loader worker default to the priority of the
+        // resource it is loading.
+        Resource* LoadAsync(const WCHAR* filename, Resource* def, float priority = DefaultPriority);
         Resource* LoadImmediate(const WCHAR* filename, Resource* def);
 
+        // raises the priority of a pending request and of its dependencies,
+        // ignored once it's loading.
+        void RaisePriority(Resource* res, float priority);
+
+        // Called by a factory while it loads owner asynchronously, typically
+        // with the result of a LoadAsync(): owner only becomes ready, and
+        // stops being pending, when dependency finished loading too.
+        // Ignored if either one isn't pending. Must not form cycles.
+        void AddDependency(Resource* owner, Resource* dependency);
+
+        // priority of requests nobody is waiting for, and of the resources
+        // of visible objects at the given distance from the camera.
+        static const float DefaultPriority;
+        static const float WaitPriority;
+        static float VisiblePriority(float distance);
+
         // wait until all the pending resources loaded.
         void WaitOnPending();
+
+        // Waits until the resources finished loading, or failed to, and
+        // returns false if the timeout expired first. Pending requests get
+        // WaitPriority. Must not be called from the loader threads.
+        bool Wait(Resource* res, DWORD timeoutMs = INFINITE);
+        bool WaitAll(Resource* const* resources, uint32_t count, DWORD timeoutMs = INFINITE);
+        // true until an asynchronous load finished.
+        bool IsPending(Resource* res);
+
+        // Asynchronous loads of files with the same contents as a resource
+        // already loaded or pending share that resource's data, see
+        // ResourceFactory::ShareResource(). On by default.
+        void SetContentSharing(bool enable) { m_contentSharing = enable; }
+        // loads that shared another resource, and the bytes they didn't load.
+        void GetSharingStats(uint32_t* sharedCount, uint64_t* savedBytes);
+
+        // calls the listeners with the resources that finished since the
+        // previous call, called once per frame on the main thread.
+        void DispatchLoaded();
         
+        // deletes every unreferenced resource, pending loads are left alone.
         int GarbageCollect();
 
+        // Loaded resources are kept after their last Release() and are only
+        // evicted, least recently used first, while the memory of all the
+        // loaded resources exceeds the budget. CollectIncremental() does that
+        // work in slices of at most timeSliceMs, called once per frame.
+        void SetMemoryBudget(uint64_t bytes);
+        uint64_t GetMemoryBudget() const { return m_memoryBudget; }
+        uint64_t GetLoadedBytes() const { return m_loadedBytes; }
+        // recounts the memory of a loaded resource whose size changed, e.g.
+        // a streamed texture that gained or dropped mips. Thread safe.
+        void UpdateBytes(Resource* res);
+        void CollectIncremental(float timeSliceMs);
+        static const uint64_t DefaultMemoryBudget;
+
     private:
         ResourceManager();
         ~ResourceManager();
 
-        typedef std::map<std::wstring, Resource*> ResourceInfoMap;
+        // identifies the payload of a file for content sharing.
+        struct ContentKey
+        {
+            hash64_t         hash;
+            UINT             size;
+            ResourceFactory* factory;
+            uint32_t         variant;
+            bool operator<(const ContentKey& other) const
+            {
+                if(hash != other.hash) return hash < other.hash;
+                if(size != other.size) return size < other.size;
+                if(factory != other.factory) return factory < other.factory;
+                return variant < other.variant;
+            }
+        };
+
+        // a pending LoadAsync(), read by an I/O thread and then processed by a worker.
+        struct LoadRequest
+        {
+            std::wstring     filename;  // full path, read by the I/O thread.
+            std::wstring     key;       // canonical path, keys m_pending and m_loaded.
+            Resource*        resource;
+            ResourceFactory* factory;
+            ResourceData     data;
+            volatile float   priority;
+            uint32_t         sequence;  // FIFO order among equal priorities.
+
+            // dependency graph, guarded by m_criticalSection.
+            bool             processed; // ProcessResource() returned.
+            bool             succeeded;
+            uint32_t         waitingOn; // dependencies not finished yet.
+            std::vector<LoadRequest*> dependents;
+            std::vector<Resource*>    dependencies;
+
+            // content sharing, see ShareContent().
+            bool             hasContentKey;
+            ContentKey       contentKey;
+            Resource*        sharedWith;  // referenced until the resource is unloaded.
+        };
+        typedef std::vector<LoadRequest*> RequestQueue;
+
+        // a thread running the processing stage. Requests are pushed to the
+        // workers in turn, a worker with an empty queue steals from the others.
+        struct LoaderWorker
+        {
+            ResourceManager* manager;
+            HANDLE           thread;
+            CRITICAL_SECTION lock;      // guards queue.
+            RequestQueue     queue;
+        };
+
+        // a finished resource and the bytes it was accounted for.
+        struct LoadedResource
+        {
+            Resource*  resource;
+            uint64_t   bytes;
+            bool       hasContentKey;
+            ContentKey contentKey;
+            Resource*  sharedWith;
+        };
+        typedef std::map<std::wstring, LoadedResource> ResourceInfoMap;
+        typedef std::map<std::wstring, LoadRequest*> PendingMap;
+
+        struct MountedArchive
+        {
+            AssetArchive* archive;
+            std::string   mountDir;     // normalized, ends with '/'.
+        };
+        // the archive entry of filename, or NULL.
+        const ArchiveEntry* FindArchived(const WCHAR* filename, AssetArchive** archive);
         bool LoadResource(Resource* r, const WCHAR* filename);
         ResourceFactory * GetFactory(const WCHAR* filename);
+
+        static DWORD WINAPI ReadThreadProc(void* arg);    // I/O stage.
+        static DWORD WINAPI WorkerThreadProc(void* arg);  // processing stage.
+        static LoadRequest* PopHighest(RequestQueue& queue);
+        void PushWork(LoadRequest* req);
+        LoadRequest* TakeWork(LoaderWorker* worker);
+        bool ProcessRequest(LoadRequest* req);
+        void ProcessedRequest(LoadRequest* req, bool ok);
+        void FinishRequest(LoadRequest* req);
+        void RaiseRequest(LoadRequest* req, float priority);
+        LoadedResource& AddLoaded(const std::wstring& filename, Resource* res);
+        bool ShareContent(LoadRequest* req);
+        bool Collectable(Resource* res);
+        void Unload(ResourceInfoMap::iterator it);
         
         ResourceInfoMap m_loaded;
-        ResourceInfoMap m_pending;
+        std::map<Resource*, LoadedResource*> m_loadedEntries;  // the entry of each resource in m_loaded.
+        PendingMap m_pending;
+        std::map<Resource*, LoadRequest*> m_requests;   // m_pending by resource.
+        std::map<ContentKey, Resource*> m_contents;     // loaded or pending, by content.
         std::map<std::wstring,ResourceFactory*> m_factories;
         std::vector<ResourceListener*> m_listeners;
+        std::vector<MountedArchive> m_archives;     // guarded by m_archiveLock.
+        SRWLOCK m_archiveLock;
 
         static ResourceManager * s_Inst;
-        static DWORD WINAPI ThreadProc (void* user);       // this is our async load thread
 
         CRITICAL_SECTION m_criticalSection;  // used for thread synchronization.
-        HANDLE m_ThreadHandle;
-        HANDLE m_EventHandle;
+        CONDITION_VARIABLE m_finishedCond;   // signaled when requests finish, with m_criticalSection.
+        std::vector<Resource*> m_finished;   // not dispatched yet, guarded by m_criticalSection.
+        std::vector<Resource*> m_dispatching;
+        RequestQueue m_readQueue;            // guarded by m_criticalSection.
+        uint32_t m_sequence;
+        HANDLE m_readSemaphore;              // one count per request in m_readQueue.
+        HANDLE m_workSemaphore;              // one count per request in the worker queues.
+        std::vector<HANDLE> m_readThreads;
+        std::vector<LoaderWorker*> m_workers;
+        volatile LONG m_nextWorker;
         volatile bool m_exitRequested;
 
+        volatile bool m_contentSharing;
+        uint32_t m_sharedCount;              // guarded by m_criticalSection.
+        uint64_t m_sharedBytes;
+
+        // memory budget and incremental collection state, guarded by m_criticalSection.
+        uint64_t m_memoryBudget;
+        uint64_t m_loadedBytes;
+        std::wstring m_gcCursor;              // next entry of m_loaded to sweep.
+        bool m_gcSwept;                       // m_gcCandidates is complete and sorted.
+        std::vector<std::pair<DWORD, std::wstring>> m_gcCandidates; // last used, name.
+        size_t m_gcNext;                      // next candidate to evict.
+        DWORD m_gcIdleUntil;                  // nothing was evictable, don't sweep again before.
+
 
     };
 
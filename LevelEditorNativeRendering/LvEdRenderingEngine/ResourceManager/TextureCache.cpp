@@ -0,0 +1,122 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+#include "TextureCache.h"
+#include "../Core/Utils.h"
+#include "../Core/Logger.h"
+#include "../Core/FileUtils.h"
+#include "../Core/Hasher.h"
+#include "../Core/MappedFile.h"
+#include "../DirectX/DirectXTex/DirectXTex.h"
+
+namespace LvEdEngine
+{
+
+// change it when the processing changes, old entries are then ignored.
+static const uint32_t CacheVersion = 1;
+
+TextureCache* TextureCache::s_inst = NULL;
+
+// -------------------------------------------------------------------------------------------------
+void TextureCache::InitInstance()
+{
+    if(s_inst == NULL)
+        s_inst = new TextureCache();
+}
+
+// -------------------------------------------------------------------------------------------------
+void TextureCache::DestroyInstance()
+{
+    SAFE_DELETE(s_inst);
+}
+
+// -------------------------------------------------------------------------------------------------
+TextureCache::TextureCache()
+    : m_enabled(true),
+      m_compress(false)
+{
+    m_dir = FileUtils::GetCacheDir(L"Textures");
+    if(m_dir.empty())
+    {
+        Logger::Log(OutputMessageType::Warning, L"No texture cache directory, textures will be processed on every load\n");
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+void TextureCache::SetOptions(bool enable, bool compress)
+{
+    m_enabled = enable;
+    m_compress = compress;
+}
+
+// -------------------------------------------------------------------------------------------------
+std::wstring TextureCache::GetCacheFile(const void* data, size_t size, bool srgb) const
+{
+    if(!m_enabled || m_dir.empty())
+        return std::wstring();
+
+    // e.g. "0123456789abcdef_00012345_s1_c0_v1.dds"
+    WCHAR name[64];
+    swprintf_s(name, L"%016llx_%08x_s%d_c%d_v%u.dds",
+        (unsigned long long)Hash64(data, size), (uint32_t)size,
+        srgb ? 1 : 0, m_compress ? 1 : 0, CacheVersion);
+    return m_dir + name;
+}
+
+// -------------------------------------------------------------------------------------------------
+bool TextureCache::Load(const std::wstring& cacheFile, DirectX::ScratchImage& image)
+{
+    MappedFile file;
+    if(!file.Open(cacheFile.c_str()))
+        return false;
+
+    HRESULT hr = DirectX::LoadFromDDSMemory(file.GetData(), file.GetSize(), DirectX::DDS_FLAGS_NONE, NULL, image);
+    if(FAILED(hr))
+    {
+        Logger::Log(OutputMessageType::Warning, L"Ignoring invalid texture cache file %s\n", cacheFile.c_str());
+        return false;
+    }
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+bool TextureCache::Store(const std::wstring& cacheFile, const DirectX::ScratchImage& image)
+{
+    DirectX::Blob blob;
+    HRESULT hr = DirectX::SaveToDDSMemory(image.GetImages(), image.GetImageCount(), image.GetMetadata(),
+        DirectX::DDS_FLAGS_NONE, blob);
+    if(Logger::IsFailureLog(hr, L"DirectX::SaveToDDSMemory"))
+        return false;
+
+    // another thread may be writing the same entry, either file is good.
+    if(!FileUtils::SaveFile(cacheFile.c_str(), blob.GetBufferPointer(), (UINT)blob.GetBufferSize()))
+    {
+        Logger::Log(OutputMessageType::Debug, L"Can't write texture cache file %s\n", cacheFile.c_str());
+        return false;
+    }
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+bool TextureCache::Compress(const DirectX::ScratchImage& image, DirectX::ScratchImage& compressed) const
+{
+    const DirectX::TexMetadata& metadata = image.GetMetadata();
+    if(!m_compress
+        || DirectX::IsCompressed(metadata.format)
+        || DirectX::IsTypeless(metadata.format)
+        || DirectX::IsPlanar(metadata.format)
+        || (metadata.width % 4) != 0
+        || (metadata.height % 4) != 0)
+    {
+        return false;
+    }
+
+    DXGI_FORMAT format = image.IsAlphaAllOpaque() ? DXGI_FORMAT_BC1_UNORM : DXGI_FORMAT_BC3_UNORM;
+    if(DirectX::IsSRGB(metadata.format))
+        format = DirectX::MakeSRGB(format);
+
+    HRESULT hr = DirectX::Compress(image.GetImages(), image.GetImageCount(), metadata,
+        format, DirectX::TEX_COMPRESS_PARALLEL, 0.5f, compressed);
+    return !Logger::IsFailureLog(hr, L"DirectX::Compress");
+}
+
+}; // namespace
@@ -0,0 +1,59 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    TextureCache.h
+
+    Keeps the processed version of the textures that aren't dds files: the
+    full mip chain, in the final format, optionally block compressed, saved
+    as a dds file in the cache directory. The cache file is named after the
+    hash of the source file and the options used to process it, so an
+    edited source or a different option just misses, and the next load of
+    the same texture is a single read instead of a decode and mip build.
+****************************************************************************/
+#pragma once
+
+#include <string>
+#include "../Core/WinHeaders.h"
+#include "../Core/NonCopyable.h"
+
+namespace DirectX
+{
+    class ScratchImage;
+}
+
+namespace LvEdEngine
+{
+    class TextureCache : public NonCopyable
+    {
+    public:
+        static void InitInstance();
+        static void DestroyInstance();
+        static TextureCache* Inst() { return s_inst; }
+
+        // enable: use and fill the cache.
+        // compress: compress new entries to BC1, or BC3 when there is alpha.
+        // the compressed and uncompressed entries are kept apart.
+        void SetOptions(bool enable, bool compress);
+        bool IsCompressing() const { return m_compress; }
+
+        // cache file for the source file contents, used as the sRGB or linear data.
+        // returns an empty string when the cache is disabled or has no directory.
+        std::wstring GetCacheFile(const void* data, size_t size, bool srgb) const;
+
+        // thread safe.
+        bool Load(const std::wstring& cacheFile, DirectX::ScratchImage& image);
+        bool Store(const std::wstring& cacheFile, const DirectX::ScratchImage& image);
+
+        // compresses a mip chain if compression is on and the format allows it,
+        // returns false if image has to be used as is.
+        bool Compress(const DirectX::ScratchImage& image, DirectX::ScratchImage& compressed) const;
+
+    private:
+        TextureCache();
+        static TextureCache* s_inst;
+
+        std::wstring    m_dir;
+        volatile bool   m_enabled;
+        volatile bool   m_compress;
+    };
+}
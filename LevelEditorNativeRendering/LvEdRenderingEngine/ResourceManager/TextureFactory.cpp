@@ -9,6 +9,8 @@
 
 #include "ResourceManager.h"
 #include "TextureFactory.h"
+#include "TextureCache.h"
+#include "TextureStreamer.h"
 #include "../DirectX/DXUtil.h"
 #include "../Renderer/GpuResourceFactory.h"
 
@@ -33,25 +35,75 @@ namespace LvEdEngine
 // -------------------------------------------------------------------------------------------------
 bool TextureFactory::LoadResource(Resource* resource, const WCHAR * filename)
 {
+    // read like the asynchronous loads, so that archives are used too.
+    ResourceData data;
+    if (!ReadResource(filename, &data))
+    {
+        return false;
+    }
+    return ProcessResource(resource, filename, data);
+}
+
+// -------------------------------------------------------------------------------------------------
+bool TextureFactory::ReadResource(const WCHAR* filename, ResourceData* data)
+{
+    return data->Map(filename);
+}
+
+// -------------------------------------------------------------------------------------------------
+bool TextureFactory::ProcessResource(Resource* resource, const WCHAR* filename, const ResourceData& data)
+{
+    Texture* tex = (Texture*)resource;
+
+    // dds files are used as they are, the others go through the cache.
+    std::wstring cacheFile;
+    if(FileUtils::GetExtensionLower(filename) != L".dds")
+    {
+        bool srgb = tex->GetTextureType() == TextureType::DIFFUSE;
+        cacheFile = TextureCache::Inst()->GetCacheFile(data.bytes, data.size, srgb);
+        DirectX::ScratchImage cached;
+        if(!cacheFile.empty() && TextureCache::Inst()->Load(cacheFile, cached))
+        {
+            return CreateTexture(tex, cached, false, cacheFile);
+        }
+    }
 
-    if(!FileUtils::Exists(filename)) return false;
-    HRESULT hr = S_OK;
     DirectX::TexMetadata metadata;
     DirectX::ScratchImage sourceScratch;
-    hr = DXUtil::LoadTexture(filename,&metadata,sourceScratch);    
+    HRESULT hr = DXUtil::LoadTexture(filename, data.bytes, data.size, &metadata, sourceScratch);
     if (Logger::IsFailureLog(hr, L"LoadTexture"))
     {
         return false;
     }
+    return CreateTexture(tex, filename, metadata, sourceScratch, cacheFile);
+}
 
-    Texture* tex = (Texture*)resource;    
+// -------------------------------------------------------------------------------------------------
+bool TextureFactory::GetShareVariant(Resource* resource, uint32_t* variant)
+{
+    // the type decides the sRGB conversion.
+    *variant = (uint32_t)((Texture*)resource)->GetTextureType();
+    return true;
+}
 
+// -------------------------------------------------------------------------------------------------
+bool TextureFactory::ShareResource(Resource* resource, Resource* source)
+{
+    Texture* tex = (Texture*)resource;
+    tex->Share((Texture*)source);
+    return tex->IsReady();
+}
+
+// -------------------------------------------------------------------------------------------------
+bool TextureFactory::CreateTexture(Texture* tex, const WCHAR* filename, const DirectX::TexMetadata& metadata, const DirectX::ScratchImage& sourceScratch,
+    const std::wstring& cacheFile)
+{
+    HRESULT hr = S_OK;
     bool forceSRGB
         = tex->GetTextureType() == TextureType::DIFFUSE
         && !DirectX::IsSRGB(metadata.format);
     
     
-    ID3D11Texture2D* dxtex = NULL;
     std::wstring ext = FileUtils::GetExtensionLower(filename);
     // generate full mip chains for non dds file.
     if(ext != L".dds")
@@ -65,23 +117,48 @@ bool forceSRGB
         hr = DirectX::GenerateMipMaps(*srcImage, filter, 0, mipScratch, false);
         if (Logger::IsFailureLog(hr, L"DirectX::GenerateMipMaps"))
             return false;    
-              
-        hr = DirectX::CreateTextureEx(m_device, mipScratch.GetImages(), mipScratch.GetImageCount(), mipScratch.GetMetadata(),
-            D3D11_USAGE_DEFAULT, D3D11_BIND_SHADER_RESOURCE, 0, 0, forceSRGB,(ID3D11Resource**)&dxtex);      
+
+        // the cache keeps the final format, it's loaded without conversion.
+        if( forceSRGB )
+            mipScratch.OverrideFormat(DirectX::MakeSRGB(mipScratch.GetMetadata().format));
+
+        DirectX::ScratchImage compressed;
+        const DirectX::ScratchImage& processed
+            = TextureCache::Inst()->Compress(mipScratch, compressed) ? compressed : mipScratch;
+
+        // the mips are streamed from the cache file.
+        std::wstring streamFile;
+        if(!cacheFile.empty() && TextureCache::Inst()->Store(cacheFile, processed))
+            streamFile = cacheFile;
+        return CreateTexture(tex, processed, false, streamFile);
+    }
+
+    return CreateTexture(tex, sourceScratch, forceSRGB, filename);
+}
+
+// -------------------------------------------------------------------------------------------------
+bool TextureFactory::CreateTexture(Texture* tex, const DirectX::ScratchImage& image, bool forceSRGB, const std::wstring& streamFile)
+{
+    // large textures start with their smallest mips when the others can be read again.
+    TextureStreamer* streamer = TextureStreamer::Inst();
+    uint32_t firstMip = (streamer && !streamFile.empty()) ? streamer->GetStartMip(image.GetMetadata()) : 0;
+
+    ID3D11Texture2D* dxtex = NULL;
+    ID3D11ShaderResourceView* texview = NULL;
+    if(!TextureStreamer::CreateMips(m_device, image, firstMip, forceSRGB, &dxtex, &texview))
+        return false;
+
+    if(firstMip > 0)
+    {
+        tex->SetMips(dxtex, texview, firstMip);
+        streamer->Register(tex, streamFile, image.GetMetadata(), forceSRGB);
     }
     else
     {
-        hr = DirectX::CreateTextureEx(m_device, sourceScratch.GetImages(), sourceScratch.GetImageCount(), metadata,
-            D3D11_USAGE_DEFAULT, D3D11_BIND_SHADER_RESOURCE, 0, 0, forceSRGB,(ID3D11Resource**)&dxtex);
+        if(streamer && tex->IsStreamed())
+            streamer->Unregister(tex);
+        tex->Set(dxtex,texview);
     }
-
-    if (Logger::IsFailureLog(hr, L"DirectX::CreateTexture"))
-            return false;    
-        
-    ID3D11ShaderResourceView* texview = GpuResourceFactory::CreateTextureView(dxtex);
-    if(!dxtex) return false;
-    
-    tex->Set(dxtex,texview);    
     return true;
 }
 
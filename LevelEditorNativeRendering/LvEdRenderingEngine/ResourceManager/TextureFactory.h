@@ -2,8 +2,16 @@
 
 #pragma once
 
+namespace DirectX
+{
+    struct TexMetadata;
+    class ScratchImage;
+}
+
 namespace LvEdEngine
 {
+    class Texture;
+
     //--------------------------------------------------
     class TextureFactory : public ResourceFactory
     {
@@ -11,7 +19,19 @@ class TextureFactory : public ResourceFactory
         TextureFactory(ID3D11Device* device);
         virtual Resource* CreateResource(Resource* def);
         virtual bool LoadResource(Resource* resource, const WCHAR * filename);
+        virtual bool ReadResource(const WCHAR* filename, ResourceData* data);
+        virtual bool ProcessResource(Resource* resource, const WCHAR* filename, const ResourceData& data);
+        // identical files share a texture when they are used the same way.
+        virtual bool GetShareVariant(Resource* resource, uint32_t* variant);
+        virtual bool ShareResource(Resource* resource, Resource* source);
     private:
+        // creates the texture from the decoded image, and stores the processed image in cacheFile if it's not empty.
+        bool CreateTexture(Texture* tex, const WCHAR* filename, const DirectX::TexMetadata& metadata, const DirectX::ScratchImage& sourceScratch,
+            const std::wstring& cacheFile);
+        // creates the texture from an image that is ready to use, streamed
+        // if it's large and streamFile is a dds file with the same image.
+        bool CreateTexture(Texture* tex, const DirectX::ScratchImage& image, bool forceSRGB, const std::wstring& streamFile);
+
         ID3D11Device* m_device;        
     };
 
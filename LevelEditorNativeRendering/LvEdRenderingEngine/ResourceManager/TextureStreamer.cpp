@@ -0,0 +1,530 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+#include "TextureStreamer.h"
+#include <algorithm>
+#include "ResourceManager.h"
+#include "../Core/Utils.h"
+#include "../Core/Logger.h"
+#include "../Renderer/Texture.h"
+#include "../Renderer/GpuResourceFactory.h"
+#include "../DirectX/DirectXTex/DirectXTex.h"
+
+namespace LvEdEngine
+{
+
+const uint64_t TextureStreamer::DefaultBudget = 512 * 1024 * 1024;
+
+// uploads in progress at a time.
+static const uint32_t MaxPendingUploads = 4;
+// a texture keeps a more detailed mip than requested for this long.
+static const DWORD HoldMs = 1000;
+// a texture that isn't requested for this long goes back to its start mip.
+static const DWORD IdleMs = 5000;
+
+TextureStreamer* TextureStreamer::s_inst = NULL;
+
+// -------------------------------------------------------------------------------------------------
+void TextureStreamer::InitInstance(ID3D11Device* device, ID3D11DeviceContext* context, bool asyncUploads)
+{
+    if(s_inst == NULL)
+        s_inst = new TextureStreamer(device, context, asyncUploads);
+}
+
+// -------------------------------------------------------------------------------------------------
+void TextureStreamer::DestroyInstance()
+{
+    SAFE_DELETE(s_inst);
+}
+
+// -------------------------------------------------------------------------------------------------
+TextureStreamer::TextureStreamer(ID3D11Device* device, ID3D11DeviceContext* context, bool asyncUploads)
+    : m_device(device),
+      m_context(context),
+      m_asyncUploads(asyncUploads),
+      m_enabled(true),
+      m_budget(DefaultBudget),
+      m_pendingCount(0),
+      m_thread(NULL),
+      m_uploadSemaphore(NULL),
+      m_exitRequested(false)
+{
+    InitializeCriticalSection(&m_lock);
+    if(m_asyncUploads)
+    {
+        m_uploadSemaphore = CreateSemaphore(NULL, 0, MAXLONG, NULL);
+        m_thread = CreateThread(NULL, 0, &TextureStreamer::ThreadProc, this, 0, NULL);
+        if(m_thread)
+            SetThreadPriority(m_thread, THREAD_PRIORITY_BELOW_NORMAL);
+        else
+            m_asyncUploads = false;
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+TextureStreamer::~TextureStreamer()
+{
+    CancelUploads();
+    for(auto it = m_entries.begin(); it != m_entries.end(); ++it)
+        delete it->second;
+    DeleteCriticalSection(&m_lock);
+}
+
+// -------------------------------------------------------------------------------------------------
+void TextureStreamer::CancelUploads()
+{
+    if(m_thread)
+    {
+        m_exitRequested = true;
+        ReleaseSemaphore(m_uploadSemaphore, 1, NULL);
+        WaitForSingleObject(m_thread, INFINITE);
+        CloseHandle(m_thread);
+        m_thread = NULL;
+    }
+    if(m_uploadSemaphore)
+    {
+        CloseHandle(m_uploadSemaphore);
+        m_uploadSemaphore = NULL;
+    }
+    m_asyncUploads = false;
+    m_enabled = false;
+
+    EnterCriticalSection(&m_lock);
+    m_uploaded.insert(m_uploaded.end(), m_uploads.begin(), m_uploads.end());
+    m_uploads.clear();
+    for(auto it = m_uploaded.begin(); it != m_uploaded.end(); ++it)
+    {
+        Upload* upload = *it;
+        SAFE_RELEASE(upload->dxtex);
+        SAFE_RELEASE(upload->view);
+        upload->tex->Release();
+        delete upload;
+    }
+    m_uploaded.clear();
+    m_pendingCount = 0;
+    for(auto it = m_entries.begin(); it != m_entries.end(); ++it)
+        it->second->loading = false;
+    LeaveCriticalSection(&m_lock);
+}
+
+// -------------------------------------------------------------------------------------------------
+//static
+bool TextureStreamer::CanStartAt(DXGI_FORMAT format, uint32_t width, uint32_t height, uint32_t mip)
+{
+    if(!DirectX::IsCompressed(format))
+        return true;
+    uint32_t w = width >> mip;
+    uint32_t h = height >> mip;
+    return w > 0 && h > 0 && (w % 4) == 0 && (h % 4) == 0;
+}
+
+// -------------------------------------------------------------------------------------------------
+uint32_t TextureStreamer::GetStartMip(const DirectX::TexMetadata& metadata) const
+{
+    if(!m_enabled
+        || metadata.dimension != DirectX::TEX_DIMENSION_TEXTURE2D
+        || metadata.arraySize != 1
+        || metadata.IsCubemap()
+        || metadata.mipLevels < 2)
+    {
+        return 0;
+    }
+
+    size_t size = metadata.width > metadata.height ? metadata.width : metadata.height;
+    if(size <= MinStreamedSize)
+        return 0;
+
+    uint32_t mip = 0;
+    while(mip + 1 < metadata.mipLevels && (size >> mip) > StartSize)
+        ++mip;
+    while(mip > 0 && !CanStartAt(metadata.format, (uint32_t)metadata.width, (uint32_t)metadata.height, mip))
+        --mip;
+    return mip;
+}
+
+// -------------------------------------------------------------------------------------------------
+//static
+bool TextureStreamer::CreateMips(ID3D11Device* device, const DirectX::ScratchImage& image, uint32_t firstMip, bool forceSRGB,
+    ID3D11Texture2D** tex, ID3D11ShaderResourceView** view)
+{
+    *tex = NULL;
+    *view = NULL;
+    const DirectX::TexMetadata& source = image.GetMetadata();
+    HRESULT hr = S_OK;
+    if(firstMip == 0)
+    {
+        hr = DirectX::CreateTextureEx(device, image.GetImages(), image.GetImageCount(), source,
+            D3D11_USAGE_DEFAULT, D3D11_BIND_SHADER_RESOURCE, 0, 0, forceSRGB, (ID3D11Resource**)tex);
+    }
+    else
+    {
+        // a single 2d texture, its images are its mips.
+        if(firstMip >= source.mipLevels || source.arraySize != 1 || source.depth != 1)
+            return false;
+        DirectX::TexMetadata metadata = source;
+        size_t width = source.width >> firstMip;
+        size_t height = source.height >> firstMip;
+        metadata.width = width ? width : 1;
+        metadata.height = height ? height : 1;
+        metadata.mipLevels = source.mipLevels - firstMip;
+        hr = DirectX::CreateTextureEx(device, image.GetImages() + firstMip, metadata.mipLevels, metadata,
+            D3D11_USAGE_DEFAULT, D3D11_BIND_SHADER_RESOURCE, 0, 0, forceSRGB, (ID3D11Resource**)tex);
+    }
+    if (Logger::IsFailureLog(hr, L"DirectX::CreateTexture"))
+        return false;
+
+    *view = GpuResourceFactory::CreateTextureView(*tex);
+    if(!*view)
+    {
+        SAFE_RELEASE(*tex);
+        return false;
+    }
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+void TextureStreamer::Register(Texture* tex, const std::wstring& file, const DirectX::TexMetadata& metadata, bool forceSRGB)
+{
+    EnterCriticalSection(&m_lock);
+    Entry*& e = m_entries[tex];
+    if(e == NULL)
+        e = new Entry();
+    e->tex = tex;
+    e->file = file;
+    e->forceSRGB = forceSRGB;
+    e->format = metadata.format;
+    e->width = (uint32_t)metadata.width;
+    e->height = (uint32_t)metadata.height;
+    e->mipCount = (uint32_t)metadata.mipLevels;
+    e->minMip = tex->GetResidentMip();
+    e->startMips = 0;
+    for(uint32_t mip = 0; mip <= e->minMip; ++mip)
+    {
+        if(CanStartAt(e->format, e->width, e->height, mip))
+            e->startMips |= 1u << mip;
+    }
+    e->residentMip = e->minMip;
+    e->wantedMip = e->minMip;
+    e->wantedTime = e->requestTime = GetTickCount();
+    e->targetMip = e->minMip;
+    e->loading = false;
+    e->failed = false;
+    LeaveCriticalSection(&m_lock);
+}
+
+// -------------------------------------------------------------------------------------------------
+void TextureStreamer::Unregister(Texture* tex)
+{
+    EnterCriticalSection(&m_lock);
+    auto it = m_entries.find(tex);
+    if(it != m_entries.end())
+    {
+        delete it->second;
+        m_entries.erase(it);
+    }
+    LeaveCriticalSection(&m_lock);
+}
+
+// -------------------------------------------------------------------------------------------------
+//static
+uint64_t TextureStreamer::ChainBytes(const Entry& e, uint32_t mip)
+{
+    uint64_t bytes = 0;
+    for(; mip < e.mipCount; ++mip)
+    {
+        size_t width = e.width >> mip;
+        size_t height = e.height >> mip;
+        size_t rowPitch, slicePitch;
+        DirectX::ComputePitch(e.format, width ? width : 1, height ? height : 1, rowPitch, slicePitch);
+        bytes += slicePitch;
+    }
+    return bytes;
+}
+
+// -------------------------------------------------------------------------------------------------
+static bool RequestedEarlier(const TextureStreamer::Entry* e1, const TextureStreamer::Entry* e2)
+{
+    // wrap around safe.
+    return (LONG)(e1->requestTime - e2->requestTime) < 0;
+}
+
+// -------------------------------------------------------------------------------------------------
+//static
+uint64_t TextureStreamer::Schedule(Entry** entries, uint32_t count, uint64_t budget)
+{
+    uint64_t total = 0;
+    for(uint32_t i = 0; i < count; ++i)
+    {
+        Entry* e = entries[i];
+        uint32_t mip = e->wantedMip < e->minMip ? e->wantedMip : e->minMip;
+        while(mip > 0 && (e->startMips & (1u << mip)) == 0)
+            --mip;
+        e->targetMip = mip;
+        total += ChainBytes(*e, mip);
+    }
+    if(total <= budget)
+        return total;
+
+    // one mip at a time, least recently requested first, until it fits.
+    std::sort(entries, entries + count, RequestedEarlier);
+    bool dropped = true;
+    while(total > budget && dropped)
+    {
+        dropped = false;
+        for(uint32_t i = 0; i < count && total > budget; ++i)
+        {
+            Entry* e = entries[i];
+            uint32_t mip = e->targetMip + 1;
+            while(mip <= e->minMip && (e->startMips & (1u << mip)) == 0)
+                ++mip;
+            if(mip > e->minMip)
+                continue;
+            total -= ChainBytes(*e, e->targetMip) - ChainBytes(*e, mip);
+            e->targetMip = mip;
+            dropped = true;
+        }
+    }
+    return total;
+}
+
+// -------------------------------------------------------------------------------------------------
+void TextureStreamer::Update()
+{
+    DWORD now = GetTickCount();
+    EnterCriticalSection(&m_lock);
+    ApplyUploads();
+
+    // wanted mips from the requests.
+    m_scheduled.clear();
+    for(auto it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        Entry* e = it->second;
+        uint32_t request = e->tex->TakeMipRequest();
+        if(e->failed)
+        {
+            e->wantedMip = e->residentMip;
+        }
+        else if(!m_enabled)
+        {
+            e->wantedMip = 0;
+        }
+        else if(request != Texture::NoMipRequest)
+        {
+            e->requestTime = now;
+            if(request <= e->wantedMip || now - e->wantedTime > HoldMs)
+            {
+                e->wantedMip = request;
+                e->wantedTime = now;
+            }
+        }
+        else if(now - e->requestTime > IdleMs)
+        {
+            e->wantedMip = e->minMip;
+        }
+        m_scheduled.push_back(e);
+    }
+    if(m_scheduled.empty())
+    {
+        LeaveCriticalSection(&m_lock);
+        ReportResized();
+        return;
+    }
+
+    uint64_t budget = m_enabled ? m_budget : UINT64_MAX;
+    Schedule(&m_scheduled[0], (uint32_t)m_scheduled.size(), budget);
+
+    // free memory first.
+    for(auto it = m_scheduled.begin(); it != m_scheduled.end(); ++it)
+    {
+        Entry* e = *it;
+        if(!e->loading && e->targetMip > e->residentMip)
+            DropMips(e, e->targetMip);
+    }
+
+    // then upload, most recently requested first.
+    std::sort(m_scheduled.begin(), m_scheduled.end(), RequestedEarlier);
+    for(auto it = m_scheduled.rbegin(); it != m_scheduled.rend() && m_pendingCount < MaxPendingUploads; ++it)
+    {
+        Entry* e = *it;
+        if(e->loading || e->failed || e->targetMip >= e->residentMip)
+            continue;
+
+        Upload* upload = new Upload();
+        upload->tex = e->tex;
+        upload->file = e->file;
+        upload->forceSRGB = e->forceSRGB;
+        upload->width = e->width;
+        upload->height = e->height;
+        upload->mipCount = e->mipCount;
+        upload->mip = e->targetMip;
+        upload->dxtex = NULL;
+        upload->view = NULL;
+        e->tex->AddRef();
+        e->loading = true;
+        ++m_pendingCount;
+        if(m_asyncUploads)
+        {
+            m_uploads.push_back(upload);
+            ReleaseSemaphore(m_uploadSemaphore, 1, NULL);
+        }
+        else
+        {
+            DoUpload(upload);
+            m_uploaded.push_back(upload);
+        }
+    }
+    if(!m_asyncUploads)
+        ApplyUploads();
+    LeaveCriticalSection(&m_lock);
+    ReportResized();
+}
+
+// -------------------------------------------------------------------------------------------------
+// The ResourceManager counted the textures at the size they were loaded
+// with. Only called from Update(), on the main thread that also deletes the
+// textures, so they are still alive here.
+void TextureStreamer::ReportResized()
+{
+    ResourceManager* manager = ResourceManager::Inst();
+    if(manager)
+    {
+        for(auto it = m_resized.begin(); it != m_resized.end(); ++it)
+            manager->UpdateBytes(*it);
+    }
+    m_resized.clear();
+}
+
+// -------------------------------------------------------------------------------------------------
+// swaps in the textures uploaded since the last call, in m_lock.
+void TextureStreamer::ApplyUploads()
+{
+    for(auto it = m_uploaded.begin(); it != m_uploaded.end(); ++it)
+    {
+        Upload* upload = *it;
+        auto entry = m_entries.find(upload->tex);
+        if(entry != m_entries.end())
+        {
+            Entry* e = entry->second;
+            e->loading = false;
+            if(upload->dxtex)
+            {
+                upload->tex->SetMips(upload->dxtex, upload->view, upload->mip);
+                e->residentMip = upload->mip;
+                m_resized.push_back(upload->tex);
+                upload->dxtex = NULL;
+                upload->view = NULL;
+            }
+            else
+            {
+                e->failed = true;
+            }
+        }
+        SAFE_RELEASE(upload->dxtex);
+        SAFE_RELEASE(upload->view);
+        upload->tex->Release();
+        delete upload;
+        --m_pendingCount;
+    }
+    m_uploaded.clear();
+}
+
+// -------------------------------------------------------------------------------------------------
+// reads the file and creates the texture, without m_lock.
+void TextureStreamer::DoUpload(Upload* upload)
+{
+    ResourceData data;
+    DirectX::TexMetadata metadata;
+    DirectX::ScratchImage image;
+    if(!data.Map(upload->file.c_str())
+        || FAILED(DirectX::LoadFromDDSMemory(data.bytes, data.size, DirectX::DDS_FLAGS_NONE, &metadata, image))
+        || metadata.width != upload->width
+        || metadata.height != upload->height
+        || metadata.mipLevels != upload->mipCount)
+    {
+        Logger::Log(OutputMessageType::Warning, L"Can't stream the mips of %ls\n", upload->file.c_str());
+        return;
+    }
+    CreateMips(m_device, image, upload->mip, upload->forceSRGB, &upload->dxtex, &upload->view);
+}
+
+// -------------------------------------------------------------------------------------------------
+// the worker: uploads in the order they were queued.
+DWORD WINAPI TextureStreamer::ThreadProc(void* arg)
+{
+    TextureStreamer* streamer = (TextureStreamer*)arg;
+    for(;;)
+    {
+        WaitForSingleObject(streamer->m_uploadSemaphore, INFINITE);
+        if(streamer->m_exitRequested)
+            break;
+
+        Upload* upload = NULL;
+        EnterCriticalSection(&streamer->m_lock);
+        if(!streamer->m_uploads.empty())
+        {
+            upload = streamer->m_uploads.front();
+            streamer->m_uploads.pop_front();
+        }
+        LeaveCriticalSection(&streamer->m_lock);
+        if(!upload)
+            continue;
+
+        streamer->DoUpload(upload);
+
+        EnterCriticalSection(&streamer->m_lock);
+        streamer->m_uploaded.push_back(upload);
+        LeaveCriticalSection(&streamer->m_lock);
+    }
+    return 0;
+}
+
+// -------------------------------------------------------------------------------------------------
+// keeps the mips from mip on, copying them from the current texture.
+void TextureStreamer::DropMips(Entry* e, uint32_t mip)
+{
+    ID3D11Texture2D* current = e->tex->GetTex();
+    if(!current)
+        return;
+
+    D3D11_TEXTURE2D_DESC desc;
+    current->GetDesc(&desc);
+    uint32_t skip = mip - e->residentMip;
+    if(skip >= desc.MipLevels)
+        return;
+    UINT width = e->width >> mip;
+    UINT height = e->height >> mip;
+    desc.Width = width ? width : 1;
+    desc.Height = height ? height : 1;
+    desc.MipLevels -= skip;
+
+    ID3D11Texture2D* dxtex = NULL;
+    HRESULT hr = m_device->CreateTexture2D(&desc, NULL, &dxtex);
+    if(Logger::IsFailureLog(hr, L"CreateTexture2D"))
+        return;
+    for(UINT level = 0; level < desc.MipLevels; ++level)
+        m_context->CopySubresourceRegion(dxtex, level, 0, 0, 0, current, level + skip, NULL);
+
+    ID3D11ShaderResourceView* view = GpuResourceFactory::CreateTextureView(dxtex);
+    if(!view)
+    {
+        dxtex->Release();
+        return;
+    }
+    e->tex->SetMips(dxtex, view, mip);
+    e->residentMip = mip;
+    m_resized.push_back(e->tex);
+}
+
+// -------------------------------------------------------------------------------------------------
+void TextureStreamer::GetStats(uint64_t* residentBytes, uint32_t* textureCount, uint32_t* pendingCount)
+{
+    EnterCriticalSection(&m_lock);
+    uint64_t bytes = 0;
+    for(auto it = m_entries.begin(); it != m_entries.end(); ++it)
+        bytes += ChainBytes(*it->second, it->second->residentMip);
+    if(residentBytes) *residentBytes = bytes;
+    if(textureCount) *textureCount = (uint32_t)m_entries.size();
+    if(pendingCount) *pendingCount = m_pendingCount;
+    LeaveCriticalSection(&m_lock);
+}
+
+}; // namespace
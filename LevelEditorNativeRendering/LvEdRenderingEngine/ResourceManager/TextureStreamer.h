@@ -0,0 +1,161 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    TextureStreamer.h
+
+    Streams the most detailed mips of large textures. A streamed texture is
+    created with its small mips only and remembers a dds file that has its
+    whole mip chain: the source file when it's a dds file, otherwise its
+    TextureCache entry. While drawing, the renderer requests the mip each
+    texture needs for the size it covers on screen, see
+    Texture::RequestScreenSize(). Once per frame Update() brings the
+    textures to the requested mips within a residency budget: when the
+    requests don't fit, the textures requested least recently lose their
+    most detailed mips first.
+    Missing mips are read and uploaded by a worker thread and swapped in by
+    Update(). Mips are dropped by copying the others to a smaller texture.
+    With the null device the uploads are done by Update() itself, so the
+    results don't depend on the timing of the threads.
+****************************************************************************/
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <d3d11.h>
+#include "../Core/WinHeaders.h"
+#include "../Core/NonCopyable.h"
+
+namespace DirectX
+{
+    struct TexMetadata;
+    class ScratchImage;
+}
+
+namespace LvEdEngine
+{
+    class Texture;
+
+    class TextureStreamer : public NonCopyable
+    {
+    public:
+        // asyncUploads: upload on a worker thread, otherwise in Update().
+        static void InitInstance(ID3D11Device* device, ID3D11DeviceContext* context, bool asyncUploads);
+        static void DestroyInstance();
+        static TextureStreamer* Inst() { return s_inst; }
+
+        // Textures larger than MinStreamedSize that are loaded while streaming
+        // is enabled start with the mips up to StartSize. Disabling streaming
+        // brings the streamed textures to full resolution regardless of the budget.
+        void SetEnabled(bool enable) { m_enabled = enable; }
+        bool IsEnabled() const { return m_enabled; }
+        void SetBudget(uint64_t bytes) { m_budget = bytes; }
+        uint64_t GetBudget() const { return m_budget; }
+        static const uint64_t DefaultBudget;
+        static const uint32_t MinStreamedSize = 512;
+        static const uint32_t StartSize = 64;
+
+        // the mip to create a texture from, 0 if it isn't streamed.
+        uint32_t GetStartMip(const DirectX::TexMetadata& metadata) const;
+
+        // creates a texture with the mips of image from firstMip on.
+        static bool CreateMips(ID3D11Device* device, const DirectX::ScratchImage& image, uint32_t firstMip, bool forceSRGB,
+            ID3D11Texture2D** tex, ID3D11ShaderResourceView** view);
+
+        // Called with a texture created by Texture::SetMips(), file is a dds
+        // file with the whole mip chain described by metadata. Thread safe.
+        void Register(Texture* tex, const std::wstring& file, const DirectX::TexMetadata& metadata, bool forceSRGB);
+        void Unregister(Texture* tex);
+
+        // applies the requests of the frames drawn since the previous call,
+        // called once per frame on the main thread.
+        void Update();
+
+        // Stops the worker, drops the uploads in progress, which reference
+        // their textures, and disables streaming. Called at shutdown before
+        // the ResourceManager deletes the textures, the loaders it waits for
+        // then create whole textures.
+        void CancelUploads();
+
+        // memory of the streamed textures at their current mips, and uploads in progress.
+        void GetStats(uint64_t* residentBytes, uint32_t* textureCount, uint32_t* pendingCount);
+
+        // a streamed texture, as seen by Schedule().
+        struct Entry
+        {
+            Texture*        tex;
+            std::wstring    file;
+            bool            forceSRGB;
+            DXGI_FORMAT     format;
+            uint32_t        width;          // of mip 0.
+            uint32_t        height;
+            uint32_t        mipCount;       // of the whole chain.
+            uint32_t        minMip;         // least detailed mip, the one it started with.
+            uint32_t        startMips;      // bit i: a texture can start at mip i, see CanStartAt().
+            uint32_t        residentMip;
+            uint32_t        wantedMip;      // from the requests.
+            DWORD           wantedTime;     // GetTickCount() when wantedMip was last requested.
+            DWORD           requestTime;    // GetTickCount() of the last request.
+            uint32_t        targetMip;      // set by Schedule().
+            bool            loading;
+            bool            failed;         // the file can't be streamed from.
+        };
+
+        // bytes of the mips of e from mip to the end of the chain.
+        static uint64_t ChainBytes(const Entry& e, uint32_t mip);
+
+        // Sets the targetMip of the entries to their wantedMip, then while the
+        // total exceeds budget the entries requested least recently lose one
+        // mip at a time, never past their minMip. Returns the total.
+        // Doesn't use the device, only reorders entries.
+        static uint64_t Schedule(Entry** entries, uint32_t count, uint64_t budget);
+
+    private:
+        TextureStreamer(ID3D11Device* device, ID3D11DeviceContext* context, bool asyncUploads);
+        ~TextureStreamer();
+        static TextureStreamer* s_inst;
+
+        // block compressed textures must start with a multiple of 4.
+        static bool CanStartAt(DXGI_FORMAT format, uint32_t width, uint32_t height, uint32_t mip);
+
+        struct Upload
+        {
+            Texture*        tex;            // referenced until the result is applied.
+            std::wstring    file;
+            bool            forceSRGB;
+            uint32_t        width;
+            uint32_t        height;
+            uint32_t        mipCount;
+            uint32_t        mip;
+            // result, NULL if it failed.
+            ID3D11Texture2D*          dxtex;
+            ID3D11ShaderResourceView* view;
+        };
+
+        static DWORD WINAPI ThreadProc(void* arg);
+        void DoUpload(Upload* upload);
+        void ApplyUploads();
+        void DropMips(Entry* e, uint32_t mip);
+        // tells the ResourceManager the new sizes of m_resized, without m_lock.
+        void ReportResized();
+
+        ID3D11Device*           m_device;
+        ID3D11DeviceContext*    m_context;
+        bool                    m_asyncUploads;
+        volatile bool           m_enabled;
+        uint64_t                m_budget;
+
+        CRITICAL_SECTION        m_lock;         // guards everything below.
+        std::map<Texture*, Entry*> m_entries;
+        std::vector<Entry*>     m_scheduled;    // Update() scratch.
+        std::deque<Upload*>     m_uploads;      // for the worker.
+        std::vector<Upload*>    m_uploaded;     // done, not applied yet.
+        std::vector<Texture*>   m_resized;      // textures that changed mips in Update().
+        uint32_t                m_pendingCount;
+
+        HANDLE                  m_thread;
+        HANDLE                  m_uploadSemaphore;  // one count per upload in m_uploads.
+        volatile bool           m_exitRequested;
+    };
+}
@@ -59,4 +59,66 @@ VsOut VS( float4 posL : POSITION, float3 normL : NORMAL)
     return fc;
 }    
 
-        
\ No newline at end of file
+        
+
+// used by BasicRenderer::DrawBatch(), world and color are per instance,
+// see GizmoInstance, INSTUV is not used.
+struct VsBatchIn
+{
+    float4 posL   : POSITION;
+    float3 normL  : NORMAL;
+    float4 world0 : INSTWORLD0;
+    float4 world1 : INSTWORLD1;
+    float4 world2 : INSTWORLD2;
+    float4 uv0    : INSTUV0;
+    float4 uv1    : INSTUV1;
+    float4 color  : INSTCOLOR0;
+};
+
+struct VsBatchOut
+{
+    float4 posH  : SV_POSITION;
+    float3 posW  : POSITION;
+    float3 normW : NORMAL;
+    float4 color : COLOR0;
+};
+
+VsBatchOut VS_Batch( VsBatchIn vin )
+{
+    VsBatchOut vout = (VsBatchOut)0;
+    float4 posL = float4(vin.posL.xyz, 1);
+    float4 posW = float4(dot(posL, vin.world0), dot(posL, vin.world1), dot(posL, vin.world2), 1);
+    vout.posH = mul( posW, mul(view,proj) );
+    vout.color = vin.color;
+    if(lit)
+    {
+        // the cofactors of the upper 3x3 transform normals like the inverse
+        // transpose up to a scale, the pixel shader normalizes.
+        float3 c0 = vin.world0.xyz;
+        float3 c1 = vin.world1.xyz;
+        float3 c2 = vin.world2.xyz;
+        float3 r0 = float3(c0.x, c1.x, c2.x);
+        float3 r1 = float3(c0.y, c1.y, c2.y);
+        float3 r2 = float3(c0.z, c1.z, c2.z);
+        float3x3 cof = float3x3(cross(r1, r2), cross(r2, r0), cross(r0, r1));
+        float det = dot(r0, cross(r1, r2));
+        vout.posW = posW.xyz;
+        vout.normW = mul( vin.normL, cof ) * (det < 0 ? -1.0 : 1.0);
+    }
+    return vout;
+}
+
+float4 PS_Batch( VsBatchOut psIn ) : SV_Target
+{
+    float4 fc = psIn.color;
+    if(lit)
+    {
+      float3 norm = normalize(psIn.normW);
+      float specPower = max(1.0,specular.w);
+      float3 A,D,S;
+      float3 toEye = normalize(camPosW - psIn.posW);
+      ComputeDirLight(psIn.posW, norm, toEye, specPower, dirlight, A, D, S);
+      fc.xyz = psIn.color.xyz * (A + D) + specular.xyz * S;
+    }
+    return fc;
+}
@@ -10,22 +10,37 @@
    float4x4 proj;   
 };                                                            
                                                               
+// used by VS_PN and PS_PN below.
 cbuffer ConstantBufferPerDraw  : register( b1 )               
 {       
    float4x4 world;                                                         
    float4   color;                                              
 };                                                            
-                                                       
-float4 VS( float4 pos : POSITION ) : SV_POSITION
+
+// world and color are per instance, see GizmoInstance.
+struct PS_INPUT
+{
+    float4 posH  : SV_POSITION;
+    float4 color : COLOR0;
+};
+
+PS_INPUT VS( float4 pos    : POSITION,
+             float4 world0 : INSTWORLD0,
+             float4 world1 : INSTWORLD1,
+             float4 world2 : INSTWORLD2,
+             float4 color  : INSTCOLOR0 )
 {                                                             	
-	float4x4 wvp = mul(world,mul(view,proj));
-	float4 posH = mul( pos, wvp );                        
-	return posH;
+    PS_INPUT vout;
+    float4 posL = float4(pos.xyz, 1);
+    float4 posW = float4(dot(posL, world0), dot(posL, world1), dot(posL, world2), 1);
+	vout.posH = mul( posW, mul(view,proj) );
+    vout.color = color;
+	return vout;
 }                                                             
 
-float4 PS( float4 pos : SV_POSITION ) : SV_Target                        
+float4 PS( PS_INPUT psIn ) : SV_Target                        
 {
-   return color;
+   return psIn.color;
 }    
 
 
@@ -9,12 +9,6 @@
     float4x4   proj;
 };
 
-cbuffer ConstantBufferPerDraw : register( b1 )
-{
-    float4x4   world;
-    float4x4   textureTrans;
-    float4      color;
-};
 
 
 //--------------------------------------------------------------------------------------
@@ -26,17 +20,25 @@
 
 //--------------------------------------------------------------------------------------
 // Input / Output structures
+// world, texture transform and color are per instance, see GizmoInstance.
 //--------------------------------------------------------------------------------------
 struct VS_INPUT
 {
     float4 posL                             : POSITION;
     float2 tex0                             : TEXCOORD0;
+    float4 world0                           : INSTWORLD0;
+    float4 world1                           : INSTWORLD1;
+    float4 world2                           : INSTWORLD2;
+    float4 uv0                              : INSTUV0;
+    float4 uv1                              : INSTUV1;
+    float4 color                            : INSTCOLOR0;
 };
 
 struct PS_INPUT
 {
     float4 posH                             : SV_POSITION;
     float2 tex0                             : TEXCOORD0;
+    float4 color                            : COLOR0;
 };
 
 //--------------------------------------------------------------------------------------
@@ -46,19 +48,19 @@ PS_INPUT VSMain( VS_INPUT input )
 {
     PS_INPUT output = (PS_INPUT)0;;
 
-	float4x4 wvp = mul(world,mul(view,proj));
-
-	output.posH  = mul( input.posL, wvp );
+    float4 posL = float4(input.posL.xyz, 1);
+    float4 posW = float4(dot(posL, input.world0), dot(posL, input.world1), dot(posL, input.world2), 1);
+	output.posH  = mul( posW, mul(view,proj) );
 
 	#ifdef FLIP_TEXTURE_Y                                               
-	output.tex0 = float2(input.tex0.x,(1.0-input.tex0.y));                 
+	float3 tex = float3(input.tex0.x,(1.0-input.tex0.y), 1);
 	#else                                                               
-	output.tex0 = input.tex0;                                             
+	float3 tex = float3(input.tex0, 1);
 	#endif 
 
    // transform texture coordinates
-   float4 tex = float4(output.tex0.x, output.tex0.y, 0, 1);
-   output.tex0 = mul(tex, textureTrans).xy;
+   output.tex0 = float2(dot(tex, input.uv0.xyz), dot(tex, input.uv1.xyz));
+   output.color = input.color;
 
    return output;
 }
@@ -71,6 +73,6 @@ PS_INPUT VSMain( VS_INPUT input )
 {
    float4 fc = diffuseTex.Sample( diffuseSampler, input.tex0 );
    clip(fc.a - 0.5);
-   fc.xyz = fc.xyz * color.xyz;
+   fc.xyz = fc.xyz * input.color.xyz;
    return fc;
 }
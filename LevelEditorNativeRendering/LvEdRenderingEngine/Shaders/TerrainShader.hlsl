@@ -53,8 +53,9 @@
 
 cbuffer ShadowMappingCb : register( b4 )
 {
-    matrix              cb_smShadowTransform;
+    matrix              cb_smShadowTransforms[MAX_SHADOW_CASCADES];
     float               cb_smTexelSize; 
+    uint                cb_smCascadeCount;
 };
 
 
@@ -68,7 +69,7 @@
 // Textures
 //--------------------------------------------------------------------------------------
 
-Texture2D         shadowTex   : register(t0);
+Texture2DArray    shadowTex   : register(t0);
 Texture2D<float>  hnTex       : register(t1);
 Texture2D         layers[MaxNumLayers] : register(t2);
 Texture2D<float>  layermasks[MaxNumLayers] : register(t10);
@@ -90,7 +91,6 @@ struct PS_INPUT
     float4 posH         : SV_POSITION;
     float3 posW         : POSITION;    	
     float2 stretchedTex : TEXCOORD0;    
-    float4 texShadow    : TEXCOORD1;
 	
 };
 
@@ -121,12 +121,6 @@ PS_INPUT VSMain( float3 posL : POSITION )
 	output.posH   = mul(float4(posW,1), vp);	
 	output.posW   = posW;	
 	output.stretchedTex = tex;
-    
-	if ( cb_shadowed )
-    {      
-        // Transform the shadow texture coordinates.
-        output.texShadow = mul( float4(posW,1),  cb_smShadowTransform);
-    }
 
     return output;
 }
@@ -182,7 +176,7 @@ PS_INPUT VSMain( float3 posL : POSITION )
 		float ShadowFactor = 1.0;
 		if ( cb_shadowed )
         {
-		  ShadowFactor = ComputeShadowFactor(shadowTex, shadowSamplerCmp, input.texShadow.xyz,cb_smTexelSize);		   
+		  ShadowFactor = ComputeCascadedShadowFactor(shadowTex, shadowSamplerCmp, input.posW, cb_smShadowTransforms, cb_smCascadeCount, cb_smTexelSize);
 		}
 		float3 A,D,S;
 		float specPower = 1;
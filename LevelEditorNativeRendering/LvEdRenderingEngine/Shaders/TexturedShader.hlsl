@@ -47,8 +47,9 @@
 
 cbuffer ConstantBufferShadowMapping : register( b3 )
 {
-    matrix              cb_smShadowTransform;    
+    matrix              cb_smShadowTransforms[MAX_SHADOW_CASCADES];
     float               cb_smTexelSize;     
+    uint                cb_smCascadeCount;
 };
 
 //--------------------------------------------------------------------------------------
@@ -57,7 +58,7 @@
 Texture2D    diffuseTex                     : register( t0 );
 Texture2D    normalTex                      : register( t1 );
 Texture2D    specularTex                    : register( t2 );
-Texture2D    shadowTex                      : register( t3 );
+Texture2DArray shadowTex                    : register( t3 );
 
 SamplerState diffuseSampler                 : register( s0 );
 SamplerComparisonState shadowSamplerCmp     : register( s1 );
@@ -80,7 +81,6 @@ struct PS_INPUT
     float3 normW                            : NORMAL;
     float3 tanW                             : TANGENT;
     float2 tex0                             : TEXCOORD0;
-    float4 texShadow                        : TEXCOORD1;
 };
 
 //--------------------------------------------------------------------------------------
@@ -107,12 +107,6 @@ PS_INPUT VSMain( VS_INPUT input )
     // transform texture coordinates
     output.tex0 = mul(tex, cb_textureTrans).xy;
 
-    if ( cb_shadowed )
-    {      
-        // Transform the shadow texture coordinates.
-        output.texShadow = mul( input.posL, mul(cb_world, cb_smShadowTransform) );
-    }
-
     return output;
 }
 
@@ -159,7 +153,7 @@ PS_INPUT VSMain( VS_INPUT input )
 		float ShadowFactor = 1.0;
 		if ( cb_shadowed )
         {
-		   ShadowFactor = ComputeShadowFactor(shadowTex, shadowSamplerCmp, input.texShadow.xyz,cb_smTexelSize);		   
+		   ShadowFactor = ComputeCascadedShadowFactor(shadowTex, shadowSamplerCmp, input.posW, cb_smShadowTransforms, cb_smCascadeCount, cb_smTexelSize);
 		}
 		float3 A,D,S;
 		float specPower = max(1.0,matspecular.a);
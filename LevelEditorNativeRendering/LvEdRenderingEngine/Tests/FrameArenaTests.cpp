@@ -0,0 +1,100 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    FrameArenaTests.cpp
+
+    FrameVector keeps its elements in order when insert() and erase() move
+    them, also when insert() grows the storage, and a FrameVector from a
+    previous frame acts as an empty one.
+****************************************************************************/
+#include "TestUtils.h"
+#include "../Core/FrameArena.h"
+
+using namespace LvEdEngine;
+
+// the arena for one test.
+class TestArena
+{
+public:
+    TestArena() { FrameArena::InitInstance(64 * 1024); }
+    ~TestArena() { FrameArena::DestroyInstance(); }
+};
+
+static bool Equals(const FrameVector<int>& v, const int* values, size_t count)
+{
+    if(v.size() != count)
+        return false;
+    for(size_t i = 0; i < count; ++i)
+    {
+        if(v[i] != values[i])
+            return false;
+    }
+    return true;
+}
+
+TEST(InsertGrowsAndKeepsTheOrder)
+{
+    TestArena arena;
+    FrameVector<int> v;
+    for(int i = 0; i < 16; ++i)
+        v.push_back(i);
+    const int* before = v.begin();
+
+    // the vector is full, so the insert moves it.
+    const int values[] = { 100, 101, 102 };
+    v.insert(v.begin() + 4, values, values + 3);
+    CHECK(v.begin() != before);
+    const int expected[] = { 0, 1, 2, 3, 100, 101, 102, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+    CHECK(Equals(v, expected, 19));
+
+    v.insert(v.end(), values, values + 1);
+    CHECK(v.size() == 20 && v.back() == 100);
+}
+
+TEST(EraseKeepsTheOrder)
+{
+    TestArena arena;
+    FrameVector<int> v;
+    for(int i = 0; i < 8; ++i)
+        v.push_back(i);
+    FrameVector<int>::iterator next = v.erase(v.begin() + 2, v.begin() + 5);
+    CHECK(*next == 5);
+    const int expected[] = { 0, 1, 5, 6, 7 };
+    CHECK(Equals(v, expected, 5));
+
+    v.erase(v.begin() + 3, v.end());
+    CHECK(Equals(v, expected, 3));
+}
+
+TEST(IteratorsOfAPreviousFrameInsertIntoAnEmptyVector)
+{
+    TestArena arena;
+    FrameVector<int> v;
+    for(int i = 0; i < 8; ++i)
+        v.push_back(i);
+    FrameVector<int>::iterator end = v.end();
+    FrameArena::Inst()->Reset();
+
+    CHECK(v.empty());
+    const int values[] = { 100, 101 };
+    v.insert(end, values, values + 2);
+    CHECK(Equals(v, values, 2));
+}
+
+TEST(IteratorsOfAPreviousFrameEraseNothing)
+{
+    TestArena arena;
+    FrameVector<int> v;
+    for(int i = 0; i < 8; ++i)
+        v.push_back(i);
+    FrameVector<int>::iterator first = v.begin() + 2;
+    FrameVector<int>::iterator last = v.begin() + 4;
+    FrameArena::Inst()->Reset();
+
+    v.erase(first, last);
+    CHECK(v.empty());
+    v.push_back(7);
+    CHECK(v.size() == 1 && v[0] == 7);
+}
+
+TEST_MAIN()
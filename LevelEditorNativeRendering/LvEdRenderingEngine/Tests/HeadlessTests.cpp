@@ -0,0 +1,118 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    HeadlessTests.cpp
+
+    The null device keeps resource contents in CPU memory, the mapped file
+    views used by the loaders, and packing asset archives.
+****************************************************************************/
+#include "TestUtils.h"
+#include <string.h>
+#include <stdio.h>
+#include <string>
+#include "../Core/Utils.h"
+#include "../Core/MappedFile.h"
+#include "../ResourceManager/AssetArchive.h"
+#include "../Renderer/NullDevice.h"
+
+using namespace LvEdEngine;
+
+static std::wstring TempFile(const char* name, const char* contents)
+{
+    std::string path = std::string("/tmp/lved_") + name;
+    FILE* f = fopen(path.c_str(), "wb");
+    fwrite(contents, 1, strlen(contents), f);
+    fclose(f);
+    return std::wstring(path.begin(), path.end());
+}
+
+TEST(NullDeviceKeepsBufferContents)
+{
+    ID3D11Device* device = NULL;
+    ID3D11DeviceContext* dc = NULL;
+    CHECK(SUCCEEDED(CreateNullDevice(&device, &dc)));
+    if(!device)
+        return;
+
+    const uint32_t data[4] = { 1, 2, 3, 4 };
+    D3D11_BUFFER_DESC desc = {};
+    desc.ByteWidth = sizeof(data);
+    desc.Usage = D3D11_USAGE_DEFAULT;
+    desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+    D3D11_SUBRESOURCE_DATA init = { data, 0, 0 };
+    ID3D11Buffer* vb = NULL;
+    CHECK(SUCCEEDED(device->CreateBuffer(&desc, &init, &vb)));
+
+    desc.Usage = D3D11_USAGE_STAGING;
+    desc.BindFlags = 0;
+    desc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+    ID3D11Buffer* staging = NULL;
+    CHECK(SUCCEEDED(device->CreateBuffer(&desc, NULL, &staging)));
+
+    const uint32_t update = 9;
+    D3D11_BOX box = { 4, 0, 0, 8, 1, 1 };
+    dc->UpdateSubresource(vb, 0, &box, &update, 0, 0);
+    dc->CopyResource(staging, vb);
+
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    CHECK(SUCCEEDED(dc->Map(staging, 0, D3D11_MAP_READ, 0, &mapped)));
+    const uint32_t* read = (const uint32_t*)mapped.pData;
+    CHECK(read[0] == 1 && read[1] == 9 && read[2] == 3 && read[3] == 4);
+    dc->Unmap(staging, 0);
+
+    SAFE_RELEASE(staging);
+    SAFE_RELEASE(vb);
+    SAFE_RELEASE(dc);
+    SAFE_RELEASE(device);
+}
+
+TEST(MappedFileReadsAndCopiesOnWrite)
+{
+    const std::wstring path = TempFile("mapped.txt", "<level/>");
+    {
+        MappedFile file;
+        CHECK(file.Open(path.c_str(), MappedFile::ReadOnly, true));
+        CHECK(file.GetSize() == 8);
+        CHECK(memcmp(file.GetData(), "<level/>", 8) == 0);
+        CHECK(file.GetData()[8] == 0);
+    }
+    {
+        MappedFile file;
+        CHECK(file.Open(path.c_str(), MappedFile::CopyOnWrite));
+        file.GetData()[0] = '#';
+    }
+    MappedFile file;
+    CHECK(file.Open(path.c_str()));
+    CHECK(file.GetData()[0] == '<');
+
+    MappedFile missing;
+    CHECK(!missing.Open(L"/tmp/lved_does_not_exist"));
+    CHECK(!missing.IsOpen());
+}
+
+TEST(MappedFileOpensBackslashedPaths)
+{
+    TempFile("backslash.txt", "data");
+    MappedFile file;
+    CHECK(file.Open(L"\\tmp\\lved_backslash.txt"));
+    CHECK(file.GetSize() == 4 && memcmp(file.GetData(), "data", 4) == 0);
+}
+
+TEST(PackSkipsTheArchiveUnderAnyName)
+{
+    CreateDirectoryW(L"/tmp/lved_pack", NULL);
+    TempFile("pack/a.txt", "alpha");
+    TempFile("pack/b.txt", "beta");
+    remove("/tmp/lved_pack/assets.lva");
+    CHECK(AssetArchive::Pack(L"/tmp/lved_pack/", L"/tmp/lved_pack/assets.lva", false) == 2);
+
+    // the archive exists now, the root and the archive are spelled differently.
+    CHECK(AssetArchive::Pack(L"/tmp//lved_pack/./", L"/tmp/lved_pack/../lved_pack/assets.lva", false) == 2);
+    AssetArchive archive;
+    CHECK(archive.Open(L"/tmp/lved_pack/assets.lva"));
+    CHECK(archive.GetEntryCount() == 2);
+    CHECK(archive.Find("a.txt") != NULL);
+    CHECK(archive.Find("assets.lva") == NULL);
+}
+
+TEST_MAIN()
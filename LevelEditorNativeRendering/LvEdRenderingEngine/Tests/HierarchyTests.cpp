@@ -0,0 +1,164 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    HierarchyTests.cpp
+
+    World transforms, bounds and bounds versions are brought up to date
+    through the whole object hierarchy by Update(), and only along the
+    paths that changed.
+****************************************************************************/
+#include "TestUtils.h"
+#include "TestEngine.h"
+#include <math.h>
+#include <vector>
+#include "../GobSystem/GameLevel.h"
+#include "../GobSystem/CubeGob.h"
+
+using namespace LvEdEngine;
+
+static void Update(GameLevel* level)
+{
+    FrameTime ft = { 0, 0 };
+    level->Update(ft, UpdateType::Editing);
+}
+
+static bool Near(float a, float b)
+{
+    return fabsf(a - b) < 1e-3f;
+}
+
+static bool Contains(const AABB& outer, const AABB& inner)
+{
+    return outer.Contain(inner.Min()) && outer.Contain(inner.Max());
+}
+
+TEST(TransformPropagatesDownDeepChain)
+{
+    LvEdTests::TestEngine engine;
+    GameLevel* level = new GameLevel();
+    const int depth = 64;
+    std::vector<GameObjectGroup*> chain;
+    GameObjectGroup* parent = level;
+    for(int i = 0; i < depth; ++i)
+    {
+        GameObjectGroup* group = new GameObjectGroup();
+        group->SetTransform(Matrix::CreateTranslation(1, 0, 0));
+        parent->AddChild(group, -1);
+        chain.push_back(group);
+        parent = group;
+    }
+    CubeGob* leaf = new CubeGob();
+    parent->AddChild(leaf, -1);
+    Update(level);
+
+    CHECK(Near(leaf->GetWorldTransform().M41, (float)depth));
+    CHECK(Near(leaf->GetBounds().GetCenter().x, (float)depth));
+    for(size_t i = 0; i < chain.size(); ++i)
+        CHECK(Contains(chain[i]->GetBounds(), leaf->GetBounds()));
+    CHECK(Contains(level->GetBounds(), leaf->GetBounds()));
+
+    // moving the root moves every descendant and grows every ancestor's version.
+    const uint32_t leafVersion = leaf->GetBoundsVersion();
+    const uint32_t midVersion = chain[depth / 2]->GetBoundsVersion();
+    chain[0]->SetTransform(Matrix::CreateTranslation(1, 10, 0));
+    Update(level);
+    CHECK(Near(leaf->GetWorldTransform().M42, 10.0f));
+    CHECK(Near(leaf->GetBounds().GetCenter().y, 10.0f));
+    CHECK(leaf->GetBoundsVersion() != leafVersion);
+    CHECK(chain[depth / 2]->GetBoundsVersion() != midVersion);
+    for(size_t i = 0; i < chain.size(); ++i)
+        CHECK(Contains(chain[i]->GetBounds(), leaf->GetBounds()));
+    CHECK(Contains(level->GetBounds(), leaf->GetBounds()));
+
+    // moving the leaf dirties its ancestors' bounds, not their transforms.
+    leaf->SetTransform(Matrix::CreateTranslation(0, 0, -20));
+    Update(level);
+    CHECK(Near(leaf->GetBounds().GetCenter().z, -20.0f));
+    CHECK(Near(chain[depth - 1]->GetWorldTransform().M42, 10.0f));
+    for(size_t i = 0; i < chain.size(); ++i)
+        CHECK(Contains(chain[i]->GetBounds(), leaf->GetBounds()));
+    delete level;
+}
+
+TEST(OnlyChangedPathsGetNewVersions)
+{
+    LvEdTests::TestEngine engine;
+    GameLevel* level = new GameLevel();
+    GameObjectGroup* a = new GameObjectGroup();
+    GameObjectGroup* b = new GameObjectGroup();
+    CubeGob* cubeA = new CubeGob();
+    CubeGob* cubeB = new CubeGob();
+    level->AddChild(a, -1);
+    level->AddChild(b, -1);
+    a->AddChild(cubeA, -1);
+    b->AddChild(cubeB, -1);
+    Update(level);
+
+    // nothing changed: nothing is recomputed.
+    const uint32_t versions[] = { level->GetBoundsVersion(), a->GetBoundsVersion(), b->GetBoundsVersion(),
+                                  cubeA->GetBoundsVersion(), cubeB->GetBoundsVersion() };
+    Update(level);
+    CHECK(level->GetBoundsVersion() == versions[0]);
+    CHECK(a->GetBoundsVersion() == versions[1]);
+    CHECK(b->GetBoundsVersion() == versions[2]);
+    CHECK(cubeA->GetBoundsVersion() == versions[3]);
+    CHECK(cubeB->GetBoundsVersion() == versions[4]);
+
+    cubeA->SetTransform(Matrix::CreateTranslation(5, 0, 0));
+    Update(level);
+    CHECK(cubeA->GetBoundsVersion() != versions[3]);
+    CHECK(a->GetBoundsVersion() != versions[1]);
+    CHECK(level->GetBoundsVersion() != versions[0]);
+    CHECK(b->GetBoundsVersion() == versions[2]);
+    CHECK(cubeB->GetBoundsVersion() == versions[4]);
+    delete level;
+}
+
+TEST(ReparentingUpdatesTheObjectAndBothParents)
+{
+    LvEdTests::TestEngine engine;
+    GameLevel* level = new GameLevel();
+    GameObjectGroup* a = new GameObjectGroup();
+    GameObjectGroup* b = new GameObjectGroup();
+    a->SetTransform(Matrix::CreateTranslation(100, 0, 0));
+    b->SetTransform(Matrix::CreateTranslation(-100, 0, 0));
+    CubeGob* stay = new CubeGob();
+    CubeGob* moved = new CubeGob();
+    CubeGob* other = new CubeGob();
+    level->AddChild(a, -1);
+    level->AddChild(b, -1);
+    a->AddChild(stay, -1);
+    a->AddChild(moved, -1);
+    b->AddChild(other, -1);
+    Update(level);
+    CHECK(Near(moved->GetBounds().GetCenter().x, 100.0f));
+    CHECK(Contains(a->GetBounds(), moved->GetBounds()));
+
+    const uint32_t movedVersion = moved->GetBoundsVersion();
+    const uint32_t aVersion = a->GetBoundsVersion();
+    const uint32_t bVersion = b->GetBoundsVersion();
+    const uint32_t stayVersion = stay->GetBoundsVersion();
+    a->RemoveChild(moved);
+    b->AddChild(moved, -1);
+    Update(level);
+
+    CHECK(Near(moved->GetWorldTransform().M41, -100.0f));
+    CHECK(Near(moved->GetBounds().GetCenter().x, -100.0f));
+    CHECK(moved->GetBoundsVersion() != movedVersion);
+    CHECK(a->GetBoundsVersion() != aVersion);
+    CHECK(b->GetBoundsVersion() != bVersion);
+    CHECK(stay->GetBoundsVersion() == stayVersion);
+    CHECK(Contains(b->GetBounds(), moved->GetBounds()));
+    CHECK(!a->GetBounds().Contain(moved->GetBounds().GetCenter()));
+    CHECK(Contains(level->GetBounds(), moved->GetBounds()));
+
+    // moving the new parent carries the reparented object along.
+    b->SetTransform(Matrix::CreateTranslation(-100, 0, 50));
+    Update(level);
+    CHECK(Near(moved->GetBounds().GetCenter().z, 50.0f));
+    CHECK(Near(other->GetBounds().GetCenter().z, 50.0f));
+    CHECK(stay->GetBoundsVersion() == stayVersion);
+    delete level;
+}
+
+TEST_MAIN()
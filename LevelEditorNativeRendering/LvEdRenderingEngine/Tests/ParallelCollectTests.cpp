@@ -0,0 +1,117 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    ParallelCollectTests.cpp
+
+    GameLevel::GetRenderablesParallel() gives the same buckets, in the same
+    order, as the serial GetRenderables() for any number of workers.
+****************************************************************************/
+#include "TestUtils.h"
+#include "TestEngine.h"
+#include <vector>
+#include "../Core/TaskPool.h"
+#include "../GobSystem/GameLevel.h"
+#include "../GobSystem/CubeGob.h"
+#include "../GobSystem/SphereGob.h"
+#include "../Renderer/RenderableNodeSorter.h"
+
+using namespace LvEdEngine;
+
+// what identifies a collected node and the bucket it went to.
+struct CollectedNode
+{
+    uint32_t    bucket;
+    uint32_t    renderFlags;
+    uint32_t    shaderId;
+    ObjectGUID  objectId;
+    uint32_t    flags;
+
+    bool operator==(const CollectedNode& n) const
+    {
+        return bucket == n.bucket && renderFlags == n.renderFlags && shaderId == n.shaderId
+            && objectId == n.objectId && flags == n.flags;
+    }
+};
+
+static std::vector<CollectedNode> Flatten(RenderableNodeSorter& sorter)
+{
+    std::vector<CollectedNode> nodes;
+    for(uint32_t b = 0; b < sorter.GetBucketCount(); ++b)
+    {
+        RenderableNodeSorter::Bucket* bucket = sorter.GetBucket(b);
+        for(auto it = bucket->renderables.begin(); it != bucket->renderables.end(); ++it)
+        {
+            CollectedNode n = { b, (uint32_t)bucket->renderFlags, (uint32_t)bucket->shaderId, it->objectId, it->flags };
+            nodes.push_back(n);
+        }
+    }
+    return nodes;
+}
+
+// top level cubes and spheres mixed with groups of several depths,
+// some of them translucent and some out of view.
+static void BuildLevel(GameLevel* level)
+{
+    int index = 0;
+    for(int g = 0; g < 24; ++g)
+    {
+        GameObjectGroup* parent = level;
+        for(int depth = 0; depth < g % 4; ++depth)
+        {
+            GameObjectGroup* group = new GameObjectGroup();
+            parent->AddChild(group, -1);
+            parent = group;
+        }
+        for(int i = 0; i < 10; ++i, ++index)
+        {
+            PrimitiveShapeGob* shape = (index % 3) ? (PrimitiveShapeGob*)new CubeGob() : (PrimitiveShapeGob*)new SphereGob();
+            shape->SetColor((index % 5) ? 0xFF808080 : 0x40808080);
+            const float x = (float)(g - 12) * 6.0f + (g % 6 == 5 ? 5000.0f : 0.0f);
+            shape->SetTransform(Matrix::CreateTranslation(x, (float)i * 3.0f, 0.0f));
+            parent->AddChild(shape, -1);
+        }
+    }
+    FrameTime ft = { 0, 0 };
+    level->Update(ft, UpdateType::Editing);
+}
+
+static std::vector<CollectedNode> Collect(GameLevel* level, TaskPool* pool)
+{
+    RenderableNodeSorter sorter;
+    sorter.SetFlags((GlobalRenderFlagsEnum)(GlobalRenderFlags::Solid | GlobalRenderFlags::Textured
+        | GlobalRenderFlags::Lit | GlobalRenderFlags::WireFrame));
+    if(pool)
+        level->GetRenderablesParallel(&sorter, RenderContext::Inst(), pool);
+    else
+        level->GetRenderables(&sorter, RenderContext::Inst());
+    std::vector<CollectedNode> nodes = Flatten(sorter);
+    FrameArena::Inst()->Reset();
+    return nodes;
+}
+
+TEST(ParallelCollectMatchesSerialForAnyWorkerCount)
+{
+    LvEdTests::TestEngine engine;
+    GameLevel* level = new GameLevel();
+    BuildLevel(level);
+
+    const std::vector<CollectedNode> serial = Collect(level, NULL);
+    CHECK(!serial.empty());
+    CHECK(serial.size() < 240); // the far groups are culled.
+
+    const uint32_t workerCounts[] = { 0, 1, 3, 7 };
+    for(uint32_t i = 0; i < ARRAY_SIZE(workerCounts); ++i)
+    {
+        TaskPool pool(workerCounts[i]);
+        // repeated, so that different threads pick up the subtrees.
+        for(int run = 0; run < 4; ++run)
+        {
+            const std::vector<CollectedNode> parallel = Collect(level, &pool);
+            CHECK(parallel.size() == serial.size());
+            CHECK(parallel == serial);
+        }
+    }
+    delete level;
+}
+
+TEST_MAIN()
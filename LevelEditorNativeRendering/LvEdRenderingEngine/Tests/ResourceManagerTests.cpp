@@ -0,0 +1,133 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    ResourceManagerTests.cpp
+
+    Loading real files through the ResourceManager: different spellings of
+    a path share one resource, while the file is opened as spelled, since
+    the case matters on a POSIX file system.
+****************************************************************************/
+#include "TestUtils.h"
+#include <string.h>
+#include <stdio.h>
+#include <string>
+#include "../Core/Utils.h"
+#include "../Core/FileUtils.h"
+#include "../Renderer/Resource.h"
+#include "../ResourceManager/ResourceManager.h"
+
+using namespace LvEdEngine;
+
+// the contents of a text file.
+class TextResource : public Resource
+{
+public:
+    virtual ResourceTypeEnum GetType() { return ResourceType::Unknown; }
+    std::string text;
+};
+
+class TextFactory : public ResourceFactory
+{
+public:
+    virtual Resource* CreateResource(Resource* /*def*/) { return new TextResource(); }
+
+    virtual bool LoadResource(Resource* resource, const WCHAR* name)
+    {
+        UINT size = 0;
+        BYTE* data = FileUtils::LoadFile(name, &size);
+        if(!data)
+            return false;
+        ((TextResource*)resource)->text.assign((const char*)data, size);
+        SAFE_DELETE_ARRAY(data);
+        return true;
+    }
+
+    virtual bool ReadResource(const WCHAR* name, ResourceData* data)
+    {
+        return data->Map(name);
+    }
+
+    virtual bool ProcessResource(Resource* resource, const WCHAR* /*name*/, const ResourceData& data)
+    {
+        ((TextResource*)resource)->text.assign((const char*)data.bytes, data.size);
+        return true;
+    }
+};
+
+static void TempFile(const char* path, const char* contents)
+{
+    FILE* f = fopen(path, "wb");
+    fwrite(contents, 1, strlen(contents), f);
+    fclose(f);
+}
+
+static const char* Text(Resource* res)
+{
+    return res ? ((TextResource*)res)->text.c_str() : "";
+}
+
+// a manager with the .txt factory for each test.
+struct TestManager
+{
+    TestManager()
+    {
+        CreateDirectoryW(L"/tmp/lved_Probe", NULL);
+        CreateDirectoryW(L"/tmp/lved_Probe/Data", NULL);
+        TempFile("/tmp/lved_Probe/Data/Tex.txt", "texel");
+        TempFile("/tmp/lved_Probe/Data/Async.txt", "async");
+        ResourceManager::InitInstance();
+        ResourceManager::Inst()->RegisterFactory(L".txt", new TextFactory());
+    }
+    ~TestManager()
+    {
+        ResourceManager::DestroyInstance();
+    }
+};
+
+TEST(LoadImmediateOpensMixedCasePaths)
+{
+    TestManager test;
+    Resource* res = ResourceManager::Inst()->LoadImmediate(L"/tmp/lved_Probe/Data/Tex.txt", NULL);
+    CHECK(res != NULL);
+    CHECK(strcmp(Text(res), "texel") == 0);
+}
+
+TEST(LoadAsyncOpensMixedCasePaths)
+{
+    TestManager test;
+    ResourceManager* mgr = ResourceManager::Inst();
+    Resource* res = mgr->LoadAsync(L"/tmp/lved_Probe/Data/Async.txt", NULL);
+    CHECK(mgr->Wait(res, 10000));
+    CHECK(res->IsReady());
+    CHECK(strcmp(Text(res), "async") == 0);
+    res->Release();
+}
+
+TEST(SpellingsOfAPathShareOneResource)
+{
+    TestManager test;
+    ResourceManager* mgr = ResourceManager::Inst();
+    Resource* res = mgr->LoadAsync(L"/tmp/lved_Probe/Data/Tex.txt", NULL);
+    Resource* dotted = mgr->LoadAsync(L"/tmp/lved_Probe/Data/../Data/./Tex.txt", NULL);
+    Resource* backslashed = mgr->LoadAsync(L"\\tmp\\lved_Probe\\Data\\Tex.txt", NULL);
+    CHECK(dotted == res && backslashed == res);
+    CHECK(mgr->Wait(res, 10000));
+    CHECK(res->IsReady());
+    CHECK(strcmp(Text(res), "texel") == 0);
+    CHECK(mgr->LoadImmediate(L"/tmp/lved_Probe/Data//Tex.txt", NULL) == res);
+
+#ifndef _WIN32
+    // another file on a case sensitive file system.
+    TempFile("/tmp/lved_Probe/Data/tex.txt", "lower");
+    Resource* lower = mgr->LoadAsync(L"/tmp/lved_Probe/Data/tex.txt", NULL);
+    CHECK(lower != res);
+    CHECK(mgr->Wait(lower, 10000));
+    CHECK(strcmp(Text(lower), "lower") == 0);
+    lower->Release();
+#endif
+    res->Release();
+    dotted->Release();
+    backslashed->Release();
+}
+
+TEST_MAIN()
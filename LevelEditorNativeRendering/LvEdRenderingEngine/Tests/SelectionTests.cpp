@@ -0,0 +1,81 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    SelectionTests.cpp
+
+    Selection::Set() takes ids from the editor, it only selects the ids of
+    live objects and never dereferences the others. Nodes are tested with
+    the id and object index they were collected with.
+****************************************************************************/
+#include "TestUtils.h"
+#include "../Core/Object.h"
+#include "../Renderer/Selection.h"
+
+using namespace LvEdEngine;
+
+class TestObject : public Object
+{
+public:
+    const char* ClassName() const { return "TestObject"; }
+};
+
+TEST(SelectsLiveObjects)
+{
+    TestObject a, b, c;
+    ObjectGUID ids[] = { c.GetInstanceId(), a.GetInstanceId(), c.GetInstanceId(), 0 };
+    Selection selection;
+    selection.Set(ids, 4);
+    CHECK(selection.Count() == 2);
+    CHECK(selection.IsSelected(&a));
+    CHECK(!selection.IsSelected(&b));
+    CHECK(selection.IsSelected(c.GetInstanceId(), c.GetObjectIndex()));
+    CHECK(!selection.IsSelected(b.GetInstanceId(), b.GetObjectIndex()));
+    CHECK(!selection.IsSelected((ObjectGUID)0, 0));
+
+    selection.Clear();
+    CHECK(selection.Count() == 0);
+    CHECK(!selection.IsSelected(&a));
+    CHECK(!selection.IsSelected(c.GetInstanceId(), c.GetObjectIndex()));
+}
+
+TEST(NodesOfAnotherObjectWithTheSameIndexArentSelected)
+{
+    TestObject a;
+    ObjectGUID id = a.GetInstanceId();
+    Selection selection;
+    selection.Set(&id, 1);
+    CHECK(selection.IsSelected(id, a.GetObjectIndex()));
+    // a node collected from an object that had the index before.
+    CHECK(!selection.IsSelected(id + 16, a.GetObjectIndex()));
+    CHECK(!selection.IsSelected(id, a.GetObjectIndex() + 1));
+}
+
+TEST(IgnoresIdsThatArentLiveObjects)
+{
+    TestObject a;
+    ObjectGUID destroyed;
+    uint32_t destroyedIndex;
+    {
+        TestObject gone;
+        destroyed = gone.GetInstanceId();
+        destroyedIndex = gone.GetObjectIndex();
+        std::vector<ObjectGUID> ids(1, destroyed);
+        std::vector<Object::LiveId> live;
+        Object::FindLive(ids, &live);
+        CHECK(live.size() == 1 && live[0].id == destroyed && live[0].index == destroyedIndex);
+    }
+    std::vector<ObjectGUID> ids(1, destroyed);
+    std::vector<Object::LiveId> live;
+    Object::FindLive(ids, &live);
+    CHECK(live.empty());
+
+    // neither a destroyed object nor garbage is dereferenced.
+    ObjectGUID editorIds[] = { destroyed, 0x10, ~(ObjectGUID)0, a.GetInstanceId() };
+    Selection selection;
+    selection.Set(editorIds, 4);
+    CHECK(selection.Count() == 1);
+    CHECK(selection.IsSelected(&a));
+    CHECK(!selection.IsSelected(destroyed, destroyedIndex));
+}
+
+TEST_MAIN()
@@ -0,0 +1,176 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    ShaderCacheTests.cpp
+
+    ShaderCache only compiles a shader when neither the memory nor the
+    cache directory has it for the same source, includes, entry point,
+    target, macros and compiler version.
+****************************************************************************/
+#include "TestUtils.h"
+#include "TestShaders.h"
+#include <string.h>
+#include <stdio.h>
+#include <string>
+#include <dirent.h>
+#include "../Renderer/ShaderCache.h"
+
+using namespace LvEdEngine;
+
+static const wchar_t* CacheDir = L"/tmp/lved_shaders/";
+
+// an empty cache directory.
+static void ClearCacheDir()
+{
+    CreateDirectoryW(L"/tmp/lved_shaders", NULL);
+    DIR* dir = opendir("/tmp/lved_shaders");
+    if(!dir)
+        return;
+    while(dirent* ent = readdir(dir))
+    {
+        if(strstr(ent->d_name, ".lvshader"))
+            remove((std::string("/tmp/lved_shaders/") + ent->d_name).c_str());
+    }
+    closedir(dir);
+}
+
+// the cache singleton on a stub compiler, which it owns.
+class TestCache
+{
+public:
+    TestCache(const wchar_t* dir, hash64_t version = 1)
+    {
+        compiler = new LvEdTests::StubShaderCompiler(version);
+        ShaderCache::InitInstance(compiler, dir);
+    }
+    ~TestCache() { ShaderCache::DestroyInstance(); }
+
+    bool Get(const ShaderCache::ShaderDesc& desc, std::string* code = NULL)
+    {
+        std::vector<uint8_t> bytes;
+        bool ok = ShaderCache::Inst()->Get(desc, &bytes);
+        if(code)
+            code->assign(bytes.begin(), bytes.end());
+        return ok;
+    }
+
+    void Stats(uint32_t* memoryHits, uint32_t* diskHits, uint32_t* compiled)
+    {
+        ShaderCache::Inst()->GetStats(memoryHits, diskHits, compiled);
+    }
+
+    LvEdTests::StubShaderCompiler* compiler;
+};
+
+static const ShaderCache::ShaderDesc TestVS = { "Test.hlsl", "VS", "vs_4_0", NULL };
+static const ShaderCache::ShaderDesc TestPS = { "Test.hlsl", "PS", "ps_4_0", NULL };
+
+TEST(CompilesOnceThenHitsInMemory)
+{
+    TestCache cache(L"");
+    std::string code;
+    CHECK(cache.Get(TestVS, &code));
+    CHECK(code == "Test.hlsl:VS:vs_4_0");
+    CHECK(cache.Get(TestVS, &code));
+    CHECK(code == "Test.hlsl:VS:vs_4_0");
+    CHECK(cache.compiler->compileCount == 1);
+
+    // another entry point is another shader.
+    CHECK(cache.Get(TestPS, &code));
+    CHECK(code == "Test.hlsl:PS:ps_4_0");
+    CHECK(cache.compiler->compileCount == 2);
+
+    uint32_t memoryHits, diskHits, compiled;
+    cache.Stats(&memoryHits, &diskHits, &compiled);
+    CHECK(memoryHits == 1 && diskHits == 0 && compiled == 2);
+}
+
+TEST(SourceAndMacrosChangeTheKey)
+{
+    TestCache cache(L"");
+    CHECK(cache.Get(TestVS));
+    cache.compiler->sources["Test.hlsl"] = "// edited";
+    CHECK(cache.Get(TestVS));
+    CHECK(cache.compiler->compileCount == 2);
+
+    D3D_SHADER_MACRO macros[] = { { "SHADOWS", "1" }, { NULL, NULL } };
+    ShaderCache::ShaderDesc withMacros = TestVS;
+    withMacros.macros = macros;
+    CHECK(cache.Get(withMacros));
+    CHECK(cache.compiler->compileCount == 3);
+    macros[0].Definition = "0";
+    CHECK(cache.Get(withMacros));
+    CHECK(cache.compiler->compileCount == 4);
+}
+
+TEST(FailuresAreKept)
+{
+    TestCache cache(L"");
+    cache.compiler->failCompile = true;
+    CHECK(!cache.Get(TestVS));
+    CHECK(!cache.Get(TestVS));
+    CHECK(cache.compiler->compileCount == 1);
+
+    cache.compiler->missing.insert("Missing.hlsl");
+    ShaderCache::ShaderDesc missing = { "Missing.hlsl", "VS", "vs_4_0", NULL };
+    CHECK(!cache.Get(missing));
+    CHECK(cache.compiler->compileCount == 1);
+}
+
+TEST(DiskHitsAcrossInstances)
+{
+    ClearCacheDir();
+    {
+        TestCache cache(CacheDir);
+        CHECK(cache.Get(TestVS));
+        CHECK(cache.compiler->compileCount == 1);
+    }
+    TestCache cache(CacheDir);
+    std::string code;
+    CHECK(cache.Get(TestVS, &code));
+    CHECK(code == "Test.hlsl:VS:vs_4_0");
+    CHECK(cache.compiler->compileCount == 0);
+    uint32_t memoryHits, diskHits, compiled;
+    cache.Stats(&memoryHits, &diskHits, &compiled);
+    CHECK(memoryHits == 0 && diskHits == 1 && compiled == 0);
+}
+
+TEST(CompilerVersionInvalidates)
+{
+    ClearCacheDir();
+    {
+        TestCache cache(CacheDir, 1);
+        CHECK(cache.Get(TestVS));
+    }
+    {
+        TestCache cache(CacheDir, 2);
+        CHECK(cache.Get(TestVS));
+        CHECK(cache.compiler->compileCount == 1);
+    }
+    // both versions are on the disk now.
+    TestCache cache(CacheDir, 1);
+    CHECK(cache.Get(TestVS));
+    CHECK(cache.compiler->compileCount == 0);
+}
+
+TEST(ChangedIncludeInvalidates)
+{
+    ClearCacheDir();
+    {
+        TestCache cache(CacheDir);
+        cache.compiler->includeNames.push_back("Common.hlsli");
+        CHECK(cache.Get(TestVS));
+    }
+    {
+        // same include, from the disk.
+        TestCache cache(CacheDir);
+        CHECK(cache.Get(TestVS));
+        CHECK(cache.compiler->compileCount == 0);
+    }
+    TestCache cache(CacheDir);
+    cache.compiler->sources["Common.hlsli"] = "// edited";
+    CHECK(cache.Get(TestVS));
+    CHECK(cache.compiler->compileCount == 1);
+}
+
+TEST_MAIN()
@@ -0,0 +1,198 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    ShadowCascadeTests.cpp
+
+    Cascade splits and fitting, and the per-cascade caster lists built by
+    ShadowCasterCollector. CPU only, no device needed.
+****************************************************************************/
+#include "TestUtils.h"
+#include <math.h>
+#include "../Renderer/ShadowCascades.h"
+#include "../Renderer/ShadowCasterCollector.h"
+#include "../Renderer/Model.h"
+
+using namespace LvEdEngine;
+
+static const float NearZ = 1.0f;
+static const float FarZ = 1000.0f;
+
+// same camera as the test engine: looking at the origin from above and behind.
+static Matrix CameraView()
+{
+    return Matrix::CreateLookAtRH(float3(0, 40, 120), float3(0, 0, 0), float3(0, 1, 0));
+}
+
+static Matrix CameraProj()
+{
+    return Matrix::CreatePerspectiveFieldOfView(1.0f, 1024.0f / 768.0f, NearZ, FarZ);
+}
+
+// ground with a tower standing on it, the top of the tower is out of view.
+static AABB SceneBounds()
+{
+    return AABB(float3(-300, -1, -300), float3(300, 260, 300));
+}
+
+static AABB Box(const float3& center, float halfSize)
+{
+    return AABB(center - float3(halfSize, halfSize, halfSize), center + float3(halfSize, halfSize, halfSize));
+}
+
+static bool Near(float a, float b)
+{
+    return fabsf(a - b) <= 1e-3f * maximize(1.0f, fabsf(b));
+}
+
+TEST(SplitsAreMonotonicAndBlendUniformWithLog)
+{
+    for(uint32_t count = 1; count <= MaxShadowCascades; ++count)
+    {
+        for(int l = 0; l <= 4; ++l)
+        {
+            float splits[MaxShadowCascades + 1];
+            ShadowCascades::ComputeSplits(NearZ, FarZ, count, l / 4.0f, splits);
+            CHECK(splits[0] == NearZ);
+            CHECK(splits[count] == FarZ);
+            for(uint32_t i = 0; i < count; ++i)
+                CHECK(splits[i] < splits[i + 1]);
+        }
+    }
+
+    float uni[5], lg[5];
+    ShadowCascades::ComputeSplits(10, 410, 4, 0.0f, uni);
+    ShadowCascades::ComputeSplits(1, 10000, 4, 1.0f, lg);
+    for(int i = 0; i <= 4; ++i)
+    {
+        CHECK(Near(uni[i], 10.0f + 100.0f * i));
+        CHECK(Near(lg[i], powf(10.0f, (float)i)));
+    }
+
+    // a zero near plane still gives valid logarithmic splits.
+    float splits[3];
+    ShadowCascades::ComputeSplits(0, 100, 2, 1.0f, splits);
+    CHECK(splits[0] > 0 && splits[0] < splits[1] && splits[1] < splits[2]);
+}
+
+TEST(CascadesCoverTheVisiblePartOfTheScene)
+{
+    ShadowCascades cascades;
+    const Matrix view = CameraView();
+    cascades.Update(view, CameraProj(), float3(0.2f, -1.0f, 0.1f), SceneBounds(), 4, 1024);
+    CHECK(cascades.GetCount() == 4);
+
+    // contiguous depth ranges, clipped to the scene.
+    CHECK(cascades.GetCascade(0).splitNear >= NearZ);
+    CHECK(cascades.GetCascade(3).splitFar <= FarZ);
+    for(uint32_t c = 0; c + 1 < cascades.GetCount(); ++c)
+        CHECK(cascades.GetCascade(c).splitFar == cascades.GetCascade(c + 1).splitNear);
+
+    // every visible point of the ground falls into the cascade of its depth.
+    int tested = 0;
+    for(float x = -60; x <= 60; x += 20)
+    {
+        for(float z = -280; z <= 100; z += 20)
+        {
+            float3 p(x, 0, z);
+            float depth = -float3::Transform(p, view).z;
+            for(uint32_t c = 0; c < cascades.GetCount(); ++c)
+            {
+                const ShadowCascade& cascade = cascades.GetCascade(c);
+                if(depth >= cascade.splitNear && depth <= cascade.splitFar)
+                {
+                    CHECK((cascades.GetCasterMask(Box(p, 0.1f)) & (1 << c)) != 0);
+                    ++tested;
+                }
+            }
+        }
+    }
+    CHECK(tested > 0);
+
+    // the camera target is covered.
+    CHECK(cascades.GetCasterMask(Box(float3(0, 0, 0), 0.1f)) != 0);
+
+    // an empty scene, or one entirely behind the camera, has nothing to shadow.
+    cascades.Update(view, CameraProj(), float3(0, -1, 0), AABB(), 4, 1024);
+    CHECK(cascades.GetCount() == 0);
+    CHECK(cascades.GetCasterMask(SceneBounds()) == 0);
+    cascades.Update(view, CameraProj(), float3(0, -1, 0), Box(float3(0, 40, 400), 10), 4, 1024);
+    CHECK(cascades.GetCount() == 0);
+}
+
+TEST(CastersOutOfViewShadowTheVisibleCascades)
+{
+    ShadowCascades cascades;
+    cascades.Update(CameraView(), CameraProj(), float3(0.1f, -1.0f, 0.1f), SceneBounds(), 3, 1024);
+    CHECK(cascades.GetCount() == 3);
+
+    // the top of the tower is above the view but between the light and the ground.
+    CHECK(cascades.GetCasterMask(Box(float3(-20, 250, -20), 5)) != 0);
+    // far to the side of the light's view of the frustum: casts into nothing.
+    CHECK(cascades.GetCasterMask(Box(float3(5000, 0, 5000), 5)) == 0);
+    CHECK(cascades.GetCasterMask(Box(float3(-5000, 100, 0), 5)) == 0);
+}
+
+TEST(CollectorSortsCastersIntoCascades)
+{
+    ShadowCascades cascades;
+    cascades.Update(CameraView(), CameraProj(), float3(0.1f, -1.0f, 0.1f), SceneBounds(), 4, 1024);
+    CHECK(cascades.GetCount() == 4);
+
+    Mesh triangles;
+    Mesh lines;
+    lines.primitiveType = PrimitiveType::LineList;
+
+    ShadowCasterCollector collector;
+    collector.SetFlags(GlobalRenderFlags::Solid);
+
+    RenderableNode near;
+    near.mesh = &triangles;
+    near.bounds = Box(float3(0, 0, 0), 1);
+    near.objectId = 1;
+    RenderableNode tower = near;
+    tower.bounds = Box(float3(-20, 250, -20), 5);
+    tower.objectId = 2;
+    RenderableNode away = near;
+    away.bounds = Box(float3(5000, 0, 5000), 1);
+    away.objectId = 3;
+    RenderableNode noCast = near;
+    noCast.SetFlag(RenderableNode::kShadowCaster, false);
+    RenderableNode wire = near;
+    wire.mesh = &lines;
+
+    collector.Add(near, RenderFlags::None, Shaders::TexturedShader);
+    collector.Add(tower, RenderFlags::None, Shaders::TexturedShader);
+    collector.Add(away, RenderFlags::None, Shaders::TexturedShader);
+    collector.Add(noCast, RenderFlags::None, Shaders::TexturedShader);
+    collector.Add(wire, RenderFlags::None, Shaders::TexturedShader);
+    collector.Add(near, RenderFlags::None, Shaders::BasicShader);
+    CHECK(collector.GetCandidates().size() == 3);
+
+    collector.CullCasters(cascades);
+    bool nearFound = false, towerFound = false;
+    for(uint32_t c = 0; c < MaxShadowCascades; ++c)
+    {
+        const std::vector<uint32_t>& casters = collector.GetCasters(c);
+        if(c >= cascades.GetCount())
+            CHECK(casters.empty());
+        for(size_t i = 0; i < casters.size(); ++i)
+        {
+            const RenderableNode& r = collector.GetCandidates()[casters[i]];
+            CHECK((cascades.GetCasterMask(r.bounds) & (1 << c)) != 0);
+            CHECK(r.objectId != 3);
+            nearFound |= r.objectId == 1;
+            towerFound |= r.objectId == 2;
+        }
+    }
+    CHECK(nearFound);
+    CHECK(towerFound);
+
+    // nothing is collected when solid rendering is off.
+    collector.ClearLists();
+    CHECK(collector.GetCandidates().empty());
+    collector.SetFlags(GlobalRenderFlags::WireFrame);
+    collector.Add(near, RenderFlags::None, Shaders::TexturedShader);
+    CHECK(collector.GetCandidates().empty());
+}
+
+TEST_MAIN()
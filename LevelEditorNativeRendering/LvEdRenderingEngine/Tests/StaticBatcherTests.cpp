@@ -0,0 +1,161 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    StaticBatcherTests.cpp
+
+    StaticBatcher::Apply() only merges members that were collected with the
+    same material and the same lights, and draws them with those lights.
+****************************************************************************/
+#include "TestUtils.h"
+#include "TestEngine.h"
+#include <vector>
+#include "../Renderer/Model.h"
+#include "../Renderer/StaticBatcher.h"
+#include "../Renderer/RenderableNodeSorter.h"
+
+using namespace LvEdEngine;
+
+static const uint32_t NodeCount = 4;
+
+static void MakeTriangle(Mesh& mesh, ID3D11Device* device)
+{
+    mesh.pos.push_back(float3(0, 0, 0));
+    mesh.pos.push_back(float3(1, 0, 0));
+    mesh.pos.push_back(float3(0, 1, 0));
+    for(int i = 0; i < 3; ++i)
+    {
+        mesh.nor.push_back(float3(0, 0, 1));
+        mesh.tex.push_back(float2(0, 0));
+        mesh.indices.push_back(i);
+    }
+    mesh.ComputeBound();
+    mesh.Construct(device);
+}
+
+static std::vector<RenderableNode> MakeNodes(Mesh* mesh)
+{
+    std::vector<RenderableNode> nodes(NodeCount);
+    for(uint32_t i = 0; i < NodeCount; ++i)
+    {
+        RenderableNode& r = nodes[i];
+        r.mesh = mesh;
+        r.objectId = 100 + i;
+        r.WorldXform = Matrix::CreateTranslation(2.0f * i, 0, 0);
+        r.bounds = mesh->bounds;
+        r.bounds.Transform(r.WorldXform);
+        r.lighting = LightEnvironment();
+        r.lighting.numDirLights = 1;
+        r.lighting.dir[0].dir = float3(0, -1, 0);
+        r.lighting.dir[0].diffuse = float3(1, 1, 1);
+    }
+    return nodes;
+}
+
+static RenderableNodeSorter::Bucket* Collect(RenderableNodeSorter& sorter, StaticBatcher& batcher,
+                                             std::vector<RenderableNode>& nodes)
+{
+    sorter.ClearLists();
+    FrameArena::Inst()->Reset();
+    sorter.SetFlags(GlobalRenderFlags::Solid);
+    sorter.Add(nodes.begin(), nodes.end(), RenderFlags::Textured, Shaders::TexturedShader);
+    batcher.Apply(&sorter);
+    CHECK(sorter.GetBucketCount() == 1);
+    return sorter.GetBucket(0);
+}
+
+TEST(MembersWithDifferentLightsAreDrawnApart)
+{
+    LvEdTests::TestEngine engine;
+    Mesh mesh;
+    MakeTriangle(mesh, engine.device);
+    std::vector<RenderableNode> nodes = MakeNodes(&mesh);
+
+    StaticBatcher batcher;
+    batcher.Add(nodes.begin(), nodes.end(), RenderFlags::Textured, Shaders::TexturedShader);
+    CHECK(batcher.Build(engine.device, 100.0f) == 1);
+    RenderableNodeSorter sorter;
+
+    // all lit alike: a single draw of every member.
+    RenderableNodeSorter::Bucket* bucket = Collect(sorter, batcher, nodes);
+    CHECK(bucket->renderables.size() == 1);
+    CHECK(bucket->renderables[0].indexCount == 3 * NodeCount);
+    CHECK(bucket->renderables[0].lighting.numPointLights == 0);
+
+    // a point light reaches the last two: they are drawn with it, the first two without.
+    for(uint32_t i = 2; i < NodeCount; ++i)
+    {
+        nodes[i].lighting.numPointLights = 1;
+        nodes[i].lighting.point[0].position = float4(6, 0, 0, 3);
+    }
+    bucket = Collect(sorter, batcher, nodes);
+    CHECK(bucket->renderables.size() == 2);
+    uint32_t lit = 0, total = 0;
+    for(size_t i = 0; i < bucket->renderables.size(); ++i)
+    {
+        const RenderableNode& r = bucket->renderables[i];
+        CHECK(r.mesh != &mesh);
+        CHECK(r.indexCount == 6);
+        total += r.indexCount;
+        if(r.lighting.numPointLights == 1)
+        {
+            CHECK(r.bounds.Min().x >= 4.0f);
+            ++lit;
+        }
+        else
+        {
+            CHECK(r.bounds.Max().x <= 3.0f);
+        }
+    }
+    CHECK(lit == 1);
+    CHECK(total == 3 * NodeCount);
+}
+
+TEST(EditedMaterialsAreNotBatched)
+{
+    LvEdTests::TestEngine engine;
+    Mesh mesh;
+    MakeTriangle(mesh, engine.device);
+    std::vector<RenderableNode> nodes = MakeNodes(&mesh);
+
+    StaticBatcher batcher;
+    batcher.Add(nodes.begin(), nodes.end(), RenderFlags::Textured, Shaders::TexturedShader);
+    CHECK(batcher.Build(engine.device, 100.0f) == 1);
+    RenderableNodeSorter sorter;
+
+    // the colour of the second object changed after the batch was built.
+    nodes[1].diffuse = float4(1, 0, 0, 1);
+    RenderableNodeSorter::Bucket* bucket = Collect(sorter, batcher, nodes);
+    uint32_t own = 0, batched = 0;
+    for(size_t i = 0; i < bucket->renderables.size(); ++i)
+    {
+        const RenderableNode& r = bucket->renderables[i];
+        if(r.mesh == &mesh)
+        {
+            CHECK(r.objectId == nodes[1].objectId);
+            CHECK(r.diffuse.y == 0);
+            ++own;
+        }
+        else
+        {
+            CHECK(r.diffuse.y == 1);
+            batched += r.indexCount;
+        }
+    }
+    CHECK(own == 1);
+    CHECK(batched == 3 * (NodeCount - 1));
+
+    // emissive and specular count too.
+    nodes[1].diffuse = float4(1, 1, 1, 1);
+    nodes[2].emissive = float4(0, 0, 1, 0);
+    nodes[3].specPower = 16;
+    bucket = Collect(sorter, batcher, nodes);
+    own = 0;
+    for(size_t i = 0; i < bucket->renderables.size(); ++i)
+    {
+        if(bucket->renderables[i].mesh == &mesh)
+            ++own;
+    }
+    CHECK(own == 2);
+}
+
+TEST_MAIN()
@@ -0,0 +1,65 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    TestEngine.h
+
+    Creates the engine singletons the CPU side of rendering uses, on the
+    null device and in the order of LvEd_Initialize(). There are no shaders
+    in the portable build, so nothing here draws.
+****************************************************************************/
+#pragma once
+
+#include "../Core/Utils.h"
+#include "../Core/FrameArena.h"
+#include "../VectorMath/V3dMath.h"
+#include "../Renderer/NullDevice.h"
+#include "../Renderer/GpuResourceFactory.h"
+#include "../Renderer/ShapeLib.h"
+#include "../Renderer/TransientBuffer.h"
+#include "../Renderer/RenderContext.h"
+
+namespace LvEdTests
+{
+    class TestEngine
+    {
+    public:
+        TestEngine()
+            : device(NULL), dc(NULL)
+        {
+            using namespace LvEdEngine;
+            CreateNullDevice(&device, &dc);
+            GpuResourceFactory::SetDevice(device);
+            ShapeLibStartup(device);
+            FrameArena::InitInstance(4 * 1024 * 1024);
+            TransientBuffer::InitInstance(device, 1024 * 1024);
+            RenderContext::InitInstance(device);
+            RenderContext::Inst()->SetContext(dc);
+            LookAt(float3(0, 40, 120), float3(0, 0, 0));
+        }
+
+        ~TestEngine()
+        {
+            using namespace LvEdEngine;
+            ShapeLibShutdown();
+            TransientBuffer::DestroyInstance();
+            FrameArena::DestroyInstance();
+            RenderContext::DestroyInstance();
+            GpuResourceFactory::SetDevice(NULL);
+            SAFE_RELEASE(dc);
+            SAFE_RELEASE(device);
+        }
+
+        // 1024x768 perspective view from eye.
+        void LookAt(const LvEdEngine::float3& eye, const LvEdEngine::float3& at)
+        {
+            using namespace LvEdEngine;
+            RenderContext* rc = RenderContext::Inst();
+            rc->SetViewPort(float4(0, 0, 1024, 768));
+            rc->Cam().SetViewProj(Matrix::CreateLookAtRH(eye, at, float3(0, 1, 0)),
+                Matrix::CreatePerspectiveFieldOfView(1.0f, 1024.0f / 768.0f, 1.0f, 1000.0f));
+        }
+
+        ID3D11Device* device;
+        ID3D11DeviceContext* dc;
+    };
+}
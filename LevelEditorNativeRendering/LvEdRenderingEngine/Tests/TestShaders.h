@@ -0,0 +1,79 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    TestShaders.h
+
+    Stand-ins for the shader compiler and the device backend, so that the
+    shaders can be created and their command buffers checked without D3D11.
+****************************************************************************/
+#pragma once
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include "../Renderer/ShaderCache.h"
+#include "../Renderer/CommandBuffer.h"
+
+namespace LvEdTests
+{
+    // Every shader has a source, unless removed. The code is made of the
+    // name, entry point and target, so any code is accepted by the null device.
+    class StubShaderCompiler : public LvEdEngine::ShaderCompiler
+    {
+    public:
+        StubShaderCompiler(LvEdEngine::hash64_t version = 1)
+            : version(version), compileCount(0), failCompile(false) {}
+
+        virtual bool ReadSource(const char* name, std::string* source)
+        {
+            auto it = sources.find(name);
+            if(it != sources.end())
+            {
+                *source = it->second;
+                return true;
+            }
+            if(missing.count(name))
+                return false;
+            *source = std::string("// ") + name;
+            return true;
+        }
+
+        virtual bool Compile(const char* name, const std::string& /*source*/, const D3D_SHADER_MACRO* /*macros*/,
+            const char* entryPoint, const char* target, std::vector<uint8_t>* code, std::vector<std::string>* includes)
+        {
+            ++compileCount;
+            if(failCompile)
+                return false;
+            std::string text = std::string(name) + ":" + entryPoint + ":" + target;
+            code->assign(text.begin(), text.end());
+            includes->assign(includeNames.begin(), includeNames.end());
+            return true;
+        }
+
+        virtual LvEdEngine::hash64_t GetVersion() { return version; }
+
+        std::map<std::string, std::string> sources;      // overrides the default source.
+        std::set<std::string>              missing;      // names without a source.
+        std::vector<std::string>           includeNames; // reported by every compile.
+        LvEdEngine::hash64_t               version;
+        int                                compileCount;
+        bool                               failCompile;
+    };
+
+    // keeps what it is asked to execute instead of executing it.
+    class RecordingBackend : public LvEdEngine::CommandBackend
+    {
+    public:
+        RecordingBackend() : executeCount(0) {}
+
+        virtual void Execute(const LvEdEngine::CommandBuffer& commands)
+        {
+            ++executeCount;
+            executed.Append(commands);
+        }
+
+        int                      executeCount;
+        LvEdEngine::CommandBuffer executed;
+    };
+}
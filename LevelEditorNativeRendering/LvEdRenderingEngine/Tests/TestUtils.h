@@ -0,0 +1,71 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    TestUtils.h
+
+    Minimal checks for the tests of the portable build. Each test program
+    registers its tests with TEST(name), runs them all from RunTests(), and
+    returns non-zero when a CHECK failed.
+****************************************************************************/
+#pragma once
+
+#include <stdio.h>
+#include <vector>
+
+namespace LvEdTests
+{
+    typedef void (*TestFn)();
+
+    struct TestCase
+    {
+        const char* name;
+        TestFn fn;
+    };
+
+    inline std::vector<TestCase>& Registry()
+    {
+        static std::vector<TestCase> s_tests;
+        return s_tests;
+    }
+
+    inline int& FailureCount()
+    {
+        static int s_failures = 0;
+        return s_failures;
+    }
+
+    struct Registrar
+    {
+        Registrar(const char* name, TestFn fn)
+        {
+            TestCase t = { name, fn };
+            Registry().push_back(t);
+        }
+    };
+
+    inline int RunTests()
+    {
+        for(size_t i = 0; i < Registry().size(); ++i)
+        {
+            const int failuresBefore = FailureCount();
+            Registry()[i].fn();
+            printf("%s %s\n", FailureCount() == failuresBefore ? "PASS" : "FAIL", Registry()[i].name);
+        }
+        printf("%d failure(s)\n", FailureCount());
+        return FailureCount() == 0 ? 0 : 1;
+    }
+}
+
+#define TEST(name) \
+    static void name(); \
+    static LvEdTests::Registrar s_register_##name(#name, name); \
+    static void name()
+
+#define CHECK(expr) \
+    do { if(!(expr)) { \
+        printf("%s(%d): CHECK(%s) failed\n", __FILE__, __LINE__, #expr); \
+        ++LvEdTests::FailureCount(); \
+    } } while(0)
+
+#define TEST_MAIN() \
+    int main() { return LvEdTests::RunTests(); }
@@ -0,0 +1,123 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    TextureStreamerTests.cpp
+
+    TextureStreamer::Schedule() gives every texture the mip it wants when
+    they fit in the budget, otherwise the textures requested least recently
+    lose their most detailed mips first, one mip per pass.
+****************************************************************************/
+#include "TestUtils.h"
+#include "../ResourceManager/TextureStreamer.h"
+
+using namespace LvEdEngine;
+
+typedef TextureStreamer::Entry Entry;
+
+// an uncompressed size x size texture with its whole mip chain, that
+// started at minMip and wants wantedMip.
+static Entry MakeEntry(uint32_t size, uint32_t minMip, uint32_t wantedMip, DWORD requestTime)
+{
+    Entry e;
+    e.tex = NULL;
+    e.forceSRGB = false;
+    e.format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    e.width = e.height = size;
+    e.mipCount = 1;
+    while((size >> e.mipCount) > 0)
+        ++e.mipCount;
+    e.minMip = minMip;
+    e.startMips = (2u << minMip) - 1;
+    e.residentMip = minMip;
+    e.wantedMip = wantedMip;
+    e.wantedTime = e.requestTime = requestTime;
+    e.targetMip = minMip;
+    e.loading = false;
+    e.failed = false;
+    return e;
+}
+
+TEST(ChainBytesCountsTheMipsFromMip)
+{
+    Entry e = MakeEntry(1024, 4, 0, 0);
+    CHECK(e.mipCount == 11);
+    CHECK(TextureStreamer::ChainBytes(e, 10) == 4);
+    CHECK(TextureStreamer::ChainBytes(e, 9) == 4 + 16);
+    CHECK(TextureStreamer::ChainBytes(e, 0) == 1024 * 1024 * 4 + TextureStreamer::ChainBytes(e, 1));
+}
+
+TEST(WantedMipsWithinTheBudget)
+{
+    Entry a = MakeEntry(1024, 4, 0, 100);
+    Entry b = MakeEntry(512, 3, 2, 200);
+    Entry* entries[] = { &a, &b };
+    uint64_t wanted = TextureStreamer::ChainBytes(a, 0) + TextureStreamer::ChainBytes(b, 2);
+    CHECK(TextureStreamer::Schedule(entries, 2, wanted) == wanted);
+    CHECK(a.targetMip == 0);
+    CHECK(b.targetMip == 2);
+    // nothing was reordered.
+    CHECK(entries[0] == &a && entries[1] == &b);
+}
+
+TEST(LeastRecentlyRequestedLoseMipsFirst)
+{
+    Entry recent = MakeEntry(1024, 4, 0, 200);
+    Entry old = MakeEntry(1024, 4, 0, 100);
+    Entry* entries[] = { &recent, &old };
+
+    // one mip less of the old texture fits.
+    uint64_t budget = TextureStreamer::ChainBytes(recent, 0) + TextureStreamer::ChainBytes(old, 1);
+    CHECK(TextureStreamer::Schedule(entries, 2, budget) == budget);
+    CHECK(recent.targetMip == 0);
+    CHECK(old.targetMip == 1);
+    CHECK(entries[0] == &old && entries[1] == &recent);
+
+    // with less, both lose one mip, then the old one another.
+    recent.wantedMip = old.wantedMip = 0;
+    budget = TextureStreamer::ChainBytes(recent, 1) + TextureStreamer::ChainBytes(old, 2);
+    CHECK(TextureStreamer::Schedule(entries, 2, budget) == budget);
+    CHECK(recent.targetMip == 1);
+    CHECK(old.targetMip == 2);
+}
+
+TEST(RequestTimesWrapAround)
+{
+    // GetTickCount() wrapped between the two requests.
+    Entry recent = MakeEntry(1024, 4, 0, 0x10);
+    Entry old = MakeEntry(1024, 4, 0, 0xFFFFFFF0);
+    Entry* entries[] = { &recent, &old };
+    uint64_t budget = TextureStreamer::ChainBytes(recent, 0) + TextureStreamer::ChainBytes(old, 1);
+    TextureStreamer::Schedule(entries, 2, budget);
+    CHECK(recent.targetMip == 0);
+    CHECK(old.targetMip == 1);
+}
+
+TEST(NeverPastTheStartMip)
+{
+    Entry a = MakeEntry(1024, 4, 0, 100);
+    Entry b = MakeEntry(2048, 5, 1, 200);
+    Entry* entries[] = { &a, &b };
+    uint64_t total = TextureStreamer::Schedule(entries, 2, 0);
+    CHECK(a.targetMip == 4);
+    CHECK(b.targetMip == 5);
+    CHECK(total == TextureStreamer::ChainBytes(a, 4) + TextureStreamer::ChainBytes(b, 5));
+}
+
+TEST(OnlyMipsTheTextureCanStartAt)
+{
+    // say mips 1 and 3 don't have block aligned sizes.
+    Entry e = MakeEntry(1024, 4, 1, 100);
+    e.startMips = (1u << 0) | (1u << 2) | (1u << 4);
+    Entry* entries[] = { &e };
+
+    // a request for mip 1 gets the more detailed mip 0.
+    CHECK(TextureStreamer::Schedule(entries, 1, UINT64_MAX) == TextureStreamer::ChainBytes(e, 0));
+    CHECK(e.targetMip == 0);
+
+    // over budget it goes from mip 0 to mip 2.
+    e.wantedMip = 0;
+    CHECK(TextureStreamer::Schedule(entries, 1, TextureStreamer::ChainBytes(e, 1)) == TextureStreamer::ChainBytes(e, 2));
+    CHECK(e.targetMip == 2);
+}
+
+TEST_MAIN()
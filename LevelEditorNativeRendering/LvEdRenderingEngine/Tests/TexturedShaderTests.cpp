@@ -0,0 +1,139 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    TexturedShaderTests.cpp
+
+    TexturedShader records its whole pass, the pipeline setup of Begin()
+    included, and hands it to the backend in End().
+****************************************************************************/
+#include "TestUtils.h"
+#include "TestEngine.h"
+#include "TestShaders.h"
+#include "../Renderer/Model.h"
+#include "../Renderer/RenderState.h"
+#include "../Renderer/ShadowMaps.h"
+#include "../Renderer/TexturedShader.h"
+
+using namespace LvEdEngine;
+
+// the engine singletons the shader uses.
+class ShaderEnvironment
+{
+public:
+    ShaderEnvironment(ID3D11Device* device)
+    {
+        ShaderCache::InitInstance(new LvEdTests::StubShaderCompiler(), L"");
+        RSCache::InitInstance(device);
+        ShadowMaps::InitInstance(device, 256);
+    }
+    ~ShaderEnvironment()
+    {
+        ShadowMaps::DestroyInstance();
+        RSCache::DestroyInstance();
+        ShaderCache::DestroyInstance();
+    }
+};
+
+static void MakeTriangle(Mesh& mesh, ID3D11Device* device)
+{
+    mesh.pos.push_back(float3(0, 0, 0));
+    mesh.pos.push_back(float3(1, 0, 0));
+    mesh.pos.push_back(float3(0, 1, 0));
+    for(int i = 0; i < 3; ++i)
+    {
+        mesh.nor.push_back(float3(0, 0, 1));
+        mesh.tex.push_back(float2(0, 0));
+        mesh.indices.push_back(i);
+    }
+    mesh.ComputeBound();
+    mesh.Construct(device);
+}
+
+TEST(BeginIsRecordedAheadOfTheDraws)
+{
+    LvEdTests::TestEngine engine;
+    ShaderEnvironment environment(engine.device);
+    LvEdTests::RecordingBackend backend;
+    RenderContext* rc = RenderContext::Inst();
+    rc->SetBackend(&backend);
+
+    Mesh mesh;
+    MakeTriangle(mesh, engine.device);
+    FrameNodeList nodes;
+    for(int i = 0; i < 3; ++i)
+    {
+        RenderableNode r;
+        r.mesh = &mesh;
+        r.WorldXform = Matrix::CreateTranslation((float)i, 0, 0);
+        r.bounds = mesh.bounds;
+        nodes.push_back(r);
+    }
+
+    TexturedShader* shader = new TexturedShader(engine.device);
+    shader->Begin(rc);
+    shader->SetRenderFlag((RenderFlagsEnum)(RenderFlags::Textured | RenderFlags::Lit));
+    shader->DrawNodes(nodes);
+    CHECK(backend.executeCount == 0);
+    shader->End();
+    CHECK(backend.executeCount == 1);
+
+    const CommandBuffer& cmds = backend.executed;
+    CHECK(cmds.GetDrawCount() == 3);
+
+    // every binding the draws rely on comes before the first draw.
+    uint32_t seen = 0;
+    const CommandHeader* last = NULL;
+    for(const CommandHeader* cmd = cmds.First(); cmd; cmd = cmds.Next(cmd))
+    {
+        last = cmd;
+        if(cmd->type == CommandType::DrawIndexed || cmd->type == CommandType::Draw)
+            break;
+        seen |= 1 << cmd->type;
+        if(cmd->type == CommandType::SetShaders)
+        {
+            const CmdSetShaders* c = CommandBuffer::Payload<CmdSetShaders>(cmd);
+            CHECK(c->vs != NULL && c->ps != NULL && c->gs == NULL);
+        }
+        else if(cmd->type == CommandType::SetInputLayout)
+        {
+            CHECK(CommandBuffer::Payload<CmdSetInputLayout>(cmd)->layout != NULL);
+        }
+        else if(cmd->type == CommandType::SetPSSamplers)
+        {
+            const CmdSetPSSamplers* c = CommandBuffer::Payload<CmdSetPSSamplers>(cmd);
+            CHECK(c->slot == 0 && c->count == 2 && c->samplers[1] == ShadowMaps::Inst()->GetSamplerState());
+        }
+        else if(cmd->type == CommandType::SetConstantBuffers)
+        {
+            const CmdSetConstantBuffers* c = CommandBuffer::Payload<CmdSetConstantBuffers>(cmd);
+            CHECK(c->slot == 0 && c->count == 4 && c->buffers[3] == ShadowMaps::Inst()->GetShadowConstantBuffer());
+        }
+    }
+    CHECK(last != NULL && last->type == CommandType::DrawIndexed);
+    const uint32_t setup = (1 << CommandType::SetDepthState) | (1 << CommandType::UpdateConstants)
+        | (1 << CommandType::SetInputLayout) | (1 << CommandType::SetPSSamplers) | (1 << CommandType::SetShaders)
+        | (1 << CommandType::SetPSResources) | (1 << CommandType::SetConstantBuffers)
+        | (1 << CommandType::SetRasterState) | (1 << CommandType::SetBlendState)
+        | (1 << CommandType::SetVertexBuffer) | (1 << CommandType::SetIndexBuffer) | (1 << CommandType::SetTopology);
+    CHECK((seen & setup) == setup);
+
+    // End() unbinds the textures after the last draw.
+    for(const CommandHeader* cmd = cmds.First(); cmd; cmd = cmds.Next(cmd))
+        last = cmd;
+    CHECK(last->type == CommandType::SetPSResources);
+    const CmdSetPSResources* unbind = CommandBuffer::Payload<CmdSetPSResources>(last);
+    CHECK(unbind->slot == 0 && unbind->count == 4);
+    for(uint32_t i = 0; i < unbind->count; ++i)
+        CHECK(unbind->views[i] == NULL);
+
+    // the next pass starts from a clean buffer.
+    shader->Begin(rc);
+    shader->End();
+    CHECK(backend.executeCount == 2);
+    CHECK(cmds.GetDrawCount() == 3);
+
+    delete shader;
+    rc->SetBackend(NULL);
+}
+
+TEST_MAIN()
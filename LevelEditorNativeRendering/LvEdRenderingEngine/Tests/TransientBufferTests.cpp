@@ -0,0 +1,177 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    TransientBufferTests.cpp
+
+    TransientBuffer::Map() hands out aligned ranges that don't overlap,
+    reuses the ring once the GPU is done with a frame, and discards the
+    buffer when an allocation doesn't fit. The null device finishes the
+    fenced frames when its context is flushed.
+****************************************************************************/
+#include "TestUtils.h"
+#include <stdint.h>
+#include "../Core/Utils.h"
+#include "../Renderer/NullDevice.h"
+#include "../Renderer/TransientBuffer.h"
+
+using namespace LvEdEngine;
+
+static const uint32_t Capacity = 1024;
+
+// a ring of Capacity bytes on its own null device.
+class TestRing
+{
+public:
+    TestRing()
+        : device(NULL), dc(NULL)
+    {
+        CreateNullDevice(&device, &dc);
+        TransientBuffer::InitInstance(device, Capacity);
+        ring = TransientBuffer::Inst();
+    }
+
+    ~TestRing()
+    {
+        TransientBuffer::DestroyInstance();
+        SAFE_RELEASE(dc);
+        SAFE_RELEASE(device);
+    }
+
+    // maps and unmaps count vertices, returns the offset or -1 on failure.
+    int64_t Alloc(uint32_t stride, uint32_t count)
+    {
+        TransientAlloc alloc;
+        if(!ring->Map(dc, stride, count, &alloc))
+            return -1;
+        CHECK(alloc.buffer == ring->GetBuffer());
+        CHECK(alloc.offset % stride == 0);
+        CHECK(alloc.firstVertex * stride == alloc.offset);
+        CHECK(alloc.offset + stride * count <= Capacity);
+        ring->Unmap(dc);
+        return alloc.offset;
+    }
+
+    ID3D11Device* device;
+    ID3D11DeviceContext* dc;
+    TransientBuffer* ring;
+};
+
+TEST(MapReturnsAlignedRangesThatDontOverlap)
+{
+    TestRing t;
+    CHECK(t.ring->GetCapacity() == Capacity);
+    CHECK(t.Alloc(12, 3) == 0);
+    // 36 bytes used, the next 16 byte vertex starts at 48.
+    CHECK(t.Alloc(16, 2) == 48);
+    CHECK(t.Alloc(12, 1) == 84);
+    CHECK(t.ring->GetDiscardCount() == 0); // the first map discards, but isn't an overflow.
+}
+
+TEST(MapWritesIntoTheBuffer)
+{
+    TestRing t;
+    TransientAlloc first, second;
+    CHECK(t.ring->Map(t.dc, 4, 4, &first));
+    uint32_t* v = (uint32_t*)first.data;
+    for(uint32_t i = 0; i < 4; ++i)
+        v[i] = i;
+    t.ring->Unmap(t.dc);
+    CHECK(t.ring->Map(t.dc, 4, 4, &second));
+    CHECK((uint8_t*)second.data - (uint8_t*)first.data == (ptrdiff_t)second.offset);
+    t.ring->Unmap(t.dc);
+
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    CHECK(SUCCEEDED(t.dc->Map(t.ring->GetBuffer(), 0, D3D11_MAP_WRITE_NO_OVERWRITE, 0, &mapped)));
+    CHECK(((uint32_t*)mapped.pData)[3] == 3);
+    t.dc->Unmap(t.ring->GetBuffer(), 0);
+}
+
+TEST(MapRejectsWhatCantFit)
+{
+    TestRing t;
+    TransientAlloc alloc;
+    CHECK(!t.ring->Map(t.dc, 0, 1, &alloc));
+    CHECK(!t.ring->Map(t.dc, 16, 0, &alloc));
+    CHECK(!t.ring->Map(t.dc, 16, t.ring->GetMaxCount(16) + 1, &alloc));
+    CHECK(t.Alloc(16, t.ring->GetMaxCount(16)) == 0);
+}
+
+TEST(EndFrameReusesTheRing)
+{
+    TestRing t;
+    CHECK(t.Alloc(16, 40) == 0);
+    t.ring->EndFrame(t.dc);
+    CHECK(t.ring->GetFrameBytes() == 640);
+    t.dc->Flush();
+
+    // 640 more bytes don't fit behind the last frame, which is done: the
+    // next frame starts over at the beginning, without a discard.
+    CHECK(t.Alloc(16, 40) == 0);
+    CHECK(t.Alloc(16, 10) == 640);
+    t.ring->EndFrame(t.dc);
+    CHECK(t.ring->GetFrameBytes() == 800);
+    CHECK(t.ring->GetDiscardCount() == 0);
+
+    // a frame without allocations.
+    t.ring->EndFrame(t.dc);
+    CHECK(t.ring->GetFrameBytes() == 0);
+}
+
+TEST(OverflowDiscardsTheBuffer)
+{
+    TestRing t;
+    CHECK(t.Alloc(16, 40) == 0);
+    CHECK(t.Alloc(16, 20) == 640);
+    CHECK(t.ring->GetDiscardCount() == 0);
+
+    // the current frame still uses [0, 960), so the ring is full.
+    CHECK(t.Alloc(16, 10) == 0);
+    CHECK(t.ring->GetDiscardCount() == 1);
+    CHECK(t.Alloc(16, 10) == 160);
+    t.ring->EndFrame(t.dc);
+    CHECK(t.ring->GetFrameBytes() == 1280);
+    CHECK(t.ring->GetDiscardCount() == 1);
+}
+
+TEST(WrapWaitsForTheGpu)
+{
+    TestRing t;
+    CHECK(t.Alloc(16, 40) == 0);
+    t.ring->EndFrame(t.dc);
+    t.dc->Flush();
+    // [640, 960) stays in use, its frame isn't flushed.
+    CHECK(t.Alloc(16, 20) == 640);
+    t.ring->EndFrame(t.dc);
+
+    // wraps into the space of the first frame, which is done.
+    CHECK(t.Alloc(16, 10) == 0);
+    CHECK(t.Alloc(16, 29) == 160);
+    CHECK(t.ring->GetDiscardCount() == 0);
+
+    // the next 32 bytes would reach the pending frame.
+    CHECK(t.Alloc(16, 2) == 0);
+    CHECK(t.ring->GetDiscardCount() == 1);
+}
+
+TEST(PendingFramesBlockTheWholeRing)
+{
+    TestRing t;
+    for(uint32_t frame = 0; frame < 3; ++frame)
+    {
+        CHECK(t.Alloc(16, 20) == frame * 320);
+        t.ring->EndFrame(t.dc);
+    }
+    CHECK(t.ring->GetDiscardCount() == 0);
+
+    // nothing is done, the ring can't wrap.
+    CHECK(t.Alloc(16, 10) == 0);
+    CHECK(t.ring->GetDiscardCount() == 1);
+    t.ring->EndFrame(t.dc);
+
+    // once the GPU catches up, the ring is reused without discarding.
+    t.dc->Flush();
+    CHECK(t.Alloc(16, 60) == 0);
+    CHECK(t.ring->GetDiscardCount() == 1);
+}
+
+TEST_MAIN()
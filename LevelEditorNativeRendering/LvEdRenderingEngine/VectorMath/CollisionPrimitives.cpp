@@ -46,7 +46,7 @@ void CreateUnitCube(Cube &cube)
 
 
     // test if point P is contained in triangle ABC
-    bool LvEdEngine::TestPointTriangle(const Triangle &t, const float3 &P)
+    bool TestPointTriangle(const Triangle &t, const float3 &P)
     {
         //method 1
         //float3 bary;
@@ -222,6 +222,8 @@ void CreateUnitCube(Cube &cube)
 
 
     //======================= Frustum ========================
+
+    static uint32_t s_frustumStamp = 0;
   
     // corners must be specified as follow
     // front: botton-left  bottom-right, top-right, top-left.
@@ -239,6 +241,7 @@ void CreateUnitCube(Cube &cube)
         m_planes[Bottom] = Plane(corners[1],corners[5],corners[4]);
         m_planes[Right] = Plane(corners[1],corners[6],corners[5]);                
         m_planes[Left] = Plane(corners[0],corners[4],corners[7]);
+        m_stamp = ++s_frustumStamp;
     }
 
 
@@ -295,6 +298,7 @@ void CreateUnitCube(Cube &cube)
         {
             this->m_corners[i] = float3::Transform(verts[i],invVP);
         }
+        m_stamp = ++s_frustumStamp;
     }
 
     const void Frustum::GetCorners( float3* out_points) const
@@ -858,6 +862,47 @@ int FrustumAABBIntersect(const Frustum& frustum, const AABB& box)
         if(intersects) return 1;
         return 2; // either intersects or completely inside frustum      
     }
+
+    //-----------------------------------------------------------------------------
+    // AABB vs Frustum test for hierarchies.
+    //
+    // Only tests the planes set in planeMask, the planes the parent of the box
+    // straddles, starting with lastPlane, the plane that rejected the box the
+    // last time. On return planeMask holds the planes the box straddles, the
+    // ones its children need to test, and lastPlane the plane that rejected it.
+    //
+    // Return values: same as FrustumAABBIntersect() above.
+    //-----------------------------------------------------------------------------
+    int FrustumAABBIntersect(const Frustum& frustum, const AABB& box, uint32_t* planeMask, uint32_t* lastPlane)
+    {
+        float3 c  = box.GetCenter();
+        float3 r  = box.Max() - c;
+        uint32_t inMask = *planeMask;
+        uint32_t outMask = 0;
+        int first = (int)*lastPlane;
+        for(int k = -1; k < 6; ++k)
+        {
+            int i = k < 0 ? first : k;
+            if((k >= 0 && i == first) || (inMask & (1 << i)) == 0)
+                continue;
+
+            const Plane& plane = frustum[i];
+            float e =  r.x * abs(plane.normal.x) 
+                + r.y * abs(plane.normal.y) 
+                + r.z * abs(plane.normal.z);
+            float s = plane.Eval(c);
+
+            if( (s + e) < 0)
+            {
+                *lastPlane = (uint32_t)i;
+                return 0;
+            }
+            if((s - e) <= 0)
+                outMask |= 1 << i;
+        }
+        *planeMask = outMask;
+        return outMask ? 1 : 2;
+    }
     //-----------------------------------------------------------------------------
     // AABB vs frustum test.
     //
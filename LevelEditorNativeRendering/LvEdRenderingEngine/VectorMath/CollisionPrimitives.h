@@ -195,9 +195,10 @@ class Triangle
     class Frustum : public NonCopyable
     {
     public: 
-        Frustum(){}
+        Frustum() : m_stamp(0) {}
         ~Frustum(){}
         enum Side { Near=0, Far, Left, Right,Top, Bottom,NumPlanes };
+        static const uint32_t AllPlanes = (1 << NumPlanes) - 1;
         enum corner {NearBottonLeft = 0, NearBottomRight, NearTopRight, NearTopLeft,
                      FarBottonLeft,FarBottomRight,FarTopRight, FarTopLeft};
 
@@ -213,9 +214,14 @@ enum corner {NearBottonLeft = 0, NearBottomRight, NearTopRight, NearTopLeft,
         void InitFromMatrix(const Matrix &viewproj);
         void InitFromCorners(float3* corners);
         const void GetCorners( float3* out_points) const;		
+
+        // changes every time the planes are set, plane masks computed
+        // against a frustum are only valid for the same stamp.
+        uint32_t GetStamp() const { return m_stamp; }
         
     private:
         Plane m_planes[6];   
+        uint32_t m_stamp;
 
         // corners must be specified as follow
         // front: botton-left  bottom-right, top-right, top-left.
@@ -252,6 +258,7 @@ enum corner {NearBottonLeft = 0, NearBottomRight, NearTopRight, NearTopLeft,
                                
 	 bool TestFrustumAABB(const Frustum& frustum, const AABB& box);
      int FrustumAABBIntersect(const Frustum& frustum, const AABB& box);
+     int FrustumAABBIntersect(const Frustum& frustum, const AABB& box, uint32_t* planeMask, uint32_t* lastPlane);
 
      bool IntersectRayAABB(const Ray& r, const AABB& box, float* out_tmin, float3* out_pos, float3* out_nor);
 
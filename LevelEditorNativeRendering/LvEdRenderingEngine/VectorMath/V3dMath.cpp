@@ -2,6 +2,7 @@
 
 #include "V3dMath.h"
 #include <math.h>
+#include <float.h>
 
 namespace LvEdEngine
 {
@@ -377,6 +377,7 @@ class Matrix
         Matrix() {this->MakeIdentity();};
         Matrix( const float *pm );
         Matrix( const Matrix& );    
+        Matrix& operator = ( const Matrix& );
         Matrix( float f11, float f12, float f13, float f14,
                 float f21, float f22, float f23, float f24,
                 float f31, float f32, float f33, float f34,
@@ -574,6 +575,12 @@ void SetRotation(const Vector3& rotation)
         memcpy(&M11, &mat, sizeof(Matrix));
     }
 
+    inline Matrix& Matrix::operator = ( const Matrix& mat )
+    {
+        memcpy(&M11, &mat, sizeof(Matrix));
+        return *this;
+    }
+
 
     inline Matrix::Matrix(  float f11, float f12, float f13, float f14,
                             float f21, float f22, float f23, float f24,
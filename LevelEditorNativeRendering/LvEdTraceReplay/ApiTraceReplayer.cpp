@@ -0,0 +1,623 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    ApiTraceReplayer.cpp
+
+****************************************************************************/
+#include "ApiTraceReplayer.h"
+#include <string.h>
+#include "LvEdRenderingEngine.h"
+#include "Core/Logger.h"
+#include "Core/PerfTimer.h"
+#include "VectorMath/CollisionPrimitives.h"
+#include "Renderer/BasicRenderer.h"
+
+using namespace LvEdEngine;
+
+//---------------------------------------------------------------------------
+ApiTraceReplayer::ApiTraceReplayer()
+  : m_frameCount(0),
+    m_totalMs(0)
+{
+    memset(m_stats, 0, sizeof(m_stats));
+}
+
+//---------------------------------------------------------------------------
+ObjectGUID ApiTraceReplayer::MapHandle(ObjectGUID recorded) const
+{
+    if(recorded == 0)
+        return 0;
+    std::map<ObjectGUID, ObjectGUID>::const_iterator it = m_handles.find(recorded);
+    return it != m_handles.end() ? it->second : 0;
+}
+
+//---------------------------------------------------------------------------
+void ApiTraceReplayer::AddHandle(ObjectGUID recorded, ObjectGUID replayed)
+{
+    if(recorded != 0)
+        m_handles[recorded] = replayed;
+}
+
+//---------------------------------------------------------------------------
+void ApiTraceReplayer::RemoveHandle(ObjectGUID recorded)
+{
+    m_handles.erase(recorded);
+}
+
+//---------------------------------------------------------------------------
+bool ApiTraceReplayer::Replay(const wchar_t* file)
+{
+    ApiTraceReader reader;
+    if(!reader.Open(file))
+        return false;
+
+    memset(m_stats, 0, sizeof(m_stats));
+    m_handles.clear();
+    m_frameCount = 0;
+    m_totalMs = 0;
+
+    Logger::Log(OutputMessageType::Info, L"Replaying trace %s\n", file);
+    ApiCallEnum call;
+    while(reader.NextCall(&call))
+        ReplayCall(reader, call);
+
+    if(reader.HasError())
+    {
+        Logger::Log(OutputMessageType::Error, L"Trace file %s is corrupt\n", file);
+        return false;
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------
+// Reads the arguments of the call, maps the handles and times the call.
+// Calls on handles that weren't created by the trace are skipped.
+void ApiTraceReplayer::ReplayCall(ApiTraceReader& r, ApiCallEnum call)
+{
+    PerfTimer timer;
+    bool skipped = false;
+
+    switch(call)
+    {
+    case ApiCall::Clear:
+        timer.Start();
+        LvEd_Clear();
+        timer.Stop();
+        break;
+
+    case ApiCall::GetObjectTypeId:
+        {
+            const char* name = r.ReadStringA();
+            timer.Start();
+            LvEd_GetObjectTypeId((char*)name);
+            timer.Stop();
+        }
+        break;
+
+    case ApiCall::GetObjectPropertyId:
+    case ApiCall::GetObjectChildListId:
+        {
+            ObjectTypeGUID typeId = r.Read<ObjectTypeGUID>();
+            const char* name = r.ReadStringA();
+            timer.Start();
+            if(call == ApiCall::GetObjectPropertyId)
+                LvEd_GetObjectPropertyId(typeId, (char*)name);
+            else
+                LvEd_GetObjectChildListId(typeId, (char*)name);
+            timer.Stop();
+        }
+        break;
+
+    case ApiCall::CreateObject:
+        {
+            ObjectTypeGUID typeId = r.Read<ObjectTypeGUID>();
+            uint32_t size = 0;
+            const void* data = r.ReadBlob(&size);
+            ObjectGUID recorded = r.Read<ObjectGUID>();
+            timer.Start();
+            ObjectGUID instanceId = LvEd_CreateObject(typeId, (void*)data, (int)size);
+            timer.Stop();
+            AddHandle(recorded, instanceId);
+        }
+        break;
+
+    case ApiCall::DestroyObject:
+        {
+            ObjectTypeGUID typeId = r.Read<ObjectTypeGUID>();
+            ObjectGUID recorded = r.Read<ObjectGUID>();
+            ObjectGUID instanceId = MapHandle(recorded);
+            skipped = instanceId == 0;
+            if(skipped) break;
+            timer.Start();
+            LvEd_DestroyObject(typeId, instanceId);
+            timer.Stop();
+            RemoveHandle(recorded);
+        }
+        break;
+
+    case ApiCall::InvokeMemberFn:
+        {
+            ObjectGUID instanceId = MapHandle(r.Read<ObjectGUID>());
+            const wchar_t* fn = r.ReadStringW();
+            const void* arg = r.ReadBlob(NULL);
+            ObjectGUID recordedRet = r.Read<ObjectGUID>();
+            skipped = instanceId == 0;
+            if(skipped) break;
+            void* retVal = NULL;
+            timer.Start();
+            LvEd_InvokeMemberFn(instanceId, (wchar_t*)fn, arg, &retVal);
+            timer.Stop();
+            if(InvokeReturnsInstanceId(fn) && retVal)
+                AddHandle(recordedRet, *(ObjectGUID*)retVal);
+        }
+        break;
+
+    case ApiCall::SetObjectProperty:
+        {
+            ObjectTypeGUID typeId = r.Read<ObjectTypeGUID>();
+            ObjectPropertyUID propId = r.Read<ObjectPropertyUID>();
+            ObjectGUID instanceId = MapHandle(r.Read<ObjectGUID>());
+            uint32_t size = 0;
+            const void* data = r.ReadBlob(&size);
+            skipped = instanceId == 0;
+            if(skipped) break;
+            timer.Start();
+            LvEd_SetObjectProperty(typeId, propId, instanceId, (void*)data, (int)size);
+            timer.Stop();
+        }
+        break;
+
+    case ApiCall::GetObjectProperty:
+        {
+            ObjectTypeGUID typeId = r.Read<ObjectTypeGUID>();
+            ObjectPropertyUID propId = r.Read<ObjectPropertyUID>();
+            ObjectGUID instanceId = MapHandle(r.Read<ObjectGUID>());
+            skipped = instanceId == 0;
+            if(skipped) break;
+            void* data = NULL;
+            int size = 0;
+            timer.Start();
+            LvEd_GetObjectProperty(typeId, propId, instanceId, &data, &size);
+            timer.Stop();
+        }
+        break;
+
+    case ApiCall::ObjectAddChild:
+    case ApiCall::ObjectRemoveChild:
+        {
+            ObjectTypeGUID typeId = r.Read<ObjectTypeGUID>();
+            ObjectListUID listId = r.Read<ObjectListUID>();
+            ObjectGUID parentId = MapHandle(r.Read<ObjectGUID>());
+            ObjectGUID childId = MapHandle(r.Read<ObjectGUID>());
+            int index = call == ApiCall::ObjectAddChild ? r.Read<int32_t>() : 0;
+            skipped = parentId == 0 || childId == 0;
+            if(skipped) break;
+            timer.Start();
+            if(call == ApiCall::ObjectAddChild)
+                LvEd_ObjectAddChild(typeId, listId, parentId, childId, index);
+            else
+                LvEd_ObjectRemoveChild(typeId, listId, parentId, childId);
+            timer.Stop();
+        }
+        break;
+
+    case ApiCall::RayPick:
+        {
+            float view[16], proj[16];
+            r.ReadBytes(view, sizeof(view));
+            r.ReadBytes(proj, sizeof(proj));
+            Ray ray = r.Read<Ray>();
+            bool skipSelected = r.Read<bool>();
+            HitRecord* hits = NULL;
+            int count = 0;
+            timer.Start();
+            LvEd_RayPick(view, proj, &ray, skipSelected, &hits, &count);
+            timer.Stop();
+        }
+        break;
+
+    case ApiCall::FrustumPick:
+        {
+            ObjectGUID surface = MapHandle(r.Read<ObjectGUID>());
+            float view[16], proj[16], rect[4];
+            r.ReadBytes(view, sizeof(view));
+            r.ReadBytes(proj, sizeof(proj));
+            r.ReadBytes(rect, sizeof(rect));
+            skipped = surface == 0;
+            if(skipped) break;
+            HitRecord* hits = NULL;
+            int count = 0;
+            timer.Start();
+            LvEd_FrustumPick(surface, view, proj, rect, &hits, &count);
+            timer.Stop();
+        }
+        break;
+
+    case ApiCall::SetSelection:
+        {
+            uint32_t size = 0;
+            const ObjectGUID* ids = (const ObjectGUID*)r.ReadBlob(&size);
+            std::vector<ObjectGUID> selection;
+            for(uint32_t i = 0; i < size / sizeof(ObjectGUID); ++i)
+            {
+                ObjectGUID id = MapHandle(ids[i]);
+                if(id != 0)
+                    selection.push_back(id);
+            }
+            timer.Start();
+            LvEd_SetSelection(selection.empty() ? NULL : &selection[0], (int)selection.size());
+            timer.Stop();
+        }
+        break;
+
+    case ApiCall::SetRenderState:
+    case ApiCall::SetGameLevel:
+        {
+            ObjectGUID recorded = r.Read<ObjectGUID>();
+            ObjectGUID instanceId = MapHandle(recorded);
+            skipped = recorded != 0 && instanceId == 0;
+            if(skipped) break;
+            timer.Start();
+            if(call == ApiCall::SetRenderState)
+                LvEd_SetRenderState(instanceId);
+            else
+                LvEd_SetGameLevel(instanceId);
+            timer.Stop();
+        }
+        break;
+
+    case ApiCall::GetGameLevel:
+        timer.Start();
+        LvEd_GetGameLevel();
+        timer.Stop();
+        break;
+
+    case ApiCall::WaitForPendingResources:
+        timer.Start();
+        LvEd_WaitForPendingResources();
+        timer.Stop();
+        break;
+
+    case ApiCall::Update:
+        {
+            FrameTime ft = r.Read<FrameTime>();
+            UpdateTypeEnum updateType = (UpdateTypeEnum)r.Read<int32_t>();
+            skipped = LvEd_GetGameLevel() == 0;
+            if(skipped) break;
+            timer.Start();
+            LvEd_Update(&ft, updateType);
+            timer.Stop();
+        }
+        break;
+
+    case ApiCall::Begin:
+        {
+            ObjectGUID surface = MapHandle(r.Read<ObjectGUID>());
+            float view[16], proj[16];
+            r.ReadBytes(view, sizeof(view));
+            r.ReadBytes(proj, sizeof(proj));
+            skipped = surface == 0;
+            if(skipped) break;
+            timer.Start();
+            LvEd_Begin(surface, view, proj);
+            timer.Stop();
+        }
+        break;
+
+    case ApiCall::End:
+        timer.Start();
+        LvEd_End();
+        timer.Stop();
+        m_frameCount++;
+        break;
+
+    case ApiCall::RenderGame:
+        timer.Start();
+        LvEd_RenderGame();
+        timer.Stop();
+        break;
+
+    case ApiCall::SetRenderThreadCount:
+        {
+            int count = r.Read<int32_t>();
+            timer.Start();
+            LvEd_SetRenderThreadCount(count);
+            timer.Stop();
+        }
+        break;
+
+    case ApiCall::SetOcclusionCulling:
+        {
+            bool enable = r.Read<bool>();
+            timer.Start();
+            LvEd_SetOcclusionCulling(enable);
+            timer.Stop();
+        }
+        break;
+
+    case ApiCall::SetSmallFeatureCulling:
+        {
+            float pixels = r.Read<float>();
+            timer.Start();
+            LvEd_SetSmallFeatureCulling(pixels);
+            timer.Stop();
+        }
+        break;
+
+    case ApiCall::SetResourceMemoryBudget:
+        {
+            uint32_t megabytes = r.Read<uint32_t>();
+            timer.Start();
+            LvEd_SetResourceMemoryBudget(megabytes);
+            timer.Stop();
+        }
+        break;
+
+    case ApiCall::MountArchive:
+        {
+            const wchar_t* archiveFile = r.ReadStringW();
+            const wchar_t* mountDir = r.ReadStringW();
+            timer.Start();
+            LvEd_MountArchive((wchar_t*)archiveFile, (wchar_t*)mountDir);
+            timer.Stop();
+        }
+        break;
+
+    case ApiCall::SetContentSharing:
+        {
+            bool enable = r.Read<bool>();
+            timer.Start();
+            LvEd_SetContentSharing(enable);
+            timer.Stop();
+        }
+        break;
+
+    case ApiCall::SetTextureCache:
+        {
+            bool enable = r.Read<bool>();
+            bool compress = r.Read<bool>();
+            timer.Start();
+            LvEd_SetTextureCache(enable, compress);
+            timer.Stop();
+        }
+        break;
+
+    case ApiCall::SetTextureStreaming:
+        {
+            bool enable = r.Read<bool>();
+            uint32_t budgetMegabytes = r.Read<uint32_t>();
+            timer.Start();
+            LvEd_SetTextureStreaming(enable, budgetMegabytes);
+            timer.Stop();
+        }
+        break;
+
+    case ApiCall::PackArchive:
+        {
+            const wchar_t* rootDir = r.ReadStringW();
+            const wchar_t* archiveFile = r.ReadStringW();
+            bool compress = r.Read<bool>();
+            timer.Start();
+            LvEd_PackArchive((wchar_t*)rootDir, (wchar_t*)archiveFile, compress);
+            timer.Stop();
+        }
+        break;
+
+    case ApiCall::BuildStaticBatches:
+        {
+            float cellSize = r.Read<float>();
+            timer.Start();
+            LvEd_BuildStaticBatches(cellSize);
+            timer.Stop();
+        }
+        break;
+
+    case ApiCall::ClearStaticBatches:
+        timer.Start();
+        LvEd_ClearStaticBatches();
+        timer.Stop();
+        break;
+
+    case ApiCall::SaveRenderSurfaceToFile:
+        {
+            ObjectGUID surface = MapHandle(r.Read<ObjectGUID>());
+            const wchar_t* fileName = r.ReadStringW();
+            skipped = surface == 0;
+            if(skipped) break;
+            timer.Start();
+            LvEd_SaveRenderSurfaceToFile(surface, (wchar_t*)fileName);
+            timer.Stop();
+        }
+        break;
+
+    case ApiCall::CreateVertexBuffer:
+        {
+            VertexFormatEnum vf = (VertexFormatEnum)r.Read<int32_t>();
+            uint32_t vertexCount = r.Read<uint32_t>();
+            const void* data = r.ReadBlob(NULL);
+            ObjectGUID recorded = r.Read<ObjectGUID>();
+            timer.Start();
+            ObjectGUID vb = LvEd_CreateVertexBuffer(vf, (void*)data, vertexCount);
+            timer.Stop();
+            AddHandle(recorded, vb);
+        }
+        break;
+
+    case ApiCall::CreateIndexBuffer:
+        {
+            uint32_t indexCount = r.Read<uint32_t>();
+            const void* data = r.ReadBlob(NULL);
+            ObjectGUID recorded = r.Read<ObjectGUID>();
+            timer.Start();
+            ObjectGUID ib = LvEd_CreateIndexBuffer((uint32_t*)data, indexCount);
+            timer.Stop();
+            AddHandle(recorded, ib);
+        }
+        break;
+
+    case ApiCall::DeleteBuffer:
+    case ApiCall::DeleteFont:
+        {
+            ObjectGUID recorded = r.Read<ObjectGUID>();
+            ObjectGUID handle = MapHandle(recorded);
+            skipped = handle == 0;
+            if(skipped) break;
+            timer.Start();
+            if(call == ApiCall::DeleteBuffer)
+                LvEd_DeleteBuffer(handle);
+            else
+                LvEd_DeleteFont(handle);
+            timer.Stop();
+            RemoveHandle(recorded);
+        }
+        break;
+
+    case ApiCall::SetRendererFlag:
+        {
+            BasicRendererFlagsEnum flags = (BasicRendererFlagsEnum)r.Read<int32_t>();
+            timer.Start();
+            LvEd_SetRendererFlag(flags);
+            timer.Stop();
+        }
+        break;
+
+    case ApiCall::DrawPrimitive:
+        {
+            PrimitiveTypeEnum pt = (PrimitiveTypeEnum)r.Read<int32_t>();
+            ObjectGUID vb = MapHandle(r.Read<ObjectGUID>());
+            uint32_t startVertex = r.Read<uint32_t>();
+            uint32_t vertexCount = r.Read<uint32_t>();
+            const float* color = (const float*)r.ReadBlob(NULL);
+            const float* xform = (const float*)r.ReadBlob(NULL);
+            skipped = vb == 0;
+            if(skipped) break;
+            timer.Start();
+            LvEd_DrawPrimitive(pt, vb, startVertex, vertexCount, (float*)color, (float*)xform);
+            timer.Stop();
+        }
+        break;
+
+    case ApiCall::DrawIndexedPrimitive:
+        {
+            PrimitiveTypeEnum pt = (PrimitiveTypeEnum)r.Read<int32_t>();
+            ObjectGUID vb = MapHandle(r.Read<ObjectGUID>());
+            ObjectGUID ib = MapHandle(r.Read<ObjectGUID>());
+            uint32_t startIndex = r.Read<uint32_t>();
+            uint32_t indexCount = r.Read<uint32_t>();
+            uint32_t startVertex = r.Read<uint32_t>();
+            const float* color = (const float*)r.ReadBlob(NULL);
+            const float* xform = (const float*)r.ReadBlob(NULL);
+            skipped = vb == 0 || ib == 0;
+            if(skipped) break;
+            timer.Start();
+            LvEd_DrawIndexedPrimitive(pt, vb, ib, startIndex, indexCount, startVertex, (float*)color, (float*)xform);
+            timer.Stop();
+        }
+        break;
+
+    case ApiCall::DrawBatch:
+        {
+            uint32_t size = 0;
+            const BasicDrawItem* recorded = (const BasicDrawItem*)r.ReadBlob(&size);
+            std::vector<BasicDrawItem> items;
+            for(uint32_t i = 0; i < size / sizeof(BasicDrawItem); ++i)
+            {
+                BasicDrawItem item = recorded[i];
+                item.vb = MapHandle(item.vb);
+                item.ib = MapHandle(item.ib);
+                if(item.vb == 0 || (recorded[i].ib != 0 && item.ib == 0))
+                    continue;
+                items.push_back(item);
+            }
+            skipped = items.empty();
+            if(skipped) break;
+            timer.Start();
+            LvEd_DrawBatch(&items[0], (int)items.size());
+            timer.Stop();
+        }
+        break;
+
+    case ApiCall::CreateFontInstance:
+        {
+            const wchar_t* name = r.ReadStringW();
+            float pixelHeight = r.Read<float>();
+            LvEdFonts::FontStyleFlags styles = (LvEdFonts::FontStyleFlags)r.Read<int32_t>();
+            ObjectGUID recorded = r.Read<ObjectGUID>();
+            timer.Start();
+            ObjectGUID font = LvEd_CreateFont((WCHAR*)name, pixelHeight, styles);
+            timer.Stop();
+            AddHandle(recorded, font);
+        }
+        break;
+
+    case ApiCall::DrawText2D:
+        {
+            ObjectGUID font = MapHandle(r.Read<ObjectGUID>());
+            const wchar_t* text = r.ReadStringW();
+            int x = r.Read<int32_t>();
+            int y = r.Read<int32_t>();
+            int color = r.Read<int32_t>();
+            skipped = font == 0;
+            if(skipped) break;
+            timer.Start();
+            LvEd_DrawText2D(font, (WCHAR*)text, x, y, color);
+            timer.Stop();
+        }
+        break;
+
+    default:
+        skipped = true;
+        break;
+    }
+
+    if(skipped)
+    {
+        Logger::Log(OutputMessageType::Debug, "Trace: skipped %s, unknown handle\n", ApiCall::ToString(call));
+        return;
+    }
+
+    double ms = timer.ElapsedTimeMS();
+    ApiCallStats& stats = m_stats[call];
+    stats.count++;
+    stats.totalMs += ms;
+    if(ms > stats.maxMs)
+        stats.maxMs = ms;
+    m_totalMs += ms;
+}
+
+//---------------------------------------------------------------------------
+void ApiTraceReplayer::LogReport() const
+{
+    Logger::Log(OutputMessageType::Info, "Trace replay: %u frames, %.3f ms in engine calls\n", m_frameCount, m_totalMs);
+    for(uint32_t i = 0; i < ApiCall::Count; ++i)
+    {
+        const ApiCallStats& stats = m_stats[i];
+        if(stats.count == 0)
+            continue;
+        Logger::Log(OutputMessageType::Info, "  %-24s %8u calls %10.3f ms total %8.4f ms avg %8.4f ms max\n",
+            ApiCall::ToString((ApiCallEnum)i), stats.count, stats.totalMs, stats.totalMs / stats.count, stats.maxMs);
+    }
+}
+
+//---------------------------------------------------------------------------
+bool ApiTraceReplayer::WriteReport(const wchar_t* file) const
+{
+    FILE* fp = NULL;
+    if(_wfopen_s(&fp, file, L"w") != 0 || fp == NULL)
+    {
+        Logger::Log(OutputMessageType::Error, L"Failed to create report file %s\n", file);
+        return false;
+    }
+    fprintf(fp, "call,count,total ms,average ms,max ms\n");
+    for(uint32_t i = 0; i < ApiCall::Count; ++i)
+    {
+        const ApiCallStats& stats = m_stats[i];
+        if(stats.count == 0)
+            continue;
+        fprintf(fp, "%s,%u,%.4f,%.4f,%.4f\n", ApiCall::ToString((ApiCallEnum)i),
+            stats.count, stats.totalMs, stats.totalMs / stats.count, stats.maxMs);
+    }
+    fprintf(fp, "frames,%u,%.4f,%.4f,\n", m_frameCount, m_totalMs, m_frameCount ? m_totalMs / m_frameCount : 0.0);
+    fclose(fp);
+    return true;
+}
@@ -0,0 +1,55 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    ApiTraceReplayer.h
+
+    Replays the traces recorded by LvEd_StartTrace, see ApiTrace.h.
+****************************************************************************/
+#pragma once
+
+#include <map>
+#include "ApiTrace.h"
+
+namespace LvEdEngine
+{
+    // time spent in the calls of one type while replaying.
+    struct ApiCallStats
+    {
+        uint32_t count;
+        double   totalMs;
+        double   maxMs;
+    };
+
+    //-----------------------------------------------------------------------
+    //  Replays a trace on the initialized engine through its exported
+    //  functions and times every call.
+    //  The handles returned while recording are mapped to the handles
+    //  returned while replaying.
+    //-----------------------------------------------------------------------
+    class ApiTraceReplayer : public NonCopyable
+    {
+    public:
+        ApiTraceReplayer();
+
+        bool Replay(const wchar_t* file);
+
+        const ApiCallStats& GetStats(ApiCallEnum call) const { return m_stats[call]; }
+        uint32_t GetFrameCount() const { return m_frameCount; }
+
+        // logs the stats of the calls that were replayed.
+        void LogReport() const;
+        // writes the stats as comma separated values.
+        bool WriteReport(const wchar_t* file) const;
+
+    private:
+        void ReplayCall(ApiTraceReader& reader, ApiCallEnum call);
+        ObjectGUID MapHandle(ObjectGUID recorded) const;
+        void AddHandle(ObjectGUID recorded, ObjectGUID replayed);
+        void RemoveHandle(ObjectGUID recorded);
+
+        std::map<ObjectGUID, ObjectGUID> m_handles;
+        ApiCallStats m_stats[ApiCall::Count];
+        uint32_t     m_frameCount;
+        double       m_totalMs;
+    };
+}
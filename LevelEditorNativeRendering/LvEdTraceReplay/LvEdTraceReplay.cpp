@@ -0,0 +1,75 @@
+//Copyright  2014 Sony Computer Entertainment America LLC. See License.txt.
+
+/****************************************************************************
+    LvEdTraceReplay.cpp
+
+    Replays a trace recorded by LvEd_StartTrace on the rendering engine and
+    reports the time spent per call type. Runs on the null device unless
+    -gpu is given, so traces can be replayed on build machines.
+
+    usage: LvEdTraceReplay [-gpu] [-report file.csv] trace
+****************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "LvEdRenderingEngine.h"
+#include "ApiTraceReplayer.h"
+#include "Core/Logger.h"
+
+using namespace LvEdEngine;
+
+//---------------------------------------------------------------------------
+static void __stdcall LogCallback(int /*messageType*/, wchar_t* text)
+{
+    fputws(text, stdout);
+}
+
+//---------------------------------------------------------------------------
+static void __stdcall InvalidateViews()
+{
+}
+
+//---------------------------------------------------------------------------
+static int Usage()
+{
+    fwprintf(stderr, L"usage: LvEdTraceReplay [-gpu] [-report file.csv] trace\n");
+    return 2;
+}
+
+//---------------------------------------------------------------------------
+int wmain(int argc, wchar_t* argv[])
+{
+    bool headless = true;
+    const wchar_t* reportFile = NULL;
+    const wchar_t* traceFile = NULL;
+    for(int i = 1; i < argc; ++i)
+    {
+        if(wcscmp(argv[i], L"-gpu") == 0)
+            headless = false;
+        else if(wcscmp(argv[i], L"-report") == 0 && i + 1 < argc)
+            reportFile = argv[++i];
+        else if(argv[i][0] != L'-' && traceFile == NULL)
+            traceFile = argv[i];
+        else
+            return Usage();
+    }
+    if(traceFile == NULL)
+        return Usage();
+
+    // the replayer logs through its own Logger, the engine through the callback.
+    Logger::SetLogCallback(LogCallback);
+    LvEd_SetHeadless(headless);
+    LvEd_Initialize(LogCallback, InvalidateViews, NULL);
+    LvEd_StopTrace(); // the replay isn't recorded, even with LVED_API_TRACE set.
+
+    ApiTraceReplayer replayer;
+    bool replayed = replayer.Replay(traceFile);
+    if(replayed)
+    {
+        replayer.LogReport();
+        if(reportFile)
+            replayed = replayer.WriteReport(reportFile);
+    }
+
+    LvEd_Shutdown();
+    return replayed ? 0 : 1;
+}
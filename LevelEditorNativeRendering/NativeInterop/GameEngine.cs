@@ -293,6 +293,154 @@ public static void RenderGame()
             NativeRenderGame();
         }
 
+        /// <summary>
+        /// Sets the number of threads used to collect renderables.
+        /// 1 collects on the calling thread only, 0 picks a default for this machine.</summary>
+        public static void SetRenderThreadCount(int count)
+        {
+            NativeSetRenderThreadCount(count);
+        }
+
+        /// <summary>
+        /// Enables software occlusion culling of the renderables hidden behind
+        /// the terrain and the objects flagged as occluders.</summary>
+        public static void SetOcclusionCulling(bool enable)
+        {
+            NativeSetOcclusionCulling(enable);
+        }
+
+        /// <summary>
+        /// Sets the size in pixels below which game objects are not drawn,
+        /// 0 disables small feature culling.</summary>
+        public static void SetSmallFeatureCulling(float pixels)
+        {
+            NativeSetSmallFeatureCulling(pixels);
+        }
+
+        /// <summary>
+        /// Gets the occlusion culling statistics of the last RenderGame call.</summary>
+        public static void GetOcclusionStats(out uint occluderTriangles, out uint tested, out uint culled)
+        {
+            NativeGetOcclusionStats(out occluderTriangles, out tested, out culled);
+        }
+
+        /// <summary>
+        /// Gets the per-frame memory statistics of the last frame: the bytes allocated,
+        /// the bytes that didn't fit in the frame arena, and the size of the arena.</summary>
+        public static void GetFrameMemoryStats(out uint peakBytes, out uint overflowBytes, out uint capacityBytes)
+        {
+            NativeGetFrameMemoryStats(out peakBytes, out overflowBytes, out capacityBytes);
+        }
+
+        /// <summary>
+        /// Sets the memory budget of the loaded textures and models, unreferenced
+        /// resources are evicted least recently used first while over budget.</summary>
+        public static void SetResourceMemoryBudget(uint megabytes)
+        {
+            NativeSetResourceMemoryBudget(megabytes);
+        }
+
+        /// <summary>
+        /// Gets the memory taken by the loaded resources and the budget, in bytes.</summary>
+        public static void GetResourceMemoryStats(out ulong loadedBytes, out ulong budgetBytes)
+        {
+            NativeGetResourceMemoryStats(out loadedBytes, out budgetBytes);
+        }
+
+        /// <summary>
+        /// Enables sharing one texture between files with identical contents.</summary>
+        public static void SetContentSharing(bool enable)
+        {
+            NativeSetContentSharing(enable);
+        }
+
+        /// <summary>
+        /// Gets the number of resources that shared the contents of another one,
+        /// and the memory that saved.</summary>
+        public static void GetContentSharingStats(out uint sharedCount, out ulong savedBytes)
+        {
+            NativeGetContentSharingStats(out sharedCount, out savedBytes);
+        }
+
+        /// <summary>
+        /// Sets the options of the cache of processed textures. Compressing
+        /// makes the first load slower and the cached textures smaller.</summary>
+        public static void SetTextureCache(bool enable, bool compress)
+        {
+            NativeSetTextureCache(enable, compress);
+        }
+
+        /// <summary>
+        /// Enables the mip streaming of large textures, and sets the memory
+        /// their mips can use.</summary>
+        public static void SetTextureStreaming(bool enable, uint budgetMegabytes)
+        {
+            NativeSetTextureStreaming(enable, budgetMegabytes);
+        }
+
+        /// <summary>
+        /// Gets the memory of the streamed textures at their current mips,
+        /// their number and the uploads in progress.</summary>
+        public static void GetTextureStreamingStats(out ulong residentBytes, out uint textureCount, out uint pendingCount)
+        {
+            NativeGetTextureStreamingStats(out residentBytes, out textureCount, out pendingCount);
+        }
+
+        /// <summary>
+        /// Mounts an asset archive, the resources under mountDir are loaded
+        /// from it when it contains them.</summary>
+        public static bool MountArchive(string archiveFile, string mountDir)
+        {
+            return NativeMountArchive(archiveFile, mountDir);
+        }
+
+        /// <summary>
+        /// Packs every file under rootDir into an asset archive.
+        /// Returns the number of files packed, -1 on failure.</summary>
+        public static int PackArchive(string rootDir, string archiveFile, bool compress)
+        {
+            return NativePackArchive(rootDir, archiveFile, compress);
+        }
+
+        /// <summary>
+        /// Merges the small static meshes of the game level that share a material
+        /// within cells of the given size. Returns the number of batches.</summary>
+        public static int BuildStaticBatches(float cellSize)
+        {
+            return NativeBuildStaticBatches(cellSize);
+        }
+
+        /// <summary>
+        /// Releases the batches built by BuildStaticBatches.</summary>
+        public static void ClearStaticBatches()
+        {
+            NativeClearStaticBatches();
+        }
+
+        /// <summary>
+        /// Starts recording the engine calls to a trace file, for replaying
+        /// them without the editor. Returns false if the file can't be created.</summary>
+        public static bool StartTrace(string traceFile)
+        {
+            return NativeStartTrace(traceFile);
+        }
+
+        /// <summary>
+        /// Stops recording the engine calls.</summary>
+        public static void StopTrace()
+        {
+            NativeStopTrace();
+        }
+
+        /// <summary>
+        /// Flags the game object as occluder for the software occlusion culling.</summary>
+        public static void SetOccluder(ulong instanceId, bool occluder)
+        {
+            byte val = occluder ? (byte)1 : (byte)0;
+            IntPtr retVal;
+            NativeInvokeMemberFn(instanceId, "SetOccluder", new IntPtr(&val), out retVal);
+        }
+
         public static bool SaveRenderSurfaceToFile(ulong renderSurface, string fileName)
         {
             return NativeSaveRenderSurfaceToFile(renderSurface, fileName);
@@ -706,6 +854,19 @@ public static void SetRendererFlag(BasicRendererFlags renderFlags)
             }
 
         }
+
+        /// <summary>
+        /// Draws many primitives with one call, use it instead of DrawPrimitive and
+        /// DrawIndexedPrimitive for objects made of many parts.</summary>
+        public static void DrawBatch(DrawBatchItem[] items, int count)
+        {
+            if (items == null || count <= 0)
+                return;
+            fixed (DrawBatchItem* ptr = items)
+            {
+                NativeDrawBatch(ptr, Math.Min(count, items.Length));
+            }
+        }
         #endregion
 
         #region font and text rendering
@@ -818,6 +979,62 @@ public static void DrawText2D(string text, ulong fontId, int x, int y, Color col
 
         [DllImportAttribute("LvEdRenderingEngine", EntryPoint = "LvEd_RenderGame")]
         private static extern void NativeRenderGame();
+
+        [DllImportAttribute("LvEdRenderingEngine", EntryPoint = "LvEd_SetRenderThreadCount", CallingConvention = CallingConvention.StdCall)]
+        private static extern void NativeSetRenderThreadCount(int count);
+
+        [DllImportAttribute("LvEdRenderingEngine", EntryPoint = "LvEd_SetOcclusionCulling", CallingConvention = CallingConvention.StdCall)]
+        private static extern void NativeSetOcclusionCulling([MarshalAs(UnmanagedType.I1)] bool enable);
+
+        [DllImportAttribute("LvEdRenderingEngine", EntryPoint = "LvEd_SetSmallFeatureCulling", CallingConvention = CallingConvention.StdCall)]
+        private static extern void NativeSetSmallFeatureCulling(float pixels);
+
+        [DllImportAttribute("LvEdRenderingEngine", EntryPoint = "LvEd_GetOcclusionStats", CallingConvention = CallingConvention.StdCall)]
+        private static extern void NativeGetOcclusionStats(out uint occluderTriangles, out uint tested, out uint culled);
+
+        [DllImportAttribute("LvEdRenderingEngine", EntryPoint = "LvEd_GetFrameMemoryStats", CallingConvention = CallingConvention.StdCall)]
+        private static extern void NativeGetFrameMemoryStats(out uint peakBytes, out uint overflowBytes, out uint capacityBytes);
+
+        [DllImportAttribute("LvEdRenderingEngine", EntryPoint = "LvEd_SetResourceMemoryBudget", CallingConvention = CallingConvention.StdCall)]
+        private static extern void NativeSetResourceMemoryBudget(uint megabytes);
+
+        [DllImportAttribute("LvEdRenderingEngine", EntryPoint = "LvEd_GetResourceMemoryStats", CallingConvention = CallingConvention.StdCall)]
+        private static extern void NativeGetResourceMemoryStats(out ulong loadedBytes, out ulong budgetBytes);
+
+        [DllImportAttribute("LvEdRenderingEngine", EntryPoint = "LvEd_SetContentSharing", CallingConvention = CallingConvention.StdCall)]
+        private static extern void NativeSetContentSharing([MarshalAs(UnmanagedType.I1)] bool enable);
+
+        [DllImportAttribute("LvEdRenderingEngine", EntryPoint = "LvEd_GetContentSharingStats", CallingConvention = CallingConvention.StdCall)]
+        private static extern void NativeGetContentSharingStats(out uint sharedCount, out ulong savedBytes);
+
+        [DllImportAttribute("LvEdRenderingEngine", EntryPoint = "LvEd_SetTextureCache", CallingConvention = CallingConvention.StdCall)]
+        private static extern void NativeSetTextureCache([MarshalAs(UnmanagedType.I1)] bool enable, [MarshalAs(UnmanagedType.I1)] bool compress);
+
+        [DllImportAttribute("LvEdRenderingEngine", EntryPoint = "LvEd_SetTextureStreaming", CallingConvention = CallingConvention.StdCall)]
+        private static extern void NativeSetTextureStreaming([MarshalAs(UnmanagedType.I1)] bool enable, uint budgetMegabytes);
+
+        [DllImportAttribute("LvEdRenderingEngine", EntryPoint = "LvEd_GetTextureStreamingStats", CallingConvention = CallingConvention.StdCall)]
+        private static extern void NativeGetTextureStreamingStats(out ulong residentBytes, out uint textureCount, out uint pendingCount);
+
+        [DllImportAttribute("LvEdRenderingEngine", EntryPoint = "LvEd_MountArchive", CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Unicode)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        private static extern bool NativeMountArchive(string archiveFile, string mountDir);
+
+        [DllImportAttribute("LvEdRenderingEngine", EntryPoint = "LvEd_PackArchive", CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Unicode)]
+        private static extern int NativePackArchive(string rootDir, string archiveFile, [MarshalAs(UnmanagedType.I1)] bool compress);
+
+        [DllImportAttribute("LvEdRenderingEngine", EntryPoint = "LvEd_BuildStaticBatches", CallingConvention = CallingConvention.StdCall)]
+        private static extern int NativeBuildStaticBatches(float cellSize);
+
+        [DllImportAttribute("LvEdRenderingEngine", EntryPoint = "LvEd_ClearStaticBatches", CallingConvention = CallingConvention.StdCall)]
+        private static extern void NativeClearStaticBatches();
+
+        [DllImportAttribute("LvEdRenderingEngine", EntryPoint = "LvEd_StartTrace", CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Unicode)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        private static extern bool NativeStartTrace(string traceFile);
+
+        [DllImportAttribute("LvEdRenderingEngine", EntryPoint = "LvEd_StopTrace", CallingConvention = CallingConvention.StdCall)]
+        private static extern void NativeStopTrace();
        
         [DllImportAttribute("LvEdRenderingEngine", EntryPoint = "LvEd_SaveRenderSurfaceToFile", CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Unicode)]
         private static extern bool NativeSaveRenderSurfaceToFile(ulong renderSurface, string fileName);
@@ -855,6 +1072,9 @@ public static void DrawText2D(string text, ulong fontId, int x, int y, Color col
                                                         uint startVertex,
                                                         float* color,
                                                         float* xform);
+
+        [DllImportAttribute("LvEdRenderingEngine", EntryPoint = "LvEd_DrawBatch", CallingConvention = CallingConvention.StdCall)]
+        private static extern void NativeDrawBatch(DrawBatchItem* items, int count);
                                                         
         [DllImport("LvEdRenderingEngine", EntryPoint = "LvEd_CreateFont", CallingConvention = CallingConvention.StdCall, CharSet = CharSet.Unicode)]
         private static extern ulong NativeCreateFont(string fontName, float pixelHeight, FontStyle fontStyles);
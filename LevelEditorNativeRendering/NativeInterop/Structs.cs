@@ -49,4 +49,30 @@ public struct HitRecord
 
     }
 
+    /// <summary>
+    /// One draw of GameEngine.DrawBatch, matches BasicDrawItem of the native renderer.</summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public unsafe struct DrawBatchItem
+    {
+        public ulong vb;
+        public ulong ib;                    // 0 for a non indexed draw.
+        public PrimitiveType primitiveType;
+        public uint start;                  // first index, or first vertex when ib is 0.
+        public uint count;                  // number of indices or vertices.
+        public uint startVertex;            // base vertex of an indexed draw.
+        public Vector4 color;
+        public fixed float xform[16];
+
+        public void SetTransform(Sce.Atf.VectorMath.Matrix4F m)
+        {
+            fixed (float* dest = xform)
+            {
+                dest[0] = m.M11; dest[1] = m.M12; dest[2] = m.M13; dest[3] = m.M14;
+                dest[4] = m.M21; dest[5] = m.M22; dest[6] = m.M23; dest[7] = m.M24;
+                dest[8] = m.M31; dest[9] = m.M32; dest[10] = m.M33; dest[11] = m.M34;
+                dest[12] = m.M41; dest[13] = m.M42; dest[14] = m.M43; dest[15] = m.M44;
+            }
+        }
+    }
+
 }